@@ -16,7 +16,10 @@
 #include "benchmarks/thirdparty/rapidjson/writer.h"
 
 // Standard headers
-// None
+#include <cstdint> // int64_t
+#include <string>  // string
+#include <utility> // move()
+#include <vector>  // vector<>
 
 // ____________________ IMPLEMENTATION ____________________
 
@@ -52,6 +55,128 @@ void generate_test_data() {
     json::Node(numbers).to_file("benchmarks/data/numbers.json");
 }
 
+// ===========================
+// --- Reflected structure ---
+// ===========================
+
+// Subset of the 'twitter.json' schema, nullable fields ('geo', 'place', 'in_reply_to_*', 'user.url' and etc.)
+// are left out since they can't be reflected into a plain member, everything else is a fairly typical config-like
+// mix of nested structs, arrays of structs, strings, numbers & bools
+
+struct TwitterMetadata {
+    std::string result_type;
+    std::string iso_language_code;
+};
+
+struct TwitterUser {
+    std::int64_t id;
+    std::string  id_str;
+    std::string  name;
+    std::string  screen_name;
+    std::string  location;
+    std::string  description;
+    std::int64_t followers_count;
+    std::int64_t friends_count;
+    std::int64_t listed_count;
+    std::string  created_at;
+    std::int64_t favourites_count;
+    bool         geo_enabled;
+    bool         verified;
+    std::int64_t statuses_count;
+    std::string  lang;
+    std::string  profile_background_color;
+    std::string  profile_background_image_url;
+    std::string  profile_background_image_url_https;
+    std::string  profile_image_url;
+    std::string  profile_image_url_https;
+    std::string  profile_link_color;
+    bool         default_profile;
+    bool         default_profile_image;
+    bool         following;
+};
+
+struct TwitterHashtag {
+    std::string      text;
+    std::vector<int> indices;
+};
+
+struct TwitterUrl {
+    std::string      url;
+    std::string      expanded_url;
+    std::string      display_url;
+    std::vector<int> indices;
+};
+
+struct TwitterMention {
+    std::string      screen_name;
+    std::string      name;
+    std::int64_t     id;
+    std::string      id_str;
+    std::vector<int> indices;
+};
+
+struct TwitterEntities {
+    std::vector<TwitterHashtag> hashtags;
+    std::vector<TwitterUrl>     urls;
+    std::vector<TwitterMention> user_mentions;
+};
+
+struct TwitterStatus {
+    TwitterMetadata metadata;
+    std::string     created_at;
+    std::int64_t    id;
+    std::string     id_str;
+    std::string     text;
+    std::string     source;
+    bool            truncated;
+    TwitterUser     user;
+    std::int64_t    retweet_count;
+    std::int64_t    favorite_count;
+    TwitterEntities entities;
+    bool            favorited;
+    bool            retweeted;
+    std::string     lang;
+};
+
+struct TwitterSearchMetadata {
+    double       completed_in;
+    std::int64_t max_id;
+    std::string  max_id_str;
+    std::string  next_results;
+    std::string  query;
+    std::string  refresh_url;
+    std::int64_t count;
+    std::int64_t since_id;
+    std::string  since_id_str;
+};
+
+struct Twitter {
+    std::vector<TwitterStatus> statuses;
+    TwitterSearchMetadata      search_metadata;
+};
+
+// clang-format off
+#define twitter_reflect(macro_)                                                                                        \
+    macro_(TwitterMetadata, result_type, iso_language_code);                                                           \
+    macro_(TwitterUser, id, id_str, name, screen_name, location, description, followers_count, friends_count,          \
+           listed_count, created_at, favourites_count, geo_enabled, verified, statuses_count, lang,                    \
+           profile_background_color, profile_background_image_url, profile_background_image_url_https,                \
+           profile_image_url, profile_image_url_https, profile_link_color, default_profile, default_profile_image,     \
+           following);                                                                                                 \
+    macro_(TwitterHashtag, text, indices);                                                                             \
+    macro_(TwitterUrl, url, expanded_url, display_url, indices);                                                       \
+    macro_(TwitterMention, screen_name, name, id, id_str, indices);                                                    \
+    macro_(TwitterEntities, hashtags, urls, user_mentions);                                                            \
+    macro_(TwitterStatus, metadata, created_at, id, id_str, text, source, truncated, user, retweet_count,              \
+           favorite_count, entities, favorited, retweeted, lang);                                                      \
+    macro_(TwitterSearchMetadata, completed_in, max_id, max_id_str, next_results, query, refresh_url, count,           \
+           since_id, since_id_str);                                                                                    \
+    macro_(Twitter, statuses, search_metadata)
+
+twitter_reflect(UTL_JSON_REFLECT);
+twitter_reflect(NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE);
+// clang-format on
+
 // =================
 // --- Benchmark ---
 // =================
@@ -182,6 +307,146 @@ void benchmark_parse_serialize_on_data(const std::string& filepath) {
     });
 }
 
+void benchmark_reflection_on_data(const std::string& filepath) {
+
+    const std::string filename = filepath.substr(filepath.find_last_of('/') + 1);
+    std::cout << "\n\n====== BENCHMARKING REFLECTION ON DATA: `" << filename << "` ======\n";
+
+    const std::string string_buffer = (std::ostringstream() << std::ifstream(filepath).rdbuf()).str();
+
+    const json::Node     json_utl      = json::from_string(string_buffer);
+    const nlohmann::json json_nlohmann = nlohmann::json::parse(string_buffer);
+    const Twitter        twitter       = json_utl.to_struct<Twitter>();
+
+    bench.minEpochIterations(4).timeUnit(1ms, "ms");
+
+    // Benchmark 'JSON -> struct', we want to see the cost of reflection alone, so nodes are parsed only once
+    bench.title("Reflection (JSON -> struct)").relative(true).warmup(10);
+
+    benchmark("utl::json [to_struct() const&]", [&]() {
+        const auto result = json_utl.to_struct<Twitter>();
+        DO_NOT_OPTIMIZE_AWAY(result);
+    });
+
+    benchmark("nlohmann  [get<T>()]", [&]() {
+        const auto result = json_nlohmann.get<Twitter>();
+        DO_NOT_OPTIMIZE_AWAY(result);
+    });
+
+    // Benchmark 'string -> struct', here the parsed node is a temporary that can be moved from
+    bench.title("Parsing to struct").relative(true);
+
+    benchmark("utl::json [from_string() + to_struct() const&]", [&]() {
+        const auto json   = json::from_string(string_buffer);
+        const auto result = json.to_struct<Twitter>();
+        DO_NOT_OPTIMIZE_AWAY(result);
+    });
+
+    benchmark("utl::json [from_string() + to_struct() &&]", [&]() {
+        const auto result = json::from_string(string_buffer).to_struct<Twitter>();
+        DO_NOT_OPTIMIZE_AWAY(result);
+    });
+
+    benchmark("utl::json [from_string_to<T>()]", [&]() {
+        const auto result = json::from_string_to<Twitter>(string_buffer);
+        DO_NOT_OPTIMIZE_AWAY(result);
+    });
+
+    benchmark("nlohmann  [parse() + get<T>()]", [&]() {
+        const auto result = nlohmann::json::parse(string_buffer).get<Twitter>();
+        DO_NOT_OPTIMIZE_AWAY(result);
+    });
+
+    // Benchmark full 'string -> struct -> string' round trip
+    bench.title("Reflected round trip").relative(true);
+
+    benchmark("utl::json [from_string() + to_struct() + from_struct()]", [&]() {
+        const auto result = json::from_struct(json::from_string(string_buffer).to_struct<Twitter>()).to_string();
+        DO_NOT_OPTIMIZE_AWAY(result);
+    });
+
+    benchmark("utl::json [from_string_to<T>() + from_struct()]", [&]() {
+        const auto result = json::from_struct(json::from_string_to<Twitter>(string_buffer)).to_string();
+        DO_NOT_OPTIMIZE_AWAY(result);
+    });
+
+    benchmark("utl::json [from_string_to<T>() + to_string()]", [&]() {
+        const auto result = json::to_string(json::from_string_to<Twitter>(string_buffer));
+        DO_NOT_OPTIMIZE_AWAY(result);
+    });
+
+    benchmark("nlohmann  [parse() + get<T>() + dump()]", [&]() {
+        const auto result = nlohmann::json(nlohmann::json::parse(string_buffer).get<Twitter>()).dump(4);
+        DO_NOT_OPTIMIZE_AWAY(result);
+    });
+
+    // Benchmark 'struct -> JSON'
+    bench.title("Reflection (struct -> JSON)").relative(true);
+
+    benchmark("utl::json [from_struct()]", [&]() {
+        const auto result = json::from_struct(twitter);
+        DO_NOT_OPTIMIZE_AWAY(result);
+    });
+
+    benchmark("nlohmann  [json(T)]", [&]() {
+        const nlohmann::json result = twitter;
+        DO_NOT_OPTIMIZE_AWAY(result);
+    });
+
+    // Benchmark 'struct -> string'
+    bench.title("Serializing struct").relative(true);
+
+    benchmark("utl::json [from_struct() + to_string()]", [&]() {
+        const auto result = json::from_struct(twitter).to_string();
+        DO_NOT_OPTIMIZE_AWAY(result);
+    });
+
+    benchmark("utl::json [to_string(T)]", [&]() {
+        const auto result = json::to_string(twitter);
+        DO_NOT_OPTIMIZE_AWAY(result);
+    });
+
+    benchmark("nlohmann  [json(T) + dump()]", [&]() {
+        const auto result = nlohmann::json(twitter).dump(4);
+        DO_NOT_OPTIMIZE_AWAY(result);
+    });
+}
+
+void benchmark_flat_dom_on_data(const std::string& filepath) {
+
+    const std::string filename = filepath.substr(filepath.find_last_of('/') + 1);
+    std::cout << "\n\n====== BENCHMARKING FLAT DOM ON DATA: `" << filename << "` ======\n";
+
+    const std::string string_buffer = (std::ostringstream() << std::ifstream(filepath).rdbuf()).str();
+
+    bench.minEpochIterations(4).timeUnit(1ms, "ms");
+
+    // All parsers start from the same in-memory buffer, this isolates the cost of building & freeing the DOM.
+    // Flat DOM has to take a copy of the buffer since strings are stored as views into it, this is included.
+    bench.title("Parsing `" + filename + "` to DOM").relative(true).warmup(10);
+
+    benchmark("utl::json [from_string()]", [&]() {
+        const auto json = json::from_string(string_buffer);
+        DO_NOT_OPTIMIZE_AWAY(json);
+    });
+
+    benchmark("utl::json [flat_from_string()]", [&]() {
+        const auto json = json::flat_from_string(string_buffer);
+        DO_NOT_OPTIMIZE_AWAY(json);
+    });
+
+    benchmark("nlohmann  [parse()]", [&]() {
+        const auto json = nlohmann::json::parse(string_buffer);
+        DO_NOT_OPTIMIZE_AWAY(json);
+    });
+
+    benchmark("RapidJSON [Parse()]", [&]() {
+        rapidjson::Document json;
+        json.Parse(string_buffer.data());
+        DO_NOT_OPTIMIZE_AWAY(json);
+    });
+}
+
 // ========================
 // --- Benchmark runner ---
 // ========================
@@ -196,4 +461,9 @@ int main() {
     benchmark_parse_serialize_on_data("benchmarks/data/random.json");
     benchmark_parse_serialize_on_data("benchmarks/data/canada.json");
     benchmark_parse_serialize_on_data("benchmarks/data/apache_builds.json");
+
+    benchmark_reflection_on_data("benchmarks/data/twitter.json");
+
+    benchmark_flat_dom_on_data("benchmarks/data/canada.json");
+    benchmark_flat_dom_on_data("benchmarks/data/twitter.json");
 }
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "benchmarks/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+// Standard headers
+#include <cstdint>       // uint64_t
+#include <mutex>         // mutex, scoped_lock
+#include <optional>      // optional<>
+#include <queue>         // queue<>
+#include <string>        // string, to_string()
+#include <unordered_map> // unordered_map<>
+#include <utility>       // move()
+
+// ____________________ IMPLEMENTATION ____________________
+
+// =================
+// --- Baselines ---
+// =================
+
+// Straightforward "lock everything" containers, which is what the concurrent ones usually replace
+
+template <class T>
+class LockedQueue {
+    std::mutex    mutex;
+    std::queue<T> queue;
+    std::size_t   capacity;
+
+public:
+    explicit LockedQueue(std::size_t capacity) : capacity(capacity) {}
+
+    bool try_push(T value) {
+        const std::scoped_lock lock(this->mutex);
+        if (this->queue.size() == this->capacity) return false;
+        this->queue.push(std::move(value));
+        return true;
+    }
+
+    std::optional<T> try_pop() {
+        const std::scoped_lock lock(this->mutex);
+        if (this->queue.empty()) return std::nullopt;
+        T value = std::move(this->queue.front());
+        this->queue.pop();
+        return value;
+    }
+};
+
+template <class K, class V>
+class LockedMap {
+    std::mutex               mutex;
+    std::unordered_map<K, V> map;
+
+public:
+    template <class F>
+    void update(const K& key, F&& f) {
+        const std::scoped_lock lock(this->mutex);
+        f(this->map[key]);
+    }
+};
+
+// =================
+// --- Benchmark ---
+// =================
+
+// Every task pushes a value & pops a value, which keeps all of the threads hammering both ends of the queue
+template <class Queue>
+void benchmark_queue(const std::string& name, std::size_t size) {
+    benchmark(name, [&] {
+        Queue queue(1024);
+
+        parallel::blocking_loop(parallel::IndexRange<std::size_t>{0, size}, [&](std::size_t low, std::size_t high) {
+            std::uint64_t sum = 0;
+            for (std::size_t i = low; i < high; ++i) {
+                while (!queue.try_push(i))
+                    if (const auto value = queue.try_pop()) sum += *value;
+                if (const auto value = queue.try_pop()) sum += *value;
+            }
+            DO_NOT_OPTIMIZE_AWAY(sum);
+        });
+    });
+}
+
+// Concurrent counting of a few thousand distinct keys, a typical "histogram" workload
+template <class Map>
+void benchmark_map(const std::string& name, std::size_t size) {
+    benchmark(name, [&] {
+        Map map;
+
+        parallel::blocking_loop(parallel::IndexRange<std::size_t>{0, size}, [&](std::size_t low, std::size_t high) {
+            for (std::size_t i = low; i < high; ++i) map.update(i % 4096, [](std::size_t& count) { ++count; });
+        });
+    });
+}
+
+// ========================
+// --- Benchmark runner ---
+// ========================
+
+int main() {
+    bench.timeUnit(1ms, "ms").minEpochTime(100ms).maxEpochTime(1s).relative(true); // global options
+
+    parallel::set_thread_count(parallel::hardware_concurrency());
+
+    constexpr std::size_t size = 1'000'000;
+
+    bench.title("Push & pop [N = " + std::to_string(size) + "]");
+    benchmark_queue<LockedQueue<std::size_t>>("std::mutex + std::queue", size);
+    benchmark_queue<parallel::MPMCQueue<std::size_t>>("parallel::MPMCQueue", size);
+
+    bench.title("Counting [N = " + std::to_string(size) + "]");
+    benchmark_map<LockedMap<std::size_t, std::size_t>>("std::mutex + std::unordered_map", size);
+    benchmark_map<parallel::ShardedMap<std::size_t, std::size_t>>("parallel::ShardedMap", size);
+}
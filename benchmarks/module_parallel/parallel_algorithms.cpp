@@ -0,0 +1,232 @@
+#include "benchmarks/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+// UTL dependencies
+#include "include/UTL/random.hpp"
+
+// Standard headers
+#include <algorithm>  // sort(), stable_sort(), partition(), find_if(), any_of()
+#include <cmath>      // sqrt()
+#include <cstdint>    // uint64_t
+#include <functional> // function<>
+#include <numeric>    // inclusive_scan(), accumulate()
+#include <string>     // string, to_string()
+#include <vector>     // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+// ============
+// --- Data ---
+// ============
+
+std::vector<std::uint64_t> random_vector(std::size_t size) {
+    std::vector<std::uint64_t> vec(size);
+    for (auto& e : vec) e = random::uniform_uint(0u, 1000u);
+    return vec;
+}
+
+// Typical datasets for sorting benchmarks, presorted & low-cardinality data tend to be handled very differently
+// from uniformly random data by most sorting algorithms
+
+struct Dataset {
+    std::string                                            name;
+    std::function<std::vector<std::uint64_t>(std::size_t)> generate;
+};
+
+const std::vector<Dataset> sorting_datasets = {
+    {"random",     [](std::size_t size) {
+         std::vector<std::uint64_t> vec(size);
+         for (auto& e : vec) e = random::uniform<std::uint64_t>(0, std::uint64_t(-1));
+         return vec;
+     }},
+    {"sorted",     [](std::size_t size) {
+         std::vector<std::uint64_t> vec(size);
+         for (std::size_t i = 0; i < size; ++i) vec[i] = i;
+         return vec;
+     }},
+    {"reversed",   [](std::size_t size) {
+         std::vector<std::uint64_t> vec(size);
+         for (std::size_t i = 0; i < size; ++i) vec[i] = size - i;
+         return vec;
+     }},
+    {"few unique", [](std::size_t size) {
+         std::vector<std::uint64_t> vec(size);
+         for (auto& e : vec) e = random::uniform<std::uint64_t>(0, 16);
+         return vec;
+     }},
+};
+
+// =================
+// --- Benchmark ---
+// =================
+
+void benchmark_inclusive_scan(std::size_t size) {
+    const auto                 input = random_vector(size);
+    std::vector<std::uint64_t> output(size);
+
+    bench.title("Inclusive scan [N = " + std::to_string(size) + "]").relative(true);
+
+    benchmark("std::inclusive_scan()", [&] {
+        std::inclusive_scan(input.begin(), input.end(), output.begin());
+        DO_NOT_OPTIMIZE_AWAY(output.data());
+    });
+
+    benchmark("parallel::blocking_inclusive_scan()", [&] {
+        parallel::blocking_inclusive_scan(input, output.begin(), parallel::sum<>{});
+        DO_NOT_OPTIMIZE_AWAY(output.data());
+    });
+}
+
+// Deterministic reduction fixes the combine tree by grain index, ideally it should cost about the same as the usual
+// reduction, which combines per-thread partial results in whatever order the threads finish
+void benchmark_reduce(std::size_t size) {
+    std::vector<double> input(size);
+    for (auto& e : input) e = random::uniform(-1.0, 1.0);
+
+    bench.title("Reduce [N = " + std::to_string(size) + "]").relative(true);
+
+    benchmark("std::accumulate()", [&] { DO_NOT_OPTIMIZE_AWAY(std::accumulate(input.begin(), input.end(), 0.0)); });
+
+    benchmark("parallel::blocking_reduce()", [&] {
+        DO_NOT_OPTIMIZE_AWAY(parallel::blocking_reduce(input, parallel::sum<>{}));
+    });
+
+    benchmark("parallel::blocking_deterministic_reduce()", [&] {
+        DO_NOT_OPTIMIZE_AWAY(parallel::blocking_deterministic_reduce(input, parallel::sum<>{}));
+    });
+}
+
+void benchmark_sorting(std::size_t size, const Dataset& dataset) {
+    const auto                 input = dataset.generate(size);
+    std::vector<std::uint64_t> data;
+
+    bench.title("Sorting [N = " + std::to_string(size) + ", " + dataset.name + "]").relative(true);
+
+    // copying the data is a part of each run, which makes it a common overhead for all algorithms
+    benchmark("std::sort()", [&] {
+        data = input;
+        std::sort(data.begin(), data.end());
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+
+    benchmark("std::stable_sort()", [&] {
+        data = input;
+        std::stable_sort(data.begin(), data.end());
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+
+    benchmark("parallel::sort()", [&] {
+        data = input;
+        parallel::sort(data);
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+
+    benchmark("parallel::stable_sort()", [&] {
+        data = input;
+        parallel::stable_sort(data);
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+}
+
+void benchmark_partition(std::size_t size) {
+    const auto                 input = random_vector(size);
+    std::vector<std::uint64_t> data;
+
+    const auto is_small = [](std::uint64_t x) { return x < 500; };
+
+    bench.title("Partition [N = " + std::to_string(size) + "]").relative(true);
+
+    benchmark("std::partition()", [&] {
+        data = input;
+        DO_NOT_OPTIMIZE_AWAY(std::partition(data.begin(), data.end(), is_small));
+    });
+
+    benchmark("parallel::partition()", [&] {
+        data = input;
+        DO_NOT_OPTIMIZE_AWAY(parallel::partition(data, is_small));
+    });
+}
+
+// Match is placed at 10% of the range, early-exit search should only need to look at a fraction of the data
+void benchmark_search(std::size_t size) {
+    const std::uint64_t        target = 1001; // outside of the generated values
+    std::vector<std::uint64_t> data   = random_vector(size);
+    data[size / 10]                   = target;
+
+    const auto is_target = [&](std::uint64_t x) { return x == target; };
+
+    bench.title("Search [N = " + std::to_string(size) + "]").relative(true);
+
+    benchmark("std::find_if()", [&] { DO_NOT_OPTIMIZE_AWAY(std::find_if(data.begin(), data.end(), is_target)); });
+
+    benchmark("parallel::find_if()", [&] { DO_NOT_OPTIMIZE_AWAY(parallel::find_if(data, is_target)); });
+
+    benchmark("std::any_of()", [&] { DO_NOT_OPTIMIZE_AWAY(std::any_of(data.begin(), data.end(), is_target)); });
+
+    benchmark("parallel::any_of()", [&] { DO_NOT_OPTIMIZE_AWAY(parallel::any_of(data, is_target)); });
+
+    benchmark("parallel::transform_reduce() [no early exit]", [&] {
+        DO_NOT_OPTIMIZE_AWAY(parallel::blocking_transform_reduce(parallel::Range{data}, false, std::logical_or<>{},
+                                                                 is_target));
+    });
+}
+
+// Cost of an iteration grows linearly with its index, with fixed grains the last blocks take much longer than
+// the first ones, which leaves most of the threads idle at the tail of the loop
+void benchmark_irregular_loop(std::size_t size) {
+    std::vector<double> data(size);
+
+    const auto body = [&](std::size_t low, std::size_t high) {
+        for (std::size_t i = low; i < high; ++i) {
+            double acc = 0;
+            for (std::size_t j = 0; j < i; ++j) acc += std::sqrt(double(j));
+            data[i] = acc;
+        }
+    };
+
+    bench.title("Irregular loop [N = " + std::to_string(size) + "]").relative(true);
+
+    benchmark("Serial", [&] {
+        body(0, size);
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+
+    benchmark("parallel::blocking_loop() [default grain]", [&] {
+        parallel::blocking_loop(parallel::IndexRange<std::size_t>{0, size}, body);
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+
+    benchmark("parallel::blocking_loop() [auto grain]", [&] {
+        parallel::blocking_loop(parallel::IndexRange<std::size_t>{0, size, parallel::auto_grain}, body);
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+}
+
+// ========================
+// --- Benchmark runner ---
+// ========================
+
+int main() {
+    bench.timeUnit(1ms, "ms").minEpochTime(100ms).maxEpochTime(1s); // global options
+
+    parallel::set_thread_count(parallel::hardware_concurrency());
+
+    benchmark_inclusive_scan(10'000);
+    benchmark_inclusive_scan(1'000'000);
+    benchmark_inclusive_scan(50'000'000);
+
+    benchmark_reduce(10'000);
+    benchmark_reduce(1'000'000);
+    benchmark_reduce(50'000'000);
+
+    for (const auto& dataset : sorting_datasets) benchmark_sorting(1'000'000, dataset);
+
+    benchmark_partition(10'000'000);
+
+    benchmark_search(50'000'000);
+
+    benchmark_irregular_loop(5'000);
+}
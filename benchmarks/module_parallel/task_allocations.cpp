@@ -0,0 +1,185 @@
+#include "benchmarks/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+// Standard headers
+#include <array>      // array<>
+#include <atomic>     // atomic<>
+#include <cstdlib>    // malloc(), free()
+#include <functional> // function<>
+#include <new>        // bad_alloc
+#include <string>     // string
+#include <vector>     // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+// =========================
+// --- Allocation counts ---
+// =========================
+
+// Replacing global 'operator new' allows us to count every allocation made by the program,
+// this includes allocations made by the thread pool internals and standard containers
+
+// GCC doesn't realize that replacement 'operator delete' calling 'free()' is paired with 'malloc()'
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+inline std::atomic<std::size_t> allocation_count = 0;
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+// ==================
+// --- Task types ---
+// ==================
+
+// Closures of different sizes, first two fit into the inline storage of the task, the last one doesn't
+
+template <std::size_t capture_size>
+struct Closure {
+    std::array<char, capture_size - sizeof(void*)> payload{};
+    std::atomic<std::size_t>*                      counter;
+
+    void operator()() const { counter->fetch_add(payload.size(), std::memory_order_relaxed); }
+};
+
+constexpr std::size_t task_count = 10'000;
+
+// =================
+// --- Benchmark ---
+// =================
+
+// Submits 'task_count' tasks from an external thread, these go into the global queue
+template <std::size_t capture_size>
+auto make_external_submission(parallel::ThreadPool& pool, std::atomic<std::size_t>& counter) {
+    return [&] {
+        for (std::size_t i = 0; i < task_count; ++i) pool.detached_task(Closure<capture_size>{{}, &counter});
+        pool.wait();
+    };
+}
+
+// Submits 'task_count' tasks from an external thread as a single batch, which only locks the global queue once
+template <std::size_t capture_size>
+auto make_external_bulk_submission(parallel::ThreadPool& pool, std::atomic<std::size_t>& counter) {
+    return [&] {
+        std::vector<Closure<capture_size>> tasks(task_count, Closure<capture_size>{{}, &counter});
+        pool.bulk_detached(tasks.begin(), tasks.end());
+        pool.wait();
+    };
+}
+
+// Submits 'task_count' tasks from a pool thread, these go into the local work-stealing deques
+template <std::size_t capture_size>
+auto make_recursive_submission(parallel::ThreadPool& pool, std::atomic<std::size_t>& counter) {
+    return [&] {
+        pool.detached_task([&] {
+            for (std::size_t i = 0; i < task_count; ++i) pool.detached_task(Closure<capture_size>{{}, &counter});
+        });
+        pool.wait();
+    };
+}
+
+// Only constructs the 'std::function<>' for each task, as a point of reference
+template <std::size_t capture_size>
+auto make_std_function_construction(std::atomic<std::size_t>& counter) {
+    return [&] {
+        for (std::size_t i = 0; i < task_count; ++i) {
+            std::function<void()> task = Closure<capture_size>{{}, &counter};
+            DO_NOT_OPTIMIZE_AWAY(task);
+        }
+    };
+}
+
+// Recursive fork-join through awaitable tasks, each fork creates a 'std::promise<>' / 'std::future<>' pair
+inline int fibonacci_futures(parallel::ThreadPool& pool, int n) {
+    if (n < 2) return n;
+
+    auto future_prev_1 = pool.awaitable_task([&] { return fibonacci_futures(pool, n - 1); });
+    auto future_prev_2 = pool.awaitable_task([&] { return fibonacci_futures(pool, n - 2); });
+
+    return future_prev_1.get() + future_prev_2.get();
+}
+
+// Recursive fork-join through a task group, all of the state stays on the stack
+inline int fibonacci_group(parallel::ThreadPool& pool, int n) {
+    if (n < 2) return n;
+
+    int prev_1 = 0, prev_2 = 0;
+
+    parallel::TaskGroup group(pool);
+    group.run([&] { prev_1 = fibonacci_group(pool, n - 1); });
+    prev_2 = fibonacci_group(pool, n - 2);
+    group.wait();
+
+    return prev_1 + prev_2;
+}
+
+constexpr int fibonacci_n = 20; // makes 'fibonacci(21) - 1 = 10945' forks, close to 'task_count'
+
+template <int (*fibonacci)(parallel::ThreadPool&, int)>
+auto make_fork_join(parallel::ThreadPool& pool, std::atomic<std::size_t>& counter) {
+    return [&] {
+        pool.awaitable_task([&] { counter += fibonacci(pool, fibonacci_n); }).wait();
+    };
+}
+
+template <class Func>
+void count_allocations(const std::string& name, Func submission) {
+    submission(); // warm up so the queues & node caches get to their steady-state capacity
+
+    const std::size_t allocations_before = allocation_count;
+    submission();
+    const std::size_t allocations_after = allocation_count;
+
+    println(name, " -> ", double(allocations_after - allocations_before) / task_count, " allocations per task");
+}
+
+// ========================
+// --- Benchmark runner ---
+// ========================
+
+int main() {
+    bench.timeUnit(1ms, "ms").minEpochTime(100ms).maxEpochTime(1s).relative(true); // global options
+
+    parallel::ThreadPool     pool(parallel::hardware_concurrency());
+    std::atomic<std::size_t> counter = 0;
+
+    // clang-format off
+    println("\n--- Allocations per task ---\n");
+    count_allocations("std::function   [ 16 byte closure]", make_std_function_construction< 16>(      counter));
+    count_allocations("std::function   [ 48 byte closure]", make_std_function_construction< 48>(      counter));
+    count_allocations("std::function   [128 byte closure]", make_std_function_construction<128>(      counter));
+    count_allocations("External tasks  [ 16 byte closure]", make_external_submission      < 16>(pool, counter));
+    count_allocations("External tasks  [ 48 byte closure]", make_external_submission      < 48>(pool, counter));
+    count_allocations("External tasks  [128 byte closure]", make_external_submission      <128>(pool, counter));
+    count_allocations("Recursive tasks [ 16 byte closure]", make_recursive_submission     < 16>(pool, counter));
+    count_allocations("Recursive tasks [ 48 byte closure]", make_recursive_submission     < 48>(pool, counter));
+    count_allocations("Recursive tasks [128 byte closure]", make_recursive_submission     <128>(pool, counter));
+    count_allocations("Fork-join       [awaitable tasks ]", make_fork_join<fibonacci_futures>(pool, counter));
+    count_allocations("Fork-join       [task group      ]", make_fork_join<fibonacci_group  >(pool, counter));
+    println();
+    
+    bench.title("Task submission");
+    benchmark("External tasks  [ 16 byte closure]", make_external_submission     < 16>(pool, counter));
+    benchmark("External tasks  [ 48 byte closure]", make_external_submission     < 48>(pool, counter));
+    benchmark("External tasks  [128 byte closure]", make_external_submission     <128>(pool, counter));
+    benchmark("External batch  [ 16 byte closure]", make_external_bulk_submission< 16>(pool, counter));
+    benchmark("External batch  [ 48 byte closure]", make_external_bulk_submission< 48>(pool, counter));
+    benchmark("Recursive tasks [ 16 byte closure]", make_recursive_submission    < 16>(pool, counter));
+    benchmark("Recursive tasks [ 48 byte closure]", make_recursive_submission    < 48>(pool, counter));
+    benchmark("Recursive tasks [128 byte closure]", make_recursive_submission    <128>(pool, counter));
+    
+    bench.title("Fork-join");
+    benchmark("Awaitable tasks", make_fork_join<fibonacci_futures>(pool, counter));
+    benchmark("Task group",      make_fork_join<fibonacci_group  >(pool, counter));
+    // clang-format on
+}
@@ -13,7 +13,8 @@
 #include "benchmarks/thirdparty/progschj/ThreadPool.h"
 
 // Standard headers
-// None
+#include <cmath>  // sin()
+#include <string> // to_string()
 
 // ____________________ IMPLEMENTATION ____________________
 
@@ -197,6 +198,25 @@ void benchmark_thread_pool(const char* name) {
 
 #define BENCHMARK_THREAD_POOL(pool_, task_) benchmark_thread_pool<pool_, task_>(#pool_)
 
+// Fine-grained loops stress scheduling rather than the task execution itself, which makes them a good measure
+// of how well the pool scales with thread count when most of the time is spent pushing / popping / stealing
+
+constexpr std::size_t loop_size  = 1'000'000;
+constexpr std::size_t loop_grain = 250; // ~4000 tasks per loop
+
+inline void benchmark_loop_scaling(std::size_t thread_count) {
+    parallel::Scheduler<> scheduler(thread_count);
+
+    std::vector<double> data(loop_size, 0.5);
+
+    benchmark("parallel::Scheduler (" + std::to_string(thread_count) + " threads)", [&] {
+        scheduler.blocking_loop(parallel::IndexRange<std::size_t>{0, loop_size, loop_grain},
+                                [&](std::size_t i) { data[i] = std::sin(data[i]); });
+
+        DO_NOT_OPTIMIZE_AWAY(data.data());
+    });
+}
+
 // ========================
 // --- Benchmark runner ---
 // ========================
@@ -231,4 +251,9 @@ int main() {
     benchmark_thread_pool<parallel::ThreadPool, DeepRecursiveTask>("parallel::ThreadPool");
     // others deadlock
     // clang-format on
+
+    bench.title("Fine-grained parallel loop scaling");
+    for (std::size_t thread_count = 1; thread_count < parallel::hardware_concurrency(); thread_count *= 2)
+        benchmark_loop_scaling(thread_count);
+    benchmark_loop_scaling(parallel::hardware_concurrency());
 }
\ No newline at end of file
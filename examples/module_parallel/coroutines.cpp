@@ -0,0 +1,23 @@
+#include "include/UTL/parallel.hpp"
+
+#include <cassert>
+
+// Requires C++20
+utl::parallel::Coroutine<int> square(int x) {
+    using namespace utl;
+    
+    co_await parallel::schedule(); // continue on the thread pool
+    co_return x * x;
+}
+
+utl::parallel::Coroutine<int> sum_of_squares(int x, int y) {
+    using namespace utl;
+    
+    // Suspends until both children finish, doesn't block a thread in the meantime
+    auto [x2, y2] = co_await parallel::when_all(square(x), square(y));
+    co_return x2 + y2;
+}
+
+int main() {
+    assert( sum_of_squares(3, 4).get() == 25 );
+}
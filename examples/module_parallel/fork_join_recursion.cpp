@@ -0,0 +1,33 @@
+#include "include/UTL/parallel.hpp"
+
+#include <cassert>
+#include <vector>
+
+// Deeply recursive illustrative task, not a practical way of computing fibonacci numbers
+int fibonacci(int n) {
+    using namespace utl;
+    
+    if (n < 2) return n;
+    
+    int prev_1 = 0, prev_2 = 0;
+    
+    // Runs both branches in parallel, no futures get allocated
+    parallel::invoke([&] { prev_1 = fibonacci(n - 1); }, [&] { prev_2 = fibonacci(n - 2); });
+    
+    return prev_1 + prev_2;
+}
+
+int main() {
+    using namespace utl;
+    
+    assert( fibonacci(8) == 21 );
+    
+    // Task groups allow spawning a dynamic number of children
+    std::vector<int> results(10);
+    
+    parallel::TaskGroup group;
+    for (std::size_t i = 0; i < results.size(); ++i) group.run([&, i] { results[i] = fibonacci(int(i)); });
+    group.wait();
+    
+    assert( results[9] == 34 );
+}
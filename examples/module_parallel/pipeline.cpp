@@ -0,0 +1,30 @@
+#include "include/UTL/parallel.hpp"
+
+#include <cassert>
+#include <optional>
+#include <string>
+#include <vector>
+
+int main() {
+    using namespace utl;
+    
+    const std::vector<std::string> lines = {"1", "2", "3", "4", "5", "6", "7", "8"};
+    
+    std::size_t      next = 0;
+    std::vector<int> output;
+    
+    parallel::pipeline(
+        4, // at most 4 lines are processed at the same time
+        // Read lines one by one
+        [&]() -> std::optional<std::string> {
+            if (next == lines.size()) return std::nullopt;
+            return lines[next++];
+        },
+        // Parse & transform lines in parallel
+        parallel::stage(parallel::StageMode::parallel, [](std::string line) { return std::stoi(line) * 10; }),
+        // Write results serially, in the original order
+        parallel::stage(parallel::StageMode::serial_in_order, [&](int value) { output.push_back(value); })
+    );
+    
+    assert( output == std::vector<int>({10, 20, 30, 40, 50, 60, 70, 80}) );
+}
@@ -16,4 +16,10 @@ int main() {
     const double subrange_sum = parallel::blocking_reduce(parallel::Range{vals.begin() + 100, vals.end()}, parallel::sum<>{});
     
     assert( subrange_sum == (200'000 - 100) * 2 );
+    
+    // Fuse transformation with the reduction
+    const double dot = parallel::blocking_transform_reduce(parallel::IndexRange<std::size_t>{0, vals.size()}, 0.0,
+                                                           parallel::sum<>{}, [&](std::size_t i) { return vals[i] * vals[i]; });
+    
+    assert( dot == 200'000 * 4 );
 }
\ No newline at end of file
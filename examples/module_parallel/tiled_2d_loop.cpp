@@ -0,0 +1,24 @@
+#include "include/UTL/parallel.hpp"
+
+#include <cassert>
+#include <vector>
+
+int main() {
+    using namespace utl;
+    
+    constexpr std::size_t rows = 300, cols = 400;
+    
+    std::vector<double> input(rows * cols, 1.0), output(rows * cols, 0.0);
+    
+    // 5-point stencil over the interior, processed in 32x64 tiles ordered along a Hilbert curve
+    const parallel::IndexRange2D range{{1, rows - 1, 32}, {1, cols - 1, 64}, parallel::TileOrder::hilbert};
+    
+    parallel::blocking_loop(range, [&](std::size_t i_low, std::size_t i_high, std::size_t j_low, std::size_t j_high) {
+        for (std::size_t i = i_low; i < i_high; ++i)
+            for (std::size_t j = j_low; j < j_high; ++j)
+                output[i * cols + j] = input[(i - 1) * cols + j] + input[(i + 1) * cols + j] +
+                                       input[i * cols + j - 1] + input[i * cols + j + 1] - 4 * input[i * cols + j];
+    });
+    
+    assert( output[cols + 1] == 0.0 );
+}
@@ -14,8 +14,8 @@
 #define utl_json_headerguard
 
 #define UTL_JSON_VERSION_MAJOR 1
-#define UTL_JSON_VERSION_MINOR 1
-#define UTL_JSON_VERSION_PATCH 5
+#define UTL_JSON_VERSION_MINOR 2
+#define UTL_JSON_VERSION_PATCH 0
 
 // _______________________ INCLUDES _______________________
 
@@ -25,14 +25,18 @@
 #include <cstdint>          // uint8_t, uint16_t, uint32_t
 #include <filesystem>       // create_directories()
 #include <fstream>          // ifstream, ofstream
+#include <functional>       // less<>
 #include <initializer_list> // initializer_list<>
+#include <istream>          // istream
 #include <limits>           // numeric_limits<>::max_digits10, numeric_limits<>::max_exponent10
 #include <map>              // map<>
-#include <stdexcept>        // runtime_error
+#include <memory>           // unique_ptr<>, make_unique<>(), align(), uninitialized_copy()
+#include <new>              // placement new
+#include <stdexcept>        // runtime_error, invalid_argument
 #include <string>           // string
 #include <string_view>      // string_view
 #include <type_traits>      // enable_if<>, is_convertible<>, is_same<>, conjunction<>, disjunction<>, negation<>, ...
-#include <utility>          // move(), declval<>()
+#include <utility>          // move(), declval<>(), pair<>, exchange()
 #include <variant>          // variant<>
 #include <vector>           // vector<>
 
@@ -529,14 +533,14 @@ class Node {
 
     [[nodiscard]] bool contains(std::string_view key) const {
         const auto& object = this->get_object();
-        const auto  it     = object.find(std::string(key));
+        const auto  it     = object.find(key);
         return it != object.end();
     }
 
     template <class T>
     [[nodiscard]] const T& value_or(std::string_view key, const T& else_value) const {
         const auto& object = this->get_object();
-        const auto  it     = object.find(std::string(key));
+        const auto  it     = object.find(key);
         if (it != object.end()) return it->second.get<T>();
         return else_value;
         // same thing as 'this->contains(key) ? json.at(key).get<T>() : else_value' but without a second map lookup
@@ -746,7 +750,7 @@ class Node {
     // ------------------
 
     template <class T>
-    [[nodiscard]] T to_struct() const {
+    [[nodiscard]] T to_struct() const& {
         static_assert(
             always_false_v<T>,
             "Provided type doesn't have a defined JSON reflection. Use 'UTL_JSON_REFLECT' macro to define one.");
@@ -760,6 +764,16 @@ class Node {
         // macros outside the class body, this is a perfectly legal thing to do, even if unintuitive compared
         // to non-template members, see https://en.cppreference.com/w/cpp/language/member_template
     }
+
+    template <class T>
+    [[nodiscard]] T to_struct() && {
+        static_assert(
+            always_false_v<T>,
+            "Provided type doesn't have a defined JSON reflection. Use 'UTL_JSON_REFLECT' macro to define one.");
+        return {};
+        // same as above, 'std::move(node).to_struct<T>()' moves strings & containers out of the node
+        // instead of copying them, which leaves the node in a valid but unspecified state
+    }
 };
 
 // Public typedefs
@@ -910,9 +924,33 @@ struct Parser {
 
     // dynamic allocation errors can be handled with regular exceptions through std::bad_alloc
 
+    std::string string_buffer; // storage for escaped strings that can't be viewed directly in 'chars'
+
     Parser() = delete;
     Parser(const std::string& chars, unsigned int& recursion_limit) : chars(chars), recursion_limit(recursion_limit) {}
 
+    void enter_nested_node() {
+        using namespace std::string_literals;
+
+        if (++this->recursion_depth > this->recursion_limit)
+            throw std::runtime_error("JSON parser has exceeded maximum allowed recursion depth of "s +
+                                     std::to_string(this->recursion_limit) +
+                                     ". If stated depth wasn't caused by an invalid input, "s +
+                                     "recursion limit can be increased in the parser."s);
+    }
+
+    void exit_nested_node() { --this->recursion_depth; }
+
+    [[noreturn]] void throw_missing_separator(std::size_t cursor, char closing) const {
+        using namespace std::string_literals;
+
+        const std::string node_name = (closing == '}') ? "object" : "array";
+
+        throw std::runtime_error("JSON "s + node_name + " node could not find comma {,} or "s + node_name +
+                                 " ending symbol {"s + closing + "} after the element at pos "s +
+                                 std::to_string(cursor) + "."s + pretty_error(cursor, this->chars));
+    }
+
     std::size_t skip_nonsignificant_whitespace(std::size_t cursor) {
         using namespace std::string_literals;
 
@@ -976,16 +1014,12 @@ struct Parser {
         cursor = this->skip_nonsignificant_whitespace(cursor);
 
         // Parse pair value
-        if (++this->recursion_depth > this->recursion_limit)
-            throw std::runtime_error("JSON parser has exceeded maximum allowed recursion depth of "s +
-                                     std::to_string(this->recursion_limit) +
-                                     ". If stated depth wasn't caused by an invalid input, "s +
-                                     "recursion limit can be increased in the parser."s);
+        this->enter_nested_node();
 
         Node value;
         std::tie(cursor, value) = this->parse_node(cursor);
 
-        --this->recursion_depth;
+        this->exit_nested_node();
 
         // Note 1:
         // The question of whether JSON allows duplicate keys is non-trivial but the resulting answer is YES.
@@ -1066,9 +1100,7 @@ struct Parser {
                 ++cursor; // move past the closing brace '}'
                 return {cursor, std::move(object_value)};
             } else {
-                throw std::runtime_error(
-                    "JSON array node could not find comma {,} or object ending symbol {}} after the element at pos "s +
-                    std::to_string(cursor) + "."s + pretty_error(cursor, this->chars));
+                this->throw_missing_separator(cursor, '}');
             }
         }
 
@@ -1081,17 +1113,13 @@ struct Parser {
 
         // Array element parser assumes it is starting at the first symbol of some JSON node
 
-        // Parse pair key
-        if (++this->recursion_depth > this->recursion_limit)
-            throw std::runtime_error("JSON parser has exceeded maximum allowed recursion depth of "s +
-                                     std::to_string(this->recursion_limit) +
-                                     ". If stated depth wasn't caused by an invalid input, "s +
-                                     "recursion limit can be increased with json::set_recursion_limit()."s);
+        // Parse array element
+        this->enter_nested_node();
 
         Node value;
         std::tie(cursor, value) = this->parse_node(cursor);
 
-        --this->recursion_depth;
+        this->exit_nested_node();
 
         parent.emplace_back(std::move(value));
 
@@ -1129,13 +1157,11 @@ struct Parser {
                 ++cursor; // move past the closing bracket ']'
                 return {cursor, std::move(array_value)};
             } else {
-                throw std::runtime_error(
-                    "JSON array node could not find comma {,} or array ending symbol {]} after the element at pos "s +
-                    std::to_string(cursor) + "."s + pretty_error(cursor, this->chars));
+                this->throw_missing_separator(cursor, ']');
             }
         }
 
-        throw std::runtime_error("JSON array node reached the end of buffer while parsing object contents." +
+        throw std::runtime_error("JSON array node reached the end of buffer while parsing array contents." +
                                  pretty_error(cursor, this->chars));
     }
 
@@ -1390,6 +1416,101 @@ struct Parser {
 
         return {cursor + token_length, Null()};
     }
+
+    // --- Non-allocating parsing ---
+    // ------------------------------
+
+    // Methods below are used by the direct 'string -> struct' parsing (see 'from_string_to()'),
+    // which matches object keys against field names & skips unknown members without building any nodes
+
+    std::pair<std::size_t, std::string_view> parse_string_view(std::size_t cursor) {
+        // Most strings (and almost all object keys) have no escape sequences, such strings can be
+        // viewed directly inside the buffer, otherwise we fall back onto the regular string parsing
+        for (std::size_t i = cursor + 1; i < this->chars.size(); ++i) {
+            const char c = this->chars[i];
+            if (c == '"') return {i + 1, std::string_view(this->chars.data() + cursor + 1, i - cursor - 1)};
+            if (c == '\\' || u8(c) <= 31) break;
+        }
+
+        std::tie(cursor, this->string_buffer) = this->parse_string(cursor);
+        return {cursor, this->string_buffer};
+        // returned view is only valid until the next call, which is fine since all we do with it is a comparison
+    }
+
+    std::pair<std::size_t, std::string_view> parse_object_key(std::size_t cursor) {
+        using namespace std::string_literals;
+
+        // Object key parser assumes it is starting at a significant symbol,
+        // leaves the cursor at the first significant symbol of the value
+
+        if (this->chars[cursor] != '"')
+            throw std::runtime_error("JSON object node encountered unexpected symbol {"s + this->chars[cursor] +
+                                     "} at pos "s + std::to_string(cursor) + " (should be {\"})."s +
+                                     pretty_error(cursor, this->chars));
+
+        std::string_view key;
+        std::tie(cursor, key) = this->parse_string_view(cursor);
+
+        cursor = this->skip_nonsignificant_whitespace(cursor);
+        if (this->chars[cursor] != ':')
+            throw std::runtime_error("JSON object node encountered unexpected symbol {"s + this->chars[cursor] +
+                                     "} after the pair key at pos "s + std::to_string(cursor) + " (should be {:})."s +
+                                     pretty_error(cursor, this->chars));
+        ++cursor; // move past the colon ':'
+        cursor = this->skip_nonsignificant_whitespace(cursor);
+
+        return {cursor, key};
+    }
+
+    // Parses contents of an object / array up to the 'closing' symbol, 'parse_element' is invoked with a cursor
+    // at the first symbol of each element and should return the cursor past its end. Same logic as in
+    // 'parse_object()' / 'parse_array()', but generic over what we actually do with the elements.
+    template <class Func>
+    std::size_t parse_sequence(std::size_t cursor, char closing, Func&& parse_element) {
+        using namespace std::string_literals;
+
+        ++cursor; // move past the opening brace '{' / bracket '['
+
+        cursor = this->skip_nonsignificant_whitespace(cursor);
+        if (this->chars[cursor] == closing) return cursor + 1;
+
+        while (cursor < this->chars.size()) {
+            this->enter_nested_node();
+            cursor = parse_element(cursor);
+            this->exit_nested_node();
+
+            cursor       = this->skip_nonsignificant_whitespace(cursor);
+            const char c = this->chars[cursor];
+
+            if (c == ',') {
+                ++cursor; // move past the comma ','
+                cursor = this->skip_nonsignificant_whitespace(cursor);
+            } else if (c == closing) {
+                return cursor + 1; // move past the closing brace '}' / bracket ']'
+            } else {
+                this->throw_missing_separator(cursor, closing);
+            }
+        }
+
+        throw std::runtime_error("JSON parser reached the end of buffer while parsing object / array contents." +
+                                 pretty_error(cursor, this->chars));
+    }
+
+    std::size_t skip_node(std::size_t cursor) {
+        // Validates the node just like 'parse_node()' would, but doesn't construct it
+        const char c = this->chars[cursor];
+
+        if (c == '{') {
+            const auto skip_pair = [&](std::size_t pos) { return this->skip_node(this->parse_object_key(pos).first); };
+            return this->parse_sequence(cursor, '}', skip_pair);
+        } else if (c == '[') {
+            const auto skip_element = [&](std::size_t pos) { return this->skip_node(pos); };
+            return this->parse_sequence(cursor, ']', skip_element);
+        } else if (c == '"') {
+            return this->parse_string_view(cursor).first;
+        }
+        return this->parse_node(cursor).first; // numbers, bools & nulls don't allocate anyway
+    }
 };
 
 
@@ -1397,6 +1518,58 @@ struct Parser {
 // --- JSON Serializing impl. ---
 // ==============================
 
+inline void serialize_json_string(std::string_view string_value, std::string& chars) {
+    chars += '"';
+
+    // Serialize string while handling escape sequences.
+    /// Without escape sequences we could just do 'chars += string_value'.
+    //
+    // Since appending individual characters is ~twice as slow as appending the whole string, we use a
+    // "buffered" way of appending, appending whole segments up to the currently escaped char.
+    // Strings with no escaped chars get appended in a single call.
+    //
+    std::size_t segment_start = 0;
+    for (std::size_t i = 0; i < string_value.size(); ++i) {
+        if (const char escaped_char_replacement = lookup_serialized_escaped_chars[u8(string_value[i])]) {
+            chars.append(string_value.data() + segment_start, i - segment_start);
+            chars += '\\';
+            chars += escaped_char_replacement;
+            segment_start = i + 1; // skip over the "actual" technical character in the string
+        }
+    }
+    chars.append(string_value.data() + segment_start, string_value.size() - segment_start);
+
+    chars += '"';
+}
+
+inline void serialize_json_number(Number number_value, std::string& chars) {
+    using namespace std::string_literals;
+
+    constexpr int max_exponent = std::numeric_limits<Number>::max_exponent10;
+    constexpr int max_digits   = 4 + std::numeric_limits<Number>::max_digits10 + std::max(2, log10_ceil(max_exponent));
+    // should be the smallest buffer size to account for all possible 'std::to_chars()' outputs,
+    // see [https://stackoverflow.com/questions/68472720/stdto-chars-minimal-floating-point-buffer-size]
+
+    std::array<char, max_digits> buffer;
+
+    const auto [number_end_ptr, error_code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), number_value);
+
+    if (error_code != std::errc{})
+        throw std::runtime_error(
+            "JSON serializing encountered std::to_chars() formatting error while serializing value {"s +
+            std::to_string(number_value) + "}."s);
+
+    // Save NaN/Inf cases as strings, since JSON spec doesn't include IEEE 754.
+    // (!) May result in non-homogenous arrays like [ 1.0, "inf" , 3.0, 4.0, "nan" ]
+    if (std::isfinite(number_value)) {
+        chars.append(buffer.data(), number_end_ptr - buffer.data());
+    } else {
+        chars += '"';
+        chars.append(buffer.data(), number_end_ptr - buffer.data());
+        chars += '"';
+    }
+}
+
 template <bool prettify>
 inline void serialize_json_recursion(const Node& node, std::string& chars, unsigned int indent_level = 0,
                                      bool skip_first_indent = false) {
@@ -1498,61 +1671,11 @@ inline void serialize_json_recursion(const Node& node, std::string& chars, unsig
     }
     // String
     else if (node.is_string()) {
-        const auto& string_value = node.get_string();
-
-        chars += '"';
-
-        // Serialize string while handling escape sequences.
-        /// Without escape sequences we could just do 'chars += string_value'.
-        //
-        // Since appending individual characters is ~twice as slow as appending the whole string, we use a
-        // "buffered" way of appending, appending whole segments up to the currently escaped char.
-        // Strings with no escaped chars get appended in a single call.
-        //
-        std::size_t segment_start = 0;
-        for (std::size_t i = 0; i < string_value.size(); ++i) {
-            if (const char escaped_char_replacement = lookup_serialized_escaped_chars[u8(string_value[i])]) {
-                chars.append(string_value.data() + segment_start, i - segment_start);
-                chars += '\\';
-                chars += escaped_char_replacement;
-                segment_start = i + 1; // skip over the "actual" technical character in the string
-            }
-        }
-        chars.append(string_value.data() + segment_start, string_value.size() - segment_start);
-
-        chars += '"';
+        serialize_json_string(node.get_string(), chars);
     }
     // Number
     else if (node.is_number()) {
-        const auto& number_value = node.get_number();
-
-        constexpr int max_exponent = std::numeric_limits<Number>::max_exponent10;
-        constexpr int max_digits =
-            4 + std::numeric_limits<Number>::max_digits10 + std::max(2, log10_ceil(max_exponent));
-        // should be the smallest buffer size to account for all possible 'std::to_chars()' outputs,
-        // see [https://stackoverflow.com/questions/68472720/stdto-chars-minimal-floating-point-buffer-size]
-
-        std::array<char, max_digits> buffer;
-
-        const auto [number_end_ptr, error_code] =
-            std::to_chars(buffer.data(), buffer.data() + buffer.size(), number_value);
-
-        if (error_code != std::errc{})
-            throw std::runtime_error(
-                "JSON serializing encountered std::to_chars() formatting error while serializing value {"s +
-                std::to_string(number_value) + "}."s);
-
-        const std::string_view number_string(buffer.data(), number_end_ptr - buffer.data());
-
-        // Save NaN/Inf cases as strings, since JSON spec doesn't include IEEE 754.
-        // (!) May result in non-homogenous arrays like [ 1.0, "inf" , 3.0, 4.0, "nan" ]
-        if (std::isfinite(number_value)) {
-            chars.append(buffer.data(), number_end_ptr - buffer.data());
-        } else {
-            chars += '"';
-            chars.append(buffer.data(), number_end_ptr - buffer.data());
-            chars += '"';
-        }
+        serialize_json_number(node.get_number(), chars);
     }
     // Bool
     else if (node.is_bool()) {
@@ -1605,6 +1728,293 @@ namespace literals {
 }
 } // namespace literals
 
+// ===================
+// --- SAX parsing ---
+// ===================
+
+// Event-based parsing, instead of constructing a 'Node' the parser invokes 'Handler' methods for every
+// JSON value it encounters, which allows processing arbitrarily large inputs with constant memory usage.
+// Token-level parsing & error reporting are shared with the regular 'Parser', on top of that we only
+// need to handle the structure & keep a sliding window over the stream so tokens can span chunk borders.
+
+// Base for user-defined handlers, derived classes can "override" only the events they're interested in,
+// handler is a template parameter of the parser so there is no need for virtual dispatch
+struct SaxHandler {
+    void on_object_begin() {}
+    void on_object_end() {}
+    void on_array_begin() {}
+    void on_array_end() {}
+    void on_key(std::string_view) {}
+    void on_string(std::string_view) {}
+    void on_number(Number) {}
+    void on_bool(Bool) {}
+    void on_null() {}
+};
+
+constexpr std::size_t default_sax_chunk_size = 64 * 1024;
+
+template <class Handler>
+struct SaxParser {
+    std::string   buffer; // sliding window over the stream, unused when parsing an in-memory string
+    Parser        parser; // initialized after the 'buffer' since it might reference it
+    Handler&      handler;
+    std::istream* stream     = nullptr;
+    std::size_t   chunk_size = default_sax_chunk_size;
+    std::size_t   cursor     = 0;
+
+    SaxParser() = delete;
+    SaxParser(const std::string& chars, Handler& handler, unsigned int& recursion_limit)
+        : parser(chars, recursion_limit), handler(handler) {}
+    SaxParser(std::istream& stream, Handler& handler, unsigned int& recursion_limit, std::size_t chunk_size)
+        : parser(this->buffer, recursion_limit), handler(handler), stream(&stream), chunk_size(chunk_size) {}
+
+    [[nodiscard]] const std::string& chars() const noexcept { return this->parser.chars; }
+
+    // Discards everything before the cursor & reads the next chunk, returns 'false' once the input is exhausted.
+    // Cursor always points to the start of the token we're currently parsing, so the token will stay whole.
+    bool refill() {
+        if (!this->stream) return false;
+
+        this->buffer.erase(0, this->cursor);
+        this->cursor = 0;
+
+        const std::size_t old_size = this->buffer.size();
+        this->buffer.resize(old_size + this->chunk_size);
+        this->stream->read(this->buffer.data() + old_size, static_cast<std::streamsize>(this->chunk_size));
+        this->buffer.resize(old_size + static_cast<std::size_t>(this->stream->gcount()));
+
+        return this->buffer.size() > old_size;
+    }
+
+    // Makes sure that 'count' chars past the cursor are buffered, unless the input ends first
+    void ensure_available(std::size_t count) {
+        if (!this->stream) return; // in-memory input is always fully available
+
+        while (this->cursor + count > this->chars().size())
+            if (!this->refill()) return;
+    }
+
+    // Returns 'false' if the input ends before a significant symbol
+    bool try_skip_nonsignificant_whitespace() {
+        while (true) {
+            while (this->cursor < this->chars().size() && lookup_whitespace_chars[u8(this->chars()[this->cursor])])
+                ++this->cursor;
+            if (this->cursor < this->chars().size()) return true;
+            if (!this->refill()) return false;
+        }
+    }
+
+    void skip_nonsignificant_whitespace() {
+        if (!this->try_skip_nonsignificant_whitespace()) this->parser.skip_nonsignificant_whitespace(this->cursor);
+        // regular parser will throw a proper "end of buffer" error
+    }
+
+    // Buffers the whole string token starting at the cursor, the string itself gets validated later.
+    // Offsets are relative to the cursor, since refills shift the buffer.
+    void buffer_string() {
+        if (!this->stream) return; // in-memory input is always fully available
+
+        for (std::size_t offset = 1;; ++offset) {
+            while (this->cursor + offset >= this->chars().size())
+                if (!this->refill()) return;
+
+            const char c = this->chars()[this->cursor + offset];
+            if (c == '\\') ++offset; // skip escaped char, this also covers '\"'
+            else if (c == '"') return;
+        }
+    }
+
+    // Buffers the whole number token starting at the cursor, the number itself gets validated later.
+    // We buffer up to the next delimiter rather than just the numeric chars, since 'from_chars()' also
+    // accepts things like 'nan' & 'inf' and we want to have the exact same behavior as the regular parser.
+    void buffer_number() {
+        if (!this->stream) return; // in-memory input is always fully available
+
+        const auto is_delimiter = [](char c) {
+            return lookup_whitespace_chars[u8(c)] || c == ',' || c == ']' || c == '}';
+        };
+
+        for (std::size_t offset = 0;; ++offset) {
+            while (this->cursor + offset >= this->chars().size())
+                if (!this->refill()) return;
+
+            if (is_delimiter(this->chars()[this->cursor + offset])) return;
+        }
+    }
+
+    void parse_node() {
+        const char c = this->chars()[this->cursor];
+
+        if (c == '{') {
+            this->parse_object();
+        } else if (c == '[') {
+            this->parse_array();
+        } else if (c == '"') {
+            this->buffer_string();
+            const auto [end_cursor, string_value] = this->parser.parse_string_view(this->cursor);
+            this->handler.on_string(string_value);
+            this->cursor = end_cursor;
+        } else if (('0' <= c && c <= '9') || (c == '-')) {
+            this->buffer_number();
+            const auto [end_cursor, number_value] = this->parser.parse_number(this->cursor);
+            this->handler.on_number(number_value);
+            this->cursor = end_cursor;
+        } else if (c == 't') {
+            this->ensure_available(4);
+            const auto [end_cursor, bool_value] = this->parser.parse_true(this->cursor);
+            this->handler.on_bool(bool_value);
+            this->cursor = end_cursor;
+        } else if (c == 'f') {
+            this->ensure_available(5);
+            const auto [end_cursor, bool_value] = this->parser.parse_false(this->cursor);
+            this->handler.on_bool(bool_value);
+            this->cursor = end_cursor;
+        } else if (c == 'n') {
+            this->ensure_available(4);
+            this->cursor = this->parser.parse_null(this->cursor).first;
+            this->handler.on_null();
+        } else {
+            this->parser.parse_node(this->cursor); // regular parser will throw a proper "unexpected symbol" error
+        }
+    }
+
+    void parse_object() {
+        using namespace std::string_literals;
+
+        this->handler.on_object_begin();
+        ++this->cursor; // move past the opening brace '{'
+
+        this->skip_nonsignificant_whitespace();
+        if (this->chars()[this->cursor] == '}') {
+            ++this->cursor; // move past the closing brace '}'
+            this->handler.on_object_end();
+            return;
+        }
+
+        while (true) {
+            // Parse pair key
+            if (this->chars()[this->cursor] != '"')
+                throw std::runtime_error("JSON object node encountered unexpected symbol {"s +
+                                         this->chars()[this->cursor] + "} at pos "s + std::to_string(this->cursor) +
+                                         " (should be {\"})."s + pretty_error(this->cursor, this->chars()));
+
+            this->buffer_string();
+            const auto [key_end_cursor, key] = this->parser.parse_string_view(this->cursor);
+            this->handler.on_key(key);
+            this->cursor = key_end_cursor;
+
+            // Handle stuff in-between
+            this->skip_nonsignificant_whitespace();
+            if (this->chars()[this->cursor] != ':')
+                throw std::runtime_error("JSON object node encountered unexpected symbol {"s +
+                                         this->chars()[this->cursor] + "} after the pair key at pos "s +
+                                         std::to_string(this->cursor) + " (should be {:})."s +
+                                         pretty_error(this->cursor, this->chars()));
+            ++this->cursor; // move past the colon ':'
+            this->skip_nonsignificant_whitespace();
+
+            // Parse pair value
+            this->parser.enter_nested_node();
+            this->parse_node();
+            this->parser.exit_nested_node();
+
+            // Handle comma / object end
+            this->skip_nonsignificant_whitespace();
+            const char c = this->chars()[this->cursor];
+
+            if (c == ',') {
+                ++this->cursor; // move past the comma ','
+                this->skip_nonsignificant_whitespace();
+            } else if (c == '}') {
+                ++this->cursor; // move past the closing brace '}'
+                this->handler.on_object_end();
+                return;
+            } else {
+                this->parser.throw_missing_separator(this->cursor, '}');
+            }
+        }
+    }
+
+    void parse_array() {
+        using namespace std::string_literals;
+
+        this->handler.on_array_begin();
+        ++this->cursor; // move past the opening bracket '['
+
+        this->skip_nonsignificant_whitespace();
+        if (this->chars()[this->cursor] == ']') {
+            ++this->cursor; // move past the closing bracket ']'
+            this->handler.on_array_end();
+            return;
+        }
+
+        while (true) {
+            // Parse element
+            this->parser.enter_nested_node();
+            this->parse_node();
+            this->parser.exit_nested_node();
+
+            // Handle comma / array end
+            this->skip_nonsignificant_whitespace();
+            const char c = this->chars()[this->cursor];
+
+            if (c == ',') {
+                ++this->cursor; // move past the comma ','
+                this->skip_nonsignificant_whitespace();
+            } else if (c == ']') {
+                ++this->cursor; // move past the closing bracket ']'
+                this->handler.on_array_end();
+                return;
+            } else {
+                this->parser.throw_missing_separator(this->cursor, ']');
+            }
+        }
+    }
+
+    void parse() {
+        using namespace std::string_literals;
+
+        this->skip_nonsignificant_whitespace(); // skip leading whitespace
+        this->parse_node();                     // starts parsing recursively from the root node
+
+        // Check for invalid trailing symbols
+        if (this->try_skip_nonsignificant_whitespace())
+            throw std::runtime_error("Invalid trailing symbols encountered after the root JSON node at pos "s +
+                                     std::to_string(this->cursor) + "."s + pretty_error(this->cursor, this->chars()));
+    }
+};
+
+// Note:
+// When parsing a stream, error positions are counted from the start of the currently buffered window,
+// the context printed by 'pretty_error()' is still accurate
+
+template <class Handler>
+void sax_from_string(const std::string& chars, Handler& handler,
+                     unsigned int recursion_limit = default_recursion_limit) {
+    SaxParser<Handler>(chars, handler, recursion_limit).parse();
+}
+
+template <class Handler>
+void sax_from_stream(std::istream& stream, Handler& handler,
+                     unsigned int recursion_limit = default_recursion_limit,
+                     std::size_t  chunk_size      = default_sax_chunk_size) {
+    if (chunk_size == 0) throw std::invalid_argument("JSON SAX parser requires a non-zero chunk size.");
+
+    SaxParser<Handler>(stream, handler, recursion_limit, chunk_size).parse();
+}
+
+template <class Handler>
+void sax_from_file(const std::string& filepath, Handler& handler,
+                   unsigned int recursion_limit = default_recursion_limit,
+                   std::size_t  chunk_size      = default_sax_chunk_size) {
+    using namespace std::string_literals;
+
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.good()) throw std::runtime_error("Could not open file {"s + filepath + "."s);
+
+    sax_from_stream(file, handler, recursion_limit, chunk_size);
+}
+
 // ============================
 // --- Structure reflection ---
 // ============================
@@ -1658,48 +2068,326 @@ void assign_value_to_node(Node& node, const T& value) {
 // --- to-struct utils ---
 // -----------------------
 
+// Member lookup for the 'to_struct()' codegen, returns 'nullptr' for missing keys so
+// we can check for presence and access the member with a single map lookup
+[[nodiscard]] inline const Node* find_member(const Node& node, std::string_view key) {
+    const auto& object = node.get_object();
+    const auto  it     = object.find(key);
+    return it != object.end() ? &it->second : nullptr;
+}
+
+[[nodiscard]] inline Node* find_member(Node& node, std::string_view key) {
+    auto&      object = node.get_object();
+    const auto it     = object.find(key);
+    return it != object.end() ? &it->second : nullptr;
+}
+
+// Forwards a part of the node with the value category of the node itself,
+// similar to C++23 'std::forward_like()', but we only need it for nodes
+template <class N, class T>
+[[nodiscard]] constexpr decltype(auto) forward_like_node(T& value) noexcept {
+    if constexpr (std::is_same_v<N, Node>) return std::move(value);
+    else return static_cast<const T&>(value);
+}
+
+template <class N>
+using enable_if_node_t = std::enable_if_t<std::is_same_v<std::decay_t<N>, Node>, bool>;
+
 // Assigning JSON node to a value for arbitrary type is a bit of an "incorrect" problem,
 // since we can't possibly know the API of the type we're assigning stuff to.
 // Object-like and array-like types need special handling that expands their nodes recursively,
 // we can't directly assign 'std::vector<Node>' to 'std::vector<double>' like we would with simpler types.
-template <class T>
-void assign_node_to_value_recursively(T& value, const Node& node) {
-    if constexpr (is_string_like_v<T>) value = node.get_string();
+//
+// Node is taken by a forwarding reference, nested objects & arrays are traversed in-place rather than
+// copied, when the node is an rvalue its strings get moved into the value instead of being copied.
+template <class T, class N, enable_if_node_t<N> = true>
+void assign_node_to_value_recursively(T& value, N&& node) {
+    if constexpr (is_string_like_v<T>) value = forward_like_node<N>(node.get_string());
     else if constexpr (is_object_like_v<T>) {
-        const auto object = node.get_object();
-        for (const auto& [key, val] : object) assign_node_to_value_recursively(value[key], val);
+        auto& object = node.get_object();
+        for (auto& [key, val] : object) assign_node_to_value_recursively(value[key], forward_like_node<N>(val));
     } else if constexpr (is_array_like_v<T>) {
-        const auto array = node.get_array();
+        auto& array = node.get_array();
         value.resize(array.size());
-        for (std::size_t i = 0; i < array.size(); ++i) assign_node_to_value_recursively(value[i], array[i]);
+        for (std::size_t i = 0; i < array.size(); ++i)
+            assign_node_to_value_recursively(value[i], forward_like_node<N>(array[i]));
     } else if constexpr (is_bool_like_v<T>) value = node.get_bool();
     else if constexpr (is_null_like_v<T>) value = node.get_null();
     else if constexpr (is_numeric_like_v<T>) value = static_cast<T>(node.get_number());
-    else if constexpr (is_reflected_struct<T>) value = node.to_struct<T>();
+    else if constexpr (is_reflected_struct<T>) value = std::forward<N>(node).template to_struct<T>();
     else static_assert(always_false_v<T>, "Method is a non-exhaustive visitor of std::variant<>.");
 }
 
 // Not sure how to generically handle array-like types with compile-time known size,
 // so we're just going to make a special case for 'std::array'
-template <class T, std::size_t N>
-void assign_node_to_value_recursively(std::array<T, N>& value, const Node& node) {
+template <class T, std::size_t size, class N, enable_if_node_t<N> = true>
+void assign_node_to_value_recursively(std::array<T, size>& value, N&& node) {
     using namespace std::string_literals;
 
-    const auto array = node.get_array();
+    auto& array = node.get_array();
 
     if (array.size() != value.size())
         throw std::runtime_error("JSON to structure serializer encountered non-mathing std::array size of "s +
                                  std::to_string(value.size()) + ", corresponding node has a size of "s +
                                  std::to_string(array.size()) + "."s);
 
-    for (std::size_t i = 0; i < array.size(); ++i) assign_node_to_value_recursively(value[i], array[i]);
+    for (std::size_t i = 0; i < array.size(); ++i)
+        assign_node_to_value_recursively(value[i], forward_like_node<N>(array[i]));
 }
 
 #define utl_json_to_struct_assign(fieldname_)                                                                          \
-    if (this->contains(#fieldname_)) assign_node_to_value_recursively(val.fieldname_, this->at(#fieldname_));
+    if (const auto* member = find_member(*this, #fieldname_)) assign_node_to_value_recursively(val.fieldname_, *member);
 // JSON might not have an entry corresponding to each structure member,
 // such members will stay defaulted according to the struct constructor
 
+#define utl_json_to_struct_move_assign(fieldname_)                                                                     \
+    if (auto* member = find_member(*this, #fieldname_))                                                                \
+        assign_node_to_value_recursively(val.fieldname_, std::move(*member));
+// same thing, but steals the member from an rvalue node
+
+// --- parse-to-struct utils ---
+// -----------------------------
+
+// Parsing text straight into the reflected structs, it follows the same conversion rules as
+// 'to_struct()', but skips the intermediate 'Node' tree entirely, strings / containers get constructed
+// directly in the struct fields and object keys are matched against field names as string views.
+// In case of duplicate keys the first occurrence wins, same as with 'from_string()'.
+
+template <class T>
+std::size_t parse_reflected_struct(Parser&, std::size_t cursor, T&) {
+    static_assert(always_false_v<T>,
+                  "Provided type doesn't have a defined JSON reflection. Use 'UTL_JSON_REFLECT' macro to define one.");
+    return cursor;
+    // specializations are defined by 'UTL_JSON_REFLECT', for every key they select the matching field and parse
+    // the value into it, unknown keys get skipped so the struct can be a subset of the JSON schema
+}
+
+inline void expect_symbol(const Parser& parser, std::size_t cursor, bool condition, std::string_view expected) {
+    using namespace std::string_literals;
+
+    if (!condition)
+        throw std::runtime_error("JSON to structure parser encountered unexpected symbol {"s + parser.chars[cursor] +
+                                 "} at pos "s + std::to_string(cursor) + " (should be the start of "s +
+                                 std::string(expected) + ")."s + pretty_error(cursor, parser.chars));
+}
+
+template <class T>
+std::size_t parse_to_value_recursively(Parser& parser, std::size_t cursor, T& value) {
+    const char c = parser.chars[cursor];
+
+    if constexpr (is_string_like_v<T>) {
+        expect_symbol(parser, cursor, c == '"', "a string");
+        std::tie(cursor, value) = parser.parse_string(cursor);
+    } else if constexpr (is_object_like_v<T>) {
+        expect_symbol(parser, cursor, c == '{', "an object");
+        value.clear();
+        return parser.parse_sequence(cursor, '}', [&](std::size_t pos) {
+            std::string_view key;
+            std::tie(pos, key) = parser.parse_object_key(pos);
+
+            std::string key_string(key);
+            if (value.find(key_string) != value.end()) return parser.skip_node(pos); // duplicate key
+            return parse_to_value_recursively(parser, pos, value[std::move(key_string)]);
+        });
+    } else if constexpr (is_array_like_v<T>) {
+        expect_symbol(parser, cursor, c == '[', "an array");
+        value.clear();
+        return parser.parse_sequence(cursor, ']', [&](std::size_t pos) {
+            value.resize(value.size() + 1);
+            return parse_to_value_recursively(parser, pos, value.back());
+        });
+    } else if constexpr (is_bool_like_v<T>) {
+        expect_symbol(parser, cursor, c == 't' || c == 'f', "a bool");
+        std::tie(cursor, value) = (c == 't') ? parser.parse_true(cursor) : parser.parse_false(cursor);
+    } else if constexpr (is_null_like_v<T>) {
+        expect_symbol(parser, cursor, c == 'n', "a null");
+        std::tie(cursor, value) = parser.parse_null(cursor);
+    } else if constexpr (is_numeric_like_v<T>) {
+        expect_symbol(parser, cursor, ('0' <= c && c <= '9') || (c == '-'), "a number");
+        Number number_value;
+        std::tie(cursor, number_value) = parser.parse_number(cursor);
+        value                          = static_cast<T>(number_value);
+    } else if constexpr (is_reflected_struct<T>) {
+        expect_symbol(parser, cursor, c == '{', "an object");
+        return parse_reflected_struct(parser, cursor, value);
+    } else static_assert(always_false_v<T>, "Method is a non-exhaustive visitor of std::variant<>.");
+
+    return cursor;
+}
+
+// Special case for 'std::array', same as with 'to_struct()'
+template <class T, std::size_t size>
+std::size_t parse_to_value_recursively(Parser& parser, std::size_t cursor, std::array<T, size>& value) {
+    using namespace std::string_literals;
+
+    expect_symbol(parser, cursor, parser.chars[cursor] == '[', "an array");
+
+    std::size_t count = 0;
+    cursor            = parser.parse_sequence(cursor, ']', [&](std::size_t pos) {
+        const std::size_t i = count++;
+        return (i < size) ? parse_to_value_recursively(parser, pos, value[i]) : parser.skip_node(pos);
+    });
+
+    if (count != size)
+        throw std::runtime_error("JSON to structure parser encountered non-mathing std::array size of "s +
+                                 std::to_string(size) + ", corresponding node has a size of "s +
+                                 std::to_string(count) + "."s);
+
+    return cursor;
+}
+
+// Duplicate keys of a field get skipped, so the first occurrence wins
+template <class T>
+std::size_t parse_struct_field_once(Parser& parser, std::size_t cursor, T& field, bool& is_assigned) {
+    if (std::exchange(is_assigned, true)) return parser.skip_node(cursor);
+    return parse_to_value_recursively(parser, cursor, field);
+}
+
+#define utl_json_count_struct_field(fieldname_) ++count;
+
+#define utl_json_parse_struct_field(fieldname_)                                                                        \
+    if (key == #fieldname_) return parse_struct_field_once(parser, pos, val.fieldname_, is_assigned[field_index]);    \
+    ++field_index;
+// keys that don't match any field get skipped,
+// fields that don't have a corresponding key stay defaulted according to the struct constructor
+
+template <class T>
+[[nodiscard]] T from_string_to(const std::string& chars, unsigned int recursion_limit = default_recursion_limit) {
+    T value{};
+
+    Parser            parser(chars, recursion_limit);
+    const std::size_t json_start = parser.skip_nonsignificant_whitespace(0); // skip leading whitespace
+    const std::size_t end_cursor = parse_to_value_recursively(parser, json_start, value);
+
+    // Check for invalid trailing symbols
+    using namespace std::string_literals;
+
+    for (auto cursor = end_cursor; cursor < chars.size(); ++cursor)
+        if (!lookup_whitespace_chars[u8(chars[cursor])])
+            throw std::runtime_error("Invalid trailing symbols encountered after the root JSON node at pos "s +
+                                     std::to_string(cursor) + "."s + pretty_error(cursor, chars));
+
+    return value;
+}
+
+template <class T>
+[[nodiscard]] T from_file_to(const std::string& filepath, unsigned int recursion_limit = default_recursion_limit) {
+    const std::string chars = read_file_to_string(filepath);
+    return from_string_to<T>(chars, recursion_limit);
+}
+
+// --- struct-to-string utils ---
+// ------------------------------
+
+// Serializing reflected structs straight into the buffer, formatting is the same as with
+// 'serialize_json_recursion()', but there is no intermediate 'Node' and struct fields are
+// written in their declaration order (rather than being sorted like the keys of 'Node::object_type')
+
+template <class T>
+void serialize_reflected_struct(const T&, std::string&, unsigned int, bool) {
+    static_assert(always_false_v<T>,
+                  "Provided type doesn't have a defined JSON reflection. Use 'UTL_JSON_REFLECT' macro to define one.");
+    // specializations are defined by 'UTL_JSON_REFLECT', they serialize struct fields as object pairs,
+    // 'prettify' is passed at runtime since explicit specializations can't be templated over it
+}
+
+// Same container layout as in 'serialize_json_recursion()', see the notes there
+template <bool prettify, class Container, class Func>
+void serialize_sequence(const Container& container, std::string& chars, std::size_t indent_size, char opening,
+                        char closing, Func&& serialize_element) {
+    // Skip all logic for empty containers
+    if (container.begin() == container.end()) {
+        chars += opening;
+        chars += closing;
+        return;
+    }
+
+    chars += opening;
+    if constexpr (prettify) chars += '\n';
+
+    for (auto it = container.begin();;) {
+        serialize_element(*it);
+        if (++it != container.end()) { // prevents trailing comma
+            chars += ',';
+            if constexpr (prettify) chars += '\n';
+        } else {
+            if constexpr (prettify) chars += '\n';
+            break;
+        }
+    }
+
+    if constexpr (prettify) chars.append(indent_size, ' ');
+    chars += closing;
+}
+
+template <bool prettify, class T>
+void serialize_value_recursively(const T& value, std::string& chars, unsigned int indent_level = 0,
+                                 bool skip_first_indent = false) {
+    constexpr std::size_t indent_level_size = 4;
+    const std::size_t     indent_size       = indent_level_size * indent_level;
+
+    if constexpr (prettify)
+        if (!skip_first_indent) chars.append(indent_size, ' ');
+
+    if constexpr (is_string_like_v<T>) serialize_json_string(value, chars);
+    else if constexpr (is_object_like_v<T>) {
+        serialize_sequence<prettify>(value, chars, indent_size, '{', '}', [&](const auto& pair) {
+            if constexpr (prettify) chars.append(indent_size + indent_level_size, ' ');
+            serialize_json_string(pair.first, chars);
+            if constexpr (prettify) chars += ": ";
+            else chars += ':';
+            serialize_value_recursively<prettify>(pair.second, chars, indent_level + 1, true);
+        });
+    } else if constexpr (is_array_like_v<T>) {
+        serialize_sequence<prettify>(value, chars, indent_size, '[', ']', [&](const auto& elem) {
+            serialize_value_recursively<prettify>(elem, chars, indent_level + 1);
+        });
+    } else if constexpr (is_bool_like_v<T>) chars += (value ? "true" : "false");
+    else if constexpr (is_null_like_v<T>) chars += "null";
+    else if constexpr (is_numeric_like_v<T>) serialize_json_number(static_cast<Number>(value), chars);
+    else if constexpr (is_reflected_struct<T>) {
+        chars += '{';
+        if constexpr (prettify) chars += '\n';
+        serialize_reflected_struct(value, chars, indent_level, prettify);
+        if constexpr (prettify) {
+            chars += '\n';
+            chars.append(indent_size, ' ');
+        }
+        chars += '}';
+    } else static_assert(always_false_v<T>, "Could not resolve recursive conversion from 'T' to JSON string.");
+}
+
+template <class T>
+void serialize_struct_field(std::string_view key, const T& value, std::string& chars, unsigned int indent_level,
+                            bool prettify, bool is_first_field) {
+    constexpr std::size_t indent_level_size = 4;
+
+    if (!is_first_field) {
+        chars += ',';
+        if (prettify) chars += '\n';
+    }
+
+    if (prettify) chars.append(indent_level_size * (indent_level + 1), ' ');
+    chars += '"';
+    chars += key;
+    chars += (prettify ? "\": " : "\":");
+
+    if (prettify) serialize_value_recursively<true>(value, chars, indent_level + 1, true);
+    else serialize_value_recursively<false>(value, chars, indent_level + 1, true);
+}
+
+#define utl_json_serialize_struct_field(fieldname_)                                                                    \
+    serialize_struct_field(#fieldname_, val.fieldname_, chars, indent_level, prettify, is_first_field);                \
+    is_first_field = false;
+
+template <class T>
+[[nodiscard]] std::string to_string(const T& value, Format format = Format::PRETTY) {
+    std::string chars;
+    if (format == Format::PRETTY) serialize_value_recursively<true>(value, chars);
+    else serialize_value_recursively<false>(value, chars);
+    return chars;
+}
+
 // --- Codegen ---
 // ---------------
 
@@ -1717,15 +2405,478 @@ void assign_node_to_value_recursively(std::array<T, N>& value, const Node& node)
     }                                                                                                                  \
                                                                                                                        \
     template <>                                                                                                        \
-    inline auto utl::json::impl::Node::to_struct<struct_name_>() const -> struct_name_ {                               \
+    inline auto utl::json::impl::Node::to_struct<struct_name_>() const& -> struct_name_ {                              \
         struct_name_ val;                                                                                              \
         /* map 'val.<FIELDNAME> = this->at("<FIELDNAME>").get<decltype(val.<FIELDNAME>)>();' */                        \
         utl_json_map(utl_json_to_struct_assign, __VA_ARGS__);                                                          \
         return val;                                                                                                    \
     }                                                                                                                  \
                                                                                                                        \
+    template <>                                                                                                        \
+    inline auto utl::json::impl::Node::to_struct<struct_name_>() && -> struct_name_ {                                  \
+        struct_name_ val;                                                                                              \
+        /* map 'val.<FIELDNAME> = std::move(this->at("<FIELDNAME>")).get<decltype(val.<FIELDNAME>)>();' */             \
+        utl_json_map(utl_json_to_struct_move_assign, __VA_ARGS__);                                                     \
+        return val;                                                                                                    \
+    }                                                                                                                  \
+                                                                                                                       \
+    template <>                                                                                                        \
+    inline std::size_t utl::json::impl::parse_reflected_struct<struct_name_>(                                          \
+        utl::json::impl::Parser& parser, std::size_t cursor, struct_name_& val) {                                      \
+        constexpr std::size_t field_count = [] {                                                                       \
+            std::size_t count = 0;                                                                                     \
+            /* map '++count;' */                                                                                       \
+            utl_json_map(utl_json_count_struct_field, __VA_ARGS__);                                                    \
+            return count;                                                                                              \
+        }();                                                                                                           \
+        bool is_assigned[field_count] = {};                                                                            \
+        return parser.parse_sequence(cursor, '}', [&](std::size_t pos) {                                               \
+            std::string_view key;                                                                                      \
+            std::tie(pos, key) = parser.parse_object_key(pos);                                                         \
+            std::size_t field_index = 0;                                                                               \
+            /* map 'if (key == "<FIELDNAME>") return parse_struct_field_once(..., val.<FIELDNAME>, ...);' */           \
+            utl_json_map(utl_json_parse_struct_field, __VA_ARGS__);                                                    \
+            return parser.skip_node(pos);                                                                              \
+        });                                                                                                            \
+    }                                                                                                                  \
+                                                                                                                       \
+    template <>                                                                                                        \
+    inline void utl::json::impl::serialize_reflected_struct<struct_name_>(                                             \
+        const struct_name_& val, std::string& chars, unsigned int indent_level, bool prettify) {                       \
+        bool is_first_field = true;                                                                                    \
+        /* map 'serialize_struct_field("<FIELDNAME>", val.<FIELDNAME>, ...);' */                                       \
+        utl_json_map(utl_json_serialize_struct_field, __VA_ARGS__);                                                    \
+    }                                                                                                                  \
+                                                                                                                       \
     static_assert(true)
 
+// ================
+// --- Flat DOM ---
+// ================
+
+// Alternative read-only DOM that trades mutability for parsing speed & memory footprint:
+//    - all nodes live in a single arena & get freed in one shot along with the document
+//    - objects are contiguous arrays of key-value pairs with a linear lookup, for objects of a typical
+//      size this is faster than a tree lookup, it also preserves the original order of keys
+//    - strings & keys are views into the parsed buffer (owned by the document), only strings with
+//      escape sequences need to be decoded into the arena
+// Parsing is done through the SAX parser, so we accept & reject exactly the same inputs as 'from_string()'.
+
+class FlatArena {
+public:
+    FlatArena()                            = default;
+    FlatArena(const FlatArena&)            = delete;
+    FlatArena& operator=(const FlatArena&) = delete;
+
+    FlatArena(FlatArena&& other) noexcept { *this = std::move(other); }
+
+    FlatArena& operator=(FlatArena&& other) noexcept {
+        if (this == &other) return *this;
+
+        this->blocks          = std::move(other.blocks);
+        this->current         = std::exchange(other.current, nullptr);
+        this->remaining       = std::exchange(other.remaining, 0);
+        this->next_block_size = std::exchange(other.next_block_size, min_block_size / 2);
+        other.blocks.clear(); // moved-from vector is only guaranteed to be in a valid state, not an empty one
+        return *this;
+    }
+    // moved-from arena shouldn't keep pointing into the blocks it no longer owns
+
+    // Returns uninitialized storage for 'count' objects, same as 'std::allocator<T>::allocate()',
+    // objects have to be constructed in it with placement 'new' before use
+    template <class T>
+    [[nodiscard]] T* allocate(std::size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena never calls destructors of its objects.");
+
+        if (count == 0) return nullptr;
+
+        const std::size_t size = sizeof(T) * count;
+
+        void* ptr = this->current;
+        if (!std::align(alignof(T), size, ptr, this->remaining)) {
+            // Block sizes grow geometrically, large allocations get a block of their own
+            if (this->next_block_size < max_block_size) this->next_block_size *= 2;
+            const std::size_t block_size = std::max(this->next_block_size, size + alignof(T));
+
+            this->blocks.emplace_back(new unsigned char[block_size]);
+            ptr             = this->blocks.back().get();
+            this->remaining = block_size;
+            std::align(alignof(T), size, ptr, this->remaining); // can't fail, block has enough space for padding
+        }
+
+        this->current = static_cast<unsigned char*>(ptr) + size;
+        this->remaining -= size;
+
+        return static_cast<T*>(ptr);
+    }
+
+private:
+    constexpr static std::size_t min_block_size = 4 * 1024;
+    constexpr static std::size_t max_block_size = 1024 * 1024;
+
+    std::vector<std::unique_ptr<unsigned char[]>> blocks;
+
+    void*       current         = nullptr;
+    std::size_t remaining       = 0;
+    std::size_t next_block_size = min_block_size / 2;
+};
+
+// Non-owning view over a contiguous range of nodes / members
+template <class T>
+class FlatRange {
+public:
+    FlatRange() = default;
+    FlatRange(const T* data, std::size_t size) : first(data), last(data + size) {}
+
+    [[nodiscard]] const T* begin() const noexcept { return this->first; }
+    [[nodiscard]] const T* end() const noexcept { return this->last; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return static_cast<std::size_t>(this->last - this->first); }
+    [[nodiscard]] bool        empty() const noexcept { return this->first == this->last; }
+
+    [[nodiscard]] const T& operator[](std::size_t pos) const { return this->first[pos]; }
+
+private:
+    const T* first = nullptr;
+    const T* last  = nullptr;
+};
+
+struct FlatMember;
+struct FlatBuilder;
+
+class FlatNode {
+public:
+    // -- Getters --
+    // -------------
+
+    [[nodiscard]] FlatRange<FlatMember> get_object() const {
+        this->check_kind(Kind::object, "object");
+        return {this->object_data, this->size};
+    }
+
+    [[nodiscard]] FlatRange<FlatNode> get_array() const {
+        this->check_kind(Kind::array, "array");
+        return {this->array_data, this->size};
+    }
+
+    [[nodiscard]] std::string_view get_string() const {
+        this->check_kind(Kind::string, "string");
+        return {this->string_data, this->size};
+    }
+
+    [[nodiscard]] Number get_number() const {
+        this->check_kind(Kind::number, "number");
+        return this->number_value;
+    }
+
+    [[nodiscard]] Bool get_bool() const {
+        this->check_kind(Kind::boolean, "bool");
+        return this->bool_value;
+    }
+
+    [[nodiscard]] Null get_null() const {
+        this->check_kind(Kind::null, "null");
+        return {};
+    }
+
+    [[nodiscard]] bool is_object() const noexcept { return this->kind == Kind::object; }
+    [[nodiscard]] bool is_array() const noexcept { return this->kind == Kind::array; }
+    [[nodiscard]] bool is_string() const noexcept { return this->kind == Kind::string; }
+    [[nodiscard]] bool is_number() const noexcept { return this->kind == Kind::number; }
+    [[nodiscard]] bool is_bool() const noexcept { return this->kind == Kind::boolean; }
+    [[nodiscard]] bool is_null() const noexcept { return this->kind == Kind::null; }
+
+    // -- Object methods ---
+    // ---------------------
+
+    [[nodiscard]] const FlatNode* find(std::string_view key) const;
+    // returns 'nullptr' for non-existent keys, in case of duplicate keys
+    // the first one is found, same as with the regular 'Node'
+
+    [[nodiscard]] const FlatNode& operator[](std::string_view key) const {
+        if (const FlatNode* node = this->find(key)) return *node;
+        throw std::runtime_error("Accessing non-existent key {" + std::string(key) + "} in JSON object.");
+    }
+
+    [[nodiscard]] const FlatNode& at(std::string_view key) const { return this->operator[](key); }
+
+    [[nodiscard]] bool contains(std::string_view key) const { return this->find(key) != nullptr; }
+
+    // -- Array methods ---
+    // --------------------
+
+    [[nodiscard]] const FlatNode& operator[](std::size_t pos) const { return this->get_array()[pos]; }
+
+    [[nodiscard]] const FlatNode& at(std::size_t pos) const {
+        const auto array = this->get_array();
+        if (pos >= array.size())
+            throw std::out_of_range("Accessing non-existent index {" + std::to_string(pos) +
+                                    "} in JSON array of size " + std::to_string(array.size()) + ".");
+        return array[pos];
+    }
+
+    // -- Conversions --
+    // -----------------
+
+    [[nodiscard]] Node to_node() const;
+
+    [[nodiscard]] std::string to_string(Format format = Format::PRETTY) const;
+
+private:
+    enum class Kind : std::uint8_t { null, object, array, string, number, boolean };
+
+    Kind          kind       = Kind::null;
+    bool          bool_value = false;
+    std::uint32_t size       = 0; // chars in a string / elements in an array / members in an object
+    union {
+        Number            number_value = 0;
+        const char*       string_data;
+        const FlatNode*   array_data;
+        const FlatMember* object_data;
+    };
+    // makes the node 16 bytes large, unlike 'Node' which is ~56 bytes with 'libstdc++'
+
+    void check_kind(Kind expected, std::string_view expected_name) const {
+        using namespace std::string_literals;
+
+        if (this->kind != expected)
+            throw std::runtime_error("JSON flat node was accessed as {"s + std::string(expected_name) +
+                                     "}, but holds a different type."s);
+    }
+
+    friend struct FlatBuilder;
+};
+
+struct FlatMember {
+    std::string_view key;
+    FlatNode         value;
+};
+
+inline const FlatNode* FlatNode::find(std::string_view key) const {
+    for (const auto& member : this->get_object())
+        if (member.key == key) return &member.value;
+    return nullptr;
+}
+
+inline Node FlatNode::to_node() const {
+    switch (this->kind) {
+    case Kind::object: {
+        Object object_value;
+        for (const auto& member : this->get_object())
+            object_value.try_emplace(std::string(member.key), member.value.to_node());
+        return object_value;
+        // 'try_emplace()' keeps the first of the duplicate keys, same as the regular parser
+    }
+    case Kind::array: {
+        Array array_value;
+        array_value.reserve(this->size);
+        for (const auto& element : this->get_array()) array_value.emplace_back(element.to_node());
+        return array_value;
+    }
+    case Kind::string: return this->get_string();
+    case Kind::number: return this->number_value;
+    case Kind::boolean: return this->bool_value;
+    default: return Null{};
+    }
+}
+
+template <bool prettify>
+void serialize_flat_recursion(const FlatNode& node, std::string& chars, unsigned int indent_level = 0,
+                              bool skip_first_indent = false) {
+    constexpr std::size_t indent_level_size = 4;
+    const std::size_t     indent_size       = indent_level_size * indent_level;
+
+    // Same formatting as 'serialize_json_recursion()', see the notes there
+
+    if constexpr (prettify)
+        if (!skip_first_indent) chars.append(indent_size, ' ');
+
+    if (node.is_object()) {
+        serialize_sequence<prettify>(node.get_object(), chars, indent_size, '{', '}', [&](const FlatMember& member) {
+            if constexpr (prettify) chars.append(indent_size + indent_level_size, ' ');
+            serialize_json_string(member.key, chars);
+            if constexpr (prettify) chars += ": ";
+            else chars += ':';
+            serialize_flat_recursion<prettify>(member.value, chars, indent_level + 1, true);
+        });
+    } else if (node.is_array()) {
+        serialize_sequence<prettify>(node.get_array(), chars, indent_size, '[', ']', [&](const FlatNode& element) {
+            serialize_flat_recursion<prettify>(element, chars, indent_level + 1);
+        });
+    } else if (node.is_string()) {
+        serialize_json_string(node.get_string(), chars);
+    } else if (node.is_number()) {
+        serialize_json_number(node.get_number(), chars);
+    } else if (node.is_bool()) {
+        chars += (node.get_bool() ? "true" : "false");
+    } else {
+        chars += "null";
+    }
+}
+
+inline std::string FlatNode::to_string(Format format) const {
+    std::string chars;
+    if (format == Format::PRETTY) serialize_flat_recursion<true>(*this, chars);
+    else serialize_flat_recursion<false>(*this, chars);
+    return chars;
+}
+
+class FlatDocument {
+public:
+    [[nodiscard]] const FlatNode& root() const noexcept { return this->root_node; }
+
+    // Shortcuts for the root node
+    [[nodiscard]] const FlatNode& operator[](std::string_view key) const { return this->root_node[key]; }
+    [[nodiscard]] const FlatNode& operator[](std::size_t pos) const { return this->root_node[pos]; }
+
+    [[nodiscard]] Node        to_node() const { return this->root_node.to_node(); }
+    [[nodiscard]] std::string to_string(Format format = Format::PRETTY) const {
+        return this->root_node.to_string(format);
+    }
+
+private:
+    std::unique_ptr<std::string> source; // on the heap so the views stay valid when the document is moved
+    FlatArena                    arena;
+    FlatNode                     root_node;
+
+    friend struct FlatBuilder;
+};
+
+// SAX handler that builds the flat DOM. Values of all currently open containers are accumulated
+// on a single stack, once the container is closed its values are moved into a contiguous arena block.
+struct FlatBuilder {
+    FlatDocument& document;
+
+    std::vector<FlatMember>                               stack;
+    std::vector<std::pair<std::size_t, std::string_view>> frames; // stack size & key of each open container
+    std::string_view                                      key;    // key of the next value, empty inside arrays
+
+    explicit FlatBuilder(FlatDocument& document) : document(document) {}
+
+    // Views into the source can be kept as is, decoded escaped strings have to be copied into the arena
+    std::string_view persist(std::string_view view) {
+        const std::string& source = *this->document.source;
+
+        // 'std::less<>' gives a total order even for pointers into unrelated objects, unlike the builtin '<'
+        constexpr std::less<const char*> less;
+        if (!less(view.data(), source.data()) && !less(source.data() + source.size(), view.data() + view.size()))
+            return view;
+
+        char* data = this->document.arena.allocate<char>(view.size());
+        std::uninitialized_copy(view.begin(), view.end(), data);
+        return {data, view.size()};
+    }
+
+    static std::uint32_t checked_size(std::size_t size) {
+        using namespace std::string_literals;
+
+        if (size > std::numeric_limits<std::uint32_t>::max())
+            throw std::runtime_error("JSON flat DOM can't store strings & containers with more than "s +
+                                     std::to_string(std::numeric_limits<std::uint32_t>::max()) + " elements."s);
+        return static_cast<std::uint32_t>(size);
+    }
+
+    void push_value(const FlatNode& node) {
+        if (this->frames.empty()) this->document.root_node = node;
+        else this->stack.push_back({this->key, node});
+    }
+
+    void open_container() { this->frames.emplace_back(this->stack.size(), this->key); }
+
+    template <class T>
+    std::pair<const T*, std::uint32_t> close_container() {
+        const auto [frame_start, frame_key] = this->frames.back();
+        this->frames.pop_back();
+        this->key = frame_key;
+
+        const std::size_t count = this->stack.size() - frame_start;
+        T*                data  = this->document.arena.allocate<T>(count);
+
+        // Arena gives us raw storage, objects are constructed in-place
+        for (std::size_t i = 0; i < count; ++i) {
+            const FlatMember& member = this->stack[frame_start + i];
+            if constexpr (std::is_same_v<T, FlatMember>) ::new (static_cast<void*>(data + i)) T(member);
+            else ::new (static_cast<void*>(data + i)) T(member.value);
+        }
+
+        this->stack.resize(frame_start);
+
+        return {data, checked_size(count)};
+    }
+
+    void on_object_begin() { this->open_container(); }
+    void on_object_end() {
+        const auto [data, size] = this->close_container<FlatMember>();
+
+        FlatNode node;
+        node.kind        = FlatNode::Kind::object;
+        node.object_data = data;
+        node.size        = size;
+        this->push_value(node);
+    }
+
+    void on_array_begin() {
+        this->open_container();
+        this->key = {};
+    }
+    void on_array_end() {
+        const auto [data, size] = this->close_container<FlatNode>();
+
+        FlatNode node;
+        node.kind       = FlatNode::Kind::array;
+        node.array_data = data;
+        node.size       = size;
+        this->push_value(node);
+    }
+
+    void on_key(std::string_view key) { this->key = this->persist(key); }
+
+    void on_string(std::string_view value) {
+        const std::string_view persisted = this->persist(value);
+
+        FlatNode node;
+        node.kind        = FlatNode::Kind::string;
+        node.string_data = persisted.data();
+        node.size        = checked_size(persisted.size());
+        this->push_value(node);
+    }
+
+    void on_number(Number value) {
+        FlatNode node;
+        node.kind         = FlatNode::Kind::number;
+        node.number_value = value;
+        this->push_value(node);
+    }
+
+    void on_bool(Bool value) {
+        FlatNode node;
+        node.kind       = FlatNode::Kind::boolean;
+        node.bool_value = value;
+        this->push_value(node);
+    }
+
+    void on_null() { this->push_value(FlatNode{}); }
+
+    [[nodiscard]] static FlatDocument build(std::string chars, unsigned int recursion_limit) {
+        FlatDocument document;
+        document.source = std::make_unique<std::string>(std::move(chars));
+
+        FlatBuilder builder(document);
+        sax_from_string(*document.source, builder, recursion_limit);
+
+        return document;
+    }
+};
+
+[[nodiscard]] inline FlatDocument flat_from_string(std::string chars,
+                                                   unsigned int recursion_limit = default_recursion_limit) {
+    return FlatBuilder::build(std::move(chars), recursion_limit);
+}
+
+[[nodiscard]] inline FlatDocument flat_from_file(const std::string& filepath,
+                                                 unsigned int       recursion_limit = default_recursion_limit) {
+    return flat_from_string(read_file_to_string(filepath), recursion_limit);
+}
 
 } // namespace utl::json::impl
 
@@ -1747,6 +2898,19 @@ using impl::Null;
 using impl::from_string;
 using impl::from_file;
 using impl::from_struct;
+using impl::SaxHandler;
+using impl::sax_from_string;
+using impl::sax_from_stream;
+using impl::sax_from_file;
+
+using impl::FlatNode;
+using impl::FlatMember;
+using impl::FlatDocument;
+using impl::flat_from_string;
+using impl::flat_from_file;
+using impl::from_string_to;
+using impl::from_file_to;
+using impl::to_string;
 
 namespace literals = impl::literals;
 
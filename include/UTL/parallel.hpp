@@ -14,26 +14,57 @@
 #define utl_parallel_headerguard
 
 #define UTL_PARALLEL_VERSION_MAJOR 2
-#define UTL_PARALLEL_VERSION_MINOR 1
-#define UTL_PARALLEL_VERSION_PATCH 4
+#define UTL_PARALLEL_VERSION_MINOR 2
+#define UTL_PARALLEL_VERSION_PATCH 0
 
 // _______________________ INCLUDES _______________________
 
+#include <algorithm>          // sort(), stable_sort(), partition(), merge(), move()
+#include <array>              // array<>
+#include <atomic>             // atomic<>, memory_order
+#include <chrono>             // steady_clock, nanoseconds, duration_cast<>()
 #include <condition_variable> // condition_variable
-#include <cstdint>            // uint64_t
-#include <functional>         // plus<>, multiplies<>, function<>
+#include <cstddef>            // size_t, ptrdiff_t, max_align_t, nullptr_t
+#include <cstdint>            // uint64_t, int64_t, uint32_t
+#include <deque>              // deque<>
+#include <exception>          // exception_ptr, current_exception(), rethrow_exception()
+#include <functional>         // plus<>, multiplies<>, less<>, bind(), hash<>, equal_to<>
 #include <future>             // future<>, promise<>
-#include <memory>             // shared_ptr<>
+#include <iterator>           // iterator_traits<>, make_move_iterator(), distance()
+#include <map>                // map<>
+#include <memory>             // unique_ptr<>, shared_ptr<>, make_shared<>()
 #include <mutex>              // mutex, scoped_lock<>, unique_lock<>
+#include <new>                // launder()
 #include <optional>           // optional<>, nullopt
-#include <queue>              // queue<>, deque<>, size_t, ptrdiff_t
 #include <stdexcept>          // current_exception, runtime_error
-#include <thread>             // thread
-#include <utility>            // forward<>()
+#include <string>             // string, to_string(), stoul(), getline()
+#include <thread>             // thread, this_thread::get_id()
+#include <tuple>              // tie(), tuple<>, tuple_cat(), get<>()
+#include <type_traits>        // decay_t<>, enable_if_t<>, is_same_v<>, is_nothrow_move_constructible_v<>
+#include <unordered_map>      // unordered_map<>
+#include <utility>            // forward<>(), move()
 #include <vector>             // vector<>
 
+// Thread affinity & CPU topology are only supported on Linux
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <fstream>   // ifstream
+#include <pthread.h> // pthread_self(), pthread_setaffinity_np(), pthread_getaffinity_np()
+#include <sched.h>   // cpu_set_t, CPU_ZERO(), CPU_SET(), CPU_ISSET(), CPU_SETSIZE
+#define utl_parallel_has_thread_affinity
+#endif
+
+// Coroutines are only supported in C++20
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && __has_include(<coroutine>)
+#include <coroutine> // coroutine_handle<>, suspend_always, noop_coroutine()
+#include <variant>   // monostate
+#define utl_parallel_has_coroutines
+#endif
+
 // ____________________ DEVELOPER DOCS ____________________
 
+// Optional macros:
+// - #define UTL_PARALLEL_ENABLE_STATS // collect per-worker thread pool statistics, see 'ThreadPool::stats()'
+//
 // Work-stealing summary:
 //
 //    - We use several queues:
@@ -48,24 +79,44 @@
 //         3. Check global queue,  work here can be popped from the front
 //    - To resolve recursive deadlocks we use a custom future:
 //         - Recursive task calls '.wait()' on its future => pop / steal work from local deques until finished
+//    - Global queue is split into high / normal / low priority tiers:
+//         - High priority tasks are checked before the local deques, others after the stealing
+//         - Lower tiers get their turn after being skipped 'starvation_limit' times in a row
+//    - Fork-join task groups avoid futures entirely:
+//         - Group state (pending counter & exception) lives on the stack of the waiting thread
+//         - Waiting thread pops / steals work the same way futures do, then parks until the last child is done
+//    - Local deques are lock-free Chase-Lev deques:
+//         - Owner thread pushes & pops at the bottom, thieves steal from the top with a CAS
+//         - Deque slots hold pointers to task nodes rather than tasks, since slots have to be atomic
+//         - Task nodes are recycled through per-worker free lists, which keeps submission allocation-free
+//    - Tasks are move-only callables with a 64-byte inline storage:
+//         - Unlike 'std::function' they don't allocate for most closures and have a non-throwing move
+//
+//    - Task accounting & sleeping doesn't use any shared mutexes:
+//         - Pending / running tasks are tracked by a single atomic counter
+//         - Idle threads park on an event count, which only touches the OS primitives when someone is
+//           actually asleep, busy pool never has sleepers and thus never goes through the slow path
 //
-// Ideally we would want to use a different algorithm with Chase-Lev lock-free local SPMC queues for work-stealing,
-// and a global lock-free MPMC queue for outside tasks, however properly implementing such queues is a task of
-// incredible complexity, which is further exacerbated by the fact that 'std::function' has a potentially throwing
-// move-assignment, which disqualifies it from ~80% of existing lock-free queue implementations.
+// Global queue is still guarded by a mutex, properly implementing a lock-free MPMC queue is a task of incredible
+// complexity and the global queue only sees external tasks, so it isn't contended nearly as much as local deques.
 //
 // Newer standards would enable several improvements in terms of implementation:
 //    - In C++20 'std::jthread' can be used to simplify joining and add stop tokens
-//    - In C++23 'std::move_only_function<>' can be used as a more efficient task type,
-//      however this still doesn't resolve the issue of throwing move assignment
-//    - In C++20 atomic wait / semaphores / barriers can be used to improve efficiency
-//      of some syncronization
+//    - In C++23 'std::move_only_function<>' could replace the custom task type, however its inline
+//      storage size is implementation-defined and it still doesn't guarantee a non-throwing move
+//    - In C++20 atomic wait is used to park threads when available, below C++20 we fall back onto
+//      a condition variable that is only touched when there are sleeping threads
 //
-// It is also possible to add task priority with a bit of constexpr logic and possibly reduce locking
-// in some parts of the scheduling, this is a work for future releases.
+// It is also possible to reduce locking in some parts of the scheduling, this is a work for future releases.
 
 // ____________________ IMPLEMENTATION ____________________
 
+// MSVC warns about structures being padded due to 'alignas()', which is precisely the point of aligning them
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4324)
+#endif
+
 namespace utl::parallel::impl {
 
 // ============================
@@ -89,639 +140,3734 @@ inline thread_local std::optional<void*>       thread_pool_ptr = std::nullopt;
     // if 'hardware_concurrency()' struggles to determine the number of threads, we fallback onto a reasonable default
 }
 
-// ===================
-// --- Thread pool ---
-// ===================
+constexpr std::size_t cache_line_size = 64;
+// 'std::hardware_destructive_interference_size' would be more appropriate, but its support is spotty and GCC warns
+// about its usage in headers due to ABI concerns, 64 bytes is correct for virtually all modern x86 & ARM CPUs
 
-class ThreadPool;
+template <class T>
+struct alignas(cache_line_size) Padded {
+    T value{};
+}; // places each value in a separate cache line, which prevents false sharing when values are stored in an array
 
-namespace ws_this_thread { // same this as thread introspection from public API, but more convenient for internal use
-inline thread_local ThreadPool* thread_pool_ptr = nullptr;
-inline thread_local std::size_t worker_index    = std::size_t(-1);
-}; // namespace ws_this_thread
+// ===========================
+// --- Work-stealing deque ---
+// ===========================
 
-inline std::size_t splitmix64() noexcept {
-    thread_local std::uint64_t state = ws_this_thread::worker_index;
+// Chase-Lev lock-free work-stealing deque, based on:
+//    - "Dynamic Circular Work-Stealing Deque" (D. Chase, Y. Lev, 2005)
+//    - "Correct and Efficient Work-Stealing for Weak Memory Models" (N. M. Le, A. Pop, A. Cohen, F. Z. Nardelli, 2013)
+//
+// The paper version uses relaxed operations paired with standalone fences, here we use 'seq_cst' operations in the
+// same places instead. On x86 this compiles to the same instructions, but unlike fences it is properly understood by
+// thread sanitizers. Retired buffers are kept alive until the deque dies since thieves might still be reading them,
+// this wastes at most as much memory as the largest buffer itself.
 
-    std::uint64_t result = (state += 0x9E3779B97f4A7C15);
-    result               = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9;
-    result               = (result ^ (result >> 27)) * 0x94D049BB133111EB;
-    return static_cast<std::size_t>(result ^ (result >> 31));
-} // very fast & simple PRNG
+template <class T>
+class WorkStealingDeque {
+    static constexpr std::int64_t initial_capacity = 64; // should be a power of 2
 
-class ThreadPool {
-    using task_type         = std::function<void()>;
-    using global_queue_type = std::queue<task_type>;
-    using local_queue_type  = std::deque<task_type>;
+    struct Buffer {
+        std::int64_t                       capacity;
+        std::int64_t                       mask;
+        std::unique_ptr<std::atomic<T*>[]> slots;
 
-    std::vector<std::thread> workers;
-    std::mutex               workers_mutex;
+        explicit Buffer(std::int64_t capacity)
+            : capacity(capacity), mask(capacity - 1), slots(std::make_unique<std::atomic<T*>[]>(capacity)) {}
 
-    global_queue_type global_queue;
-    std::mutex        global_queue_mutex;
+        [[nodiscard]] T* get(std::int64_t i) const noexcept { return this->slots[i & this->mask].load(relaxed); }
+        void             put(std::int64_t i, T* x) noexcept { this->slots[i & this->mask].store(x, relaxed); }
+    };
 
-    std::vector<local_queue_type> local_queues;
-    std::vector<std::mutex>       local_queues_mutexes;
+    static constexpr auto relaxed = std::memory_order_relaxed;
+    static constexpr auto acquire = std::memory_order_acquire;
+    static constexpr auto release = std::memory_order_release;
+    static constexpr auto seq_cst = std::memory_order_seq_cst;
 
-    std::condition_variable task_available_cv;
-    std::condition_variable task_done_cv;
-    std::mutex              task_mutex;
+    alignas(cache_line_size) std::atomic<std::int64_t> top{0};    // stealing end, contended by thieves
+    alignas(cache_line_size) std::atomic<std::int64_t> bottom{0}; // owner end
+    alignas(cache_line_size) std::atomic<Buffer*>      buffer{nullptr};
 
-    std::size_t tasks_running = 0; // protected by task mutex
-    std::size_t tasks_pending = 0;
+    std::vector<std::unique_ptr<Buffer>> buffers; // owns current & retired buffers, only accessed by the owner
 
-    bool waiting     = false; // protected by task mutex
-    bool terminating = true;
+    Buffer* grow(Buffer* old, std::int64_t t, std::int64_t b) {
+        this->buffers.push_back(std::make_unique<Buffer>(old->capacity * 2));
+        Buffer* grown = this->buffers.back().get();
+        for (std::int64_t i = t; i < b; ++i) grown->put(i, old->get(i));
+        return grown;
+    }
 
-private:
-    void spawn_workers(std::size_t count) {
-        this->workers              = std::vector<std::thread>(count);
-        this->local_queues         = std::vector<local_queue_type>(count);
-        this->local_queues_mutexes = std::vector<std::mutex>(count);
-        {
-            const std::scoped_lock task_lock(this->task_mutex);
-            this->terminating = false;
-        }
-        for (std::size_t i = 0; i < count; ++i) this->workers[i] = std::thread([this, i] { this->worker_main(i); });
+public:
+    WorkStealingDeque() {
+        this->buffers.push_back(std::make_unique<Buffer>(initial_capacity));
+        this->buffer.store(this->buffers.back().get(), relaxed);
     }
 
-    void terminate_workers() {
-        {
-            const std::scoped_lock polling_lock(this->task_mutex);
-            this->terminating = true;
-        }
-        this->task_available_cv.notify_all();
+    WorkStealingDeque(const WorkStealingDeque&)            = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
 
-        for (std::size_t i = 0; i < this->workers.size(); ++i)
-            if (this->workers[i].joinable()) this->workers[i].join();
-    }
+    // Any thread, approximate unless called by the owner
+    [[nodiscard]] bool empty() const noexcept { return this->bottom.load(relaxed) <= this->top.load(relaxed); }
 
-    void worker_main(std::size_t worker_index) {
-        this_thread::thread_pool_ptr    = this;
-        this_thread::worker_index       = worker_index;
-        ws_this_thread::thread_pool_ptr = this;
-        ws_this_thread::worker_index    = worker_index;
+    [[nodiscard]] std::size_t size() const noexcept {
+        const std::int64_t size = this->bottom.load(relaxed) - this->top.load(relaxed);
+        return size > 0 ? static_cast<std::size_t>(size) : 0;
+    }
 
-        while (true) {
-            std::unique_lock task_lock(this->task_mutex);
+    // Owner-only
+    void push(T* x) {
+        const std::int64_t b = this->bottom.load(relaxed);
+        const std::int64_t t = this->top.load(acquire);
+        Buffer*            a = this->buffer.load(relaxed);
 
-            // Wake up thread pool 'wait()' if necessary
-            if (this->waiting && !this->tasks_pending && !this->tasks_running) this->task_done_cv.notify_all();
+        if (b - t > a->capacity - 1) {
+            a = this->grow(a, t, b);
+            this->buffer.store(a, release);
+        }
 
-            // Tasks pending       => continue execution and pull tasks to execute
-            // Pool is terminating => continue execution and break out of the main loop
-            // otherwise           => wait
-            this->task_available_cv.wait(task_lock, [this] { return this->terminating || this->tasks_pending; });
+        a->put(b, x);
+        this->bottom.store(b + 1, seq_cst);
+    }
 
-            // Terminate if necessary
-            if (this->terminating) break;
+    // Owner-only, returns 'nullptr' if deque is empty
+    [[nodiscard]] T* pop() noexcept {
+        const std::int64_t b = this->bottom.load(relaxed) - 1;
+        Buffer*            a = this->buffer.load(relaxed);
 
-            task_lock.unlock();
+        this->bottom.store(b, seq_cst);
+        std::int64_t t = this->top.load(seq_cst);
 
-            // Try to pull in a task
-            task_type task;
-            if (this->try_pop_local(task) || this->try_steal(task) || this->try_pop_global(task)) {
-                task_lock.lock();
-                --this->tasks_pending;
-                ++this->tasks_running;
-                task_lock.unlock();
+        if (t > b) { // deque was empty
+            this->bottom.store(b + 1, relaxed);
+            return nullptr;
+        }
 
-                task();
+        T* x = a->get(b);
 
-                task_lock.lock();
-                --this->tasks_running;
-                task_lock.unlock();
-            }
+        if (t == b) { // last element, race against thieves
+            if (!this->top.compare_exchange_strong(t, t + 1, seq_cst, relaxed)) x = nullptr;
+            this->bottom.store(b + 1, relaxed);
         }
 
-        this_thread::thread_pool_ptr    = std::nullopt;
-        this_thread::worker_index       = std::nullopt;
-        ws_this_thread::thread_pool_ptr = nullptr;
-        ws_this_thread::worker_index    = std::size_t(-1);
+        return x;
     }
 
-    bool try_pop_local(task_type& task) {
-        const std::scoped_lock local_queue_lock(this->local_queues_mutexes[ws_this_thread::worker_index]);
+    // Any thread, returns 'nullptr' if deque is empty
+    [[nodiscard]] T* steal() noexcept {
+        while (true) {
+            std::int64_t       t = this->top.load(seq_cst);
+            const std::int64_t b = this->bottom.load(seq_cst);
 
-        auto& local_queue = this->local_queues[ws_this_thread::worker_index];
+            if (t >= b) return nullptr;
 
-        if (local_queue.empty()) return false;
+            T* x = this->buffer.load(acquire)->get(t);
 
-        task = std::move(local_queue.front());
-        local_queue.pop_front();
-        return true;
+            if (this->top.compare_exchange_strong(t, t + 1, seq_cst, relaxed)) return x;
+            // CAS failure means some other thread got the element first, which means we can just retry
+        }
     }
+};
 
-    bool try_steal(task_type& task) {
-        for (std::size_t attempt = 0; attempt < this->workers.size(); ++attempt) {
-            const std::size_t i = splitmix64() % this->workers.size();
+// ===================
+// --- Event count ---
+// ===================
 
-            if (i == ws_this_thread::worker_index) continue; // don't steal from yourself
+// Event count is a "condition variable for lock-free code", waiting on it follows a 3-step protocol:
+//    1. 'prepare_wait()' registers a waiter and returns current epoch
+//    2. Waiter re-checks the condition it's waiting for, if it's satisfied => 'cancel_wait()'
+//    3. Otherwise 'commit_wait(epoch)' blocks until somebody notifies after the epoch was taken
+//
+// Notifying side first makes the condition true and then calls 'notify_one()' / 'notify_all()', which
+// only bumps the epoch & wakes up threads if there are registered waiters, otherwise notification is just
+// a single atomic load. Both sides use sequentially consistent operations, which guarantees that either
+// notifier sees the waiter, or the waiter sees the satisfied condition, so no wake-ups can be lost.
+
+// clang-format off
+#if defined(__cpp_lib_atomic_wait) && __cpp_lib_atomic_wait >= 201907L
+    #define utl_parallel_has_atomic_wait
+#endif
+// clang-format on
 
-            const std::scoped_lock local_queue_lock(this->local_queues_mutexes[i]);
+class EventCount {
+    alignas(cache_line_size) std::atomic<std::uint32_t> epoch{0};
+    alignas(cache_line_size) std::atomic<std::uint32_t> waiters{0};
 
-            auto& local_queue = this->local_queues[i];
+#ifndef utl_parallel_has_atomic_wait
+    std::mutex              mutex;
+    std::condition_variable cv;
+#endif
 
-            if (local_queue.empty()) continue;
+    static constexpr std::size_t all_waiters = std::size_t(-1);
 
-            task = std::move(local_queue.back());
-            local_queue.pop_back();
-            return true;
-        }
+    void wake(std::size_t count) {
+        this->epoch.fetch_add(1, std::memory_order_seq_cst);
 
-        return false;
+#ifdef utl_parallel_has_atomic_wait
+        if (count == all_waiters) this->epoch.notify_all();
+        else
+            for (std::size_t i = 0; i < count; ++i) this->epoch.notify_one();
+#else
+        { const std::scoped_lock lock(this->mutex); } // prevents waiter from missing the epoch change
+        if (count == all_waiters) this->cv.notify_all();
+        else
+            for (std::size_t i = 0; i < count; ++i) this->cv.notify_one();
+#endif
     }
 
-    bool try_pop_global(task_type& task) {
-        const std::scoped_lock global_queue_lock(this->global_queue_mutex);
-
-        if (this->global_queue.empty()) return false;
+public:
+    using key_type = std::uint32_t;
 
-        task = std::move(this->global_queue.front());
-        this->global_queue.pop();
-        return true;
+    [[nodiscard]] key_type prepare_wait() noexcept {
+        this->waiters.fetch_add(1, std::memory_order_seq_cst);
+        return this->epoch.load(std::memory_order_seq_cst);
     }
 
-public:
-    explicit ThreadPool(std::size_t count = std::thread::hardware_concurrency()) { this->spawn_workers(count); }
+    void cancel_wait() noexcept { this->waiters.fetch_sub(1, std::memory_order_seq_cst); }
 
-    ~ThreadPool() noexcept {
-        try {
-            this->wait();
-            this->terminate_workers();
-        } catch (...) {} // no throwing from the destructor
+    [[nodiscard]] bool has_waiters() const noexcept { return this->waiters.load(std::memory_order_relaxed) != 0; }
+
+    void commit_wait(key_type key) {
+#ifdef utl_parallel_has_atomic_wait
+        this->epoch.wait(key, std::memory_order_seq_cst);
+#else
+        std::unique_lock lock(this->mutex);
+        this->cv.wait(lock, [&] { return this->epoch.load(std::memory_order_seq_cst) != key; });
+#endif
+        this->waiters.fetch_sub(1, std::memory_order_seq_cst);
     }
 
-    template <class T = void>
-    struct future_type {
-        std::future<T> future;
+    void notify_one() {
+        if (this->waiters.load(std::memory_order_seq_cst)) this->wake(1);
+    }
 
-        void fallthrough() const {
-            ThreadPool* pool = ws_this_thread::thread_pool_ptr;
+    void notify_all() {
+        if (this->waiters.load(std::memory_order_seq_cst)) this->wake(all_waiters);
+    }
 
-            if (!pool) return;
+    void notify(std::size_t count) { // wakes up to 'count' waiters, extra notifications would be wasted syscalls
+        const std::size_t waiters = this->waiters.load(std::memory_order_seq_cst);
+        if (waiters && count) this->wake(count < waiters ? count : all_waiters);
+    }
+};
 
-            // Execute recursive tasks from local queues until this future is ready
-            task_type task;
-            while (pool->try_pop_local(task) || pool->try_steal(task)) {
-                pool->task_mutex.lock();
-                --pool->tasks_pending;
-                ++pool->tasks_running;
-                pool->task_mutex.unlock();
+// =================
+// --- Task type ---
+// =================
 
-                task();
+// Move-only type-erased 'void()' callable with a small buffer optimization. Closures that fit into the inline
+// storage and have a non-throwing move get stored in-place, others fall back onto a heap allocation. Storage
+// size is selected so the whole task takes exactly 64 bytes, which fits most lambdas capturing a few references
+// or values, as well as a 'std::promise<>' used by awaitable tasks. Compared to 'std::function<>' this means:
+//    - No allocation for closures up to 56 bytes ('std::function<>' SBO is usually just 16 bytes)
+//    - Support for move-only closures, no need to wrap promises into shared pointers
+//    - Non-throwing move, which allows tasks to live in the lock-free & allocation-free containers
+
+class Task {
+    static constexpr std::size_t total_size   = 64;
+    static constexpr std::size_t storage_size = total_size - sizeof(void*);
+
+    struct VTable {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src) noexcept; // move-constructs 'dst' from 'src' and destroys 'src'
+        void (*destroy)(void* storage) noexcept;
+    };
 
-                pool->task_mutex.lock();
-                --pool->tasks_running;
-                pool->task_mutex.unlock();
+    template <class F>
+    static constexpr bool fits_inline = sizeof(F) <= storage_size && alignof(F) <= alignof(std::max_align_t) &&
+                                        std::is_nothrow_move_constructible_v<F>;
 
-                if (this->is_ready()) return;
-            }
+    template <class F>
+    struct InlineVTable {
+        static F* get(void* storage) noexcept { return std::launder(static_cast<F*>(storage)); }
+
+        static void invoke(void* storage) { (*get(storage))(); }
+        static void move(void* dst, void* src) noexcept {
+            ::new (dst) F(std::move(*get(src)));
+            get(src)->~F();
         }
+        static void destroy(void* storage) noexcept { get(storage)->~F(); }
 
-        bool is_ready() const { return this->future.wait_for(std::chrono::seconds{0}) == std::future_status::ready; }
+        static constexpr VTable value = {&invoke, &move, &destroy};
+    };
 
-    public:
-        future_type(std::future<T>&& future) : future(std::move(future)) {} // conversion from regular future
-        future_type& operator=(std::future<T>&& future) {
-            this->future = std::move(future);
-            return *this;
-        }
+    template <class F>
+    struct HeapVTable {
+        static F*& get(void* storage) noexcept { return *std::launder(static_cast<F**>(storage)); }
 
-        using is_recursive = void;
+        static void invoke(void* storage) { (*get(storage))(); }
+        static void move(void* dst, void* src) noexcept { ::new (dst) F*(get(src)); }
+        static void destroy(void* storage) noexcept { delete get(storage); }
 
-        auto get() {
-            this->fallthrough();
-            return this->future.get();
-        }
+        static constexpr VTable value = {&invoke, &move, &destroy};
+    };
 
-        bool valid() const noexcept { return this->future.valid(); }
+    alignas(std::max_align_t) unsigned char storage[storage_size];
+    const VTable* vtable = nullptr;
 
-        void wait() const {
-            this->fallthrough();
-            this->future.wait();
+public:
+    Task() noexcept = default;
+
+    template <class F, std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>, bool> = true>
+    Task(F&& f) {
+        using closure_type = std::decay_t<F>;
+
+        if constexpr (fits_inline<closure_type>) {
+            ::new (static_cast<void*>(this->storage)) closure_type(std::forward<F>(f));
+            this->vtable = &InlineVTable<closure_type>::value;
+        } else {
+            ::new (static_cast<void*>(this->storage)) closure_type*(new closure_type(std::forward<F>(f)));
+            this->vtable = &HeapVTable<closure_type>::value;
         }
+    }
 
-        template <class Rep, class Period>
-        std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout_duration) const {
-            this->fallthrough();
-            return this->future.wait_for(timeout_duration);
-        }
+    Task(const Task&)            = delete;
+    Task& operator=(const Task&) = delete;
 
-        template <class Clock, class Duration>
-        std::future_status wait_until(const std::chrono::time_point<Clock, Duration>& timeout_time) const {
-            this->fallthrough();
-            return this->future.wait_until(timeout_time);
-        }
-    };
+    Task(Task&& other) noexcept : vtable(other.vtable) {
+        if (this->vtable) this->vtable->move(this->storage, other.storage);
+        other.vtable = nullptr;
+    }
 
-    void set_thread_count(std::size_t count) {
-        if (ws_this_thread::thread_pool_ptr == this)
-            throw std::runtime_error("Cannot resize thread pool from its own pool thread.");
+    Task& operator=(Task&& other) noexcept {
+        if (this == &other) return *this;
 
-        const std::scoped_lock workers_lock(this->workers_mutex);
+        this->reset();
+        this->vtable = other.vtable;
+        if (this->vtable) this->vtable->move(this->storage, other.storage);
+        other.vtable = nullptr;
 
-        this->wait();
-        this->terminate_workers();
-        this->spawn_workers(count);
+        return *this;
     }
 
-    [[nodiscard]] std::size_t get_thread_count() {
-        if (ws_this_thread::thread_pool_ptr == this) return this->workers.size();
-        // calls from inside the pool shouldn't lock, otherwise we could deadlock the thread by trying to
-        // query the thread count while the pool was instructed to resize, worker count is constant during
-        // a worker lifetime so it's safe to query without a lock anyways
+    Task& operator=(std::nullptr_t) noexcept {
+        this->reset();
+        return *this;
+    }
 
-        const std::scoped_lock workers_lock(this->workers_mutex);
+    ~Task() { this->reset(); }
 
-        return this->workers.size();
+    void reset() noexcept {
+        if (this->vtable) this->vtable->destroy(this->storage);
+        this->vtable = nullptr;
     }
 
-    void wait() {
-        std::unique_lock task_lock(this->task_mutex);
+    void operator()() { this->vtable->invoke(this->storage); }
 
-        this->waiting = true;
-        this->task_done_cv.wait(task_lock, [this] { return !this->tasks_pending && !this->tasks_running; });
-        this->waiting = false;
-    }
+    explicit operator bool() const noexcept { return this->vtable; }
+};
 
-    template <class F, class... Args>
-    void detached_task(F&& f, Args&&... args) {
-        auto closure = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+static_assert(sizeof(Task) == 64);
 
-        // Recursive task
-        if (ws_this_thread::thread_pool_ptr == this) {
-            const std::scoped_lock local_queue_lock(this->local_queues_mutexes[ws_this_thread::worker_index]);
-            this->local_queues[ws_this_thread::worker_index].push_front(std::move(closure));
-        }
-        // Regular task
-        else {
-            const std::scoped_lock global_queue_lock(this->global_queue_mutex);
-            this->global_queue.emplace(std::move(closure));
-        }
+// ==================
+// --- Task nodes ---
+// ==================
 
-        {
-            const std::scoped_lock task_lock(this->task_mutex);
-            ++this->tasks_pending;
-        }
-        this->task_available_cv.notify_one();
-    }
+// Local deques store pointers, which means every recursive task needs a node to live in. To avoid allocating
+// a new node per task, each worker has its own cache of free nodes. Nodes can be freed by any thread in the pool
+// (since tasks can be stolen), in which case they are returned into the remote list of their owner. Remote list is
+// a lock-free stack that only gets pushed to and then drained by the owner in a single exchange, so there's no ABA.
 
-    template <class F, class... Args, class R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
-    future_type<R> awaitable_task(F&& f, Args&&... args) {
-        auto closure = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+struct TaskNode {
+    Task        task;
+    TaskNode*   next  = nullptr;
+    std::size_t owner = 0; // index of the worker whose cache allocated this node
+};
 
-        const std::shared_ptr<std::promise<R>> promise = std::make_shared<std::promise<R>>();
-        // ideally we could just move promise into a lambda and use it as is, however that makes the lambda
-        // non-copyable (since promise itself is move-only) which doesn't work with 'std::function<>', this
-        // is fixed in C++23 with 'std::move_only_function<>'
+class TaskNodeCache {
+    TaskNode* local_list = nullptr; // owner-only
 
-        future_type<R> future = promise->get_future();
+    alignas(cache_line_size) std::atomic<TaskNode*> remote_list{nullptr};
 
-        this->detached_task([closure = std::move(closure), promise = std::move(promise)]() mutable {
-            try {
-                if constexpr (std::is_void_v<R>) {
-                    closure();
-                    promise->set_value();
-                } else {
-                    promise->set_value(closure());
-                } // 'promise->set_value(f())' when 'f()' returns 'void' is a compile error, so we use a workaround
-            } catch (...) {
-                try {
-                    promise->set_exception(std::current_exception()); // this may still throw
-                } catch (...) {}
-            }
-        });
+    static void free_list(TaskNode* head) noexcept {
+        while (head) delete std::exchange(head, head->next);
+    }
 
-        return future;
+public:
+    TaskNodeCache() = default;
+
+    TaskNodeCache(const TaskNodeCache&)            = delete;
+    TaskNodeCache& operator=(const TaskNodeCache&) = delete;
+
+    ~TaskNodeCache() {
+        free_list(this->local_list);
+        free_list(this->remote_list.load(std::memory_order_acquire));
     }
-};
 
-template <class T = void>
-using Future = ThreadPool::future_type<T>;
+    // Owner-only
+    [[nodiscard]] TaskNode* acquire(std::size_t owner) {
+        if (!this->local_list) this->local_list = this->remote_list.exchange(nullptr, std::memory_order_acquire);
 
-// ==============
-// --- Ranges ---
-// ==============
+        if (!this->local_list) {
+            TaskNode* node = new TaskNode;
+            node->owner    = owner;
+            return node;
+        }
 
-// --- SFINAE helpers ---
-// ----------------------
+        return std::exchange(this->local_list, this->local_list->next);
+    }
 
-template <bool Cond>
-using require = std::enable_if_t<Cond, bool>;
+    // Owner-only
+    void release_local(TaskNode* node) noexcept {
+        node->next       = this->local_list;
+        this->local_list = node;
+    }
 
-template <class T, class... Args>
-using require_invocable = require<std::is_invocable_v<T, Args...>>;
-// this is simple convenience
+    // Any thread
+    void release_remote(TaskNode* node) noexcept {
+        TaskNode* head = this->remote_list.load(std::memory_order_relaxed);
+        do {
+            node->next = head;
+        } while (!this->remote_list.compare_exchange_weak(head, node, std::memory_order_release,
+                                                          std::memory_order_relaxed));
+    }
+};
 
-template <class T, class = void>
-struct has_iter : std::false_type {};
-template <class T>
-struct has_iter<T, std::void_t<decltype(std::declval<typename T::iterator>())>> : std::true_type {};
+// ==================
+// --- Ring queue ---
+// ==================
 
-template <class T, class = void>
-struct has_const_iter : std::false_type {};
-template <class T>
-struct has_const_iter<T, std::void_t<decltype(std::declval<typename T::const_iterator>())>> : std::true_type {};
+// Growable FIFO queue based on a ring buffer. Unlike 'std::queue<>' (which uses 'std::deque<>' underneath)
+// it never releases its storage, which means pushing & popping doesn't allocate once the queue warms up.
 
 template <class T>
-using require_has_some_iter = require<has_iter<T>::value || has_const_iter<T>::value>;
-// needed to restrict template 'Range' constructor from a container, otherwise it takes priority over copy / move ctors
+class RingQueue {
+    std::vector<T> buffer; // capacity is always a power of 2
+    std::size_t    head  = 0;
+    std::size_t    count = 0;
 
-template <class T, class = void>
-struct is_recursive : std::false_type {};
-template <class T>
-struct is_recursive<T, std::void_t<decltype(std::declval<typename T::is_recursive>())>> : std::true_type {};
-template <class T>
-constexpr bool is_recursive_v = is_recursive<T>::value;
+    void grow() {
+        std::vector<T> grown(this->buffer.empty() ? 16 : this->buffer.size() * 2);
+        for (std::size_t i = 0; i < this->count; ++i) grown[i] = std::move(this->buffer[this->index(i)]);
 
-// --- Utils ---
-// -------------
+        this->buffer = std::move(grown);
+        this->head   = 0;
+    }
 
-[[nodiscard]] constexpr std::size_t min_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? b : a; }
-[[nodiscard]] constexpr std::size_t max_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? a : b; }
-// no reason to include the entirety of <algorithm> just for 2 one-liners
+    [[nodiscard]] std::size_t index(std::size_t i) const noexcept {
+        return (this->head + i) & (this->buffer.size() - 1);
+    }
 
-constexpr std::size_t default_grains_per_thread = 4;
-// by default we distribute 4 tasks per thread, this number is purely empirical. We don't want to split up
-// work into too many tasks (like with 'grain_size = 1'), yet we want it to be a bit more granular than
-// doing 1 task per thread since that would be horrible if tasks are noticeably uneven.
+public:
+    [[nodiscard]] bool        empty() const noexcept { return this->count == 0; }
+    [[nodiscard]] std::size_t size() const noexcept { return this->count; }
 
-// --- Range ---
-// -------------
+    void push(T&& value) {
+        if (this->count == this->buffer.size()) this->grow();
 
-template <class It>
-struct Range {
-    It          begin;
-    It          end;
-    std::size_t grain_size;
+        this->buffer[this->index(this->count)] = std::move(value);
+        ++this->count;
+    }
 
-    Range() = delete;
+    void pop(T& value) noexcept {
+        value      = std::move(this->buffer[this->head]);
+        this->head = this->index(1);
+        --this->count;
+    }
+};
 
-    constexpr Range(It begin, It end, std::size_t grain_size) : begin(begin), end(end), grain_size(grain_size) {}
+// =================
+// --- Placement ---
+// =================
 
-    Range(It begin, It end)
-        : Range(begin, end, max_size(1, (end - begin) / (hardware_concurrency() * default_grains_per_thread))) {}
+// Worker placement policy, describes how pool threads get pinned to CPUs:
+//    - 'none'           - no pinning, OS is free to migrate threads (default)
+//    - 'compact'        - workers fill CPUs in topological order, neighbouring workers share cores & sockets
+//    - 'scatter'        - workers alternate between NUMA nodes & physical cores, hyper-threads get used last
+//    - 'physical_cores' - one worker per physical core, hyper-threads are left unused
+//    - 'cpu_list'       - worker 'i' gets pinned to 'cpus[i % cpus.size()]'
+// If there are more workers than suitable CPUs, assignment wraps around. Only CPUs allowed by the affinity mask of
+// the thread creating the pool are considered. Pinning is implemented for Linux, elsewhere every policy is a no-op.
+
+struct Placement {
+    enum class Policy { none, compact, scatter, physical_cores, cpu_list };
+
+    Policy                   policy = Policy::none;
+    std::vector<std::size_t> cpus; // only used by 'cpu_list'
+
+    [[nodiscard]] static Placement none() { return {Policy::none, {}}; }
+    [[nodiscard]] static Placement compact() { return {Policy::compact, {}}; }
+    [[nodiscard]] static Placement scatter() { return {Policy::scatter, {}}; }
+    [[nodiscard]] static Placement physical_cores() { return {Policy::physical_cores, {}}; }
+    [[nodiscard]] static Placement cpu_list(std::vector<std::size_t> cpus) {
+        return {Policy::cpu_list, std::move(cpus)};
+    }
+};
 
+struct CpuInfo {
+    std::size_t cpu;
+    std::size_t node;
+    std::size_t package;
+    std::size_t core;
+};
 
-    template <class Container, require<has_const_iter<Container>::value> = true>
-    Range(const Container& container) : Range(container.begin(), container.end()) {}
+#ifdef utl_parallel_has_thread_affinity
 
-    template <class Container, require<has_iter<Container>::value> = true>
-    Range(Container& container) : Range(container.begin(), container.end()) {}
-}; // requires random-access iterator, but no good way to express that before C++20 concepts
+// Parses sysfs CPU & node lists, for example '0-3,8-11'
+[[nodiscard]] inline std::vector<std::size_t> parse_cpu_list(const std::string& str) {
+    std::vector<std::size_t> list;
 
-// CTAD for deducing iterator range from a container
-template <class Container>
-Range(const Container& container) -> Range<typename Container::const_iterator>;
+    for (std::size_t pos = 0; pos < str.size();) {
+        const std::size_t end   = std::min(str.find(',', pos), str.size());
+        const std::string token = str.substr(pos, end - pos);
+        pos                     = end + 1;
 
-template <class Container>
-Range(Container& container) -> Range<typename Container::iterator>;
+        if (token.empty()) continue;
 
-// --- Index range ---
+        const std::size_t dash  = token.find('-');
+        const std::size_t first = std::stoul(token.substr(0, dash));
+        const std::size_t last  = (dash == std::string::npos) ? first : std::stoul(token.substr(dash + 1));
+
+        for (std::size_t i = first; i <= last; ++i) list.push_back(i);
+    }
+
+    return list;
+}
+
+[[nodiscard]] inline std::string read_sysfs_line(const std::string& path) {
+    std::ifstream file(path);
+    std::string   line;
+    std::getline(file, line);
+    return line; // missing file => empty line
+}
+
+#endif
+
+// Returns topology of CPUs available to the calling thread, empty if it can't be determined
+[[nodiscard]] inline std::vector<CpuInfo> get_cpu_topology() {
+#ifdef utl_parallel_has_thread_affinity
+    try {
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (pthread_getaffinity_np(pthread_self(), sizeof(allowed), &allowed) != 0) return {};
+
+        constexpr std::size_t max_cpus = CPU_SETSIZE;
+
+        std::vector<std::size_t> cpu_nodes(max_cpus, 0); // systems without NUMA have no node info => single node
+        for (std::size_t node : parse_cpu_list(read_sysfs_line("/sys/devices/system/node/online"))) {
+            const std::string path = "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+            for (std::size_t cpu : parse_cpu_list(read_sysfs_line(path)))
+                if (cpu < max_cpus) cpu_nodes[cpu] = node;
+        }
+
+        const auto read_id = [](const std::string& path, std::size_t fallback) {
+            const std::string line = read_sysfs_line(path);
+            return line.empty() ? fallback : std::size_t(std::stoul(line));
+        };
+
+        std::vector<CpuInfo> topology;
+        for (std::size_t cpu = 0; cpu < max_cpus; ++cpu) {
+            if (!CPU_ISSET(cpu, &allowed)) continue;
+
+            const std::string dir     = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+            const std::size_t package = read_id(dir + "physical_package_id", 0);
+            const std::size_t core    = read_id(dir + "core_id", cpu); // unknown core => every CPU is a core
+
+            topology.push_back({cpu, cpu_nodes[cpu], package, core});
+        }
+
+        return topology;
+    } catch (...) { return {}; } // malformed sysfs is treated the same as missing one
+#else
+    return {};
+#endif
+}
+
+// Returns CPUs assigned to each of the 'count' workers, empty if workers shouldn't be pinned
+[[nodiscard]] inline std::vector<CpuInfo> assign_cpus(const Placement& placement, std::size_t count,
+                                                      std::vector<CpuInfo> topology) {
+    using Policy = Placement::Policy;
+
+    if (placement.policy == Policy::none || count == 0) return {};
+
+    std::sort(topology.begin(), topology.end(), [](const CpuInfo& lhs, const CpuInfo& rhs) {
+        return std::tie(lhs.node, lhs.package, lhs.core, lhs.cpu) < std::tie(rhs.node, rhs.package, rhs.core, rhs.cpu);
+    });
+
+    // Rank of each CPU among hyper-threads of its core & rank of its core inside the NUMA node,
+    // topological sort above puts hyper-threads of a core next to each other, so one pass is enough
+    std::vector<std::size_t> smt_ranks(topology.size()), core_ranks(topology.size());
+    for (std::size_t i = 0; i < topology.size(); ++i) {
+        if (i == 0 || topology[i].node != topology[i - 1].node) {
+            smt_ranks[i]  = 0;
+            core_ranks[i] = 0;
+        } else if (topology[i].package == topology[i - 1].package && topology[i].core == topology[i - 1].core) {
+            smt_ranks[i]  = smt_ranks[i - 1] + 1;
+            core_ranks[i] = core_ranks[i - 1];
+        } else {
+            smt_ranks[i]  = 0;
+            core_ranks[i] = core_ranks[i - 1] + 1;
+        }
+    }
+
+    std::vector<CpuInfo> order;
+
+    if (placement.policy == Policy::compact) {
+        order = topology;
+    } else if (placement.policy == Policy::physical_cores) {
+        for (std::size_t i = 0; i < topology.size(); ++i)
+            if (smt_ranks[i] == 0) order.push_back(topology[i]);
+    } else if (placement.policy == Policy::scatter) {
+        std::vector<std::size_t> indices(topology.size());
+        for (std::size_t i = 0; i < indices.size(); ++i) indices[i] = i;
+
+        std::sort(indices.begin(), indices.end(), [&](std::size_t lhs, std::size_t rhs) {
+            return std::tie(smt_ranks[lhs], core_ranks[lhs], topology[lhs].node) <
+                   std::tie(smt_ranks[rhs], core_ranks[rhs], topology[rhs].node);
+        });
+
+        for (std::size_t i : indices) order.push_back(topology[i]);
+    } else if (placement.policy == Policy::cpu_list) {
+        for (std::size_t cpu : placement.cpus)
+            for (const CpuInfo& info : topology)
+                if (info.cpu == cpu) order.push_back(info); // CPUs that aren't available get skipped
+    }
+
+    if (order.empty()) return {};
+
+    std::vector<CpuInfo> assignment(count);
+    for (std::size_t i = 0; i < count; ++i) assignment[i] = order[i % order.size()];
+    return assignment;
+}
+
+inline void pin_this_thread(std::size_t cpu) noexcept {
+#ifdef utl_parallel_has_thread_affinity
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set); // failure just leaves the thread unpinned
+#else
+    (void)cpu;
+#endif
+}
+
+// ==================
+// --- Statistics ---
+// ==================
+
+// Thread pool can optionally collect per-worker statistics, which is useful for tuning grain sizes & priorities.
+// Each counter has a single writer (its worker), so updates are plain relaxed load & store rather than atomic
+// read-modify-write, atomics only let 'stats()' read counters from other threads without a data race. Disabled
+// statistics compile out entirely, the only leftover is an empty vector of counters.
+
+// clang-format off
+#ifdef UTL_PARALLEL_ENABLE_STATS
+    constexpr bool stats_enabled = true;
+#else
+    constexpr bool stats_enabled = false;
+#endif
+// clang-format on
+
+using stats_clock = std::chrono::steady_clock;
+
+constexpr std::size_t latency_buckets = 32;
+
+[[nodiscard]] inline std::uint64_t elapsed_ns(stats_clock::time_point start) noexcept {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(stats_clock::now() - start);
+    return static_cast<std::uint64_t>(elapsed.count());
+}
+
+// Bucket 'k > 0' counts latencies in '[2^(k-1), 2^k)' nanoseconds, the last one also counts everything above
+[[nodiscard]] constexpr std::size_t latency_bucket(std::uint64_t ns) noexcept {
+    std::size_t bucket = 0;
+    for (; ns && bucket < latency_buckets - 1; ns >>= 1) ++bucket;
+    return bucket;
+}
+
+struct WorkerStats {
+    std::size_t              executed_tasks        = 0;
+    std::size_t              local_pops            = 0;
+    std::size_t              global_pops           = 0;
+    std::size_t              steals                = 0;
+    std::size_t              failed_steals         = 0;
+    std::size_t              max_local_queue_depth = 0;
+    std::chrono::nanoseconds idle_time             = std::chrono::nanoseconds{0};
+
+    std::array<std::size_t, latency_buckets> latency_histogram{}; // time from submission to execution
+};
+
+struct PoolStats {
+    std::vector<WorkerStats> workers;
+    std::size_t              max_global_queue_depth = 0;
+
+    [[nodiscard]] WorkerStats total() const {
+        WorkerStats total;
+
+        for (const auto& worker : this->workers) {
+            total.executed_tasks += worker.executed_tasks;
+            total.local_pops += worker.local_pops;
+            total.global_pops += worker.global_pops;
+            total.steals += worker.steals;
+            total.failed_steals += worker.failed_steals;
+            if (total.max_local_queue_depth < worker.max_local_queue_depth)
+                total.max_local_queue_depth = worker.max_local_queue_depth;
+            total.idle_time += worker.idle_time;
+            for (std::size_t i = 0; i < latency_buckets; ++i) total.latency_histogram[i] += worker.latency_histogram[i];
+        }
+
+        return total;
+    }
+};
+
+struct WorkerCounters {
+    using counter_type = std::atomic<std::size_t>;
+
+    counter_type executed_tasks{0};
+    counter_type local_pops{0};
+    counter_type global_pops{0};
+    counter_type steals{0};
+    counter_type failed_steals{0};
+    counter_type max_local_queue_depth{0};
+    counter_type idle_ns{0};
+
+    std::array<counter_type, latency_buckets> latency_histogram{};
+
+    static void add(counter_type& counter, std::size_t value) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    static void raise(counter_type& counter, std::size_t value) noexcept {
+        if (counter.load(std::memory_order_relaxed) < value) counter.store(value, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] WorkerStats snapshot() const noexcept {
+        WorkerStats stats;
+
+        stats.executed_tasks        = this->executed_tasks.load(std::memory_order_relaxed);
+        stats.local_pops            = this->local_pops.load(std::memory_order_relaxed);
+        stats.global_pops           = this->global_pops.load(std::memory_order_relaxed);
+        stats.steals                = this->steals.load(std::memory_order_relaxed);
+        stats.failed_steals         = this->failed_steals.load(std::memory_order_relaxed);
+        stats.max_local_queue_depth = this->max_local_queue_depth.load(std::memory_order_relaxed);
+        stats.idle_time             = std::chrono::nanoseconds(this->idle_ns.load(std::memory_order_relaxed));
+
+        for (std::size_t i = 0; i < latency_buckets; ++i)
+            stats.latency_histogram[i] = this->latency_histogram[i].load(std::memory_order_relaxed);
+
+        return stats;
+    }
+};
+
+// ==================
+// --- Coroutines ---
+// ==================
+
+// C++20 coroutine support. 'Coroutine<T>' is a lazy task, it starts either when awaited (in which case it runs
+// inline on the awaiting thread) or when spawned onto a thread pool. Completion is tracked by a single atomic:
+//    - 'pending' => coroutine is still running and nobody awaits it yet
+//    - 'ready'   => coroutine has finished
+//    - Any other value is the address of an awaiting coroutine, which gets resumed on whatever thread finishes
+//      the awaited one through a symmetric transfer, this way no thread ever blocks while awaiting
+// Waiting from regular code goes through a small helper coroutine that signals a blocking event.
+
+#ifdef utl_parallel_has_coroutines
+
+class ThreadPool;
+
+template <class T = void>
+class Coroutine;
+
+// Notification happens under the lock, once the waiter sees 'done' the event may be destroyed
+class BlockingEvent {
+    std::mutex              mutex;
+    std::condition_variable cv;
+    bool                    done = false;
+
+public:
+    void set() {
+        const std::scoped_lock lock(this->mutex);
+        this->done = true;
+        this->cv.notify_all();
+    }
+
+    void wait() {
+        std::unique_lock lock(this->mutex);
+        this->cv.wait(lock, [this] { return this->done; });
+    }
+};
+
+class SyncWaiter {
+public:
+    struct promise_type {
+        BlockingEvent* event = nullptr;
+
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> handle) noexcept { handle.promise().event->set(); }
+            void await_resume() const noexcept {}
+        };
+
+        SyncWaiter get_return_object() noexcept {
+            return SyncWaiter{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter        final_suspend() const noexcept { return {}; }
+        void                return_void() const noexcept {}
+        void                unhandled_exception() const noexcept { std::terminate(); } // completion can't throw
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    explicit SyncWaiter(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    template <class Awaitable>
+    static SyncWaiter make(Awaitable& awaitable) {
+        co_await awaitable;
+    }
+
+public:
+    SyncWaiter(const SyncWaiter&)            = delete;
+    SyncWaiter& operator=(const SyncWaiter&) = delete;
+
+    ~SyncWaiter() { this->handle.destroy(); }
+
+    // Blocks current thread until 'awaitable' is done, doesn't park a thread per await in coroutine code
+    template <class Awaitable>
+    static void wait(Awaitable&& awaitable) {
+        BlockingEvent event;
+
+        SyncWaiter waiter = make(awaitable);
+        waiter.handle.promise().event = &event;
+        waiter.handle.resume();
+
+        event.wait();
+    }
+};
+
+struct CoroutinePromiseBase {
+    static constexpr std::uintptr_t pending = 0;
+    static constexpr std::uintptr_t ready   = 1;
+
+    std::atomic<std::uintptr_t> state{pending}; // 'pending', 'ready' or an address of the awaiting coroutine
+    bool                        started = false;
+    std::exception_ptr          exception;
+
+    template <class Promise>
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            const std::uintptr_t awaiting = handle.promise().state.exchange(ready, std::memory_order_acq_rel);
+            // can't touch the promise past this point, awaiting side is free to destroy the frame once it sees 'ready'
+
+            if (awaiting == pending) return std::noop_coroutine();
+            return std::coroutine_handle<>::from_address(reinterpret_cast<void*>(awaiting));
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; } // coroutines are lazy
+    void                unhandled_exception() noexcept { this->exception = std::current_exception(); }
+
+    void rethrow_if_failed() const {
+        if (this->exception) std::rethrow_exception(this->exception);
+    }
+};
+
+template <class T>
+struct CoroutinePromise : CoroutinePromiseBase {
+    std::optional<T> value;
+
+    Coroutine<T>                      get_return_object() noexcept;
+    FinalAwaiter<CoroutinePromise<T>> final_suspend() const noexcept { return {}; }
+
+    template <class U = T>
+    void return_value(U&& value) {
+        this->value.emplace(std::forward<U>(value));
+    }
+
+    T& result() & {
+        this->rethrow_if_failed();
+        return *this->value;
+    }
+
+    T result() && {
+        this->rethrow_if_failed();
+        return std::move(*this->value);
+    }
+};
+
+template <>
+struct CoroutinePromise<void> : CoroutinePromiseBase {
+    Coroutine<void>                      get_return_object() noexcept;
+    FinalAwaiter<CoroutinePromise<void>> final_suspend() const noexcept { return {}; }
+
+    void return_void() const noexcept {}
+
+    void result() const { this->rethrow_if_failed(); }
+};
+
+template <class T>
+class Coroutine {
+    static_assert(!std::is_reference_v<T>, "Coroutines cannot return references.");
+
+public:
+    using promise_type = CoroutinePromise<T>;
+
+private:
+    friend class ThreadPool;
+    friend promise_type;
+
+    std::coroutine_handle<promise_type> handle;
+
+    explicit Coroutine(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) {}
+
+    // Waits for completion without touching the result, can't throw
+    struct CompletionAwaiter {
+        std::coroutine_handle<promise_type> handle;
+
+        bool await_ready() const noexcept {
+            const promise_type& promise = this->handle.promise();
+            return promise.started && promise.state.load(std::memory_order_acquire) == promise_type::ready;
+        }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            promise_type&        promise = this->handle.promise();
+            const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(awaiting.address());
+
+            // Not started yet => run it inline on this thread, it will transfer back to us when finished
+            if (!promise.started) {
+                promise.started = true;
+                promise.state.store(address, std::memory_order_relaxed);
+                return this->handle;
+            }
+
+            // Already running somewhere else => register as a continuation, unless it finished in the meantime
+            std::uintptr_t expected = promise_type::pending;
+            if (promise.state.compare_exchange_strong(expected, address, std::memory_order_acq_rel)) {
+                return std::noop_coroutine();
+            }
+
+            return awaiting;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    struct LvalueAwaiter : CompletionAwaiter {
+        decltype(auto) await_resume() const { return this->handle.promise().result(); }
+    };
+
+    struct RvalueAwaiter : CompletionAwaiter {
+        decltype(auto) await_resume() const { return std::move(this->handle.promise()).result(); }
+    };
+
+    [[nodiscard]] CompletionAwaiter completion() const noexcept { return CompletionAwaiter{this->handle}; }
+
+public:
+    Coroutine(const Coroutine&)            = delete;
+    Coroutine& operator=(const Coroutine&) = delete;
+
+    Coroutine(Coroutine&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+    Coroutine& operator=(Coroutine&& other) noexcept {
+        if (this != &other) {
+            this->destroy();
+            this->handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
+
+    ~Coroutine() { this->destroy(); }
+
+    LvalueAwaiter operator co_await() & noexcept { return LvalueAwaiter{{this->handle}}; }
+    RvalueAwaiter operator co_await() && noexcept { return RvalueAwaiter{{this->handle}}; }
+
+    [[nodiscard]] bool valid() const noexcept { return static_cast<bool>(this->handle); }
+
+    [[nodiscard]] bool is_ready() const noexcept { return this->completion().await_ready(); }
+
+    // Blocking API for regular code, coroutine that wasn't started yet runs inline on the calling thread
+    void wait() const {
+        if (!this->is_ready()) SyncWaiter::wait(this->completion());
+    }
+
+    T get() {
+        this->wait();
+        return std::move(this->handle.promise()).result();
+    }
+
+private:
+    void destroy() noexcept {
+        if (!this->handle) return;
+
+        // Coroutine that is still running somewhere can't be destroyed under its own feet
+        if (this->handle.promise().started) this->wait();
+
+        this->handle.destroy();
+        this->handle = nullptr;
+    }
+};
+
+template <class T>
+Coroutine<T> CoroutinePromise<T>::get_return_object() noexcept {
+    return Coroutine<T>{std::coroutine_handle<CoroutinePromise<T>>::from_promise(*this)};
+}
+
+inline Coroutine<void> CoroutinePromise<void>::get_return_object() noexcept {
+    return Coroutine<void>{std::coroutine_handle<CoroutinePromise<void>>::from_promise(*this)};
+}
+
+template <class T>
+using non_void_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+#endif
+
+// ===================
+// --- Thread pool ---
+// ===================
+
+class ThreadPool;
+class TaskGroup;
+
+template <class T>
+class PerWorker;
+
+namespace ws_this_thread { // same this as thread introspection from public API, but more convenient for internal use
+inline thread_local ThreadPool* thread_pool_ptr = nullptr;
+inline thread_local std::size_t worker_index    = std::size_t(-1);
+}; // namespace ws_this_thread
+
+inline std::size_t splitmix64() noexcept {
+    thread_local std::uint64_t state = ws_this_thread::worker_index;
+
+    std::uint64_t result = (state += 0x9E3779B97f4A7C15);
+    result               = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9;
+    result               = (result ^ (result >> 27)) * 0x94D049BB133111EB;
+    return static_cast<std::size_t>(result ^ (result >> 31));
+} // very fast & simple PRNG
+
+// Priority classes of the global queue. High priority tasks are taken before any other work (including
+// the local deques), normal & low ones are taken after the local & stolen work. Each non-empty tier can
+// be skipped in favor of a higher one at most 'starvation_limit' times in a row, after that it gets its turn.
+enum class Priority { high, normal, low };
+
+constexpr std::size_t priority_count   = 3;
+constexpr std::size_t starvation_limit = 16;
+
+class ThreadPool {
+    friend class TaskGroup; // waiting groups execute tasks from the local deques
+
+    template <class T>
+    friend class PerWorker; // per-worker storage follows the thread count of the pool
+
+    using task_type         = Task;
+    using global_queue_type = RingQueue<task_type>;
+    using local_queue_type  = WorkStealingDeque<TaskNode>;
+
+    std::vector<std::thread> workers;
+    std::mutex               workers_mutex;
+
+    std::array<global_queue_type, priority_count> global_queues; // one FIFO per priority tier
+    std::array<std::size_t, priority_count>       skip_counts{};  // guarded by the same mutex as the queues
+    std::mutex                                    global_queue_mutex;
+
+    std::vector<local_queue_type> local_queues; // lock-free, not resized during worker lifetime
+    std::vector<TaskNodeCache>    node_caches;  // one per worker, recycles nodes of the local queues
+
+    Placement                placement;
+    std::vector<std::size_t> worker_nodes; // NUMA node of each worker, all zeroes unless workers are pinned
+    bool                     multiple_nodes = false;
+
+    alignas(cache_line_size) std::atomic<std::size_t> tasks_unfinished{0}; // pending + running
+    alignas(cache_line_size) std::atomic<std::size_t> global_queue_size{0};
+    alignas(cache_line_size) std::atomic<std::size_t> high_priority_size{0};
+    // allows workers to skip locking the global queue when it's empty
+
+    std::atomic<bool> terminating{true};
+
+    EventCount task_available; // idle workers park here
+    EventCount tasks_done;     // 'wait()' parks here
+
+    std::vector<Padded<WorkerCounters>> counters; // one per worker, stays empty unless stats are enabled
+    std::atomic<std::size_t>            max_global_queue_depth{0};
+
+    std::map<std::size_t, std::function<void(std::size_t)>> resize_observers; // invoked with the new thread count
+    std::size_t                                             next_observer_id      = 0;
+    std::size_t                                             observed_thread_count = 0;
+    std::mutex                                              resize_observers_mutex;
+
+private:
+    // Observers get notified while there are no workers, which lets them resize per-worker state without locking
+    std::size_t add_resize_observer(std::function<void(std::size_t)> observer) {
+        const std::scoped_lock observers_lock(this->resize_observers_mutex);
+
+        observer(this->observed_thread_count);
+        this->resize_observers.emplace(this->next_observer_id, std::move(observer));
+        return this->next_observer_id++;
+    }
+
+    void remove_resize_observer(std::size_t id) {
+        const std::scoped_lock observers_lock(this->resize_observers_mutex);
+        this->resize_observers.erase(id);
+    }
+
+    void notify_resize_observers(std::size_t count) {
+        const std::scoped_lock observers_lock(this->resize_observers_mutex);
+
+        this->observed_thread_count = count;
+        for (auto& [id, observer] : this->resize_observers) observer(count);
+    }
+
+    void spawn_workers(std::size_t count) {
+        this->notify_resize_observers(count);
+
+        this->workers      = std::vector<std::thread>(count);
+        this->local_queues = std::vector<local_queue_type>(count);
+        this->node_caches  = std::vector<TaskNodeCache>(count);
+        this->terminating.store(false, std::memory_order_seq_cst);
+
+        if constexpr (stats_enabled) {
+            this->counters = std::vector<Padded<WorkerCounters>>(count);
+            this->max_global_queue_depth.store(0, std::memory_order_relaxed);
+        }
+
+        const bool                 pinned = (this->placement.policy != Placement::Policy::none);
+        const std::vector<CpuInfo> cpus   = pinned ? assign_cpus(this->placement, count, get_cpu_topology())
+                                                   : std::vector<CpuInfo>{}; // don't touch sysfs unless needed
+
+        this->worker_nodes = std::vector<std::size_t>(count, 0);
+        for (std::size_t i = 0; i < cpus.size(); ++i) this->worker_nodes[i] = cpus[i].node;
+
+        this->multiple_nodes = false;
+        for (std::size_t node : this->worker_nodes) this->multiple_nodes |= (node != this->worker_nodes.front());
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::optional<std::size_t> cpu = cpus.empty() ? std::nullopt : std::optional{cpus[i].cpu};
+
+            this->workers[i] = std::thread([this, i, cpu] {
+                if (cpu) pin_this_thread(*cpu);
+                this->worker_main(i);
+            });
+        }
+    }
+
+    void terminate_workers() {
+        this->terminating.store(true, std::memory_order_seq_cst);
+        this->task_available.notify_all();
+
+        for (std::size_t i = 0; i < this->workers.size(); ++i)
+            if (this->workers[i].joinable()) this->workers[i].join();
+
+        for (auto& local_queue : this->local_queues)
+            while (TaskNode* node = local_queue.pop()) delete node; // deque doesn't own its pointers
+    }
+
+    void worker_main(std::size_t worker_index) {
+        this_thread::thread_pool_ptr    = this;
+        this_thread::worker_index       = worker_index;
+        ws_this_thread::thread_pool_ptr = this;
+        ws_this_thread::worker_index    = worker_index;
+
+        task_type task;
+
+        while (true) {
+            // Fast path, no synchronization beyond the queues themselves
+            if (this->try_acquire_task(task)) {
+                this->execute(task);
+                continue;
+            }
+
+            // Slow path, register as a sleeper, re-check everything and park if there is still nothing to do
+            const EventCount::key_type key = this->task_available.prepare_wait();
+
+            if (this->terminating.load(std::memory_order_seq_cst)) {
+                this->task_available.cancel_wait();
+                break;
+            }
+
+            if (this->try_acquire_task(task)) {
+                this->task_available.cancel_wait();
+                this->execute(task);
+                continue;
+            }
+
+            if constexpr (stats_enabled) {
+                const auto idle_start = stats_clock::now();
+                this->task_available.commit_wait(key);
+                WorkerCounters::add(this->local_counters().idle_ns, static_cast<std::size_t>(elapsed_ns(idle_start)));
+            } else {
+                this->task_available.commit_wait(key);
+            }
+        }
+
+        this_thread::thread_pool_ptr    = std::nullopt;
+        this_thread::worker_index       = std::nullopt;
+        ws_this_thread::thread_pool_ptr = nullptr;
+        ws_this_thread::worker_index    = std::size_t(-1);
+    }
+
+    bool try_acquire_task(task_type& task) {
+        return this->try_pop_urgent(task) || this->try_pop_local(task) || this->try_steal(task) ||
+               this->try_pop_global(task);
+    }
+
+    [[nodiscard]] WorkerCounters& local_counters() noexcept {
+        return this->counters[ws_this_thread::worker_index].value;
+    }
+
+    // With stats enabled tasks carry their submission time, this makes closures 16 bytes larger
+    template <class F>
+    task_type make_task(F&& f) {
+        if constexpr (stats_enabled) {
+            return [this, f = std::forward<F>(f), submitted = stats_clock::now()]() mutable {
+                WorkerCounters::add(this->local_counters().latency_histogram[latency_bucket(elapsed_ns(submitted))], 1);
+                f();
+            };
+        } else {
+            return task_type(std::forward<F>(f));
+        }
+    }
+
+    void record_global_queue_depth(std::size_t depth) noexcept { // called under the global queue lock
+        if constexpr (stats_enabled)
+            if (this->max_global_queue_depth.load(std::memory_order_relaxed) < depth)
+                this->max_global_queue_depth.store(depth, std::memory_order_relaxed);
+    }
+
+    void execute(task_type& task) {
+        if constexpr (stats_enabled) WorkerCounters::add(this->local_counters().executed_tasks, 1);
+
+        task();
+        task = nullptr; // captured state should die with the task, not linger until the next one
+
+        if (this->tasks_unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) this->tasks_done.notify_all();
+    }
+
+    void push_local(task_type&& task) {
+        const std::size_t index = ws_this_thread::worker_index;
+
+        TaskNode* node = this->node_caches[index].acquire(index);
+        node->task     = std::move(task);
+
+        try {
+            this->local_queues[index].push(node);
+        } catch (...) {
+            node->task = nullptr;
+            this->node_caches[index].release_local(node);
+            throw;
+        }
+
+        if constexpr (stats_enabled)
+            WorkerCounters::raise(this->local_counters().max_local_queue_depth, this->local_queues[index].size());
+    }
+
+    void take_from_node(TaskNode* node, task_type& task) noexcept {
+        task = std::move(node->task);
+
+        if (node->owner == ws_this_thread::worker_index) this->node_caches[node->owner].release_local(node);
+        else this->node_caches[node->owner].release_remote(node);
+    }
+
+    bool try_pop_local(task_type& task) {
+        TaskNode* node = this->local_queues[ws_this_thread::worker_index].pop();
+
+        if (!node) return false;
+
+        if constexpr (stats_enabled) WorkerCounters::add(this->local_counters().local_pops, 1);
+
+        this->take_from_node(node, task);
+        return true;
+    }
+
+    bool try_steal(task_type& task) {
+        const bool stolen = this->try_steal_any(task);
+
+        if constexpr (stats_enabled) {
+            if (stolen) WorkerCounters::add(this->local_counters().steals, 1);
+            else WorkerCounters::add(this->local_counters().failed_steals, 1);
+        }
+
+        return stolen;
+    }
+
+    bool try_steal_any(task_type& task) {
+        if (!this->multiple_nodes) return this->try_steal_if(task, [](std::size_t) { return true; });
+
+        // Victims on the same NUMA node go first, stealing across nodes is more expensive since all
+        // the data touched by the task will likely have to travel through the interconnect
+        const std::size_t node = this->worker_nodes[ws_this_thread::worker_index];
+
+        return this->try_steal_if(task, [&](std::size_t i) { return this->worker_nodes[i] == node; }) ||
+               this->try_steal_if(task, [&](std::size_t i) { return this->worker_nodes[i] != node; });
+    }
+
+    template <class Pred>
+    bool try_steal_if(task_type& task, Pred&& is_victim) {
+        const std::size_t count = this->local_queues.size();
+        const std::size_t start = count ? splitmix64() % count : 0;
+
+        // Unlike regular random stealing this is guaranteed to check every deque, which is
+        // necessary for a correct re-check before parking the thread, see 'worker_main()'
+        for (std::size_t k = 0; k < count; ++k) {
+            const std::size_t i = (start + k) % count;
+
+            if (i == ws_this_thread::worker_index) continue; // don't steal from yourself
+            if (!is_victim(i)) continue;
+
+            TaskNode* node = this->local_queues[i].steal();
+
+            if (!node) continue;
+
+            this->take_from_node(node, task);
+            return true;
+        }
+
+        return false;
+    }
+
+    bool try_pop_urgent(task_type& task) {
+        if (!this->high_priority_size.load(std::memory_order_seq_cst)) return false;
+        return this->try_pop_global(task); // high priority work doesn't wait behind the local deques
+    }
+
+    bool try_pop_global(task_type& task) {
+        if (!this->global_queue_size.load(std::memory_order_seq_cst)) return false;
+
+        const std::scoped_lock global_queue_lock(this->global_queue_mutex);
+
+        // Highest non-empty tier goes first, unless some lower tier was skipped too many times already
+        std::size_t selected = priority_count;
+
+        for (std::size_t tier = 0; tier < priority_count; ++tier) {
+            if (this->global_queues[tier].empty()) continue;
+            if (selected == priority_count) selected = tier;
+            if (this->skip_counts[tier] >= starvation_limit) {
+                selected = tier;
+                break;
+            }
+        }
+
+        if (selected == priority_count) return false;
+
+        for (std::size_t tier = selected + 1; tier < priority_count; ++tier)
+            if (!this->global_queues[tier].empty()) ++this->skip_counts[tier];
+        this->skip_counts[selected] = 0;
+
+        this->global_queues[selected].pop(task);
+        this->global_queue_size.fetch_sub(1, std::memory_order_seq_cst);
+        if constexpr (stats_enabled) WorkerCounters::add(this->local_counters().global_pops, 1);
+        if (selected == tier_index(Priority::high)) this->high_priority_size.fetch_sub(1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    [[nodiscard]] static constexpr std::size_t tier_index(Priority priority) noexcept {
+        return static_cast<std::size_t>(priority);
+    }
+
+    void push_global(task_type&& task, Priority priority) {
+        const std::scoped_lock global_queue_lock(this->global_queue_mutex);
+
+        this->global_queues[tier_index(priority)].push(std::move(task));
+        this->global_queue_size.fetch_add(1, std::memory_order_seq_cst);
+        this->record_global_queue_depth(this->global_queues[tier_index(priority)].size());
+        if (priority == Priority::high) this->high_priority_size.fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    // Pushes 'wrap(*it)' for every element of '[first, last)' as a single batch, 'pushed' counts successful pushes
+    // so the caller can roll back its own accounting when some allocation throws halfway through the batch
+    template <class It, class Wrap>
+    void push_bulk(It first, It last, Wrap&& wrap, std::size_t& pushed) {
+        const std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+
+        if (!count) return;
+
+        this->tasks_unfinished.fetch_add(count, std::memory_order_seq_cst); // same reasoning as 'detached_task()'
+
+        try {
+            // Recursive tasks, local deque is lock-free, the gain comes from notifying workers just once
+            if (ws_this_thread::thread_pool_ptr == this) {
+                for (; first != last; ++first, ++pushed) this->push_local(this->make_task(wrap(*first)));
+            }
+            // Regular tasks, the whole batch goes in under a single lock
+            else {
+                const std::scoped_lock global_queue_lock(this->global_queue_mutex);
+
+                try {
+                    for (; first != last; ++first, ++pushed)
+                        this->global_queues[tier_index(Priority::normal)].push(this->make_task(wrap(*first)));
+                } catch (...) {
+                    this->global_queue_size.fetch_add(pushed, std::memory_order_seq_cst);
+                    throw;
+                }
+
+                this->global_queue_size.fetch_add(pushed, std::memory_order_seq_cst);
+                this->record_global_queue_depth(this->global_queues[tier_index(Priority::normal)].size());
+            }
+        } catch (...) {
+            const std::size_t not_pushed = count - pushed;
+            if (this->tasks_unfinished.fetch_sub(not_pushed, std::memory_order_acq_rel) == not_pushed)
+                this->tasks_done.notify_all();
+            this->task_available.notify(pushed);
+            throw;
+        }
+
+        this->task_available.notify(count);
+    }
+
+public:
+    explicit ThreadPool(std::size_t count = std::thread::hardware_concurrency(), Placement placement = {})
+        : placement(std::move(placement)) {
+        this->spawn_workers(count);
+    }
+
+    ~ThreadPool() noexcept {
+        try {
+            this->wait();
+            this->terminate_workers();
+        } catch (...) {} // no throwing from the destructor
+    }
+
+    template <class T = void>
+    struct future_type {
+        std::future<T> future;
+
+        void fallthrough() const {
+            ThreadPool* pool = ws_this_thread::thread_pool_ptr;
+
+            if (!pool) return;
+
+            // Execute recursive tasks from local queues until this future is ready
+            task_type task;
+            while (pool->try_pop_local(task) || pool->try_steal(task)) {
+                pool->execute(task);
+
+                if (this->is_ready()) return;
+            }
+        }
+
+        bool is_ready() const { return this->future.wait_for(std::chrono::seconds{0}) == std::future_status::ready; }
+
+    public:
+        future_type(std::future<T>&& future) : future(std::move(future)) {} // conversion from regular future
+        future_type& operator=(std::future<T>&& future) {
+            this->future = std::move(future);
+            return *this;
+        }
+
+        using is_recursive = void;
+
+        auto get() {
+            this->fallthrough();
+            return this->future.get();
+        }
+
+        bool valid() const noexcept { return this->future.valid(); }
+
+        void wait() const {
+            this->fallthrough();
+            this->future.wait();
+        }
+
+        template <class Rep, class Period>
+        std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout_duration) const {
+            this->fallthrough();
+            return this->future.wait_for(timeout_duration);
+        }
+
+        template <class Clock, class Duration>
+        std::future_status wait_until(const std::chrono::time_point<Clock, Duration>& timeout_time) const {
+            this->fallthrough();
+            return this->future.wait_until(timeout_time);
+        }
+    };
+
+    void set_thread_count(std::size_t count) {
+        if (ws_this_thread::thread_pool_ptr == this)
+            throw std::runtime_error("Cannot resize thread pool from its own pool thread.");
+
+        const std::scoped_lock workers_lock(this->workers_mutex);
+
+        this->wait();
+        this->terminate_workers();
+        this->spawn_workers(count);
+    }
+
+    void set_thread_count(std::size_t count, Placement placement) {
+        if (ws_this_thread::thread_pool_ptr == this)
+            throw std::runtime_error("Cannot resize thread pool from its own pool thread.");
+
+        const std::scoped_lock workers_lock(this->workers_mutex);
+
+        this->wait();
+        this->terminate_workers();
+        this->placement = std::move(placement);
+        this->spawn_workers(count);
+    }
+
+    [[nodiscard]] std::size_t get_thread_count() {
+        if (ws_this_thread::thread_pool_ptr == this) return this->workers.size();
+        // calls from inside the pool shouldn't lock, otherwise we could deadlock the thread by trying to
+        // query the thread count while the pool was instructed to resize, worker count is constant during
+        // a worker lifetime so it's safe to query without a lock anyways
+
+        const std::scoped_lock workers_lock(this->workers_mutex);
+
+        return this->workers.size();
+    }
+
+    void wait() {
+        while (this->tasks_unfinished.load(std::memory_order_acquire)) {
+            const EventCount::key_type key = this->tasks_done.prepare_wait();
+
+            if (!this->tasks_unfinished.load(std::memory_order_seq_cst)) {
+                this->tasks_done.cancel_wait();
+                return;
+            }
+
+            this->tasks_done.commit_wait(key);
+        }
+    }
+
+#ifdef utl_parallel_has_coroutines
+    // Awaiting it moves the coroutine onto one of the pool threads
+    [[nodiscard]] auto schedule() noexcept {
+        struct ScheduleAwaiter {
+            ThreadPool* pool;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) {
+                this->pool->detached_task([handle] { handle.resume(); });
+            }
+            void await_resume() const noexcept {}
+        };
+
+        return ScheduleAwaiter{this};
+    }
+
+    // Starts the coroutine on one of the pool threads, result can be awaited or waited on with '.get()' / '.wait()'
+    template <class T>
+    Coroutine<T> spawn(Coroutine<T> coroutine) {
+        if (!coroutine.handle || coroutine.handle.promise().started) return coroutine; // already running
+
+        const auto handle        = coroutine.handle;
+        handle.promise().started = true;
+        this->detached_task([handle] { handle.resume(); });
+
+        return coroutine;
+    }
+
+    // Spawns all coroutines & resumes the awaiting coroutine once all of them are done, if any of them throws
+    // the first exception (in the order of arguments) gets rethrown, but only after all coroutines have finished
+    template <class... Ts>
+    Coroutine<std::tuple<non_void_t<Ts>...>> when_all(Coroutine<Ts>... coroutines) {
+        ((coroutines = this->spawn(std::move(coroutines))), ...);
+        (co_await coroutines.completion(), ...);
+
+        co_return std::tuple<non_void_t<Ts>...>{take_result(coroutines)...};
+    }
+
+    template <class T>
+    Coroutine<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>>
+    when_all(std::vector<Coroutine<T>> coroutines) {
+        for (auto& coroutine : coroutines) coroutine = this->spawn(std::move(coroutine));
+        for (auto& coroutine : coroutines) co_await coroutine.completion();
+
+        if constexpr (std::is_void_v<T>) {
+            for (auto& coroutine : coroutines) coroutine.get();
+        } else {
+            std::vector<T> results;
+            results.reserve(coroutines.size());
+            for (auto& coroutine : coroutines) results.push_back(coroutine.get());
+            co_return results;
+        }
+    }
+
+private:
+    template <class T>
+    static non_void_t<T> take_result(Coroutine<T>& coroutine) {
+        if constexpr (std::is_void_v<T>) {
+            coroutine.get();
+            return {};
+        } else {
+            return coroutine.get();
+        }
+    }
+
+public:
+#endif
+
+    // Per-worker counters accumulated since the workers were spawned, empty unless 'UTL_PARALLEL_ENABLE_STATS' is
+    // defined. Counters are read without stopping the workers, so the snapshot is only consistent for an idle pool.
+    [[nodiscard]] PoolStats stats() {
+        std::unique_lock workers_lock(this->workers_mutex, std::defer_lock);
+        if (ws_this_thread::thread_pool_ptr != this) workers_lock.lock(); // same reasoning as 'get_thread_count()'
+
+        PoolStats stats;
+
+        for (const auto& counters : this->counters) stats.workers.push_back(counters.value.snapshot());
+        stats.max_global_queue_depth = this->max_global_queue_depth.load(std::memory_order_relaxed);
+
+        return stats;
+    }
+
+    // Approximate check for threads parked with no queued tasks to take, which means a new task would get picked
+    // up right away. Tasks queued by the calling thread itself count too, since idle threads will steal them first.
+    [[nodiscard]] bool has_idle_threads() const noexcept {
+        if (!this->task_available.has_waiters()) return false;
+        if (this->global_queue_size.load(std::memory_order_relaxed)) return false;
+        if (ws_this_thread::thread_pool_ptr == this && !this->local_queues[ws_this_thread::worker_index].empty())
+            return false;
+        return true;
+    }
+
+    template <class F, class... Args>
+    void detached_task(F&& f, Args&&... args) {
+        this->detached_task(Priority::normal, std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    template <class F, class... Args>
+    void detached_task(Priority priority, F&& f, Args&&... args) {
+        task_type task = this->make_task(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+
+        this->tasks_unfinished.fetch_add(1, std::memory_order_seq_cst);
+        // task has to be counted before it becomes visible to the workers, otherwise it could
+        // get executed & decrement the counter first, which would briefly wrap it around zero
+
+        try {
+            // Recursive task, explicitly prioritized ones still go into the global tiers so any thread can see them
+            if (ws_this_thread::thread_pool_ptr == this && priority == Priority::normal) {
+                this->push_local(std::move(task));
+            }
+            // Regular task
+            else {
+                this->push_global(std::move(task), priority);
+            }
+        } catch (...) {
+            if (this->tasks_unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) this->tasks_done.notify_all();
+            throw;
+        }
+
+        this->task_available.notify_one();
+    }
+
+    // Submits every callable of '[first, last)' as a detached task with a single queue lock & a single notification,
+    // which wakes up only as many workers as there are tasks. Use 'std::make_move_iterator()' to move the callables.
+    template <class It>
+    void bulk_detached(It first, It last) {
+        std::size_t pushed = 0;
+        this->push_bulk(first, last, [](auto&& f) -> auto&& { return std::forward<decltype(f)>(f); }, pushed);
+    }
+
+    template <class F, class... Args, class R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    future_type<R> awaitable_task(F&& f, Args&&... args) {
+        return this->awaitable_task(Priority::normal, std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    template <class F, class... Args, class R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    future_type<R> awaitable_task(Priority priority, F&& f, Args&&... args) {
+        auto closure = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+
+        std::promise<R> promise;
+        future_type<R>  future = promise.get_future();
+
+        this->detached_task(priority, [closure = std::move(closure), promise = std::move(promise)]() mutable {
+            try {
+                if constexpr (std::is_void_v<R>) {
+                    closure();
+                    promise.set_value();
+                } else {
+                    promise.set_value(closure());
+                } // 'promise.set_value(f())' when 'f()' returns 'void' is a compile error, so we use a workaround
+            } catch (...) {
+                try {
+                    promise.set_exception(std::current_exception()); // this may still throw
+                } catch (...) {}
+            }
+        });
+
+        return future;
+    }
+};
+
+template <class T = void>
+using Future = ThreadPool::future_type<T>;
+
+// ==================
+// --- Task group ---
+// ==================
+
+// Fork-join primitive for recursive divide-and-conquer. Unlike awaitable tasks it doesn't allocate a shared
+// 'std::promise<>' / 'std::future<>' state per task, all of the state lives in the group on the stack of the
+// waiting thread, children only capture a pointer to it. Pending counter starts at 1, which is the reference
+// held by the group itself until 'wait()', this way the counter can only reach zero once the group is waited on.
+//
+// Waiting from a pool thread executes queued work (most likely our own children from the local deque) until
+// every child is done. When there is nothing to take the thread parks on the same event count as idle workers,
+// so any newly pushed task (for example grandchildren pushed by whoever stole our child) wakes it up to help
+// and the waiting thread counts as idle for 'ThreadPool::has_idle_threads()'. Completion of the last child
+// wakes it up too. Waiting from an external thread just parks until the last child signals completion.
+
+class TaskGroup {
+    ThreadPool* pool;
+
+    alignas(cache_line_size) std::atomic<std::size_t> pending{1};
+
+    std::atomic<bool>       failed{false};
+    std::atomic<bool>       helper_parked{false}; // pool thread waiting on the group is parked as an idle worker
+    std::exception_ptr      exception;
+    bool                    done = false;
+    std::mutex              mutex;
+    std::condition_variable cv;
+
+    void capture_exception(std::exception_ptr ptr) {
+        const std::scoped_lock lock(this->mutex);
+        if (!this->exception) this->exception = std::move(ptr); // first exception wins
+        this->failed.store(true, std::memory_order_relaxed);
+    }
+
+    void finish_one() {
+        if (this->pending.fetch_sub(1, std::memory_order_seq_cst) != 1) return;
+
+        // Parked helper can't be woken up selectively, it sleeps among idle workers. Either it sees 'pending == 0'
+        // before parking, or we see the flag here, both sides use 'seq_cst' so one of them can't miss the other.
+        if (this->helper_parked.load(std::memory_order_seq_cst)) this->pool->task_available.notify_all();
+
+        // Notification has to happen under the lock, once the waiter sees 'done' the group may be destroyed
+        const std::scoped_lock lock(this->mutex);
+        this->done = true;
+        this->cv.notify_all();
+    }
+
+    // Same loop as 'ThreadPool::worker_main()', except it ends once the group is done rather than on termination
+    void help() {
+        if (ws_this_thread::thread_pool_ptr != this->pool) return;
+
+        EventCount&           task_available = this->pool->task_available;
+        ThreadPool::task_type task;
+
+        while (this->pending.load(std::memory_order_seq_cst)) {
+            if (this->pool->try_acquire_task(task)) {
+                this->pool->execute(task);
+                continue;
+            }
+
+            const EventCount::key_type key = task_available.prepare_wait();
+            this->helper_parked.store(true, std::memory_order_seq_cst);
+
+            if (!this->pending.load(std::memory_order_seq_cst)) {
+                task_available.cancel_wait();
+            } else if (this->pool->try_acquire_task(task)) {
+                task_available.cancel_wait();
+                this->helper_parked.store(false, std::memory_order_relaxed);
+                this->pool->execute(task);
+                continue;
+            } else {
+                task_available.commit_wait(key);
+            }
+
+            this->helper_parked.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    template <class F>
+    auto make_child(F&& f) {
+        return [this, f = std::forward<F>(f)]() mutable {
+            if (!this->failed.load(std::memory_order_relaxed)) { // remaining work of a failed group is skipped
+                try {
+                    f();
+                } catch (...) { this->capture_exception(std::current_exception()); }
+            }
+            this->finish_one();
+        };
+    }
+
+public:
+    explicit TaskGroup(ThreadPool& pool) : pool(&pool) {}
+    TaskGroup(); // uses global thread pool, defined after it
+
+    TaskGroup(const TaskGroup&)            = delete;
+    TaskGroup(TaskGroup&&)                 = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    TaskGroup& operator=(TaskGroup&&)      = delete;
+
+    ~TaskGroup() {
+        try {
+            this->wait();
+        } catch (...) {} // children reference the group, it can't die before them, exceptions are discarded
+    }
+
+    template <class F>
+    void run(F&& f) {
+        this->pending.fetch_add(1, std::memory_order_relaxed); // group reference keeps the counter above zero
+
+        try {
+            this->pool->detached_task(this->make_child(std::forward<F>(f)));
+        } catch (...) {
+            this->pending.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+    }
+
+    // Runs every callable of '[first, last)' as a part of the group, see 'ThreadPool::bulk_detached()'
+    template <class It>
+    void bulk_run(It first, It last) {
+        const std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+
+        this->pending.fetch_add(count, std::memory_order_relaxed);
+
+        std::size_t pushed = 0;
+        try {
+            this->pool->push_bulk(
+                first, last, [this](auto&& f) { return this->make_child(std::forward<decltype(f)>(f)); }, pushed);
+        } catch (...) {
+            this->pending.fetch_sub(count - pushed, std::memory_order_relaxed);
+            throw;
+        }
+    }
+
+    void wait() {
+        // Release the group reference, if some children are still pending help them & park until the last one is done,
+        // even after helping we still have to wait for 'done' since the last child might still be touching the group
+        if (this->pending.fetch_sub(1, std::memory_order_seq_cst) != 1) {
+            this->help();
+
+            std::unique_lock lock(this->mutex);
+            this->cv.wait(lock, [this] { return this->done; });
+        }
+
+        // Reset the group so it can be reused
+        this->pending.store(1, std::memory_order_relaxed);
+        this->done = false;
+        this->failed.store(false, std::memory_order_relaxed);
+
+        if (std::exception_ptr ptr = std::exchange(this->exception, nullptr)) std::rethrow_exception(ptr);
+    }
+};
+
+// ==============
+// --- Ranges ---
+// ==============
+
+// --- SFINAE helpers ---
+// ----------------------
+
+template <bool Cond>
+using require = std::enable_if_t<Cond, bool>;
+
+template <class T, class... Args>
+using require_invocable = require<std::is_invocable_v<T, Args...>>;
+// this is simple convenience
+
+template <class T, class = void>
+struct has_iter : std::false_type {};
+template <class T>
+struct has_iter<T, std::void_t<decltype(std::declval<typename T::iterator>())>> : std::true_type {};
+
+template <class T, class = void>
+struct has_const_iter : std::false_type {};
+template <class T>
+struct has_const_iter<T, std::void_t<decltype(std::declval<typename T::const_iterator>())>> : std::true_type {};
+
+template <class T>
+using require_has_some_iter = require<has_iter<T>::value || has_const_iter<T>::value>;
+// needed to restrict template 'Range' constructor from a container, otherwise it takes priority over copy / move ctors
+
+template <class T, class = void>
+struct is_recursive : std::false_type {};
+template <class T>
+struct is_recursive<T, std::void_t<decltype(std::declval<typename T::is_recursive>())>> : std::true_type {};
+template <class T>
+constexpr bool is_recursive_v = is_recursive<T>::value;
+
+template <class T, class = void>
+struct has_thread_count : std::false_type {};
+template <class T>
+struct has_thread_count<T, std::void_t<decltype(std::declval<T&>().get_thread_count())>> : std::true_type {};
+template <class T>
+constexpr bool has_thread_count_v = has_thread_count<T>::value;
+
+template <class T, class = void>
+struct has_idle_threads : std::false_type {};
+template <class T>
+struct has_idle_threads<T, std::void_t<decltype(std::declval<T&>().has_idle_threads())>> : std::true_type {};
+template <class T>
+constexpr bool has_idle_threads_v = has_idle_threads<T>::value;
+
+template <class T, class = void>
+struct has_bulk_detached : std::false_type {};
+template <class T>
+struct has_bulk_detached<T, std::void_t<decltype(std::declval<T&>().bulk_detached(std::declval<void (**)()>(),
+                                                                                   std::declval<void (**)()>()))>>
+    : std::true_type {};
+template <class T>
+constexpr bool has_bulk_detached_v = has_bulk_detached<T>::value;
+
+// --- Utils ---
+// -------------
+
+[[nodiscard]] constexpr std::size_t min_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? b : a; }
+[[nodiscard]] constexpr std::size_t max_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? a : b; }
+// standard min/max would be ambiguous with our own binary operations of the same name, hence a separate pair
+
+constexpr std::size_t default_grains_per_thread = 4;
+// by default we distribute 4 tasks per thread, this number is purely empirical. We don't want to split up
+// work into too many tasks (like with 'grain_size = 1'), yet we want it to be a bit more granular than
+// doing 1 task per thread since that would be horrible if tasks are noticeably uneven.
+
+[[nodiscard]] inline std::size_t default_grain_size(std::size_t size) {
+    return max_size(1, size / (hardware_concurrency() * default_grains_per_thread));
+}
+
+constexpr std::size_t auto_grain = 0;
+// grain size sentinel that enables auto-partitioning, work gets split into coarse chunks which are then
+// split further on demand whenever some threads become idle, see 'Scheduler::auto_partitioned_loop()'
+
+constexpr std::size_t auto_grain_steps_per_thread = 64;
+// auto-partitioned chunks are processed in steps of 'size / (threads * 64)' iterations, in between the steps
+// we check whether some threads are idle and can take over a half of the remaining work
+
+[[nodiscard]] inline std::size_t resolve_grain_size(std::size_t grain_size, std::size_t size) {
+    return (grain_size == auto_grain) ? default_grain_size(size) : grain_size;
+} // algorithms that need a fixed block structure fall back onto a default grain when asked for auto-partitioning
+
+constexpr std::size_t min_parallel_scan_size = 1 << 15;
+// parallel scan traverses the input twice, which makes it slower than a serial scan unless input is large enough
+
+constexpr std::size_t min_parallel_sort_size = 1 << 14;
+// parallel sort & partition need an intermediate buffer, below this size it's faster to just do things serially
+
+// --- Range ---
+// -------------
+
+template <class It>
+constexpr bool is_random_access_v =
+    std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
+
+template <class It>
+[[nodiscard]] std::size_t distance_size(It begin, It end) {
+    return static_cast<std::size_t>(std::distance(begin, end));
+} // O(1) for random-access iterators, a single pass over the range otherwise
+
+template <class It>
+struct Range {
+    It          begin;
+    It          end;
+    std::size_t grain_size;
+
+    Range() = delete;
+
+    constexpr Range(It begin, It end, std::size_t grain_size) : begin(begin), end(end), grain_size(grain_size) {}
+
+    Range(It begin, It end)
+        : Range(begin, end, default_grain_size(distance_size(begin, end))) {}
+
+
+    template <class Container, require<has_const_iter<Container>::value> = true>
+    Range(const Container& container) : Range(container.begin(), container.end()) {}
+
+    template <class Container, require<has_iter<Container>::value> = true>
+    Range(Container& container) : Range(container.begin(), container.end()) {}
+}; // loops & reductions accept forward iterators, scans & sorts require random-access ones
+
+// Note: Blocks of random-access ranges are computed with an offset, blocks of forward ranges get built by walking
+//       the range once on the calling thread, which is still much cheaper than copying a container into a vector
+
+// CTAD for deducing iterator range from a container
+template <class Container>
+Range(const Container& container) -> Range<typename Container::const_iterator>;
+
+template <class Container>
+Range(Container& container) -> Range<typename Container::iterator>;
+
+// --- Index range ---
 // -------------------
 
-template <class Idx = std::ptrdiff_t>
-struct IndexRange {
-    Idx         first;
-    Idx         last;
-    std::size_t grain_size;
+template <class Idx = std::ptrdiff_t>
+struct IndexRange {
+    Idx         first;
+    Idx         last;
+    std::size_t grain_size;
+
+    IndexRange() = delete;
+
+    constexpr IndexRange(Idx first, Idx last, std::size_t grain_size)
+        : first(first), last(last), grain_size(grain_size) {}
+
+    IndexRange(Idx first, Idx last)
+        : IndexRange(first, last, default_grain_size(last - first)) {}
+
+    template <class Idx1, class Idx2>
+    constexpr IndexRange(Idx1 first, Idx2 last, std::size_t grain_size)
+        : first(first), last(last), grain_size(grain_size) {}
+
+    template <class Idx1, class Idx2>
+    IndexRange(Idx1 first, Idx2 last)
+        : IndexRange(first, last, default_grain_size(last - first)) {}
+};
+
+// Note: It is common to have a ranges from 'int' to 'std::size_t' (for example 'IndexRange{0, vec.size()}'),
+//       in such cases we assume 'std::ptrdiff_t' as a reasonable default
+
+// --- Multidimensional index range ---
+// ------------------------------------
+
+// Multidimensional ranges are split into tiles, tile size along each dimension is given by the grain size
+// of the corresponding 1D range, 'auto_grain' picks a size that splits the range into a default number of tiles
+
+enum class TileOrder { row_major, z_order, hilbert };
+
+template <class Idx = std::ptrdiff_t>
+struct IndexRange2D {
+    IndexRange<Idx> i;
+    IndexRange<Idx> j;
+    TileOrder       order;
+
+    IndexRange2D() = delete;
+
+    constexpr IndexRange2D(IndexRange<Idx> i, IndexRange<Idx> j, TileOrder order = TileOrder::row_major)
+        : i(i), j(j), order(order) {}
+};
+
+template <class Idx = std::ptrdiff_t>
+struct IndexRange3D {
+    IndexRange<Idx> i;
+    IndexRange<Idx> j;
+    IndexRange<Idx> k;
+    TileOrder       order;
+
+    IndexRange3D() = delete;
+
+    constexpr IndexRange3D(IndexRange<Idx> i, IndexRange<Idx> j, IndexRange<Idx> k,
+                           TileOrder order = TileOrder::row_major)
+        : i(i), j(j), k(k), order(order) {}
+};
+
+// --- Tiling ---
+// --------------
+
+// Space-filling curve keys, tiles with close keys are also close to each other in space. Threads process
+// contiguous runs of tiles, with a curve order such runs form compact blobs rather than long thin stripes,
+// which means less data gets pulled into the cache per tile for stencils & other neighborhood-based loops.
+
+template <std::size_t N>
+[[nodiscard]] constexpr std::uint64_t morton_key(const std::array<std::uint32_t, N>& coords, unsigned bits) noexcept {
+    std::uint64_t key = 0;
+    for (unsigned b = bits; b-- > 0;)
+        for (std::size_t d = 0; d < N; ++d) key = (key << 1) | ((coords[d] >> b) & 1u);
+    return key;
+}
+
+// See J. Skilling "Programming the Hilbert curve" (2004), coordinates get transformed into a "transposed"
+// Hilbert index in place, interleaving its bits the same way as for a Morton key produces the index itself
+template <std::size_t N>
+[[nodiscard]] constexpr std::uint64_t hilbert_key(std::array<std::uint32_t, N> x, unsigned bits) noexcept {
+    const std::uint32_t m = std::uint32_t(1) << (bits - 1);
+
+    // Inverse undo
+    for (std::uint32_t q = m; q > 1; q >>= 1) {
+        const std::uint32_t p = q - 1;
+        for (std::size_t i = 0; i < N; ++i) {
+            if (x[i] & q) {
+                x[0] ^= p; // invert
+            } else {
+                const std::uint32_t t = (x[0] ^ x[i]) & p; // exchange
+                x[0] ^= t;
+                x[i] ^= t;
+            }
+        }
+    }
+
+    // Gray encode
+    for (std::size_t i = 1; i < N; ++i) x[i] ^= x[i - 1];
+
+    std::uint32_t t = 0;
+    for (std::uint32_t q = m; q > 1; q >>= 1)
+        if (x[N - 1] & q) t ^= q - 1;
+    for (std::size_t i = 0; i < N; ++i) x[i] ^= t;
+
+    return morton_key(x, bits);
+}
+
+// Splits N-dimensional index range into tiles & enumerates them in a given order. Row-major order maps tile
+// numbers to tile coordinates arithmetically, curve orders sort the tile coordinates by their key upfront.
+template <std::size_t N, class Idx>
+class Tiling {
+    std::array<Idx, N>                        first;
+    std::array<std::size_t, N>                sizes;
+    std::array<std::size_t, N>                tile_sizes;
+    std::array<std::size_t, N>                tile_counts;
+    std::vector<std::array<std::uint32_t, N>> curve; // tile coordinates in curve order, empty for row-major
+
+    // Smallest number of pieces per dimension that gives at least the default number of tiles in total
+    static std::size_t default_pieces() {
+        const std::size_t target = hardware_concurrency() * default_grains_per_thread;
+
+        std::size_t pieces = 1;
+        for (;; ++pieces) {
+            std::size_t total = 1;
+            for (std::size_t d = 0; d < N; ++d) total *= pieces;
+            if (total >= target) return pieces;
+        }
+    }
+
+public:
+    Tiling(const std::array<IndexRange<Idx>, N>& ranges, TileOrder order) {
+        for (std::size_t d = 0; d < N; ++d) {
+            const IndexRange<Idx>& range = ranges[d];
+
+            this->first[d] = range.first;
+            this->sizes[d] = (range.first < range.last) ? static_cast<std::size_t>(range.last - range.first) : 0;
+
+            if (range.grain_size == auto_grain) {
+                const std::size_t pieces = default_pieces();
+                this->tile_sizes[d]      = max_size((this->sizes[d] + pieces - 1) / pieces, 1);
+            } else {
+                this->tile_sizes[d] = range.grain_size;
+            }
+
+            this->tile_counts[d] = (this->sizes[d] + this->tile_sizes[d] - 1) / this->tile_sizes[d];
+        }
+
+        if (order == TileOrder::row_major || this->size() == 0) return;
+
+        // Curve has to cover a power-of-2 grid, tiles outside of the range simply don't get a key
+        std::size_t max_count = 1;
+        for (std::size_t d = 0; d < N; ++d) max_count = max_size(max_count, this->tile_counts[d]);
+
+        unsigned bits = 1;
+        while ((max_count - 1) >> bits) ++bits;
+
+        std::vector<std::pair<std::uint64_t, std::array<std::uint32_t, N>>> keyed(this->size());
+
+        for (std::size_t t = 0; t < keyed.size(); ++t) {
+            std::array<std::uint32_t, N> coords = this->row_major_coords(t);
+            keyed[t] = {(order == TileOrder::hilbert) ? hilbert_key(coords, bits) : morton_key(coords, bits), coords};
+        }
+
+        std::sort(keyed.begin(), keyed.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+        this->curve.reserve(keyed.size());
+        for (const auto& [key, coords] : keyed) this->curve.push_back(coords);
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        std::size_t total = 1;
+        for (std::size_t d = 0; d < N; ++d) total *= this->tile_counts[d];
+        return total;
+    }
+
+    // Last dimension is the fastest one, same as for nested loops over 'i, j, k'
+    [[nodiscard]] std::array<std::uint32_t, N> row_major_coords(std::size_t t) const noexcept {
+        std::array<std::uint32_t, N> coords{};
+        for (std::size_t d = N; d-- > 0;) {
+            coords[d] = static_cast<std::uint32_t>(t % this->tile_counts[d]);
+            t /= this->tile_counts[d];
+        }
+        return coords;
+    }
+
+    // Invokes 'f(low, high)' with index bounds of the tile number 't'
+    template <class F>
+    void visit(std::size_t t, F& f) const {
+        const std::array<std::uint32_t, N> coords = this->curve.empty() ? this->row_major_coords(t) : this->curve[t];
+
+        std::array<Idx, N> low, high;
+        for (std::size_t d = 0; d < N; ++d) {
+            const std::size_t offset = coords[d] * this->tile_sizes[d];
+            const std::size_t extent = min_size(offset + this->tile_sizes[d], this->sizes[d]);
+
+            low[d]  = static_cast<Idx>(this->first[d] + static_cast<Idx>(offset));
+            high[d] = static_cast<Idx>(this->first[d] + static_cast<Idx>(extent));
+        }
+
+        f(low, high);
+    }
+};
+
+// ==========================
+// --- Per-worker storage ---
+// ==========================
+
+// Enumerable thread-local storage, similar to 'tbb::enumerable_thread_specific'. Every pool thread gets its own
+// lazily constructed value in a slot padded to a cache line & indexed by the worker index, so 'local()' needs no
+// synchronization on the hot path. Threads that don't belong to the pool fall back onto a mutex-protected map
+// keyed by thread id. Pool notifies the storage whenever its thread count changes, slots of the removed workers
+// are kept if they hold a value so nothing gets lost before the final combine.
+
+template <class T>
+class PerWorker {
+    ThreadPool* pool;
+    std::size_t observer_id;
+
+    std::function<T()>                     factory;
+    std::vector<Padded<std::optional<T>>>  worker_slots; // only resized while the pool has no workers
+    std::unordered_map<std::thread::id, T> external_slots;
+    std::mutex                             external_slots_mutex;
+
+    void resize(std::size_t count) {
+        std::size_t used = 0;
+        for (std::size_t i = 0; i < this->worker_slots.size(); ++i)
+            if (this->worker_slots[i].value) used = i + 1;
+
+        this->worker_slots.resize(std::max(count, used));
+    }
+
+public:
+    explicit PerWorker(ThreadPool& pool) : PerWorker(pool, [] { return T{}; }) {}
+
+    template <class F, require<std::is_invocable_r_v<T, F&>> = true>
+    PerWorker(ThreadPool& pool, F factory) : pool(&pool), factory(std::move(factory)) {
+        this->observer_id = this->pool->add_resize_observer([this](std::size_t count) { this->resize(count); });
+    }
+
+    PerWorker(); // uses global thread pool, defined after it
+
+    template <class F, require<std::is_invocable_r_v<T, F&>> = true>
+    explicit PerWorker(F factory); // uses global thread pool, defined after it
+
+    PerWorker(const PerWorker&)            = delete;
+    PerWorker(PerWorker&&)                 = delete;
+    PerWorker& operator=(const PerWorker&) = delete;
+    PerWorker& operator=(PerWorker&&)      = delete;
+
+    ~PerWorker() { this->pool->remove_resize_observer(this->observer_id); }
+
+    // Returns the value of the current thread, it gets constructed by the factory on the first access
+    [[nodiscard]] T& local() {
+        const std::size_t index = ws_this_thread::worker_index;
+
+        if (ws_this_thread::thread_pool_ptr == this->pool && index < this->worker_slots.size()) {
+            std::optional<T>& slot = this->worker_slots[index].value;
+            if (!slot) slot.emplace(this->factory());
+            return *slot;
+        }
+
+        const std::scoped_lock external_slots_lock(this->external_slots_mutex);
+
+        const std::thread::id id = std::this_thread::get_id();
+
+        auto it = this->external_slots.find(id);
+        if (it == this->external_slots.end()) it = this->external_slots.emplace(id, this->factory()).first;
+        return it->second; // references to the map values are stable
+    }
+
+    // Invokes 'f(value)' for every constructed value, shouldn't be called concurrently with 'local()'
+    template <class F>
+    void for_each(F&& f) {
+        for (auto& slot : this->worker_slots)
+            if (slot.value) f(*slot.value);
+
+        const std::scoped_lock external_slots_lock(this->external_slots_mutex);
+        for (auto& [id, value] : this->external_slots) f(value);
+    }
+
+    // Folds all constructed values with a binary operation, returns a value made by the factory if there are none
+    template <class Op>
+    [[nodiscard]] T combine(Op&& op) {
+        std::optional<T> result;
+        this->for_each([&](T& value) {
+            if (result) result = op(*result, value);
+            else result = value;
+        });
+        return result ? std::move(*result) : this->factory();
+    }
+
+    // Number of constructed values
+    [[nodiscard]] std::size_t size() {
+        std::size_t count = 0;
+        this->for_each([&](T&) { ++count; });
+        return count;
+    }
+
+    // Destroys all values, they will be constructed again on the next access
+    void clear() {
+        for (auto& slot : this->worker_slots) slot.value.reset();
+
+        const std::scoped_lock external_slots_lock(this->external_slots_mutex);
+        this->external_slots.clear();
+    }
+};
+
+// =======================
+// --- Partial results ---
+// =======================
+
+// Reductions accumulate results of each grain into a per-worker slot padded to a cache line, which means there is
+// no synchronization on the hot path, slots get combined by the calling thread once all grains are done. Threads
+// that don't belong to the backend can't use worker slots and fall back onto a shared mutex-protected slot, this
+// can't happen with a 'ThreadPool' backend, but custom backends might execute tasks on arbitrary threads.
+
+template <class T>
+class PartialResults {
+    std::vector<Padded<std::optional<T>>> worker_slots;
+    std::optional<T>                      shared_slot;
+    std::mutex                            shared_slot_mutex;
+    const void*                           pool;
+
+    template <class Op>
+    static void merge_into(std::optional<T>& slot, T&& partial, Op& op) {
+        if (slot) *slot = op(*slot, partial);
+        else slot = std::move(partial);
+    }
+
+public:
+    PartialResults(std::size_t worker_count, const void* pool) : worker_slots(worker_count), pool(pool) {}
+
+    template <class Op>
+    void accumulate(T&& partial, Op& op) {
+        const std::optional<void*>       thread_pool  = this_thread::get_pool();
+        const std::optional<std::size_t> thread_index = this_thread::get_index();
+
+        const bool is_backend_thread = thread_pool && *thread_pool == this->pool && thread_index &&
+                                       *thread_index < this->worker_slots.size();
+
+        if (is_backend_thread) {
+            merge_into(this->worker_slots[*thread_index].value, std::move(partial), op);
+        } else {
+            const std::scoped_lock shared_slot_lock(this->shared_slot_mutex);
+            merge_into(this->shared_slot, std::move(partial), op);
+        }
+    }
+
+    template <class Op>
+    T combine(T init, Op& op) {
+        for (auto& slot : this->worker_slots)
+            if (slot.value) init = op(init, *slot.value);
+        if (this->shared_slot) init = op(init, *this->shared_slot);
+        return init;
+    }
+};
+
+// ====================
+// --- Cancellation ---
+// ====================
+
+// Cancellation token is a shared flag, similar to 'std::stop_token' from C++20, copies of the token refer to
+// the same state. Loops that were given a token check it before every block (or every iteration for iteration
+// overloads), this way blocks that are queued but haven't started yet turn into no-ops once the token gets
+// cancelled. Blocks that are already running can poll the token themselves.
+
+class CancellationToken {
+    std::shared_ptr<std::atomic<bool>> cancelled = std::make_shared<std::atomic<bool>>(false);
+
+public:
+    void cancel() noexcept { this->cancelled->store(true, std::memory_order_release); }
+
+    [[nodiscard]] bool is_cancelled() const noexcept { return this->cancelled->load(std::memory_order_acquire); }
+};
+
+template <class F>
+struct SkipIfCancelled {
+    CancellationToken token;
+    F                 f;
+
+    template <class... Args, require_invocable<const F&, Args...> = true>
+    void operator()(Args... args) const {
+        if (!this->token.is_cancelled()) this->f(args...);
+    }
+}; // wraps block / iteration function of the loop, stays invocable with the same arguments as 'F'
+
+template <class T>
+using require_no_iter = require<!has_iter<T>::value && !has_const_iter<T>::value>;
+// distinguishes ranges from containers in the cancellable loop overloads
+
+// ================
+// --- Pipeline ---
+// ================
+
+// Token-based pipeline, similar to 'tbb::parallel_pipeline()'. Every item produced by the source becomes a token
+// that carries it through the stages, token is processed by a single task that runs as many stages as it can
+// inline. When a serial stage is busy (or it's not the turn of the token yet) the token gets parked in the stage
+// and the task ends, whichever task releases the stage resumes the next parked token as a new task, this way
+// waiting for a stage never blocks a thread. Once the number of tokens in flight reaches the limit, the source
+// stops producing until some token leaves the pipeline, which bounds the amount of buffered items.
+
+enum class StageMode { parallel, serial_in_order, serial_out_of_order };
+
+template <class F>
+struct Stage {
+    StageMode mode;
+    F         f;
+};
+
+template <class F>
+Stage<std::decay_t<F>> stage(StageMode mode, F&& f) {
+    return {mode, std::forward<F>(f)};
+}
+
+// Input types of every stage as a tuple, the source produces 'In', every stage consumes the output of the previous one
+template <class In, class... Fs>
+struct stage_inputs {
+    using type = std::tuple<>;
+};
+
+template <class In, class F, class... Fs>
+struct stage_inputs<In, F, Fs...> {
+    using next = std::invoke_result_t<F&, In&&>;
+    using rest = typename stage_inputs<next, Fs...>::type;
+    using type = decltype(std::tuple_cat(std::declval<std::tuple<In>>(), std::declval<rest>()));
+};
+
+template <class T>
+struct SerialStageState {
+    bool                     busy = false;
+    std::size_t              next = 0; // sequence number of the next token, only used by in-order stages
+    std::map<std::size_t, T> parked;   // tokens waiting for the stage, ordered by their sequence number
+};
+
+template <class Tuple>
+struct serial_stage_states;
+
+template <class... Ts>
+struct serial_stage_states<std::tuple<Ts...>> {
+    using type = std::tuple<SerialStageState<Ts>...>;
+};
+
+// Runs tasks submitted from arbitrary threads & waits for all of them, thread pool uses a task group,
+// other backends fall back onto recursive futures. Every task submits its children before it finishes,
+// so once every future in the list is done there can be no more pending tasks.
+template <class Backend>
+class TaskTracker {
+    using future_type = typename Backend::template future_type<>;
+
+    Backend&                backend;
+    std::deque<future_type> futures; // unlike a vector, deque doesn't invalidate references when growing
+    std::mutex              mutex;
+
+public:
+    explicit TaskTracker(Backend& backend) : backend(backend) {}
+
+    template <class F>
+    void run(F&& f) {
+        future_type future = this->backend.awaitable_task(std::forward<F>(f));
+
+        const std::scoped_lock lock(this->mutex);
+        this->futures.push_back(std::move(future));
+    }
+
+    void wait() {
+        for (std::size_t i = 0;; ++i) {
+            future_type* future;
+            {
+                const std::scoped_lock lock(this->mutex);
+                if (i == this->futures.size()) break;
+                future = &this->futures[i];
+            }
+            future->wait();
+        }
+
+        for (auto& future : this->futures) future.get(); // rethrows the first exception
+    }
+};
+
+template <>
+class TaskTracker<ThreadPool> : public TaskGroup {
+public:
+    explicit TaskTracker(ThreadPool& pool) : TaskGroup(pool) {}
+};
+
+template <class Backend, class Source, class... Fs>
+class Pipeline {
+    using item_type = typename std::invoke_result_t<Source&>::value_type; // source returns 'std::optional<>'
+    using inputs    = typename stage_inputs<item_type, Fs...>::type;
+
+    template <std::size_t K>
+    using input_t = std::tuple_element_t<K, inputs>;
+
+    constexpr static std::size_t stage_count = sizeof...(Fs);
+
+    Source&                   source;
+    std::tuple<Stage<Fs>&...> stages;
+    std::size_t               max_tokens;
+
+    std::mutex                                  mutex; // guards everything below
+    typename serial_stage_states<inputs>::type serial_states;
+    std::size_t                                 produced     = 0;
+    std::size_t                                 in_flight    = 0;
+    bool                                        input_active = false;
+    bool                                        input_done   = false;
+
+    std::atomic<bool>    failed{false};
+    TaskTracker<Backend> tasks;
+
+    template <class F>
+    void spawn(F&& f) {
+        this->tasks.run([this, f = std::forward<F>(f)]() mutable {
+            if (this->failed.load(std::memory_order_relaxed)) return; // failed pipeline discards remaining tokens
+
+            try {
+                f();
+            } catch (...) {
+                this->failed.store(true, std::memory_order_relaxed);
+                throw;
+            }
+        });
+    }
+
+    // Source is serial, there is only ever one input task, which spawns the next one before processing its token
+    void input() {
+        std::optional<item_type> item = this->source();
+
+        std::size_t sequence = 0;
+        bool        more     = false;
+        {
+            const std::scoped_lock lock(this->mutex);
+
+            if (!item) {
+                this->input_done   = true;
+                this->input_active = false;
+                return;
+            }
+
+            sequence           = this->produced++;
+            more               = ++this->in_flight < this->max_tokens;
+            this->input_active = more; // otherwise input gets resumed by the next token to leave the pipeline
+        }
+
+        if (more) this->spawn([this] { this->input(); });
+
+        this->process<0>(sequence, std::move(*item));
+    }
+
+    void finish_token() {
+        bool resume_input = false;
+        {
+            const std::scoped_lock lock(this->mutex);
+
+            --this->in_flight;
+            resume_input       = !this->input_active && !this->input_done;
+            this->input_active = this->input_active || resume_input;
+        }
+
+        if (resume_input) this->spawn([this] { this->input(); });
+    }
+
+    template <std::size_t K>
+    void process(std::size_t sequence, input_t<K>&& value) {
+        if (this->failed.load(std::memory_order_relaxed)) return;
+
+        const StageMode mode = std::get<K>(this->stages).mode;
+
+        if (mode == StageMode::parallel) return this->execute<K>(sequence, std::move(value));
+
+        // Serial stage, token either acquires it or gets parked until its turn
+        {
+            const std::scoped_lock lock(this->mutex);
+
+            auto& state = std::get<K>(this->serial_states);
+
+            if (state.busy || (mode == StageMode::serial_in_order && sequence != state.next)) {
+                state.parked.emplace(sequence, std::move(value));
+                return;
+            }
+
+            state.busy = true;
+        }
+
+        this->execute_serial<K>(sequence, std::move(value));
+    }
+
+    // Runs an acquired serial stage, after that hands the stage over to the next suitable parked token
+    template <std::size_t K>
+    void execute_serial(std::size_t sequence, input_t<K>&& value) {
+        const StageMode mode = std::get<K>(this->stages).mode;
+
+        const auto release = [&] {
+            typename std::map<std::size_t, input_t<K>>::node_type next;
+            {
+                const std::scoped_lock lock(this->mutex);
+
+                auto& state = std::get<K>(this->serial_states);
+
+                ++state.next;
+
+                const bool has_next = !state.parked.empty() && (mode == StageMode::serial_out_of_order ||
+                                                                state.parked.begin()->first == state.next);
+
+                if (has_next) next = state.parked.extract(state.parked.begin());
+                else state.busy = false;
+            }
+
+            // Stage stays busy, it is handed over to the parked token directly
+            if (next)
+                this->spawn([this, next_sequence = next.key(), next_value = std::move(next.mapped())]() mutable {
+                    this->execute_serial<K>(next_sequence, std::move(next_value));
+                });
+        };
+
+        this->execute<K>(sequence, std::move(value), release);
+    }
+
+    template <std::size_t K, class Release = void (*)()>
+    void execute(std::size_t sequence, input_t<K>&& value, Release&& release = [] {}) {
+        auto& f = std::get<K>(this->stages).f;
+
+        if constexpr (K + 1 < stage_count) {
+            input_t<K + 1> result = std::invoke(f, std::move(value));
+            release();
+            this->process<K + 1>(sequence, std::move(result));
+        } else {
+            std::invoke(f, std::move(value));
+            release();
+            this->finish_token();
+        }
+    }
+
+public:
+    Pipeline(Backend& backend, std::size_t max_tokens, Source& source, Stage<Fs>&... stages)
+        : source(source), stages(stages...), max_tokens(max_size(max_tokens, 1)), tasks(backend) {}
+
+    void run() {
+        this->input_active = true;
+        this->spawn([this] { this->input(); });
+        this->tasks.wait();
+    }
+};
+
+// =================
+// --- Scheduler ---
+// =================
+
+// There is a ton of boilerplate since we need a whole bunch of convenience overloads
+// (ranges / index ranges / containers, blocked functions / iteration functions, etc.),
+// but conceptually it's all quite simple we end up with 2 overloads for tasks,
+// 6+6+3=15 overloads for parallel-for and 4+4+2=10 overloads for reduce
+
+#define utl_parallel_assert_message                                                                                    \
+    "Awaitable loops require recursive task support from the 'future_type' of 'Scheduler' backend. "                   \
+    "Future can signal such support by  providing a 'using is_recursive = void' member typedef."
+// 'static_assert()' only supports string literals, cannot use constexpr variable here, assert itself
+// shouldn't be included in the macro as it makes error messages uglier due to macro expansion
+
+#define utl_parallel_random_access_message                                                                             \
+    "Scans, sorts & deterministic reductions require a 'Range' with random-access iterators."
+
+template <class Backend = ThreadPool>
+struct Scheduler {
+
+    // --- Backend ---
+    // ---------------
+
+    Backend backend; // underlying thread pool
+
+    template <class T = void>
+    using future_type = typename Backend::template future_type<T>;
+
+    template <class... Args>
+    explicit Scheduler(Args&&... args) : backend(std::forward<Args>(args)...) {}
+
+    // --- Task API ---
+    // ----------------
+
+    template <class F, class... Args>
+    void detached_task(F&& f, Args&&... args) {
+        this->backend.detached_task(std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    template <class F, class... Args, class R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    future_type<R> awaitable_task(F&& f, Args&&... args) {
+        return this->backend.awaitable_task(std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    template <class F, class... Args>
+    void detached_task(Priority priority, F&& f, Args&&... args) {
+        this->backend.detached_task(priority, std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    template <class F, class... Args, class R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    future_type<R> awaitable_task(Priority priority, F&& f, Args&&... args) {
+        return this->backend.awaitable_task(priority, std::forward<F>(f), std::forward<Args>(args)...);
+    }
+
+    // --- Fork-join API ---
+    // ---------------------
+
+    // Runs all callables in parallel & waits for them, first one gets executed inline by the calling thread
+    template <class F, class... Fs>
+    void invoke(F&& f, Fs&&... fs) {
+        if constexpr (std::is_same_v<Backend, ThreadPool>) {
+            TaskGroup group(this->backend);
+            (group.run(std::forward<Fs>(fs)), ...);
+
+            try {
+                std::forward<F>(f)();
+            } catch (...) {
+                group.wait(); // children may reference the stack of the caller, can't unwind before they're done
+                throw;
+            }
+
+            group.wait();
+        }
+        // Other backends don't expose their internals, fall back onto recursive futures
+        else {
+            static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
+
+            std::array<future_type<>, sizeof...(Fs)> futures = {this->awaitable_task(std::forward<Fs>(fs))...};
+
+            try {
+                std::forward<F>(f)();
+            } catch (...) {
+                for (const auto& future : futures) future.wait();
+                throw;
+            }
+
+            for (const auto& future : futures) future.wait();
+            for (auto& future : futures) future.get(); // rethrows exceptions of the children
+        }
+    }
+
+    // --- Parallel-for API ---
+    // ------------------------
+
+    // - 'Range' overloads (6) -
+
+    template <class It, class F, require_invocable<F, It, It> = true> // blocked loop iteration overload
+    void detached_loop(Range<It> range, F&& f) {
+        // auto-partitioned pieces share state on the stack of a waiting caller, detached loops use a default grain
+        if (range.grain_size == auto_grain)
+            range.grain_size = default_grain_size(distance_size(range.begin, range.end));
+
+        this->detached_blocks<It>(range, f);
+    }
+
+    template <class It, class F, require_invocable<F, It> = true> // single loop iteration overload
+    void detached_loop(Range<It> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](It low, It high) { // combine individual index
+            for (It it = low; it != high; ++it) f(it);                   // calls into blocks and forward
+        }; // into a blocked loop iteration overload
+        this->detached_loop(range, std::move(iterate_block));
+    }
+
+    template <class It, class F, require_invocable<F, It, It> = true>
+    void blocking_loop(Range<It> range, F&& f) {
+        if (range.grain_size == auto_grain) {
+            // forward iterators can't be split on demand in O(1), they use a default grain instead
+            if constexpr (is_random_access_v<It>)
+                return this->auto_partitioned_loop(range.end - range.begin, [&](std::size_t low, std::size_t high) {
+                    f(range.begin + low, range.begin + high);
+                });
+            else range.grain_size = default_grain_size(distance_size(range.begin, range.end));
+        }
+
+        this->blocking_blocks<It>(range, f);
+    }
+
+    template <class It, class F, require_invocable<F, It> = true>
+    void blocking_loop(Range<It> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](It low, It high) {
+            for (It it = low; it != high; ++it) f(it);
+        };
+        this->blocking_loop(range, std::move(iterate_block));
+    }
+
+    template <class It, class F, require_invocable<F, It, It> = true>
+    future_type<> awaitable_loop(Range<It> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
+
+        auto submit_loop = [this, range, f = std::forward<F>(f)] { this->blocking_loop(range, f); };
+        return this->awaitable_task(std::move(submit_loop));
+        // to wait for multiple tasks we need a vector of futures, since logically we want API to return regular
+        // 'future_type<>' rather than some composite construct, we can wrap block awaiting into another task
+        // that will "merge" all those futures into a single one for the user, this requires recursive task
+        // support from the backend so it's provided conditionally
+    }
+
+    template <class It, class F, require_invocable<F, It> = true>
+    future_type<> awaitable_loop(Range<It> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
+
+        auto iterate_block = [f = std::forward<F>(f)](It low, It high) {
+            for (It it = low; it != high; ++it) f(it);
+        };
+        return this->awaitable_loop(range, std::move(iterate_block));
+    }
+
+    // - 'IndexRange' overloads (6) -
+
+    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
+    void detached_loop(IndexRange<Idx> range, F&& f) {
+        range.grain_size = resolve_grain_size(range.grain_size, range.last - range.first);
+
+        this->detached_blocks<Idx>(range, f);
+    }
+
+    template <class Idx, class F, require_invocable<F, Idx> = true>
+    void detached_loop(IndexRange<Idx> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](Idx low, Idx high) {
+            for (Idx i = low; i < high; ++i) f(i);
+        };
+        this->detached_loop(range, std::move(iterate_block));
+    }
+
+    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
+    void blocking_loop(IndexRange<Idx> range, F&& f) {
+        if (range.grain_size == auto_grain)
+            return this->auto_partitioned_loop(range.last - range.first, [&](std::size_t low, std::size_t high) {
+                f(static_cast<Idx>(range.first + low), static_cast<Idx>(range.first + high));
+            });
+
+        this->blocking_blocks<Idx>(range, f);
+    }
+
+    template <class Idx, class F, require_invocable<F, Idx> = true>
+    void blocking_loop(IndexRange<Idx> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](Idx low, Idx high) {
+            for (Idx i = low; i < high; ++i) f(i);
+        };
+        this->blocking_loop(range, std::move(iterate_block));
+    }
+
+    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
+    future_type<> awaitable_loop(IndexRange<Idx> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
+
+        auto submit_loop = [this, range, f = std::forward<F>(f)] { this->blocking_loop(range, f); };
+        return this->awaitable_task(std::move(submit_loop));
+    }
+
+    template <class Idx, class F, require_invocable<F, Idx> = true>
+    future_type<> awaitable_loop(IndexRange<Idx> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
+
+        auto iterate_block = [f = std::forward<F>(f)](Idx low, Idx high) {
+            for (Idx i = low; i < high; ++i) f(i);
+        };
+        return this->awaitable_loop(range, std::move(iterate_block));
+    }
+
+    // - 'IndexRange2D' overloads (6) -
+
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx, Idx> = true>
+    void detached_loop(IndexRange2D<Idx> range, F&& f) {
+        auto tile = [f = std::forward<F>(f)](const auto& low, const auto& high) {
+            f(low[0], high[0], low[1], high[1]);
+        };
+        this->detached_tiles(Tiling<2, Idx>({range.i, range.j}, range.order), std::move(tile));
+    }
+
+    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
+    void detached_loop(IndexRange2D<Idx> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](Idx i_low, Idx i_high, Idx j_low, Idx j_high) {
+            for (Idx i = i_low; i < i_high; ++i)
+                for (Idx j = j_low; j < j_high; ++j) f(i, j);
+        };
+        this->detached_loop(range, std::move(iterate_block));
+    }
+
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx, Idx> = true>
+    void blocking_loop(IndexRange2D<Idx> range, F&& f) {
+        auto tile = [&f](const auto& low, const auto& high) { f(low[0], high[0], low[1], high[1]); };
+        this->blocking_tiles(Tiling<2, Idx>({range.i, range.j}, range.order), tile);
+    }
+
+    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
+    void blocking_loop(IndexRange2D<Idx> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](Idx i_low, Idx i_high, Idx j_low, Idx j_high) {
+            for (Idx i = i_low; i < i_high; ++i)
+                for (Idx j = j_low; j < j_high; ++j) f(i, j);
+        };
+        this->blocking_loop(range, std::move(iterate_block));
+    }
+
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx, Idx> = true>
+    future_type<> awaitable_loop(IndexRange2D<Idx> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
+
+        auto submit_loop = [this, range, f = std::forward<F>(f)] { this->blocking_loop(range, f); };
+        return this->awaitable_task(std::move(submit_loop));
+    }
+
+    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
+    future_type<> awaitable_loop(IndexRange2D<Idx> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
+
+        auto iterate_block = [f = std::forward<F>(f)](Idx i_low, Idx i_high, Idx j_low, Idx j_high) {
+            for (Idx i = i_low; i < i_high; ++i)
+                for (Idx j = j_low; j < j_high; ++j) f(i, j);
+        };
+        return this->awaitable_loop(range, std::move(iterate_block));
+    }
+
+    // - 'IndexRange3D' overloads (6) -
+
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx, Idx, Idx, Idx> = true>
+    void detached_loop(IndexRange3D<Idx> range, F&& f) {
+        auto tile = [f = std::forward<F>(f)](const auto& low, const auto& high) {
+            f(low[0], high[0], low[1], high[1], low[2], high[2]);
+        };
+        this->detached_tiles(Tiling<3, Idx>({range.i, range.j, range.k}, range.order), std::move(tile));
+    }
+
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx> = true>
+    void detached_loop(IndexRange3D<Idx> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](Idx i_low, Idx i_high, Idx j_low, Idx j_high, Idx k_low,
+                                                      Idx k_high) {
+            for (Idx i = i_low; i < i_high; ++i)
+                for (Idx j = j_low; j < j_high; ++j)
+                    for (Idx k = k_low; k < k_high; ++k) f(i, j, k);
+        };
+        this->detached_loop(range, std::move(iterate_block));
+    }
+
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx, Idx, Idx, Idx> = true>
+    void blocking_loop(IndexRange3D<Idx> range, F&& f) {
+        auto tile = [&f](const auto& low, const auto& high) { f(low[0], high[0], low[1], high[1], low[2], high[2]); };
+        this->blocking_tiles(Tiling<3, Idx>({range.i, range.j, range.k}, range.order), tile);
+    }
+
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx> = true>
+    void blocking_loop(IndexRange3D<Idx> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](Idx i_low, Idx i_high, Idx j_low, Idx j_high, Idx k_low,
+                                                      Idx k_high) {
+            for (Idx i = i_low; i < i_high; ++i)
+                for (Idx j = j_low; j < j_high; ++j)
+                    for (Idx k = k_low; k < k_high; ++k) f(i, j, k);
+        };
+        this->blocking_loop(range, std::move(iterate_block));
+    }
+
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx, Idx, Idx, Idx> = true>
+    future_type<> awaitable_loop(IndexRange3D<Idx> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
+
+        auto submit_loop = [this, range, f = std::forward<F>(f)] { this->blocking_loop(range, f); };
+        return this->awaitable_task(std::move(submit_loop));
+    }
+
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx> = true>
+    future_type<> awaitable_loop(IndexRange3D<Idx> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
+
+        auto iterate_block = [f = std::forward<F>(f)](Idx i_low, Idx i_high, Idx j_low, Idx j_high, Idx k_low,
+                                                      Idx k_high) {
+            for (Idx i = i_low; i < i_high; ++i)
+                for (Idx j = j_low; j < j_high; ++j)
+                    for (Idx k = k_low; k < k_high; ++k) f(i, j, k);
+        };
+        return this->awaitable_loop(range, std::move(iterate_block));
+    }
+
+    // - 'Container' overloads (3) -
+
+    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true> // without SFINAE reqs
+    void detached_loop(Container&& container, F&& f) {                                         // such overloads would
+        this->detached_loop(Range{std::forward<Container>(container)}, std::forward<F>(f));    // always get picked
+    } // over the others
+
+    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+    void blocking_loop(Container&& container, F&& f) {
+        this->blocking_loop(Range{std::forward<Container>(container)}, std::forward<F>(f));
+    }
+
+    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+    future_type<> awaitable_loop(Container&& container, F&& f) {
+        return this->awaitable_loop(Range{std::forward<Container>(container)}, std::forward<F>(f));
+    }
+
+    // - Cancellable overloads (6) -
+
+    // Any of the range types above, once the 'token' is cancelled remaining blocks / iterations get skipped
+
+    template <class R, class F, require_no_iter<R> = true>
+    void detached_loop(R range, CancellationToken token, F&& f) {
+        this->detached_loop(range, SkipIfCancelled<std::decay_t<F>>{std::move(token), std::forward<F>(f)});
+    }
+
+    template <class R, class F, require_no_iter<R> = true>
+    void blocking_loop(R range, CancellationToken token, F&& f) {
+        this->blocking_loop(range, SkipIfCancelled<std::decay_t<F>>{std::move(token), std::forward<F>(f)});
+    }
+
+    template <class R, class F, require_no_iter<R> = true>
+    future_type<> awaitable_loop(R range, CancellationToken token, F&& f) {
+        return this->awaitable_loop(range, SkipIfCancelled<std::decay_t<F>>{std::move(token), std::forward<F>(f)});
+    }
+
+    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+    void detached_loop(Container&& container, CancellationToken token, F&& f) {
+        this->detached_loop(Range{std::forward<Container>(container)}, std::move(token), std::forward<F>(f));
+    }
+
+    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+    void blocking_loop(Container&& container, CancellationToken token, F&& f) {
+        this->blocking_loop(Range{std::forward<Container>(container)}, std::move(token), std::forward<F>(f));
+    }
+
+    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+    future_type<> awaitable_loop(Container&& container, CancellationToken token, F&& f) {
+        return this->awaitable_loop(Range{std::forward<Container>(container)}, std::move(token), std::forward<F>(f));
+    }
+
+    // --- Parallel-reduce API ---
+    // ---------------------------
+
+    // - 'Range' overloads (2) -
+
+    template <class It, class Op, class R = typename It::value_type>
+    R blocking_reduce(Range<It> range, Op&& op) {
+        if (range.begin == range.end) throw std::runtime_error("Reduction over an empty range is undefined");
+
+        const auto identity = [](const auto& value) -> const auto& { return value; };
+
+        return this->blocking_transform_reduce(Range<It>{std::next(range.begin), range.end, range.grain_size},
+                                               R(*range.begin), std::forward<Op>(op), identity);
+    }
+
+    template <class It, class Op, class R = typename It::value_type>
+    future_type<R> awaitable_reduce(Range<It> range, Op&& op) {
+        auto submit_reduce = [this, range, op = std::forward<Op>(op)] { return this->blocking_reduce(range, op); };
+        return this->awaitable_task(std::move(submit_reduce));
+    }
+
+    // - 'Container' overloads (2) -
+
+    template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
+    R blocking_reduce(Container&& container, Op&& op) {
+        return this->blocking_reduce(Range{std::forward<Container>(container)}, std::forward<Op>(op));
+    }
+
+    template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
+    future_type<R> awaitable_reduce(Container&& container, Op&& op) {
+        return this->awaitable_reduce(Range{std::forward<Container>(container)}, std::forward<Op>(op));
+    }
+
+    // - Deterministic overloads (4) -
+
+    // Every grain folds its elements left-to-right into its own slot, slots then get combined by a fixed pairwise
+    // tree over the grain indices. Both only depend on the grain structure, which makes the result reproducible
+    // regardless of the thread count or the order in which grains finish, this matters for floating point.
+    template <class It, class Op, class R = typename It::value_type>
+    R blocking_deterministic_reduce(Range<It> range, Op&& op) {
+        static_assert(is_random_access_v<It>, utl_parallel_random_access_message);
+
+        if (range.begin == range.end) throw std::runtime_error("Reduction over an empty range is undefined");
+
+        const std::size_t size       = range.end - range.begin;
+        const std::size_t grain_size = resolve_grain_size(range.grain_size, size);
+        const std::size_t grains     = (size + grain_size - 1) / grain_size;
+
+        std::vector<std::optional<R>> partials(grains);
+
+        this->blocking_loop(IndexRange<std::size_t>{0, grains, 1}, [&](std::size_t low, std::size_t high) {
+            for (std::size_t grain = low; grain < high; ++grain) {
+                It       it  = range.begin + grain * grain_size;
+                const It end = range.begin + min_size((grain + 1) * grain_size, size);
+
+                R partial = R(*it);
+                for (++it; it != end; ++it) partial = op(partial, *it);
+
+                partials[grain] = std::move(partial);
+            }
+        });
+
+        for (std::size_t stride = 1; stride < grains; stride *= 2)
+            for (std::size_t grain = 0; grain + stride < grains; grain += 2 * stride)
+                partials[grain] = op(*partials[grain], *partials[grain + stride]);
+
+        return std::move(*partials.front());
+    }
+
+    template <class It, class Op, class R = typename It::value_type>
+    future_type<R> awaitable_deterministic_reduce(Range<It> range, Op&& op) {
+        auto submit_reduce = [this, range, op = std::forward<Op>(op)] {
+            return this->blocking_deterministic_reduce(range, op);
+        };
+        return this->awaitable_task(std::move(submit_reduce));
+    }
+
+    template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
+    R blocking_deterministic_reduce(Container&& container, Op&& op) {
+        return this->blocking_deterministic_reduce(Range{std::forward<Container>(container)}, std::forward<Op>(op));
+    }
+
+    template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
+    future_type<R> awaitable_deterministic_reduce(Container&& container, Op&& op) {
+        return this->awaitable_deterministic_reduce(Range{std::forward<Container>(container)}, std::forward<Op>(op));
+    }
+
+    // --- Parallel-transform-reduce API ---
+    // -------------------------------------
+
+    // - 'Range' overloads (2) -
+
+    template <class It, class T, class ReduceOp, class TransformOp>
+    T blocking_transform_reduce(Range<It> range, T init, ReduceOp&& reduce_op, TransformOp&& transform_op) {
+        PartialResults<T> partial_results(this->worker_count(), &this->backend);
+
+        this->blocking_loop(range, [&](It low, It high) {
+            T partial = transform_op(*low);
+            for (It it = std::next(low); it != high; ++it) partial = reduce_op(partial, transform_op(*it));
+
+            partial_results.accumulate(std::move(partial), reduce_op);
+        });
+
+        return partial_results.combine(std::move(init), reduce_op);
+    }
+
+    template <class It, class T, class ReduceOp, class TransformOp>
+    future_type<T> awaitable_transform_reduce(Range<It> range, T init, ReduceOp&& reduce_op,
+                                              TransformOp&& transform_op) {
+        auto submit_reduce = [this, range, init = std::move(init), reduce_op = std::forward<ReduceOp>(reduce_op),
+                              transform_op = std::forward<TransformOp>(transform_op)] {
+            return this->blocking_transform_reduce(range, init, reduce_op, transform_op);
+        };
+        return this->awaitable_task(std::move(submit_reduce));
+    }
+
+    // - 'IndexRange' overloads (2) -
+
+    template <class Idx, class T, class ReduceOp, class TransformOp>
+    T blocking_transform_reduce(IndexRange<Idx> range, T init, ReduceOp&& reduce_op, TransformOp&& transform_op) {
+        PartialResults<T> partial_results(this->worker_count(), &this->backend);
+
+        this->blocking_loop(range, [&](Idx low, Idx high) {
+            T partial = transform_op(low);
+            for (Idx i = low + 1; i < high; ++i) partial = reduce_op(partial, transform_op(i));
+
+            partial_results.accumulate(std::move(partial), reduce_op);
+        });
+
+        return partial_results.combine(std::move(init), reduce_op);
+    }
+
+    template <class Idx, class T, class ReduceOp, class TransformOp>
+    future_type<T> awaitable_transform_reduce(IndexRange<Idx> range, T init, ReduceOp&& reduce_op,
+                                              TransformOp&& transform_op) {
+        auto submit_reduce = [this, range, init = std::move(init), reduce_op = std::forward<ReduceOp>(reduce_op),
+                              transform_op = std::forward<TransformOp>(transform_op)] {
+            return this->blocking_transform_reduce(range, init, reduce_op, transform_op);
+        };
+        return this->awaitable_task(std::move(submit_reduce));
+    }
+
+    // - 'Container' overloads (2) -
+
+    template <class Container, class T, class ReduceOp, class TransformOp,
+              require_has_some_iter<std::decay_t<Container>> = true>
+    T blocking_transform_reduce(Container&& container, T init, ReduceOp&& reduce_op, TransformOp&& transform_op) {
+        return this->blocking_transform_reduce(Range{std::forward<Container>(container)}, std::move(init),
+                                               std::forward<ReduceOp>(reduce_op),
+                                               std::forward<TransformOp>(transform_op));
+    }
+
+    template <class Container, class T, class ReduceOp, class TransformOp,
+              require_has_some_iter<std::decay_t<Container>> = true>
+    future_type<T> awaitable_transform_reduce(Container&& container, T init, ReduceOp&& reduce_op,
+                                              TransformOp&& transform_op) {
+        return this->awaitable_transform_reduce(Range{std::forward<Container>(container)}, std::move(init),
+                                                std::forward<ReduceOp>(reduce_op),
+                                                std::forward<TransformOp>(transform_op));
+    }
+
+    // --- Parallel-scan API ---
+    // -------------------------
+
+    // - 'Range' overloads (4) -
+
+    template <class It, class OutIt, class Op>
+    OutIt blocking_inclusive_scan(Range<It> range, OutIt out, Op&& op) {
+        static_assert(is_random_access_v<It>, utl_parallel_random_access_message);
+
+        using value_type = typename std::iterator_traits<It>::value_type;
+
+        const auto value = [&](std::size_t i) -> decltype(auto) { return range.begin[i]; };
 
-    IndexRange() = delete;
+        return this->scan<value_type>(range.end - range.begin, range.grain_size, value, out, std::nullopt, op);
+    }
 
-    constexpr IndexRange(Idx first, Idx last, std::size_t grain_size)
-        : first(first), last(last), grain_size(grain_size) {}
+    template <class It, class OutIt, class Op>
+    future_type<OutIt> awaitable_inclusive_scan(Range<It> range, OutIt out, Op&& op) {
+        auto submit_scan = [this, range, out, op = std::forward<Op>(op)] {
+            return this->blocking_inclusive_scan(range, out, op);
+        };
+        return this->awaitable_task(std::move(submit_scan));
+    }
 
-    IndexRange(Idx first, Idx last)
-        : IndexRange(first, last, max_size(1, (last - first) / (hardware_concurrency() * default_grains_per_thread))) {}
+    template <class It, class OutIt, class T, class Op>
+    OutIt blocking_exclusive_scan(Range<It> range, OutIt out, T init, Op&& op) {
+        static_assert(is_random_access_v<It>, utl_parallel_random_access_message);
 
-    template <class Idx1, class Idx2>
-    constexpr IndexRange(Idx1 first, Idx2 last, std::size_t grain_size)
-        : first(first), last(last), grain_size(grain_size) {}
+        const auto value = [&](std::size_t i) -> decltype(auto) { return range.begin[i]; };
 
-    template <class Idx1, class Idx2>
-    IndexRange(Idx1 first, Idx2 last)
-        : IndexRange(first, last, max_size(1, (last - first) / (hardware_concurrency() * default_grains_per_thread))) {}
-};
+        return this->scan<T>(range.end - range.begin, range.grain_size, value, out, std::move(init), op);
+    }
 
-// Note: It is common to have a ranges from 'int' to 'std::size_t' (for example 'IndexRange{0, vec.size()}'),
-//       in such cases we assume 'std::ptrdiff_t' as a reasonable default
+    template <class It, class OutIt, class T, class Op>
+    future_type<OutIt> awaitable_exclusive_scan(Range<It> range, OutIt out, T init, Op&& op) {
+        auto submit_scan = [this, range, out, init = std::move(init), op = std::forward<Op>(op)] {
+            return this->blocking_exclusive_scan(range, out, init, op);
+        };
+        return this->awaitable_task(std::move(submit_scan));
+    }
 
-// =================
-// --- Scheduler ---
-// =================
+    // - 'IndexRange' overloads (4) -
 
-// There is a ton of boilerplate since we need a whole bunch of convenience overloads
-// (ranges / index ranges / containers, blocked functions / iteration functions, etc.),
-// but conceptually it's all quite simple we end up with 2 overloads for tasks,
-// 6+6+3=15 overloads for parallel-for and 4+4+2=10 overloads for reduce
+    template <class Idx, class OutIt, class Op, class F>
+    OutIt blocking_inclusive_scan(IndexRange<Idx> range, OutIt out, Op&& op, F&& f) {
+        using value_type = std::decay_t<std::invoke_result_t<F&, Idx>>;
 
-#define utl_parallel_assert_message                                                                                    \
-    "Awaitable loops require recursive task support from the 'future_type' of 'Scheduler' backend. "                   \
-    "Future can signal such support by  providing a 'using is_recursive = void' member typedef."
-// 'static_assert()' only supports string literals, cannot use constexpr variable here, assert itself
-// shouldn't be included in the macro as it makes error messages uglier due to macro expansion
+        const auto value = [&](std::size_t i) -> decltype(auto) { return f(static_cast<Idx>(range.first + i)); };
 
-template <class Backend = ThreadPool>
-struct Scheduler {
+        return this->scan<value_type>(range.last - range.first, range.grain_size, value, out, std::nullopt, op);
+    }
 
-    // --- Backend ---
-    // ---------------
+    template <class Idx, class OutIt, class Op, class F>
+    future_type<OutIt> awaitable_inclusive_scan(IndexRange<Idx> range, OutIt out, Op&& op, F&& f) {
+        auto submit_scan = [this, range, out, op = std::forward<Op>(op), f = std::forward<F>(f)] {
+            return this->blocking_inclusive_scan(range, out, op, f);
+        };
+        return this->awaitable_task(std::move(submit_scan));
+    }
 
-    Backend backend; // underlying thread pool
+    template <class Idx, class OutIt, class T, class Op, class F>
+    OutIt blocking_exclusive_scan(IndexRange<Idx> range, OutIt out, T init, Op&& op, F&& f) {
+        const auto value = [&](std::size_t i) -> decltype(auto) { return f(static_cast<Idx>(range.first + i)); };
 
-    template <class T = void>
-    using future_type = typename Backend::template future_type<T>;
+        return this->scan<T>(range.last - range.first, range.grain_size, value, out, std::move(init), op);
+    }
 
-    template <class... Args>
-    explicit Scheduler(Args&&... args) : backend(std::forward<Args>(args)...) {}
+    template <class Idx, class OutIt, class T, class Op, class F>
+    future_type<OutIt> awaitable_exclusive_scan(IndexRange<Idx> range, OutIt out, T init, Op&& op, F&& f) {
+        auto submit_scan = [this, range, out, init = std::move(init), op = std::forward<Op>(op),
+                            f = std::forward<F>(f)] { return this->blocking_exclusive_scan(range, out, init, op, f); };
+        return this->awaitable_task(std::move(submit_scan));
+    }
 
-    // --- Task API ---
-    // ----------------
+    // - 'Container' overloads (4) -
 
-    template <class F, class... Args>
-    void detached_task(F&& f, Args&&... args) {
-        this->backend.detached_task(std::forward<F>(f), std::forward<Args>(args)...);
+    template <class Container, class OutIt, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+    OutIt blocking_inclusive_scan(Container&& container, OutIt out, Op&& op) {
+        return this->blocking_inclusive_scan(Range{std::forward<Container>(container)}, out, std::forward<Op>(op));
     }
 
-    template <class F, class... Args, class R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
-    future_type<R> awaitable_task(F&& f, Args&&... args) {
-        return this->backend.awaitable_task(std::forward<F>(f), std::forward<Args>(args)...);
+    template <class Container, class OutIt, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+    future_type<OutIt> awaitable_inclusive_scan(Container&& container, OutIt out, Op&& op) {
+        return this->awaitable_inclusive_scan(Range{std::forward<Container>(container)}, out, std::forward<Op>(op));
     }
 
-    // --- Parallel-for API ---
-    // ------------------------
+    template <class Container, class OutIt, class T, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+    OutIt blocking_exclusive_scan(Container&& container, OutIt out, T init, Op&& op) {
+        return this->blocking_exclusive_scan(Range{std::forward<Container>(container)}, out, std::move(init),
+                                             std::forward<Op>(op));
+    }
 
-    // - 'Range' overloads (6) -
+    template <class Container, class OutIt, class T, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+    future_type<OutIt> awaitable_exclusive_scan(Container&& container, OutIt out, T init, Op&& op) {
+        return this->awaitable_exclusive_scan(Range{std::forward<Container>(container)}, out, std::move(init),
+                                              std::forward<Op>(op));
+    }
 
-    template <class It, class F, require_invocable<F, It, It> = true> // blocked loop iteration overload
-    void detached_loop(Range<It> range, F&& f) {
-        for (It it = range.begin; it < range.end; it += min_size(range.grain_size, range.end - it))
-            this->detached_task(f, it, it + min_size(range.grain_size, range.end - it));
-        // 'min_size(...)' bit takes care of the unevenly sized tail segment
+    // --- Parallel-sort API ---
+    // -------------------------
+
+    // - 'Range' overloads (3) -
+
+    template <class It, class Cmp = std::less<>>
+    void sort(Range<It> range, Cmp&& cmp = Cmp{}) {
+        static_assert(is_random_access_v<It>, utl_parallel_random_access_message);
+        this->merge_sort<false>(range, cmp);
     }
 
-    template <class It, class F, require_invocable<F, It> = true> // single loop iteration overload
-    void detached_loop(Range<It> range, F&& f) {
-        auto iterate_block = [f = std::forward<F>(f)](It low, It high) { // combine individual index
-            for (It it = low; it < high; ++it) f(it);                    // calls into blocks and forward
-        }; // into a blocked loop iteration overload
-        this->detached_loop(range, std::move(iterate_block));
+    template <class It, class Cmp = std::less<>>
+    void stable_sort(Range<It> range, Cmp&& cmp = Cmp{}) {
+        static_assert(is_random_access_v<It>, utl_parallel_random_access_message);
+        this->merge_sort<true>(range, cmp);
     }
 
-    template <class It, class F, require_invocable<F, It, It> = true>
-    void blocking_loop(Range<It> range, F&& f) {
-        std::vector<future_type<>> futures;
+    template <class It, class Pred>
+    It partition(Range<It> range, Pred&& pred) {
+        static_assert(is_random_access_v<It>, utl_parallel_random_access_message);
 
-        for (It it = range.begin; it < range.end; it += min_size(range.grain_size, range.end - it))
-            futures.emplace_back(this->awaitable_task(f, it, it + min_size(range.grain_size, range.end - it)));
+        using value_type = typename std::iterator_traits<It>::value_type;
 
-        for (auto& future : futures) future.wait();
+        const std::size_t size       = range.end - range.begin;
+        const std::size_t block_size = resolve_grain_size(range.grain_size, size);
+
+        if (size < min_parallel_sort_size || size <= block_size) return std::partition(range.begin, range.end, pred);
+
+        const std::size_t block_count = (size + block_size - 1) / block_size;
+
+        // Evaluate the predicate once per element & count matches in each block, scan over counts gives us
+        // output offsets. Predicate results are stored so the scatter can't disagree with the counts even if
+        // the predicate is impure.
+        std::vector<char>        matches(size);
+        std::vector<std::size_t> true_offsets(block_count + 1, 0);
+
+        this->blocking_loop(IndexRange<std::size_t>{0, block_count, 1}, [&](std::size_t block) {
+            const std::size_t low  = block * block_size;
+            const std::size_t high = min_size(low + block_size, size);
+
+            std::size_t count = 0;
+            for (std::size_t i = low; i < high; ++i) count += (matches[i] = static_cast<bool>(pred(range.begin[i])));
+
+            true_offsets[block + 1] = count;
+        });
+
+        for (std::size_t block = 0; block < block_count; ++block) true_offsets[block + 1] += true_offsets[block];
+
+        const std::size_t true_count = true_offsets.back();
+
+        // Leading matches & trailing non-matches are already in place, only the part in between needs a buffer
+        std::size_t first = 0, last = size;
+        while (first < last && matches[first]) ++first;
+        while (first < last && !matches[last - 1]) --last;
+
+        if (first == last) return range.begin + true_count;
+
+        // Scatter elements from the buffer back into the range, elements keep their relative order
+        std::vector<value_type> buffer(std::make_move_iterator(range.begin + first),
+                                       std::make_move_iterator(range.begin + last));
+
+        this->blocking_loop(IndexRange<std::size_t>{0, block_count, 1}, [&](std::size_t block) {
+            const std::size_t low  = block * block_size;
+            const std::size_t high = min_size(low + block_size, size);
+
+            std::size_t true_pos  = true_offsets[block];
+            std::size_t false_pos = true_count + low - true_offsets[block];
+
+            for (std::size_t i = low; i < high; ++i) {
+                const std::size_t pos = matches[i] ? true_pos++ : false_pos++;
+                if (first <= i && i < last) range.begin[pos] = std::move(buffer[i - first]);
+            }
+        });
+
+        return range.begin + true_count;
     }
 
-    template <class It, class F, require_invocable<F, It> = true>
-    void blocking_loop(Range<It> range, F&& f) {
-        auto iterate_block = [f = std::forward<F>(f)](It low, It high) {
-            for (It it = low; it < high; ++it) f(it);
-        };
-        this->blocking_loop(range, std::move(iterate_block));
+    // - 'Container' overloads (3) -
+
+    template <class Container, class Cmp = std::less<>, require_has_some_iter<std::decay_t<Container>> = true>
+    void sort(Container&& container, Cmp&& cmp = Cmp{}) {
+        this->sort(Range{std::forward<Container>(container)}, std::forward<Cmp>(cmp));
     }
 
-    template <class It, class F, require_invocable<F, It, It> = true>
-    future_type<> awaitable_loop(Range<It> range, F&& f) {
-        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
+    template <class Container, class Cmp = std::less<>, require_has_some_iter<std::decay_t<Container>> = true>
+    void stable_sort(Container&& container, Cmp&& cmp = Cmp{}) {
+        this->stable_sort(Range{std::forward<Container>(container)}, std::forward<Cmp>(cmp));
+    }
 
-        auto submit_loop = [this, range, f = std::forward<F>(f)] { this->blocking_loop(range, f); };
-        return this->awaitable_task(std::move(submit_loop));
-        // to wait for multiple tasks we need a vector of futures, since logically we want API to return regular
-        // 'future_type<>' rather than some composite construct, we can wrap block awaiting into another task
-        // that will "merge" all those futures into a single one for the user, this requires recursive task
-        // support from the backend so it's provided conditionally
+    template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+    auto partition(Container&& container, Pred&& pred) {
+        return this->partition(Range{std::forward<Container>(container)}, std::forward<Pred>(pred));
     }
 
-    template <class It, class F, require_invocable<F, It> = true>
-    future_type<> awaitable_loop(Range<It> range, F&& f) {
-        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
+    // --- Parallel-search API ---
+    // ---------------------------
 
-        auto iterate_block = [f = std::forward<F>(f)](It low, It high) {
-            for (It it = low; it < high; ++it) f(it);
-        };
-        return this->awaitable_loop(range, std::move(iterate_block));
+    // - 'Range' overloads (4) -
+
+    // Returns the first iterator satisfying 'pred', same as 'std::find_if()'. Once a block finds a match, blocks
+    // after it stop or get skipped entirely, blocks before it still have to finish since they could contain an
+    // earlier match. Since blocks are queued in order, earlier blocks usually get searched first.
+    template <class It, class Pred>
+    It find_if(Range<It> range, Pred&& pred) {
+        if (range.grain_size == auto_grain)
+            range.grain_size = default_grain_size(distance_size(range.begin, range.end));
+
+        std::vector<It> bounds; // block boundaries, the last one is the end of the range
+        for_each_block(range, [&](It low, It) { bounds.push_back(low); });
+        bounds.push_back(range.end);
+
+        const std::size_t blocks = bounds.size() - 1;
+
+        std::vector<It>          matches(blocks, range.end);
+        std::atomic<std::size_t> first_match{blocks}; // earliest block with a match so far, 'blocks' if none
+
+        this->blocking_loop(IndexRange<std::size_t>{0, blocks, 1}, [&](std::size_t block) {
+            for (It it = bounds[block]; it != bounds[block + 1]; ++it) {
+                if (block > first_match.load(std::memory_order_relaxed)) return;
+                if (!pred(*it)) continue;
+
+                matches[block] = it;
+
+                std::size_t current = first_match.load(std::memory_order_relaxed);
+                while (block < current && !first_match.compare_exchange_weak(current, block)) {}
+                return;
+            }
+        });
+
+        const std::size_t block = first_match.load(std::memory_order_relaxed);
+        return (block == blocks) ? range.end : matches[block];
     }
 
-    // - 'IndexRange' overloads (6) -
+    // Any match is enough to know the answer, first match cancels the loop so that queued blocks get skipped,
+    // running blocks poll a flag on the stack, which is cheaper than going through the token for every element
+    template <class It, class Pred>
+    bool any_of(Range<It> range, Pred&& pred) {
+        CancellationToken token;
+        std::atomic<bool> found{false};
+
+        this->blocking_loop(range, token, [&](It low, It high) {
+            for (It it = low; it != high && !found.load(std::memory_order_relaxed); ++it) {
+                if (!pred(*it)) continue;
+                found.store(true, std::memory_order_relaxed);
+                token.cancel();
+            }
+        });
 
-    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
-    void detached_loop(IndexRange<Idx> range, F&& f) {
-        for (Idx i = range.first; i < range.last; i += static_cast<Idx>(range.grain_size))
-            this->detached_task(f, i, static_cast<Idx>(min_size(i + range.grain_size, range.last)));
+        return found.load(std::memory_order_relaxed);
     }
 
-    template <class Idx, class F, require_invocable<F, Idx> = true>
-    void detached_loop(IndexRange<Idx> range, F&& f) {
-        auto iterate_block = [f = std::forward<F>(f)](Idx low, Idx high) {
-            for (Idx i = low; i < high; ++i) f(i);
-        };
-        this->detached_loop(range, std::move(iterate_block));
+    template <class It, class Pred>
+    bool all_of(Range<It> range, Pred&& pred) {
+        return !this->any_of(range, [&](const auto& value) { return !pred(value); });
     }
 
-    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
-    void blocking_loop(IndexRange<Idx> range, F&& f) {
-        std::vector<future_type<>> futures;
+    template <class It, class Pred>
+    bool none_of(Range<It> range, Pred&& pred) {
+        return !this->any_of(range, std::forward<Pred>(pred));
+    }
 
-        for (Idx i = range.first; i < range.last; i += static_cast<Idx>(range.grain_size))
-            futures.emplace_back(
-                this->awaitable_task(f, i, static_cast<Idx>(min_size(i + range.grain_size, range.last))));
+    // - 'Container' overloads (4) -
 
-        for (auto& future : futures) future.wait();
+    template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+    auto find_if(Container&& container, Pred&& pred) {
+        return this->find_if(Range{std::forward<Container>(container)}, std::forward<Pred>(pred));
     }
 
-    template <class Idx, class F, require_invocable<F, Idx> = true>
-    void blocking_loop(IndexRange<Idx> range, F&& f) {
-        auto iterate_block = [f = std::forward<F>(f)](Idx low, Idx high) {
-            for (Idx i = low; i < high; ++i) f(i);
-        };
-        this->blocking_loop(range, std::move(iterate_block));
+    template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+    bool any_of(Container&& container, Pred&& pred) {
+        return this->any_of(Range{std::forward<Container>(container)}, std::forward<Pred>(pred));
     }
 
-    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
-    future_type<> awaitable_loop(IndexRange<Idx> range, F&& f) {
-        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
+    template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+    bool all_of(Container&& container, Pred&& pred) {
+        return this->all_of(Range{std::forward<Container>(container)}, std::forward<Pred>(pred));
+    }
 
-        auto submit_loop = [this, range, f = std::forward<F>(f)] { this->blocking_loop(range, f); };
-        return this->awaitable_task(std::move(submit_loop));
+    template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+    bool none_of(Container&& container, Pred&& pred) {
+        return this->none_of(Range{std::forward<Container>(container)}, std::forward<Pred>(pred));
     }
 
-    template <class Idx, class F, require_invocable<F, Idx> = true>
-    future_type<> awaitable_loop(IndexRange<Idx> range, F&& f) {
+    // --- Pipeline API ---
+    // --------------------
+
+    // Runs 'source()' until it returns 'std::nullopt', passing every produced item through the stages,
+    // at most 'max_tokens' items can be in flight at the same time
+    template <class Source, class... Fs>
+    void pipeline(std::size_t max_tokens, Source&& source, Stage<Fs>... stages) {
+        static_assert(sizeof...(Fs) > 0, "Pipeline requires at least one stage after the source.");
         static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
 
-        auto iterate_block = [f = std::forward<F>(f)](Idx low, Idx high) {
-            for (Idx i = low; i < high; ++i) f(i);
+        Pipeline<Backend, std::remove_reference_t<Source>, Fs...>(this->backend, max_tokens, source, stages...).run();
+    }
+
+private:
+    template <class It, class G>
+    static void for_each_block(const Range<It>& range, G&& g) {
+        if constexpr (is_random_access_v<It>) {
+            for (It it = range.begin; it < range.end; it += min_size(range.grain_size, range.end - it))
+                g(it, it + min_size(range.grain_size, range.end - it));
+            // 'min_size(...)' bit takes care of the unevenly sized tail segment
+        } else {
+            for (It low = range.begin; low != range.end;) {
+                It high = low;
+                for (std::size_t i = 0; i < range.grain_size && high != range.end; ++i) ++high;
+                g(low, high);
+                low = high;
+            }
+        }
+    }
+
+    template <class Idx, class G>
+    static void for_each_block(const IndexRange<Idx>& range, G&& g) {
+        for (Idx i = range.first; i < range.last; i += static_cast<Idx>(range.grain_size))
+            g(i, static_cast<Idx>(min_size(i + range.grain_size, range.last)));
+    }
+
+    // Submits 'f(low, high)' for every block of the range, backends supporting bulk submission get all of the
+    // blocks in a single batch, which saves us from locking the queue & waking up a worker once per block
+    template <class T, class R, class F>
+    void detached_blocks(const R& range, F& f) {
+        if constexpr (has_bulk_detached_v<Backend>) {
+            const auto make_block = [&f](T low, T high) { return [f, low, high]() mutable { f(low, high); }; };
+
+            std::vector<std::invoke_result_t<decltype(make_block), T, T>> blocks;
+            for_each_block(range, [&](T low, T high) { blocks.push_back(make_block(low, high)); });
+
+            this->backend.bulk_detached(std::make_move_iterator(blocks.begin()), std::make_move_iterator(blocks.end()));
+        } else {
+            for_each_block(range, [&](T low, T high) { this->detached_task(f, low, high); });
+        }
+    }
+
+    // Runs 'f(low, high)' for every block of the range & waits for all of them, rethrows the first exception.
+    // Thread pool runs the blocks through a task group, which avoids allocating a future for every block.
+    template <class T, class R, class F>
+    void blocking_blocks(const R& range, F& f) {
+        if constexpr (std::is_same_v<Backend, ThreadPool>) {
+            const auto make_block = [&f](T low, T high) { return [f, low, high]() mutable { f(low, high); }; };
+
+            std::vector<std::invoke_result_t<decltype(make_block), T, T>> blocks;
+            for_each_block(range, [&](T low, T high) { blocks.push_back(make_block(low, high)); });
+
+            TaskGroup group(this->backend);
+            group.bulk_run(std::make_move_iterator(blocks.begin()), std::make_move_iterator(blocks.end()));
+            group.wait();
+        } else {
+            std::vector<future_type<>> futures;
+            for_each_block(range, [&](T low, T high) { futures.emplace_back(this->awaitable_task(f, low, high)); });
+
+            for (auto& future : futures) future.wait();
+            for (auto& future : futures) future.get();
+        }
+    }
+
+    // Tiles are processed as an auto-partitioned loop over tile numbers, this way threads take contiguous runs
+    // of tiles, which stay spatially close to each other when tiles are ordered along a space-filling curve
+    template <std::size_t N, class Idx, class F>
+    void blocking_tiles(const Tiling<N, Idx>& tiling, F& f) {
+        this->auto_partitioned_loop(tiling.size(), [&](std::size_t low, std::size_t high) {
+            for (std::size_t t = low; t < high; ++t) tiling.visit(t, f);
+        });
+    }
+
+    // Detached tiles can outlive the caller, tiling gets shared between the tasks instead of being copied into each
+    template <std::size_t N, class Idx, class F>
+    void detached_tiles(Tiling<N, Idx>&& tiling, F&& f) {
+        const auto shared_tiling = std::make_shared<const Tiling<N, Idx>>(std::move(tiling));
+
+        auto iterate_tiles = [shared_tiling, f = std::forward<F>(f)](std::size_t low, std::size_t high) mutable {
+            for (std::size_t t = low; t < high; ++t) shared_tiling->visit(t, f);
         };
-        return this->awaitable_loop(range, std::move(iterate_block));
+        this->detached_blocks<std::size_t>(IndexRange<std::size_t>{0, shared_tiling->size(), 1}, iterate_tiles);
     }
 
-    // - 'Container' overloads (3) -
+    std::size_t worker_count() {
+        if constexpr (has_thread_count_v<Backend>) return this->backend.get_thread_count();
+        else return 0; // backend doesn't expose its thread count => all partial results go into the shared slot
+    }
 
-    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true> // without SFINAE reqs
-    void detached_loop(Container&& container, F&& f) {                                         // such overloads would
-        this->detached_loop(Range{std::forward<Container>(container)}, std::forward<F>(f));    // always get picked
-    } // over the others
+    // Auto-partitioned loop over offsets '[0, size)', this is what TBB calls an "auto partitioner". Work starts
+    // as a single coarse piece per thread, each piece is processed in small steps and whenever backend reports
+    // idle threads in between the steps, upper half of the remaining work gets split off into a new task. Since
+    // idle threads only exist if nothing is left to steal, this only splits when a previous split got stolen.
+    // Backends without 'has_idle_threads()' can't split on demand, they just use the default number of pieces.
+    template <class F>
+    void auto_partitioned_loop(std::size_t size, F&& f) {
+        if (size == 0) return;
 
-    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
-    void blocking_loop(Container&& container, F&& f) {
-        this->blocking_loop(Range{std::forward<Container>(container)}, std::forward<F>(f));
+        const std::size_t threads = max_size(this->worker_count(), 1);
+        const std::size_t step    = max_size(size / (threads * auto_grain_steps_per_thread), 1);
+
+        const auto run_piece = [&](const auto& self, std::size_t low, std::size_t high) -> void {
+            std::vector<future_type<>> splits;
+
+            const auto wait_for_splits = [&] {
+                for (auto& split : splits) split.wait();
+            };
+
+            try {
+                while (low < high) {
+                    if (high - low >= 2 * step && this->has_idle_threads()) {
+                        const std::size_t mid = low + (high - low) / 2;
+                        splits.emplace_back(this->awaitable_task([&self, mid, high] { self(self, mid, high); }));
+                        high = mid;
+                    } else {
+                        const std::size_t next = min_size(low + step, high);
+                        f(low, next);
+                        low = next;
+                    }
+                }
+            } catch (...) {
+                wait_for_splits(); // splits reference this stack frame, they can't outlive it
+                throw;
+            }
+
+            wait_for_splits();
+            for (auto& split : splits) split.get(); // rethrows exceptions of the splits
+        };
+
+        const std::size_t pieces = min_size(has_idle_threads_v<Backend> ? threads : threads * default_grains_per_thread,
+                                            (size + step - 1) / step);
+
+        std::vector<future_type<>> futures;
+
+        for (std::size_t piece = 0; piece < pieces; ++piece) {
+            const std::size_t low  = size * piece / pieces;
+            const std::size_t high = size * (piece + 1) / pieces;
+            futures.emplace_back(this->awaitable_task([&run_piece, low, high] { run_piece(run_piece, low, high); }));
+        }
+
+        for (auto& future : futures) future.wait();
+        for (auto& future : futures) future.get();
+        // not using 'blocking_loop()' here since that would recursively instantiate auto-partitioning templates
     }
 
-    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
-    future_type<> awaitable_loop(Container&& container, F&& f) {
-        return this->awaitable_loop(Range{std::forward<Container>(container)}, std::forward<F>(f));
+    bool has_idle_threads() {
+        if constexpr (has_idle_threads_v<Backend>) return this->backend.has_idle_threads();
+        else return false;
     }
 
-    // --- Parallel-reduce API ---
-    // ---------------------------
+    // Merge sort, chunks of 'grain_size' get sorted in parallel, after which sorted runs get merged pairwise
+    // in rounds, ping-ponging between the range and the buffer. Merges themselves are also parallel, output
+    // of each merge is split into pieces of 'grain_size' that can be merged independently (see 'merge_round()').
+    template <bool stable, class It, class Cmp>
+    void merge_sort(Range<It> range, Cmp& cmp) {
+        using value_type = typename std::iterator_traits<It>::value_type;
 
-    // - 'Range' overloads (2) -
+        const std::size_t size       = range.end - range.begin;
+        const std::size_t chunk_size = resolve_grain_size(range.grain_size, size);
 
-    template <class It, class Op, class R = typename It::value_type>
-    R blocking_reduce(Range<It> range, Op&& op) {
-        if (range.begin == range.end) throw std::runtime_error("Reduction over an empty range is undefined");
+        const auto serial_sort = [&](It first, It last) {
+            if constexpr (stable) std::stable_sort(first, last, cmp);
+            else std::sort(first, last, cmp);
+        };
+
+        if (size < min_parallel_sort_size || size <= chunk_size) return serial_sort(range.begin, range.end);
+
+        this->blocking_loop(Range<It>{range.begin, range.end, chunk_size}, serial_sort);
+
+        std::vector<value_type> buffer(std::make_move_iterator(range.begin), std::make_move_iterator(range.end));
+
+        bool in_buffer = true;
+
+        for (std::size_t width = chunk_size; width < size; width *= 2) {
+            if (in_buffer) this->merge_round(buffer.begin(), range.begin, size, width, chunk_size, cmp);
+            else this->merge_round(range.begin, buffer.begin(), size, width, chunk_size, cmp);
+            in_buffer = !in_buffer;
+        }
+
+        if (in_buffer)
+            this->blocking_loop(IndexRange<std::size_t>{0, size, chunk_size}, [&](std::size_t low, std::size_t high) {
+                std::move(buffer.begin() + low, buffer.begin() + high, range.begin + low);
+            });
+    }
+
+    // Merges pairs of adjacent sorted runs of 'width' from 'src' into 'dst'. To merge in parallel we use the merge
+    // path approach: for every output offset 'd' binary search finds how many of the first 'd' merged elements
+    // come from the left run, this splits both runs into pieces that merge independently of each other.
+    // Note: Splits have to be computed in a separate pass, otherwise a search could read elements already moved
+    //       out by a neighbouring piece.
+    template <class Src, class Dst, class Cmp>
+    void merge_round(Src src, Dst dst, std::size_t size, std::size_t width, std::size_t piece_size, Cmp& cmp) {
+        const std::size_t pair_width      = 2 * width;
+        const std::size_t pair_count      = (size + pair_width - 1) / pair_width;
+        const std::size_t pieces_per_pair = (pair_width + piece_size - 1) / piece_size;
+
+        struct Piece {
+            std::size_t first, mid, last; // pair of runs
+            std::size_t low, high;        // merged output
+        };
+
+        const auto get_piece = [&](std::size_t task) {
+            const std::size_t pair  = task / pieces_per_pair;
+            const std::size_t piece = task % pieces_per_pair;
+
+            const std::size_t first = pair * pair_width;
+            const std::size_t mid   = min_size(first + width, size);
+            const std::size_t last  = min_size(first + pair_width, size);
+            const std::size_t low   = min_size(first + piece * piece_size, last);
+            const std::size_t high  = min_size(low + piece_size, last);
+
+            return Piece{first, mid, last, low, high}; // tail pair might have fewer pieces, those will be empty
+        };
+
+        const std::size_t        task_count = pair_count * pieces_per_pair;
+        std::vector<std::size_t> left_splits(task_count); // how much of the left run precedes the piece
 
-        R          result = *range.begin;
-        std::mutex result_mutex;
+        this->blocking_loop(IndexRange<std::size_t>{0, task_count, 1}, [&](std::size_t task) {
+            const Piece p = get_piece(task);
+            if (p.low == p.high) return;
 
-        this->blocking_loop(Range<It>{range.begin + 1, range.end}, [&](It low, It high) {
-            R partial_result = *low;
-            for (auto it = low + 1; it != high; ++it) partial_result = op(partial_result, *it);
+            const std::size_t left_size  = p.mid - p.first;
+            const std::size_t right_size = p.last - p.mid;
 
-            const std::scoped_lock result_lock(result_mutex);
-            result = op(result, partial_result);
+            left_splits[task] = merge_path(p.low - p.first, src + p.first, left_size, src + p.mid, right_size, cmp);
         });
 
-        return result;
+        this->blocking_loop(IndexRange<std::size_t>{0, task_count, 1}, [&](std::size_t task) {
+            const Piece p = get_piece(task);
+            if (p.low == p.high) return;
+
+            const std::size_t left_low   = left_splits[task];
+            const std::size_t left_high  = (p.high == p.last) ? p.mid - p.first : left_splits[task + 1];
+            const std::size_t right_low  = p.low - p.first - left_low;
+            const std::size_t right_high = p.high - p.first - left_high;
+
+            const Src left  = src + p.first;
+            const Src right = src + p.mid;
+
+            std::merge(std::make_move_iterator(left + left_low), std::make_move_iterator(left + left_high),
+                       std::make_move_iterator(right + right_low), std::make_move_iterator(right + right_high),
+                       dst + p.low, cmp);
+        });
     }
 
-    template <class It, class Op, class R = typename It::value_type>
-    future_type<R> awaitable_reduce(Range<It> range, Op&& op) {
-        auto submit_reduce = [this, range, op = std::forward<Op>(op)] { return this->blocking_reduce(range, op); };
-        return this->awaitable_task(std::move(submit_reduce));
+    // Returns how many of the first 'd' elements of a stable merge come from the left run,
+    // ties go to the left run, which is consistent with 'std::merge()' & keeps merging stable
+    template <class Src, class Cmp>
+    static std::size_t merge_path(std::size_t d, Src left, std::size_t left_size, Src right, std::size_t right_size,
+                                  Cmp& cmp) {
+        std::size_t low  = (d > right_size) ? d - right_size : 0;
+        std::size_t high = min_size(d, left_size);
+
+        while (low < high) {
+            const std::size_t i = low + (high - low) / 2;
+            if (!cmp(right[d - i - 1], left[i])) low = i + 1; // 'left[i]' precedes 'right[d - i - 1]'
+            else high = i;
+        }
+
+        return low;
     }
 
-    // - 'Container' overloads (2) -
+    // Scan is done in 3 phases over blocks of 'grain_size':
+    //    1. Up-sweep   - blocks get reduced in parallel, last block is skipped since its total affects nothing
+    //    2. Carries    - serial exclusive scan over block totals gives us a carry-in value for every block
+    //    3. Down-sweep - blocks get scanned in parallel, starting from their carry
+    // Empty 'init' means inclusive scan, block carry is empty only for the very first block of an inclusive scan.
+    // Input is always read before the corresponding output is written, which makes in-place scans valid.
+    template <class T, class Value, class OutIt, class Op>
+    OutIt scan(std::size_t size, std::size_t grain_size, Value& value, OutIt out, std::optional<T> init, Op& op) {
+        const bool inclusive = !init.has_value();
+
+        const auto scan_block = [&](std::size_t low, std::size_t high, const std::optional<T>& carry) {
+            if (low == high) return;
+
+            if (inclusive) {
+                T acc = carry ? T(op(*carry, value(low))) : T(value(low));
+                out[low] = acc;
+                for (std::size_t i = low + 1; i < high; ++i) out[i] = acc = op(acc, value(i));
+            } else {
+                T acc = *carry;
+                for (std::size_t i = low; i < high; ++i) {
+                    T next = op(acc, value(i));
+                    out[i] = std::move(acc);
+                    acc    = std::move(next);
+                }
+            }
+        };
+
+        grain_size                    = resolve_grain_size(grain_size, size);
+        const std::size_t block_count = (size + grain_size - 1) / grain_size;
+
+        if (size < min_parallel_scan_size || block_count < 2) {
+            scan_block(0, size, init);
+            return out + size;
+        }
+
+        std::vector<std::optional<T>> carries(block_count);
+
+        this->blocking_loop(IndexRange<std::size_t>{0, block_count - 1, 1}, [&](std::size_t block) {
+            const std::size_t low  = block * grain_size;
+            const std::size_t high = min_size(low + grain_size, size);
+
+            T acc = value(low);
+            for (std::size_t i = low + 1; i < high; ++i) acc = op(acc, value(i));
+
+            carries[block + 1] = std::move(acc); // block total temporarily lives in the slot of the next block
+        });
+
+        carries[0] = std::move(init);
+        for (std::size_t block = 1; block < block_count; ++block)
+            if (carries[block - 1]) carries[block] = op(*carries[block - 1], *carries[block]);
+
+        this->blocking_loop(IndexRange<std::size_t>{0, block_count, 1}, [&](std::size_t block) {
+            const std::size_t low  = block * grain_size;
+            const std::size_t high = min_size(low + grain_size, size);
 
-    template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
-    R blocking_reduce(Container&& container, Op&& op) {
-        return this->blocking_reduce(Range{std::forward<Container>(container)}, std::forward<Op>(op));
-    }
+            scan_block(low, high, carries[block]);
+        });
 
-    template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
-    future_type<R> awaitable_reduce(Container&& container, Op&& op) {
-        return this->awaitable_reduce(Range{std::forward<Container>(container)}, std::forward<Op>(op));
+        return out + size;
     }
 };
 
 #undef utl_parallel_assert_message
+#undef utl_parallel_random_access_message
 
 // =========================
 // --- Binary operations ---
@@ -773,14 +3919,277 @@ template <>
 struct max<void> {
     template <class T1, class T2>
     constexpr auto operator()(T1&& lhs, T2&& rhs) const
-        noexcept(noexcept(std::less<>{}(lhs, rhs) ? std::forward<T1>(rhs) : std::forward<T2>(lhs)))
-            -> decltype(std::less<>{}(lhs, rhs) ? std::forward<T1>(rhs) : std::forward<T2>(lhs)) {
-        return std::less<>{}(lhs, rhs) ? std::forward<T1>(rhs) : std::forward<T2>(lhs);
+        noexcept(noexcept(std::less<>{}(lhs, rhs) ? std::forward<T2>(rhs) : std::forward<T1>(lhs)))
+            -> decltype(std::less<>{}(lhs, rhs) ? std::forward<T2>(rhs) : std::forward<T1>(lhs)) {
+        return std::less<>{}(lhs, rhs) ? std::forward<T2>(rhs) : std::forward<T1>(lhs);
     }
 
     using is_transparent = std::less<>::is_transparent;
 };
 
+// =============================
+// --- Concurrent containers ---
+// =============================
+
+// --- MPMC queue ---
+// ------------------
+
+// Bounded lock-free multi-producer multi-consumer queue, based on the D. Vyukov bounded MPMC queue. Every cell
+// of the ring buffer has a sequence number that tells producers & consumers whether the cell is free for the
+// current lap, claiming a cell is a single CAS on the enqueue / dequeue position, after that the cell is owned
+// exclusively until its sequence number is published. Producers & consumers only contend with their own kind.
+//
+// Cell cannot be given up once claimed, which is why values have to be nothrow-move-constructible.
+
+template <class T>
+class MPMCQueue {
+    static_assert(std::is_nothrow_move_constructible_v<T>, "MPMCQueue requires nothrow-move-constructible values.");
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        [[nodiscard]] T* get() noexcept { return std::launder(reinterpret_cast<T*>(this->storage)); }
+    };
+
+    static constexpr auto relaxed = std::memory_order_relaxed;
+    static constexpr auto acquire = std::memory_order_acquire;
+    static constexpr auto release = std::memory_order_release;
+
+    std::size_t             mask;
+    std::unique_ptr<Cell[]> cells;
+
+    alignas(cache_line_size) std::atomic<std::size_t> enqueue_pos{0};
+    alignas(cache_line_size) std::atomic<std::size_t> dequeue_pos{0};
+
+    static std::size_t round_up_capacity(std::size_t capacity) noexcept {
+        std::size_t rounded = 2; // algorithm needs at least 2 cells to tell a full queue from an empty one
+        while (rounded < capacity) rounded *= 2;
+        return rounded;
+    }
+
+public:
+    explicit MPMCQueue(std::size_t capacity)
+        : mask(round_up_capacity(capacity) - 1), cells(std::make_unique<Cell[]>(this->mask + 1)) {
+        for (std::size_t i = 0; i <= this->mask; ++i) this->cells[i].sequence.store(i, relaxed);
+    }
+
+    MPMCQueue(const MPMCQueue&)            = delete;
+    MPMCQueue(MPMCQueue&&)                 = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(MPMCQueue&&)      = delete;
+
+    ~MPMCQueue() {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+            while (this->try_pop().has_value()) {} // destroys the remaining values
+    }
+
+    // Moves 'value' into the queue, returns 'false' and leaves 'value' untouched if the queue is full
+    [[nodiscard]] bool try_push(T&& value) noexcept {
+        Cell*       cell;
+        std::size_t pos = this->enqueue_pos.load(relaxed);
+
+        while (true) {
+            cell = &this->cells[pos & this->mask];
+
+            const std::size_t    sequence = cell->sequence.load(acquire);
+            const std::ptrdiff_t diff     = static_cast<std::ptrdiff_t>(sequence - pos);
+
+            if (diff == 0) {
+                if (this->enqueue_pos.compare_exchange_weak(pos, pos + 1, relaxed)) break;
+            } else if (diff < 0) {
+                return false; // cell still holds a value from the previous lap => queue is full
+            } else {
+                pos = this->enqueue_pos.load(relaxed); // another producer got ahead of us
+            }
+        }
+
+        ::new (static_cast<void*>(cell->storage)) T(std::move(value));
+        cell->sequence.store(pos + 1, release);
+        return true;
+    }
+
+    [[nodiscard]] bool try_push(const T& value) {
+        T copy = value;
+        return this->try_push(std::move(copy));
+    }
+
+    template <class... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args) {
+        return this->try_push(T(std::forward<Args>(args)...));
+    }
+
+    // Moves the oldest value out of the queue, returns 'std::nullopt' if the queue is empty
+    [[nodiscard]] std::optional<T> try_pop() noexcept {
+        Cell*       cell;
+        std::size_t pos = this->dequeue_pos.load(relaxed);
+
+        while (true) {
+            cell = &this->cells[pos & this->mask];
+
+            const std::size_t    sequence = cell->sequence.load(acquire);
+            const std::ptrdiff_t diff     = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+
+            if (diff == 0) {
+                if (this->dequeue_pos.compare_exchange_weak(pos, pos + 1, relaxed)) break;
+            } else if (diff < 0) {
+                return std::nullopt; // cell hasn't been filled for this lap yet => queue is empty
+            } else {
+                pos = this->dequeue_pos.load(relaxed); // another consumer got ahead of us
+            }
+        }
+
+        std::optional<T> value(std::move(*cell->get()));
+        cell->get()->~T();
+        cell->sequence.store(pos + this->mask + 1, release); // frees the cell for the next lap of producers
+        return value;
+    }
+
+    [[nodiscard]] bool try_pop(T& value) {
+        std::optional<T> popped = this->try_pop();
+        if (popped) value = std::move(*popped);
+        return popped.has_value();
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return this->mask + 1; }
+
+    // Approximate, the value might already be outdated by the time it's returned
+    [[nodiscard]] std::size_t size() const noexcept {
+        const std::size_t enqueued = this->enqueue_pos.load(relaxed);
+        const std::size_t dequeued = this->dequeue_pos.load(relaxed);
+        return (enqueued > dequeued) ? min_size(enqueued - dequeued, this->capacity()) : 0;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return this->size() == 0; }
+};
+
+// --- Sharded map ---
+// -------------------
+
+// Hash map split into independently locked shards, every shard sits in its own cache line so threads working
+// with different shards contend neither on the lock nor on the memory. Shard is selected by a remixed hash,
+// 'std::unordered_map' picks buckets by the same hash & standard hashes of integers are usually an identity,
+// without remixing every shard would end up using only a fraction of its buckets.
+
+template <class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+class ShardedMap {
+    using map_type = std::unordered_map<K, V, Hash, KeyEqual>;
+
+    struct alignas(cache_line_size) Shard {
+        mutable std::mutex mutex;
+        map_type           map;
+    };
+
+    std::size_t              mask;
+    std::unique_ptr<Shard[]> shards;
+    Hash                     hash;
+
+    static std::size_t round_up_shard_count(std::size_t count) noexcept {
+        std::size_t rounded = 1;
+        while (rounded < count) rounded *= 2;
+        return rounded;
+    }
+
+    // Finalizer of the MurmurHash3, spreads every bit of the input across the whole output
+    [[nodiscard]] static constexpr std::uint64_t mix(std::uint64_t h) noexcept {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    [[nodiscard]] Shard& shard_of(const K& key) const {
+        return this->shards[mix(static_cast<std::uint64_t>(this->hash(key))) & this->mask];
+    }
+
+public:
+    explicit ShardedMap(std::size_t shard_count = hardware_concurrency() * 4)
+        : mask(round_up_shard_count(shard_count) - 1), shards(std::make_unique<Shard[]>(this->mask + 1)) {}
+
+    ShardedMap(const ShardedMap&)            = delete;
+    ShardedMap(ShardedMap&&)                 = delete;
+    ShardedMap& operator=(const ShardedMap&) = delete;
+    ShardedMap& operator=(ShardedMap&&)      = delete;
+
+    // Inserts a value constructed from 'args...' unless 'key' is already present, returns whether it was inserted
+    template <class... Args>
+    bool try_emplace(const K& key, Args&&... args) {
+        Shard&                 shard = this->shard_of(key);
+        const std::scoped_lock lock(shard.mutex);
+        return shard.map.try_emplace(key, std::forward<Args>(args)...).second;
+    }
+
+    // Inserts or overwrites the value, returns whether it was inserted
+    bool insert_or_assign(const K& key, V value) {
+        Shard&                 shard = this->shard_of(key);
+        const std::scoped_lock lock(shard.mutex);
+        return shard.map.insert_or_assign(key, std::move(value)).second;
+    }
+
+    // Invokes 'f(value)' under the lock of the shard, value is default-constructed if the key is not present yet
+    template <class F>
+    void update(const K& key, F&& f) {
+        Shard&                 shard = this->shard_of(key);
+        const std::scoped_lock lock(shard.mutex);
+        std::forward<F>(f)(shard.map[key]);
+    }
+
+    // Returns a copy of the value, references can't be returned since the value may be modified concurrently
+    [[nodiscard]] std::optional<V> get(const K& key) const {
+        Shard&                 shard = this->shard_of(key);
+        const std::scoped_lock lock(shard.mutex);
+
+        const auto it = shard.map.find(key);
+        if (it == shard.map.end()) return std::nullopt;
+        return it->second;
+    }
+
+    [[nodiscard]] bool contains(const K& key) const {
+        Shard&                 shard = this->shard_of(key);
+        const std::scoped_lock lock(shard.mutex);
+        return shard.map.find(key) != shard.map.end();
+    }
+
+    bool erase(const K& key) {
+        Shard&                 shard = this->shard_of(key);
+        const std::scoped_lock lock(shard.mutex);
+        return shard.map.erase(key) != 0;
+    }
+
+    // Invokes 'f(key, value)' for every element, shards get locked one at a time,
+    // which means concurrent modifications of other shards can happen during the traversal
+    template <class F>
+    void for_each(F&& f) {
+        for (std::size_t i = 0; i <= this->mask; ++i) {
+            const std::scoped_lock lock(this->shards[i].mutex);
+            for (auto& [key, value] : this->shards[i].map) f(key, value);
+        }
+    }
+
+    // Approximate when there are concurrent modifications, shards get counted one at a time
+    [[nodiscard]] std::size_t size() const {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i <= this->mask; ++i) {
+            const std::scoped_lock lock(this->shards[i].mutex);
+            total += this->shards[i].map.size();
+        }
+        return total;
+    }
+
+    [[nodiscard]] bool empty() const { return this->size() == 0; }
+
+    void clear() {
+        for (std::size_t i = 0; i <= this->mask; ++i) {
+            const std::scoped_lock lock(this->shards[i].mutex);
+            this->shards[i].map.clear();
+        }
+    }
+
+    [[nodiscard]] std::size_t shard_count() const noexcept { return this->mask + 1; }
+};
+
 // =======================
 // --- Global executor ---
 // =======================
@@ -799,10 +4208,23 @@ inline void set_thread_count(std::size_t count = hardware_concurrency()) {
     global_scheduler().backend.set_thread_count(count);
 }
 
+inline void set_thread_count(std::size_t count, Placement placement) {
+    global_scheduler().backend.set_thread_count(count, std::move(placement));
+}
+
 inline std::size_t get_thread_count() { return global_scheduler().backend.get_thread_count(); }
 
 inline void wait() { global_scheduler().backend.wait(); }
 
+inline TaskGroup::TaskGroup() : TaskGroup(global_scheduler().backend) {}
+
+template <class T>
+PerWorker<T>::PerWorker() : PerWorker(global_scheduler().backend) {}
+
+template <class T>
+template <class F, require<std::is_invocable_r_v<T, F&>>>
+PerWorker<T>::PerWorker(F factory) : PerWorker(global_scheduler().backend, std::move(factory)) {}
+
 // --- Scheduler API ---
 // ---------------------
 
@@ -821,6 +4243,44 @@ Future<R> awaitable_task(F&& f, Args&&... args) {
     return global_scheduler().awaitable_task(std::forward<F>(f), std::forward<Args>(args)...);
 }
 
+template <class F, class... Args>
+void detached_task(Priority priority, F&& f, Args&&... args) {
+    global_scheduler().detached_task(priority, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+template <class F, class... Args, class R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+Future<R> awaitable_task(Priority priority, F&& f, Args&&... args) {
+    return global_scheduler().awaitable_task(priority, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+// - Coroutine API -
+
+#ifdef utl_parallel_has_coroutines
+[[nodiscard]] inline auto schedule() noexcept { return global_scheduler().backend.schedule(); }
+
+template <class T>
+Coroutine<T> spawn(Coroutine<T> coroutine) {
+    return global_scheduler().backend.spawn(std::move(coroutine));
+}
+
+template <class... Ts>
+Coroutine<std::tuple<non_void_t<Ts>...>> when_all(Coroutine<Ts>... coroutines) {
+    return global_scheduler().backend.when_all(std::move(coroutines)...);
+}
+
+template <class T>
+Coroutine<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> when_all(std::vector<Coroutine<T>> coroutines) {
+    return global_scheduler().backend.when_all(std::move(coroutines));
+}
+#endif
+
+// - Fork-join API -
+
+template <class F, class... Fs>
+void invoke(F&& f, Fs&&... fs) {
+    global_scheduler().invoke(std::forward<F>(f), std::forward<Fs>(fs)...);
+}
+
 // - Parallel-for API -
 
 template <class It, class F>
@@ -853,6 +4313,36 @@ Future<> awaitable_loop(IndexRange<Idx> range, F&& f) {
     return global_scheduler().awaitable_loop(range, std::forward<F>(f));
 }
 
+template <class Idx, class F>
+void detached_loop(IndexRange2D<Idx> range, F&& f) {
+    global_scheduler().detached_loop(range, std::forward<F>(f));
+}
+
+template <class Idx, class F>
+void blocking_loop(IndexRange2D<Idx> range, F&& f) {
+    global_scheduler().blocking_loop(range, std::forward<F>(f));
+}
+
+template <class Idx, class F>
+Future<> awaitable_loop(IndexRange2D<Idx> range, F&& f) {
+    return global_scheduler().awaitable_loop(range, std::forward<F>(f));
+}
+
+template <class Idx, class F>
+void detached_loop(IndexRange3D<Idx> range, F&& f) {
+    global_scheduler().detached_loop(range, std::forward<F>(f));
+}
+
+template <class Idx, class F>
+void blocking_loop(IndexRange3D<Idx> range, F&& f) {
+    global_scheduler().blocking_loop(range, std::forward<F>(f));
+}
+
+template <class Idx, class F>
+Future<> awaitable_loop(IndexRange3D<Idx> range, F&& f) {
+    return global_scheduler().awaitable_loop(range, std::forward<F>(f));
+}
+
 template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
 void detached_loop(Container&& container, F&& f) {
     global_scheduler().detached_loop(std::forward<Container>(container), std::forward<F>(f));
@@ -868,6 +4358,39 @@ Future<> awaitable_loop(Container&& container, F&& f) {
     return global_scheduler().awaitable_loop(std::forward<Container>(container), std::forward<F>(f));
 }
 
+template <class R, class F, require_no_iter<R> = true>
+void detached_loop(R range, CancellationToken token, F&& f) {
+    global_scheduler().detached_loop(range, std::move(token), std::forward<F>(f));
+}
+
+template <class R, class F, require_no_iter<R> = true>
+void blocking_loop(R range, CancellationToken token, F&& f) {
+    global_scheduler().blocking_loop(range, std::move(token), std::forward<F>(f));
+}
+
+template <class R, class F, require_no_iter<R> = true>
+Future<> awaitable_loop(R range, CancellationToken token, F&& f) {
+    return global_scheduler().awaitable_loop(range, std::move(token), std::forward<F>(f));
+}
+
+template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+void detached_loop(Container&& container, CancellationToken token, F&& f) {
+    global_scheduler().detached_loop(std::forward<Container>(container), std::move(token), std::forward<F>(f));
+}
+
+template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+void blocking_loop(Container&& container, CancellationToken token, F&& f) {
+    global_scheduler().blocking_loop(std::forward<Container>(container), std::move(token), std::forward<F>(f));
+}
+
+template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+Future<> awaitable_loop(Container&& container, CancellationToken token, F&& f) {
+    return global_scheduler().awaitable_loop(std::forward<Container>(container), std::move(token),
+                                             std::forward<F>(f));
+}
+
+// - Parallel-reduce API -
+
 template <class It, class Op, class R = typename It::value_type>
 R blocking_reduce(Range<It> range, Op&& op) {
     return global_scheduler().blocking_reduce(range, std::forward<Op>(op));
@@ -888,8 +4411,221 @@ Future<R> awaitable_reduce(Container&& container, Op&& op) {
     return global_scheduler().awaitable_reduce(std::forward<Container>(container), std::forward<Op>(op));
 }
 
+template <class It, class Op, class R = typename It::value_type>
+R blocking_deterministic_reduce(Range<It> range, Op&& op) {
+    return global_scheduler().blocking_deterministic_reduce(range, std::forward<Op>(op));
+}
+
+template <class It, class Op, class R = typename It::value_type>
+Future<R> awaitable_deterministic_reduce(Range<It> range, Op&& op) {
+    return global_scheduler().awaitable_deterministic_reduce(range, std::forward<Op>(op));
+}
+
+template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
+R blocking_deterministic_reduce(Container&& container, Op&& op) {
+    return global_scheduler().blocking_deterministic_reduce(std::forward<Container>(container), std::forward<Op>(op));
+}
+
+template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
+Future<R> awaitable_deterministic_reduce(Container&& container, Op&& op) {
+    return global_scheduler().awaitable_deterministic_reduce(std::forward<Container>(container), std::forward<Op>(op));
+}
+
+template <class It, class T, class ReduceOp, class TransformOp>
+T blocking_transform_reduce(Range<It> range, T init, ReduceOp&& reduce_op, TransformOp&& transform_op) {
+    return global_scheduler().blocking_transform_reduce(range, std::move(init), std::forward<ReduceOp>(reduce_op),
+                                                        std::forward<TransformOp>(transform_op));
+}
+
+template <class It, class T, class ReduceOp, class TransformOp>
+Future<T> awaitable_transform_reduce(Range<It> range, T init, ReduceOp&& reduce_op, TransformOp&& transform_op) {
+    return global_scheduler().awaitable_transform_reduce(range, std::move(init), std::forward<ReduceOp>(reduce_op),
+                                                         std::forward<TransformOp>(transform_op));
+}
+
+template <class Idx, class T, class ReduceOp, class TransformOp>
+T blocking_transform_reduce(IndexRange<Idx> range, T init, ReduceOp&& reduce_op, TransformOp&& transform_op) {
+    return global_scheduler().blocking_transform_reduce(range, std::move(init), std::forward<ReduceOp>(reduce_op),
+                                                        std::forward<TransformOp>(transform_op));
+}
+
+template <class Idx, class T, class ReduceOp, class TransformOp>
+Future<T> awaitable_transform_reduce(IndexRange<Idx> range, T init, ReduceOp&& reduce_op,
+                                     TransformOp&& transform_op) {
+    return global_scheduler().awaitable_transform_reduce(range, std::move(init), std::forward<ReduceOp>(reduce_op),
+                                                         std::forward<TransformOp>(transform_op));
+}
+
+template <class Container, class T, class ReduceOp, class TransformOp,
+          require_has_some_iter<std::decay_t<Container>> = true>
+T blocking_transform_reduce(Container&& container, T init, ReduceOp&& reduce_op, TransformOp&& transform_op) {
+    return global_scheduler().blocking_transform_reduce(std::forward<Container>(container), std::move(init),
+                                                        std::forward<ReduceOp>(reduce_op),
+                                                        std::forward<TransformOp>(transform_op));
+}
+
+template <class Container, class T, class ReduceOp, class TransformOp,
+          require_has_some_iter<std::decay_t<Container>> = true>
+Future<T> awaitable_transform_reduce(Container&& container, T init, ReduceOp&& reduce_op,
+                                     TransformOp&& transform_op) {
+    return global_scheduler().awaitable_transform_reduce(std::forward<Container>(container), std::move(init),
+                                                         std::forward<ReduceOp>(reduce_op),
+                                                         std::forward<TransformOp>(transform_op));
+}
+
+// - Parallel-scan API -
+
+template <class It, class OutIt, class Op>
+OutIt blocking_inclusive_scan(Range<It> range, OutIt out, Op&& op) {
+    return global_scheduler().blocking_inclusive_scan(range, out, std::forward<Op>(op));
+}
+
+template <class It, class OutIt, class Op>
+Future<OutIt> awaitable_inclusive_scan(Range<It> range, OutIt out, Op&& op) {
+    return global_scheduler().awaitable_inclusive_scan(range, out, std::forward<Op>(op));
+}
+
+template <class It, class OutIt, class T, class Op>
+OutIt blocking_exclusive_scan(Range<It> range, OutIt out, T init, Op&& op) {
+    return global_scheduler().blocking_exclusive_scan(range, out, std::move(init), std::forward<Op>(op));
+}
+
+template <class It, class OutIt, class T, class Op>
+Future<OutIt> awaitable_exclusive_scan(Range<It> range, OutIt out, T init, Op&& op) {
+    return global_scheduler().awaitable_exclusive_scan(range, out, std::move(init), std::forward<Op>(op));
+}
+
+template <class Idx, class OutIt, class Op, class F>
+OutIt blocking_inclusive_scan(IndexRange<Idx> range, OutIt out, Op&& op, F&& f) {
+    return global_scheduler().blocking_inclusive_scan(range, out, std::forward<Op>(op), std::forward<F>(f));
+}
+
+template <class Idx, class OutIt, class Op, class F>
+Future<OutIt> awaitable_inclusive_scan(IndexRange<Idx> range, OutIt out, Op&& op, F&& f) {
+    return global_scheduler().awaitable_inclusive_scan(range, out, std::forward<Op>(op), std::forward<F>(f));
+}
+
+template <class Idx, class OutIt, class T, class Op, class F>
+OutIt blocking_exclusive_scan(IndexRange<Idx> range, OutIt out, T init, Op&& op, F&& f) {
+    return global_scheduler().blocking_exclusive_scan(range, out, std::move(init), std::forward<Op>(op),
+                                                      std::forward<F>(f));
+}
+
+template <class Idx, class OutIt, class T, class Op, class F>
+Future<OutIt> awaitable_exclusive_scan(IndexRange<Idx> range, OutIt out, T init, Op&& op, F&& f) {
+    return global_scheduler().awaitable_exclusive_scan(range, out, std::move(init), std::forward<Op>(op),
+                                                       std::forward<F>(f));
+}
+
+template <class Container, class OutIt, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+OutIt blocking_inclusive_scan(Container&& container, OutIt out, Op&& op) {
+    return global_scheduler().blocking_inclusive_scan(std::forward<Container>(container), out, std::forward<Op>(op));
+}
+
+template <class Container, class OutIt, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+Future<OutIt> awaitable_inclusive_scan(Container&& container, OutIt out, Op&& op) {
+    return global_scheduler().awaitable_inclusive_scan(std::forward<Container>(container), out, std::forward<Op>(op));
+}
+
+template <class Container, class OutIt, class T, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+OutIt blocking_exclusive_scan(Container&& container, OutIt out, T init, Op&& op) {
+    return global_scheduler().blocking_exclusive_scan(std::forward<Container>(container), out, std::move(init),
+                                                      std::forward<Op>(op));
+}
+
+template <class Container, class OutIt, class T, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+Future<OutIt> awaitable_exclusive_scan(Container&& container, OutIt out, T init, Op&& op) {
+    return global_scheduler().awaitable_exclusive_scan(std::forward<Container>(container), out, std::move(init),
+                                                       std::forward<Op>(op));
+}
+
+// - Parallel-sort API -
+
+template <class It, class Cmp = std::less<>>
+void sort(Range<It> range, Cmp&& cmp = Cmp{}) {
+    global_scheduler().sort(range, std::forward<Cmp>(cmp));
+}
+
+template <class It, class Cmp = std::less<>>
+void stable_sort(Range<It> range, Cmp&& cmp = Cmp{}) {
+    global_scheduler().stable_sort(range, std::forward<Cmp>(cmp));
+}
+
+template <class It, class Pred>
+It partition(Range<It> range, Pred&& pred) {
+    return global_scheduler().partition(range, std::forward<Pred>(pred));
+}
+
+template <class Container, class Cmp = std::less<>, require_has_some_iter<std::decay_t<Container>> = true>
+void sort(Container&& container, Cmp&& cmp = Cmp{}) {
+    global_scheduler().sort(std::forward<Container>(container), std::forward<Cmp>(cmp));
+}
+
+template <class Container, class Cmp = std::less<>, require_has_some_iter<std::decay_t<Container>> = true>
+void stable_sort(Container&& container, Cmp&& cmp = Cmp{}) {
+    global_scheduler().stable_sort(std::forward<Container>(container), std::forward<Cmp>(cmp));
+}
+
+template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+auto partition(Container&& container, Pred&& pred) {
+    return global_scheduler().partition(std::forward<Container>(container), std::forward<Pred>(pred));
+}
+
+// - Parallel-search API -
+
+template <class It, class Pred>
+It find_if(Range<It> range, Pred&& pred) {
+    return global_scheduler().find_if(range, std::forward<Pred>(pred));
+}
+
+template <class It, class Pred>
+bool any_of(Range<It> range, Pred&& pred) {
+    return global_scheduler().any_of(range, std::forward<Pred>(pred));
+}
+
+template <class It, class Pred>
+bool all_of(Range<It> range, Pred&& pred) {
+    return global_scheduler().all_of(range, std::forward<Pred>(pred));
+}
+
+template <class It, class Pred>
+bool none_of(Range<It> range, Pred&& pred) {
+    return global_scheduler().none_of(range, std::forward<Pred>(pred));
+}
+
+template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+auto find_if(Container&& container, Pred&& pred) {
+    return global_scheduler().find_if(std::forward<Container>(container), std::forward<Pred>(pred));
+}
+
+template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+bool any_of(Container&& container, Pred&& pred) {
+    return global_scheduler().any_of(std::forward<Container>(container), std::forward<Pred>(pred));
+}
+
+template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+bool all_of(Container&& container, Pred&& pred) {
+    return global_scheduler().all_of(std::forward<Container>(container), std::forward<Pred>(pred));
+}
+
+template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+bool none_of(Container&& container, Pred&& pred) {
+    return global_scheduler().none_of(std::forward<Container>(container), std::forward<Pred>(pred));
+}
+
+// - Pipeline API -
+
+template <class Source, class... Fs>
+void pipeline(std::size_t max_tokens, Source&& source, Stage<Fs>... stages) {
+    global_scheduler().pipeline(max_tokens, std::forward<Source>(source), std::move(stages)...);
+}
+
 } // namespace utl::parallel::impl
 
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
 // ______________________ PUBLIC API ______________________
 
 namespace utl::parallel {
@@ -897,9 +4633,19 @@ namespace utl::parallel {
 using impl::Scheduler;
 using impl::ThreadPool;
 using impl::Future;
+using impl::TaskGroup;
+using impl::PerWorker;
+using impl::Placement;
+using impl::Priority;
+using impl::WorkerStats;
+using impl::PoolStats;
 
 using impl::Range;
 using impl::IndexRange;
+using impl::IndexRange2D;
+using impl::IndexRange3D;
+using impl::TileOrder;
+using impl::auto_grain;
 
 using impl::sum;
 using impl::prod;
@@ -913,12 +4659,49 @@ using impl::wait;
 using impl::detached_task;
 using impl::awaitable_task;
 
+using impl::invoke;
+
+#ifdef utl_parallel_has_coroutines
+using impl::Coroutine;
+using impl::schedule;
+using impl::spawn;
+using impl::when_all;
+#endif
+
 using impl::detached_loop;
 using impl::blocking_loop;
 using impl::awaitable_loop;
 
 using impl::blocking_reduce;
 using impl::awaitable_reduce;
+using impl::blocking_deterministic_reduce;
+using impl::awaitable_deterministic_reduce;
+
+using impl::blocking_transform_reduce;
+using impl::awaitable_transform_reduce;
+
+using impl::blocking_inclusive_scan;
+using impl::awaitable_inclusive_scan;
+using impl::blocking_exclusive_scan;
+using impl::awaitable_exclusive_scan;
+
+using impl::sort;
+using impl::stable_sort;
+using impl::partition;
+
+using impl::CancellationToken;
+using impl::find_if;
+using impl::any_of;
+using impl::all_of;
+using impl::none_of;
+
+using impl::MPMCQueue;
+using impl::ShardedMap;
+
+using impl::StageMode;
+using impl::Stage;
+using impl::stage;
+using impl::pipeline;
 
 namespace this_thread = impl::this_thread;
 
@@ -1310,8 +1310,8 @@ namespace literals = impl::literals;
 #define utl_json_headerguard
 
 #define UTL_JSON_VERSION_MAJOR 1
-#define UTL_JSON_VERSION_MINOR 1
-#define UTL_JSON_VERSION_PATCH 5
+#define UTL_JSON_VERSION_MINOR 2
+#define UTL_JSON_VERSION_PATCH 0
 
 // _______________________ INCLUDES _______________________
 
@@ -1321,14 +1321,18 @@ namespace literals = impl::literals;
 #include <cstdint>          // uint8_t, uint16_t, uint32_t
 #include <filesystem>       // create_directories()
 #include <fstream>          // ifstream, ofstream
+#include <functional>       // less<>
 #include <initializer_list> // initializer_list<>
+#include <istream>          // istream
 #include <limits>           // numeric_limits<>::max_digits10, numeric_limits<>::max_exponent10
 #include <map>              // map<>
-#include <stdexcept>        // runtime_error
+#include <memory>           // unique_ptr<>, make_unique<>(), align(), uninitialized_copy()
+#include <new>              // placement new
+#include <stdexcept>        // runtime_error, invalid_argument
 #include <string>           // string
 #include <string_view>      // string_view
 #include <type_traits>      // enable_if<>, is_convertible<>, is_same<>, conjunction<>, disjunction<>, negation<>, ...
-#include <utility>          // move(), declval<>()
+#include <utility>          // move(), declval<>(), pair<>, exchange()
 #include <variant>          // variant<>
 #include <vector>           // vector<>
 
@@ -1825,14 +1829,14 @@ class Node {
 
     [[nodiscard]] bool contains(std::string_view key) const {
         const auto& object = this->get_object();
-        const auto  it     = object.find(std::string(key));
+        const auto  it     = object.find(key);
         return it != object.end();
     }
 
     template <class T>
     [[nodiscard]] const T& value_or(std::string_view key, const T& else_value) const {
         const auto& object = this->get_object();
-        const auto  it     = object.find(std::string(key));
+        const auto  it     = object.find(key);
         if (it != object.end()) return it->second.get<T>();
         return else_value;
         // same thing as 'this->contains(key) ? json.at(key).get<T>() : else_value' but without a second map lookup
@@ -2042,7 +2046,7 @@ class Node {
     // ------------------
 
     template <class T>
-    [[nodiscard]] T to_struct() const {
+    [[nodiscard]] T to_struct() const& {
         static_assert(
             always_false_v<T>,
             "Provided type doesn't have a defined JSON reflection. Use 'UTL_JSON_REFLECT' macro to define one.");
@@ -2056,6 +2060,16 @@ class Node {
         // macros outside the class body, this is a perfectly legal thing to do, even if unintuitive compared
         // to non-template members, see https://en.cppreference.com/w/cpp/language/member_template
     }
+
+    template <class T>
+    [[nodiscard]] T to_struct() && {
+        static_assert(
+            always_false_v<T>,
+            "Provided type doesn't have a defined JSON reflection. Use 'UTL_JSON_REFLECT' macro to define one.");
+        return {};
+        // same as above, 'std::move(node).to_struct<T>()' moves strings & containers out of the node
+        // instead of copying them, which leaves the node in a valid but unspecified state
+    }
 };
 
 // Public typedefs
@@ -2206,9 +2220,33 @@ struct Parser {
 
     // dynamic allocation errors can be handled with regular exceptions through std::bad_alloc
 
+    std::string string_buffer; // storage for escaped strings that can't be viewed directly in 'chars'
+
     Parser() = delete;
     Parser(const std::string& chars, unsigned int& recursion_limit) : chars(chars), recursion_limit(recursion_limit) {}
 
+    void enter_nested_node() {
+        using namespace std::string_literals;
+
+        if (++this->recursion_depth > this->recursion_limit)
+            throw std::runtime_error("JSON parser has exceeded maximum allowed recursion depth of "s +
+                                     std::to_string(this->recursion_limit) +
+                                     ". If stated depth wasn't caused by an invalid input, "s +
+                                     "recursion limit can be increased in the parser."s);
+    }
+
+    void exit_nested_node() { --this->recursion_depth; }
+
+    [[noreturn]] void throw_missing_separator(std::size_t cursor, char closing) const {
+        using namespace std::string_literals;
+
+        const std::string node_name = (closing == '}') ? "object" : "array";
+
+        throw std::runtime_error("JSON "s + node_name + " node could not find comma {,} or "s + node_name +
+                                 " ending symbol {"s + closing + "} after the element at pos "s +
+                                 std::to_string(cursor) + "."s + pretty_error(cursor, this->chars));
+    }
+
     std::size_t skip_nonsignificant_whitespace(std::size_t cursor) {
         using namespace std::string_literals;
 
@@ -2272,16 +2310,12 @@ struct Parser {
         cursor = this->skip_nonsignificant_whitespace(cursor);
 
         // Parse pair value
-        if (++this->recursion_depth > this->recursion_limit)
-            throw std::runtime_error("JSON parser has exceeded maximum allowed recursion depth of "s +
-                                     std::to_string(this->recursion_limit) +
-                                     ". If stated depth wasn't caused by an invalid input, "s +
-                                     "recursion limit can be increased in the parser."s);
+        this->enter_nested_node();
 
         Node value;
         std::tie(cursor, value) = this->parse_node(cursor);
 
-        --this->recursion_depth;
+        this->exit_nested_node();
 
         // Note 1:
         // The question of whether JSON allows duplicate keys is non-trivial but the resulting answer is YES.
@@ -2362,9 +2396,7 @@ struct Parser {
                 ++cursor; // move past the closing brace '}'
                 return {cursor, std::move(object_value)};
             } else {
-                throw std::runtime_error(
-                    "JSON array node could not find comma {,} or object ending symbol {}} after the element at pos "s +
-                    std::to_string(cursor) + "."s + pretty_error(cursor, this->chars));
+                this->throw_missing_separator(cursor, '}');
             }
         }
 
@@ -2377,17 +2409,13 @@ struct Parser {
 
         // Array element parser assumes it is starting at the first symbol of some JSON node
 
-        // Parse pair key
-        if (++this->recursion_depth > this->recursion_limit)
-            throw std::runtime_error("JSON parser has exceeded maximum allowed recursion depth of "s +
-                                     std::to_string(this->recursion_limit) +
-                                     ". If stated depth wasn't caused by an invalid input, "s +
-                                     "recursion limit can be increased with json::set_recursion_limit()."s);
+        // Parse array element
+        this->enter_nested_node();
 
         Node value;
         std::tie(cursor, value) = this->parse_node(cursor);
 
-        --this->recursion_depth;
+        this->exit_nested_node();
 
         parent.emplace_back(std::move(value));
 
@@ -2425,13 +2453,11 @@ struct Parser {
                 ++cursor; // move past the closing bracket ']'
                 return {cursor, std::move(array_value)};
             } else {
-                throw std::runtime_error(
-                    "JSON array node could not find comma {,} or array ending symbol {]} after the element at pos "s +
-                    std::to_string(cursor) + "."s + pretty_error(cursor, this->chars));
+                this->throw_missing_separator(cursor, ']');
             }
         }
 
-        throw std::runtime_error("JSON array node reached the end of buffer while parsing object contents." +
+        throw std::runtime_error("JSON array node reached the end of buffer while parsing array contents." +
                                  pretty_error(cursor, this->chars));
     }
 
@@ -2686,6 +2712,101 @@ struct Parser {
 
         return {cursor + token_length, Null()};
     }
+
+    // --- Non-allocating parsing ---
+    // ------------------------------
+
+    // Methods below are used by the direct 'string -> struct' parsing (see 'from_string_to()'),
+    // which matches object keys against field names & skips unknown members without building any nodes
+
+    std::pair<std::size_t, std::string_view> parse_string_view(std::size_t cursor) {
+        // Most strings (and almost all object keys) have no escape sequences, such strings can be
+        // viewed directly inside the buffer, otherwise we fall back onto the regular string parsing
+        for (std::size_t i = cursor + 1; i < this->chars.size(); ++i) {
+            const char c = this->chars[i];
+            if (c == '"') return {i + 1, std::string_view(this->chars.data() + cursor + 1, i - cursor - 1)};
+            if (c == '\\' || u8(c) <= 31) break;
+        }
+
+        std::tie(cursor, this->string_buffer) = this->parse_string(cursor);
+        return {cursor, this->string_buffer};
+        // returned view is only valid until the next call, which is fine since all we do with it is a comparison
+    }
+
+    std::pair<std::size_t, std::string_view> parse_object_key(std::size_t cursor) {
+        using namespace std::string_literals;
+
+        // Object key parser assumes it is starting at a significant symbol,
+        // leaves the cursor at the first significant symbol of the value
+
+        if (this->chars[cursor] != '"')
+            throw std::runtime_error("JSON object node encountered unexpected symbol {"s + this->chars[cursor] +
+                                     "} at pos "s + std::to_string(cursor) + " (should be {\"})."s +
+                                     pretty_error(cursor, this->chars));
+
+        std::string_view key;
+        std::tie(cursor, key) = this->parse_string_view(cursor);
+
+        cursor = this->skip_nonsignificant_whitespace(cursor);
+        if (this->chars[cursor] != ':')
+            throw std::runtime_error("JSON object node encountered unexpected symbol {"s + this->chars[cursor] +
+                                     "} after the pair key at pos "s + std::to_string(cursor) + " (should be {:})."s +
+                                     pretty_error(cursor, this->chars));
+        ++cursor; // move past the colon ':'
+        cursor = this->skip_nonsignificant_whitespace(cursor);
+
+        return {cursor, key};
+    }
+
+    // Parses contents of an object / array up to the 'closing' symbol, 'parse_element' is invoked with a cursor
+    // at the first symbol of each element and should return the cursor past its end. Same logic as in
+    // 'parse_object()' / 'parse_array()', but generic over what we actually do with the elements.
+    template <class Func>
+    std::size_t parse_sequence(std::size_t cursor, char closing, Func&& parse_element) {
+        using namespace std::string_literals;
+
+        ++cursor; // move past the opening brace '{' / bracket '['
+
+        cursor = this->skip_nonsignificant_whitespace(cursor);
+        if (this->chars[cursor] == closing) return cursor + 1;
+
+        while (cursor < this->chars.size()) {
+            this->enter_nested_node();
+            cursor = parse_element(cursor);
+            this->exit_nested_node();
+
+            cursor       = this->skip_nonsignificant_whitespace(cursor);
+            const char c = this->chars[cursor];
+
+            if (c == ',') {
+                ++cursor; // move past the comma ','
+                cursor = this->skip_nonsignificant_whitespace(cursor);
+            } else if (c == closing) {
+                return cursor + 1; // move past the closing brace '}' / bracket ']'
+            } else {
+                this->throw_missing_separator(cursor, closing);
+            }
+        }
+
+        throw std::runtime_error("JSON parser reached the end of buffer while parsing object / array contents." +
+                                 pretty_error(cursor, this->chars));
+    }
+
+    std::size_t skip_node(std::size_t cursor) {
+        // Validates the node just like 'parse_node()' would, but doesn't construct it
+        const char c = this->chars[cursor];
+
+        if (c == '{') {
+            const auto skip_pair = [&](std::size_t pos) { return this->skip_node(this->parse_object_key(pos).first); };
+            return this->parse_sequence(cursor, '}', skip_pair);
+        } else if (c == '[') {
+            const auto skip_element = [&](std::size_t pos) { return this->skip_node(pos); };
+            return this->parse_sequence(cursor, ']', skip_element);
+        } else if (c == '"') {
+            return this->parse_string_view(cursor).first;
+        }
+        return this->parse_node(cursor).first; // numbers, bools & nulls don't allocate anyway
+    }
 };
 
 
@@ -2693,6 +2814,58 @@ struct Parser {
 // --- JSON Serializing impl. ---
 // ==============================
 
+inline void serialize_json_string(std::string_view string_value, std::string& chars) {
+    chars += '"';
+
+    // Serialize string while handling escape sequences.
+    /// Without escape sequences we could just do 'chars += string_value'.
+    //
+    // Since appending individual characters is ~twice as slow as appending the whole string, we use a
+    // "buffered" way of appending, appending whole segments up to the currently escaped char.
+    // Strings with no escaped chars get appended in a single call.
+    //
+    std::size_t segment_start = 0;
+    for (std::size_t i = 0; i < string_value.size(); ++i) {
+        if (const char escaped_char_replacement = lookup_serialized_escaped_chars[u8(string_value[i])]) {
+            chars.append(string_value.data() + segment_start, i - segment_start);
+            chars += '\\';
+            chars += escaped_char_replacement;
+            segment_start = i + 1; // skip over the "actual" technical character in the string
+        }
+    }
+    chars.append(string_value.data() + segment_start, string_value.size() - segment_start);
+
+    chars += '"';
+}
+
+inline void serialize_json_number(Number number_value, std::string& chars) {
+    using namespace std::string_literals;
+
+    constexpr int max_exponent = std::numeric_limits<Number>::max_exponent10;
+    constexpr int max_digits   = 4 + std::numeric_limits<Number>::max_digits10 + std::max(2, log10_ceil(max_exponent));
+    // should be the smallest buffer size to account for all possible 'std::to_chars()' outputs,
+    // see [https://stackoverflow.com/questions/68472720/stdto-chars-minimal-floating-point-buffer-size]
+
+    std::array<char, max_digits> buffer;
+
+    const auto [number_end_ptr, error_code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), number_value);
+
+    if (error_code != std::errc{})
+        throw std::runtime_error(
+            "JSON serializing encountered std::to_chars() formatting error while serializing value {"s +
+            std::to_string(number_value) + "}."s);
+
+    // Save NaN/Inf cases as strings, since JSON spec doesn't include IEEE 754.
+    // (!) May result in non-homogenous arrays like [ 1.0, "inf" , 3.0, 4.0, "nan" ]
+    if (std::isfinite(number_value)) {
+        chars.append(buffer.data(), number_end_ptr - buffer.data());
+    } else {
+        chars += '"';
+        chars.append(buffer.data(), number_end_ptr - buffer.data());
+        chars += '"';
+    }
+}
+
 template <bool prettify>
 inline void serialize_json_recursion(const Node& node, std::string& chars, unsigned int indent_level = 0,
                                      bool skip_first_indent = false) {
@@ -2794,61 +2967,11 @@ inline void serialize_json_recursion(const Node& node, std::string& chars, unsig
     }
     // String
     else if (node.is_string()) {
-        const auto& string_value = node.get_string();
-
-        chars += '"';
-
-        // Serialize string while handling escape sequences.
-        /// Without escape sequences we could just do 'chars += string_value'.
-        //
-        // Since appending individual characters is ~twice as slow as appending the whole string, we use a
-        // "buffered" way of appending, appending whole segments up to the currently escaped char.
-        // Strings with no escaped chars get appended in a single call.
-        //
-        std::size_t segment_start = 0;
-        for (std::size_t i = 0; i < string_value.size(); ++i) {
-            if (const char escaped_char_replacement = lookup_serialized_escaped_chars[u8(string_value[i])]) {
-                chars.append(string_value.data() + segment_start, i - segment_start);
-                chars += '\\';
-                chars += escaped_char_replacement;
-                segment_start = i + 1; // skip over the "actual" technical character in the string
-            }
-        }
-        chars.append(string_value.data() + segment_start, string_value.size() - segment_start);
-
-        chars += '"';
+        serialize_json_string(node.get_string(), chars);
     }
     // Number
     else if (node.is_number()) {
-        const auto& number_value = node.get_number();
-
-        constexpr int max_exponent = std::numeric_limits<Number>::max_exponent10;
-        constexpr int max_digits =
-            4 + std::numeric_limits<Number>::max_digits10 + std::max(2, log10_ceil(max_exponent));
-        // should be the smallest buffer size to account for all possible 'std::to_chars()' outputs,
-        // see [https://stackoverflow.com/questions/68472720/stdto-chars-minimal-floating-point-buffer-size]
-
-        std::array<char, max_digits> buffer;
-
-        const auto [number_end_ptr, error_code] =
-            std::to_chars(buffer.data(), buffer.data() + buffer.size(), number_value);
-
-        if (error_code != std::errc{})
-            throw std::runtime_error(
-                "JSON serializing encountered std::to_chars() formatting error while serializing value {"s +
-                std::to_string(number_value) + "}."s);
-
-        const std::string_view number_string(buffer.data(), number_end_ptr - buffer.data());
-
-        // Save NaN/Inf cases as strings, since JSON spec doesn't include IEEE 754.
-        // (!) May result in non-homogenous arrays like [ 1.0, "inf" , 3.0, 4.0, "nan" ]
-        if (std::isfinite(number_value)) {
-            chars.append(buffer.data(), number_end_ptr - buffer.data());
-        } else {
-            chars += '"';
-            chars.append(buffer.data(), number_end_ptr - buffer.data());
-            chars += '"';
-        }
+        serialize_json_number(node.get_number(), chars);
     }
     // Bool
     else if (node.is_bool()) {
@@ -2901,6 +3024,293 @@ namespace literals {
 }
 } // namespace literals
 
+// ===================
+// --- SAX parsing ---
+// ===================
+
+// Event-based parsing, instead of constructing a 'Node' the parser invokes 'Handler' methods for every
+// JSON value it encounters, which allows processing arbitrarily large inputs with constant memory usage.
+// Token-level parsing & error reporting are shared with the regular 'Parser', on top of that we only
+// need to handle the structure & keep a sliding window over the stream so tokens can span chunk borders.
+
+// Base for user-defined handlers, derived classes can "override" only the events they're interested in,
+// handler is a template parameter of the parser so there is no need for virtual dispatch
+struct SaxHandler {
+    void on_object_begin() {}
+    void on_object_end() {}
+    void on_array_begin() {}
+    void on_array_end() {}
+    void on_key(std::string_view) {}
+    void on_string(std::string_view) {}
+    void on_number(Number) {}
+    void on_bool(Bool) {}
+    void on_null() {}
+};
+
+constexpr std::size_t default_sax_chunk_size = 64 * 1024;
+
+template <class Handler>
+struct SaxParser {
+    std::string   buffer; // sliding window over the stream, unused when parsing an in-memory string
+    Parser        parser; // initialized after the 'buffer' since it might reference it
+    Handler&      handler;
+    std::istream* stream     = nullptr;
+    std::size_t   chunk_size = default_sax_chunk_size;
+    std::size_t   cursor     = 0;
+
+    SaxParser() = delete;
+    SaxParser(const std::string& chars, Handler& handler, unsigned int& recursion_limit)
+        : parser(chars, recursion_limit), handler(handler) {}
+    SaxParser(std::istream& stream, Handler& handler, unsigned int& recursion_limit, std::size_t chunk_size)
+        : parser(this->buffer, recursion_limit), handler(handler), stream(&stream), chunk_size(chunk_size) {}
+
+    [[nodiscard]] const std::string& chars() const noexcept { return this->parser.chars; }
+
+    // Discards everything before the cursor & reads the next chunk, returns 'false' once the input is exhausted.
+    // Cursor always points to the start of the token we're currently parsing, so the token will stay whole.
+    bool refill() {
+        if (!this->stream) return false;
+
+        this->buffer.erase(0, this->cursor);
+        this->cursor = 0;
+
+        const std::size_t old_size = this->buffer.size();
+        this->buffer.resize(old_size + this->chunk_size);
+        this->stream->read(this->buffer.data() + old_size, static_cast<std::streamsize>(this->chunk_size));
+        this->buffer.resize(old_size + static_cast<std::size_t>(this->stream->gcount()));
+
+        return this->buffer.size() > old_size;
+    }
+
+    // Makes sure that 'count' chars past the cursor are buffered, unless the input ends first
+    void ensure_available(std::size_t count) {
+        if (!this->stream) return; // in-memory input is always fully available
+
+        while (this->cursor + count > this->chars().size())
+            if (!this->refill()) return;
+    }
+
+    // Returns 'false' if the input ends before a significant symbol
+    bool try_skip_nonsignificant_whitespace() {
+        while (true) {
+            while (this->cursor < this->chars().size() && lookup_whitespace_chars[u8(this->chars()[this->cursor])])
+                ++this->cursor;
+            if (this->cursor < this->chars().size()) return true;
+            if (!this->refill()) return false;
+        }
+    }
+
+    void skip_nonsignificant_whitespace() {
+        if (!this->try_skip_nonsignificant_whitespace()) this->parser.skip_nonsignificant_whitespace(this->cursor);
+        // regular parser will throw a proper "end of buffer" error
+    }
+
+    // Buffers the whole string token starting at the cursor, the string itself gets validated later.
+    // Offsets are relative to the cursor, since refills shift the buffer.
+    void buffer_string() {
+        if (!this->stream) return; // in-memory input is always fully available
+
+        for (std::size_t offset = 1;; ++offset) {
+            while (this->cursor + offset >= this->chars().size())
+                if (!this->refill()) return;
+
+            const char c = this->chars()[this->cursor + offset];
+            if (c == '\\') ++offset; // skip escaped char, this also covers '\"'
+            else if (c == '"') return;
+        }
+    }
+
+    // Buffers the whole number token starting at the cursor, the number itself gets validated later.
+    // We buffer up to the next delimiter rather than just the numeric chars, since 'from_chars()' also
+    // accepts things like 'nan' & 'inf' and we want to have the exact same behavior as the regular parser.
+    void buffer_number() {
+        if (!this->stream) return; // in-memory input is always fully available
+
+        const auto is_delimiter = [](char c) {
+            return lookup_whitespace_chars[u8(c)] || c == ',' || c == ']' || c == '}';
+        };
+
+        for (std::size_t offset = 0;; ++offset) {
+            while (this->cursor + offset >= this->chars().size())
+                if (!this->refill()) return;
+
+            if (is_delimiter(this->chars()[this->cursor + offset])) return;
+        }
+    }
+
+    void parse_node() {
+        const char c = this->chars()[this->cursor];
+
+        if (c == '{') {
+            this->parse_object();
+        } else if (c == '[') {
+            this->parse_array();
+        } else if (c == '"') {
+            this->buffer_string();
+            const auto [end_cursor, string_value] = this->parser.parse_string_view(this->cursor);
+            this->handler.on_string(string_value);
+            this->cursor = end_cursor;
+        } else if (('0' <= c && c <= '9') || (c == '-')) {
+            this->buffer_number();
+            const auto [end_cursor, number_value] = this->parser.parse_number(this->cursor);
+            this->handler.on_number(number_value);
+            this->cursor = end_cursor;
+        } else if (c == 't') {
+            this->ensure_available(4);
+            const auto [end_cursor, bool_value] = this->parser.parse_true(this->cursor);
+            this->handler.on_bool(bool_value);
+            this->cursor = end_cursor;
+        } else if (c == 'f') {
+            this->ensure_available(5);
+            const auto [end_cursor, bool_value] = this->parser.parse_false(this->cursor);
+            this->handler.on_bool(bool_value);
+            this->cursor = end_cursor;
+        } else if (c == 'n') {
+            this->ensure_available(4);
+            this->cursor = this->parser.parse_null(this->cursor).first;
+            this->handler.on_null();
+        } else {
+            this->parser.parse_node(this->cursor); // regular parser will throw a proper "unexpected symbol" error
+        }
+    }
+
+    void parse_object() {
+        using namespace std::string_literals;
+
+        this->handler.on_object_begin();
+        ++this->cursor; // move past the opening brace '{'
+
+        this->skip_nonsignificant_whitespace();
+        if (this->chars()[this->cursor] == '}') {
+            ++this->cursor; // move past the closing brace '}'
+            this->handler.on_object_end();
+            return;
+        }
+
+        while (true) {
+            // Parse pair key
+            if (this->chars()[this->cursor] != '"')
+                throw std::runtime_error("JSON object node encountered unexpected symbol {"s +
+                                         this->chars()[this->cursor] + "} at pos "s + std::to_string(this->cursor) +
+                                         " (should be {\"})."s + pretty_error(this->cursor, this->chars()));
+
+            this->buffer_string();
+            const auto [key_end_cursor, key] = this->parser.parse_string_view(this->cursor);
+            this->handler.on_key(key);
+            this->cursor = key_end_cursor;
+
+            // Handle stuff in-between
+            this->skip_nonsignificant_whitespace();
+            if (this->chars()[this->cursor] != ':')
+                throw std::runtime_error("JSON object node encountered unexpected symbol {"s +
+                                         this->chars()[this->cursor] + "} after the pair key at pos "s +
+                                         std::to_string(this->cursor) + " (should be {:})."s +
+                                         pretty_error(this->cursor, this->chars()));
+            ++this->cursor; // move past the colon ':'
+            this->skip_nonsignificant_whitespace();
+
+            // Parse pair value
+            this->parser.enter_nested_node();
+            this->parse_node();
+            this->parser.exit_nested_node();
+
+            // Handle comma / object end
+            this->skip_nonsignificant_whitespace();
+            const char c = this->chars()[this->cursor];
+
+            if (c == ',') {
+                ++this->cursor; // move past the comma ','
+                this->skip_nonsignificant_whitespace();
+            } else if (c == '}') {
+                ++this->cursor; // move past the closing brace '}'
+                this->handler.on_object_end();
+                return;
+            } else {
+                this->parser.throw_missing_separator(this->cursor, '}');
+            }
+        }
+    }
+
+    void parse_array() {
+        using namespace std::string_literals;
+
+        this->handler.on_array_begin();
+        ++this->cursor; // move past the opening bracket '['
+
+        this->skip_nonsignificant_whitespace();
+        if (this->chars()[this->cursor] == ']') {
+            ++this->cursor; // move past the closing bracket ']'
+            this->handler.on_array_end();
+            return;
+        }
+
+        while (true) {
+            // Parse element
+            this->parser.enter_nested_node();
+            this->parse_node();
+            this->parser.exit_nested_node();
+
+            // Handle comma / array end
+            this->skip_nonsignificant_whitespace();
+            const char c = this->chars()[this->cursor];
+
+            if (c == ',') {
+                ++this->cursor; // move past the comma ','
+                this->skip_nonsignificant_whitespace();
+            } else if (c == ']') {
+                ++this->cursor; // move past the closing bracket ']'
+                this->handler.on_array_end();
+                return;
+            } else {
+                this->parser.throw_missing_separator(this->cursor, ']');
+            }
+        }
+    }
+
+    void parse() {
+        using namespace std::string_literals;
+
+        this->skip_nonsignificant_whitespace(); // skip leading whitespace
+        this->parse_node();                     // starts parsing recursively from the root node
+
+        // Check for invalid trailing symbols
+        if (this->try_skip_nonsignificant_whitespace())
+            throw std::runtime_error("Invalid trailing symbols encountered after the root JSON node at pos "s +
+                                     std::to_string(this->cursor) + "."s + pretty_error(this->cursor, this->chars()));
+    }
+};
+
+// Note:
+// When parsing a stream, error positions are counted from the start of the currently buffered window,
+// the context printed by 'pretty_error()' is still accurate
+
+template <class Handler>
+void sax_from_string(const std::string& chars, Handler& handler,
+                     unsigned int recursion_limit = default_recursion_limit) {
+    SaxParser<Handler>(chars, handler, recursion_limit).parse();
+}
+
+template <class Handler>
+void sax_from_stream(std::istream& stream, Handler& handler,
+                     unsigned int recursion_limit = default_recursion_limit,
+                     std::size_t  chunk_size      = default_sax_chunk_size) {
+    if (chunk_size == 0) throw std::invalid_argument("JSON SAX parser requires a non-zero chunk size.");
+
+    SaxParser<Handler>(stream, handler, recursion_limit, chunk_size).parse();
+}
+
+template <class Handler>
+void sax_from_file(const std::string& filepath, Handler& handler,
+                   unsigned int recursion_limit = default_recursion_limit,
+                   std::size_t  chunk_size      = default_sax_chunk_size) {
+    using namespace std::string_literals;
+
+    std::ifstream file(filepath, std::ios::binary);
+    if (!file.good()) throw std::runtime_error("Could not open file {"s + filepath + "."s);
+
+    sax_from_stream(file, handler, recursion_limit, chunk_size);
+}
+
 // ============================
 // --- Structure reflection ---
 // ============================
@@ -2954,2030 +3364,2784 @@ void assign_value_to_node(Node& node, const T& value) {
 // --- to-struct utils ---
 // -----------------------
 
+// Member lookup for the 'to_struct()' codegen, returns 'nullptr' for missing keys so
+// we can check for presence and access the member with a single map lookup
+[[nodiscard]] inline const Node* find_member(const Node& node, std::string_view key) {
+    const auto& object = node.get_object();
+    const auto  it     = object.find(key);
+    return it != object.end() ? &it->second : nullptr;
+}
+
+[[nodiscard]] inline Node* find_member(Node& node, std::string_view key) {
+    auto&      object = node.get_object();
+    const auto it     = object.find(key);
+    return it != object.end() ? &it->second : nullptr;
+}
+
+// Forwards a part of the node with the value category of the node itself,
+// similar to C++23 'std::forward_like()', but we only need it for nodes
+template <class N, class T>
+[[nodiscard]] constexpr decltype(auto) forward_like_node(T& value) noexcept {
+    if constexpr (std::is_same_v<N, Node>) return std::move(value);
+    else return static_cast<const T&>(value);
+}
+
+template <class N>
+using enable_if_node_t = std::enable_if_t<std::is_same_v<std::decay_t<N>, Node>, bool>;
+
 // Assigning JSON node to a value for arbitrary type is a bit of an "incorrect" problem,
 // since we can't possibly know the API of the type we're assigning stuff to.
 // Object-like and array-like types need special handling that expands their nodes recursively,
 // we can't directly assign 'std::vector<Node>' to 'std::vector<double>' like we would with simpler types.
-template <class T>
-void assign_node_to_value_recursively(T& value, const Node& node) {
-    if constexpr (is_string_like_v<T>) value = node.get_string();
+//
+// Node is taken by a forwarding reference, nested objects & arrays are traversed in-place rather than
+// copied, when the node is an rvalue its strings get moved into the value instead of being copied.
+template <class T, class N, enable_if_node_t<N> = true>
+void assign_node_to_value_recursively(T& value, N&& node) {
+    if constexpr (is_string_like_v<T>) value = forward_like_node<N>(node.get_string());
     else if constexpr (is_object_like_v<T>) {
-        const auto object = node.get_object();
-        for (const auto& [key, val] : object) assign_node_to_value_recursively(value[key], val);
+        auto& object = node.get_object();
+        for (auto& [key, val] : object) assign_node_to_value_recursively(value[key], forward_like_node<N>(val));
     } else if constexpr (is_array_like_v<T>) {
-        const auto array = node.get_array();
+        auto& array = node.get_array();
         value.resize(array.size());
-        for (std::size_t i = 0; i < array.size(); ++i) assign_node_to_value_recursively(value[i], array[i]);
+        for (std::size_t i = 0; i < array.size(); ++i)
+            assign_node_to_value_recursively(value[i], forward_like_node<N>(array[i]));
     } else if constexpr (is_bool_like_v<T>) value = node.get_bool();
     else if constexpr (is_null_like_v<T>) value = node.get_null();
     else if constexpr (is_numeric_like_v<T>) value = static_cast<T>(node.get_number());
-    else if constexpr (is_reflected_struct<T>) value = node.to_struct<T>();
+    else if constexpr (is_reflected_struct<T>) value = std::forward<N>(node).template to_struct<T>();
     else static_assert(always_false_v<T>, "Method is a non-exhaustive visitor of std::variant<>.");
 }
 
 // Not sure how to generically handle array-like types with compile-time known size,
 // so we're just going to make a special case for 'std::array'
-template <class T, std::size_t N>
-void assign_node_to_value_recursively(std::array<T, N>& value, const Node& node) {
+template <class T, std::size_t size, class N, enable_if_node_t<N> = true>
+void assign_node_to_value_recursively(std::array<T, size>& value, N&& node) {
     using namespace std::string_literals;
 
-    const auto array = node.get_array();
+    auto& array = node.get_array();
 
     if (array.size() != value.size())
         throw std::runtime_error("JSON to structure serializer encountered non-mathing std::array size of "s +
                                  std::to_string(value.size()) + ", corresponding node has a size of "s +
                                  std::to_string(array.size()) + "."s);
 
-    for (std::size_t i = 0; i < array.size(); ++i) assign_node_to_value_recursively(value[i], array[i]);
+    for (std::size_t i = 0; i < array.size(); ++i)
+        assign_node_to_value_recursively(value[i], forward_like_node<N>(array[i]));
 }
 
 #define utl_json_to_struct_assign(fieldname_)                                                                          \
-    if (this->contains(#fieldname_)) assign_node_to_value_recursively(val.fieldname_, this->at(#fieldname_));
+    if (const auto* member = find_member(*this, #fieldname_)) assign_node_to_value_recursively(val.fieldname_, *member);
 // JSON might not have an entry corresponding to each structure member,
 // such members will stay defaulted according to the struct constructor
 
-// --- Codegen ---
-// ---------------
+#define utl_json_to_struct_move_assign(fieldname_)                                                                     \
+    if (auto* member = find_member(*this, #fieldname_))                                                                \
+        assign_node_to_value_recursively(val.fieldname_, std::move(*member));
+// same thing, but steals the member from an rvalue node
 
-#define UTL_JSON_REFLECT(struct_name_, ...)                                                                            \
-                                                                                                                       \
-    template <>                                                                                                        \
-    constexpr bool utl::json::impl::is_reflected_struct<struct_name_> = true;                                          \
-                                                                                                                       \
-    template <>                                                                                                        \
-    inline utl::json::impl::Node utl::json::impl::from_struct<struct_name_>(const struct_name_& val) {                 \
-        utl::json::impl::Node json;                                                                                    \
-        /* map 'json["<FIELDNAME>"] = val.<FIELDNAME>;' */                                                             \
-        utl_json_map(utl_json_from_struct_assign, __VA_ARGS__);                                                        \
-        return json;                                                                                                   \
-    }                                                                                                                  \
-                                                                                                                       \
-    template <>                                                                                                        \
-    inline auto utl::json::impl::Node::to_struct<struct_name_>() const -> struct_name_ {                               \
-        struct_name_ val;                                                                                              \
-        /* map 'val.<FIELDNAME> = this->at("<FIELDNAME>").get<decltype(val.<FIELDNAME>)>();' */                        \
-        utl_json_map(utl_json_to_struct_assign, __VA_ARGS__);                                                          \
-        return val;                                                                                                    \
-    }                                                                                                                  \
-                                                                                                                       \
-    static_assert(true)
+// --- parse-to-struct utils ---
+// -----------------------------
 
+// Parsing text straight into the reflected structs, it follows the same conversion rules as
+// 'to_struct()', but skips the intermediate 'Node' tree entirely, strings / containers get constructed
+// directly in the struct fields and object keys are matched against field names as string views.
+// In case of duplicate keys the first occurrence wins, same as with 'from_string()'.
 
-} // namespace utl::json::impl
+template <class T>
+std::size_t parse_reflected_struct(Parser&, std::size_t cursor, T&) {
+    static_assert(always_false_v<T>,
+                  "Provided type doesn't have a defined JSON reflection. Use 'UTL_JSON_REFLECT' macro to define one.");
+    return cursor;
+    // specializations are defined by 'UTL_JSON_REFLECT', for every key they select the matching field and parse
+    // the value into it, unknown keys get skipped so the struct can be a subset of the JSON schema
+}
 
-// ______________________ PUBLIC API ______________________
+inline void expect_symbol(const Parser& parser, std::size_t cursor, bool condition, std::string_view expected) {
+    using namespace std::string_literals;
 
-namespace utl::json {
+    if (!condition)
+        throw std::runtime_error("JSON to structure parser encountered unexpected symbol {"s + parser.chars[cursor] +
+                                 "} at pos "s + std::to_string(cursor) + " (should be the start of "s +
+                                 std::string(expected) + ")."s + pretty_error(cursor, parser.chars));
+}
 
-using impl::Format;
+template <class T>
+std::size_t parse_to_value_recursively(Parser& parser, std::size_t cursor, T& value) {
+    const char c = parser.chars[cursor];
+
+    if constexpr (is_string_like_v<T>) {
+        expect_symbol(parser, cursor, c == '"', "a string");
+        std::tie(cursor, value) = parser.parse_string(cursor);
+    } else if constexpr (is_object_like_v<T>) {
+        expect_symbol(parser, cursor, c == '{', "an object");
+        value.clear();
+        return parser.parse_sequence(cursor, '}', [&](std::size_t pos) {
+            std::string_view key;
+            std::tie(pos, key) = parser.parse_object_key(pos);
+
+            std::string key_string(key);
+            if (value.find(key_string) != value.end()) return parser.skip_node(pos); // duplicate key
+            return parse_to_value_recursively(parser, pos, value[std::move(key_string)]);
+        });
+    } else if constexpr (is_array_like_v<T>) {
+        expect_symbol(parser, cursor, c == '[', "an array");
+        value.clear();
+        return parser.parse_sequence(cursor, ']', [&](std::size_t pos) {
+            value.resize(value.size() + 1);
+            return parse_to_value_recursively(parser, pos, value.back());
+        });
+    } else if constexpr (is_bool_like_v<T>) {
+        expect_symbol(parser, cursor, c == 't' || c == 'f', "a bool");
+        std::tie(cursor, value) = (c == 't') ? parser.parse_true(cursor) : parser.parse_false(cursor);
+    } else if constexpr (is_null_like_v<T>) {
+        expect_symbol(parser, cursor, c == 'n', "a null");
+        std::tie(cursor, value) = parser.parse_null(cursor);
+    } else if constexpr (is_numeric_like_v<T>) {
+        expect_symbol(parser, cursor, ('0' <= c && c <= '9') || (c == '-'), "a number");
+        Number number_value;
+        std::tie(cursor, number_value) = parser.parse_number(cursor);
+        value                          = static_cast<T>(number_value);
+    } else if constexpr (is_reflected_struct<T>) {
+        expect_symbol(parser, cursor, c == '{', "an object");
+        return parse_reflected_struct(parser, cursor, value);
+    } else static_assert(always_false_v<T>, "Method is a non-exhaustive visitor of std::variant<>.");
 
-using impl::Node;
+    return cursor;
+}
 
-using impl::Object;
-using impl::Array;
-using impl::String;
-using impl::Number;
-using impl::Bool;
-using impl::Null;
+// Special case for 'std::array', same as with 'to_struct()'
+template <class T, std::size_t size>
+std::size_t parse_to_value_recursively(Parser& parser, std::size_t cursor, std::array<T, size>& value) {
+    using namespace std::string_literals;
 
-using impl::from_string;
-using impl::from_file;
-using impl::from_struct;
+    expect_symbol(parser, cursor, parser.chars[cursor] == '[', "an array");
 
-namespace literals = impl::literals;
+    std::size_t count = 0;
+    cursor            = parser.parse_sequence(cursor, ']', [&](std::size_t pos) {
+        const std::size_t i = count++;
+        return (i < size) ? parse_to_value_recursively(parser, pos, value[i]) : parser.skip_node(pos);
+    });
 
-// macro -> UTL_JSON_REFLECT
+    if (count != size)
+        throw std::runtime_error("JSON to structure parser encountered non-mathing std::array size of "s +
+                                 std::to_string(size) + ", corresponding node has a size of "s +
+                                 std::to_string(count) + "."s);
 
-using impl::is_reflected_struct;
+    return cursor;
+}
 
-} // namespace utl::json
+// Duplicate keys of a field get skipped, so the first occurrence wins
+template <class T>
+std::size_t parse_struct_field_once(Parser& parser, std::size_t cursor, T& field, bool& is_assigned) {
+    if (std::exchange(is_assigned, true)) return parser.skip_node(cursor);
+    return parse_to_value_recursively(parser, cursor, field);
+}
 
-#endif
-#endif // module utl::json
+#define utl_json_count_struct_field(fieldname_) ++count;
 
+#define utl_json_parse_struct_field(fieldname_)                                                                        \
+    if (key == #fieldname_) return parse_struct_field_once(parser, pos, val.fieldname_, is_assigned[field_index]);    \
+    ++field_index;
+// keys that don't match any field get skipped,
+// fields that don't have a corresponding key stay defaulted according to the struct constructor
 
+template <class T>
+[[nodiscard]] T from_string_to(const std::string& chars, unsigned int recursion_limit = default_recursion_limit) {
+    T value{};
 
+    Parser            parser(chars, recursion_limit);
+    const std::size_t json_start = parser.skip_nonsignificant_whitespace(0); // skip leading whitespace
+    const std::size_t end_cursor = parse_to_value_recursively(parser, json_start, value);
 
+    // Check for invalid trailing symbols
+    using namespace std::string_literals;
 
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//
-// Module:        utl::log
-// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_log.md
-// Source repo:   https://github.com/DmitriBogdanov/UTL
-//
-// This project is licensed under the MIT License
-//
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    for (auto cursor = end_cursor; cursor < chars.size(); ++cursor)
+        if (!lookup_whitespace_chars[u8(chars[cursor])])
+            throw std::runtime_error("Invalid trailing symbols encountered after the root JSON node at pos "s +
+                                     std::to_string(cursor) + "."s + pretty_error(cursor, chars));
 
-#if !defined(UTL_PICK_MODULES) || defined(UTL_MODULE_LOG)
+    return value;
+}
 
-#ifndef utl_log_headerguard
-#define utl_log_headerguard
+template <class T>
+[[nodiscard]] T from_file_to(const std::string& filepath, unsigned int recursion_limit = default_recursion_limit) {
+    const std::string chars = read_file_to_string(filepath);
+    return from_string_to<T>(chars, recursion_limit);
+}
 
-#define UTL_LOG_VERSION_MAJOR 2
-#define UTL_LOG_VERSION_MINOR 3
-#define UTL_LOG_VERSION_PATCH 3
+// --- struct-to-string utils ---
+// ------------------------------
 
-// _______________________ INCLUDES _______________________
+// Serializing reflected structs straight into the buffer, formatting is the same as with
+// 'serialize_json_recursion()', but there is no intermediate 'Node' and struct fields are
+// written in their declaration order (rather than being sorted like the keys of 'Node::object_type')
 
-#include <array>              // array<>, size_t
-#include <atomic>             // atomic<>
-#include <cassert>            // assert()
-#include <charconv>           // to_chars()
-#include <chrono>             // steady_clock
-#include <condition_variable> // condition_variable
-#include <fstream>            // ofstream, ostream
-#include <functional>         // function<>, ref()
-#include <iostream>           // cout
-#include <iterator>           // ostreambuf_iterator<>
-#include <memory>             // unique_ptr<>, make_unique<>()
-#include <mutex>              // mutex<>, scoped_lock<>
-#include <queue>              // queue<>
-#include <sstream>            // ostringstream
-#include <string>             // string
-#include <string_view>        // string_view
-#include <thread>             // thread
-#include <tuple>              // tuple<>, get<>, tuple_size_v<>, apply()
-#include <type_traits>        // enable_if_t<>, is_enum_v<>, is_integral_v<>, is_unsigned_v<>, underlying_type_t<>, ...
-#include <utility>            // forward<>(), integer_sequence<>, make_index_sequence<>
+template <class T>
+void serialize_reflected_struct(const T&, std::string&, unsigned int, bool) {
+    static_assert(always_false_v<T>,
+                  "Provided type doesn't have a defined JSON reflection. Use 'UTL_JSON_REFLECT' macro to define one.");
+    // specializations are defined by 'UTL_JSON_REFLECT', they serialize struct fields as object pairs,
+    // 'prettify' is passed at runtime since explicit specializations can't be templated over it
+}
 
-// ____________________ DEVELOPER DOCS ____________________
+// Same container layout as in 'serialize_json_recursion()', see the notes there
+template <bool prettify, class Container, class Func>
+void serialize_sequence(const Container& container, std::string& chars, std::size_t indent_size, char opening,
+                        char closing, Func&& serialize_element) {
+    // Skip all logic for empty containers
+    if (container.begin() == container.end()) {
+        chars += opening;
+        chars += closing;
+        return;
+    }
 
-// A somewhat overengineered logger that uses a lot of compile-time magic and internal macro codegen
-// to generate a concise macro-free API that provides features usually associated with macros.
-//
-// We also want simple customizability on user side while squeezing out as much formatting
-// performance as we reasonably can using compile-time logic. Combined with the inherent
-// weirdness of variadic formatting this at times leads to some truly horrific constructs.
-//
-// All things considered, format strings are a much simpler solution from the implementation perspective,
-// however properly using them isn't possible without bringing in fmtlib as a dependency. In theory,
-// if we wanted to to push for truly top-notch performance the plan would be as follows:
-//    1. Bring in fmtlib as a dependency and use format strings as a syntax of choice
-//    2. Bring in llfio / glaze or another low latency IO library as a dependency
-//    3. Implement async formatting & IO backend:
-//    |  A. Loging threads push entries into a MPSC lock-free queue
-//    |  B. Serialized types are limited to a specific set which can be encoded
-//    |  C. Each queue entry consists of a:
-//    |  |  a. Timestamp
-//    |  |  b. Pointer to a constexpr metadata struct that contains callsite,
-//    |  |     format string and a pointer to a generated template decoder function
-//    |  |  c. Binary copy encoding the arguments
-//    |  D. Backend thread pops entries from the queue and puts them into an unbounded transit buffer
-//    |     ordered by the entry timestamp, this buffer gets periodically flushed, this is necessary
-//    |     to sort multi-threaded logs by time without introducing syncronization on the logging
-//    |     threads, perfect ordering is not theoretically guaranteed it is good enough in practice
-//    |  E. When flushing, backend thread performs:
-//    |  |  a. Decoding using the received function pointer
-//    |  |  b. Formatting using fmtlib
-//    |  |  c. Buffered IO using the manual buffer and the underlying IO library
-//    4. Use macro API to generate & format callsite and other metadata at compile-time,
-//       doing the same with functions is non-feasible / extremely difficult due to the
-//       design of 'std::source_location' which prevent proper compile-time evaluation
-//    5. Use a custom <chrono> clock based on RDTSC timestamps for lower overhead
-// this, however, would require a project of a whole different scale and integration complexity.
+    chars += opening;
+    if constexpr (prettify) chars += '\n';
 
-// ____________________ IMPLEMENTATION ____________________
+    for (auto it = container.begin();;) {
+        serialize_element(*it);
+        if (++it != container.end()) { // prevents trailing comma
+            chars += ',';
+            if constexpr (prettify) chars += '\n';
+        } else {
+            if constexpr (prettify) chars += '\n';
+            break;
+        }
+    }
 
-// ===============================================
-// --- Optional 'std::source_location' support ---
-// ===============================================
+    if constexpr (prettify) chars.append(indent_size, ' ');
+    chars += closing;
+}
 
-// clang-format off
+template <bool prettify, class T>
+void serialize_value_recursively(const T& value, std::string& chars, unsigned int indent_level = 0,
+                                 bool skip_first_indent = false) {
+    constexpr std::size_t indent_level_size = 4;
+    const std::size_t     indent_size       = indent_level_size * indent_level;
 
-// Detect if we have C++20 or above
+    if constexpr (prettify)
+        if (!skip_first_indent) chars.append(indent_size, ' ');
 
-#ifdef _MSC_VER
-    #define utl_log_cpp_standard _MSVC_LANG
-#else
-    #define utl_log_cpp_standard __cplusplus
-#endif
+    if constexpr (is_string_like_v<T>) serialize_json_string(value, chars);
+    else if constexpr (is_object_like_v<T>) {
+        serialize_sequence<prettify>(value, chars, indent_size, '{', '}', [&](const auto& pair) {
+            if constexpr (prettify) chars.append(indent_size + indent_level_size, ' ');
+            serialize_json_string(pair.first, chars);
+            if constexpr (prettify) chars += ": ";
+            else chars += ':';
+            serialize_value_recursively<prettify>(pair.second, chars, indent_level + 1, true);
+        });
+    } else if constexpr (is_array_like_v<T>) {
+        serialize_sequence<prettify>(value, chars, indent_size, '[', ']', [&](const auto& elem) {
+            serialize_value_recursively<prettify>(elem, chars, indent_level + 1);
+        });
+    } else if constexpr (is_bool_like_v<T>) chars += (value ? "true" : "false");
+    else if constexpr (is_null_like_v<T>) chars += "null";
+    else if constexpr (is_numeric_like_v<T>) serialize_json_number(static_cast<Number>(value), chars);
+    else if constexpr (is_reflected_struct<T>) {
+        chars += '{';
+        if constexpr (prettify) chars += '\n';
+        serialize_reflected_struct(value, chars, indent_level, prettify);
+        if constexpr (prettify) {
+            chars += '\n';
+            chars.append(indent_size, ' ');
+        }
+        chars += '}';
+    } else static_assert(always_false_v<T>, "Could not resolve recursive conversion from 'T' to JSON string.");
+}
 
-// For C++20 and above use typedef for 'std::source_location'
+template <class T>
+void serialize_struct_field(std::string_view key, const T& value, std::string& chars, unsigned int indent_level,
+                            bool prettify, bool is_first_field) {
+    constexpr std::size_t indent_level_size = 4;
 
-#if utl_log_cpp_standard >= 202002L
-    #include <source_location>
-    namespace utl::log::impl {
-        using SourceLocation = std::source_location;
+    if (!is_first_field) {
+        chars += ',';
+        if (prettify) chars += '\n';
     }
-    #define utl_log_has_source_location
-#endif
 
-// Below C++20 detect compiler version and intrinsics that allow its emulation.
-// Emulation works similarly for all 3 major compilers and is quite simple to implement.
-// It provides the entire standard API except '.column()' which is not supported by GCC.
+    if (prettify) chars.append(indent_level_size * (indent_level + 1), ' ');
+    chars += '"';
+    chars += key;
+    chars += (prettify ? "\": " : "\":");
 
-// MSVC: requires at least VS 2019 16.6 Preview 2
-#ifndef utl_log_has_source_location
-    #ifdef _MSC_VER
-        #if _MSC_VER >= 1927
-            #define utl_log_use_source_location_builtin
-            #define utl_log_has_source_location
-        #endif
-    #endif
-#endif
+    if (prettify) serialize_value_recursively<true>(value, chars, indent_level + 1, true);
+    else serialize_value_recursively<false>(value, chars, indent_level + 1, true);
+}
 
-// GCC, clang: can be detected with '__has_builtin()'
-#ifndef utl_log_has_source_location 
-    #ifdef __has_builtin
-        #if __has_builtin(__builtin_LINE) && __has_builtin(__builtin_FUNCTION) && __has_builtin(__builtin_FILE)
-            #define utl_log_use_source_location_builtin
-            #define utl_log_has_source_location
-        #endif
-    #endif
-#endif
+#define utl_json_serialize_struct_field(fieldname_)                                                                    \
+    serialize_struct_field(#fieldname_, val.fieldname_, chars, indent_level, prettify, is_first_field);                \
+    is_first_field = false;
 
-// clang-format on
+template <class T>
+[[nodiscard]] std::string to_string(const T& value, Format format = Format::PRETTY) {
+    std::string chars;
+    if (format == Format::PRETTY) serialize_value_recursively<true>(value, chars);
+    else serialize_value_recursively<false>(value, chars);
+    return chars;
+}
 
-#ifdef utl_log_use_source_location_builtin
-namespace utl::log::impl {
-class SourceLocation {
-    int         _line = -1;
-    const char* _func = nullptr;
-    const char* _file = nullptr;
+// --- Codegen ---
+// ---------------
 
-    constexpr SourceLocation(int line, const char* func, const char* file) noexcept
-        : _line(line), _func(func), _file(file) {}
+#define UTL_JSON_REFLECT(struct_name_, ...)                                                                            \
+                                                                                                                       \
+    template <>                                                                                                        \
+    constexpr bool utl::json::impl::is_reflected_struct<struct_name_> = true;                                          \
+                                                                                                                       \
+    template <>                                                                                                        \
+    inline utl::json::impl::Node utl::json::impl::from_struct<struct_name_>(const struct_name_& val) {                 \
+        utl::json::impl::Node json;                                                                                    \
+        /* map 'json["<FIELDNAME>"] = val.<FIELDNAME>;' */                                                             \
+        utl_json_map(utl_json_from_struct_assign, __VA_ARGS__);                                                        \
+        return json;                                                                                                   \
+    }                                                                                                                  \
+                                                                                                                       \
+    template <>                                                                                                        \
+    inline auto utl::json::impl::Node::to_struct<struct_name_>() const& -> struct_name_ {                              \
+        struct_name_ val;                                                                                              \
+        /* map 'val.<FIELDNAME> = this->at("<FIELDNAME>").get<decltype(val.<FIELDNAME>)>();' */                        \
+        utl_json_map(utl_json_to_struct_assign, __VA_ARGS__);                                                          \
+        return val;                                                                                                    \
+    }                                                                                                                  \
+                                                                                                                       \
+    template <>                                                                                                        \
+    inline auto utl::json::impl::Node::to_struct<struct_name_>() && -> struct_name_ {                                  \
+        struct_name_ val;                                                                                              \
+        /* map 'val.<FIELDNAME> = std::move(this->at("<FIELDNAME>")).get<decltype(val.<FIELDNAME>)>();' */             \
+        utl_json_map(utl_json_to_struct_move_assign, __VA_ARGS__);                                                     \
+        return val;                                                                                                    \
+    }                                                                                                                  \
+                                                                                                                       \
+    template <>                                                                                                        \
+    inline std::size_t utl::json::impl::parse_reflected_struct<struct_name_>(                                          \
+        utl::json::impl::Parser& parser, std::size_t cursor, struct_name_& val) {                                      \
+        constexpr std::size_t field_count = [] {                                                                       \
+            std::size_t count = 0;                                                                                     \
+            /* map '++count;' */                                                                                       \
+            utl_json_map(utl_json_count_struct_field, __VA_ARGS__);                                                    \
+            return count;                                                                                              \
+        }();                                                                                                           \
+        bool is_assigned[field_count] = {};                                                                            \
+        return parser.parse_sequence(cursor, '}', [&](std::size_t pos) {                                               \
+            std::string_view key;                                                                                      \
+            std::tie(pos, key) = parser.parse_object_key(pos);                                                         \
+            std::size_t field_index = 0;                                                                               \
+            /* map 'if (key == "<FIELDNAME>") return parse_struct_field_once(..., val.<FIELDNAME>, ...);' */           \
+            utl_json_map(utl_json_parse_struct_field, __VA_ARGS__);                                                    \
+            return parser.skip_node(pos);                                                                              \
+        });                                                                                                            \
+    }                                                                                                                  \
+                                                                                                                       \
+    template <>                                                                                                        \
+    inline void utl::json::impl::serialize_reflected_struct<struct_name_>(                                             \
+        const struct_name_& val, std::string& chars, unsigned int indent_level, bool prettify) {                       \
+        bool is_first_field = true;                                                                                    \
+        /* map 'serialize_struct_field("<FIELDNAME>", val.<FIELDNAME>, ...);' */                                       \
+        utl_json_map(utl_json_serialize_struct_field, __VA_ARGS__);                                                    \
+    }                                                                                                                  \
+                                                                                                                       \
+    static_assert(true)
 
+// ================
+// --- Flat DOM ---
+// ================
+
+// Alternative read-only DOM that trades mutability for parsing speed & memory footprint:
+//    - all nodes live in a single arena & get freed in one shot along with the document
+//    - objects are contiguous arrays of key-value pairs with a linear lookup, for objects of a typical
+//      size this is faster than a tree lookup, it also preserves the original order of keys
+//    - strings & keys are views into the parsed buffer (owned by the document), only strings with
+//      escape sequences need to be decoded into the arena
+// Parsing is done through the SAX parser, so we accept & reject exactly the same inputs as 'from_string()'.
+
+class FlatArena {
 public:
-    constexpr SourceLocation()                      = default;
-    constexpr SourceLocation(const SourceLocation&) = default;
-    constexpr SourceLocation(SourceLocation&&)      = default;
+    FlatArena()                            = default;
+    FlatArena(const FlatArena&)            = delete;
+    FlatArena& operator=(const FlatArena&) = delete;
 
-    [[nodiscard]] constexpr static SourceLocation
-    current(int line = __builtin_LINE(), const char* func = __builtin_FUNCTION(), const char* file = __builtin_FILE()) {
-        return SourceLocation{line, func, file};
+    FlatArena(FlatArena&& other) noexcept { *this = std::move(other); }
+
+    FlatArena& operator=(FlatArena&& other) noexcept {
+        if (this == &other) return *this;
+
+        this->blocks          = std::move(other.blocks);
+        this->current         = std::exchange(other.current, nullptr);
+        this->remaining       = std::exchange(other.remaining, 0);
+        this->next_block_size = std::exchange(other.next_block_size, min_block_size / 2);
+        other.blocks.clear(); // moved-from vector is only guaranteed to be in a valid state, not an empty one
+        return *this;
     }
+    // moved-from arena shouldn't keep pointing into the blocks it no longer owns
 
-    [[nodiscard]] constexpr int         line() const noexcept { return this->_line; }
-    [[nodiscard]] constexpr const char* file_name() const noexcept { return this->_file; }
-    [[nodiscard]] constexpr const char* function_name() const noexcept { return this->_func; }
-};
-} // namespace utl::log::impl
-#endif
-
-// If all else fails, provide a mock class that returns nothing
+    // Returns uninitialized storage for 'count' objects, same as 'std::allocator<T>::allocate()',
+    // objects have to be constructed in it with placement 'new' before use
+    template <class T>
+    [[nodiscard]] T* allocate(std::size_t count) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena never calls destructors of its objects.");
 
-#ifndef utl_log_has_source_location
-#define utl_log_has_source_location
-namespace utl::log::impl {
-struct SourceLocation {
-    [[nodiscard]] constexpr static SourceLocation current() { return SourceLocation{}; }
+        if (count == 0) return nullptr;
 
-    [[nodiscard]] constexpr int         line() const noexcept { return 0; }
-    [[nodiscard]] constexpr const char* file_name() const noexcept { return ""; }
-    [[nodiscard]] constexpr const char* function_name() const noexcept { return ""; }
-};
-} // namespace utl::log::impl
-#endif
+        const std::size_t size = sizeof(T) * count;
 
-namespace utl::log::impl {
+        void* ptr = this->current;
+        if (!std::align(alignof(T), size, ptr, this->remaining)) {
+            // Block sizes grow geometrically, large allocations get a block of their own
+            if (this->next_block_size < max_block_size) this->next_block_size *= 2;
+            const std::size_t block_size = std::max(this->next_block_size, size + alignof(T));
 
-// =================
-// --- Utilities ---
-// =================
+            this->blocks.emplace_back(new unsigned char[block_size]);
+            ptr             = this->blocks.back().get();
+            this->remaining = block_size;
+            std::align(alignof(T), size, ptr, this->remaining); // can't fail, block has enough space for padding
+        }
 
-// --- ANSI Colors ---
-// -------------------
+        this->current = static_cast<unsigned char*>(ptr) + size;
+        this->remaining -= size;
 
-namespace ansi {
+        return static_cast<T*>(ptr);
+    }
 
-constexpr std::string_view black          = "\033[30m";
-constexpr std::string_view red            = "\033[31m";
-constexpr std::string_view green          = "\033[32m";
-constexpr std::string_view yellow         = "\033[33m";
-constexpr std::string_view blue           = "\033[34m";
-constexpr std::string_view magenta        = "\033[35m";
-constexpr std::string_view cyan           = "\033[36m";
-constexpr std::string_view white          = "\033[37m";
-constexpr std::string_view bright_black   = "\033[90m"; // also known as "gray"
-constexpr std::string_view bright_red     = "\033[91m";
-constexpr std::string_view bright_green   = "\033[92m";
-constexpr std::string_view bright_yellow  = "\033[93m";
-constexpr std::string_view bright_blue    = "\033[94m";
-constexpr std::string_view bright_magenta = "\033[95m";
-constexpr std::string_view bright_cyan    = "\033[96m";
-constexpr std::string_view bright_white   = "\033[97m";
+private:
+    constexpr static std::size_t min_block_size = 4 * 1024;
+    constexpr static std::size_t max_block_size = 1024 * 1024;
 
-constexpr std::string_view bold_black          = "\033[30;1m";
-constexpr std::string_view bold_red            = "\033[31;1m";
-constexpr std::string_view bold_green          = "\033[32;1m";
-constexpr std::string_view bold_yellow         = "\033[33;1m";
-constexpr std::string_view bold_blue           = "\033[34;1m";
-constexpr std::string_view bold_magenta        = "\033[35;1m";
-constexpr std::string_view bold_cyan           = "\033[36;1m";
-constexpr std::string_view bold_white          = "\033[37;1m";
-constexpr std::string_view bold_bright_black   = "\033[90;1m";
-constexpr std::string_view bold_bright_red     = "\033[91;1m";
-constexpr std::string_view bold_bright_green   = "\033[92;1m";
-constexpr std::string_view bold_bright_yellow  = "\033[93;1m";
-constexpr std::string_view bold_bright_blue    = "\033[94;1m";
-constexpr std::string_view bold_bright_magenta = "\033[95;1m";
-constexpr std::string_view bold_bright_cyan    = "\033[96;1m";
-constexpr std::string_view bold_bright_white   = "\033[97;1m";
+    std::vector<std::unique_ptr<unsigned char[]>> blocks;
 
-constexpr std::string_view reset = "\033[0m";
+    void*       current         = nullptr;
+    std::size_t remaining       = 0;
+    std::size_t next_block_size = min_block_size / 2;
+};
 
-} // namespace ansi
+// Non-owning view over a contiguous range of nodes / members
+template <class T>
+class FlatRange {
+public:
+    FlatRange() = default;
+    FlatRange(const T* data, std::size_t size) : first(data), last(data + size) {}
 
-// --- SFINAE helpers ---
-// ----------------------
+    [[nodiscard]] const T* begin() const noexcept { return this->first; }
+    [[nodiscard]] const T* end() const noexcept { return this->last; }
 
-template <bool Cond>
-using require = std::enable_if_t<Cond, bool>;
+    [[nodiscard]] std::size_t size() const noexcept { return static_cast<std::size_t>(this->last - this->first); }
+    [[nodiscard]] bool        empty() const noexcept { return this->first == this->last; }
 
-template <class T>
-using require_enum = require<std::is_enum_v<T>>;
+    [[nodiscard]] const T& operator[](std::size_t pos) const { return this->first[pos]; }
 
-template <class T>
-using require_uint = require<std::is_integral_v<T> && std::is_unsigned_v<T>>;
+private:
+    const T* first = nullptr;
+    const T* last  = nullptr;
+};
 
-template <class T>
-using require_integral = require<std::is_integral_v<T>>;
+struct FlatMember;
+struct FlatBuilder;
 
-template <class T>
-using require_float = require<std::is_floating_point_v<T>>;
+class FlatNode {
+public:
+    // -- Getters --
+    // -------------
 
-template <class>
-constexpr bool always_false_v = false;
+    [[nodiscard]] FlatRange<FlatMember> get_object() const {
+        this->check_kind(Kind::object, "object");
+        return {this->object_data, this->size};
+    }
 
-// --- Thread ID ---
-// -----------------
+    [[nodiscard]] FlatRange<FlatNode> get_array() const {
+        this->check_kind(Kind::array, "array");
+        return {this->array_data, this->size};
+    }
 
-// Human readable replacement for 'std::this_thread::get_id()'. Usually this is implemented using
-// 'std::unordered_map<std::thread::id, int>' accessed with 'std::this_thread::get_id()' but such
-// approach is considerably slower due to a map lookup and requires additional logic to address
-// possible thread id reuse, which many implementations seem to neglect. We can use thread-locals
-// and an atomic counter to implement lazily initialized thread id count. After a first call the
-// overhead of getting thread id should be approx ~ to a branch + array lookup.
-[[nodiscard]] inline int get_next_linear_thread_id() {
-    static std::atomic<int> counter = 0;
-    return counter++;
-}
+    [[nodiscard]] std::string_view get_string() const {
+        this->check_kind(Kind::string, "string");
+        return {this->string_data, this->size};
+    }
 
-[[nodiscard]] inline int this_thread_linear_id() {
-    thread_local int thread_id = get_next_linear_thread_id();
-    return thread_id;
-}
+    [[nodiscard]] Number get_number() const {
+        this->check_kind(Kind::number, "number");
+        return this->number_value;
+    }
 
-// --- Local time ---
-// ------------------
+    [[nodiscard]] Bool get_bool() const {
+        this->check_kind(Kind::boolean, "bool");
+        return this->bool_value;
+    }
 
-[[nodiscard]] inline std::tm to_localtime(const std::time_t& time) {
-    // There are 3 ways of getting localtime in C-stdlib:
-    //    1. 'std::localtime()' - isn't thread-safe and will be marked as "deprecated" by MSVC
-    //    2. 'localtime_r()'    - isn't a part of C++, it's a part of C11, in reality provided by POSIX
-    //    3. 'localtime_s()'    - isn't a part of C++, it's a part of C23, in reality provided by Windows
-    //                            with reversed order of arguments
-    // Seemingly there is no portable way of getting thread-safe localtime without being screamed at by at least one
-    // compiler, however there is a little known trick that uses a side effect of 'std::mktime()' which normalizes its
-    // inputs should they "overflow" the allowed range. Unlike 'localtime', 'std::mktime()' is thread-safe and portable,
-    // see https://stackoverflow.com/questions/54246983/c-how-to-fix-add-a-time-offset-the-calculation-is-wrong/54248414
+    [[nodiscard]] Null get_null() const {
+        this->check_kind(Kind::null, "null");
+        return {};
+    }
 
-    // Create reference time moment at year 2025
-    std::tm reference_tm{};
-    reference_tm.tm_isdst = -1;  // negative => let the implementation deal with daylight savings
-    reference_tm.tm_year  = 125; // counting starts from 1900
+    [[nodiscard]] bool is_object() const noexcept { return this->kind == Kind::object; }
+    [[nodiscard]] bool is_array() const noexcept { return this->kind == Kind::array; }
+    [[nodiscard]] bool is_string() const noexcept { return this->kind == Kind::string; }
+    [[nodiscard]] bool is_number() const noexcept { return this->kind == Kind::number; }
+    [[nodiscard]] bool is_bool() const noexcept { return this->kind == Kind::boolean; }
+    [[nodiscard]] bool is_null() const noexcept { return this->kind == Kind::null; }
 
-    // Get the 'std::time_t' corresponding to the reference time moment
-    const std::time_t reference_time = std::mktime(&reference_tm);
-    if (reference_time == -1)
-        throw std::runtime_error("time::to_localtime(): time moment can't be represented as 'std::time_t'.");
+    // -- Object methods ---
+    // ---------------------
 
-    // Adjusting reference moment by 'time - reference_time' makes it equal to the current time moment,
-    // it is now invalid due to seconds overflowing the allowed range
-    reference_tm.tm_sec += static_cast<int>(time - reference_time);
-    // 'std::time_t' is an arithmetic type, although not defined, this is almost always an
-    // integral value holding the number of seconds since Epoch (see cppreference). This is
-    // why we can substract them and add into the seconds.
+    [[nodiscard]] const FlatNode* find(std::string_view key) const;
+    // returns 'nullptr' for non-existent keys, in case of duplicate keys
+    // the first one is found, same as with the regular 'Node'
 
-    // Normalize time moment, it is now valid and corresponds to a current local time
-    if (std::mktime(&reference_tm) == -1)
-        throw std::runtime_error("time::to_localtime(): time moment can't be represented as 'std::time_t'.");
+    [[nodiscard]] const FlatNode& operator[](std::string_view key) const {
+        if (const FlatNode* node = this->find(key)) return *node;
+        throw std::runtime_error("Accessing non-existent key {" + std::string(key) + "} in JSON object.");
+    }
 
-    return reference_tm;
-}
+    [[nodiscard]] const FlatNode& at(std::string_view key) const { return this->operator[](key); }
 
-[[nodiscard]] inline std::string datetime_string(const char* format = "%Y-%m-%d %H:%M:%S") {
-    const auto now    = std::chrono::system_clock::now();
-    const auto c_time = std::chrono::system_clock::to_time_t(now);
-    const auto c_tm   = to_localtime(c_time);
+    [[nodiscard]] bool contains(std::string_view key) const { return this->find(key) != nullptr; }
 
-    std::array<char, 256> buffer;
-    if (std::strftime(buffer.data(), buffer.size(), format, &c_tm) == 0)
-        throw std::runtime_error("time::datetime_string(): 'format' does not fit into the buffer.");
-    return std::string(buffer.data());
+    // -- Array methods ---
+    // --------------------
 
-    // Note 1: C++20 provides <chrono> with a native way of getting date, before that we have to use <ctime>
-    // Note 2: 'std::chrono::system_clock' is unique - its output can be converted into a C-style 'std::time_t'
-    // Note 3: This function is thread-safe, we use a quirky implementation of 'localtime()', see notes above
-}
+    [[nodiscard]] const FlatNode& operator[](std::size_t pos) const { return this->get_array()[pos]; }
 
-// --- Thread-local state ---
-// --------------------------
+    [[nodiscard]] const FlatNode& at(std::size_t pos) const {
+        const auto array = this->get_array();
+        if (pos >= array.size())
+            throw std::out_of_range("Accessing non-existent index {" + std::to_string(pos) +
+                                    "} in JSON array of size " + std::to_string(array.size()) + ".");
+        return array[pos];
+    }
 
-[[nodiscard]] inline std::string& thread_local_temporary_string() {
-    thread_local std::string str;
-    str.clear();
-    return str; // returned string is always empty, no need to clear it at the callsite
-}
-// In order to compute alignment we have to format things into a temporary string first.
-// The naive way would be to allocate a new function-local string every time. We can reduce
-// allocations by keeping a single temp string per thread and reusing it every time we need a temporary.
+    // -- Conversions --
+    // -----------------
 
-// --- Constants ---
-// -----------------
+    [[nodiscard]] Node to_node() const;
 
-constexpr std::size_t max_chars_float = 30;       // enough to fit 80-bit long double
-constexpr std::size_t max_chars_int   = 20;       // enough to fit 64-bit signed integer
-constexpr std::size_t buffering_size  = 8 * 1024; // 8 KB, good for most systems
-constexpr auto        buffering_time  = std::chrono::milliseconds{5};
+    [[nodiscard]] std::string to_string(Format format = Format::PRETTY) const;
 
-// --- <chrono> formatting ---
-// ---------------------------
+private:
+    enum class Kind : std::uint8_t { null, object, array, string, number, boolean };
+
+    Kind          kind       = Kind::null;
+    bool          bool_value = false;
+    std::uint32_t size       = 0; // chars in a string / elements in an array / members in an object
+    union {
+        Number            number_value = 0;
+        const char*       string_data;
+        const FlatNode*   array_data;
+        const FlatMember* object_data;
+    };
+    // makes the node 16 bytes large, unlike 'Node' which is ~56 bytes with 'libstdc++'
 
-struct SplitDuration {
-    std::chrono::hours        hours;
-    std::chrono::minutes      min;
-    std::chrono::seconds      sec;
-    std::chrono::milliseconds ms;
-    std::chrono::microseconds us;
-    std::chrono::nanoseconds  ns;
+    void check_kind(Kind expected, std::string_view expected_name) const {
+        using namespace std::string_literals;
 
-    constexpr static std::size_t size = 6; // number of time units, avoids magic constants everywhere
+        if (this->kind != expected)
+            throw std::runtime_error("JSON flat node was accessed as {"s + std::string(expected_name) +
+                                     "}, but holds a different type."s);
+    }
 
-    using common_rep = std::common_type_t<decltype(hours)::rep, decltype(min)::rep, decltype(sec)::rep,
-                                          decltype(ms)::rep, decltype(us)::rep, decltype(ns)::rep>;
-    // standard doesn't specify common representation type, usually it's 'std::int64_t'
+    friend struct FlatBuilder;
+};
 
-    std::array<common_rep, SplitDuration::size> count() {
-        return {this->hours.count(), this->min.count(), this->sec.count(),
-                this->ms.count(),    this->us.count(),  this->ns.count()};
-    }
+struct FlatMember {
+    std::string_view key;
+    FlatNode         value;
 };
 
-template <class Rep, class Period>
-[[nodiscard]] constexpr SplitDuration unit_split(std::chrono::duration<Rep, Period> val) {
-    // for some reason 'duration_cast<>()' is not 'noexcept'
-    const auto hours = std::chrono::duration_cast<std::chrono::hours>(val);
-    const auto min   = std::chrono::duration_cast<std::chrono::minutes>(val - hours);
-    const auto sec   = std::chrono::duration_cast<std::chrono::seconds>(val - hours - min);
-    const auto ms    = std::chrono::duration_cast<std::chrono::milliseconds>(val - hours - min - sec);
-    const auto us    = std::chrono::duration_cast<std::chrono::microseconds>(val - hours - min - sec - ms);
-    const auto ns    = std::chrono::duration_cast<std::chrono::nanoseconds>(val - hours - min - sec - ms - us);
-    return {hours, min, sec, ms, us, ns};
+inline const FlatNode* FlatNode::find(std::string_view key) const {
+    for (const auto& member : this->get_object())
+        if (member.key == key) return &member.value;
+    return nullptr;
 }
 
-using Sec = std::chrono::duration<double, std::chrono::seconds::period>; // convenient duration-to-float conversion
+inline Node FlatNode::to_node() const {
+    switch (this->kind) {
+    case Kind::object: {
+        Object object_value;
+        for (const auto& member : this->get_object())
+            object_value.try_emplace(std::string(member.key), member.value.to_node());
+        return object_value;
+        // 'try_emplace()' keeps the first of the duplicate keys, same as the regular parser
+    }
+    case Kind::array: {
+        Array array_value;
+        array_value.reserve(this->size);
+        for (const auto& element : this->get_array()) array_value.emplace_back(element.to_node());
+        return array_value;
+    }
+    case Kind::string: return this->get_string();
+    case Kind::number: return this->number_value;
+    case Kind::boolean: return this->bool_value;
+    default: return Null{};
+    }
+}
 
-// --- Worker thread ---
-// ---------------------
+template <bool prettify>
+void serialize_flat_recursion(const FlatNode& node, std::string& chars, unsigned int indent_level = 0,
+                              bool skip_first_indent = false) {
+    constexpr std::size_t indent_level_size = 4;
+    const std::size_t     indent_size       = indent_level_size * indent_level;
 
-// A single persistent thread that executes detached tasks, effectively a single-thread thread pool
-class WorkerThread {
-    bool                              terminating;
-    std::queue<std::function<void()>> tasks;
-    std::mutex                        mutex;
-    std::condition_variable           polling_cv;
-    std::thread                       thread;
+    // Same formatting as 'serialize_json_recursion()', see the notes there
 
-    void thread_main() {
-        while (true) {
-            std::unique_lock lock(this->mutex);
+    if constexpr (prettify)
+        if (!skip_first_indent) chars.append(indent_size, ' ');
 
-            this->polling_cv.wait(lock, [this] { return this->terminating || !this->tasks.empty(); });
+    if (node.is_object()) {
+        serialize_sequence<prettify>(node.get_object(), chars, indent_size, '{', '}', [&](const FlatMember& member) {
+            if constexpr (prettify) chars.append(indent_size + indent_level_size, ' ');
+            serialize_json_string(member.key, chars);
+            if constexpr (prettify) chars += ": ";
+            else chars += ':';
+            serialize_flat_recursion<prettify>(member.value, chars, indent_level + 1, true);
+        });
+    } else if (node.is_array()) {
+        serialize_sequence<prettify>(node.get_array(), chars, indent_size, '[', ']', [&](const FlatNode& element) {
+            serialize_flat_recursion<prettify>(element, chars, indent_level + 1);
+        });
+    } else if (node.is_string()) {
+        serialize_json_string(node.get_string(), chars);
+    } else if (node.is_number()) {
+        serialize_json_number(node.get_number(), chars);
+    } else if (node.is_bool()) {
+        chars += (node.get_bool() ? "true" : "false");
+    } else {
+        chars += "null";
+    }
+}
 
-            while (!this->tasks.empty()) {
-                auto task = std::move(this->tasks.front());
-                this->tasks.pop();
+inline std::string FlatNode::to_string(Format format) const {
+    std::string chars;
+    if (format == Format::PRETTY) serialize_flat_recursion<true>(*this, chars);
+    else serialize_flat_recursion<false>(*this, chars);
+    return chars;
+}
 
-                lock.unlock();
-                task();
-                lock.lock();
-            }
+class FlatDocument {
+public:
+    [[nodiscard]] const FlatNode& root() const noexcept { return this->root_node; }
 
-            if (this->terminating) break;
-        }
+    // Shortcuts for the root node
+    [[nodiscard]] const FlatNode& operator[](std::string_view key) const { return this->root_node[key]; }
+    [[nodiscard]] const FlatNode& operator[](std::size_t pos) const { return this->root_node[pos]; }
+
+    [[nodiscard]] Node        to_node() const { return this->root_node.to_node(); }
+    [[nodiscard]] std::string to_string(Format format = Format::PRETTY) const {
+        return this->root_node.to_string(format);
     }
 
-public:
-    WorkerThread() : terminating(false), thread([this] { this->thread_main(); }) {}
+private:
+    std::unique_ptr<std::string> source; // on the heap so the views stay valid when the document is moved
+    FlatArena                    arena;
+    FlatNode                     root_node;
 
-    ~WorkerThread() { // stops the worker thread & joins once the tasks are done
-        {
-            const std::scoped_lock lock(this->mutex);
-            this->terminating = true;
-        }
+    friend struct FlatBuilder;
+};
 
-        this->polling_cv.notify_one();
+// SAX handler that builds the flat DOM. Values of all currently open containers are accumulated
+// on a single stack, once the container is closed its values are moved into a contiguous arena block.
+struct FlatBuilder {
+    FlatDocument& document;
 
-        if (this->thread.joinable()) this->thread.join();
+    std::vector<FlatMember>                               stack;
+    std::vector<std::pair<std::size_t, std::string_view>> frames; // stack size & key of each open container
+    std::string_view                                      key;    // key of the next value, empty inside arrays
+
+    explicit FlatBuilder(FlatDocument& document) : document(document) {}
+
+    // Views into the source can be kept as is, decoded escaped strings have to be copied into the arena
+    std::string_view persist(std::string_view view) {
+        const std::string& source = *this->document.source;
+
+        // 'std::less<>' gives a total order even for pointers into unrelated objects, unlike the builtin '<'
+        constexpr std::less<const char*> less;
+        if (!less(view.data(), source.data()) && !less(source.data() + source.size(), view.data() + view.size()))
+            return view;
+
+        char* data = this->document.arena.allocate<char>(view.size());
+        std::uninitialized_copy(view.begin(), view.end(), data);
+        return {data, view.size()};
     }
 
-    void detached_task(std::function<void()> task) {
-        {
-            const std::scoped_lock lock(this->mutex);
-            this->tasks.emplace(std::move(task));
+    static std::uint32_t checked_size(std::size_t size) {
+        using namespace std::string_literals;
+
+        if (size > std::numeric_limits<std::uint32_t>::max())
+            throw std::runtime_error("JSON flat DOM can't store strings & containers with more than "s +
+                                     std::to_string(std::numeric_limits<std::uint32_t>::max()) + " elements."s);
+        return static_cast<std::uint32_t>(size);
+    }
+
+    void push_value(const FlatNode& node) {
+        if (this->frames.empty()) this->document.root_node = node;
+        else this->stack.push_back({this->key, node});
+    }
+
+    void open_container() { this->frames.emplace_back(this->stack.size(), this->key); }
+
+    template <class T>
+    std::pair<const T*, std::uint32_t> close_container() {
+        const auto [frame_start, frame_key] = this->frames.back();
+        this->frames.pop_back();
+        this->key = frame_key;
+
+        const std::size_t count = this->stack.size() - frame_start;
+        T*                data  = this->document.arena.allocate<T>(count);
+
+        // Arena gives us raw storage, objects are constructed in-place
+        for (std::size_t i = 0; i < count; ++i) {
+            const FlatMember& member = this->stack[frame_start + i];
+            if constexpr (std::is_same_v<T, FlatMember>) ::new (static_cast<void*>(data + i)) T(member);
+            else ::new (static_cast<void*>(data + i)) T(member.value);
         }
 
-        this->polling_cv.notify_one();
+        this->stack.resize(frame_start);
+
+        return {data, checked_size(count)};
     }
-};
 
-// --- Other ---
-// -------------
+    void on_object_begin() { this->open_container(); }
+    void on_object_end() {
+        const auto [data, size] = this->close_container<FlatMember>();
 
-template <class T>
-[[nodiscard]] constexpr T max(T a, T b) noexcept {
-    return a < b ? b : a;
-} // saves us from including the whole <algorithm> for a one-liner
+        FlatNode node;
+        node.kind        = FlatNode::Kind::object;
+        node.object_data = data;
+        node.size        = size;
+        this->push_value(node);
+    }
 
-template <class Tp, class Func> // Func = void(Element&&)
-constexpr void tuple_for_each(Tp&& tuple, Func&& func) {
-    std::apply([&func](auto&&... args) { (func(std::forward<decltype(args)>(args)), ...); }, std::forward<Tp>(tuple));
-}
+    void on_array_begin() {
+        this->open_container();
+        this->key = {};
+    }
+    void on_array_end() {
+        const auto [data, size] = this->close_container<FlatNode>();
 
-template <class T, T... Idxs, class Func> // Func = void(std::integral_constant<T, Index>)
-constexpr void for_sequence(std::integer_sequence<T, Idxs...>, Func&& func) {
-    (func(std::integral_constant<std::size_t, Idxs>{}), ...);
-} // effectively a 'constexpr for' where 'constexpr parameters' are passed as integral constants
+        FlatNode node;
+        node.kind       = FlatNode::Kind::array;
+        node.array_data = data;
+        node.size       = size;
+        this->push_value(node);
+    }
 
-template <class E, require_enum<E> = true>
-[[nodiscard]] constexpr auto to_underlying(E value) noexcept {
-    return static_cast<std::underlying_type_t<E>>(value); // in C++23 gets replaced by 'std::to_underlying()'
-}
+    void on_key(std::string_view key) { this->key = this->persist(key); }
 
-template <class E, require_enum<E> = true>
-[[nodiscard]] constexpr bool to_bool(E value) noexcept {
-    return static_cast<bool>(to_underlying(value));
-}
+    void on_string(std::string_view value) {
+        const std::string_view persisted = this->persist(value);
 
-// "Unwrapper" for container adaptors such as 'std::queue', 'std::priority_queue', 'std::stack'
-template <class Adaptor>
-const auto& underlying_container_cref(const Adaptor& adaptor) {
+        FlatNode node;
+        node.kind        = FlatNode::Kind::string;
+        node.string_data = persisted.data();
+        node.size        = checked_size(persisted.size());
+        this->push_value(node);
+    }
 
-    struct Hack : private Adaptor {
-        static const typename Adaptor::container_type& get_container(const Adaptor& adp) {
-            return adp.*&Hack::c;
-            // An extremely hacky yet standard-compliant way of accessing protected member
-            // of a class without actually creating any instances of the derived class.
-            //
-            // This expression consists of 2 operators: '.*' and '&'.
-            // '.*' takes an object on the left side, and a member pointer on the right side,
-            // and resolves the pointed-to member of the given object, this means
-            // 'object.*&Class::member' is essentially equivalent to 'object.member',
-            // except it reveals a "loophole" in protection semantics that allows us to
-            // interpret base class object as if it was derived class.
-            //
-            // Note that doing seemingly much more logical 'static_cast<Derived&>(object).member'
-            // is technically UB, even through most compilers will do the reasonable thing.
-        }
-    };
+    void on_number(Number value) {
+        FlatNode node;
+        node.kind         = FlatNode::Kind::number;
+        node.number_value = value;
+        this->push_value(node);
+    }
 
-    return Hack::get_container(adaptor);
-}
+    void on_bool(Bool value) {
+        FlatNode node;
+        node.kind       = FlatNode::Kind::boolean;
+        node.bool_value = value;
+        this->push_value(node);
+    }
 
-// ===============
-// --- Styling ---
-// ===============
+    void on_null() { this->push_value(FlatNode{}); }
 
-// --- Modifiers ---
-// -----------------
+    [[nodiscard]] static FlatDocument build(std::string chars, unsigned int recursion_limit) {
+        FlatDocument document;
+        document.source = std::make_unique<std::string>(std::move(chars));
 
-// clang-format off
-namespace mods {
-struct FloatFormat   { std::chars_format format; int precision; };
-struct IntegerFormat { int               base;                  };
-struct AlignLeft     { std::size_t       size;                  };
-struct AlignCenter   { std::size_t       size;                  };
-struct AlignRight    { std::size_t       size;                  };
-struct Color         { std::string_view  code;                  };
-} // namespace mods
-// clang-format on
+        FlatBuilder builder(document);
+        sax_from_string(*document.source, builder, recursion_limit);
 
-// --- Wrapped values ---
-// ----------------------
+        return document;
+    }
+};
 
-// Note:
-// Creating a 'wrapped value' class that doesn't leave dangling references when used with temporaries
-// requires careful application of perfect forwarding, if we were to make a naive struct like this:
-//    > template <class T>
-//    > struct Wrapper { const T& val };
-// Then creating such struct from a temporary and then passing it around further would lead to a dangling reference,
-// we want 'Wrapper' to "take ownership" of the value when it gets constructed from a temporary, but save only a
-// reference when it gets constructed from an l-value (since copying it would be wasteful), this can be achieved
-// through appropriate CTAD with perfect forwarding:
-//    > template <class T>
-//    > struct Wrapper {
-//    >     T val;
-//    >     Wrapper(T&& val) : val(std::forward<T>(val)) {}
-//    > };
-//    >
-//    > template <class T>
-//    > Wrapper(T&& val) -> Wrapper<T>;
-// 'Wrapper{const std::vector<int>&}' => 'T' will be 'const std::vector<int>&'
-// 'Wrapper{      std::vector<int>&}' => 'T' will be '      std::vector<int>&'
-// 'Wrapper{      std::vector<int> }' => 'T' will be '      std::vector<int> '
+[[nodiscard]] inline FlatDocument flat_from_string(std::string chars,
+                                                   unsigned int recursion_limit = default_recursion_limit) {
+    return FlatBuilder::build(std::move(chars), recursion_limit);
+}
 
-#define utl_log_define_style_wrapper(wrapper_, style_)                                                                 \
-    template <class T>                                                                                                 \
-    struct wrapper_ {                                                                                                  \
-        T      value;                                                                                                  \
-        style_ mod;                                                                                                    \
-                                                                                                                       \
-        wrapper_(T&& value, style_ mod) : value(std::forward<T>(value)), mod(mod) {}                                   \
-    };                                                                                                                 \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    wrapper_(T&&, style_)->wrapper_<T>
+[[nodiscard]] inline FlatDocument flat_from_file(const std::string& filepath,
+                                                 unsigned int       recursion_limit = default_recursion_limit) {
+    return flat_from_string(read_file_to_string(filepath), recursion_limit);
+}
 
-// clang-format off
-utl_log_define_style_wrapper(FormattedFloat  , mods::FloatFormat  );
-utl_log_define_style_wrapper(FormattedInteger, mods::IntegerFormat);
-utl_log_define_style_wrapper(AlignedLeft     , mods::AlignLeft    );
-utl_log_define_style_wrapper(AlignedCenter   , mods::AlignCenter  );
-utl_log_define_style_wrapper(AlignedRight    , mods::AlignRight   );
-utl_log_define_style_wrapper(Colored         , mods::Color        );
-// clang-format on
+} // namespace utl::json::impl
 
-#undef utl_log_define_style_wrapper
+// ______________________ PUBLIC API ______________________
 
-// --- Style merging ---
-// ---------------------
+namespace utl::json {
 
-namespace mods { // necessary for unqualified name lookup to discover operators with 'mods::' types
+using impl::Format;
 
-#define utl_log_define_style_merging(wrapper_, style_, require_)                                                       \
-    template <class T, require_ = true>                                                                                \
-    [[nodiscard]] constexpr wrapper_<T> operator|(T&& value, style_ mod) noexcept {                                    \
-        return {std::forward<T>(value), mod};                                                                          \
-    }                                                                                                                  \
-    static_assert(true)
+using impl::Node;
 
-// clang-format off
-utl_log_define_style_merging(FormattedFloat  , mods::FloatFormat  , require_float   <std::decay_t<T>>);
-utl_log_define_style_merging(FormattedInteger, mods::IntegerFormat, require_integral<std::decay_t<T>>);
-utl_log_define_style_merging(AlignedLeft     , mods::AlignLeft    , bool                             );
-utl_log_define_style_merging(AlignedCenter   , mods::AlignCenter  , bool                             );
-utl_log_define_style_merging(AlignedRight    , mods::AlignRight   , bool                             );
-utl_log_define_style_merging(Colored         , mods::Color        , bool                             );
-// clang-format on
+using impl::Object;
+using impl::Array;
+using impl::String;
+using impl::Number;
+using impl::Bool;
+using impl::Null;
 
-#undef utl_log_define_style_merging
+using impl::from_string;
+using impl::from_file;
+using impl::from_struct;
+using impl::SaxHandler;
+using impl::sax_from_string;
+using impl::sax_from_stream;
+using impl::sax_from_file;
+
+using impl::FlatNode;
+using impl::FlatMember;
+using impl::FlatDocument;
+using impl::flat_from_string;
+using impl::flat_from_file;
+using impl::from_string_to;
+using impl::from_file_to;
+using impl::to_string;
 
-// Prohibit applying alignment after the color (which is necessary to make log color escaping work),
-// doing it at the operator level produces the best error messages and tends to work well with LSPs
-#define utl_log_prohibit_style_merging(wrapper_, style_)                                                               \
-    template <class T>                                                                                                 \
-    constexpr void operator|(wrapper_, style_) noexcept {                                                              \
-        static_assert(always_false_v<T>, "Color modifiers should be applied after alignment.");                        \
-    }                                                                                                                  \
-    static_assert(true)
+namespace literals = impl::literals;
 
-// clang-format off
-utl_log_prohibit_style_merging(const Colored<T>& , mods::AlignRight );
-utl_log_prohibit_style_merging(const Colored<T>& , mods::AlignCenter);
-utl_log_prohibit_style_merging(const Colored<T>& , mods::AlignLeft  );
-utl_log_prohibit_style_merging(      Colored<T>&&, mods::AlignRight );
-utl_log_prohibit_style_merging(      Colored<T>&&, mods::AlignCenter);
-utl_log_prohibit_style_merging(      Colored<T>&&, mods::AlignLeft  );
-// clang-format on
+// macro -> UTL_JSON_REFLECT
 
-#undef utl_log_prohibit_style_merging
+using impl::is_reflected_struct;
 
-} // namespace mods
+} // namespace utl::json
 
-// --- Public API for style modifiers ---
-// --------------------------------------
+#endif
+#endif // module utl::json
 
-[[nodiscard]] constexpr auto general(std::size_t precision = 6) noexcept {
-    return mods::FloatFormat{std::chars_format::general, static_cast<int>(precision)};
-}
-[[nodiscard]] constexpr auto fixed(std::size_t precision = 3) noexcept {
-    return mods::FloatFormat{std::chars_format::fixed, static_cast<int>(precision)};
-}
-[[nodiscard]] constexpr auto scientific(std::size_t precision = 3) noexcept {
-    return mods::FloatFormat{std::chars_format::scientific, static_cast<int>(precision)};
-}
-[[nodiscard]] constexpr auto hex(std::size_t precision = 3) noexcept {
-    return mods::FloatFormat{std::chars_format::hex, static_cast<int>(precision)};
-}
-[[nodiscard]] constexpr auto base(std::size_t base) noexcept { return mods::IntegerFormat{static_cast<int>(base)}; }
-[[nodiscard]] constexpr auto align_left(std::size_t size) noexcept { return mods::AlignLeft{size}; }
-[[nodiscard]] constexpr auto align_center(std::size_t size) noexcept { return mods::AlignCenter{size}; }
-[[nodiscard]] constexpr auto align_right(std::size_t size) noexcept { return mods::AlignRight{size}; }
 
-// clang-format off
-namespace color {
-constexpr auto black               = mods::Color{ansi::black              };
-constexpr auto red                 = mods::Color{ansi::red                };
-constexpr auto green               = mods::Color{ansi::green              };
-constexpr auto yellow              = mods::Color{ansi::yellow             };
-constexpr auto blue                = mods::Color{ansi::blue               };
-constexpr auto magenta             = mods::Color{ansi::magenta            };
-constexpr auto cyan                = mods::Color{ansi::cyan               };
-constexpr auto white               = mods::Color{ansi::white              };
-constexpr auto bright_black        = mods::Color{ansi::bright_black       };
-constexpr auto bright_red          = mods::Color{ansi::bright_red         };
-constexpr auto bright_green        = mods::Color{ansi::bright_green       };
-constexpr auto bright_yellow       = mods::Color{ansi::bright_yellow      };
-constexpr auto bright_blue         = mods::Color{ansi::bright_blue        };
-constexpr auto bright_magenta      = mods::Color{ansi::bright_magenta     };
-constexpr auto bright_cyan         = mods::Color{ansi::bright_cyan        };
-constexpr auto bright_white        = mods::Color{ansi::bright_white       };
-constexpr auto bold_black          = mods::Color{ansi::bold_black         };
-constexpr auto bold_red            = mods::Color{ansi::bold_red           };
-constexpr auto bold_green          = mods::Color{ansi::bold_green         };
-constexpr auto bold_yellow         = mods::Color{ansi::bold_yellow        };
-constexpr auto bold_blue           = mods::Color{ansi::bold_blue          };
-constexpr auto bold_magenta        = mods::Color{ansi::bold_magenta       };
-constexpr auto bold_cyan           = mods::Color{ansi::bold_cyan          };
-constexpr auto bold_white          = mods::Color{ansi::bold_white         };
-constexpr auto bold_bright_black   = mods::Color{ansi::bold_bright_black  };
-constexpr auto bold_bright_red     = mods::Color{ansi::bold_bright_red    };
-constexpr auto bold_bright_green   = mods::Color{ansi::bold_bright_green  };
-constexpr auto bold_bright_yellow  = mods::Color{ansi::bold_bright_yellow };
-constexpr auto bold_bright_blue    = mods::Color{ansi::bold_bright_blue   };
-constexpr auto bold_bright_magenta = mods::Color{ansi::bold_bright_magenta};
-constexpr auto bold_bright_cyan    = mods::Color{ansi::bold_bright_cyan   };
-constexpr auto bold_bright_white   = mods::Color{ansi::bold_bright_white  };
-} // namespace color
-// clang-format on
 
-// =================
-// --- Formatter ---
-// =================
 
-// --- Member detection type traits ---
-// ------------------------------------
 
-#define utl_log_define_trait(trait_name_, ...)                                                                         \
-    template <class T, class = void>                                                                                   \
-    struct trait_name_ : std::false_type {};                                                                           \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    struct trait_name_<T, std::void_t<decltype(__VA_ARGS__)>> : std::true_type {};                                     \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    constexpr bool trait_name_##_v = trait_name_<T>::value
-
-// clang-format off
-utl_log_define_trait(has_string        , std::declval<T>().string()                              );
-utl_log_define_trait(has_real          , std::declval<T>().real()                                );
-utl_log_define_trait(has_imag          , std::declval<T>().imag()                                );
-utl_log_define_trait(has_begin         , std::declval<T>().begin()                               );
-utl_log_define_trait(has_end           , std::declval<T>().end()                                 );
-utl_log_define_trait(has_input_it      , std::next(std::declval<T>().begin())                    );
-utl_log_define_trait(has_get           , std::get<0>(std::declval<T>())                          );
-utl_log_define_trait(has_tuple_size    , std::tuple_size<T>::value                               );
-utl_log_define_trait(has_container_type, std::declval<typename std::decay_t<T>::container_type>());
-utl_log_define_trait(has_rep           , std::declval<typename std::decay_t<T>::rep>()           );
-utl_log_define_trait(has_period        , std::declval<typename std::decay_t<T>::period>()        );
-utl_log_define_trait(has_ostream_insert, std::declval<std::ostream>() << std::declval<T>()       );
-// clang-format on
-
-#undef utl_log_define_trait
-
-// --- Type trait chain ---
-// ------------------------
-
-// We want to provide default formatting behaviour based on type traits, however one type
-// might satisfy multiple formatter-suitable type traits. To avoid ambiguity we need to select
-// one based on a certain trait priority.
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //
-// A simple way to do it would be to have and 'if constexpr' chain inside the formatter,
-// however that would leave user with no good customization points.
+// Module:        utl::log
+// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_log.md
+// Source repo:   https://github.com/DmitriBogdanov/UTL
 //
-// We can emulate an 'if constexpr' chain on the type trait level by arranging them in a following pattern:
-//    > is_TYPE_i = /* if TYPE should be included due to its properties         */;
-//    > is_TYPE_e = /* if TYPE should be excluded due to already having a match */;
-//    > is_TYPE_v = is_TYPE_i && !is_TYPE_e;
+// This project is licensed under the MIT License
 //
-// Similar effect could be achieved in other ways, but this one proved to be so far the least impactful
-// in terms of compile times, as we don't introduce and deep template nesting & minimize instantiations.
-
-template <class Type>
-struct Traits {
-    using T = std::decay_t<Type>;
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-    // char types ('char')
-    constexpr static bool is_char_i               = std::is_same_v<T, char>;
-    constexpr static bool is_char_e               = false;
-    constexpr static bool is_char_v               = is_char_i && !is_char_e;
-    // enum types
-    constexpr static bool is_enum_i               = std::is_enum_v<T>;
-    constexpr static bool is_enum_e               = is_char_e || is_char_i;
-    constexpr static bool is_enum_v               = is_enum_i && !is_enum_e;
-    // types with '.string()' ('std::path')
-    constexpr static bool is_path_i               = has_string_v<T>;
-    constexpr static bool is_path_e               = is_enum_e || is_enum_i;
-    constexpr static bool is_path_v               = is_path_i && !is_path_e;
-    // string-like types ('std::string_view', 'std::string', 'const char*')
-    constexpr static bool is_string_i             = std::is_convertible_v<T, std::string_view>;
-    constexpr static bool is_string_e             = is_path_e || is_path_i;
-    constexpr static bool is_string_v             = is_string_i && !is_string_e;
-    // string-convertible types (custom classes)
-    constexpr static bool is_string_convertible_i = std::is_convertible_v<T, std::string>;
-    constexpr static bool is_string_convertible_e = is_string_e || is_string_i;
-    constexpr static bool is_string_convertible_v = is_string_convertible_i && !is_string_convertible_e;
-    // boolean types ('bool')
-    constexpr static bool is_bool_i               = std::is_same_v<T, bool>;
-    constexpr static bool is_bool_e               = is_string_convertible_e || is_string_convertible_i;
-    constexpr static bool is_bool_v               = is_bool_i && !is_bool_e;
-    // integer types ('int', 'std::uint64_t', etc.)
-    constexpr static bool is_integer_i            = std::is_integral_v<T>;
-    constexpr static bool is_integer_e            = is_bool_e || is_bool_i;
-    constexpr static bool is_integer_v            = is_integer_i && !is_integer_e;
-    // floating-point types
-    constexpr static bool is_float_i              = std::is_floating_point_v<T>;
-    constexpr static bool is_float_e              = is_integer_e || is_integer_i;
-    constexpr static bool is_float_v              = is_float_i && !is_float_e;
-    // 'std::complex'-like types
-    constexpr static bool is_complex_i            = has_imag_v<T>;
-    constexpr static bool is_complex_e            = is_float_e || is_float_i;
-    constexpr static bool is_complex_v            = is_complex_i && !is_complex_e;
-    // array-like types
-    constexpr static bool is_array_i              = has_begin_v<T> && has_end_v<T> && has_input_it_v<T>;
-    constexpr static bool is_array_e              = is_complex_e || is_complex_i;
-    constexpr static bool is_array_v              = is_array_i && !is_array_e;
-    // tuple-like types
-    constexpr static bool is_tuple_i              = has_get_v<T> && has_tuple_size_v<T>;
-    constexpr static bool is_tuple_e              = is_array_e || is_array_i;
-    constexpr static bool is_tuple_v              = is_tuple_i && !is_tuple_e;
-    // container adaptor types
-    constexpr static bool is_adaptor_i            = has_container_type_v<T>;
-    constexpr static bool is_adaptor_e            = is_tuple_e || is_tuple_i;
-    constexpr static bool is_adaptor_v            = is_adaptor_i && !is_adaptor_e;
-    // <chrono> types
-    constexpr static bool is_duration_i           = has_rep_v<T> && has_period_v<T>;
-    constexpr static bool is_duration_e           = is_adaptor_e || is_adaptor_i;
-    constexpr static bool is_duration_v           = is_duration_i && !is_duration_e;
-    // printable types
-    constexpr static bool is_printable_i          = has_ostream_insert_v<T>;
-    constexpr static bool is_printable_e          = is_duration_e || is_duration_i;
-    constexpr static bool is_printable_v          = is_printable_i && !is_printable_e;
-};
+#if !defined(UTL_PICK_MODULES) || defined(UTL_MODULE_LOG)
 
-// --- String buffer ---
-// ---------------------
+#ifndef utl_log_headerguard
+#define utl_log_headerguard
 
-// Simplest case of a 'buffer' concept, wraps 'std::string' into a buffer-like API for appending
-// so we can use it in formatters that require an intermediate string for formatting
+#define UTL_LOG_VERSION_MAJOR 2
+#define UTL_LOG_VERSION_MINOR 3
+#define UTL_LOG_VERSION_PATCH 3
 
-class StringBuffer {
-    std::string& str;
+// _______________________ INCLUDES _______________________
 
-public:
-    StringBuffer(std::string& str) noexcept : str(str) {}
+#include <array>              // array<>, size_t
+#include <atomic>             // atomic<>
+#include <cassert>            // assert()
+#include <charconv>           // to_chars()
+#include <chrono>             // steady_clock
+#include <condition_variable> // condition_variable
+#include <fstream>            // ofstream, ostream
+#include <functional>         // function<>, ref()
+#include <iostream>           // cout
+#include <iterator>           // ostreambuf_iterator<>
+#include <memory>             // unique_ptr<>, make_unique<>()
+#include <mutex>              // mutex<>, scoped_lock<>
+#include <queue>              // queue<>
+#include <sstream>            // ostringstream
+#include <string>             // string
+#include <string_view>        // string_view
+#include <thread>             // thread
+#include <tuple>              // tuple<>, get<>, tuple_size_v<>, apply()
+#include <type_traits>        // enable_if_t<>, is_enum_v<>, is_integral_v<>, is_unsigned_v<>, underlying_type_t<>, ...
+#include <utility>            // forward<>(), integer_sequence<>, make_index_sequence<>
 
-    void push_string(std::string_view sv) { this->str += sv; }
+// ____________________ DEVELOPER DOCS ____________________
 
-    void push_chars(std::size_t count, char ch) { this->str.append(count, ch); }
-};
+// A somewhat overengineered logger that uses a lot of compile-time magic and internal macro codegen
+// to generate a concise macro-free API that provides features usually associated with macros.
+//
+// We also want simple customizability on user side while squeezing out as much formatting
+// performance as we reasonably can using compile-time logic. Combined with the inherent
+// weirdness of variadic formatting this at times leads to some truly horrific constructs.
+//
+// All things considered, format strings are a much simpler solution from the implementation perspective,
+// however properly using them isn't possible without bringing in fmtlib as a dependency. In theory,
+// if we wanted to to push for truly top-notch performance the plan would be as follows:
+//    1. Bring in fmtlib as a dependency and use format strings as a syntax of choice
+//    2. Bring in llfio / glaze or another low latency IO library as a dependency
+//    3. Implement async formatting & IO backend:
+//    |  A. Loging threads push entries into a MPSC lock-free queue
+//    |  B. Serialized types are limited to a specific set which can be encoded
+//    |  C. Each queue entry consists of a:
+//    |  |  a. Timestamp
+//    |  |  b. Pointer to a constexpr metadata struct that contains callsite,
+//    |  |     format string and a pointer to a generated template decoder function
+//    |  |  c. Binary copy encoding the arguments
+//    |  D. Backend thread pops entries from the queue and puts them into an unbounded transit buffer
+//    |     ordered by the entry timestamp, this buffer gets periodically flushed, this is necessary
+//    |     to sort multi-threaded logs by time without introducing syncronization on the logging
+//    |     threads, perfect ordering is not theoretically guaranteed it is good enough in practice
+//    |  E. When flushing, backend thread performs:
+//    |  |  a. Decoding using the received function pointer
+//    |  |  b. Formatting using fmtlib
+//    |  |  c. Buffered IO using the manual buffer and the underlying IO library
+//    4. Use macro API to generate & format callsite and other metadata at compile-time,
+//       doing the same with functions is non-feasible / extremely difficult due to the
+//       design of 'std::source_location' which prevent proper compile-time evaluation
+//    5. Use a custom <chrono> clock based on RDTSC timestamps for lower overhead
+// this, however, would require a project of a whole different scale and integration complexity.
 
-// --- Partial specializations ---
-// -------------------------------
+// ____________________ IMPLEMENTATION ____________________
 
-// Base template
-template <class T, class = void>
-struct Formatter {
-    static_assert(always_false_v<T>, "No formatter could be deduced for the type.");
-};
+// ===============================================
+// --- Optional 'std::source_location' support ---
+// ===============================================
 
-// char types ('char')
-template <class T>
-struct Formatter<T, std::enable_if_t<Traits<T>::is_char_v>> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const T& arg) const {
-        buffer.push_chars(1, arg);
-    }
-};
+// clang-format off
 
-// enum types
-template <class T>
-struct Formatter<T, std::enable_if_t<Traits<T>::is_enum_v>> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const T& arg) const {
-        Formatter<std::underlying_type_t<std::decay_t<T>>>{}(buffer, to_underlying(arg));
-    }
-};
+// Detect if we have C++20 or above
 
-// types with '.string()' ('std::path')
-template <class T>
-struct Formatter<T, std::enable_if_t<Traits<T>::is_path_v>> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const T& arg) const {
-        buffer.push_string(arg.string());
-    }
-};
+#ifdef _MSC_VER
+    #define utl_log_cpp_standard _MSVC_LANG
+#else
+    #define utl_log_cpp_standard __cplusplus
+#endif
 
-// string-like types ('std::string_view', 'std::string', 'const char*')
-template <class T>
-struct Formatter<T, std::enable_if_t<Traits<T>::is_string_v>> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const T& arg) const {
-        buffer.push_string(std::string_view{arg});
-    }
-};
+// For C++20 and above use typedef for 'std::source_location'
 
-// string-convertible types (custom classes)
-template <class T>
-struct Formatter<T, std::enable_if_t<Traits<T>::is_string_convertible_v>> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const T& arg) const {
-        buffer.push_string(std::string{arg});
+#if utl_log_cpp_standard >= 202002L
+    #include <source_location>
+    namespace utl::log::impl {
+        using SourceLocation = std::source_location;
     }
-};
+    #define utl_log_has_source_location
+#endif
 
-// boolean types ('bool')
-template <class T>
-struct Formatter<T, std::enable_if_t<Traits<T>::is_bool_v>> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const T& arg) const {
-        buffer.push_string(arg ? "true" : "false");
-    }
-};
+// Below C++20 detect compiler version and intrinsics that allow its emulation.
+// Emulation works similarly for all 3 major compilers and is quite simple to implement.
+// It provides the entire standard API except '.column()' which is not supported by GCC.
 
-// integral types ('int', 'std::uint64_t', etc.)
-template <class T>
-struct Formatter<T, std::enable_if_t<Traits<T>::is_integer_v>> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const T& arg) const {
-        std::array<char, max_chars_int> res;
+// MSVC: requires at least VS 2019 16.6 Preview 2
+#ifndef utl_log_has_source_location
+    #ifdef _MSC_VER
+        #if _MSC_VER >= 1927
+            #define utl_log_use_source_location_builtin
+            #define utl_log_has_source_location
+        #endif
+    #endif
+#endif
 
-        const std::size_t serialized = std::to_chars(res.data(), res.data() + res.size(), arg).ptr - res.data();
+// GCC, clang: can be detected with '__has_builtin()'
+#ifndef utl_log_has_source_location 
+    #ifdef __has_builtin
+        #if __has_builtin(__builtin_LINE) && __has_builtin(__builtin_FUNCTION) && __has_builtin(__builtin_FILE)
+            #define utl_log_use_source_location_builtin
+            #define utl_log_has_source_location
+        #endif
+    #endif
+#endif
 
-        buffer.push_string(std::string_view{res.data(), serialized});
-    }
-};
+// clang-format on
 
-// floating-point types
-template <class T>
-struct Formatter<T, std::enable_if_t<Traits<T>::is_float_v>> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const T& arg) const {
-        std::array<char, max_chars_int> res;
+#ifdef utl_log_use_source_location_builtin
+namespace utl::log::impl {
+class SourceLocation {
+    int         _line = -1;
+    const char* _func = nullptr;
+    const char* _file = nullptr;
 
-        const std::size_t serialized = std::to_chars(res.data(), res.data() + res.size(), arg).ptr - res.data();
+    constexpr SourceLocation(int line, const char* func, const char* file) noexcept
+        : _line(line), _func(func), _file(file) {}
 
-        buffer.push_string(std::string_view{res.data(), serialized});
+public:
+    constexpr SourceLocation()                      = default;
+    constexpr SourceLocation(const SourceLocation&) = default;
+    constexpr SourceLocation(SourceLocation&&)      = default;
+
+    [[nodiscard]] constexpr static SourceLocation
+    current(int line = __builtin_LINE(), const char* func = __builtin_FUNCTION(), const char* file = __builtin_FILE()) {
+        return SourceLocation{line, func, file};
     }
+
+    [[nodiscard]] constexpr int         line() const noexcept { return this->_line; }
+    [[nodiscard]] constexpr const char* file_name() const noexcept { return this->_file; }
+    [[nodiscard]] constexpr const char* function_name() const noexcept { return this->_func; }
 };
+} // namespace utl::log::impl
+#endif
 
-// 'std::complex'-like types
-template <class T>
-struct Formatter<T, std::enable_if_t<Traits<T>::is_complex_v>> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const T& arg) const {
-        const auto string_formatter = Formatter<std::string_view>{};
-        const auto value_formatter  = Formatter<decltype(arg.real())>{};
+// If all else fails, provide a mock class that returns nothing
 
-        value_formatter(buffer, arg.real());
-        if (arg.imag() >= 0) {
-            string_formatter(buffer, " + ");
-            value_formatter(buffer, arg.imag());
-        } else {
-            string_formatter(buffer, " - ");
-            value_formatter(buffer, -arg.imag());
-        }
-        string_formatter(buffer, "i");
-    }
+#ifndef utl_log_has_source_location
+#define utl_log_has_source_location
+namespace utl::log::impl {
+struct SourceLocation {
+    [[nodiscard]] constexpr static SourceLocation current() { return SourceLocation{}; }
+
+    [[nodiscard]] constexpr int         line() const noexcept { return 0; }
+    [[nodiscard]] constexpr const char* file_name() const noexcept { return ""; }
+    [[nodiscard]] constexpr const char* function_name() const noexcept { return ""; }
 };
+} // namespace utl::log::impl
+#endif
 
-// array-like types
-template <class T>
-struct Formatter<T, std::enable_if_t<Traits<T>::is_array_v>> {
-    static constexpr std::string_view prefix    = "[ ";
-    static constexpr std::string_view suffix    = " ]";
-    static constexpr std::string_view delimiter = ", ";
+namespace utl::log::impl {
 
-    template <class Buffer>
-    void operator()(Buffer& buffer, const T& arg) const {
-        const auto string_formatter = Formatter<std::string_view>{};
-        const auto value_formatter  = Formatter<typename std::decay_t<T>::value_type>{};
+// =================
+// --- Utilities ---
+// =================
 
-        string_formatter(buffer, prefix);
-        if (arg.begin() != arg.end()) {
-            for (auto it = arg.begin();;) {
-                value_formatter(buffer, *it);
-                if (++it == arg.end()) break; // prevents trailing comma
-                string_formatter(buffer, delimiter);
-            }
-        }
-        string_formatter(buffer, suffix);
-    }
-};
+// --- ANSI Colors ---
+// -------------------
 
-// tuple-like types
-template <class T>
-struct Formatter<T, std::enable_if_t<Traits<T>::is_tuple_v>> {
-    static constexpr std::string_view prefix    = "< ";
-    static constexpr std::string_view suffix    = " >";
-    static constexpr std::string_view delimiter = ", ";
+namespace ansi {
 
-    template <class Buffer>
-    void operator()(Buffer& buffer, const T& arg) const {
-        const auto string_formatter = Formatter<std::string_view>{};
+constexpr std::string_view black          = "\033[30m";
+constexpr std::string_view red            = "\033[31m";
+constexpr std::string_view green          = "\033[32m";
+constexpr std::string_view yellow         = "\033[33m";
+constexpr std::string_view blue           = "\033[34m";
+constexpr std::string_view magenta        = "\033[35m";
+constexpr std::string_view cyan           = "\033[36m";
+constexpr std::string_view white          = "\033[37m";
+constexpr std::string_view bright_black   = "\033[90m"; // also known as "gray"
+constexpr std::string_view bright_red     = "\033[91m";
+constexpr std::string_view bright_green   = "\033[92m";
+constexpr std::string_view bright_yellow  = "\033[93m";
+constexpr std::string_view bright_blue    = "\033[94m";
+constexpr std::string_view bright_magenta = "\033[95m";
+constexpr std::string_view bright_cyan    = "\033[96m";
+constexpr std::string_view bright_white   = "\033[97m";
 
-        string_formatter(buffer, prefix);
+constexpr std::string_view bold_black          = "\033[30;1m";
+constexpr std::string_view bold_red            = "\033[31;1m";
+constexpr std::string_view bold_green          = "\033[32;1m";
+constexpr std::string_view bold_yellow         = "\033[33;1m";
+constexpr std::string_view bold_blue           = "\033[34;1m";
+constexpr std::string_view bold_magenta        = "\033[35;1m";
+constexpr std::string_view bold_cyan           = "\033[36;1m";
+constexpr std::string_view bold_white          = "\033[37;1m";
+constexpr std::string_view bold_bright_black   = "\033[90;1m";
+constexpr std::string_view bold_bright_red     = "\033[91;1m";
+constexpr std::string_view bold_bright_green   = "\033[92;1m";
+constexpr std::string_view bold_bright_yellow  = "\033[93;1m";
+constexpr std::string_view bold_bright_blue    = "\033[94;1m";
+constexpr std::string_view bold_bright_magenta = "\033[95;1m";
+constexpr std::string_view bold_bright_cyan    = "\033[96;1m";
+constexpr std::string_view bold_bright_white   = "\033[97;1m";
 
-        for_sequence(std::make_index_sequence<std::tuple_size_v<T>>{}, [&](auto index) {
-            const auto& element = std::get<index>(arg); // 'index' is an 'std::integral_constant<std::size_t, i>'
+constexpr std::string_view reset = "\033[0m";
 
-            if constexpr (index != 0) string_formatter(buffer, delimiter);
+} // namespace ansi
 
-            Formatter<std::tuple_element_t<index, T>>{}(buffer, element);
-        });
+// --- SFINAE helpers ---
+// ----------------------
 
-        string_formatter(buffer, suffix);
-    }
-};
+template <bool Cond>
+using require = std::enable_if_t<Cond, bool>;
 
-// container adaptor types
 template <class T>
-struct Formatter<T, std::enable_if_t<Traits<T>::is_adaptor_v>> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const T& arg) const {
-        const auto& ref = underlying_container_cref(arg);
+using require_enum = require<std::is_enum_v<T>>;
 
-        Formatter<std::decay_t<decltype(ref)>>{}(buffer, ref);
-    }
-};
+template <class T>
+using require_uint = require<std::is_integral_v<T> && std::is_unsigned_v<T>>;
 
-// <chrono> types
 template <class T>
-struct Formatter<T, std::enable_if_t<Traits<T>::is_duration_v>> {
-    constexpr static std::size_t relevant_units = 3;
+using require_integral = require<std::is_integral_v<T>>;
 
-    constexpr static std::array<std::string_view, SplitDuration::size> names = {"hours", "min", "sec",
-                                                                                "ms",    "us",  "ns"};
+template <class T>
+using require_float = require<std::is_floating_point_v<T>>;
 
-    template <class Buffer>
-    void operator()(Buffer& buffer, const T& arg) const {
+template <class>
+constexpr bool always_false_v = false;
 
-        auto string_formatter  = Formatter<std::string_view>{};
-        auto integer_formatter = Formatter<SplitDuration::common_rep>{};
+// --- Thread ID ---
+// -----------------
 
-        // Takes 'unit_count' of the highest relevant units and converts them to string,
-        // for example with 'unit_count' equal to '3', we will have:
-        //
-        // timescale <= hours   =>   show { hours, min, sec }   =>   string "___ hours ___ min ___ sec"
-        // timescale <= min     =>   show {   min, sec,  ms }   =>   string "___ min ___ sec ___ ms"
-        // timescale <= sec     =>   show {   sec,  ms,  us }   =>   string "___ sec ___ ms ___ us"
-        // timescale <= ms      =>   show {    ms,  us,  ns }   =>   string "___ ms ___ us ___ ns"
-        // timescale <= us      =>   show {    us,  ns      }   =>   string "___ us ___ ns"
-        // timescale <= ns      =>   show {    ns           }   =>   string "___ ns"
+// Human readable replacement for 'std::this_thread::get_id()'. Usually this is implemented using
+// 'std::unordered_map<std::thread::id, int>' accessed with 'std::this_thread::get_id()' but such
+// approach is considerably slower due to a map lookup and requires additional logic to address
+// possible thread id reuse, which many implementations seem to neglect. We can use thread-locals
+// and an atomic counter to implement lazily initialized thread id count. After a first call the
+// overhead of getting thread id should be approx ~ to a branch + array lookup.
+[[nodiscard]] inline int get_next_linear_thread_id() {
+    static std::atomic<int> counter = 0;
+    return counter++;
+}
 
-        const std::array<SplitDuration::common_rep, SplitDuration::size> counts = unit_split(arg).count();
+[[nodiscard]] inline int this_thread_linear_id() {
+    thread_local int thread_id = get_next_linear_thread_id();
+    return thread_id;
+}
 
-        for (std::size_t unit = 0; unit < counts.size(); ++unit) {
-            if (counts[unit]) {
-                const std::size_t last =
-                    (unit + relevant_units < counts.size()) ? (unit + relevant_units) : counts.size();
-                // don't want to include the whole <algorithm> just for 'std::max()'
+// --- Local time ---
+// ------------------
 
-                for (std::size_t k = unit; k < last; ++k) {
-                    integer_formatter(buffer, counts[k]);
-                    string_formatter(buffer, " ");
-                    string_formatter(buffer, names[k]);
-                    if (k + 1 != last) string_formatter(buffer, " "); // prevents trailing space at the end
-                }
-                return;
-            }
-        }
+[[nodiscard]] inline std::tm to_localtime(const std::time_t& time) {
+    // There are 3 ways of getting localtime in C-stdlib:
+    //    1. 'std::localtime()' - isn't thread-safe and will be marked as "deprecated" by MSVC
+    //    2. 'localtime_r()'    - isn't a part of C++, it's a part of C11, in reality provided by POSIX
+    //    3. 'localtime_s()'    - isn't a part of C++, it's a part of C23, in reality provided by Windows
+    //                            with reversed order of arguments
+    // Seemingly there is no portable way of getting thread-safe localtime without being screamed at by at least one
+    // compiler, however there is a little known trick that uses a side effect of 'std::mktime()' which normalizes its
+    // inputs should they "overflow" the allowed range. Unlike 'localtime', 'std::mktime()' is thread-safe and portable,
+    // see https://stackoverflow.com/questions/54246983/c-how-to-fix-add-a-time-offset-the-calculation-is-wrong/54248414
 
-        string_formatter(buffer, "0 ns"); // fallback, unlikely to ever be triggered
-    }
-};
+    // Create reference time moment at year 2025
+    std::tm reference_tm{};
+    reference_tm.tm_isdst = -1;  // negative => let the implementation deal with daylight savings
+    reference_tm.tm_year  = 125; // counting starts from 1900
 
-// printable types
-template <class T>
-struct Formatter<T, std::enable_if_t<Traits<T>::is_printable_v>> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const T& arg) const {
-        buffer.push_string((std::ostringstream{} << arg).str());
-        // creating a string stream every time is slow, but there is no way around it,
-        // this is simply a flaw of streams as a design
-    }
-};
+    // Get the 'std::time_t' corresponding to the reference time moment
+    const std::time_t reference_time = std::mktime(&reference_tm);
+    if (reference_time == -1)
+        throw std::runtime_error("time::to_localtime(): time moment can't be represented as 'std::time_t'.");
 
-// 'FormattedFloat<T>' types
-template <class T>
-struct Formatter<FormattedFloat<T>, std::enable_if_t<Traits<T>::is_float_v>> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const FormattedFloat<T>& arg) const {
-        std::array<char, max_chars_int> res;
+    // Adjusting reference moment by 'time - reference_time' makes it equal to the current time moment,
+    // it is now invalid due to seconds overflowing the allowed range
+    reference_tm.tm_sec += static_cast<int>(time - reference_time);
+    // 'std::time_t' is an arithmetic type, although not defined, this is almost always an
+    // integral value holding the number of seconds since Epoch (see cppreference). This is
+    // why we can substract them and add into the seconds.
 
-        const std::size_t serialized =
-            std::to_chars(res.data(), res.data() + res.size(), arg.value, arg.mod.format, arg.mod.precision).ptr -
-            res.data();
+    // Normalize time moment, it is now valid and corresponds to a current local time
+    if (std::mktime(&reference_tm) == -1)
+        throw std::runtime_error("time::to_localtime(): time moment can't be represented as 'std::time_t'.");
 
-        buffer.push_string(std::string_view{res.data(), serialized});
-    }
-};
+    return reference_tm;
+}
 
-// 'FormattedInteger<T>' types
-template <class T>
-struct Formatter<FormattedInteger<T>, std::enable_if_t<Traits<T>::is_integer_v>> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const FormattedInteger<T>& arg) const {
-        std::array<char, max_chars_int> res;
+[[nodiscard]] inline std::string datetime_string(const char* format = "%Y-%m-%d %H:%M:%S") {
+    const auto now    = std::chrono::system_clock::now();
+    const auto c_time = std::chrono::system_clock::to_time_t(now);
+    const auto c_tm   = to_localtime(c_time);
 
-        const std::size_t serialized =
-            std::to_chars(res.data(), res.data() + res.size(), arg.value, arg.mod.base).ptr - res.data();
+    std::array<char, 256> buffer;
+    if (std::strftime(buffer.data(), buffer.size(), format, &c_tm) == 0)
+        throw std::runtime_error("time::datetime_string(): 'format' does not fit into the buffer.");
+    return std::string(buffer.data());
 
-        buffer.push_string(std::string_view{res.data(), serialized});
-    }
-};
+    // Note 1: C++20 provides <chrono> with a native way of getting date, before that we have to use <ctime>
+    // Note 2: 'std::chrono::system_clock' is unique - its output can be converted into a C-style 'std::time_t'
+    // Note 3: This function is thread-safe, we use a quirky implementation of 'localtime()', see notes above
+}
 
-// 'AlignedLeft<T>' types
-template <class T>
-struct Formatter<AlignedLeft<T>, void> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const AlignedLeft<T>& arg) const {
-        std::string& temp = thread_local_temporary_string();
-        StringBuffer temp_buffer(temp);
+// --- Thread-local state ---
+// --------------------------
 
-        Formatter<T>{}(temp_buffer, arg.value);
+[[nodiscard]] inline std::string& thread_local_temporary_string() {
+    thread_local std::string str;
+    str.clear();
+    return str; // returned string is always empty, no need to clear it at the callsite
+}
+// In order to compute alignment we have to format things into a temporary string first.
+// The naive way would be to allocate a new function-local string every time. We can reduce
+// allocations by keeping a single temp string per thread and reusing it every time we need a temporary.
 
-        const std::size_t size_no_pad   = temp.size();
-        const std::size_t size_with_pad = max(arg.mod.size, size_no_pad);
-        const std::size_t right_pad     = size_with_pad - size_no_pad;
+// --- Constants ---
+// -----------------
 
-        buffer.push_string(temp);
-        buffer.push_chars(right_pad, ' ');
-    }
-};
+constexpr std::size_t max_chars_float = 30;       // enough to fit 80-bit long double
+constexpr std::size_t max_chars_int   = 20;       // enough to fit 64-bit signed integer
+constexpr std::size_t buffering_size  = 8 * 1024; // 8 KB, good for most systems
+constexpr auto        buffering_time  = std::chrono::milliseconds{5};
 
-// 'AlignedCenter<T>' types
-template <class T>
-struct Formatter<AlignedCenter<T>, void> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const AlignedCenter<T>& arg) const {
-        std::string& temp = thread_local_temporary_string();
-        StringBuffer temp_buffer(temp);
+// --- <chrono> formatting ---
+// ---------------------------
 
-        Formatter<T>{}(temp_buffer, arg.value);
+struct SplitDuration {
+    std::chrono::hours        hours;
+    std::chrono::minutes      min;
+    std::chrono::seconds      sec;
+    std::chrono::milliseconds ms;
+    std::chrono::microseconds us;
+    std::chrono::nanoseconds  ns;
 
-        const std::size_t size_no_pad   = temp.size();
-        const std::size_t size_with_pad = max(arg.mod.size, size_no_pad);
-        const std::size_t left_pad      = (size_with_pad - size_no_pad) / 2;
-        const std::size_t right_pad     = size_with_pad - size_no_pad - left_pad;
+    constexpr static std::size_t size = 6; // number of time units, avoids magic constants everywhere
 
-        buffer.push_chars(left_pad, ' ');
-        buffer.push_string(temp);
-        buffer.push_chars(right_pad, ' ');
+    using common_rep = std::common_type_t<decltype(hours)::rep, decltype(min)::rep, decltype(sec)::rep,
+                                          decltype(ms)::rep, decltype(us)::rep, decltype(ns)::rep>;
+    // standard doesn't specify common representation type, usually it's 'std::int64_t'
+
+    std::array<common_rep, SplitDuration::size> count() {
+        return {this->hours.count(), this->min.count(), this->sec.count(),
+                this->ms.count(),    this->us.count(),  this->ns.count()};
     }
 };
 
-// 'AlignedRight<T>' types
-template <class T>
-struct Formatter<AlignedRight<T>, void> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const AlignedRight<T>& arg) const {
-        std::string& temp = thread_local_temporary_string();
-        StringBuffer temp_buffer(temp);
+template <class Rep, class Period>
+[[nodiscard]] constexpr SplitDuration unit_split(std::chrono::duration<Rep, Period> val) {
+    // for some reason 'duration_cast<>()' is not 'noexcept'
+    const auto hours = std::chrono::duration_cast<std::chrono::hours>(val);
+    const auto min   = std::chrono::duration_cast<std::chrono::minutes>(val - hours);
+    const auto sec   = std::chrono::duration_cast<std::chrono::seconds>(val - hours - min);
+    const auto ms    = std::chrono::duration_cast<std::chrono::milliseconds>(val - hours - min - sec);
+    const auto us    = std::chrono::duration_cast<std::chrono::microseconds>(val - hours - min - sec - ms);
+    const auto ns    = std::chrono::duration_cast<std::chrono::nanoseconds>(val - hours - min - sec - ms - us);
+    return {hours, min, sec, ms, us, ns};
+}
 
-        Formatter<T>{}(temp_buffer, arg.value);
+using Sec = std::chrono::duration<double, std::chrono::seconds::period>; // convenient duration-to-float conversion
 
-        const std::size_t size_no_pad   = temp.size();
-        const std::size_t size_with_pad = max(arg.mod.size, size_no_pad);
-        const std::size_t left_pad      = size_with_pad - size_no_pad;
+// --- Worker thread ---
+// ---------------------
 
-        buffer.push_chars(left_pad, ' ');
-        buffer.push_string(temp);
-    }
-};
+// A single persistent thread that executes detached tasks, effectively a single-thread thread pool
+class WorkerThread {
+    bool                              terminating;
+    std::queue<std::function<void()>> tasks;
+    std::mutex                        mutex;
+    std::condition_variable           polling_cv;
+    std::thread                       thread;
 
-// 'Colored<T>' types
-template <class T>
-struct Formatter<Colored<T>, void> {
-    template <class Buffer>
-    void operator()(Buffer& buffer, const Colored<T>& arg) const {
-        buffer.push_string(arg.mod.code);
-        Formatter<T>{}(buffer, arg.value);
-        buffer.push_string(ansi::reset);
-    }
-};
+    void thread_main() {
+        while (true) {
+            std::unique_lock lock(this->mutex);
 
-// ==============
-// --- Logger ---
-// ==============
+            this->polling_cv.wait(lock, [this] { return this->terminating || !this->tasks.empty(); });
 
-// Class layout:
-//
-//    Logger               | Input: Message    | Output: Message    | - Captures meta, forwards message to all sinks
-//    -> tuple<Sink, ...>
-//
-//    Sink                 | Input: Message    | Output: Message    | - Wraps underlying API & provides defaults
-//    -> Protector         | Input: Message    | Output: Message    | - Handles safe/unsafe threading
-//       -> Writer         | Input: Message    | Output: Log string | - Handles message formatting
-//         -> Buffer       | Input: Log string | Output: Log string | - Handles instant/fixed/timed buffering
-//            -> Flusher   | Input: Log string | Output: Log string | - Handles sync/async flushing
-//               -> Output | Input: Log string | Output: Log string | - Wraps underlying IO output
-//
-// Specific instances of all listed components depend on specializations selected though policies.
+            while (!this->tasks.empty()) {
+                auto task = std::move(this->tasks.front());
+                this->tasks.pop();
 
-// --- Message metadata ---
-// ------------------------
+                lock.unlock();
+                task();
+                lock.lock();
+            }
 
-using Clock = std::chrono::steady_clock;
+            if (this->terminating) break;
+        }
+    }
 
-// Metadata associated with a logging record, generated once by the 'Logger' and distributed to all sinks
-struct Record {
-    Clock::duration  elapsed;
-    std::string_view file;
-    std::size_t      line;
-};
+public:
+    WorkerThread() : terminating(false), thread([this] { this->thread_main(); }) {}
 
-// --- Policies ---
-// ----------------
+    ~WorkerThread() { // stops the worker thread & joins once the tasks are done
+        {
+            const std::scoped_lock lock(this->mutex);
+            this->terminating = true;
+        }
 
-namespace policy {
+        this->polling_cv.notify_one();
 
-enum class Type { FILE, STREAM };
+        if (this->thread.joinable()) this->thread.join();
+    }
 
-enum class Level { ERR = 0, WARN = 1, NOTE = 2, INFO = 3, DEBUG = 4, TRACE = 5 };
+    void detached_task(std::function<void()> task) {
+        {
+            const std::scoped_lock lock(this->mutex);
+            this->tasks.emplace(std::move(task));
+        }
 
-enum class Color { NONE, ANSI };
+        this->polling_cv.notify_one();
+    }
+};
 
-enum class Format {
-    DATE     = 1 << 0,
-    TITLE    = 1 << 1,
-    THREAD   = 1 << 2,
-    UPTIME   = 1 << 3,
-    CALLSITE = 1 << 4,
-    LEVEL    = 1 << 5,
-    NONE     = 0,
-    FULL     = DATE | TITLE | THREAD | UPTIME | CALLSITE | LEVEL
-}; // bitmask enum
+// --- Other ---
+// -------------
 
-[[nodiscard]] constexpr Format operator|(Format a, Format b) noexcept {
-    return static_cast<Format>(to_underlying(a) | to_underlying(b));
-}
+template <class T>
+[[nodiscard]] constexpr T max(T a, T b) noexcept {
+    return a < b ? b : a;
+} // saves us from including the whole <algorithm> for a one-liner
 
-[[nodiscard]] constexpr Format operator&(Format a, Format b) noexcept {
-    return static_cast<Format>(to_underlying(a) & to_underlying(b));
+template <class Tp, class Func> // Func = void(Element&&)
+constexpr void tuple_for_each(Tp&& tuple, Func&& func) {
+    std::apply([&func](auto&&... args) { (func(std::forward<decltype(args)>(args)), ...); }, std::forward<Tp>(tuple));
 }
 
-enum class Buffering { NONE, FIXED, TIMED };
+template <class T, T... Idxs, class Func> // Func = void(std::integral_constant<T, Index>)
+constexpr void for_sequence(std::integer_sequence<T, Idxs...>, Func&& func) {
+    (func(std::integral_constant<std::size_t, Idxs>{}), ...);
+} // effectively a 'constexpr for' where 'constexpr parameters' are passed as integral constants
 
-enum class Flushing { SYNC, ASYNC };
-
-enum class Threading { UNSAFE, SAFE };
+template <class E, require_enum<E> = true>
+[[nodiscard]] constexpr auto to_underlying(E value) noexcept {
+    return static_cast<std::underlying_type_t<E>>(value); // in C++23 gets replaced by 'std::to_underlying()'
+}
 
-} // namespace policy
+template <class E, require_enum<E> = true>
+[[nodiscard]] constexpr bool to_bool(E value) noexcept {
+    return static_cast<bool>(to_underlying(value));
+}
 
-// =========================
-// --- Component: Output ---
-// =========================
+// "Unwrapper" for container adaptors such as 'std::queue', 'std::priority_queue', 'std::stack'
+template <class Adaptor>
+const auto& underlying_container_cref(const Adaptor& adaptor) {
 
-template <policy::Type type>
-class Output;
+    struct Hack : private Adaptor {
+        static const typename Adaptor::container_type& get_container(const Adaptor& adp) {
+            return adp.*&Hack::c;
+            // An extremely hacky yet standard-compliant way of accessing protected member
+            // of a class without actually creating any instances of the derived class.
+            //
+            // This expression consists of 2 operators: '.*' and '&'.
+            // '.*' takes an object on the left side, and a member pointer on the right side,
+            // and resolves the pointed-to member of the given object, this means
+            // 'object.*&Class::member' is essentially equivalent to 'object.member',
+            // except it reveals a "loophole" in protection semantics that allows us to
+            // interpret base class object as if it was derived class.
+            //
+            // Note that doing seemingly much more logical 'static_cast<Derived&>(object).member'
+            // is technically UB, even through most compilers will do the reasonable thing.
+        }
+    };
 
-// --- File output ---
-// -------------------
+    return Hack::get_container(adaptor);
+}
 
-template <>
-class Output<policy::Type::FILE> {
-    std::ofstream file;
+// ===============
+// --- Styling ---
+// ===============
 
-public:
-    Output(const std::string& name) : file(name) {}
-    Output(std::ofstream&& file) : file(std::move(file)) {}
+// --- Modifiers ---
+// -----------------
 
-    void flush_string(std::string_view sv) {
-        this->file.write(sv.data(), sv.size());
-        this->file.flush();
-    }
+// clang-format off
+namespace mods {
+struct FloatFormat   { std::chars_format format; int precision; };
+struct IntegerFormat { int               base;                  };
+struct AlignLeft     { std::size_t       size;                  };
+struct AlignCenter   { std::size_t       size;                  };
+struct AlignRight    { std::size_t       size;                  };
+struct Color         { std::string_view  code;                  };
+} // namespace mods
+// clang-format on
 
-    void flush_chars(std::size_t count, char ch) {
-        std::ostreambuf_iterator<char> first(this->file);
-        for (std::size_t i = 0; i < count; ++i) first = ch;
-        // fastest way of writing N chars to a stream, 'std::ostreambuf_iterator' writes character to a stream
-        // when assigned, dereference/increment is no-op making it rather strange for an "iterator"
-    }
-};
+// --- Wrapped values ---
+// ----------------------
 
-// --- Stream output ---
-// ---------------------
+// Note:
+// Creating a 'wrapped value' class that doesn't leave dangling references when used with temporaries
+// requires careful application of perfect forwarding, if we were to make a naive struct like this:
+//    > template <class T>
+//    > struct Wrapper { const T& val };
+// Then creating such struct from a temporary and then passing it around further would lead to a dangling reference,
+// we want 'Wrapper' to "take ownership" of the value when it gets constructed from a temporary, but save only a
+// reference when it gets constructed from an l-value (since copying it would be wasteful), this can be achieved
+// through appropriate CTAD with perfect forwarding:
+//    > template <class T>
+//    > struct Wrapper {
+//    >     T val;
+//    >     Wrapper(T&& val) : val(std::forward<T>(val)) {}
+//    > };
+//    >
+//    > template <class T>
+//    > Wrapper(T&& val) -> Wrapper<T>;
+// 'Wrapper{const std::vector<int>&}' => 'T' will be 'const std::vector<int>&'
+// 'Wrapper{      std::vector<int>&}' => 'T' will be '      std::vector<int>&'
+// 'Wrapper{      std::vector<int> }' => 'T' will be '      std::vector<int> '
 
-template <>
-class Output<policy::Type::STREAM> {
-    std::ostream& os;
+#define utl_log_define_style_wrapper(wrapper_, style_)                                                                 \
+    template <class T>                                                                                                 \
+    struct wrapper_ {                                                                                                  \
+        T      value;                                                                                                  \
+        style_ mod;                                                                                                    \
+                                                                                                                       \
+        wrapper_(T&& value, style_ mod) : value(std::forward<T>(value)), mod(mod) {}                                   \
+    };                                                                                                                 \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    wrapper_(T&&, style_)->wrapper_<T>
 
-public:
-    Output(std::ostream& os) noexcept : os(os) {}
+// clang-format off
+utl_log_define_style_wrapper(FormattedFloat  , mods::FloatFormat  );
+utl_log_define_style_wrapper(FormattedInteger, mods::IntegerFormat);
+utl_log_define_style_wrapper(AlignedLeft     , mods::AlignLeft    );
+utl_log_define_style_wrapper(AlignedCenter   , mods::AlignCenter  );
+utl_log_define_style_wrapper(AlignedRight    , mods::AlignRight   );
+utl_log_define_style_wrapper(Colored         , mods::Color        );
+// clang-format on
 
-    void flush_string(std::string_view sv) {
-        this->os.write(sv.data(), sv.size());
-        this->os.flush();
-    }
+#undef utl_log_define_style_wrapper
 
-    void flush_chars(std::size_t count, char ch) {
-        std::ostreambuf_iterator<char> first(this->os);
-        for (std::size_t i = 0; i < count; ++i) first = ch;
-        // fastest way of writing N chars to a stream, 'std::ostreambuf_iterator' writes character to a stream
-        // when assigned, dereference/increment is no-op making it a rather strange case of an "iterator"
-    }
-};
+// --- Style merging ---
+// ---------------------
 
-// ==========================
-// --- Component: Flusher ---
-// ==========================
+namespace mods { // necessary for unqualified name lookup to discover operators with 'mods::' types
 
-template <class OutputType, policy::Flushing flushing>
-class Flusher;
+#define utl_log_define_style_merging(wrapper_, style_, require_)                                                       \
+    template <class T, require_ = true>                                                                                \
+    [[nodiscard]] constexpr wrapper_<T> operator|(T&& value, style_ mod) noexcept {                                    \
+        return {std::forward<T>(value), mod};                                                                          \
+    }                                                                                                                  \
+    static_assert(true)
 
-// --- Synchonous flushing ---
-// ---------------------------
+// clang-format off
+utl_log_define_style_merging(FormattedFloat  , mods::FloatFormat  , require_float   <std::decay_t<T>>);
+utl_log_define_style_merging(FormattedInteger, mods::IntegerFormat, require_integral<std::decay_t<T>>);
+utl_log_define_style_merging(AlignedLeft     , mods::AlignLeft    , bool                             );
+utl_log_define_style_merging(AlignedCenter   , mods::AlignCenter  , bool                             );
+utl_log_define_style_merging(AlignedRight    , mods::AlignRight   , bool                             );
+utl_log_define_style_merging(Colored         , mods::Color        , bool                             );
+// clang-format on
 
-template <class OutputType>
-class Flusher<OutputType, policy::Flushing::SYNC> {
-    OutputType output;
+#undef utl_log_define_style_merging
 
-public:
-    Flusher(OutputType&& output) : output(std::move(output)) {}
+// Prohibit applying alignment after the color (which is necessary to make log color escaping work),
+// doing it at the operator level produces the best error messages and tends to work well with LSPs
+#define utl_log_prohibit_style_merging(wrapper_, style_)                                                               \
+    template <class T>                                                                                                 \
+    constexpr void operator|(wrapper_, style_) noexcept {                                                              \
+        static_assert(always_false_v<T>, "Color modifiers should be applied after alignment.");                        \
+    }                                                                                                                  \
+    static_assert(true)
 
-    void flush_string(std::string_view sv) { this->output.flush_string(sv); }
+// clang-format off
+utl_log_prohibit_style_merging(const Colored<T>& , mods::AlignRight );
+utl_log_prohibit_style_merging(const Colored<T>& , mods::AlignCenter);
+utl_log_prohibit_style_merging(const Colored<T>& , mods::AlignLeft  );
+utl_log_prohibit_style_merging(      Colored<T>&&, mods::AlignRight );
+utl_log_prohibit_style_merging(      Colored<T>&&, mods::AlignCenter);
+utl_log_prohibit_style_merging(      Colored<T>&&, mods::AlignLeft  );
+// clang-format on
 
-    void flush_chars(std::size_t count, char ch) { this->output.flush_chars(count, ch); }
-};
+#undef utl_log_prohibit_style_merging
 
-// --- Async flushing ---
-// ----------------------
+} // namespace mods
 
-template <class OutputType>
-class Flusher<OutputType, policy::Flushing::ASYNC> {
-    OutputType output; // destruction order matters here, 'output' should be available until 'worker' thread joins
+// --- Public API for style modifiers ---
+// --------------------------------------
 
-    std::unique_ptr<WorkerThread> worker = std::make_unique<WorkerThread>();
+[[nodiscard]] constexpr auto general(std::size_t precision = 6) noexcept {
+    return mods::FloatFormat{std::chars_format::general, static_cast<int>(precision)};
+}
+[[nodiscard]] constexpr auto fixed(std::size_t precision = 3) noexcept {
+    return mods::FloatFormat{std::chars_format::fixed, static_cast<int>(precision)};
+}
+[[nodiscard]] constexpr auto scientific(std::size_t precision = 3) noexcept {
+    return mods::FloatFormat{std::chars_format::scientific, static_cast<int>(precision)};
+}
+[[nodiscard]] constexpr auto hex(std::size_t precision = 3) noexcept {
+    return mods::FloatFormat{std::chars_format::hex, static_cast<int>(precision)};
+}
+[[nodiscard]] constexpr auto base(std::size_t base) noexcept { return mods::IntegerFormat{static_cast<int>(base)}; }
+[[nodiscard]] constexpr auto align_left(std::size_t size) noexcept { return mods::AlignLeft{size}; }
+[[nodiscard]] constexpr auto align_center(std::size_t size) noexcept { return mods::AlignCenter{size}; }
+[[nodiscard]] constexpr auto align_right(std::size_t size) noexcept { return mods::AlignRight{size}; }
 
-public:
-    Flusher(OutputType&& output) : output(std::move(output)) {}
+// clang-format off
+namespace color {
+constexpr auto black               = mods::Color{ansi::black              };
+constexpr auto red                 = mods::Color{ansi::red                };
+constexpr auto green               = mods::Color{ansi::green              };
+constexpr auto yellow              = mods::Color{ansi::yellow             };
+constexpr auto blue                = mods::Color{ansi::blue               };
+constexpr auto magenta             = mods::Color{ansi::magenta            };
+constexpr auto cyan                = mods::Color{ansi::cyan               };
+constexpr auto white               = mods::Color{ansi::white              };
+constexpr auto bright_black        = mods::Color{ansi::bright_black       };
+constexpr auto bright_red          = mods::Color{ansi::bright_red         };
+constexpr auto bright_green        = mods::Color{ansi::bright_green       };
+constexpr auto bright_yellow       = mods::Color{ansi::bright_yellow      };
+constexpr auto bright_blue         = mods::Color{ansi::bright_blue        };
+constexpr auto bright_magenta      = mods::Color{ansi::bright_magenta     };
+constexpr auto bright_cyan         = mods::Color{ansi::bright_cyan        };
+constexpr auto bright_white        = mods::Color{ansi::bright_white       };
+constexpr auto bold_black          = mods::Color{ansi::bold_black         };
+constexpr auto bold_red            = mods::Color{ansi::bold_red           };
+constexpr auto bold_green          = mods::Color{ansi::bold_green         };
+constexpr auto bold_yellow         = mods::Color{ansi::bold_yellow        };
+constexpr auto bold_blue           = mods::Color{ansi::bold_blue          };
+constexpr auto bold_magenta        = mods::Color{ansi::bold_magenta       };
+constexpr auto bold_cyan           = mods::Color{ansi::bold_cyan          };
+constexpr auto bold_white          = mods::Color{ansi::bold_white         };
+constexpr auto bold_bright_black   = mods::Color{ansi::bold_bright_black  };
+constexpr auto bold_bright_red     = mods::Color{ansi::bold_bright_red    };
+constexpr auto bold_bright_green   = mods::Color{ansi::bold_bright_green  };
+constexpr auto bold_bright_yellow  = mods::Color{ansi::bold_bright_yellow };
+constexpr auto bold_bright_blue    = mods::Color{ansi::bold_bright_blue   };
+constexpr auto bold_bright_magenta = mods::Color{ansi::bold_bright_magenta};
+constexpr auto bold_bright_cyan    = mods::Color{ansi::bold_bright_cyan   };
+constexpr auto bold_bright_white   = mods::Color{ansi::bold_bright_white  };
+} // namespace color
+// clang-format on
 
-    Flusher(Flusher&& other) : output(std::move(other.output)), worker(std::move(other.worker)) {}
+// =================
+// --- Formatter ---
+// =================
 
-    void flush_string(std::string_view sv) {
-        this->worker->detached_task([&out = output, str = std::string(sv)]() { out.flush_string(str); });
+// --- Member detection type traits ---
+// ------------------------------------
 
-        // Note 1: The buffer might be mutated while the other thread flushes it, we have to pass a copy
-        // Note 2: 'std::bind' doesn't bind reference arguments, we have to add a wrapper with 'std::ref'
-    }
-
-    void flush_chars(std::size_t count, char ch) {
-        this->worker->detached_task([&out = output, count, ch] { out.flush_chars(count, ch); });
-    }
-};
-
-// =========================
-// --- Component: Buffer ---
-// =========================
-
-template <class FlusherType, policy::Buffering buffering>
-class Buffer;
+#define utl_log_define_trait(trait_name_, ...)                                                                         \
+    template <class T, class = void>                                                                                   \
+    struct trait_name_ : std::false_type {};                                                                           \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    struct trait_name_<T, std::void_t<decltype(__VA_ARGS__)>> : std::true_type {};                                     \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    constexpr bool trait_name_##_v = trait_name_<T>::value
 
-// --- Instant buffering ---
-// -------------------------
+// clang-format off
+utl_log_define_trait(has_string        , std::declval<T>().string()                              );
+utl_log_define_trait(has_real          , std::declval<T>().real()                                );
+utl_log_define_trait(has_imag          , std::declval<T>().imag()                                );
+utl_log_define_trait(has_begin         , std::declval<T>().begin()                               );
+utl_log_define_trait(has_end           , std::declval<T>().end()                                 );
+utl_log_define_trait(has_input_it      , std::next(std::declval<T>().begin())                    );
+utl_log_define_trait(has_get           , std::get<0>(std::declval<T>())                          );
+utl_log_define_trait(has_tuple_size    , std::tuple_size<T>::value                               );
+utl_log_define_trait(has_container_type, std::declval<typename std::decay_t<T>::container_type>());
+utl_log_define_trait(has_rep           , std::declval<typename std::decay_t<T>::rep>()           );
+utl_log_define_trait(has_period        , std::declval<typename std::decay_t<T>::period>()        );
+utl_log_define_trait(has_ostream_insert, std::declval<std::ostream>() << std::declval<T>()       );
+// clang-format on
 
-template <class FlusherType>
-class Buffer<FlusherType, policy::Buffering::NONE> {
-    FlusherType flusher;
+#undef utl_log_define_trait
 
-public:
-    Buffer(FlusherType&& flusher) : flusher(std::move(flusher)) {}
+// --- Type trait chain ---
+// ------------------------
 
-    void push_record(const Record&) const noexcept {} // only matters for timed buffer
+// We want to provide default formatting behaviour based on type traits, however one type
+// might satisfy multiple formatter-suitable type traits. To avoid ambiguity we need to select
+// one based on a certain trait priority.
+//
+// A simple way to do it would be to have and 'if constexpr' chain inside the formatter,
+// however that would leave user with no good customization points.
+//
+// We can emulate an 'if constexpr' chain on the type trait level by arranging them in a following pattern:
+//    > is_TYPE_i = /* if TYPE should be included due to its properties         */;
+//    > is_TYPE_e = /* if TYPE should be excluded due to already having a match */;
+//    > is_TYPE_v = is_TYPE_i && !is_TYPE_e;
+//
+// Similar effect could be achieved in other ways, but this one proved to be so far the least impactful
+// in terms of compile times, as we don't introduce and deep template nesting & minimize instantiations.
 
-    void push_string(std::string_view sv) { this->flusher.flush_string(sv); }
+template <class Type>
+struct Traits {
+    using T = std::decay_t<Type>;
 
-    void push_chars(std::size_t count, char ch) { this->flusher.flush_chars(count, ch); }
+    // char types ('char')
+    constexpr static bool is_char_i               = std::is_same_v<T, char>;
+    constexpr static bool is_char_e               = false;
+    constexpr static bool is_char_v               = is_char_i && !is_char_e;
+    // enum types
+    constexpr static bool is_enum_i               = std::is_enum_v<T>;
+    constexpr static bool is_enum_e               = is_char_e || is_char_i;
+    constexpr static bool is_enum_v               = is_enum_i && !is_enum_e;
+    // types with '.string()' ('std::path')
+    constexpr static bool is_path_i               = has_string_v<T>;
+    constexpr static bool is_path_e               = is_enum_e || is_enum_i;
+    constexpr static bool is_path_v               = is_path_i && !is_path_e;
+    // string-like types ('std::string_view', 'std::string', 'const char*')
+    constexpr static bool is_string_i             = std::is_convertible_v<T, std::string_view>;
+    constexpr static bool is_string_e             = is_path_e || is_path_i;
+    constexpr static bool is_string_v             = is_string_i && !is_string_e;
+    // string-convertible types (custom classes)
+    constexpr static bool is_string_convertible_i = std::is_convertible_v<T, std::string>;
+    constexpr static bool is_string_convertible_e = is_string_e || is_string_i;
+    constexpr static bool is_string_convertible_v = is_string_convertible_i && !is_string_convertible_e;
+    // boolean types ('bool')
+    constexpr static bool is_bool_i               = std::is_same_v<T, bool>;
+    constexpr static bool is_bool_e               = is_string_convertible_e || is_string_convertible_i;
+    constexpr static bool is_bool_v               = is_bool_i && !is_bool_e;
+    // integer types ('int', 'std::uint64_t', etc.)
+    constexpr static bool is_integer_i            = std::is_integral_v<T>;
+    constexpr static bool is_integer_e            = is_bool_e || is_bool_i;
+    constexpr static bool is_integer_v            = is_integer_i && !is_integer_e;
+    // floating-point types
+    constexpr static bool is_float_i              = std::is_floating_point_v<T>;
+    constexpr static bool is_float_e              = is_integer_e || is_integer_i;
+    constexpr static bool is_float_v              = is_float_i && !is_float_e;
+    // 'std::complex'-like types
+    constexpr static bool is_complex_i            = has_imag_v<T>;
+    constexpr static bool is_complex_e            = is_float_e || is_float_i;
+    constexpr static bool is_complex_v            = is_complex_i && !is_complex_e;
+    // array-like types
+    constexpr static bool is_array_i              = has_begin_v<T> && has_end_v<T> && has_input_it_v<T>;
+    constexpr static bool is_array_e              = is_complex_e || is_complex_i;
+    constexpr static bool is_array_v              = is_array_i && !is_array_e;
+    // tuple-like types
+    constexpr static bool is_tuple_i              = has_get_v<T> && has_tuple_size_v<T>;
+    constexpr static bool is_tuple_e              = is_array_e || is_array_i;
+    constexpr static bool is_tuple_v              = is_tuple_i && !is_tuple_e;
+    // container adaptor types
+    constexpr static bool is_adaptor_i            = has_container_type_v<T>;
+    constexpr static bool is_adaptor_e            = is_tuple_e || is_tuple_i;
+    constexpr static bool is_adaptor_v            = is_adaptor_i && !is_adaptor_e;
+    // <chrono> types
+    constexpr static bool is_duration_i           = has_rep_v<T> && has_period_v<T>;
+    constexpr static bool is_duration_e           = is_adaptor_e || is_adaptor_i;
+    constexpr static bool is_duration_v           = is_duration_i && !is_duration_e;
+    // printable types
+    constexpr static bool is_printable_i          = has_ostream_insert_v<T>;
+    constexpr static bool is_printable_e          = is_duration_e || is_duration_i;
+    constexpr static bool is_printable_v          = is_printable_i && !is_printable_e;
 };
 
-// --- Fixed buffering ---
-// -----------------------
+// --- String buffer ---
+// ---------------------
 
-template <class FlusherType>
-class Buffer<FlusherType, policy::Buffering::FIXED> {
-    constexpr static std::size_t size = buffering_size;
+// Simplest case of a 'buffer' concept, wraps 'std::string' into a buffer-like API for appending
+// so we can use it in formatters that require an intermediate string for formatting
 
-    FlusherType            flusher;
-    std::array<char, size> buffer{};
-    std::size_t            cursor{};
+class StringBuffer {
+    std::string& str;
 
 public:
-    Buffer(FlusherType&& output) : flusher(std::move(output)) {}
-
-    // Buffered flusher need non-trivial destructor and move semantics to ensure correct flushing of
-    // the remaining buffer upon destruction. Moved-from buffer should not flush upon destruction.
-    Buffer(Buffer&& other) : flusher(std::move(other.flusher)), buffer(other.buffer), cursor(other.cursor) {
-        other.cursor = size;
-    }
-
-    ~Buffer() {
-        if (this->cursor == size) return;
+    StringBuffer(std::string& str) noexcept : str(str) {}
 
-        this->flusher.flush_string(std::string_view{this->buffer.data(), this->cursor});
-    }
+    void push_string(std::string_view sv) { this->str += sv; }
 
-    void push_record(const Record&) const noexcept {} // only matters for timed buffer
+    void push_chars(std::size_t count, char ch) { this->str.append(count, ch); }
+};
 
-    void push_string(std::string_view sv) {
-        while (true) {
-            const std::size_t space_needed    = sv.size();
-            const std::size_t space_remaining = size - this->cursor;
+// --- Partial specializations ---
+// -------------------------------
 
-            // Fast path: Message fits into the buffer
-            if (space_needed <= space_remaining) {
-                for (std::size_t i = 0; i < space_needed; ++i) this->buffer[this->cursor + i] = sv[i];
-                this->cursor += space_needed;
+// Base template
+template <class T, class = void>
+struct Formatter {
+    static_assert(always_false_v<T>, "No formatter could be deduced for the type.");
+};
 
-                return;
-            }
-            // Slow path: Message doesn't fit, need to flush
-            else {
-                for (std::size_t i = 0; i < space_remaining; ++i) this->buffer[this->cursor + i] = sv[i];
-                this->cursor = 0;
-                this->flusher.flush_string(std::string_view{this->buffer.data(), this->buffer.size()});
+// char types ('char')
+template <class T>
+struct Formatter<T, std::enable_if_t<Traits<T>::is_char_v>> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const T& arg) const {
+        buffer.push_chars(1, arg);
+    }
+};
 
-                sv.remove_prefix(space_remaining);
-            }
-        }
+// enum types
+template <class T>
+struct Formatter<T, std::enable_if_t<Traits<T>::is_enum_v>> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const T& arg) const {
+        Formatter<std::underlying_type_t<std::decay_t<T>>>{}(buffer, to_underlying(arg));
     }
+};
 
-    void push_chars(std::size_t count, char ch) {
-        while (true) {
-            const std::size_t space_needed    = count;
-            const std::size_t space_remaining = size - this->cursor;
+// types with '.string()' ('std::path')
+template <class T>
+struct Formatter<T, std::enable_if_t<Traits<T>::is_path_v>> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const T& arg) const {
+        buffer.push_string(arg.string());
+    }
+};
 
-            // Fast path: Message fits into the buffer
-            if (space_needed <= space_remaining) {
-                for (std::size_t i = 0; i < space_needed; ++i) this->buffer[this->cursor + i] = ch;
-                this->cursor += space_needed;
+// string-like types ('std::string_view', 'std::string', 'const char*')
+template <class T>
+struct Formatter<T, std::enable_if_t<Traits<T>::is_string_v>> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const T& arg) const {
+        buffer.push_string(std::string_view{arg});
+    }
+};
 
-                return;
-            }
-            // Slow path: Message doesn't fit, need to flush
-            else {
-                for (std::size_t i = 0; i < space_remaining; ++i) this->buffer[this->cursor + i] = ch;
-                this->cursor = 0;
-                this->flusher.flush_string(std::string_view{this->buffer.data(), this->buffer.size()});
+// string-convertible types (custom classes)
+template <class T>
+struct Formatter<T, std::enable_if_t<Traits<T>::is_string_convertible_v>> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const T& arg) const {
+        buffer.push_string(std::string{arg});
+    }
+};
 
-                count -= space_remaining; // guaranteed to not underflow
-            }
-        }
+// boolean types ('bool')
+template <class T>
+struct Formatter<T, std::enable_if_t<Traits<T>::is_bool_v>> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const T& arg) const {
+        buffer.push_string(arg ? "true" : "false");
     }
 };
 
-// --- Timed buffering ---
-// -----------------------
+// integral types ('int', 'std::uint64_t', etc.)
+template <class T>
+struct Formatter<T, std::enable_if_t<Traits<T>::is_integer_v>> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const T& arg) const {
+        std::array<char, max_chars_int> res;
 
-template <class FlusherType>
-class Buffer<FlusherType, policy::Buffering::TIMED> {
-    FlusherType     flusher;
-    std::string     buffer;
-    Clock::duration last_flush_uptime{};
+        const std::size_t serialized = std::to_chars(res.data(), res.data() + res.size(), arg).ptr - res.data();
 
-    void flush() {
-        this->flusher.flush_string(this->buffer);
-
-        this->buffer.clear();
-        // standard doesn't guarantee that this doesn't reallocate (unlike 'std::vector<>'), however all
-        // existing implementations do the reasonable thing and don't reallocate so we can mostly rely on it
+        buffer.push_string(std::string_view{res.data(), serialized});
     }
+};
 
-public:
-    Buffer(FlusherType&& flusher) : flusher(std::move(flusher)) {}
+// floating-point types
+template <class T>
+struct Formatter<T, std::enable_if_t<Traits<T>::is_float_v>> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const T& arg) const {
+        std::array<char, max_chars_int> res;
 
-    Buffer(Buffer&& other)
-        : flusher(std::move(other).flusher), buffer(std::move(other).buffer),
-          last_flush_uptime(other.last_flush_uptime) {
-        other.buffer.clear(); // ensures moved-from buffer will not flush in destructor
-    }
+        const std::size_t serialized = std::to_chars(res.data(), res.data() + res.size(), arg).ptr - res.data();
 
-    ~Buffer() {
-        if (!this->buffer.empty()) this->flush();
+        buffer.push_string(std::string_view{res.data(), serialized});
     }
+};
 
-    void push_record(const Record& record) noexcept {
-        // retrieving timestamps is expensive, we can reuse the one already produced by the logger
+// 'std::complex'-like types
+template <class T>
+struct Formatter<T, std::enable_if_t<Traits<T>::is_complex_v>> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const T& arg) const {
+        const auto string_formatter = Formatter<std::string_view>{};
+        const auto value_formatter  = Formatter<decltype(arg.real())>{};
 
-        if (record.elapsed - this->last_flush_uptime > buffering_time) {
-            this->flush();
-            this->last_flush_uptime = record.elapsed;
+        value_formatter(buffer, arg.real());
+        if (arg.imag() >= 0) {
+            string_formatter(buffer, " + ");
+            value_formatter(buffer, arg.imag());
+        } else {
+            string_formatter(buffer, " - ");
+            value_formatter(buffer, -arg.imag());
         }
+        string_formatter(buffer, "i");
     }
-
-    void push_string(std::string_view sv) { this->buffer += sv; }
-
-    void push_chars(std::size_t count, char ch) { this->buffer.append(count, ch); }
 };
 
-// =========================
-// --- Component: Writer ---
-// =========================
-
-// --- Style configuration ---
-// ---------------------------
+// array-like types
+template <class T>
+struct Formatter<T, std::enable_if_t<Traits<T>::is_array_v>> {
+    static constexpr std::string_view prefix    = "[ ";
+    static constexpr std::string_view suffix    = " ]";
+    static constexpr std::string_view delimiter = ", ";
 
-namespace config {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const T& arg) const {
+        const auto string_formatter = Formatter<std::string_view>{};
+        const auto value_formatter  = Formatter<typename std::decay_t<T>::value_type>{};
 
-constexpr std::size_t width_thread        = 6;
-constexpr std::size_t width_uptime        = 8;
-constexpr std::size_t width_callsite_name = 24; // split used for file:line alignment
-constexpr std::size_t width_callsite_line = 4;
-constexpr std::size_t width_callsite      = width_callsite_name + 1 + width_callsite_line;
-constexpr std::size_t width_level         = 5;
-constexpr std::size_t width_message       = 30; // doesn't limit actual message size, used for separator width
+        string_formatter(buffer, prefix);
+        if (arg.begin() != arg.end()) {
+            for (auto it = arg.begin();;) {
+                value_formatter(buffer, *it);
+                if (++it == arg.end()) break; // prevents trailing comma
+                string_formatter(buffer, delimiter);
+            }
+        }
+        string_formatter(buffer, suffix);
+    }
+};
 
-constexpr std::string_view delimiter_front = "| ";
-constexpr std::string_view delimiter_mid   = " | ";
+// tuple-like types
+template <class T>
+struct Formatter<T, std::enable_if_t<Traits<T>::is_tuple_v>> {
+    static constexpr std::string_view prefix    = "< ";
+    static constexpr std::string_view suffix    = " >";
+    static constexpr std::string_view delimiter = ", ";
 
-constexpr std::string_view title_thread   = "thread";
-constexpr std::string_view title_uptime   = "  uptime";
-constexpr std::string_view title_callsite = "                     callsite";
-constexpr std::string_view title_level    = "level";
-constexpr std::string_view title_message  = "message";
+    template <class Buffer>
+    void operator()(Buffer& buffer, const T& arg) const {
+        const auto string_formatter = Formatter<std::string_view>{};
 
-constexpr std::string_view date_prefix = "date -> ";
+        string_formatter(buffer, prefix);
 
-constexpr char hline_fill = '-';
+        for_sequence(std::make_index_sequence<std::tuple_size_v<T>>{}, [&](auto index) {
+            const auto& element = std::get<index>(arg); // 'index' is an 'std::integral_constant<std::size_t, i>'
 
-constexpr std::string_view line_break = "\n";
+            if constexpr (index != 0) string_formatter(buffer, delimiter);
 
-constexpr std::string_view name_err   = "  ERR";
-constexpr std::string_view name_warn  = " WARN";
-constexpr std::string_view name_note  = " NOTE";
-constexpr std::string_view name_info  = " INFO";
-constexpr std::string_view name_debug = "DEBUG";
-constexpr std::string_view name_trace = "TRACE";
+            Formatter<std::tuple_element_t<index, T>>{}(buffer, element);
+        });
 
-constexpr std::string_view color_header = ansi::bold_cyan;
+        string_formatter(buffer, suffix);
+    }
+};
 
-constexpr std::string_view color_err   = ansi::bold_red;
-constexpr std::string_view color_warn  = ansi::yellow;
-constexpr std::string_view color_note  = ansi::magenta;
-constexpr std::string_view color_info  = ansi::white;
-constexpr std::string_view color_debug = ansi::green;
-constexpr std::string_view color_trace = ansi::bright_black;
+// container adaptor types
+template <class T>
+struct Formatter<T, std::enable_if_t<Traits<T>::is_adaptor_v>> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const T& arg) const {
+        const auto& ref = underlying_container_cref(arg);
 
-static_assert(width_thread == title_thread.size());
-static_assert(width_uptime == title_uptime.size());
-static_assert(width_callsite == title_callsite.size());
-static_assert(width_level == title_level.size());
-static_assert(width_message > title_message.size());
+        Formatter<std::decay_t<decltype(ref)>>{}(buffer, ref);
+    }
+};
 
-static_assert(width_level == name_trace.size());
-static_assert(width_level == name_debug.size());
-static_assert(width_level == name_info.size());
-static_assert(width_level == name_note.size());
-static_assert(width_level == name_warn.size());
-static_assert(width_level == name_err.size());
+// <chrono> types
+template <class T>
+struct Formatter<T, std::enable_if_t<Traits<T>::is_duration_v>> {
+    constexpr static std::size_t relevant_units = 3;
 
-} // namespace config
+    constexpr static std::array<std::string_view, SplitDuration::size> names = {"hours", "min", "sec",
+                                                                                "ms",    "us",  "ns"};
 
-// --- Component ---
-// -----------------
+    template <class Buffer>
+    void operator()(Buffer& buffer, const T& arg) const {
 
-// Component that wraps 'Formatter' with sink-specific formatting
+        auto string_formatter  = Formatter<std::string_view>{};
+        auto integer_formatter = Formatter<SplitDuration::common_rep>{};
 
-template <class BufferType, policy::Level level, policy::Color color, policy::Format format>
-struct Writer {
-private:
-    BufferType buffer;
+        // Takes 'unit_count' of the highest relevant units and converts them to string,
+        // for example with 'unit_count' equal to '3', we will have:
+        //
+        // timescale <= hours   =>   show { hours, min, sec }   =>   string "___ hours ___ min ___ sec"
+        // timescale <= min     =>   show {   min, sec,  ms }   =>   string "___ min ___ sec ___ ms"
+        // timescale <= sec     =>   show {   sec,  ms,  us }   =>   string "___ sec ___ ms ___ us"
+        // timescale <= ms      =>   show {    ms,  us,  ns }   =>   string "___ ms ___ us ___ ns"
+        // timescale <= us      =>   show {    us,  ns      }   =>   string "___ us ___ ns"
+        // timescale <= ns      =>   show {    ns           }   =>   string "___ ns"
 
-    constexpr static bool has_color = color == policy::Color::ANSI;
+        const std::array<SplitDuration::common_rep, SplitDuration::size> counts = unit_split(arg).count();
 
-    constexpr static bool format_date  = to_bool(format & policy::Format::DATE);
-    constexpr static bool format_title = to_bool(format & policy::Format::TITLE);
+        for (std::size_t unit = 0; unit < counts.size(); ++unit) {
+            if (counts[unit]) {
+                const std::size_t last =
+                    (unit + relevant_units < counts.size()) ? (unit + relevant_units) : counts.size();
+                // don't want to include the whole <algorithm> just for 'std::max()'
 
-    constexpr static auto delimiter_date = config::delimiter_front;
+                for (std::size_t k = unit; k < last; ++k) {
+                    integer_formatter(buffer, counts[k]);
+                    string_formatter(buffer, " ");
+                    string_formatter(buffer, names[k]);
+                    if (k + 1 != last) string_formatter(buffer, " "); // prevents trailing space at the end
+                }
+                return;
+            }
+        }
 
-    constexpr static bool format_thread   = to_bool(format & policy::Format::THREAD);
-    constexpr static bool format_uptime   = to_bool(format & policy::Format::UPTIME);
-    constexpr static bool format_callsite = to_bool(format & policy::Format::CALLSITE);
-    constexpr static bool format_level    = to_bool(format & policy::Format::LEVEL);
-    constexpr static bool format_message  = true;
+        string_formatter(buffer, "0 ns"); // fallback, unlikely to ever be triggered
+    }
+};
 
-    constexpr static bool front_is_thread   = format_thread;
-    constexpr static bool front_is_uptime   = format_uptime && !front_is_thread;
-    constexpr static bool front_is_callsite = format_callsite && !front_is_thread && !front_is_uptime;
-    constexpr static bool front_is_level = format_level && !front_is_thread && !front_is_uptime && !front_is_callsite;
-    constexpr static bool front_is_message =
-        format_message && !front_is_thread && !front_is_uptime && !front_is_callsite && !front_is_level;
+// printable types
+template <class T>
+struct Formatter<T, std::enable_if_t<Traits<T>::is_printable_v>> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const T& arg) const {
+        buffer.push_string((std::ostringstream{} << arg).str());
+        // creating a string stream every time is slow, but there is no way around it,
+        // this is simply a flaw of streams as a design
+    }
+};
 
-    constexpr static auto delimiter_thread   = front_is_thread ? config::delimiter_front : config::delimiter_mid;
-    constexpr static auto delimiter_uptime   = front_is_uptime ? config::delimiter_front : config::delimiter_mid;
-    constexpr static auto delimiter_callsite = front_is_callsite ? config::delimiter_front : config::delimiter_mid;
-    constexpr static auto delimiter_level    = front_is_level ? config::delimiter_front : config::delimiter_mid;
-    constexpr static auto delimiter_message  = front_is_message ? config::delimiter_front : config::delimiter_mid;
+// 'FormattedFloat<T>' types
+template <class T>
+struct Formatter<FormattedFloat<T>, std::enable_if_t<Traits<T>::is_float_v>> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const FormattedFloat<T>& arg) const {
+        std::array<char, max_chars_int> res;
 
-    void write_thread() {
-        using styled_type     = AlignedLeft<int>;
-        const styled_type arg = this_thread_linear_id() | align_left(config::width_thread);
+        const std::size_t serialized =
+            std::to_chars(res.data(), res.data() + res.size(), arg.value, arg.mod.format, arg.mod.precision).ptr -
+            res.data();
 
-        Formatter<styled_type>{}(this->buffer, arg);
+        buffer.push_string(std::string_view{res.data(), serialized});
     }
+};
 
-    void write_uptime(const Record& record) {
-        using styled_type     = AlignedRight<FormattedFloat<double>>;
-        const styled_type arg = Sec(record.elapsed).count() | fixed(2) | align_right(config::width_uptime);
+// 'FormattedInteger<T>' types
+template <class T>
+struct Formatter<FormattedInteger<T>, std::enable_if_t<Traits<T>::is_integer_v>> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const FormattedInteger<T>& arg) const {
+        std::array<char, max_chars_int> res;
 
-        Formatter<styled_type>{}(this->buffer, arg);
-    }
+        const std::size_t serialized =
+            std::to_chars(res.data(), res.data() + res.size(), arg.value, arg.mod.base).ptr - res.data();
 
-    void write_callsite([[maybe_unused]] const Record& record) {
-        using styled_file      = AlignedRight<const std::string_view&>;
-        const styled_file file = record.file | align_right(config::width_callsite_name);
+        buffer.push_string(std::string_view{res.data(), serialized});
+    }
+};
 
-        using styled_line      = AlignedLeft<const std::size_t&>;
-        const styled_line line = record.line | align_left(config::width_callsite_line);
+// 'AlignedLeft<T>' types
+template <class T>
+struct Formatter<AlignedLeft<T>, void> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const AlignedLeft<T>& arg) const {
+        std::string& temp = thread_local_temporary_string();
+        StringBuffer temp_buffer(temp);
 
-        Formatter<styled_file>{}(this->buffer, file);
-        Formatter<char>{}(this->buffer, ':');
-        Formatter<styled_line>{}(this->buffer, line);
-    }
+        Formatter<T>{}(temp_buffer, arg.value);
 
-    template <policy::Level message_level>
-    void write_level() {
-        // clang-format off
-        if constexpr (message_level == policy::Level::ERR  ) this->buffer.push_string(config::name_err  );
-        if constexpr (message_level == policy::Level::WARN ) this->buffer.push_string(config::name_warn );
-        if constexpr (message_level == policy::Level::NOTE ) this->buffer.push_string(config::name_note );
-        if constexpr (message_level == policy::Level::INFO ) this->buffer.push_string(config::name_info );
-        if constexpr (message_level == policy::Level::DEBUG) this->buffer.push_string(config::name_debug);
-        if constexpr (message_level == policy::Level::TRACE) this->buffer.push_string(config::name_trace);
-        // clang-format on
-    }
+        const std::size_t size_no_pad   = temp.size();
+        const std::size_t size_with_pad = max(arg.mod.size, size_no_pad);
+        const std::size_t right_pad     = size_with_pad - size_no_pad;
 
-    template <policy::Level message_level>
-    void write_color_message() {
-        // clang-format off
-        if constexpr (message_level == policy::Level::ERR  ) this->buffer.push_string(config::color_err  );
-        if constexpr (message_level == policy::Level::WARN ) this->buffer.push_string(config::color_warn );
-        if constexpr (message_level == policy::Level::NOTE ) this->buffer.push_string(config::color_note );
-        if constexpr (message_level == policy::Level::INFO ) this->buffer.push_string(config::color_info );
-        if constexpr (message_level == policy::Level::DEBUG) this->buffer.push_string(config::color_debug);
-        if constexpr (message_level == policy::Level::TRACE) this->buffer.push_string(config::color_trace);
-        // clang-format on
+        buffer.push_string(temp);
+        buffer.push_chars(right_pad, ' ');
     }
+};
 
-    void write_color_header() { this->buffer.push_string(config::color_header); }
+// 'AlignedCenter<T>' types
+template <class T>
+struct Formatter<AlignedCenter<T>, void> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const AlignedCenter<T>& arg) const {
+        std::string& temp = thread_local_temporary_string();
+        StringBuffer temp_buffer(temp);
 
-    void write_color_reset() { this->buffer.push_string(ansi::reset); }
+        Formatter<T>{}(temp_buffer, arg.value);
 
-    template <policy::Level message_level, class T>
-    void write_arg(const T& arg) {
-        Formatter<T>{}(this->buffer, arg);
+        const std::size_t size_no_pad   = temp.size();
+        const std::size_t size_with_pad = max(arg.mod.size, size_no_pad);
+        const std::size_t left_pad      = (size_with_pad - size_no_pad) / 2;
+        const std::size_t right_pad     = size_with_pad - size_no_pad - left_pad;
+
+        buffer.push_chars(left_pad, ' ');
+        buffer.push_string(temp);
+        buffer.push_chars(right_pad, ' ');
     }
+};
 
-    // Color modifier requires special handling at the logger level since we need to properly escape & restore
-    // current logging level color. This wouldn't be required if ANSI codes could be nested.
-    template <policy::Level message_level, class T>
-    void write_arg(const Colored<T>& arg) {
-        // Switch to message color
-        if constexpr (has_color) this->write_color_reset();
-        if constexpr (has_color) this->buffer.push_string(arg.mod.code);
+// 'AlignedRight<T>' types
+template <class T>
+struct Formatter<AlignedRight<T>, void> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const AlignedRight<T>& arg) const {
+        std::string& temp = thread_local_temporary_string();
+        StringBuffer temp_buffer(temp);
 
-        this->write_arg<message_level>(arg.value);
+        Formatter<T>{}(temp_buffer, arg.value);
 
-        // Restore logger color
-        if constexpr (has_color) this->buffer.push_string(ansi::reset);
-        if constexpr (has_color) this->write_color_message<message_level>();
-    }
+        const std::size_t size_no_pad   = temp.size();
+        const std::size_t size_with_pad = max(arg.mod.size, size_no_pad);
+        const std::size_t left_pad      = size_with_pad - size_no_pad;
 
-    void write_header_datetime() {
-        this->buffer.push_string(config::delimiter_front);
-        this->buffer.push_string(config::date_prefix);
-        this->buffer.push_string(datetime_string());
-        this->buffer.push_string(config::line_break);
+        buffer.push_chars(left_pad, ' ');
+        buffer.push_string(temp);
     }
+};
 
-    void write_header_separator() {
-        if constexpr (format_thread) this->buffer.push_string(delimiter_thread);
-        if constexpr (format_thread) this->buffer.push_chars(config::width_thread, config::hline_fill);
-        if constexpr (format_uptime) this->buffer.push_string(delimiter_uptime);
-        if constexpr (format_uptime) this->buffer.push_chars(config::width_uptime, config::hline_fill);
-        if constexpr (format_callsite) this->buffer.push_string(delimiter_callsite);
-        if constexpr (format_callsite) this->buffer.push_chars(config::width_callsite, config::hline_fill);
-        if constexpr (format_level) this->buffer.push_string(delimiter_level);
-        if constexpr (format_level) this->buffer.push_chars(config::width_level, config::hline_fill);
-        this->buffer.push_string(delimiter_message);
-        this->buffer.push_chars(config::width_message, config::hline_fill);
-        this->buffer.push_string(config::line_break);
+// 'Colored<T>' types
+template <class T>
+struct Formatter<Colored<T>, void> {
+    template <class Buffer>
+    void operator()(Buffer& buffer, const Colored<T>& arg) const {
+        buffer.push_string(arg.mod.code);
+        Formatter<T>{}(buffer, arg.value);
+        buffer.push_string(ansi::reset);
     }
+};
 
-    void write_header_hline() {
-        constexpr std::size_t w_thread   = format_thread ? (config::width_thread + delimiter_thread.size()) : 0;
-        constexpr std::size_t w_uptime   = format_uptime ? (config::width_uptime + delimiter_uptime.size()) : 0;
-        constexpr std::size_t w_callsite = format_callsite ? (config::width_callsite + delimiter_callsite.size()) : 0;
-        constexpr std::size_t w_level    = format_level ? (config::width_level + delimiter_level.size()) : 0;
-        constexpr std::size_t w_message  = config::width_message + delimiter_message.size();
+// ==============
+// --- Logger ---
+// ==============
 
-        constexpr std::size_t hline_total =
-            w_thread + w_uptime + w_callsite + w_level + w_message - config::delimiter_front.size();
+// Class layout:
+//
+//    Logger               | Input: Message    | Output: Message    | - Captures meta, forwards message to all sinks
+//    -> tuple<Sink, ...>
+//
+//    Sink                 | Input: Message    | Output: Message    | - Wraps underlying API & provides defaults
+//    -> Protector         | Input: Message    | Output: Message    | - Handles safe/unsafe threading
+//       -> Writer         | Input: Message    | Output: Log string | - Handles message formatting
+//         -> Buffer       | Input: Log string | Output: Log string | - Handles instant/fixed/timed buffering
+//            -> Flusher   | Input: Log string | Output: Log string | - Handles sync/async flushing
+//               -> Output | Input: Log string | Output: Log string | - Wraps underlying IO output
+//
+// Specific instances of all listed components depend on specializations selected though policies.
 
-        this->buffer.push_string(config::delimiter_front);
-        this->buffer.push_chars(hline_total, config::hline_fill);
-        this->buffer.push_string(config::line_break);
-    }
+// --- Message metadata ---
+// ------------------------
 
-    void write_header_title() {
-        if constexpr (format_thread) this->buffer.push_string(delimiter_thread);
-        if constexpr (format_thread) this->buffer.push_string(config::title_thread);
-        if constexpr (format_uptime) this->buffer.push_string(delimiter_uptime);
-        if constexpr (format_uptime) this->buffer.push_string(config::title_uptime);
-        if constexpr (format_callsite) this->buffer.push_string(delimiter_callsite);
-        if constexpr (format_callsite) this->buffer.push_string(config::title_callsite);
-        if constexpr (format_level) this->buffer.push_string(delimiter_level);
-        if constexpr (format_level) this->buffer.push_string(config::title_level);
-        this->buffer.push_string(delimiter_message);
-        this->buffer.push_string(config::title_message);
-        this->buffer.push_string(config::line_break);
-    }
+using Clock = std::chrono::steady_clock;
 
-    void write_header() {
-        // Start color
-        if constexpr (has_color) this->write_color_header();
+// Metadata associated with a logging record, generated once by the 'Logger' and distributed to all sinks
+struct Record {
+    Clock::duration  elapsed;
+    std::string_view file;
+    std::size_t      line;
+};
 
-        if constexpr (format_date) {
-            this->write_header_hline();
-            this->write_header_datetime();
-            this->write_header_separator();
-        }
+// --- Policies ---
+// ----------------
 
-        if constexpr (format_title) {
-            this->write_header_title();
-            this->write_header_separator();
-        }
+namespace policy {
 
-        // End color
-        if constexpr (has_color) this->write_color_reset();
-    }
+enum class Type { FILE, STREAM };
 
-    template <policy::Level message_level, class... Args>
-    void write_message(const Record& record, const Args&... args) {
-        // Start color
-        if constexpr (has_color) this->write_color_message<message_level>();
+enum class Level { ERR = 0, WARN = 1, NOTE = 2, INFO = 3, DEBUG = 4, TRACE = 5 };
 
-        // Format info & message
-        if constexpr (format_thread) this->buffer.push_string(delimiter_thread);
-        if constexpr (format_thread) this->write_thread();
-        if constexpr (format_uptime) this->buffer.push_string(delimiter_uptime);
-        if constexpr (format_uptime) this->write_uptime(record);
-        if constexpr (format_callsite) this->buffer.push_string(delimiter_callsite);
-        if constexpr (format_callsite) this->write_callsite(record);
-        if constexpr (format_level) this->buffer.push_string(delimiter_level);
-        if constexpr (format_level) this->write_level<message_level>();
+enum class Color { NONE, ANSI };
 
-        this->buffer.push_string(delimiter_message);
-        (this->write_arg<message_level>(args), ...);
-        this->buffer.push_string(config::line_break);
+enum class Format {
+    DATE     = 1 << 0,
+    TITLE    = 1 << 1,
+    THREAD   = 1 << 2,
+    UPTIME   = 1 << 3,
+    CALLSITE = 1 << 4,
+    LEVEL    = 1 << 5,
+    NONE     = 0,
+    FULL     = DATE | TITLE | THREAD | UPTIME | CALLSITE | LEVEL
+}; // bitmask enum
 
-        // Notify buffer of the record metadata it can potentially use
-        this->buffer.push_record(record);
+[[nodiscard]] constexpr Format operator|(Format a, Format b) noexcept {
+    return static_cast<Format>(to_underlying(a) | to_underlying(b));
+}
 
-        // End color
-        if constexpr (has_color) this->write_color_reset();
-    }
+[[nodiscard]] constexpr Format operator&(Format a, Format b) noexcept {
+    return static_cast<Format>(to_underlying(a) & to_underlying(b));
+}
 
-public:
-    Writer(BufferType&& buffer) : buffer(std::move(buffer)) {}
+enum class Buffering { NONE, FIXED, TIMED };
 
-    void header() {
-        if constexpr (format_date || format_title) this->write_header();
-    }
+enum class Flushing { SYNC, ASYNC };
 
-    template <policy::Level message_level, class... Args>
-    void message([[maybe_unused]] const Record& record, [[maybe_unused]] const Args&... args) {
-        if constexpr (message_level <= level) this->write_message<message_level>(record, args...);
-        // Note: Both '[[maybe_unused]]' and splitting 'write_message()' into a separate method are
-        //       necessary to prevent MSVC from complaining about unused code at W4 warning level
-        //       in cases where this methods should intentionally compile to nothing.
-    }
-};
+enum class Threading { UNSAFE, SAFE };
 
-// ============================
-// --- Component: Protector ---
-// ============================
+} // namespace policy
 
-template <class WriterType, policy::Threading>
-class Protector;
+// =========================
+// --- Component: Output ---
+// =========================
 
-// --- Thread-unsafe writing ---
-// -----------------------------
+template <policy::Type type>
+class Output;
 
-template <class WriterType>
-class Protector<WriterType, policy::Threading::UNSAFE> {
-    WriterType writer;
+// --- File output ---
+// -------------------
 
-public:
-    Protector(WriterType&& writer) : writer(std::move(writer)) {}
+template <>
+class Output<policy::Type::FILE> {
+    std::ofstream file;
 
-    void header() { this->writer.header(); }
+public:
+    Output(const std::string& name) : file(name) {}
+    Output(std::ofstream&& file) : file(std::move(file)) {}
 
-    template <policy::Level message_level, class... Args>
-    void message(const Record& record, const Args&... args) {
-        this->writer.template message<message_level>(record, args...);
+    void flush_string(std::string_view sv) {
+        this->file.write(sv.data(), sv.size());
+        this->file.flush();
+    }
+
+    void flush_chars(std::size_t count, char ch) {
+        std::ostreambuf_iterator<char> first(this->file);
+        for (std::size_t i = 0; i < count; ++i) first = ch;
+        // fastest way of writing N chars to a stream, 'std::ostreambuf_iterator' writes character to a stream
+        // when assigned, dereference/increment is no-op making it rather strange for an "iterator"
     }
 };
 
-// --- Thread-safe writing ---
-// ---------------------------
+// --- Stream output ---
+// ---------------------
 
-template <class WriterType>
-class Protector<WriterType, policy::Threading::SAFE> {
-    WriterType writer;
-    std::mutex mutex;
+template <>
+class Output<policy::Type::STREAM> {
+    std::ostream& os;
 
 public:
-    Protector(WriterType&& writer) : writer(std::move(writer)) {}
-
-    Protector(Protector&& other) : writer(std::move(other.writer)) {}
-    // we assume move to be thread-safe since it should only be done in logger constructor which is thread-safe
-    // by itself due being either 'static' or function-local, otherwise we'd need to lock 'other.mutex'
+    Output(std::ostream& os) noexcept : os(os) {}
 
-    void header() { this->writer.header(); }
+    void flush_string(std::string_view sv) {
+        this->os.write(sv.data(), sv.size());
+        this->os.flush();
+    }
 
-    template <policy::Level message_level, class... Args>
-    void message(const Record& record, const Args&... args) {
-        const std::lock_guard lock(this->mutex);
-        this->writer.template message<message_level>(record, args...);
+    void flush_chars(std::size_t count, char ch) {
+        std::ostreambuf_iterator<char> first(this->os);
+        for (std::size_t i = 0; i < count; ++i) first = ch;
+        // fastest way of writing N chars to a stream, 'std::ostreambuf_iterator' writes character to a stream
+        // when assigned, dereference/increment is no-op making it a rather strange case of an "iterator"
     }
 };
 
-// =======================
-// --- Component: Sink ---
-// =======================
+// ==========================
+// --- Component: Flusher ---
+// ==========================
 
-// Component that wraps all the previous components into a public API with defaults & CTAD
+template <class OutputType, policy::Flushing flushing>
+class Flusher;
 
-// clang-format off
-template <
-    policy::Type      type,
-    policy::Level     level     = (type == policy::Type::STREAM) ? policy::Level::INFO : policy::Level::TRACE,
-    policy::Color     color     = (type == policy::Type::STREAM) ? policy::Color::ANSI : policy::Color::NONE,
-    policy::Format    format    = policy::Format::FULL,
-    policy::Buffering buffering = (type == policy::Type::STREAM) ? policy::Buffering::NONE : policy::Buffering::FIXED,
-    policy::Flushing  flushing  = policy::Flushing::SYNC,
-    policy::Threading threading = policy::Threading::SAFE
->
-// clang-format on
-class Sink {
-    using output_type    = Output<type>;
-    using flusher_type   = Flusher<output_type, flushing>;
-    using buffer_type    = Buffer<flusher_type, buffering>;
-    using writer_type    = Writer<buffer_type, level, color, format>;
-    using protector_type = Protector<writer_type, threading>;
+// --- Synchonous flushing ---
+// ---------------------------
 
-    protector_type protector;
+template <class OutputType>
+class Flusher<OutputType, policy::Flushing::SYNC> {
+    OutputType output;
 
 public:
-    Sink(protector_type&& protector) : protector(std::move(protector)) {}
-
-    void header() { this->protector.header(); }
+    Flusher(OutputType&& output) : output(std::move(output)) {}
 
-    template <policy::Level message_level, class... Args>
-    void message(const Record& record, const Args&... args) {
-        this->protector.template message<message_level>(record, args...);
-    }
+    void flush_string(std::string_view sv) { this->output.flush_string(sv); }
 
-    // Stream sink preset
-    Sink(std::ostream& os) : Sink(protector_type(writer_type(buffer_type(flusher_type(output_type(os)))))) {}
-    // File sink preset
-    Sink(std::ofstream&& file)
-        : Sink(protector_type(writer_type(buffer_type(flusher_type(output_type(std::move(file))))))) {}
-    Sink(std::string_view name)
-        : Sink(protector_type(writer_type(buffer_type(flusher_type(output_type(std::string(name))))))) {}
+    void flush_chars(std::size_t count, char ch) { this->output.flush_chars(count, ch); }
 };
 
-// CTAD for presets
-Sink(std::ostream&) -> Sink<policy::Type::STREAM>;
-Sink(std::ofstream&&) -> Sink<policy::Type::FILE>;
-Sink(std::string_view) -> Sink<policy::Type::FILE>;
+// --- Async flushing ---
+// ----------------------
 
-// =========================
-// --- Component: Logger ---
-// =========================
+template <class OutputType>
+class Flusher<OutputType, policy::Flushing::ASYNC> {
+    OutputType output; // destruction order matters here, 'output' should be available until 'worker' thread joins
 
-// --- Codegen macros ---
-// ----------------------
+    std::unique_ptr<WorkerThread> worker = std::make_unique<WorkerThread>();
 
-// Since we want to have macro-free API on the user side, the only way of capturing callsite is
-// 'std::source_location' or its re-implementation. The only way to capture callsite with such class
-// in C++17 is by using it as a defaulted function parameter, however we cannot have defaulted parameters
-// after a variadic pack (which is what logging functions accept).
-//
-// Some loggers that use global logging functions work around this by replacing such functions with class constructor,
-// that use special CTAD to omit the need to pass source location. However, we cannot use this with a local logger API
-// without making it weird for the user. The only way to achieve the desired regular syntax is to manually provide
-// overloads for every number of arguments up to a certain large N. Since doing that truly manually would require
-// an unreasonable amount of code repetition, we use macros to generate those function with preprocessor.
-//
-// This is truly horrible, but sacrifices must be made if we want a nice user API.
-//
-// Such codegen could also be implemented in a more concise way using map-macro, however this adds a lot of
-// nested preprocessing which bloats the compile time and slows down LSPs, so we use simple & shallow macros
-// even through it requires more boilerplate on the use site, this results in no measurable slowdown.
+public:
+    Flusher(OutputType&& output) : output(std::move(output)) {}
 
-#define utl_log_hold(...) __VA_ARGS__
+    Flusher(Flusher&& other) : output(std::move(other.output)), worker(std::move(other.worker)) {}
 
-#define utl_log_member_alias(template_params_, function_params_, args_)                                                \
-    template <template_params_>                                                                                        \
-    void err(function_params_, SourceLocation location = SourceLocation::current()) {                                  \
-        this->message<policy::Level::ERR>(location, args_);                                                            \
-    }                                                                                                                  \
-    template <template_params_>                                                                                        \
-    void warn(function_params_, SourceLocation location = SourceLocation::current()) {                                 \
-        this->message<policy::Level::WARN>(location, args_);                                                           \
-    }                                                                                                                  \
-    template <template_params_>                                                                                        \
-    void note(function_params_, SourceLocation location = SourceLocation::current()) {                                 \
-        this->message<policy::Level::NOTE>(location, args_);                                                           \
-    }                                                                                                                  \
-    template <template_params_>                                                                                        \
-    void info(function_params_, SourceLocation location = SourceLocation::current()) {                                 \
-        this->message<policy::Level::INFO>(location, args_);                                                           \
-    }                                                                                                                  \
-    template <template_params_>                                                                                        \
-    void debug(function_params_, SourceLocation location = SourceLocation::current()) {                                \
-        this->message<policy::Level::DEBUG>(location, args_);                                                          \
-    }                                                                                                                  \
-    template <template_params_>                                                                                        \
-    void trace(function_params_, SourceLocation location = SourceLocation::current()) {                                \
-        this->message<policy::Level::TRACE>(location, args_);                                                          \
+    void flush_string(std::string_view sv) {
+        this->worker->detached_task([&out = output, str = std::string(sv)]() { out.flush_string(str); });
+
+        // Note 1: The buffer might be mutated while the other thread flushes it, we have to pass a copy
+        // Note 2: 'std::bind' doesn't bind reference arguments, we have to add a wrapper with 'std::ref'
     }
 
-#define utl_log_function_alias(template_params_, function_params_, args_)                                              \
-    template <template_params_>                                                                                        \
-    void err(function_params_, SourceLocation location = SourceLocation::current()) {                                  \
-        default_logger().err(args_, location);                                                                         \
-    }                                                                                                                  \
-    template <template_params_>                                                                                        \
-    void warn(function_params_, SourceLocation location = SourceLocation::current()) {                                 \
-        default_logger().warn(args_, location);                                                                        \
-    }                                                                                                                  \
-    template <template_params_>                                                                                        \
-    void note(function_params_, SourceLocation location = SourceLocation::current()) {                                 \
-        default_logger().note(args_, location);                                                                        \
-    }                                                                                                                  \
-    template <template_params_>                                                                                        \
-    void info(function_params_, SourceLocation location = SourceLocation::current()) {                                 \
-        default_logger().info(args_, location);                                                                        \
-    }                                                                                                                  \
-    template <template_params_>                                                                                        \
-    void debug(function_params_, SourceLocation location = SourceLocation::current()) {                                \
-        default_logger().debug(args_, location);                                                                       \
-    }                                                                                                                  \
-    template <template_params_>                                                                                        \
-    void trace(function_params_, SourceLocation location = SourceLocation::current()) {                                \
-        default_logger().trace(args_, location);                                                                       \
+    void flush_chars(std::size_t count, char ch) {
+        this->worker->detached_task([&out = output, count, ch] { out.flush_chars(count, ch); });
     }
+};
 
-// --- Component ---
-// -----------------
+// =========================
+// --- Component: Buffer ---
+// =========================
 
-// Component that wraps a number of sinks and distributes records to them
+template <class FlusherType, policy::Buffering buffering>
+class Buffer;
 
-template <class... Sinks>
-class Logger {
-    std::tuple<Sinks...> sinks;
-    Clock::time_point    creation_time_point = Clock::now();
+// --- Instant buffering ---
+// -------------------------
 
-    template <policy::Level message_level, class... Args>
-    void message(SourceLocation location, const Args&... args) {
-        // Get record info
-        Record record;
-        record.elapsed = Clock::now() - this->creation_time_point;
+template <class FlusherType>
+class Buffer<FlusherType, policy::Buffering::NONE> {
+    FlusherType flusher;
 
-        std::string_view path = location.function_name();
+public:
+    Buffer(FlusherType&& flusher) : flusher(std::move(flusher)) {}
 
-        record.file = path.substr(path.find_last_of("\\/") + 1);
-        record.line = static_cast<std::size_t>(location.line());
+    void push_record(const Record&) const noexcept {} // only matters for timed buffer
 
-        // Note 1: Even if there is nothing to trim, the 'file' will be correct due to the 'npos + 1 == 0' wrap-around
+    void push_string(std::string_view sv) { this->flusher.flush_string(sv); }
 
-        // Note 2: We have no choice, but to evaluate 'std::source_location' at runtime due to a deficiency in its
-        //         design. In C++20 we do get potential constexpr source location through non-type template parameters,
-        //         but even we have to implement a custom source location using compiler build-ins since standard one
-        //         doesn't work as a non-type parameter.
+    void push_chars(std::size_t count, char ch) { this->flusher.flush_chars(count, ch); }
+};
 
-        // Forward record & message to every sink
-        tuple_for_each(this->sinks, [&](auto&& sink) { sink.template message<message_level>(record, args...); });
-    }
+// --- Fixed buffering ---
+// -----------------------
+
+template <class FlusherType>
+class Buffer<FlusherType, policy::Buffering::FIXED> {
+    constexpr static std::size_t size = buffering_size;
+
+    FlusherType            flusher;
+    std::array<char, size> buffer{};
+    std::size_t            cursor{};
 
 public:
-    Logger(Sinks&&... sinks) : sinks(std::move(sinks)...) {
-        tuple_for_each(this->sinks, [&](auto&& sink) { sink.header(); }); // [Important!]
-        // any buffer operations should happen AFTER the sink construction, since during construction
-        // buffer & output pointers can change, which would break the async case (single-threaded case is fine)
+    Buffer(FlusherType&& output) : flusher(std::move(output)) {}
+
+    // Buffered flusher need non-trivial destructor and move semantics to ensure correct flushing of
+    // the remaining buffer upon destruction. Moved-from buffer should not flush upon destruction.
+    Buffer(Buffer&& other) : flusher(std::move(other.flusher)), buffer(other.buffer), cursor(other.cursor) {
+        other.cursor = size;
     }
 
-    // Create err() / warn() / note() / info() / debug() / trace() for up to 18 arguments
-    // clang-format off
-    utl_log_member_alias( // 1
-        utl_log_hold(class A   ),
-        utl_log_hold(const A& a),
+    ~Buffer() {
+        if (this->cursor == size) return;
+
+        this->flusher.flush_string(std::string_view{this->buffer.data(), this->cursor});
+    }
+
+    void push_record(const Record&) const noexcept {} // only matters for timed buffer
+
+    void push_string(std::string_view sv) {
+        while (true) {
+            const std::size_t space_needed    = sv.size();
+            const std::size_t space_remaining = size - this->cursor;
+
+            // Fast path: Message fits into the buffer
+            if (space_needed <= space_remaining) {
+                for (std::size_t i = 0; i < space_needed; ++i) this->buffer[this->cursor + i] = sv[i];
+                this->cursor += space_needed;
+
+                return;
+            }
+            // Slow path: Message doesn't fit, need to flush
+            else {
+                for (std::size_t i = 0; i < space_remaining; ++i) this->buffer[this->cursor + i] = sv[i];
+                this->cursor = 0;
+                this->flusher.flush_string(std::string_view{this->buffer.data(), this->buffer.size()});
+
+                sv.remove_prefix(space_remaining);
+            }
+        }
+    }
+
+    void push_chars(std::size_t count, char ch) {
+        while (true) {
+            const std::size_t space_needed    = count;
+            const std::size_t space_remaining = size - this->cursor;
+
+            // Fast path: Message fits into the buffer
+            if (space_needed <= space_remaining) {
+                for (std::size_t i = 0; i < space_needed; ++i) this->buffer[this->cursor + i] = ch;
+                this->cursor += space_needed;
+
+                return;
+            }
+            // Slow path: Message doesn't fit, need to flush
+            else {
+                for (std::size_t i = 0; i < space_remaining; ++i) this->buffer[this->cursor + i] = ch;
+                this->cursor = 0;
+                this->flusher.flush_string(std::string_view{this->buffer.data(), this->buffer.size()});
+
+                count -= space_remaining; // guaranteed to not underflow
+            }
+        }
+    }
+};
+
+// --- Timed buffering ---
+// -----------------------
+
+template <class FlusherType>
+class Buffer<FlusherType, policy::Buffering::TIMED> {
+    FlusherType     flusher;
+    std::string     buffer;
+    Clock::duration last_flush_uptime{};
+
+    void flush() {
+        this->flusher.flush_string(this->buffer);
+
+        this->buffer.clear();
+        // standard doesn't guarantee that this doesn't reallocate (unlike 'std::vector<>'), however all
+        // existing implementations do the reasonable thing and don't reallocate so we can mostly rely on it
+    }
+
+public:
+    Buffer(FlusherType&& flusher) : flusher(std::move(flusher)) {}
+
+    Buffer(Buffer&& other)
+        : flusher(std::move(other).flusher), buffer(std::move(other).buffer),
+          last_flush_uptime(other.last_flush_uptime) {
+        other.buffer.clear(); // ensures moved-from buffer will not flush in destructor
+    }
+
+    ~Buffer() {
+        if (!this->buffer.empty()) this->flush();
+    }
+
+    void push_record(const Record& record) noexcept {
+        // retrieving timestamps is expensive, we can reuse the one already produced by the logger
+
+        if (record.elapsed - this->last_flush_uptime > buffering_time) {
+            this->flush();
+            this->last_flush_uptime = record.elapsed;
+        }
+    }
+
+    void push_string(std::string_view sv) { this->buffer += sv; }
+
+    void push_chars(std::size_t count, char ch) { this->buffer.append(count, ch); }
+};
+
+// =========================
+// --- Component: Writer ---
+// =========================
+
+// --- Style configuration ---
+// ---------------------------
+
+namespace config {
+
+constexpr std::size_t width_thread        = 6;
+constexpr std::size_t width_uptime        = 8;
+constexpr std::size_t width_callsite_name = 24; // split used for file:line alignment
+constexpr std::size_t width_callsite_line = 4;
+constexpr std::size_t width_callsite      = width_callsite_name + 1 + width_callsite_line;
+constexpr std::size_t width_level         = 5;
+constexpr std::size_t width_message       = 30; // doesn't limit actual message size, used for separator width
+
+constexpr std::string_view delimiter_front = "| ";
+constexpr std::string_view delimiter_mid   = " | ";
+
+constexpr std::string_view title_thread   = "thread";
+constexpr std::string_view title_uptime   = "  uptime";
+constexpr std::string_view title_callsite = "                     callsite";
+constexpr std::string_view title_level    = "level";
+constexpr std::string_view title_message  = "message";
+
+constexpr std::string_view date_prefix = "date -> ";
+
+constexpr char hline_fill = '-';
+
+constexpr std::string_view line_break = "\n";
+
+constexpr std::string_view name_err   = "  ERR";
+constexpr std::string_view name_warn  = " WARN";
+constexpr std::string_view name_note  = " NOTE";
+constexpr std::string_view name_info  = " INFO";
+constexpr std::string_view name_debug = "DEBUG";
+constexpr std::string_view name_trace = "TRACE";
+
+constexpr std::string_view color_header = ansi::bold_cyan;
+
+constexpr std::string_view color_err   = ansi::bold_red;
+constexpr std::string_view color_warn  = ansi::yellow;
+constexpr std::string_view color_note  = ansi::magenta;
+constexpr std::string_view color_info  = ansi::white;
+constexpr std::string_view color_debug = ansi::green;
+constexpr std::string_view color_trace = ansi::bright_black;
+
+static_assert(width_thread == title_thread.size());
+static_assert(width_uptime == title_uptime.size());
+static_assert(width_callsite == title_callsite.size());
+static_assert(width_level == title_level.size());
+static_assert(width_message > title_message.size());
+
+static_assert(width_level == name_trace.size());
+static_assert(width_level == name_debug.size());
+static_assert(width_level == name_info.size());
+static_assert(width_level == name_note.size());
+static_assert(width_level == name_warn.size());
+static_assert(width_level == name_err.size());
+
+} // namespace config
+
+// --- Component ---
+// -----------------
+
+// Component that wraps 'Formatter' with sink-specific formatting
+
+template <class BufferType, policy::Level level, policy::Color color, policy::Format format>
+struct Writer {
+private:
+    BufferType buffer;
+
+    constexpr static bool has_color = color == policy::Color::ANSI;
+
+    constexpr static bool format_date  = to_bool(format & policy::Format::DATE);
+    constexpr static bool format_title = to_bool(format & policy::Format::TITLE);
+
+    constexpr static auto delimiter_date = config::delimiter_front;
+
+    constexpr static bool format_thread   = to_bool(format & policy::Format::THREAD);
+    constexpr static bool format_uptime   = to_bool(format & policy::Format::UPTIME);
+    constexpr static bool format_callsite = to_bool(format & policy::Format::CALLSITE);
+    constexpr static bool format_level    = to_bool(format & policy::Format::LEVEL);
+    constexpr static bool format_message  = true;
+
+    constexpr static bool front_is_thread   = format_thread;
+    constexpr static bool front_is_uptime   = format_uptime && !front_is_thread;
+    constexpr static bool front_is_callsite = format_callsite && !front_is_thread && !front_is_uptime;
+    constexpr static bool front_is_level = format_level && !front_is_thread && !front_is_uptime && !front_is_callsite;
+    constexpr static bool front_is_message =
+        format_message && !front_is_thread && !front_is_uptime && !front_is_callsite && !front_is_level;
+
+    constexpr static auto delimiter_thread   = front_is_thread ? config::delimiter_front : config::delimiter_mid;
+    constexpr static auto delimiter_uptime   = front_is_uptime ? config::delimiter_front : config::delimiter_mid;
+    constexpr static auto delimiter_callsite = front_is_callsite ? config::delimiter_front : config::delimiter_mid;
+    constexpr static auto delimiter_level    = front_is_level ? config::delimiter_front : config::delimiter_mid;
+    constexpr static auto delimiter_message  = front_is_message ? config::delimiter_front : config::delimiter_mid;
+
+    void write_thread() {
+        using styled_type     = AlignedLeft<int>;
+        const styled_type arg = this_thread_linear_id() | align_left(config::width_thread);
+
+        Formatter<styled_type>{}(this->buffer, arg);
+    }
+
+    void write_uptime(const Record& record) {
+        using styled_type     = AlignedRight<FormattedFloat<double>>;
+        const styled_type arg = Sec(record.elapsed).count() | fixed(2) | align_right(config::width_uptime);
+
+        Formatter<styled_type>{}(this->buffer, arg);
+    }
+
+    void write_callsite([[maybe_unused]] const Record& record) {
+        using styled_file      = AlignedRight<const std::string_view&>;
+        const styled_file file = record.file | align_right(config::width_callsite_name);
+
+        using styled_line      = AlignedLeft<const std::size_t&>;
+        const styled_line line = record.line | align_left(config::width_callsite_line);
+
+        Formatter<styled_file>{}(this->buffer, file);
+        Formatter<char>{}(this->buffer, ':');
+        Formatter<styled_line>{}(this->buffer, line);
+    }
+
+    template <policy::Level message_level>
+    void write_level() {
+        // clang-format off
+        if constexpr (message_level == policy::Level::ERR  ) this->buffer.push_string(config::name_err  );
+        if constexpr (message_level == policy::Level::WARN ) this->buffer.push_string(config::name_warn );
+        if constexpr (message_level == policy::Level::NOTE ) this->buffer.push_string(config::name_note );
+        if constexpr (message_level == policy::Level::INFO ) this->buffer.push_string(config::name_info );
+        if constexpr (message_level == policy::Level::DEBUG) this->buffer.push_string(config::name_debug);
+        if constexpr (message_level == policy::Level::TRACE) this->buffer.push_string(config::name_trace);
+        // clang-format on
+    }
+
+    template <policy::Level message_level>
+    void write_color_message() {
+        // clang-format off
+        if constexpr (message_level == policy::Level::ERR  ) this->buffer.push_string(config::color_err  );
+        if constexpr (message_level == policy::Level::WARN ) this->buffer.push_string(config::color_warn );
+        if constexpr (message_level == policy::Level::NOTE ) this->buffer.push_string(config::color_note );
+        if constexpr (message_level == policy::Level::INFO ) this->buffer.push_string(config::color_info );
+        if constexpr (message_level == policy::Level::DEBUG) this->buffer.push_string(config::color_debug);
+        if constexpr (message_level == policy::Level::TRACE) this->buffer.push_string(config::color_trace);
+        // clang-format on
+    }
+
+    void write_color_header() { this->buffer.push_string(config::color_header); }
+
+    void write_color_reset() { this->buffer.push_string(ansi::reset); }
+
+    template <policy::Level message_level, class T>
+    void write_arg(const T& arg) {
+        Formatter<T>{}(this->buffer, arg);
+    }
+
+    // Color modifier requires special handling at the logger level since we need to properly escape & restore
+    // current logging level color. This wouldn't be required if ANSI codes could be nested.
+    template <policy::Level message_level, class T>
+    void write_arg(const Colored<T>& arg) {
+        // Switch to message color
+        if constexpr (has_color) this->write_color_reset();
+        if constexpr (has_color) this->buffer.push_string(arg.mod.code);
+
+        this->write_arg<message_level>(arg.value);
+
+        // Restore logger color
+        if constexpr (has_color) this->buffer.push_string(ansi::reset);
+        if constexpr (has_color) this->write_color_message<message_level>();
+    }
+
+    void write_header_datetime() {
+        this->buffer.push_string(config::delimiter_front);
+        this->buffer.push_string(config::date_prefix);
+        this->buffer.push_string(datetime_string());
+        this->buffer.push_string(config::line_break);
+    }
+
+    void write_header_separator() {
+        if constexpr (format_thread) this->buffer.push_string(delimiter_thread);
+        if constexpr (format_thread) this->buffer.push_chars(config::width_thread, config::hline_fill);
+        if constexpr (format_uptime) this->buffer.push_string(delimiter_uptime);
+        if constexpr (format_uptime) this->buffer.push_chars(config::width_uptime, config::hline_fill);
+        if constexpr (format_callsite) this->buffer.push_string(delimiter_callsite);
+        if constexpr (format_callsite) this->buffer.push_chars(config::width_callsite, config::hline_fill);
+        if constexpr (format_level) this->buffer.push_string(delimiter_level);
+        if constexpr (format_level) this->buffer.push_chars(config::width_level, config::hline_fill);
+        this->buffer.push_string(delimiter_message);
+        this->buffer.push_chars(config::width_message, config::hline_fill);
+        this->buffer.push_string(config::line_break);
+    }
+
+    void write_header_hline() {
+        constexpr std::size_t w_thread   = format_thread ? (config::width_thread + delimiter_thread.size()) : 0;
+        constexpr std::size_t w_uptime   = format_uptime ? (config::width_uptime + delimiter_uptime.size()) : 0;
+        constexpr std::size_t w_callsite = format_callsite ? (config::width_callsite + delimiter_callsite.size()) : 0;
+        constexpr std::size_t w_level    = format_level ? (config::width_level + delimiter_level.size()) : 0;
+        constexpr std::size_t w_message  = config::width_message + delimiter_message.size();
+
+        constexpr std::size_t hline_total =
+            w_thread + w_uptime + w_callsite + w_level + w_message - config::delimiter_front.size();
+
+        this->buffer.push_string(config::delimiter_front);
+        this->buffer.push_chars(hline_total, config::hline_fill);
+        this->buffer.push_string(config::line_break);
+    }
+
+    void write_header_title() {
+        if constexpr (format_thread) this->buffer.push_string(delimiter_thread);
+        if constexpr (format_thread) this->buffer.push_string(config::title_thread);
+        if constexpr (format_uptime) this->buffer.push_string(delimiter_uptime);
+        if constexpr (format_uptime) this->buffer.push_string(config::title_uptime);
+        if constexpr (format_callsite) this->buffer.push_string(delimiter_callsite);
+        if constexpr (format_callsite) this->buffer.push_string(config::title_callsite);
+        if constexpr (format_level) this->buffer.push_string(delimiter_level);
+        if constexpr (format_level) this->buffer.push_string(config::title_level);
+        this->buffer.push_string(delimiter_message);
+        this->buffer.push_string(config::title_message);
+        this->buffer.push_string(config::line_break);
+    }
+
+    void write_header() {
+        // Start color
+        if constexpr (has_color) this->write_color_header();
+
+        if constexpr (format_date) {
+            this->write_header_hline();
+            this->write_header_datetime();
+            this->write_header_separator();
+        }
+
+        if constexpr (format_title) {
+            this->write_header_title();
+            this->write_header_separator();
+        }
+
+        // End color
+        if constexpr (has_color) this->write_color_reset();
+    }
+
+    template <policy::Level message_level, class... Args>
+    void write_message(const Record& record, const Args&... args) {
+        // Start color
+        if constexpr (has_color) this->write_color_message<message_level>();
+
+        // Format info & message
+        if constexpr (format_thread) this->buffer.push_string(delimiter_thread);
+        if constexpr (format_thread) this->write_thread();
+        if constexpr (format_uptime) this->buffer.push_string(delimiter_uptime);
+        if constexpr (format_uptime) this->write_uptime(record);
+        if constexpr (format_callsite) this->buffer.push_string(delimiter_callsite);
+        if constexpr (format_callsite) this->write_callsite(record);
+        if constexpr (format_level) this->buffer.push_string(delimiter_level);
+        if constexpr (format_level) this->write_level<message_level>();
+
+        this->buffer.push_string(delimiter_message);
+        (this->write_arg<message_level>(args), ...);
+        this->buffer.push_string(config::line_break);
+
+        // Notify buffer of the record metadata it can potentially use
+        this->buffer.push_record(record);
+
+        // End color
+        if constexpr (has_color) this->write_color_reset();
+    }
+
+public:
+    Writer(BufferType&& buffer) : buffer(std::move(buffer)) {}
+
+    void header() {
+        if constexpr (format_date || format_title) this->write_header();
+    }
+
+    template <policy::Level message_level, class... Args>
+    void message([[maybe_unused]] const Record& record, [[maybe_unused]] const Args&... args) {
+        if constexpr (message_level <= level) this->write_message<message_level>(record, args...);
+        // Note: Both '[[maybe_unused]]' and splitting 'write_message()' into a separate method are
+        //       necessary to prevent MSVC from complaining about unused code at W4 warning level
+        //       in cases where this methods should intentionally compile to nothing.
+    }
+};
+
+// ============================
+// --- Component: Protector ---
+// ============================
+
+template <class WriterType, policy::Threading>
+class Protector;
+
+// --- Thread-unsafe writing ---
+// -----------------------------
+
+template <class WriterType>
+class Protector<WriterType, policy::Threading::UNSAFE> {
+    WriterType writer;
+
+public:
+    Protector(WriterType&& writer) : writer(std::move(writer)) {}
+
+    void header() { this->writer.header(); }
+
+    template <policy::Level message_level, class... Args>
+    void message(const Record& record, const Args&... args) {
+        this->writer.template message<message_level>(record, args...);
+    }
+};
+
+// --- Thread-safe writing ---
+// ---------------------------
+
+template <class WriterType>
+class Protector<WriterType, policy::Threading::SAFE> {
+    WriterType writer;
+    std::mutex mutex;
+
+public:
+    Protector(WriterType&& writer) : writer(std::move(writer)) {}
+
+    Protector(Protector&& other) : writer(std::move(other.writer)) {}
+    // we assume move to be thread-safe since it should only be done in logger constructor which is thread-safe
+    // by itself due being either 'static' or function-local, otherwise we'd need to lock 'other.mutex'
+
+    void header() { this->writer.header(); }
+
+    template <policy::Level message_level, class... Args>
+    void message(const Record& record, const Args&... args) {
+        const std::lock_guard lock(this->mutex);
+        this->writer.template message<message_level>(record, args...);
+    }
+};
+
+// =======================
+// --- Component: Sink ---
+// =======================
+
+// Component that wraps all the previous components into a public API with defaults & CTAD
+
+// clang-format off
+template <
+    policy::Type      type,
+    policy::Level     level     = (type == policy::Type::STREAM) ? policy::Level::INFO : policy::Level::TRACE,
+    policy::Color     color     = (type == policy::Type::STREAM) ? policy::Color::ANSI : policy::Color::NONE,
+    policy::Format    format    = policy::Format::FULL,
+    policy::Buffering buffering = (type == policy::Type::STREAM) ? policy::Buffering::NONE : policy::Buffering::FIXED,
+    policy::Flushing  flushing  = policy::Flushing::SYNC,
+    policy::Threading threading = policy::Threading::SAFE
+>
+// clang-format on
+class Sink {
+    using output_type    = Output<type>;
+    using flusher_type   = Flusher<output_type, flushing>;
+    using buffer_type    = Buffer<flusher_type, buffering>;
+    using writer_type    = Writer<buffer_type, level, color, format>;
+    using protector_type = Protector<writer_type, threading>;
+
+    protector_type protector;
+
+public:
+    Sink(protector_type&& protector) : protector(std::move(protector)) {}
+
+    void header() { this->protector.header(); }
+
+    template <policy::Level message_level, class... Args>
+    void message(const Record& record, const Args&... args) {
+        this->protector.template message<message_level>(record, args...);
+    }
+
+    // Stream sink preset
+    Sink(std::ostream& os) : Sink(protector_type(writer_type(buffer_type(flusher_type(output_type(os)))))) {}
+    // File sink preset
+    Sink(std::ofstream&& file)
+        : Sink(protector_type(writer_type(buffer_type(flusher_type(output_type(std::move(file))))))) {}
+    Sink(std::string_view name)
+        : Sink(protector_type(writer_type(buffer_type(flusher_type(output_type(std::string(name))))))) {}
+};
+
+// CTAD for presets
+Sink(std::ostream&) -> Sink<policy::Type::STREAM>;
+Sink(std::ofstream&&) -> Sink<policy::Type::FILE>;
+Sink(std::string_view) -> Sink<policy::Type::FILE>;
+
+// =========================
+// --- Component: Logger ---
+// =========================
+
+// --- Codegen macros ---
+// ----------------------
+
+// Since we want to have macro-free API on the user side, the only way of capturing callsite is
+// 'std::source_location' or its re-implementation. The only way to capture callsite with such class
+// in C++17 is by using it as a defaulted function parameter, however we cannot have defaulted parameters
+// after a variadic pack (which is what logging functions accept).
+//
+// Some loggers that use global logging functions work around this by replacing such functions with class constructor,
+// that use special CTAD to omit the need to pass source location. However, we cannot use this with a local logger API
+// without making it weird for the user. The only way to achieve the desired regular syntax is to manually provide
+// overloads for every number of arguments up to a certain large N. Since doing that truly manually would require
+// an unreasonable amount of code repetition, we use macros to generate those function with preprocessor.
+//
+// This is truly horrible, but sacrifices must be made if we want a nice user API.
+//
+// Such codegen could also be implemented in a more concise way using map-macro, however this adds a lot of
+// nested preprocessing which bloats the compile time and slows down LSPs, so we use simple & shallow macros
+// even through it requires more boilerplate on the use site, this results in no measurable slowdown.
+
+#define utl_log_hold(...) __VA_ARGS__
+
+#define utl_log_member_alias(template_params_, function_params_, args_)                                                \
+    template <template_params_>                                                                                        \
+    void err(function_params_, SourceLocation location = SourceLocation::current()) {                                  \
+        this->message<policy::Level::ERR>(location, args_);                                                            \
+    }                                                                                                                  \
+    template <template_params_>                                                                                        \
+    void warn(function_params_, SourceLocation location = SourceLocation::current()) {                                 \
+        this->message<policy::Level::WARN>(location, args_);                                                           \
+    }                                                                                                                  \
+    template <template_params_>                                                                                        \
+    void note(function_params_, SourceLocation location = SourceLocation::current()) {                                 \
+        this->message<policy::Level::NOTE>(location, args_);                                                           \
+    }                                                                                                                  \
+    template <template_params_>                                                                                        \
+    void info(function_params_, SourceLocation location = SourceLocation::current()) {                                 \
+        this->message<policy::Level::INFO>(location, args_);                                                           \
+    }                                                                                                                  \
+    template <template_params_>                                                                                        \
+    void debug(function_params_, SourceLocation location = SourceLocation::current()) {                                \
+        this->message<policy::Level::DEBUG>(location, args_);                                                          \
+    }                                                                                                                  \
+    template <template_params_>                                                                                        \
+    void trace(function_params_, SourceLocation location = SourceLocation::current()) {                                \
+        this->message<policy::Level::TRACE>(location, args_);                                                          \
+    }
+
+#define utl_log_function_alias(template_params_, function_params_, args_)                                              \
+    template <template_params_>                                                                                        \
+    void err(function_params_, SourceLocation location = SourceLocation::current()) {                                  \
+        default_logger().err(args_, location);                                                                         \
+    }                                                                                                                  \
+    template <template_params_>                                                                                        \
+    void warn(function_params_, SourceLocation location = SourceLocation::current()) {                                 \
+        default_logger().warn(args_, location);                                                                        \
+    }                                                                                                                  \
+    template <template_params_>                                                                                        \
+    void note(function_params_, SourceLocation location = SourceLocation::current()) {                                 \
+        default_logger().note(args_, location);                                                                        \
+    }                                                                                                                  \
+    template <template_params_>                                                                                        \
+    void info(function_params_, SourceLocation location = SourceLocation::current()) {                                 \
+        default_logger().info(args_, location);                                                                        \
+    }                                                                                                                  \
+    template <template_params_>                                                                                        \
+    void debug(function_params_, SourceLocation location = SourceLocation::current()) {                                \
+        default_logger().debug(args_, location);                                                                       \
+    }                                                                                                                  \
+    template <template_params_>                                                                                        \
+    void trace(function_params_, SourceLocation location = SourceLocation::current()) {                                \
+        default_logger().trace(args_, location);                                                                       \
+    }
+
+// --- Component ---
+// -----------------
+
+// Component that wraps a number of sinks and distributes records to them
+
+template <class... Sinks>
+class Logger {
+    std::tuple<Sinks...> sinks;
+    Clock::time_point    creation_time_point = Clock::now();
+
+    template <policy::Level message_level, class... Args>
+    void message(SourceLocation location, const Args&... args) {
+        // Get record info
+        Record record;
+        record.elapsed = Clock::now() - this->creation_time_point;
+
+        std::string_view path = location.function_name();
+
+        record.file = path.substr(path.find_last_of("\\/") + 1);
+        record.line = static_cast<std::size_t>(location.line());
+
+        // Note 1: Even if there is nothing to trim, the 'file' will be correct due to the 'npos + 1 == 0' wrap-around
+
+        // Note 2: We have no choice, but to evaluate 'std::source_location' at runtime due to a deficiency in its
+        //         design. In C++20 we do get potential constexpr source location through non-type template parameters,
+        //         but even we have to implement a custom source location using compiler build-ins since standard one
+        //         doesn't work as a non-type parameter.
+
+        // Forward record & message to every sink
+        tuple_for_each(this->sinks, [&](auto&& sink) { sink.template message<message_level>(record, args...); });
+    }
+
+public:
+    Logger(Sinks&&... sinks) : sinks(std::move(sinks)...) {
+        tuple_for_each(this->sinks, [&](auto&& sink) { sink.header(); }); // [Important!]
+        // any buffer operations should happen AFTER the sink construction, since during construction
+        // buffer & output pointers can change, which would break the async case (single-threaded case is fine)
+    }
+
+    // Create err() / warn() / note() / info() / debug() / trace() for up to 18 arguments
+    // clang-format off
+    utl_log_member_alias( // 1
+        utl_log_hold(class A   ),
+        utl_log_hold(const A& a),
         utl_log_hold(         a)
     )
     utl_log_member_alias( // 2
@@ -5095,477 +6259,3069 @@ class Logger {
     // clang-format on
 };
 
-// =============================
-// --- Pre-configured logger ---
-// =============================
+// =============================
+// --- Pre-configured logger ---
+// =============================
+
+inline auto& default_logger() {
+    static auto logger = Logger{Sink{std::cout}, Sink{"latest.log"}};
+    return logger;
+}
+
+// Expose default logger err() / warn() / note() / info() / debug() / trace() as functions in the global namespace
+// clang-format off
+utl_log_function_alias( // 1
+    utl_log_hold(class A   ),
+    utl_log_hold(const A& a),
+    utl_log_hold(         a)
+)
+utl_log_function_alias( // 2
+    utl_log_hold(class A   , class B   ),
+    utl_log_hold(const A& a, const B& b),
+    utl_log_hold(         a,          b)
+)
+utl_log_function_alias( // 3
+    utl_log_hold(class A   , class B   , class C   ),
+    utl_log_hold(const A& a, const B& b, const C& c),
+    utl_log_hold(         a,          b,          c)
+)
+utl_log_function_alias( // 4
+    utl_log_hold(class A   , class B   , class C   , class D   ),
+    utl_log_hold(const A& a, const B& b, const C& c, const D& d),
+    utl_log_hold(         a,          b,          c,          d)
+)
+utl_log_function_alias( // 5
+    utl_log_hold(class A   , class B   , class C   , class D   , class E   ),
+    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e),
+    utl_log_hold(         a,          b,          c,          d,          e)
+)
+utl_log_function_alias( // 6
+    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   ),
+    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f),
+    utl_log_hold(         a,          b,          c,          d,          e,          f)
+)
+utl_log_function_alias( // 7
+    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   ),
+    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g),
+    utl_log_hold(         a,          b,          c,          d,          e,          f,          g)
+)
+utl_log_function_alias( // 8
+    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   ),
+    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h),
+    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h)
+)
+utl_log_function_alias( // 9
+    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ),
+    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i),
+    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i)
+)
+utl_log_function_alias( // 10
+    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
+                 class J                                                                                                   ),
+    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
+                 const J& j                                                                                                ),
+    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
+                          j                                                                                                )
+)
+utl_log_function_alias( // 11
+    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
+                 class J   , class K                                                                                       ),
+    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
+                 const J& j, const K& k                                                                                    ),
+    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
+                          j,          k                                                                                    )
+)
+utl_log_function_alias( // 12
+    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
+                 class J   , class K   , class L                                                                           ),
+    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
+                 const J& j, const K& k, const L& l                                                                        ),
+    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
+                          j,          k,          l                                                                        )
+)
+utl_log_function_alias( // 13
+    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
+                 class J   , class K   , class L   , class M                                                               ),
+    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
+                 const J& j, const K& k, const L& l, const M& m                                                            ),
+    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
+                          j,          k,          l,          m                                                            )
+)
+utl_log_function_alias( // 14
+    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
+                 class J   , class K   , class L   , class M   , class N                                                   ),
+    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
+                 const J& j, const K& k, const L& l, const M& m, const N& n                                                ),
+    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
+                          j,          k,          l,          m,          n                                                )
+)
+utl_log_function_alias( // 15
+    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
+                 class J   , class K   , class L   , class M   , class N   , class O                                       ),
+    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
+                 const J& j, const K& k, const L& l, const M& m, const N& n, const O& o                                    ),
+    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
+                          j,          k,          l,          m,          n,          o                                    )
+)
+utl_log_function_alias( // 16
+    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
+                 class J   , class K   , class L   , class M   , class N   , class O   , class P                           ),
+    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
+                 const J& j, const K& k, const L& l, const M& m, const N& n, const O& o, const P& p                        ),
+    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
+                          j,          k,          l,          m,          n,          o,          p                        )
+)
+utl_log_function_alias( // 17
+    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
+                 class J   , class K   , class L   , class M   , class N   , class O   , class P   , class Q               ),
+    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
+                 const J& j, const K& k, const L& l, const M& m, const N& n, const O& o, const P& p, const Q& q            ),
+    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
+                          j,          k,          l,          m,          n,          o,          p,          q            )
+)
+utl_log_function_alias( // 18
+    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
+                 class J   , class K   , class L   , class M   , class N   , class O   , class P   , class Q   , class R   ),
+    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
+                 const J& j, const K& k, const L& l, const M& m, const N& n, const O& o, const P& p, const Q& q, const R& r),
+    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
+                          j,          k,          l,          m,          n,          o,          p,          q,          r)
+)
+    // clang-format on
+
+    // ================
+    // --- Printing ---
+    // ================
+
+    template <class... Args>
+    void stringify_append(std::string& str, const Args&... args) {
+    // Format all 'args' into a string using the same buffer abstraction as logging sinks, this doesn't add overhead
+    StringBuffer buffer(str);
+    (Formatter<Args>{}(buffer, args), ...);
+}
+
+template <class... Args>
+std::string stringify(const Args&... args) {
+    std::string res;
+    stringify_append(res, args...);
+    return res;
+}
+
+template <class... Args>
+void print(const Args&... args) {
+    // Print all 'args' to console in a thread-safe way with instant flushing
+    static std::mutex     mutex;
+    const std::lock_guard lock(mutex);
+
+    std::cout << stringify(args...) << std::flush;
+}
+
+template <class... Args>
+void println(const Args&... args) {
+    print(args..., '\n');
+}
+
+} // namespace utl::log::impl
+
+// ______________________ PUBLIC API ______________________
+
+namespace utl::log {
+
+using impl::Formatter;
+
+using impl::Logger;
+using impl::Sink;
+
+namespace policy = impl::policy;
+
+using impl::general;
+using impl::fixed;
+using impl::scientific;
+using impl::hex;
+using impl::base;
+using impl::align_left;
+using impl::align_center;
+using impl::align_right;
+
+namespace color = impl::color;
+
+using impl::err;
+using impl::warn;
+using impl::note;
+using impl::info;
+using impl::debug;
+using impl::trace;
+
+using impl::stringify_append;
+using impl::stringify;
+using impl::print;
+using impl::println;
+
+} // namespace utl::log
+
+#endif
+#endif // module utl::log
+
+
+
+
+
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Module:        utl::math
+// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_math.md
+// Source repo:   https://github.com/DmitriBogdanov/UTL
+//
+// This project is licensed under the MIT License
+//
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#if !defined(UTL_PICK_MODULES) || defined(UTL_MODULE_MATH)
+
+#ifndef utl_math_headerguard
+#define utl_math_headerguard
+
+#define UTL_MATH_VERSION_MAJOR 1
+#define UTL_MATH_VERSION_MINOR 2
+#define UTL_MATH_VERSION_PATCH 1
+
+// _______________________ INCLUDES _______________________
+
+#include <cassert>     // assert()
+#include <limits>      // numeric_limits<>
+#include <type_traits> // enable_if_t<>, is_floating_point<>, is_arithmetic<>, is_integral<>, is_same<>, ...
+
+// ____________________ DEVELOPER DOCS ____________________
+
+// A bunch of template utils that naturally accumulated over time.
+//
+// This header used to be somewhat of a junkyard of different math-adjacent stuff, but later underwent a cleanup
+// due to the development of another numerical library (GSE) implementing a much more "serious" mathematical package,
+// a lot of functionality from here was generalized and moved into the appropriate modules of this lib.
+
+// ____________________ IMPLEMENTATION ____________________
+
+namespace utl::math::impl {
+
+// ======================
+// --- SFINAE helpers ---
+// ======================
+
+template <bool Cond>
+using require = std::enable_if_t<Cond, bool>;
+
+template <class T>
+using require_arithmetic = require<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>;
+
+template <class T>
+using require_int = require<std::is_integral_v<T> && !std::is_same_v<T, bool>>;
+
+template <class T>
+using require_uint = require<std::is_integral_v<T> && std::is_unsigned_v<T> && !std::is_same_v<T, bool>>;
+
+template <class T>
+using require_float = require<std::is_floating_point_v<T>>;
+
+template <class T, class... Args>
+using require_invocable = require<std::is_invocable_v<T, Args...>>;
+
+// =================
+// --- Constants ---
+// =================
+
+namespace constants {
+
+constexpr double pi      = 3.14159265358979323846;
+constexpr double two_pi  = 6.28318530717958647693;
+constexpr double half_pi = 1.57079632679489661923;
+constexpr double inv_pi  = 0.31830988618379067153;
+constexpr double sqrtpi  = 1.77245385090551602729;
+constexpr double e       = 2.71828182845904523536; // Euler's number
+constexpr double egamma  = 0.57721566490153286060; // Euler-Mascheroni constant
+constexpr double phi     = 1.61803398874989484820; // golden ratio
+constexpr double ln2     = 0.69314718055994530942;
+constexpr double ln10    = 2.30258509299404568402;
+constexpr double sqrt2   = 1.41421356237309504880;
+constexpr double sqrt3   = 1.73205080756887729352;
+
+} // namespace constants
+
+// =======================
+// --- Basic functions ---
+// =======================
+
+template <class T, require_arithmetic<T> = true>
+[[nodiscard]] constexpr T abs(T x) noexcept {
+    return (x > T(0)) ? x : -x;
+}
+
+template <class T, require_arithmetic<T> = true>
+[[nodiscard]] constexpr T sign(T x) noexcept {
+    if constexpr (std::is_unsigned_v<T>) return (x > T(0)) ? T(1) : T(0);
+    else return (x > T(0)) ? T(1) : (x < T(0)) ? T(-1) : T(0);
+} // returns -1 / 0 / 1
+
+template <class T, require_arithmetic<T> = true>
+[[nodiscard]] constexpr T bsign(T x) noexcept {
+    if constexpr (std::is_unsigned_v<T>) return T(1);
+    else return (x >= T(0)) ? T(1) : T(-1);
+} // returns -1 / 1 (1 gets priority in x == 0)
+
+template <class T, require_arithmetic<T> = true>
+[[nodiscard]] constexpr T sqr(T x) noexcept {
+    return x * x;
+}
+
+template <class T, require_arithmetic<T> = true>
+[[nodiscard]] constexpr T cube(T x) noexcept {
+    return x * x * x;
+}
+
+template <class T, require_float<T> = true>
+[[nodiscard]] constexpr T inv(T x) noexcept {
+    return T(1) / x;
+}
+
+template <class T, require_arithmetic<T> = true>
+[[nodiscard]] constexpr T heaviside(T x) noexcept {
+    return static_cast<T>(x > T(0));
+}
+
+// Floating point midpoint based on 'libstdc++' implementation, takes care of extreme values
+template <class T, require_float<T> = true>
+[[nodiscard]] constexpr T midpoint(T a, T b) noexcept {
+    constexpr T low  = std::numeric_limits<T>::min() * 2;
+    constexpr T high = std::numeric_limits<T>::max() / 2;
+
+    const T abs_a = abs(a);
+    const T abs_b = abs(b);
+
+    if (abs_a <= high && abs_b <= high) return (a + b) / 2; // always correctly rounded
+    if (abs_a < low) return a + b / 2;                      // not safe to halve 'a'
+    if (abs_b < low) return b + a / 2;                      // not safe to halve 'b'
+    return a / 2 + b / 2;                                   // correctly rounded for remaining cases
+}
+
+// Non-overflowing integer midpoint is less trivial than it might initially seem, see
+// https://lemire.me/blog/2022/12/06/fast-midpoint-between-two-integers-without-overflow/
+// https://biowpn.github.io/bioweapon/2025/03/23/generalizing-std-midpoint.html
+template <class T, require_int<T> = true>
+[[nodiscard]] constexpr T midpoint(T a, T b) noexcept {
+    return ((a ^ b) >> 1) + (a & b);
+    // fast rounding-down midpoint by Warren (Hacker's Delight section 2.5)
+    // rounding-up version would be '(a | b) - ((a ^ b) >> 1)'
+    // this is faster than C++20 'std::midpoint()' due to a different rounding mode
+}
+
+template <class T, require_arithmetic<T> = true>
+[[nodiscard]] constexpr T absdiff(T a, T b) noexcept {
+    return (a > b) ? (a - b) : (b - a);
+}
+
+// =======================
+// --- Power functions ---
+// =======================
+
+// Squaring algorithm for positive integer powers
+template <class T, class U, require_arithmetic<T> = true, require_int<U> = true>
+[[nodiscard]] constexpr T pow_squaring(T x, U p) noexcept {
+    if (p == U(0)) return T(1);
+    if (p == U(1)) return x;
+    const T half_pow = pow_squaring(x, p / 2);
+    return (p % U(2) == U(0)) ? half_pow * half_pow : half_pow * half_pow * x;
+}
+
+template <class T, class U, require_arithmetic<T> = true, require_int<U> = true>
+[[nodiscard]] constexpr T pow(T x, U p) noexcept {
+    if constexpr (std::is_signed_v<T>) {
+        return (p < 0) ? T(1) / pow_squaring(x, -p) : pow_squaring(x, p);
+    } else {
+        return pow_squaring(x, p); // no need for the branch in unsigned case
+    }
+}
+
+[[nodiscard]] constexpr int signpow(int p) noexcept { return (p % 2 == 0) ? 1 : -1; }
+
+// =======================
+// --- Index functions ---
+// =======================
+
+template <class T, require_int<T> = true>
+[[nodiscard]] constexpr T kronecker_delta(T i, T j) noexcept {
+    return (i == j) ? T(1) : T(0);
+}
+
+template <class T, require_int<T> = true>
+[[nodiscard]] constexpr T levi_civita(T i, T j, T k) noexcept {
+    if (i == j || j == k || k == i) return T(0);
+    const unsigned int inversions = (i > j) + (i > k) + (j > k);
+    return (inversions % 2 == 0) ? T(1) : T(-1);
+}
+
+// ===================
+// --- Conversions ---
+// ===================
+
+template <class T, require_float<T> = true>
+[[nodiscard]] constexpr T deg_to_rad(T degrees) noexcept {
+    constexpr T factor = T(constants::pi / 180.);
+    return degrees * factor;
+}
+
+template <class T, require_float<T> = true>
+[[nodiscard]] constexpr T rad_to_deg(T radians) noexcept {
+    constexpr T factor = T(180. / constants::pi);
+    return radians * factor;
+}
+
+// ===========================
+// --- Sequence operations ---
+// ===========================
+
+template <class Idx, class Func, require_invocable<Func, Idx> = true>
+[[nodiscard]] constexpr auto sum(Idx low, Idx high, Func&& func) noexcept(noexcept(func(Idx{}))) {
+    assert(low <= high);
+    std::invoke_result_t<Func, Idx> res = 0;
+    for (Idx i = low; i <= high; ++i) res += func(i);
+    return res;
+}
+
+template <class Idx, class Func, require_invocable<Func, Idx> = true>
+[[nodiscard]] constexpr auto prod(Idx low, Idx high, Func&& func) noexcept(noexcept(func(Idx{}))) {
+    assert(low <= high);
+    std::invoke_result_t<Func, Idx> res = 1;
+    for (Idx i = low; i <= high; ++i) res *= func(i);
+    return res;
+}
+
+} // namespace utl::math::impl
+
+// ______________________ PUBLIC API ______________________
+
+namespace utl::math {
+
+namespace constants = impl::constants;
+
+using impl::abs;
+using impl::sign;
+using impl::bsign;
+using impl::sqr;
+using impl::cube;
+using impl::inv;
+using impl::heaviside;
+
+using impl::midpoint;
+using impl::absdiff;
+
+using impl::pow;
+using impl::signpow;
+
+using impl::kronecker_delta;
+using impl::levi_civita;
+
+using impl::deg_to_rad;
+using impl::rad_to_deg;
+
+using impl::sum;
+using impl::prod;
+
+} // namespace utl::math
+
+#endif
+#endif // module utl::math
+
+
+
+
+
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Module:        utl::mvl
+// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_mvl.md
+// Source repo:   https://github.com/DmitriBogdanov/UTL
+//
+// This project is licensed under the MIT License
+//
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+#if !defined(UTL_PICK_MODULES) || defined(UTL_MODULE_MVL)
+
+#ifndef utl_mvl_headerguard
+#define utl_mvl_headerguard
+
+#define UTL_MVL_VERSION_MAJOR 0 // [!] module in early experimental stage,
+#define UTL_MVL_VERSION_MINOR 1 //     functional, but needs significant work
+#define UTL_MVL_VERSION_PATCH 3 //     to complete and bring up-to-date
+
+// _______________________ INCLUDES _______________________
+
+#include <algorithm>        // swap(), find(), count(), is_sorted(), min_element(), max_element(), ...
+#include <cassert>          // assert() // Note: Perhaps temporary
+#include <charconv>         // to_chars()
+#include <cmath>            // isfinite()
+#include <cstddef>          // size_t, ptrdiff_t, nullptr_t
+#include <functional>       // reference_wrapper<>, multiplies<>
+#include <initializer_list> // initializer_list<>
+#include <iterator>         // random_access_iterator_tag, reverse_iterator<>
+#include <memory>           // unique_ptr<>
+#include <numeric>          // accumulate()
+#include <ostream>          // ostream
+#include <sstream>          // ostringstream
+#include <stdexcept>        // out_of_range, invalid_argument
+#include <string>           // string
+#include <string_view>      // string_view<>
+#include <type_traits>      // conditional_t<>, enable_if_t<>, void_t<>, true_type, false_type, remove_reference_t<>
+#include <utility>          // move()
+#include <vector>           // vector<>
+
+// ____________________ DEVELOPER DOCS ____________________
+
+// [experimental!] This header is still work in progress and likely to undergo significant changes to
+// its API & implementation.
+//
+// This module tries to implement an "unreasonably flexible yet convenient" template for vectors and matrices,
+// in order to do so we have to rely heavily on either conditional compilation or automatic code generation
+// (or both). There are multiple seemingly viable approaches to it, yet the most of them proved to be either
+// unsuitable or unreasonable from the implementation standpoint. Below is a little rundown of implementations
+// that were attempted and used/discared for various reasons.
+//
+// Currently matrix/vector/view/etc code reuse is implemented though a whole bunch of conditional compilation with
+// SFINAE, abuse of conditional inheritance, conditional types and constexpr if's. While not perfect, this is
+// the best working approach so far. Below is a list of approaches that has been considered & tried:
+//
+// 1) No code reuse, all classes implemented manually - unrealistically cumbersome, huge code duplication
+//
+//    => [-] UNSUITABLE APPROACH
+//
+// 2) Regular OOP with virtual classes - having vtables in lightweight containers is highly undesirable,
+//    we can avoid this using CRTP however we run into issues with multiple inheritance (see below)
+//
+//    => [-] UNSUITABLE APPROACH
+//
+// 3) CRTP - we unavoidably run into multiple inheritance issues (diamond problem) with concepts like:
+//       [mutable-matrix-like] : [const-matrix-like] & [mutable-iterable] where both parents derive from
+//       [const-iterable]
+//
+//    While those issues are resolvable, their handling becomes more and more difficult as parent classes grow larger.
+//    A usual solution for this would be virtual inheritance, however it prevents us from calling derived methods inside
+//    the base class due to "static downcast via virtual inheritance" rule, which makes 'static_cast<Derived*>(this)'
+//    illegal. We can resolve all name collisions manually, however it leads to a code that is absolutely horrific and
+//    easy to mess up.
+//
+//    There is also an issue of extreme boilerplate, since we want to propagate '_types<>' wrapper and the 'Final'
+//    return type to all base classes we end up with extremely unwieldy template arguments that make compile errors and
+//    refactoring a challenge.
+//
+//    => [~] SUITABLE, BUT VERY PROBLEMATIC APPROACH
+//
+// 4) Template-based mixins without CRTP - these allow to add functionality on top of a class, essentially it works
+//    like "inverted" CRTP from the code logic POV. While being almost a perfect solution, it doesn't allow us to
+//    return objects of derived type from base class methods, which is a requirement for the intended matrix API.
+//
+//    => [-] UNSUITABLE APPROACH
+//
+// 5) Macro-based mixins - insert functionality directly in a class, a simple way of doing exactly what we want.
+//    "Mixed-in" methods are simply functions implemented in terms of certain "required" methods.
+//    Doesn't lead to huge template chains and doesn't have any inheritance at all. The main downside is being
+//    preprocessor based, which exposes some identifiers to a global namespace and makes all "connection points"
+//    in logic dependant on correct naming inside macros, rather than actual semantical symbols.
+//
+//    Difficult to work with due to being ignored by the language server, gets increasingly cumbersome as the number of
+//    classes grows and still has significant code duplication (vector/matrix * dense/strided/sparse *
+//    * container/view/const_view = 18 manually created definitions).
+//
+//    => [+-] SUITABLE, BUT HEAVILY FLAWED APPROACH
+//
+// 6) A single class with all parts of API correctly enabled/disabled through SFINAE. Closest thing to a sensible
+//    approach with minimal (basically none) code duplication. However it has a number of non-trivial quirks
+//    when it comes to conditionally compiling member variables, types & functions (every group has a quirk of
+//    its own, functions are the least problematic). Some of such quirks limit possible conditional API (member
+//    types suffer from this) or, for example, prevent use of initialization lists on conditionally compiled
+//    constructors (big sad).
+//
+//    A less obvious downside compared to macros, is that it doesn't get handles as well by the language server
+//    autocomplete - SFINAE-disabled methods still show up as autocomplete suggestions, even if they get marked
+//    as missing immediately upon writing the whole name.
+//
+//    => [+] DIFFICULT, BUT WORKABLE, BEST APPROACH SO FAR
+//
+// NOTES ON SPAN:
+//
+// We can easily implement Matlab-like API to take matrix blocks like this:
+//    matrix(Span{0, 10}, 4)
+// which would be equivalent to
+//    matrix.block(0, 4, 10, 1)
+// we only need a thin 'Span' POD with 2 members and a few overloads for 'operator()' that redirect span
+// to 'this->block(...)'
+//
+// NOTES ON NAMING:
+//
+// Macro naming is a bit of a mess as of now.
+
+// ____________________ IMPLEMENTATION ____________________
+
+namespace utl::mvl {
+
+// ===================
+// --- Type Traits ---
+// ===================
+
+// Macro for generating type traits with all their boilerplate
+//
+// While it'd be nice to avoid macro usage alltogether, having a few macros for generating standardized boilerplate
+// that gets repeated several dozen times DRASTICALLY improves the maintainability of the whole conditional compilation
+// mechanism down the line. They will be later #undef'ed.
+
+#define utl_mvl_define_trait(trait_name_, ...)                                                                         \
+    template <class T, class = void>                                                                                   \
+    struct trait_name_ : std::false_type {};                                                                           \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    struct trait_name_<T, std::void_t<decltype(__VA_ARGS__)>> : std::true_type {};                                     \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    constexpr bool trait_name_##_v = trait_name_<T>::value;                                                            \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    using trait_name_##_enable_if = std::enable_if_t<trait_name_<T>::value, bool>
+
+// Shortcuts for different types of requirements
+
+#define utl_mvl_define_trait_has_binary_op(trait_name_, op_)                                                           \
+    utl_mvl_define_trait(trait_name_, std::declval<std::decay_t<T>>() op_ std::declval<std::decay_t<T>>())
+
+#define utl_mvl_define_trait_has_assignment_op(trait_name_, op_)                                                       \
+    utl_mvl_define_trait(trait_name_, std::declval<std::decay_t<T>&>() op_ std::declval<std::decay_t<T>>())
+// for operators like '+=' lhs should be a reference
+
+#define utl_mvl_define_trait_has_unary_op(trait_name_, op_)                                                            \
+    utl_mvl_define_trait(trait_name_, op_ std::declval<std::decay_t<T>>())
+
+#define utl_mvl_define_trait_has_member(trait_name_, member_)                                                          \
+    utl_mvl_define_trait(trait_name_, std::declval<std::decay_t<T>>().member_)
+
+#define utl_mvl_define_trait_has_member_type(trait_name_, member_)                                                     \
+    utl_mvl_define_trait(trait_name_, std::declval<typename std::decay_t<T>::member_>())
+
+// --- Type traits ---
+// -------------------
+
+utl_mvl_define_trait(_has_ostream_output_op, std::declval<std::ostream>() << std::declval<T>());
+
+utl_mvl_define_trait_has_binary_op(_has_binary_op_plus, +);
+utl_mvl_define_trait_has_binary_op(_has_binary_op_minus, -);
+utl_mvl_define_trait_has_binary_op(_has_binary_op_multiplies, *);
+utl_mvl_define_trait_has_binary_op(_has_binary_op_less, <);
+utl_mvl_define_trait_has_binary_op(_has_binary_op_greater, >);
+utl_mvl_define_trait_has_binary_op(_has_binary_op_equal, ==);
+
+utl_mvl_define_trait_has_assignment_op(_has_assignment_op_plus, +=);
+utl_mvl_define_trait_has_assignment_op(_has_assignment_op_minus, -=);
+utl_mvl_define_trait_has_assignment_op(_has_assignment_op_multiplies, *=);
+
+utl_mvl_define_trait_has_unary_op(_has_unary_op_plus, +);
+utl_mvl_define_trait_has_unary_op(_has_unary_op_minus, -);
+
+utl_mvl_define_trait_has_member(_has_member_i, i);
+utl_mvl_define_trait_has_member(_has_member_j, j);
+utl_mvl_define_trait_has_member(_has_member_value, value);
+
+utl_mvl_define_trait_has_member(_is_tensor, is_tensor);
+utl_mvl_define_trait_has_member(_is_sparse_entry_1d, is_sparse_entry_1d);
+utl_mvl_define_trait_has_member(_is_sparse_entry_2d, is_sparse_entry_2d);
+
+// =======================
+// --- Stringification ---
+// =======================
+
+// Stringification implementation from 'utl::log' module, see its source for more notes.
+
+// --- Internal type traits ---
+// ----------------------------
+
+utl_mvl_define_trait(_has_string_append, std::string() += std::declval<T>());
+utl_mvl_define_trait(_has_real, std::declval<T>().real());
+utl_mvl_define_trait(_has_imag, std::declval<T>().imag());
+utl_mvl_define_trait(_has_begin, std::declval<T>().begin());
+utl_mvl_define_trait(_has_end, std::declval<T>().end());
+utl_mvl_define_trait(_has_input_iter, std::next(std::declval<T>().begin()));
+utl_mvl_define_trait(_has_get, std::get<0>(std::declval<T>()));
+utl_mvl_define_trait(_has_tuple_size, std::tuple_size<T>::value);
+utl_mvl_define_trait(_has_ostream_insert, std::declval<std::ostream>() << std::declval<T>());
+
+// --- Internal utils ---
+// ----------------------
+
+template <class>
+inline constexpr bool _always_false_v = false;
+
+template <class T>
+constexpr int _log_10_ceil(T num) {
+    return num < 10 ? 1 : 1 + _log_10_ceil(num / 10);
+}
+
+template <class T>
+constexpr int _max_float_digits =
+    4 + std::numeric_limits<T>::max_digits10 + std::max(2, _log_10_ceil(std::numeric_limits<T>::max_exponent10));
+
+template <class T>
+constexpr int _max_int_digits = 2 + std::numeric_limits<T>::digits10;
+
+// --- Stringifier ---
+// -------------------
+
+// TODO:
+// Replace or rethink all of this stringifying stuff, perhaps it would be best to just have a super-simple
+// one and let other functions take custom stringifier from 'utl::log'
+
+template <class T>
+void _append_stringified(std::string& str, const T& value);
+
+inline void _append_stringified_bool(std::string& str, bool value) { str += value ? "true" : "false"; }
+
+template <class T>
+void _append_stringified_integer(std::string& str, T value) {
+    std::array<char, _max_int_digits<T>> buffer;
+    const auto [number_end_ptr, error_code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    if (error_code != std::errc())
+        throw std::runtime_error(
+            "Integer stringification encountered std::to_chars() formatting error while serializing a value.");
+    str.append(buffer.data(), number_end_ptr - buffer.data());
+}
+
+template <class T>
+void _append_stringified_float(std::string& str, T value) {
+    std::array<char, _max_float_digits<T>> buffer;
+    const auto [number_end_ptr, error_code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+    if (error_code != std::errc())
+        throw std::runtime_error(
+            "Float stringification encountered std::to_chars() formatting error while serializing a value.");
+    str.append(buffer.data(), number_end_ptr - buffer.data());
+}
+
+template <class T>
+void _append_stringified_complex(std::string& str, T value) {
+    _append_stringified_float(str, value.real());
+    str += " + ";
+    _append_stringified_float(str, value.imag());
+    str += " i";
+}
+
+template <class T>
+void _append_stringified_stringlike(std::string& str, const T& value) {
+    str += value;
+}
+
+template <class T>
+void _append_stringified_string_convertible(std::string& str, const T& value) {
+    str += std::string(value);
+}
+
+template <class T>
+void _append_stringified_array(std::string& str, const T& value) {
+    str += "{ ";
+    if (value.begin() != value.end())
+        for (auto it = value.begin();;) {
+            _append_stringified(str, *it);
+            if (++it == value.end()) break;
+            str += ", ";
+        }
+    str += " }";
+}
+
+template <class Tuple, std::size_t... Idx>
+void _append_stringified_tuple_impl(std::string& str, Tuple value, std::index_sequence<Idx...>) {
+    ((Idx == 0 ? "" : str += ", ", _append_stringified(str, std::get<Idx>(value))), ...);
+}
+
+template <template <class...> class Tuple, class... Args>
+void _append_stringified_tuple(std::string& str, const Tuple<Args...>& value) {
+    str += "< ";
+    _append_stringified_tuple_impl(str, value, std::index_sequence_for<Args...>{});
+    str += " >";
+}
+
+template <class T>
+void _append_stringified_printable(std::string& str, const T& value) {
+    str += (std::ostringstream() << value).str();
+}
+
+// --- Selector ---
+// ----------------
+
+template <class T>
+void _append_stringified(std::string& str, const T& value) {
+    if constexpr (std::is_same_v<T, bool>) _append_stringified_bool(str, value);
+    else if constexpr (std::is_same_v<T, char>) _append_stringified_stringlike(str, value);
+    else if constexpr (std::is_integral_v<T>) _append_stringified_integer(str, value);
+    else if constexpr (std::is_floating_point_v<T>) _append_stringified_float(str, value);
+    else if constexpr (_has_real_v<T> && _has_imag_v<T>) _append_stringified_complex(str, value);
+    else if constexpr (std::is_convertible_v<T, std::string_view>) _append_stringified_stringlike(str, value);
+    else if constexpr (std::is_convertible_v<T, std::string>) _append_stringified_string_convertible(str, value);
+    else if constexpr (_has_begin_v<T> && _has_end_v<T> && _has_input_iter_v<T>) _append_stringified_array(str, value);
+    else if constexpr (_has_get_v<T> && _has_tuple_size_v<T>) _append_stringified_tuple(str, value);
+    else if constexpr (_has_ostream_insert_v<T>) _append_stringified_printable(str, value);
+    else static_assert(_always_false_v<T>, "No valid stringification exists for the type.");
+}
+
+// --- Public API ---
+// ------------------
+
+template <class... Args>
+void append_stringified(std::string& str, Args&&... args) {
+    (_append_stringified(str, std::forward<Args>(args)), ...);
+}
+
+template <class... Args>
+[[nodiscard]] std::string stringify(Args&&... args) {
+    std::string buffer;
+    append_stringified(buffer, std::forward<Args>(args)...);
+    return buffer;
+}
+
+// Override "common special cases" that can be improved relative to a generic implementation
+[[nodiscard]] inline std::string stringify(int value) { return std::to_string(value); }
+[[nodiscard]] inline std::string stringify(long value) { return std::to_string(value); }
+[[nodiscard]] inline std::string stringify(long long value) { return std::to_string(value); }
+[[nodiscard]] inline std::string stringify(unsigned int value) { return std::to_string(value); }
+[[nodiscard]] inline std::string stringify(unsigned long value) { return std::to_string(value); }
+[[nodiscard]] inline std::string stringify(unsigned long long value) { return std::to_string(value); }
+
+// We wrap stringifying function in functor-class so we can use it a default template callable argument.
+// Templates can't infer template parameters from default arguments:
+//
+//    template<class Func>
+//    void do_stuff(Func f = default_f);  // <- CAN'T infer 'Func'
+//
+//    template<class Func = default_functor>
+//    void do_stuff(Func f = Func());     // <- CAN infer 'Func'
+//
+// which is why the "standard" way of doing it (standard as in used by STL containers) is to use functors as default
+// template arguments, if user passes a callable it will override the 'Func' and we get the usual behaviour.
+//
+template <class T>
+struct default_stringifier {
+    [[nodiscard]] std::string operator()(const T& value) const { return stringify(value); }
+};
+
+// ======================
+// --- Codegen Macros ---
+// ======================
+
+#define utl_mvl_assert(condition_) assert(condition_)
+// if (!__VA_ARGS__) throw std::runtime_error("Failed assert on line " + std::to_string(__LINE__))
+
+// ========================
+// --- Helper Functions ---
+// ========================
+
+// Shortcut for lambda-type-based SFINAE.
+//
+// Callables in this module are usually takes as a template type since 'std::function<>' introduces very significant
+// overhead with its type erasure. With template args all lambdas and functors can be nicely inlined, however we lose
+// the ability to overload functions that take callable the way we could with 'std::function<>'.
+//
+// As a workaround we can use SFINAE to reject "overloads" tha don't have a particular signature, effectively achieving
+// the behaviour we need.
+template <class FuncType, class Signature>
+using _has_signature_enable_if = std::enable_if_t<std::is_convertible_v<FuncType, std::function<Signature>>, bool>;
+
+template <class T>
+[[nodiscard]] std::unique_ptr<T[]> _make_unique_ptr_array(size_t size) {
+    return std::unique_ptr<T[]>(new T[size]);
+}
+
+// Macro version of 'std::unreachable()' implementation from https://en.cppreference.com/w/cpp/utility/unreachable
+// we use macro instead of a function to work around false-positive MSVC /W4 warnings about "unreachable code"
+// in a function that exists to mark unreachable code
+#if defined(_MSC_VER) && !defined(__clang__) // MSVC
+#define utl_mvl_unreachable static_assert(true)
+#else // GCC, Clang
+#define utl_mvl_unreachable __builtin_unreachable()
+#endif
+
+// =======================
+// --- Utility Classes ---
+// =======================
+
+// Wrapper that allows passing standard set of member types down the CRTP chain
+// (types have to be passed through template args one way or another. Trying to access
+// 'derived_type::value_type' from the CRTP base class will fail, since in order for it to be available
+// the derived class has to be "implemented" which can only happen after the base class is "implemented",
+// which requires the type => a logical loop. So we wrap all the types in a class a pass them down
+// the chain a "pack with everything" type of deal. This pack then gets "unwrapped" with
+// '_utl_storage_define_types' macro in every class => we have all the member types defined).
+//
+// (!) Since CRTP approach has been deprecated in favor of mixins, the original reasoning is no longer
+// accurate, however it is this a useful class whenever a pack of types has to be passed through a
+// template (like, for example, in iterator implementation)
+template <class T>
+struct _types {
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference       = T&;
+    using const_reference = const T&;
+    using pointer         = T*;
+    using const_pointer   = const T*;
+};
+
+// A minimal equivalent of the once proposed 'std::observer_ptr<>'.
+// Used in views to allow observer pointers with the same interface as 'std::unique_ptr',
+// which means a generic '.data()` can be implemented without having to make a separate version for views and containers
+template <class T>
+class _observer_ptr {
+public:
+    using element_type = T;
+
+private:
+    element_type* _data = nullptr;
+
+public:
+    // - Constructors -
+    constexpr _observer_ptr() noexcept = default;
+    constexpr _observer_ptr(std::nullptr_t) noexcept {}
+    explicit _observer_ptr(element_type* ptr) : _data(ptr) {}
+
+    _observer_ptr& operator=(element_type* ptr) {
+        this->_data = ptr;
+        return *this;
+    }
+
+    // - Interface -
+    [[nodiscard]] constexpr element_type* get() const noexcept { return _data; }
+};
+
+// =================
+// --- Iterators ---
+// =================
+
+// Iterator template for 1D iterator over a tensor.
+// Reduces code duplication for const & non-const variants by bundling some conditional logic.
+// Uses 'operator[]' of 'ParentPointer' for all logic, thus allowing arbitrary tensors that
+// don't have to be contiguous or even ordered in memory.
+template <class ParentPointer, class Types, bool is_const_iter = false>
+class _flat_iterator {
+    using parent_pointer = ParentPointer;
+
+public:
+    // Iterator reqs: [General]
+    // Contains member types      =>
+    using iterator_category = std::random_access_iterator_tag;
+    using difference_type   = typename Types::difference_type;
+    using value_type        = typename Types::value_type;
+    using pointer = typename std::conditional_t<is_const_iter, typename Types::const_pointer, typename Types::pointer>;
+    using reference =
+        typename std::conditional_t<is_const_iter, typename Types::const_reference, typename Types::reference>;
+
+    // Iterator reqs: [General]
+    // Constructible
+    _flat_iterator(parent_pointer parent, difference_type idx) : _parent(parent), _idx(idx) {}
+    // Copy-constructible => by default
+    // Copy-assignable    => by default
+    // Destructible       => by default
+    // Swappable
+    friend void swap(_flat_iterator& lhs, _flat_iterator& rhs) { std::swap(lhs._idx, rhs._idx); }
+
+    // Iterator reqs: [General]
+    // Can be incremented (prefix & postfix)
+    _flat_iterator& operator++() {
+        ++_idx;
+        return *this;
+    } // prefix
+    _flat_iterator operator++(int) {
+        _flat_iterator temp = *this;
+        ++_idx;
+        return temp;
+    } // postfix
+
+    // Iterator reqs: [Input iterator]
+    // Supports equality/inequality comparisons
+    friend bool operator==(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx == it2._idx; };
+    friend bool operator!=(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx != it2._idx; };
+    // Can be dereferenced as an rvalue
+    reference   operator*() const { return _parent->operator[](_idx); }
+    pointer     operator->() const { return &_parent->operator[](_idx); }
+
+    // Iterator reqs: [Output iterator]
+    // Can be dereferenced as an lvalue (only for mutable iterator types) => not needed
+
+    // Iterator reqs: [Forward iterator]
+    // Default-constructible
+    _flat_iterator() : _parent(nullptr), _idx(0) {}
+    // "Multi-pass" - dereferencing & incrementing does not affects dereferenceability => satisfied
+
+    // Iterator reqs: [Bidirectional iterator]
+    // Can be decremented
+    _flat_iterator& operator--() {
+        --_idx;
+        return *this;
+    } // prefix
+    _flat_iterator operator--(int) {
+        _flat_iterator temp = *this;
+        --_idx;
+        return temp;
+    } // postfix
+
+    // Iterator reqs: [Random Access iterator]
+    // See: https://en.cppreference.com/w/cpp/named_req/RandomAccessIterator
+    // Supports arithmetic operators: it + n, n + it, it - n, it1 - it2
+    friend _flat_iterator operator+(const _flat_iterator& it, difference_type diff) {
+        return _flat_iterator(it._parent, it._idx + diff);
+    }
+    friend _flat_iterator operator+(difference_type diff, const _flat_iterator& it) {
+        return _flat_iterator(it._parent, it._idx + diff);
+    }
+    friend _flat_iterator operator-(const _flat_iterator& it, difference_type diff) {
+        return _flat_iterator(it._parent, it._idx - diff);
+    }
+    friend difference_type operator-(const _flat_iterator& it1, const _flat_iterator& it2) {
+        return it1._idx - it2._idx;
+    }
+    // Supports inequality comparisons (<, >, <= and >=) between iterators
+    friend bool     operator<(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx < it2._idx; }
+    friend bool     operator>(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx > it2._idx; }
+    friend bool     operator<=(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx <= it2._idx; }
+    friend bool     operator>=(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx >= it2._idx; }
+    // Standard assumption: Both iterators are from the same container => no need to compare '_parent'
+    // Supports compound assignment operations += and -=
+    _flat_iterator& operator+=(difference_type diff) {
+        _idx += diff;
+        return *this;
+    }
+    _flat_iterator& operator-=(difference_type diff) {
+        _idx -= diff;
+        return *this;
+    }
+    // Supports offset dereference operator ([])
+    reference operator[](difference_type diff) const { return _parent->operator[](_idx + diff); }
+
+private:
+    parent_pointer  _parent;
+    difference_type _idx; // not size_type because we have to use it in 'difference_type' operations most of the time
+};
+
+// ======================================
+// --- Sparse Matrix Pairs & Triplets ---
+// ======================================
+
+// Note:
+// All sparse entries and multi-dimensional indices can be sorted lexicographically
+
+template <class T>
+struct SparseEntry1D {
+    size_t i;
+    T      value;
+
+    constexpr static bool is_sparse_entry_1d = true;
+
+    [[nodiscard]] bool operator<(const SparseEntry1D& other) const noexcept { return this->i < other.i; }
+    [[nodiscard]] bool operator>(const SparseEntry1D& other) const noexcept { return this->i > other.i; }
+};
+
+template <class T>
+struct SparseEntry2D {
+    size_t i;
+    size_t j;
+    T      value;
+
+    constexpr static bool is_sparse_entry_2d = true;
+
+    [[nodiscard]] bool operator<(const SparseEntry2D& other) const noexcept {
+        return (this->i < other.i) || (this->j < other.j);
+    }
+    [[nodiscard]] bool operator>(const SparseEntry2D& other) const noexcept {
+        return (this->i > other.i) || (this->j > other.j);
+    }
+};
+
+struct Index2D {
+    size_t i;
+    size_t j;
+
+    [[nodiscard]] bool operator<(const Index2D& other) const noexcept {
+        return (this->i < other.i) || (this->j < other.j);
+    }
+    [[nodiscard]] bool operator>(const Index2D& other) const noexcept {
+        return (this->i > other.i) || (this->j > other.j);
+    }
+    [[nodiscard]] bool operator==(const Index2D& other) const noexcept {
+        return (this->i == other.i) && (this->j == other.j);
+    }
+};
+
+// Functions that take 2 sparse entries '{ i, j, v1 }' and '{ i, j, v2 }' and return '{ i, j, op(v1, v2) }'.
+// Same thing for 1D sparse entries. LHS/RHS index correctness only gets checked in debug.
+//
+// Declaring these functions saves us from having to duplicate implementations of 'apply_binary_operator()'
+// for 1D and 2D sparse entries that have different number of constructor args. Instead, those cases will
+// be handled by '_apply_binary_op_to_sparse_entry()' that is SFINAE-overloaded to work with both.
+//
+// Implementations use perfect forwarding for everything and do the "overloading" through SFINAE with type traits.
+//
+// In reality 'op' doesn't ever get forwarded as an r-value but since are doing things generic why not forward it
+// properly as well. This is also somewhat ugly, but it works well enough and there isn't much reason to rewrite
+// this with some new abstraction.
+//
+template <class L, class R, class Op, _is_sparse_entry_1d_enable_if<L> = true, _is_sparse_entry_1d_enable_if<R> = true>
+std::decay_t<L> _apply_binary_op_to_sparse_entries(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.i == right.i);
+    return {left.i, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right).value)};
+}
+
+template <class L, class R, class Op, _is_sparse_entry_2d_enable_if<L> = true, _is_sparse_entry_2d_enable_if<R> = true>
+std::decay_t<L> _apply_binary_op_to_sparse_entries(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.i == right.i);
+    utl_mvl_assert(left.j == right.j);
+    return {left.i, left.j, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right).value)};
+}
+
+template <class L, class R, class Op, _is_sparse_entry_1d_enable_if<L> = true>
+std::decay_t<L> _apply_binary_op_to_sparse_entry_and_value(L&& left, R&& right_value, Op&& op) {
+    return {left.i, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right_value))};
+}
+
+template <class L, class R, class Op, _is_sparse_entry_2d_enable_if<L> = true>
+std::decay_t<L> _apply_binary_op_to_sparse_entry_and_value(L&& left, R&& right_value, Op&& op) {
+    return {left.i, left.j, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right_value))};
+}
+
+template <class L, class R, class Op, _is_sparse_entry_1d_enable_if<R> = true>
+std::decay_t<R> _apply_binary_op_to_value_and_sparse_entry(L&& left_value, R&& right, Op&& op) {
+    return {right.i, std::forward<Op>(op)(std::forward<L>(left_value), std::forward<R>(right).value)};
+}
+
+template <class L, class R, class Op, _is_sparse_entry_2d_enable_if<R> = true>
+std::decay_t<R> _apply_binary_op_to_value_and_sparse_entry(L&& left_value, R&& right, Op&& op) {
+    return {right.i, right.j, std::forward<Op>(op)(std::forward<L>(left_value), std::forward<R>(right).value)};
+}
+
+// TODO:
+// Fix binary ops, figure out what the hell did I even do here
+
+// =============
+// --- Enums ---
+// =============
+
+// Parameter enums
+//
+// Their combination specifies compiled tensor API.
+enum class Dimension { VECTOR, MATRIX };
+enum class Type { DENSE, STRIDED, SPARSE };
+enum class Ownership { CONTAINER, VIEW, CONST_VIEW };
+
+// Config enums
+//
+// They specify conditional logic for a tensor.
+// Combination of config & parameter enums fully defines a GenericTensor.
+enum class Checking { NONE, BOUNDS };
+enum class Layout { /* 1D */ FLAT, /* 2D */ RC, CR, /* Other */ SPARSE };
+
+// Shortcut template used to deduce type of '_data' based on tensor 'ownership' parameter
+template <Ownership ownership, class ContainerResult, class ViewResult, class ConstViewResult>
+using _choose_based_on_ownership =
+    std::conditional_t<ownership == Ownership::CONTAINER, ContainerResult,
+                       std::conditional_t<ownership == Ownership::VIEW, ViewResult, ConstViewResult>>;
+
+// Shortcut template used to check that both arguments are tensors
+// that have the same value type, mostly used in binary operators
+// for nicer error messages and to prevent accidental conversions
+template <class L, class R>
+using _are_tensors_with_same_value_type_enable_if =
+    std::enable_if_t<_is_tensor_v<L> && _is_tensor_v<R> &&
+                         std::is_same_v<typename std::decay_t<L>::value_type, typename std::decay_t<R>::value_type>,
+                     bool>;
+
+// =====================================
+// --- Boilerplate generation macros ---
+// =====================================
+
+// Macros used to pass around unwieldy chains of tensor template arguments.
+//
+#define utl_mvl_tensor_arg_defs                                                                                        \
+    class T, Dimension _dimension, Type _type, Ownership _ownership, Checking _checking, Layout _layout
+
+#define utl_mvl_tensor_arg_vals T, _dimension, _type, _ownership, _checking, _layout
+
+// Incredibly important macros used for conditional compilation of member functions.
+// They automatically create the boilerplate that makes member functions dependant on the template parameters,
+// which is necessary for conditional compilation and "forward" to a 'enable_if' condition.
+//
+// 'utl_mvl_require' is intended to be used inside template methods (template in a sense that they have other template
+// args besides this conditional compilation boilerplate which technically makes all methods template).
+//
+// 'utl_mvl_reqs' is used when we want only conditional compilation (aka majority of cases) and cuts down on
+// boilerplate even more.
+//
+#define utl_mvl_require(condition_)                                                                                    \
+    class value_type = T, Dimension dimension = _dimension, Type type = _type, Ownership ownership = _ownership,       \
+          Checking checking = _checking, Layout layout = _layout, std::enable_if_t<condition_, bool> = true
+
+#define utl_mvl_reqs(condition_) template <utl_mvl_require(condition_)>
+
+// A somewhat scuffed version of trait-defining macro used to create SFINAE-restrictions
+// on tensor params in free functions. Only supports trivial conditions of the form
+// '<parameter> [==][!=] <value>'. Perhaps there is a better way of doing it, but I'm not yet sure.
+//
+// Used mostly to restrict linear algebra operations for sparse/nonsparse so we can get
+// a "SFINAE-driven overloading" on operators that take both arguments with perfect forwarding,
+// which means they can't be overloaded in a regular way
+//
+#define utl_mvl_define_tensor_param_restriction(trait_name_, expr_)                                                    \
+    template <class T>                                                                                                 \
+    constexpr bool trait_name_##_v = (std::decay_t<T>::params::expr_);                                                 \
+                                                                                                                       \
+    template <class T>                                                                                                 \
+    using trait_name_##_enable_if = std::enable_if_t<trait_name_##_v<T>, bool>;
+
+utl_mvl_define_tensor_param_restriction(_is_sparse_tensor, type == Type::SPARSE);
+utl_mvl_define_tensor_param_restriction(_is_nonsparse_tensor, type != Type::SPARSE);
+utl_mvl_define_tensor_param_restriction(_is_matrix_tensor, dimension == Dimension::MATRIX);
+
+// ===========================
+// --- Data Member Classes ---
+// ===========================
+
+// Unlike class method, member values can't be templated, which prevents us from using regular 'enable_if_t' SFINAE
+// for their conditional compilation. The (seemingly) best workaround to compile members conditionally is to inherit
+// 'std::conditional<T, EmptyClass>' where 'T' is a "dummy" class with the sole purpose of having data members to
+// inherit. This does not introduce virtualization (which is good, that how we want it).
+
+template <int id>
+struct _nothing {};
+
+template <utl_mvl_tensor_arg_defs>
+class _2d_extents {
+private:
+    using size_type = typename _types<T>::size_type;
+
+public:
+    size_type _rows = 0;
+    size_type _cols = 0;
+};
+
+template <utl_mvl_tensor_arg_defs>
+class _2d_strides {
+private:
+    using size_type = typename _types<T>::size_type;
+
+public:
+    size_type _row_stride = 0;
+    size_type _col_stride = 0;
+};
+
+template <utl_mvl_tensor_arg_defs>
+struct _2d_dense_data {
+private:
+    using value_type = typename _types<T>::value_type;
+    using _data_t    = _choose_based_on_ownership<_ownership, std::unique_ptr<value_type[]>, _observer_ptr<value_type>,
+                                                  _observer_ptr<const value_type>>;
+
+public:
+    _data_t _data;
+};
+
+template <utl_mvl_tensor_arg_defs>
+struct _2d_sparse_data {
+private:
+    using value_type = typename _types<T>::value_type;
+    using _triplet_t = _choose_based_on_ownership<_ownership, SparseEntry2D<value_type>,
+                                                  SparseEntry2D<std::reference_wrapper<value_type>>,
+                                                  SparseEntry2D<std::reference_wrapper<const value_type>>>;
+
+public:
+    using triplet_type = _triplet_t;
+
+    std::vector<triplet_type> _data;
+};
+
+// ===================
+// --- Tensor Type ---
+// ===================
+
+template <utl_mvl_tensor_arg_defs>
+class GenericTensor
+    // Conditionally compile member variables through inheritance
+    : public std::conditional_t<_dimension == Dimension::MATRIX, _2d_extents<utl_mvl_tensor_arg_vals>, _nothing<1>>,
+      public std::conditional_t<_dimension == Dimension::MATRIX && _type == Type::STRIDED,
+                                _2d_strides<utl_mvl_tensor_arg_vals>, _nothing<2>>,
+      public std::conditional_t<_type == Type::DENSE || _type == Type::STRIDED, _2d_dense_data<utl_mvl_tensor_arg_vals>,
+                                _nothing<3>>,
+      public std::conditional_t<_type == Type::SPARSE, _2d_sparse_data<utl_mvl_tensor_arg_vals>, _nothing<4>>
+// > After this point no non-static member variables will be introduced
+{
+    // --- Parameter reflection ---
+    // ----------------------------
+public:
+    struct params {
+        constexpr static auto dimension = _dimension;
+        constexpr static auto type      = _type;
+        constexpr static auto ownership = _ownership;
+        constexpr static auto checking  = _checking;
+        constexpr static auto layout    = _layout;
+
+        // Prevent impossible layouts
+        static_assert((dimension == Dimension::VECTOR) == (layout == Layout::FLAT), "Flat layout <=> matrix is 1D.");
+        static_assert((type == Type::SPARSE) == (layout == Layout::SPARSE), "Sparse layout <=> matrix is sparse.");
+    };
+
+    constexpr static bool is_tensor = true;
+
+    // --- Member types ---
+    // --------------------
+private:
+    using _type_wrapper = _types<T>;
+
+public:
+    using self            = GenericTensor;
+    using value_type      = typename _type_wrapper::value_type;
+    using size_type       = typename _type_wrapper::size_type;
+    using difference_type = typename _type_wrapper::difference_type;
+    using reference       = typename _type_wrapper::reference;
+    using const_reference = typename _type_wrapper::const_reference;
+    using pointer         = typename _type_wrapper::pointer;
+    using const_pointer   = typename _type_wrapper::const_pointer;
+
+    using owning_reflection = GenericTensor<value_type, params::dimension, params::type, Ownership::CONTAINER,
+                                            params::checking, params::layout>;
+    // container type corresponding to 'self', this is the return type of algebraic operations on a tensor
+
+    // --- Iterators ---
+    // -----------------
+public:
+    using const_iterator         = _flat_iterator<const self*, _type_wrapper, true>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+    using iterator = std::conditional_t<_ownership != Ownership::CONST_VIEW, _flat_iterator<self*, _type_wrapper>,
+                                        const_iterator>; // for const views 'iterator' is the same as 'const_iterator'
+    using reverse_iterator = std::reverse_iterator<iterator>;
+
+    [[nodiscard]] const_iterator cbegin() const { return const_iterator(this, 0); }
+    [[nodiscard]] const_iterator cend() const { return const_iterator(this, this->size()); }
+    [[nodiscard]] const_iterator begin() const { return this->cbegin(); }
+    [[nodiscard]] const_iterator end() const { return this->cend(); }
+
+    [[nodiscard]] const_reverse_iterator crbegin() const { return const_reverse_iterator(this->cend()); }
+    [[nodiscard]] const_reverse_iterator crend() const { return const_reverse_iterator(this->cbegin()); }
+    [[nodiscard]] const_reverse_iterator rbegin() const { return this->crbegin(); }
+    [[nodiscard]] const_reverse_iterator rend() const { return this->crend(); }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW)
+    [[nodiscard]] iterator begin() { return iterator(this, 0); }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW)
+    [[nodiscard]] iterator end() { return iterator(this, this->size()); }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW)
+    [[nodiscard]] reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW)
+    [[nodiscard]] reverse_iterator rend() { return reverse_iterator(this->begin()); }
+
+    // --- Basic getters ---
+    // ---------------------
+public:
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+    [[nodiscard]] size_type size() const noexcept { return this->rows() * this->cols(); }
+
+    utl_mvl_reqs(type == Type::SPARSE)
+    [[nodiscard]] size_type size() const noexcept { return this->_data.size(); }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX)
+    [[nodiscard]] size_type rows() const noexcept { return this->_rows; }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX)
+    [[nodiscard]] size_type cols() const noexcept { return this->_cols; }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE)
+    [[nodiscard]] constexpr size_type row_stride() const noexcept {
+        if constexpr (self::params::layout == Layout::RC) return 0;
+        if constexpr (self::params::layout == Layout::CR) return 1;
+        utl_mvl_unreachable;
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE)
+    [[nodiscard]] constexpr size_type col_stride() const noexcept {
+        if constexpr (self::params::layout == Layout::RC) return 1;
+        if constexpr (self::params::layout == Layout::CR) return 0;
+        utl_mvl_unreachable;
+    }
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED)
+    [[nodiscard]] size_type row_stride() const noexcept { return this->_row_stride; }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED)
+    [[nodiscard]] size_type col_stride() const noexcept { return this->_col_stride; }
+
+    utl_mvl_reqs(type == Type::DENSE || type == Type::STRIDED)
+    [[nodiscard]] const_pointer data() const noexcept { return this->_data.get(); }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && (type == Type::DENSE || type == Type::STRIDED))
+    [[nodiscard]] pointer data() noexcept { return this->_data.get(); }
+
+    [[nodiscard]] bool empty() const noexcept { return (this->size() == 0); }
+
+    // --- Advanced getters ---
+    // ------------------------
+    utl_mvl_reqs(_has_binary_op_equal<value_type>::value)
+    [[nodiscard]] bool contains(const_reference value) const {
+        return std::find(this->cbegin(), this->cend(), value) != this->cend();
+    }
+
+    utl_mvl_reqs(_has_binary_op_equal<value_type>::value)
+    [[nodiscard]] size_type count(const_reference value) const {
+        return std::count(this->cbegin(), this->cend(), value);
+    }
+
+    utl_mvl_reqs(_has_binary_op_less<value_type>::value)
+    [[nodiscard]] bool is_sorted() const { return std::is_sorted(this->cbegin(), this->cend()); }
+
+    template <class Compare>
+    [[nodiscard]] bool is_sorted(Compare cmp) const {
+        return std::is_sorted(this->cbegin(), this->cend(), cmp);
+    }
+
+    [[nodiscard]] std::vector<value_type> to_std_vector() const { return std::vector(this->cbegin(), this->cend()); }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE)
+    self transposed() const {
+        self res(this->cols(), this->rows());
+        this->for_each([&](const value_type& element, size_type i, size_type j) { res(j, i) = element; });
+        return res;
+    }
+
+    utl_mvl_reqs(ownership == Ownership::CONTAINER)
+    [[nodiscard]] self clone() const { return *this; }
+
+    utl_mvl_reqs(ownership == Ownership::CONTAINER)
+    [[nodiscard]] self move() & { return std::move(*this); }
+
+    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout>
+    [[nodiscard]] bool
+    compare_contents(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
+                                         other_checking, other_layout>& other) const {
+        // Surface-level checks
+        if ((this->rows() != other.rows()) || (this->cols() != other.cols())) return false;
+        // Compare while respecting sparsity
+        constexpr bool is_sparse_l = (self::params::type == Type::SPARSE);
+        constexpr bool is_sparse_r = (std::remove_reference_t<decltype(other)>::params::type == Type::SPARSE);
+        // Same sparsity comparison
+        if constexpr (is_sparse_l == is_sparse_r) {
+            return this->size() == other.size() &&
+                   this->true_for_all([&](const_reference e, size_type i, size_type j) { return e == other(i, j); });
+        }
+        // Different sparsity comparison
+        // TODO: Impl here and use .all_of() OR .any_of()
+        else
+            return true;
+    }
+
+    // --- Indexation ---
+    // ------------------
+public:
+    // Vector API
+    [[nodiscard]] const_reference front() const { return this->operator[](0); }
+    [[nodiscard]] const_reference back() const { return this->operator[](this->size() - 1); }
+    [[nodiscard]] reference       front() { return this->operator[](0); }
+    [[nodiscard]] reference       back() { return this->operator[](this->size() - 1); }
+
+private:
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED)
+    [[nodiscard]] size_type _get_memory_offset_strided_impl(size_type idx, size_type i, size_type j) const {
+        if constexpr (self::params::layout == Layout::RC) return idx * this->col_stride() + this->row_stride() * i;
+        if constexpr (self::params::layout == Layout::CR) return idx * this->row_stride() + this->col_stride() * j;
+        utl_mvl_unreachable;
+    }
+
+public:
+    utl_mvl_reqs(type == Type::DENSE)
+    [[nodiscard]] size_type get_memory_offset_of_idx(size_type idx) const {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
+        return idx;
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE)
+    [[nodiscard]] size_type get_memory_offset_of_ij(size_type i, size_type j) const {
+        return this->get_idx_of_ij(i, j);
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED)
+    [[nodiscard]] size_type get_memory_offset_of_idx(size_type idx) const {
+        const auto ij = this->get_ij_of_idx(idx);
+        return _get_memory_offset_strided_impl(idx, ij.i, ij.j);
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED)
+    [[nodiscard]] size_type get_memory_offset_of_ij(size_type i, size_type j) const {
+        const auto idx = this->get_idx_of_ij(i, j);
+        return _get_memory_offset_strided_impl(idx, i, j);
+    }
+
+public:
+    // - Flat indexation -
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::MATRIX &&
+                 (type == Type::DENSE || type == Type::STRIDED))
+    [[nodiscard]] reference operator[](size_type idx) { return this->data()[this->get_memory_offset_of_idx(idx)]; }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+    [[nodiscard]] const_reference operator[](size_type idx) const {
+        return this->data()[this->get_memory_offset_of_idx(idx)];
+    }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::VECTOR || type == Type::SPARSE)
+    [[nodiscard]] reference operator[](size_type idx) {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
+        return this->_data[idx].value;
+    }
+
+    utl_mvl_reqs(dimension == Dimension::VECTOR || type == Type::SPARSE)
+    [[nodiscard]] const_reference operator[](size_type idx) const {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
+        return this->_data[idx].value;
+    }
+
+    // - 2D indexation -
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::MATRIX &&
+                 (type == Type::DENSE || type == Type::STRIDED))
+    [[nodiscard]] reference operator()(size_type i, size_type j) {
+        return this->data()[this->get_memory_offset_of_ij(i, j)];
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+    [[nodiscard]] const_reference operator()(size_type i, size_type j) const {
+        return this->data()[this->get_memory_offset_of_ij(i, j)];
+    }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::MATRIX && type == Type::SPARSE)
+    [[nodiscard]] reference operator()(size_type i, size_type j) {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(i, j);
+        return this->_data[this->get_idx_of_ij(i, j)].value;
+    }
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
+    [[nodiscard]] const_reference operator()(size_type i, size_type j) const {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(i, j);
+        return this->_data[this->get_idx_of_ij(i, j)].value;
+    }
+
+    // --- Index conversions ---
+    // -------------------------
+
+    // - Bound checking -
+private:
+    void _bound_check_idx(size_type idx) const {
+        if (idx >= this->size())
+            throw std::out_of_range(
+                stringify("idx (which is ", idx, ") >= this->size() (which is ", this->size(), ")"));
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX)
+    void _bound_check_ij(size_type i, size_type j) const {
+        if (i >= this->rows())
+            throw std::out_of_range(stringify("i (which is ", i, ") >= this->rows() (which is ", this->rows(), ")"));
+        else if (j >= this->cols())
+            throw std::out_of_range(stringify("j (which is ", j, ") >= this->cols() (which is ", this->cols(), ")"));
+    }
+
+    // - Dense & strided implementations -
+private:
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+    [[nodiscard]] size_type _unchecked_get_idx_of_ij(size_type i, size_type j) const {
+        if constexpr (self::params::layout == Layout::RC) return i * this->cols() + j;
+        if constexpr (self::params::layout == Layout::CR) return j * this->rows() + i;
+        utl_mvl_unreachable;
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+    [[nodiscard]] Index2D _unchecked_get_ij_of_idx(size_type idx) const {
+        if constexpr (self::params::layout == Layout::RC) return {idx / this->cols(), idx % this->cols()};
+        if constexpr (self::params::layout == Layout::CR) return {idx % this->rows(), idx / this->rows()};
+        utl_mvl_unreachable;
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONTAINER)
+    [[nodiscard]] size_type _total_allocated_size() const noexcept {
+        // Note 1: Allocated size of the strided matrix is NOT equal to .size() (which is same as rows * cols)
+        // This is due to all the padding between the actual elements
+        // Note 2: The question of whether .size() should return the number of 'strided' elements or the number
+        // of actually allocated elements is rather perplexing, while the second option is more "correct" its
+        // usefulness is dubious at bets, while the first one does in fact allow convenient 1D iteration over
+        // all the elements. Option 1 also provides an API consistent with strided views, which is why it ended
+        // up being the one chosen
+        //
+        // This method returns a true allocated size
+        if constexpr (self::params::layout == Layout::RC)
+            return (this->rows() - 1) * this->row_stride() + this->rows() * this->cols() * this->col_stride();
+        if constexpr (self::params::layout == Layout::CR)
+            return (this->cols() - 1) * this->col_stride() + this->rows() * this->cols() * this->row_stride();
+        utl_mvl_unreachable;
+    }
+
+public:
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+    [[nodiscard]] size_type get_idx_of_ij(size_type i, size_type j) const {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_ij(i, j);
+        return _unchecked_get_idx_of_ij(i, j);
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+    [[nodiscard]] Index2D get_ij_of_idx(size_type idx) const {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
+        return _unchecked_get_ij_of_idx(idx);
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+    [[nodiscard]] size_type extent_major() const noexcept {
+        if constexpr (self::params::layout == Layout::RC) return this->rows();
+        if constexpr (self::params::layout == Layout::CR) return this->cols();
+        utl_mvl_unreachable;
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
+    [[nodiscard]] size_type extent_minor() const noexcept {
+        if constexpr (self::params::layout == Layout::RC) return this->cols();
+        if constexpr (self::params::layout == Layout::CR) return this->rows();
+        utl_mvl_unreachable;
+    }
+
+    // - Sparse implementations -
+private:
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
+    [[nodiscard]] size_type _search_ij(size_type i, size_type j) const noexcept {
+        // Returns this->size() if {i, j} wasn't found.
+        // Linear search for small .size() (more efficient fue to prediction and cache locality)
+        if (true) {
+            for (size_type idx = 0; idx < this->size(); ++idx)
+                if (this->_data[idx].i == i && this->_data[idx].j == j) return idx;
+            return this->size();
+        }
+        // TODO: Binary search for larger .size() (N(log2(size)) instead of N(size) asymptotically)
+    }
+
+public:
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
+    [[nodiscard]] size_type get_idx_of_ij(size_type i, size_type j) const {
+        const size_type idx = this->_search_ij(i, j);
+        // Return this->size() if {i, j} wasn't found. Throw with bound checking.
+        if constexpr (self::params::checking == Checking::BOUNDS)
+            if (idx == this->size())
+                throw std::out_of_range(stringify("Index { ", i, ", ", j, "} in not a part of sparse matrix"));
+        return idx;
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
+    [[nodiscard]] Index2D get_ij_of_idx(size_type idx) const {
+        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
+        return Index2D{this->_data[idx].i, this->_data[idx].j};
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
+    [[nodiscard]] bool contains_index(size_type i, size_type j) const noexcept {
+        return this->_search_ij(i, j) != this->size();
+    }
+
+    // --- Reductions ---
+    // ------------------
+    utl_mvl_reqs(_has_binary_op_plus<value_type>::value)
+    [[nodiscard]] value_type sum() const { return std::accumulate(this->cbegin(), this->cend(), value_type()); }
+
+    utl_mvl_reqs(_has_binary_op_multiplies<value_type>::value)
+    [[nodiscard]] value_type product() const {
+        return std::accumulate(this->cbegin(), this->cend(), value_type(), std::multiplies<value_type>());
+    }
+
+    utl_mvl_reqs(_has_binary_op_less<value_type>::value)
+    [[nodiscard]] value_type min() const { return *std::min_element(this->cbegin(), this->cend()); }
+
+    utl_mvl_reqs(_has_binary_op_less<value_type>::value)
+    [[nodiscard]] value_type max() const { return *std::max_element(this->cbegin(), this->cend()); }
+
+    // --- Predicate operations ---
+    // ----------------------------
+    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference)> = true>
+    [[nodiscard]] bool true_for_any(PredType predicate) const {
+        for (size_type idx = 0; idx < this->size(); ++idx)
+            if (predicate(this->operator[](idx), idx)) return true;
+        return false;
+    }
+
+    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type)> = true>
+    [[nodiscard]] bool true_for_any(PredType predicate) const {
+        for (size_type idx = 0; idx < this->size(); ++idx)
+            if (predicate(this->operator[](idx), idx)) return true;
+        return false;
+    }
+
+    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX)>
+    [[nodiscard]] bool true_for_any(PredType predicate) const {
+        // Loop over all 2D indices using 1D loop with idx->ij conversion
+        // This is just as fast and ensures looping only over existing elements in non-dense matrices
+        for (size_type idx = 0; idx < this->size(); ++idx) {
+            const auto ij = this->get_ij_of_idx(idx);
+            if (predicate(this->operator[](idx), ij.i, ij.j)) return true;
+        }
+        return false;
+    }
+
+    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference)> = true>
+    [[nodiscard]] bool true_for_all(PredType predicate) const {
+        auto inverse_predicate = [&](const_reference e) -> bool { return !predicate(e); };
+        return !this->true_for_any(inverse_predicate);
+    }
+
+    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type)> = true>
+    [[nodiscard]] bool true_for_all(PredType predicate) const {
+        auto inverse_predicate = [&](const_reference e, size_type idx) -> bool { return !predicate(e, idx); };
+        return !this->true_for_any(inverse_predicate);
+    }
+
+    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX)>
+    [[nodiscard]] bool true_for_all(PredType predicate) const {
+        // We can reuse .true_for_any() with inverted predicate due to following conjecture:
+        // FOR_ALL (predicate)  ~  ! FOR_ANY (!predicate)
+        auto inverse_predicate = [&](const_reference e, size_type i, size_type j) -> bool {
+            return !predicate(e, i, j);
+        };
+        return !this->true_for_any(inverse_predicate);
+    }
+
+    // --- Const algorithms ---
+    // ------------------------
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference)> = true>
+    const self& for_each(FuncType func) const {
+        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx));
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type)> = true>
+    const self& for_each(FuncType func) const {
+        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx), idx);
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX)>
+    const self& for_each(FuncType func) const {
+        // Loop over all 2D indices using 1D loop with idx->ij conversion.
+        // This is just as fast and ensures looping only over existing elements in non-dense matrices.
+        for (size_type idx = 0; idx < this->size(); ++idx) {
+            const auto ij = this->get_ij_of_idx(idx);
+            func(this->operator[](idx), ij.i, ij.j);
+        }
+        return *this;
+    }
+
+    // --- Mutating algorithms ---
+    // ---------------------------
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference)> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& for_each(FuncType func) {
+        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx));
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type)> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& for_each(FuncType func) {
+        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx), idx);
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX)>
+    self& for_each(FuncType func) {
+        for (size_type idx = 0; idx < this->size(); ++idx) {
+            const auto ij = this->get_ij_of_idx(idx);
+            func(this->operator[](idx), ij.i, ij.j);
+        }
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(const_reference)> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& transform(FuncType func) {
+        const auto func_wrapper = [&](reference elem) { elem = func(elem); };
+        return this->for_each(func_wrapper);
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(const_reference, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::VECTOR && ownership != Ownership::CONST_VIEW)>
+    self& transform(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i) { elem = func(elem, i); };
+        return this->for_each(func_wrapper);
+    }
+
+    template <class FuncType,
+              _has_signature_enable_if<FuncType, value_type(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
+    self& transform(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i, size_type j) { elem = func(elem, i, j); };
+        return this->for_each(func_wrapper);
+    }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW)
+    self& fill(const_reference value) {
+        for (size_type idx = 0; idx < this->size(); ++idx) this->operator[](idx) = value;
+        return *this;
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type()> = true,
+              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& fill(FuncType func) {
+        const auto func_wrapper = [&](reference elem) { elem = func(); };
+        return this->for_each(func_wrapper);
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(size_type)> = true,
+              utl_mvl_require(dimension == Dimension::VECTOR && ownership != Ownership::CONST_VIEW)>
+    self& fill(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i) { elem = func(i); };
+        return this->for_each(func_wrapper);
+    }
+
+    template <class FuncType, _has_signature_enable_if<FuncType, value_type(size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
+    self& fill(FuncType func) {
+        const auto func_wrapper = [&](reference elem, size_type i, size_type j) { elem = func(i, j); };
+        return this->for_each(func_wrapper);
+    }
+
+    template <class Compare, utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& sort(Compare cmp) {
+        std::sort(this->begin(), this->end(), cmp);
+        return *this;
+    }
+    template <class Compare, utl_mvl_require(ownership != Ownership::CONST_VIEW)>
+    self& stable_sort(Compare cmp) {
+        std::stable_sort(this->begin(), this->end(), cmp);
+        return *this;
+    }
+
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && _has_binary_op_less<value_type>::value)
+    self& sort() {
+        std::sort(this->begin(), this->end());
+        return *this;
+    }
+    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && _has_binary_op_less<value_type>::value)
+    self& stable_sort() {
+        std::stable_sort(this->begin(), this->end());
+        return *this;
+    }
+
+    // --- Sparse Subviews ---
+    // -----------------------
+
+    // - Const views -
+private:
+    using _cref_triplet_array =
+        std::vector<SparseEntry2D<std::reference_wrapper<const value_type>>>; // NOTE: Generalize for 1D
+
+public:
+    using sparse_const_view_type = GenericTensor<value_type, self::params::dimension, Type::SPARSE,
+                                                 Ownership::CONST_VIEW, self::params::checking, Layout::SPARSE>;
+
+    template <class UnaryPredicate, _has_signature_enable_if<UnaryPredicate, bool(const_reference)> = true>
+    [[nodiscard]] sparse_const_view_type filter(UnaryPredicate predicate) const {
+        const auto forwarded_predicate = [&](const_reference elem, size_type, size_type) -> bool {
+            return predicate(elem);
+        };
+        return this->filter(forwarded_predicate);
+        // NOTE: This would need its own implementation for a proper 1D support
+    }
+
+    template <class UnaryPredicate, _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type)> = true>
+    [[nodiscard]] sparse_const_view_type filter(UnaryPredicate predicate) const {
+        const auto forwarded_predicate = [&](const_reference elem, size_type i, size_type j) -> bool {
+            const size_type idx = this->get_idx_of_ij(i, j);
+            return predicate(elem, idx);
+        };
+        return this->filter(forwarded_predicate);
+        // NOTE: This would need its own implementation for a proper 1D support
+    }
+
+    template <class UnaryPredicate,
+              _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX)>
+    [[nodiscard]] sparse_const_view_type filter(UnaryPredicate predicate) const {
+        // We can't preallocate triplets without scanning predicate through the whole matrix,
+        // so we just push back entries into a vector and use to construct a sparse view
+        _cref_triplet_array triplets;
+        const auto          add_triplet_if_predicate = [&](const_reference elem, size_type i, size_type j) -> void {
+            if (predicate(elem, i, j)) triplets.push_back({i, j, elem});
+        };
+
+        this->for_each(add_triplet_if_predicate);
+
+        triplets.shrink_to_fit();
+        return sparse_const_view_type(this->rows(), this->cols(), std::move(triplets));
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX)
+    [[nodiscard]] sparse_const_view_type diagonal() const {
+        // Sparse matrices have no better way of getting a diagonal than filtering (i ==j)
+        if constexpr (self::params::type == Type::SPARSE) {
+            return this->filter([](const_reference, size_type i, size_type j) { return i == j; });
+        }
+        // Non-sparse matrices can just iterate over diagonal directly
+        else {
+            const size_type     min_size = std::min(this->rows(), this->cols());
+            _cref_triplet_array triplets;
+            triplets.reserve(min_size);
+            for (size_type k = 0; k < min_size; ++k) triplets.push_back({k, k, this->operator()(k, k)});
+            return sparse_const_view_type(this->rows(), this->cols(), std::move(triplets));
+        }
+    }
+
+    // - Mutable views -
+private:
+    using _ref_triplet_array =
+        std::vector<SparseEntry2D<std::reference_wrapper<value_type>>>; // NOTE: Generalize for 1D
+
+public:
+    using sparse_view_type = GenericTensor<value_type, self::params::dimension, Type::SPARSE, Ownership::VIEW,
+                                           self::params::checking, Layout::SPARSE>;
+
+    template <class UnaryPredicate, utl_mvl_require(ownership != Ownership::CONST_VIEW),
+              _has_signature_enable_if<UnaryPredicate, bool(const_reference)> = true>
+    [[nodiscard]] sparse_view_type filter(UnaryPredicate predicate) {
+        const auto forwarded_predicate = [&](const_reference elem, size_type, size_type) -> bool {
+            return predicate(elem);
+        };
+        return this->filter(forwarded_predicate);
+        // NOTE: This would need its own implementation for a proper 1D support
+    }
+
+    template <class UnaryPredicate, utl_mvl_require(ownership != Ownership::CONST_VIEW),
+              _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type)> = true>
+    [[nodiscard]] sparse_view_type filter(UnaryPredicate predicate) {
+        const auto forwarded_predicate = [&](const_reference elem, size_type i, size_type j) -> bool {
+            const size_type idx = this->get_idx_of_ij(i, j);
+            return predicate(elem, idx);
+        };
+        return this->filter(forwarded_predicate);
+        // NOTE: This would need its own implementation for a proper 1D support
+    }
+
+    template <class UnaryPredicate,
+              _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type, size_type)> = true,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
+    [[nodiscard]] sparse_view_type filter(UnaryPredicate predicate) {
+        // This method implements actual filtering, others just forward predicates to it
+        _ref_triplet_array triplets;
+        // We can't preallocate triplets without scanning predicate through the whole matrix,
+        // so we just push back entries into a vector and use to construct a sparse view
+        const auto         add_triplet_if_predicate = [&](reference elem, size_type i, size_type j) -> void {
+            if (predicate(elem, i, j)) triplets.push_back({i, j, elem});
+        };
+
+        this->for_each(add_triplet_if_predicate);
+
+        triplets.shrink_to_fit();
+        return sparse_view_type(this->rows(), this->cols(), std::move(triplets));
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)
+    [[nodiscard]] sparse_view_type diagonal() {
+        /* Sparse matrices have no better way of getting a diagonal than filtering (i == j) */
+        if constexpr (self::params::type == Type::SPARSE) {
+            return this->filter([](const_reference, size_type i, size_type j) { return i == j; });
+        } /* Non-sparse matrices can just iterate over diagonal directly */
+        else {
+            const size_type    min_size = std::min(this->rows(), this->cols());
+            _ref_triplet_array triplets;
+            triplets.reserve(min_size);
+            for (size_type k = 0; k < min_size; ++k) triplets.push_back({k, k, this->operator()(k, k)});
+            return sparse_view_type(this->rows(), this->cols(), std::move(triplets));
+        }
+    }
+
+    // --- Block Subviews ---
+    // ----------------------
+public:
+    // - Const views -
+    using block_const_view_type =
+        std::conditional_t<self::params::type == Type::SPARSE, sparse_const_view_type,
+                           GenericTensor<value_type, self::params::dimension, Type::STRIDED, Ownership::CONST_VIEW,
+                                         self::params::checking, self::params::layout>>;
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
+    [[nodiscard]] block_const_view_type block(size_type block_i, size_type block_j, size_type block_rows,
+                                              size_type block_cols) const {
+        // Sparse matrices have no better way of getting a block than filtering by { i, j }
+
+        // Do the same thing as in .filter(), but shrink resulting view size to
+        // { block_rows, block_cols } and shift indexation by { block_i, block_j }
+        _cref_triplet_array triplets;
+
+        const auto add_triplet_if_inside_block = [&](const_reference elem, size_type i, size_type j) -> void {
+            if ((block_i <= i) && (i < block_i + block_rows) && (block_j <= j) && (j < block_j + block_cols))
+                triplets.push_back({i - block_i, j - block_j, elem});
+        };
+
+        this->for_each(add_triplet_if_inside_block);
+
+        triplets.shrink_to_fit();
+        return block_const_view_type(block_rows, block_cols, std::move(triplets));
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type != Type::SPARSE)
+    [[nodiscard]] block_const_view_type block(size_type block_i, size_type block_j, size_type block_rows,
+                                              size_type block_cols) const {
+        if constexpr (self::params::layout == Layout::RC) {
+            const size_type row_stride = this->row_stride() + this->col_stride() * (this->cols() - block_cols);
+            const size_type col_stride = this->col_stride();
+            return block_const_view_type(block_rows, block_cols, row_stride, col_stride,
+                                         &this->operator()(block_i, block_j));
+        }
+        if constexpr (self::params::layout == Layout::CR) {
+            const size_type row_stride = this->row_stride();
+            const size_type col_stride = this->col_stride() + this->row_stride() * (this->rows() - block_rows);
+            return block_const_view_type(block_rows, block_cols, row_stride, col_stride,
+                                         &this->operator()(block_i, block_j));
+        }
+        utl_mvl_unreachable;
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX)
+    [[nodiscard]] block_const_view_type row(size_type i) const { return this->block(i, 0, 1, this->cols()); }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX)
+    [[nodiscard]] block_const_view_type col(size_type j) const { return this->block(0, j, this->rows(), 1); }
+
+    // - Mutable views -
+    using block_view_type =
+        std::conditional_t<self::params::type == Type::SPARSE, sparse_view_type,
+                           GenericTensor<value_type, self::params::dimension, Type::STRIDED, Ownership::VIEW,
+                                         self::params::checking, self::params::layout>>;
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE && ownership != Ownership::CONST_VIEW)
+    [[nodiscard]] block_view_type block(size_type block_i, size_type block_j, size_type block_rows,
+                                        size_type block_cols) {
+        // Sparse matrices have no better way of getting a block than filtering by { i, j }
+
+        // Do the same thing as in .filter(), but shrink resulting view size to
+        // { block_rows, block_cols } and shift indexation by { block_i, block_j }
+        _ref_triplet_array triplets;
+
+        const auto add_triplet_if_inside_block = [&](reference elem, size_type i, size_type j) -> void {
+            if ((block_i <= i) && (i < block_i + block_rows) && (block_j <= j) && (j < block_j + block_cols))
+                triplets.push_back({i - block_i, j - block_j, elem});
+        };
+
+        this->for_each(add_triplet_if_inside_block);
+
+        triplets.shrink_to_fit();
+        return block_view_type(block_rows, block_cols, std::move(triplets));
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type != Type::SPARSE && ownership != Ownership::CONST_VIEW)
+    [[nodiscard]] block_view_type block(size_type block_i, size_type block_j, size_type block_rows,
+                                        size_type block_cols) {
+        if constexpr (self::params::layout == Layout::RC) {
+            const size_type row_stride = this->row_stride() + this->col_stride() * (this->cols() - block_cols);
+            const size_type col_stride = this->col_stride();
+            return block_view_type(block_rows, block_cols, row_stride, col_stride, &this->operator()(block_i, block_j));
+        }
+        if constexpr (self::params::layout == Layout::CR) {
+            const size_type row_stride = this->row_stride();
+            const size_type col_stride = this->col_stride() + this->row_stride() * (this->rows() - block_rows);
+            return block_view_type(block_rows, block_cols, row_stride, col_stride, &this->operator()(block_i, block_j));
+        }
+        utl_mvl_unreachable;
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)
+    [[nodiscard]] block_view_type row(size_type i) { return this->block(i, 0, 1, this->cols()); }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)
+    [[nodiscard]] block_view_type col(size_type j) { return this->block(0, j, this->rows(), 1); }
+
+    // --- Sparse operations ---
+    // -------------------------
+
+private:
+    using _triplet_t = _choose_based_on_ownership<_ownership, SparseEntry2D<value_type>,
+                                                  SparseEntry2D<std::reference_wrapper<value_type>>,
+                                                  SparseEntry2D<std::reference_wrapper<const value_type>>>;
+
+public:
+    using sparse_entry_type = _triplet_t;
+
+    utl_mvl_reqs(type == Type::SPARSE)
+    [[nodiscard]] const std::vector<sparse_entry_type>& entries() const noexcept { return this->_data; }
+
+    utl_mvl_reqs(type == Type::SPARSE && ownership != Ownership::CONST_VIEW)
+    [[nodiscard]] std::vector<sparse_entry_type>& entries() noexcept { return this->_data; }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
+    self& insert_triplets(const std::vector<sparse_entry_type>& triplets) {
+        // Bulk-insert triplets and sort by index
+        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
+            return (l.i < r.i) && (l.j < r.j);
+        };
+
+        this->_data.insert(this->_data.end(), triplets.begin(), triplets.end());
+        std::sort(this->_data.begin(), this->_data.end(), ordering);
+
+        return *this;
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
+    self& rewrite_triplets(std::vector<sparse_entry_type>&& triplets) {
+        // Move-construct all triplets at once and sort by index
+        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
+            return (l.i < r.i) && (l.j < r.j);
+        };
+
+        this->_data = std::move(triplets);
+        std::sort(this->_data.begin(), this->_data.end(), ordering);
+
+        return *this;
+    }
+
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
+    self& erase_triplets(std::vector<Index2D> indices) {
+        // Erase triplets with {i, j} from 'indices' using the fact that both
+        // 'indices' and triplets are sorted. We can scan through triplets once
+        // while advancing 'cursor' when 'indices[cursor]' gets deleted, which
+        // result in all necessary triplets being marked for erasure in order.
+        std::sort(indices.begin(), indices.end());
+        std::size_t cursor = 0;
+
+        const auto erase_condition = [&](const sparse_entry_type& triplet) -> bool {
+            /* Stop erasing once all target indices are handled */
+            if (cursor == indices.size()) return false;
+            if (indices[cursor].i == triplet.i && indices[cursor].j == triplet.j) {
+                ++cursor;
+                return true;
+            }
+            return false;
+        };
+
+        const auto iter = std::remove_if(this->_data.begin(), this->_data.end(), erase_condition);
+        this->_data.erase(iter, this->_data.end());
+
+        // Re-sort triplets just in case
+        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
+            return (l.i < r.i) && (l.j < r.j);
+        };
+        std::sort(this->_data.begin(), this->_data.end(), ordering);
+
+        return *this;
+    }
+
+    // --- Constructors ---
+    // --------------------
+
+    // - Matrix -
+public:
+    // Rule of five:
+    // copy-ctor       - [+] (deduced from copy-assignment)
+    // move-ctor       - [+] (= default)
+    // copy-assignment - [+] (custom for dense/strided, same as default for sparse)
+    // move-assignment - [+] (= default)
+    // destructor      - [+] (= default)
+
+    // Move-ctor is default for all types
+    GenericTensor(self&& other) noexcept = default;
+
+    // Move-assignment is default for all types
+    self& operator=(self&& other) noexcept = default;
+
+    // Copy-ctor is deduced from assignment operator
+    GenericTensor(const self& other) { *this = other; }
+
+    // Copy-assignment
+    self& operator=(const self& other) {
+        // Note: copy-assignment operator CANNOT be templated, it has to be implemented with 'if constexpr'
+        this->_rows = other.rows();
+        this->_cols = other.cols();
+        if constexpr (self::params::type == Type::DENSE) {
+            this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
+            std::copy(other.begin(), other.end(), this->begin());
+        }
+        if constexpr (self::params::type == Type::STRIDED) {
+            this->_row_stride = other.row_stride();
+            this->_col_stride = other.col_stride();
+            this->_data       = std::move(_make_unique_ptr_array<value_type>(this->size()));
+            std::copy(other.begin(), other.end(), this->begin());
+        }
+        if constexpr (self::params::type == Type::SPARSE) { this->_data = other._data; }
+        return *this;
+    }
+
+    // Default-ctor (containers)
+    utl_mvl_reqs(ownership == Ownership::CONTAINER)
+    GenericTensor() noexcept {}
+
+    // Default-ctor (views)
+    utl_mvl_reqs(ownership != Ownership::CONTAINER)
+    GenericTensor() noexcept = delete;
+
+    // Copy-assignment over the config boundaries
+    // We can change checking config, copy from matrices with different layouts,
+    // copy from views and even matrices of other types
+    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
+                              ownership == Ownership::CONTAINER)>
+    self& operator=(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
+                                        other_checking, other_layout>& other) {
+        this->_rows = other.rows();
+        this->_cols = other.cols();
+        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
+        this->fill(value_type());
+        other.for_each([&](const value_type& element, size_type i, size_type j) { this->operator()(i, j) = element; });
+        return *this;
+        // copying from sparse to dense works, all elements that weren't in the sparse matrix remain default-initialized
+    }
+
+    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
+                              ownership == Ownership::CONTAINER)>
+    self& operator=(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
+                                        other_checking, other_layout>& other) {
+        this->_rows       = other.rows();
+        this->_cols       = other.cols();
+        this->_row_stride = other.row_stride();
+        this->_col_stride = other.col_stride();
+        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->size()));
+        this->fill(value_type());
+        // Not quite sure whether swapping strides when changing layouts like this is okay,
+        // but it seems to be correct
+        if constexpr (self::params::layout != other_layout) std::swap(this->_row_stride, this->_cols_stride);
+        other.for_each([&](const value_type& element, size_type i, size_type j) { this->operator()(i, j) = element; });
+        return *this;
+        // copying from sparse to strided works, all elements that weren't in the sparse matrix remain
+        // default-initialized
+    }
+
+    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::SPARSE &&
+                              ownership == Ownership::CONTAINER)>
+    self& operator=(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
+                                        other_checking, other_layout>& other) {
+        this->_rows = other.rows();
+        this->_cols = other.cols();
+        std::vector<sparse_entry_type> triplets;
+
+        // Other sparse matrices can be trivially copied
+        if constexpr (other_type == Type::SPARSE) {
+            triplets.reserve(other.size());
+            other.for_each([&](const value_type& elem, size_type i, size_type j) { triplets.push_back({i, j, elem}); });
+        }
+        // Non-sparse matrices are filtered by non-default-initialized-elements to construct a sparse subset
+        else {
+            other.for_each([&](const_reference elem, size_type i, size_type j) {
+                if (elem != value_type()) triplets.push_back({i, j, elem});
+            });
+        }
+
+        this->rewrite_triplets(std::move(triplets));
+        return *this;
+    }
+
+    // Copy-ctor over the config boundaries (deduced from assignment over config boundaries)
+    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership == Ownership::CONTAINER)>
+    GenericTensor(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership, other_checking,
+                                      other_layout>& other) {
+        *this = other;
+    }
+
+    // Move-assignment over config boundaries
+    // Note: Unlike copying, we can't change layout, only checking config
+    // Also 'other' can no longer be a view or have a different type
+    template <Checking other_checking, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
+                                                       ownership == Ownership::CONTAINER)>
+    self& operator=(GenericTensor<value_type, self::params::dimension, self::params::type, self::params::ownership,
+                                  other_checking, self::params::layout>&& other) {
+        this->_rows = other.rows();
+        this->_cols = other.cols();
+        this->_data = std::move(other._data);
+        return *this;
+    }
+
+    template <Checking other_checking, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
+                                                       ownership == Ownership::CONTAINER)>
+    self& operator=(GenericTensor<value_type, self::params::dimension, self::params::type, self::params::ownership,
+                                  other_checking, self::params::layout>&& other) {
+        this->_rows       = other.rows();
+        this->_cols       = other.cols();
+        this->_row_stride = other.row_stride();
+        this->_col_stride = other.col_stride();
+        this->_data       = std::move(other._data);
+        return *this;
+    }
+
+    template <Checking other_checking, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::SPARSE &&
+                                                       ownership == Ownership::CONTAINER)>
+    self& operator=(GenericTensor<value_type, self::params::dimension, self::params::type, self::params::ownership,
+                                  other_checking, self::params::layout>&& other) {
+        this->_rows = other.rows();
+        this->_cols = other.cols();
+        this->_data = std::move(other._data);
+        return *this;
+    }
+
+    // Move-ctor over the config boundaries (deduced from move-assignment over config boundaries)
+    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && ownership == Ownership::CONTAINER)>
+    GenericTensor(GenericTensor<value_type, self::params::dimension, other_type, other_ownership, other_checking,
+                                other_layout>&& other) {
+        *this = std::move(other);
+    }
+
+    // Init-with-value
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::CONTAINER)
+    explicit GenericTensor(size_type rows, size_type cols, const_reference value = value_type()) {
+        this->_rows = rows;
+        this->_cols = cols;
+        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
+        this->fill(value);
+    }
+
+    // Init-with-lambda
+    template <class FuncType, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
+                                              ownership == Ownership::CONTAINER)>
+    explicit GenericTensor(size_type rows, size_type cols, FuncType init_func) {
+        // .fill() already takes care of preventing improper values of 'FuncType', no need to do the check here
+        this->_rows = rows;
+        this->_cols = cols;
+        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
+        this->fill(init_func);
+    }
+
+    // Init-with-ilist
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::CONTAINER)
+    GenericTensor(std::initializer_list<std::initializer_list<value_type>> init) {
+        this->_rows = init.size();
+        this->_cols = (*init.begin()).size();
+        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
+
+        // Check dimensions (throw if cols have different dimensions)
+        for (auto row_it = init.begin(); row_it < init.end(); ++row_it)
+            if (static_cast<size_type>((*row_it).end() - (*row_it).begin()) != this->cols())
+                throw std::invalid_argument("Initializer list dimensions don't match.");
+
+        // Copy elements
+        for (size_type i = 0; i < this->rows(); ++i)
+            for (size_type j = 0; j < this->cols(); ++j) this->operator()(i, j) = (init.begin()[i]).begin()[j];
+    }
+
+    // Init-with-data
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::CONTAINER)
+    explicit GenericTensor(size_type rows, size_type cols, pointer data_ptr) noexcept {
+        this->_rows = rows;
+        this->_cols = cols;
+        this->_data = std::move(decltype(this->_data)(data_ptr));
+    }
+
+    // - Matrix View -
+
+    // Init-from-data
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::VIEW)
+    explicit GenericTensor(size_type rows, size_type cols, pointer data_ptr) {
+        this->_rows = rows;
+        this->_cols = cols;
+        this->_data = data_ptr;
+    }
+
+    // Init-from-tensor (any tensor of the same API type)
+    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::VIEW)>
+    GenericTensor(GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
+                                other_checking, other_layout>& other) {
+        this->_rows = other.rows();
+        this->_cols = other.cols();
+        this->_data = other.data();
+    }
+
+    // - Const Matrix View -
+
+    // Init-from-data
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::CONST_VIEW)
+    explicit GenericTensor(size_type rows, size_type cols, const_pointer data_ptr) {
+        this->_rows = rows;
+        this->_cols = cols;
+        this->_data = data_ptr;
+    }
+
+    // Init-from-tensor (any tensor of the same API type)
+    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
+                              ownership == Ownership::CONST_VIEW)>
+    GenericTensor(const GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
+                                      other_checking, other_layout>& other) {
+        this->_rows = other.rows();
+        this->_cols = other.cols();
+        this->_data = other.data();
+    }
+
+    // - Strided Matrix -
+
+    // Init-with-value
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONTAINER)
+    explicit GenericTensor(size_type rows, size_type cols, size_type row_stride, size_type col_stride,
+                           const_reference value = value_type()) {
+        this->_rows       = rows;
+        this->_cols       = cols;
+        this->_row_stride = row_stride;
+        this->_col_stride = col_stride;
+        // Allocates size is NOT the same as .size() due to padding, see notes on '_total_allocated_size()'
+        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
+        this->fill(value);
+    }
+
+    // Init-with-lambda
+    template <class FuncType, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
+                                              ownership == Ownership::CONTAINER)>
+    explicit GenericTensor(size_type rows, size_type cols, size_type row_stride, size_type col_stride,
+                           FuncType init_func) {
+        // .fill() already takes care of preventing improper values of 'FuncType', no need to do the check here
+        this->_rows       = rows;
+        this->_cols       = cols;
+        this->_row_stride = row_stride;
+        this->_col_stride = col_stride;
+        // Allocates size is NOT the same as .size() due to padding, see notes on '_total_allocated_size()'
+        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
+        this->fill(init_func);
+    }
+
+    // Init-with-ilist
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONTAINER)
+    GenericTensor(std::initializer_list<std::initializer_list<value_type>> init, size_type row_stride,
+                  size_type col_stride) {
+        this->_rows       = init.size();
+        this->_cols       = (*init.begin()).size();
+        this->_row_stride = row_stride;
+        this->_col_stride = col_stride;
+        // Allocates size is NOT the same as .size() due to padding, see notes on '_total_allocated_size()'
+        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
+
+        // Check dimensions (throw if cols have different dimensions)
+        for (auto row_it = init.begin(); row_it < init.end(); ++row_it)
+            if ((*row_it).end() - (*row_it).begin() != this->_cols)
+                throw std::invalid_argument("Initializer list dimensions don't match.");
+
+        // Copy elements
+        for (size_type i = 0; i < this->rows(); ++i)
+            for (size_type j = 0; j < this->cols(); ++j) this->operator()(i, j) = (init.begin()[i]).begin()[j];
+    }
+
+    // Init-with-data
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONTAINER)
+    explicit GenericTensor(size_type rows, size_type cols, size_type row_stride, size_type col_stride,
+                           pointer data_ptr) noexcept {
+        this->_rows       = rows;
+        this->_cols       = cols;
+        this->_row_stride = row_stride;
+        this->_col_stride = col_stride;
+        this->_data       = std::move(decltype(this->_data)(data_ptr));
+    }
+
+    // - Strided Matrix View -
+
+    // Init-from-data
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::VIEW)
+    explicit GenericTensor(size_type rows, size_type cols, size_type row_stride, size_type col_stride,
+                           pointer data_ptr) {
+        this->_rows       = rows;
+        this->_cols       = cols;
+        this->_row_stride = row_stride;
+        this->_col_stride = col_stride;
+        this->_data       = data_ptr;
+    }
+
+    // Init-from-tensor (any tensor of the same API type)
+    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::VIEW)>
+    GenericTensor(GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
+                                other_checking, other_layout>& other) {
+        this->_rows       = other.rows();
+        this->_cols       = other.cols();
+        this->_row_stride = other.row_stride();
+        this->_col_stride = other.col_stride();
+        this->_data       = other.data();
+    }
+
+    // - Const Strided Matrix View -
+
+    // Init-from-data
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONST_VIEW)
+    explicit GenericTensor(size_type rows, size_type cols, size_type row_stride, size_type col_stride,
+                           const_pointer data_ptr) {
+        this->_rows       = rows;
+        this->_cols       = cols;
+        this->_row_stride = row_stride;
+        this->_col_stride = col_stride;
+        this->_data       = data_ptr;
+    }
+
+    // Init-from-tensor (any tensor of the same API type)
+    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
+              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
+                              ownership == Ownership::CONST_VIEW)>
+    GenericTensor(const GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
+                                      other_checking, other_layout>& other) {
+        this->_rows       = other.rows();
+        this->_cols       = other.cols();
+        this->_row_stride = other.row_stride();
+        this->_col_stride = other.col_stride();
+        this->_data       = other.data();
+    }
+
+    // - Sparse Matrix / Sparse Matrix View / Sparse Matrix Const View -
+
+    // Init-from-data (copy)
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
+    explicit GenericTensor(size_type rows, size_type cols, const std::vector<sparse_entry_type>& data) {
+        this->_rows = rows;
+        this->_cols = cols;
+        this->insert_triplets(std::move(data));
+    }
+
+    // Init-from-data (move)
+    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
+    explicit GenericTensor(size_type rows, size_type cols, std::vector<sparse_entry_type>&& data) {
+        this->_rows = rows;
+        this->_cols = cols;
+        this->rewrite_triplets(std::move(data));
+    }
+};
+
+// ===========================
+// --- Predefined Typedefs ---
+// ===========================
+
+constexpr auto _default_checking        = Checking::NONE;
+constexpr auto _default_layout_dense_2d = Layout::RC;
+
+// - Dense 2D -
+template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
+using Matrix = GenericTensor<T, Dimension::MATRIX, Type::DENSE, Ownership::CONTAINER, checking, layout>;
+
+template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
+using MatrixView = GenericTensor<T, Dimension::MATRIX, Type::DENSE, Ownership::VIEW, checking, layout>;
+
+template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
+using ConstMatrixView = GenericTensor<T, Dimension::MATRIX, Type::DENSE, Ownership::CONST_VIEW, checking, layout>;
+
+// - Strided 2D -
+template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
+using StridedMatrix = GenericTensor<T, Dimension::MATRIX, Type::STRIDED, Ownership::CONTAINER, checking, layout>;
+
+template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
+using StridedMatrixView = GenericTensor<T, Dimension::MATRIX, Type::STRIDED, Ownership::VIEW, checking, layout>;
+
+template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
+using ConstStridedMatrixView =
+    GenericTensor<T, Dimension::MATRIX, Type::STRIDED, Ownership::CONST_VIEW, checking, layout>;
+
+// - Sparse 2D -
+template <class T, Checking checking = _default_checking>
+using SparseMatrix = GenericTensor<T, Dimension::MATRIX, Type::SPARSE, Ownership::CONTAINER, checking, Layout::SPARSE>;
+
+template <class T, Checking checking = _default_checking>
+using SparseMatrixView = GenericTensor<T, Dimension::MATRIX, Type::SPARSE, Ownership::VIEW, checking, Layout::SPARSE>;
+
+template <class T, Checking checking = _default_checking>
+using ConstSparseMatrixView =
+    GenericTensor<T, Dimension::MATRIX, Type::SPARSE, Ownership::CONST_VIEW, checking, Layout::SPARSE>;
+
+// ==================
+// --- Formatters ---
+// ==================
+
+namespace format {
 
-inline auto& default_logger() {
-    static auto logger = Logger{Sink{std::cout}, Sink{"latest.log"}};
-    return logger;
-}
+// --- Implementation ---
+// ----------------------
 
-// Expose default logger err() / warn() / note() / info() / debug() / trace() as functions in the global namespace
-// clang-format off
-utl_log_function_alias( // 1
-    utl_log_hold(class A   ),
-    utl_log_hold(const A& a),
-    utl_log_hold(         a)
-)
-utl_log_function_alias( // 2
-    utl_log_hold(class A   , class B   ),
-    utl_log_hold(const A& a, const B& b),
-    utl_log_hold(         a,          b)
-)
-utl_log_function_alias( // 3
-    utl_log_hold(class A   , class B   , class C   ),
-    utl_log_hold(const A& a, const B& b, const C& c),
-    utl_log_hold(         a,          b,          c)
-)
-utl_log_function_alias( // 4
-    utl_log_hold(class A   , class B   , class C   , class D   ),
-    utl_log_hold(const A& a, const B& b, const C& c, const D& d),
-    utl_log_hold(         a,          b,          c,          d)
-)
-utl_log_function_alias( // 5
-    utl_log_hold(class A   , class B   , class C   , class D   , class E   ),
-    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e),
-    utl_log_hold(         a,          b,          c,          d,          e)
-)
-utl_log_function_alias( // 6
-    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   ),
-    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f),
-    utl_log_hold(         a,          b,          c,          d,          e,          f)
-)
-utl_log_function_alias( // 7
-    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   ),
-    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g),
-    utl_log_hold(         a,          b,          c,          d,          e,          f,          g)
-)
-utl_log_function_alias( // 8
-    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   ),
-    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h),
-    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h)
-)
-utl_log_function_alias( // 9
-    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ),
-    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i),
-    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i)
-)
-utl_log_function_alias( // 10
-    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
-                 class J                                                                                                   ),
-    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
-                 const J& j                                                                                                ),
-    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
-                          j                                                                                                )
-)
-utl_log_function_alias( // 11
-    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
-                 class J   , class K                                                                                       ),
-    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
-                 const J& j, const K& k                                                                                    ),
-    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
-                          j,          k                                                                                    )
-)
-utl_log_function_alias( // 12
-    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
-                 class J   , class K   , class L                                                                           ),
-    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
-                 const J& j, const K& k, const L& l                                                                        ),
-    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
-                          j,          k,          l                                                                        )
-)
-utl_log_function_alias( // 13
-    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
-                 class J   , class K   , class L   , class M                                                               ),
-    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
-                 const J& j, const K& k, const L& l, const M& m                                                            ),
-    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
-                          j,          k,          l,          m                                                            )
-)
-utl_log_function_alias( // 14
-    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
-                 class J   , class K   , class L   , class M   , class N                                                   ),
-    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
-                 const J& j, const K& k, const L& l, const M& m, const N& n                                                ),
-    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
-                          j,          k,          l,          m,          n                                                )
-)
-utl_log_function_alias( // 15
-    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
-                 class J   , class K   , class L   , class M   , class N   , class O                                       ),
-    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
-                 const J& j, const K& k, const L& l, const M& m, const N& n, const O& o                                    ),
-    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
-                          j,          k,          l,          m,          n,          o                                    )
-)
-utl_log_function_alias( // 16
-    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
-                 class J   , class K   , class L   , class M   , class N   , class O   , class P                           ),
-    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
-                 const J& j, const K& k, const L& l, const M& m, const N& n, const O& o, const P& p                        ),
-    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
-                          j,          k,          l,          m,          n,          o,          p                        )
-)
-utl_log_function_alias( // 17
-    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
-                 class J   , class K   , class L   , class M   , class N   , class O   , class P   , class Q               ),
-    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
-                 const J& j, const K& k, const L& l, const M& m, const N& n, const O& o, const P& p, const Q& q            ),
-    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
-                          j,          k,          l,          m,          n,          o,          p,          q            )
-)
-utl_log_function_alias( // 18
-    utl_log_hold(class A   , class B   , class C   , class D   , class E   , class F   , class G   , class H   , class I   ,
-                 class J   , class K   , class L   , class M   , class N   , class O   , class P   , class Q   , class R   ),
-    utl_log_hold(const A& a, const B& b, const C& c, const D& d, const E& e, const F& f, const G& g, const H& h, const I& i,
-                 const J& j, const K& k, const L& l, const M& m, const N& n, const O& o, const P& p, const Q& q, const R& r),
-    utl_log_hold(         a,          b,          c,          d,          e,          f,          g,          h,          i,
-                          j,          k,          l,          m,          n,          o,          p,          q,          r)
-)
-    // clang-format on
+// The "header" of all human-readable formats that displays
+// some meta info with tensor type and dimensions.
+template <utl_mvl_tensor_arg_defs>
+[[nodiscard]] std::string _tensor_meta_string(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
+    std::string buffer;
 
-    // ================
-    // --- Printing ---
-    // ================
+    if constexpr (_type == Type::DENSE) buffer += "Dense";
+    if constexpr (_type == Type::STRIDED) buffer += "Strided";
+    if constexpr (_type == Type::SPARSE) buffer += "Sparse";
+    if constexpr (_dimension == Dimension::VECTOR) buffer += stringify(" vector [size = ", tensor.size(), "]:\n");
+    if constexpr (_dimension == Dimension::MATRIX)
+        buffer += stringify(" matrix [size = ", tensor.size(), "] (", tensor.rows(), " x ", tensor.cols(), "):\n");
 
-    template <class... Args>
-    void stringify_append(std::string& str, const Args&... args) {
-    // Format all 'args' into a string using the same buffer abstraction as logging sinks, this doesn't add overhead
-    StringBuffer buffer(str);
-    (Formatter<Args>{}(buffer, args), ...);
+    return buffer;
 }
 
-template <class... Args>
-std::string stringify(const Args&... args) {
-    std::string res;
-    stringify_append(res, args...);
-    return res;
+// Human-readable formats automatically collapse matrices
+// that are too  large to be reasonably parsed by a human
+constexpr std::size_t _max_displayed_flat_size = 30 * 30;
+
+template <utl_mvl_tensor_arg_defs>
+[[nodiscard]] std::string _as_too_large(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
+    return stringify(_tensor_meta_string(tensor), "  <hidden due to large size>\n");
 }
 
-template <class... Args>
-void print(const Args&... args) {
-    // Print all 'args' to console in a thread-safe way with instant flushing
-    static std::mutex     mutex;
-    const std::lock_guard lock(mutex);
+// Generic method to do "dense matrix print" with given delimiters.
+// Cuts down on repetition since a lot of formats only differ in the delimiters used.
+template <class T, Type type, Ownership ownership, Checking checking, Layout layout, class Func>
+[[nodiscard]] std::string
+_generic_dense_format(const GenericTensor<T, Dimension::MATRIX, type, ownership, checking, layout>& tensor,     //
+                      std::string_view                                                              begin,      //
+                      std::string_view                                                              row_begin,  //
+                      std::string_view                                                              col_delim,  //
+                      std::string_view                                                              row_end,    //
+                      std::string_view                                                              row_delim,  //
+                      std::string_view                                                              end,        //
+                      Func                                                                          stringifier //
+) {
+    if (tensor.empty()) return (std::string() += begin) += end;
 
-    std::cout << stringify(args...) << std::flush;
-}
+    Matrix<std::string> strings(tensor.rows(), tensor.cols());
 
-template <class... Args>
-void println(const Args&... args) {
-    print(args..., '\n');
+    // Stringify
+    if constexpr (type == Type::SPARSE) strings.fill("-");
+    tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) { strings(i, j) = stringifier(elem); });
+    // this takes care of sparsity, if the matrix is sparse we prefill 'strings' with "-" and then fill appropriate
+    // {i, j} with actual stringified values from the tensor. For dense matrices no unnecessary work is done.
+
+    // Get column widths - we want matrix to format nice and aligned
+    std::vector<std::size_t> column_widths(strings.cols(), 0);
+    for (std::size_t i = 0; i < strings.rows(); ++i)
+        for (std::size_t j = 0; j < strings.cols(); ++j)
+            column_widths[j] = std::max(column_widths[j], strings(i, j).size());
+
+    // Format with proper alignment
+    std::string buffer(begin);
+    for (std::size_t i = 0; i < strings.rows(); ++i) {
+        buffer += row_begin;
+        for (std::size_t j = 0; j < strings.cols(); ++j) {
+            if (strings(i, j).size() < column_widths[j]) buffer.append(column_widths[j] - strings(i, j).size(), ' ');
+            buffer += strings(i, j);
+            if (j + 1 < strings.cols()) buffer += col_delim;
+        }
+        buffer += row_end;
+        if (i + 1 < strings.rows()) buffer += row_delim;
+    }
+    buffer += end;
+
+    return buffer;
 }
 
-} // namespace utl::log::impl
+// --- Human-readable formats ---
+// ------------------------------
 
-// ______________________ PUBLIC API ______________________
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_vector(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
 
-namespace utl::log {
+    std::string buffer = _tensor_meta_string(tensor);
 
-using impl::Formatter;
+    buffer += "  { ";
+    for (std::size_t idx = 0; idx < tensor.size(); ++idx) {
+        buffer += stringifier(tensor[idx]);
+        if (idx + 1 < tensor.size()) buffer += ", ";
+    }
+    buffer += " }\n";
 
-using impl::Logger;
-using impl::Sink;
+    return buffer;
+}
 
-namespace policy = impl::policy;
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_dictionary(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
+                                        Func                                          stringifier = Func()) {
+    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
 
-using impl::general;
-using impl::fixed;
-using impl::scientific;
-using impl::hex;
-using impl::base;
-using impl::align_left;
-using impl::align_center;
-using impl::align_right;
+    std::string buffer = _tensor_meta_string(tensor);
+
+    if constexpr (_dimension == Dimension::MATRIX) {
+        tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) {
+            buffer += stringify("(", i, ", ", j, ") = ");
+            buffer += stringifier(elem);
+            buffer += '\n';
+        });
+    } else {
+        tensor.for_each([&](const T& elem, std::size_t i) {
+            buffer += stringify("(", i, ") = ");
+            buffer += stringifier(elem);
+            buffer += '\n';
+        });
+    }
 
-namespace color = impl::color;
+    return buffer;
+}
 
-using impl::err;
-using impl::warn;
-using impl::note;
-using impl::info;
-using impl::debug;
-using impl::trace;
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_matrix(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
 
-using impl::stringify_append;
-using impl::stringify;
-using impl::print;
-using impl::println;
+    return _generic_dense_format(tensor, _tensor_meta_string(tensor), "  [ ", " ", " ]\n", "", "", stringifier);
+}
 
-} // namespace utl::log
+// --- Export formats ---
+// ----------------------
 
-#endif
-#endif // module utl::log
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_raw(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "", "", " ", "\n", "", "", stringifier);
+}
 
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_csv(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "", "", ", ", "\n", "", "", stringifier);
+}
 
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_json(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "[\n", "    [ ", ", ", " ]", ",\n", "\n]\n", stringifier);
+}
 
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_mathematica(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
+                                         Func                                          stringifier = Func()) {
+    return _generic_dense_format(tensor, "{\n", "    { ", ", ", " }", ",\n", "\n}\n", stringifier);
+}
 
+template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
+[[nodiscard]] std::string as_latex(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
+    return _generic_dense_format(tensor, "\\begin{pmatrix}\n", "  ", " & ", " \\\\\n", "", "\\end{pmatrix}\n",
+                                 stringifier);
+}
 
 
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//
-// Module:        utl::math
-// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_math.md
-// Source repo:   https://github.com/DmitriBogdanov/UTL
-//
-// This project is licensed under the MIT License
-//
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+} // namespace format
 
-#if !defined(UTL_PICK_MODULES) || defined(UTL_MODULE_MATH)
+// ================================
+// --- Linear algebra operators ---
+// ================================
 
-#ifndef utl_math_headerguard
-#define utl_math_headerguard
+// --- Unary operator implementation ----
+// --------------------------------------
 
-#define UTL_MATH_VERSION_MAJOR 1
-#define UTL_MATH_VERSION_MINOR 2
-#define UTL_MATH_VERSION_PATCH 1
+template <class L, class Op,                                                    //
+          _is_tensor_enable_if<L> = true,                                       //
+          class return_type       = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_unary_op(L&& left, Op&& op) {
+    using reference = typename std::decay_t<L>::reference;
 
-// _______________________ INCLUDES _______________________
+    // Reuse r-value if possible
+    return_type res = std::forward<L>(left);
 
-#include <cassert>     // assert()
-#include <limits>      // numeric_limits<>
-#include <type_traits> // enable_if_t<>, is_floating_point<>, is_arithmetic<>, is_integral<>, is_same<>, ...
+    // '.for_each()' takes care of possible sparsity
+    res.for_each([&](reference elem) { elem = op(std::move(elem)); });
 
-// ____________________ DEVELOPER DOCS ____________________
+    return res;
+}
 
-// A bunch of template utils that naturally accumulated over time.
-//
-// This header used to be somewhat of a junkyard of different math-adjacent stuff, but later underwent a cleanup
-// due to the development of another numerical library (GSE) implementing a much more "serious" mathematical package,
-// a lot of functionality from here was generalized and moved into the appropriate modules of this lib.
+// --- Unary operator API ----
+// ---------------------------
 
-// ____________________ IMPLEMENTATION ____________________
+// std <functional> has function objects for every operator possible,
+// except unary '+' for some reason, which is why we have to implement it ourselves.
+// This is the exact same thing as 'std::negate<>' but for operator '+'.
+template <class T>
+struct _unary_plus_functor {
+    constexpr T operator()(const T& lhs) const { return +lhs; }
+};
 
-namespace utl::math::impl {
+template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
+          _has_unary_op_plus_enable_if<value_type> = true>
+auto operator+(L&& left) {
+    return apply_unary_op(std::forward<L>(left), _unary_plus_functor<value_type>());
+}
 
-// ======================
-// --- SFINAE helpers ---
-// ======================
+template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
+          _has_unary_op_minus_enable_if<value_type> = true>
+auto operator-(L&& left) {
+    return apply_unary_op(std::forward<L>(left), std::negate<value_type>());
+}
 
-template <bool Cond>
-using require = std::enable_if_t<Cond, bool>;
+// --- Binary operator implementation ---
+// --------------------------------------
 
-template <class T>
-using require_arithmetic = require<std::is_arithmetic_v<T> && !std::is_same_v<T, bool>>;
+// Doing things "in a dumb but simple way" would be to just have all operators take arguments as const-refs and
+// return a copy, however we can speed things up a lot by properly using perfect forwarding, which would reuse
+// r-values if possible to avoid allocation. Doing so would effectively change something like this:
+//    res = A + B - C - D + E
+// from 5 (!) copies to only 1, since first operator will create an r-value that gets propagated and reused by
+// all others. This however introduces it's own set of challenges since instead of traditional overloading we
+// now have to resort to SFINAE-driven imitation of it and carefully watch what we restrict.
+//
+// So here are the key points of implementing all of this:
+//
+//    1. All unary and binary operators ('-', '+', '*' and etc.) can benefit from reusing r-values and moving
+//       one of the arguments into the result rather than copy. This can only happen to CONTAINER args that
+//       correspond to the return type.
+//
+//    2. Binary operators have following return types for different tensors:
+//       - (1)  dense +  dense =>  dense      (complexity O(N^2))
+//       - (2)  dense + sparse =>  dense      (complexity O(N)  )
+//       - (3) sparse +  dense =>  dense      (complexity O(N)  )
+//       - (4) sparse + sparse => sparse      (complexity O(N)  )
+//       return types inherit option arguments from the lhs and always have 'ownership == CONTAINER',
+//       while argument can be anything, including views. To implement the list above efficiently there
+//       is no other way but to make 4 separate implementation, tailored for each level of sparsity.
+//
+//    3. All binary operators can be written in a generic form like 'apply_binary_operator(A, B, op)'
+//       and specialized with operator functors froms std <functional>. All we need for individual
+//       operators is to figure out correct boilerplate with perfect forwarding. "Overload resolution"
+//       will be performed by the 'apply_operator' method.
+//
+// It's a good question whether to threat binary '*' as element-wise product (which would be in line with other
+// operators) or a matrix product, but in the end it seems doing it element-wise would be too confusing for the
+// user, so we leave '*' as a matrix product and declare element-wise product as a function 'elementwise_product()'
+// since no existing operators seem suitable for such overload.
 
-template <class T>
-using require_int = require<std::is_integral_v<T> && !std::is_same_v<T, bool>>;
+// (1)  dense +  dense =>  dense
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
+          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
 
-template <class T>
-using require_uint = require<std::is_integral_v<T> && std::is_unsigned_v<T> && !std::is_same_v<T, bool>>;
+    using reference = typename std::decay_t<L>::reference;
+    using size_type = typename std::decay_t<L>::size_type;
 
-template <class T>
-using require_float = require<std::is_floating_point_v<T>>;
+    return_type res;
 
-template <class T, class... Args>
-using require_invocable = require<std::is_invocable_v<T, Args...>>;
+    // Reuse r-value arguments if possible while preserving the order of operations
+    if constexpr (std::is_rvalue_reference_v<L> && std::decay_t<L>::params::ownership == Ownership::CONTAINER) {
+        res = std::forward<L>(left);
+        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(std::move(elem), right(i, j)); });
+    } else if constexpr (std::is_rvalue_reference_v<R> && std::decay_t<R>::params::ownership == Ownership::CONTAINER) {
+        res = std::forward<R>(right);
+        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), std::move(elem)); });
+    } else {
+        res = return_type(left.rows(), left.cols());
+        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), right(i, j)); });
+    }
 
-// =================
-// --- Constants ---
-// =================
+    return res;
+}
 
-namespace constants {
+// (2)  dense + sparse =>  dense
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
+          _is_sparse_tensor_enable_if<R>                    = true,                                       //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
 
-constexpr double pi      = 3.14159265358979323846;
-constexpr double two_pi  = 6.28318530717958647693;
-constexpr double half_pi = 1.57079632679489661923;
-constexpr double inv_pi  = 0.31830988618379067153;
-constexpr double sqrtpi  = 1.77245385090551602729;
-constexpr double e       = 2.71828182845904523536; // Euler's number
-constexpr double egamma  = 0.57721566490153286060; // Euler-Mascheroni constant
-constexpr double phi     = 1.61803398874989484820; // golden ratio
-constexpr double ln2     = 0.69314718055994530942;
-constexpr double ln10    = 2.30258509299404568402;
-constexpr double sqrt2   = 1.41421356237309504880;
-constexpr double sqrt3   = 1.73205080756887729352;
+    using reference = typename std::decay_t<L>::reference;
+    using size_type = typename std::decay_t<L>::size_type;
 
-} // namespace constants
+    // Reuse r-value if possible
+    return_type res = std::forward<L>(left);
 
-// =======================
-// --- Basic functions ---
-// =======================
+    // '.for_each()' to only iterate sparse elements
+    right.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(std::move(res(i, j)), elem); });
 
-template <class T, require_arithmetic<T> = true>
-[[nodiscard]] constexpr T abs(T x) noexcept {
-    return (x > T(0)) ? x : -x;
+    return res;
 }
 
-template <class T, require_arithmetic<T> = true>
-[[nodiscard]] constexpr T sign(T x) noexcept {
-    if constexpr (std::is_unsigned_v<T>) return (x > T(0)) ? T(1) : T(0);
-    else return (x > T(0)) ? T(1) : (x < T(0)) ? T(-1) : T(0);
-} // returns -1 / 0 / 1
+// (3) sparse +  dense =>  dense
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_sparse_tensor_enable_if<L>                    = true,                                       //
+          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
+          class return_type                                 = typename std::decay_t<R>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
 
-template <class T, require_arithmetic<T> = true>
-[[nodiscard]] constexpr T bsign(T x) noexcept {
-    if constexpr (std::is_unsigned_v<T>) return T(1);
-    else return (x >= T(0)) ? T(1) : T(-1);
-} // returns -1 / 1 (1 gets priority in x == 0)
+    using reference = typename std::decay_t<R>::reference;
+    using size_type = typename std::decay_t<R>::size_type;
+
+    // Reuse r-value if possible
+    return_type res = std::forward<R>(right);
 
-template <class T, require_arithmetic<T> = true>
-[[nodiscard]] constexpr T sqr(T x) noexcept {
-    return x * x;
-}
+    // '.for_each()' to only iterate sparse elements
+    left.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(elem, std::move(res(i, j))); });
 
-template <class T, require_arithmetic<T> = true>
-[[nodiscard]] constexpr T cube(T x) noexcept {
-    return x * x * x;
+    return res;
 }
 
-template <class T, require_float<T> = true>
-[[nodiscard]] constexpr T inv(T x) noexcept {
-    return T(1) / x;
-}
+// (4) sparse + sparse => sparse
+template <class L, class R, class Op,                                                                     //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
+          _is_sparse_tensor_enable_if<L>                    = true,                                       //
+          _is_sparse_tensor_enable_if<R>                    = true,                                       //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection //
+          >
+return_type apply_binary_op(L&& left, R&& right, Op&& op) {
+    utl_mvl_assert(left.rows() == right.rows());
+    utl_mvl_assert(left.cols() == right.cols());
 
-template <class T, require_arithmetic<T> = true>
-[[nodiscard]] constexpr T heaviside(T x) noexcept {
-    return static_cast<T>(x > T(0));
-}
+    using sparse_entry = typename std::decay_t<L>::sparse_entry_type;
+    using value_type   = typename std::decay_t<L>::value_type;
 
-// Floating point midpoint based on 'libstdc++' implementation, takes care of extreme values
-template <class T, require_float<T> = true>
-[[nodiscard]] constexpr T midpoint(T a, T b) noexcept {
-    constexpr T low  = std::numeric_limits<T>::min() * 2;
-    constexpr T high = std::numeric_limits<T>::max() / 2;
+    std::vector<sparse_entry> res_triplets;
+    res_triplets.reserve(std::max(left.size(), right.size()));
+    // not enough when matrices have different sparsity patterns, but good enough for initial guess
 
-    const T abs_a = abs(a);
-    const T abs_b = abs(b);
+    std::size_t i = 0, j = 0;
 
-    if (abs_a <= high && abs_b <= high) return (a + b) / 2; // always correctly rounded
-    if (abs_a < low) return a + b / 2;                      // not safe to halve 'a'
-    if (abs_b < low) return b + a / 2;                      // not safe to halve 'b'
-    return a / 2 + b / 2;                                   // correctly rounded for remaining cases
-}
+    // Merge sparsity patterns
+    while (i < left.size() && j < right.size()) {
+        // Entry present only in lhs sparsity pattern
+        if (left._data[i] < right._data[j]) {
+            res_triplets.emplace_back(
+                _apply_binary_op_to_sparse_entry_and_value(std::forward<L>(left)._data[i++], value_type{}, op));
+        }
+        // Entry present only in rhs sparsity pattern
+        else if (left._data[i] > right._data[j]) {
+            res_triplets.emplace_back(
+                _apply_binary_op_to_value_and_sparse_entry(value_type{}, std::forward<R>(right)._data[j++], op));
+        }
+        // Entry present in both sparsity patterns
+        else {
+            res_triplets.emplace_back(_apply_binary_op_to_sparse_entries(std::forward<L>(left)._data[i++],
+                                                                         std::forward<R>(right)._data[j++], op));
+        }
+    }
+    // Copy the rest of lhs (if needed)
+    while (i < left.size()) res_triplets.emplace_back(std::forward<L>(left)._data[i++]);
+    // Copy the rest of rhs (if needed)
+    while (j < right.size()) res_triplets.emplace_back(std::forward<R>(right)._data[j++]);
 
-// Non-overflowing integer midpoint is less trivial than it might initially seem, see
-// https://lemire.me/blog/2022/12/06/fast-midpoint-between-two-integers-without-overflow/
-// https://biowpn.github.io/bioweapon/2025/03/23/generalizing-std-midpoint.html
-template <class T, require_int<T> = true>
-[[nodiscard]] constexpr T midpoint(T a, T b) noexcept {
-    return ((a ^ b) >> 1) + (a & b);
-    // fast rounding-down midpoint by Warren (Hacker's Delight section 2.5)
-    // rounding-up version would be '(a | b) - ((a ^ b) >> 1)'
-    // this is faster than C++20 'std::midpoint()' due to a different rounding mode
+    return return_type(left.rows(), left.cols(), std::move(res_triplets));
 }
 
-template <class T, require_arithmetic<T> = true>
-[[nodiscard]] constexpr T absdiff(T a, T b) noexcept {
-    return (a > b) ? (a - b) : (b - a);
-}
+// --- Binary operator API ---
+// ---------------------------
 
-// =======================
-// --- Power functions ---
-// =======================
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_plus_enable_if<value_type> = true>
+auto operator+(L&& left, R&& right) {
+    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::plus<value_type>());
+}
 
-// Squaring algorithm for positive integer powers
-template <class T, class U, require_arithmetic<T> = true, require_int<U> = true>
-[[nodiscard]] constexpr T pow_squaring(T x, U p) noexcept {
-    if (p == U(0)) return T(1);
-    if (p == U(1)) return x;
-    const T half_pow = pow_squaring(x, p / 2);
-    return (p % U(2) == U(0)) ? half_pow * half_pow : half_pow * half_pow * x;
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_minus_enable_if<value_type> = true>
+auto operator-(L&& left, R&& right) {
+    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::minus<value_type>());
 }
 
-template <class T, class U, require_arithmetic<T> = true, require_int<U> = true>
-[[nodiscard]] constexpr T pow(T x, U p) noexcept {
-    if constexpr (std::is_signed_v<T>) {
-        return (p < 0) ? T(1) / pow_squaring(x, -p) : pow_squaring(x, p);
-    } else {
-        return pow_squaring(x, p); // no need for the branch in unsigned case
-    }
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type                                = typename std::decay_t<L>::value_type,
+          _has_binary_op_multiplies_enable_if<value_type> = true>
+auto elementwise_product(L&& left, R&& right) {
+    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::multiplies<value_type>());
 }
 
-[[nodiscard]] constexpr int signpow(int p) noexcept { return (p % 2 == 0) ? 1 : -1; }
+// --- Augmented assignment operator API ---
+// -----------------------------------------
 
-// =======================
-// --- Index functions ---
-// =======================
+// These can just reuse corresponding binary operators while 'std::move()'ing lhs to avoid copying.
 
-template <class T, require_int<T> = true>
-[[nodiscard]] constexpr T kronecker_delta(T i, T j) noexcept {
-    return (i == j) ? T(1) : T(0);
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type = typename std::decay_t<L>::value_type, _has_assignment_op_plus_enable_if<value_type> = true>
+L& operator+=(L&& left, R&& right) {
+    return (left = std::move(left) + right);
 }
 
-template <class T, require_int<T> = true>
-[[nodiscard]] constexpr T levi_civita(T i, T j, T k) noexcept {
-    if (i == j || j == k || k == i) return T(0);
-    const unsigned int inversions = (i > j) + (i > k) + (j > k);
-    return (inversions % 2 == 0) ? T(1) : T(-1);
+template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
+          class value_type                               = typename std::decay_t<L>::value_type,
+          _has_assignment_op_minus_enable_if<value_type> = true>
+L& operator-=(L&& left, R&& right) {
+    return (left = std::move(left) - right);
 }
 
-// ===================
-// --- Conversions ---
-// ===================
+// --- Matrix multiplication ---
+// -----------------------------
 
-template <class T, require_float<T> = true>
-[[nodiscard]] constexpr T deg_to_rad(T degrees) noexcept {
-    constexpr T factor = T(constants::pi / 180.);
-    return degrees * factor;
-}
+// Just like with binary operators, we run into the need to have 4 different implementations:
+//    - (1)  dense +  dense =>  dense      (complexity O(N^3))
+//    - (2)  dense + sparse =>  dense      (complexity O(N^2))
+//    - (3) sparse +  dense =>  dense      (complexity O(N^2))
+//    - (4) sparse + sparse => sparse      (complexity O(N)  )
+//
+// Would be gread to implement proper "smart" GEMM and CRS-multiplication for sparse matrices, however that adds
+// an absolutely huge amount of complexity for x1.5-x3 speedup on matrix multiplication, which is already kind of
+// an afterthought provided here mainly for convenience and not for actual number crunching usage.
+//
+// We do however use some basic optimizations like loop reordering / temporaries / blocking to have a sensible baseline,
+// we properly account for sparsity which brings multiplication with sparse matrices from O(N^3) down to O(N^2) / O(N).
 
-template <class T, require_float<T> = true>
-[[nodiscard]] constexpr T rad_to_deg(T radians) noexcept {
-    constexpr T factor = T(180. / constants::pi);
-    return radians * factor;
-}
+// (1)  dense +  dense =>  dense
+//
+// From benchmarks 1D blocking over "k" with a decently large block size seems to be more reliable than 2D/3D blocking.
+// When measuring varying matrix sizes and datatypes, for matrices with less than ~1k rows/cols (aka matrices that fully
+// fit into L2 cache) 1D blocking doesn't  seem to have much of an effect (positive or negative), while 2D/3D has often
+// lead to a slowdown for specific matrix  sizes. At large enough sizes blocking leads to a noticeable (~2x) speedup.
+// Note that this is all very hardware-specific, so it's difficult to make a truly generic judgement. In general,
+// blocking seems to be worth it.
+//
+// Note that unlike other binary operators, here there is no possible benefit in r-value reuse.
+//
+template <class L, class R,                                                                                //
+          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                        //
+          _is_nonsparse_tensor_enable_if<L>                 = true,                                        //
+          _is_nonsparse_tensor_enable_if<R>                 = true,                                        //
+          class value_type                                  = typename std::decay_t<L>::value_type,        //
+          class return_type                                 = typename std::decay_t<L>::owning_reflection, //
+          _has_binary_op_multiplies_enable_if<value_type>   = true,                                        //
+          _has_assignment_op_plus_enable_if<value_type>     = true                                         //
+          >
+return_type operator*(const L& left, const R& right) {
+    utl_mvl_assert(left.cols() == right.rows());
 
-// ===========================
-// --- Sequence operations ---
-// ===========================
+    using size_type = typename std::decay_t<L>::size_type;
 
-template <class Idx, class Func, require_invocable<Func, Idx> = true>
-[[nodiscard]] constexpr auto sum(Idx low, Idx high, Func&& func) noexcept(noexcept(func(Idx{}))) {
-    assert(low <= high);
-    std::invoke_result_t<Func, Idx> res = 0;
-    for (Idx i = low; i <= high; ++i) res += func(i);
-    return res;
-}
+    const size_type N_i = left.rows(), N_k = left.cols(), N_j = right.cols();
+    // (N_i)x(N_k) * (N_k)x(N_j) => (N_i)x(N_j)
 
-template <class Idx, class Func, require_invocable<Func, Idx> = true>
-[[nodiscard]] constexpr auto prod(Idx low, Idx high, Func&& func) noexcept(noexcept(func(Idx{}))) {
-    assert(low <= high);
-    std::invoke_result_t<Func, Idx> res = 1;
-    for (Idx i = low; i <= high; ++i) res *= func(i);
-    return res;
-}
+    constexpr size_type block_size_kk = 32;
 
-} // namespace utl::math::impl
+    return_type res(N_i, N_j, value_type{});
 
-// ______________________ PUBLIC API ______________________
+    for (size_type kk = 0; kk < N_k; kk += block_size_kk) {
+        const size_type k_extent = std::min(N_k, kk + block_size_kk);
+        // needed for matrices that aren't a multiple of block size
+        for (size_type i = 0; i < N_i; ++i) {
+            for (size_type k = kk; k < k_extent; ++k) {
+                const auto& r = left(i, k);
+                for (size_type j = 0; j < N_j; ++j) res(i, j) += r * right(k, j);
+            }
+        }
+    }
 
-namespace utl::math {
+    return res;
+}
 
-namespace constants = impl::constants;
+// (2)  dense + sparse =>  dense
 
-using impl::abs;
-using impl::sign;
-using impl::bsign;
-using impl::sqr;
-using impl::cube;
-using impl::inv;
-using impl::heaviside;
+// TODO:
 
-using impl::midpoint;
-using impl::absdiff;
+// (3) sparse +  dense =>  dense
 
-using impl::pow;
-using impl::signpow;
+// TODO:
 
-using impl::kronecker_delta;
-using impl::levi_civita;
+// (4) sparse + sparse => sparse
 
-using impl::deg_to_rad;
-using impl::rad_to_deg;
+// TODO:
 
-using impl::sum;
-using impl::prod;
+// Clear out internal macros
+#undef utl_mvl_tensor_arg_defs
+#undef utl_mvl_tensor_arg_vals
+#undef utl_mvl_require
+#undef utl_mvl_reqs
 
-} // namespace utl::math
+} // namespace utl::mvl
 
 #endif
-#endif // module utl::math
+#endif // module utl::mvl
 
 
 
@@ -5574,3320 +9330,3874 @@ using impl::prod;
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //
-// Module:        utl::mvl
-// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_mvl.md
+// Module:        utl::parallel
+// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_parallel.md
 // Source repo:   https://github.com/DmitriBogdanov/UTL
 //
 // This project is licensed under the MIT License
 //
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-#if !defined(UTL_PICK_MODULES) || defined(UTL_MODULE_MVL)
+#if !defined(UTL_PICK_MODULES) || defined(UTL_MODULE_PARALLEL)
 
-#ifndef utl_mvl_headerguard
-#define utl_mvl_headerguard
+#ifndef utl_parallel_headerguard
+#define utl_parallel_headerguard
 
-#define UTL_MVL_VERSION_MAJOR 0 // [!] module in early experimental stage,
-#define UTL_MVL_VERSION_MINOR 1 //     functional, but needs significant work
-#define UTL_MVL_VERSION_PATCH 3 //     to complete and bring up-to-date
+#define UTL_PARALLEL_VERSION_MAJOR 2
+#define UTL_PARALLEL_VERSION_MINOR 2
+#define UTL_PARALLEL_VERSION_PATCH 0
 
 // _______________________ INCLUDES _______________________
 
-#include <algorithm>        // swap(), find(), count(), is_sorted(), min_element(), max_element(), ...
-#include <cassert>          // assert() // Note: Perhaps temporary
-#include <charconv>         // to_chars()
-#include <cmath>            // isfinite()
-#include <cstddef>          // size_t, ptrdiff_t, nullptr_t
-#include <functional>       // reference_wrapper<>, multiplies<>
-#include <initializer_list> // initializer_list<>
-#include <iterator>         // random_access_iterator_tag, reverse_iterator<>
-#include <memory>           // unique_ptr<>
-#include <numeric>          // accumulate()
-#include <ostream>          // ostream
-#include <sstream>          // ostringstream
-#include <stdexcept>        // out_of_range, invalid_argument
-#include <string>           // string
-#include <string_view>      // string_view<>
-#include <type_traits>      // conditional_t<>, enable_if_t<>, void_t<>, true_type, false_type, remove_reference_t<>
-#include <utility>          // move()
-#include <vector>           // vector<>
+#include <algorithm>          // sort(), stable_sort(), partition(), merge(), move()
+#include <array>              // array<>
+#include <atomic>             // atomic<>, memory_order
+#include <chrono>             // steady_clock, nanoseconds, duration_cast<>()
+#include <condition_variable> // condition_variable
+#include <cstddef>            // size_t, ptrdiff_t, max_align_t, nullptr_t
+#include <cstdint>            // uint64_t, int64_t, uint32_t
+#include <deque>              // deque<>
+#include <exception>          // exception_ptr, current_exception(), rethrow_exception()
+#include <functional>         // plus<>, multiplies<>, less<>, bind(), hash<>, equal_to<>
+#include <future>             // future<>, promise<>
+#include <iterator>           // iterator_traits<>, make_move_iterator(), distance()
+#include <map>                // map<>
+#include <memory>             // unique_ptr<>, shared_ptr<>, make_shared<>()
+#include <mutex>              // mutex, scoped_lock<>, unique_lock<>
+#include <new>                // launder()
+#include <optional>           // optional<>, nullopt
+#include <stdexcept>          // current_exception, runtime_error
+#include <string>             // string, to_string(), stoul(), getline()
+#include <thread>             // thread, this_thread::get_id()
+#include <tuple>              // tie(), tuple<>, tuple_cat(), get<>()
+#include <type_traits>        // decay_t<>, enable_if_t<>, is_same_v<>, is_nothrow_move_constructible_v<>
+#include <unordered_map>      // unordered_map<>
+#include <utility>            // forward<>(), move()
+#include <vector>             // vector<>
+
+// Thread affinity & CPU topology are only supported on Linux
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <fstream>   // ifstream
+#include <pthread.h> // pthread_self(), pthread_setaffinity_np(), pthread_getaffinity_np()
+#include <sched.h>   // cpu_set_t, CPU_ZERO(), CPU_SET(), CPU_ISSET(), CPU_SETSIZE
+#define utl_parallel_has_thread_affinity
+#endif
+
+// Coroutines are only supported in C++20
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && __has_include(<coroutine>)
+#include <coroutine> // coroutine_handle<>, suspend_always, noop_coroutine()
+#include <variant>   // monostate
+#define utl_parallel_has_coroutines
+#endif
 
 // ____________________ DEVELOPER DOCS ____________________
 
-// [experimental!] This header is still work in progress and likely to undergo significant changes to
-// its API & implementation.
-//
-// This module tries to implement an "unreasonably flexible yet convenient" template for vectors and matrices,
-// in order to do so we have to rely heavily on either conditional compilation or automatic code generation
-// (or both). There are multiple seemingly viable approaches to it, yet the most of them proved to be either
-// unsuitable or unreasonable from the implementation standpoint. Below is a little rundown of implementations
-// that were attempted and used/discared for various reasons.
-//
-// Currently matrix/vector/view/etc code reuse is implemented though a whole bunch of conditional compilation with
-// SFINAE, abuse of conditional inheritance, conditional types and constexpr if's. While not perfect, this is
-// the best working approach so far. Below is a list of approaches that has been considered & tried:
-//
-// 1) No code reuse, all classes implemented manually - unrealistically cumbersome, huge code duplication
-//
-//    => [-] UNSUITABLE APPROACH
-//
-// 2) Regular OOP with virtual classes - having vtables in lightweight containers is highly undesirable,
-//    we can avoid this using CRTP however we run into issues with multiple inheritance (see below)
-//
-//    => [-] UNSUITABLE APPROACH
-//
-// 3) CRTP - we unavoidably run into multiple inheritance issues (diamond problem) with concepts like:
-//       [mutable-matrix-like] : [const-matrix-like] & [mutable-iterable] where both parents derive from
-//       [const-iterable]
-//
-//    While those issues are resolvable, their handling becomes more and more difficult as parent classes grow larger.
-//    A usual solution for this would be virtual inheritance, however it prevents us from calling derived methods inside
-//    the base class due to "static downcast via virtual inheritance" rule, which makes 'static_cast<Derived*>(this)'
-//    illegal. We can resolve all name collisions manually, however it leads to a code that is absolutely horrific and
-//    easy to mess up.
-//
-//    There is also an issue of extreme boilerplate, since we want to propagate '_types<>' wrapper and the 'Final'
-//    return type to all base classes we end up with extremely unwieldy template arguments that make compile errors and
-//    refactoring a challenge.
-//
-//    => [~] SUITABLE, BUT VERY PROBLEMATIC APPROACH
-//
-// 4) Template-based mixins without CRTP - these allow to add functionality on top of a class, essentially it works
-//    like "inverted" CRTP from the code logic POV. While being almost a perfect solution, it doesn't allow us to
-//    return objects of derived type from base class methods, which is a requirement for the intended matrix API.
-//
-//    => [-] UNSUITABLE APPROACH
-//
-// 5) Macro-based mixins - insert functionality directly in a class, a simple way of doing exactly what we want.
-//    "Mixed-in" methods are simply functions implemented in terms of certain "required" methods.
-//    Doesn't lead to huge template chains and doesn't have any inheritance at all. The main downside is being
-//    preprocessor based, which exposes some identifiers to a global namespace and makes all "connection points"
-//    in logic dependant on correct naming inside macros, rather than actual semantical symbols.
-//
-//    Difficult to work with due to being ignored by the language server, gets increasingly cumbersome as the number of
-//    classes grows and still has significant code duplication (vector/matrix * dense/strided/sparse *
-//    * container/view/const_view = 18 manually created definitions).
-//
-//    => [+-] SUITABLE, BUT HEAVILY FLAWED APPROACH
-//
-// 6) A single class with all parts of API correctly enabled/disabled through SFINAE. Closest thing to a sensible
-//    approach with minimal (basically none) code duplication. However it has a number of non-trivial quirks
-//    when it comes to conditionally compiling member variables, types & functions (every group has a quirk of
-//    its own, functions are the least problematic). Some of such quirks limit possible conditional API (member
-//    types suffer from this) or, for example, prevent use of initialization lists on conditionally compiled
-//    constructors (big sad).
+// Optional macros:
+// - #define UTL_PARALLEL_ENABLE_STATS // collect per-worker thread pool statistics, see 'ThreadPool::stats()'
 //
-//    A less obvious downside compared to macros, is that it doesn't get handles as well by the language server
-//    autocomplete - SFINAE-disabled methods still show up as autocomplete suggestions, even if they get marked
-//    as missing immediately upon writing the whole name.
+// Work-stealing summary:
 //
-//    => [+] DIFFICULT, BUT WORKABLE, BEST APPROACH SO FAR
+//    - We use several queues:
+//         - All  threads have a global task queue
+//         - Each thread  has  a local  task deque
+//    - Tasks go into different queues depending on their source:
+//         - Work queued from a     pool thread => recursive task, goes to the front of local  deque
+//         - Work queued from a non-pool thread => external  task, goes to the back  of global queue
+//    - When threads are looking for work they search in 3 steps:
+//         1. Check local  deque,  work here can be popped from the front
+//         2. Check other  deques, work here can be stolen from the back
+//         3. Check global queue,  work here can be popped from the front
+//    - To resolve recursive deadlocks we use a custom future:
+//         - Recursive task calls '.wait()' on its future => pop / steal work from local deques until finished
+//    - Global queue is split into high / normal / low priority tiers:
+//         - High priority tasks are checked before the local deques, others after the stealing
+//         - Lower tiers get their turn after being skipped 'starvation_limit' times in a row
+//    - Fork-join task groups avoid futures entirely:
+//         - Group state (pending counter & exception) lives on the stack of the waiting thread
+//         - Waiting thread pops / steals work the same way futures do, then parks until the last child is done
+//    - Local deques are lock-free Chase-Lev deques:
+//         - Owner thread pushes & pops at the bottom, thieves steal from the top with a CAS
+//         - Deque slots hold pointers to task nodes rather than tasks, since slots have to be atomic
+//         - Task nodes are recycled through per-worker free lists, which keeps submission allocation-free
+//    - Tasks are move-only callables with a 64-byte inline storage:
+//         - Unlike 'std::function' they don't allocate for most closures and have a non-throwing move
 //
-// NOTES ON SPAN:
+//    - Task accounting & sleeping doesn't use any shared mutexes:
+//         - Pending / running tasks are tracked by a single atomic counter
+//         - Idle threads park on an event count, which only touches the OS primitives when someone is
+//           actually asleep, busy pool never has sleepers and thus never goes through the slow path
 //
-// We can easily implement Matlab-like API to take matrix blocks like this:
-//    matrix(Span{0, 10}, 4)
-// which would be equivalent to
-//    matrix.block(0, 4, 10, 1)
-// we only need a thin 'Span' POD with 2 members and a few overloads for 'operator()' that redirect span
-// to 'this->block(...)'
+// Global queue is still guarded by a mutex, properly implementing a lock-free MPMC queue is a task of incredible
+// complexity and the global queue only sees external tasks, so it isn't contended nearly as much as local deques.
 //
-// NOTES ON NAMING:
+// Newer standards would enable several improvements in terms of implementation:
+//    - In C++20 'std::jthread' can be used to simplify joining and add stop tokens
+//    - In C++23 'std::move_only_function<>' could replace the custom task type, however its inline
+//      storage size is implementation-defined and it still doesn't guarantee a non-throwing move
+//    - In C++20 atomic wait is used to park threads when available, below C++20 we fall back onto
+//      a condition variable that is only touched when there are sleeping threads
 //
-// Macro naming is a bit of a mess as of now.
+// It is also possible to reduce locking in some parts of the scheduling, this is a work for future releases.
 
 // ____________________ IMPLEMENTATION ____________________
 
-namespace utl::mvl {
+// MSVC warns about structures being padded due to 'alignas()', which is precisely the point of aligning them
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4324)
+#endif
 
-// ===================
-// --- Type Traits ---
-// ===================
+namespace utl::parallel::impl {
 
-// Macro for generating type traits with all their boilerplate
+// ============================
+// --- Thread introspection ---
+// ============================
+
+namespace this_thread {
+
+inline thread_local std::optional<std::size_t> worker_index    = std::nullopt;
+inline thread_local std::optional<void*>       thread_pool_ptr = std::nullopt;
+
+[[nodiscard]] inline std::optional<std::size_t> get_index() noexcept { return worker_index; }
+[[nodiscard]] inline std::optional<void*>       get_pool() noexcept { return thread_pool_ptr; }
+
+}; // namespace this_thread
+
+[[nodiscard]] inline std::size_t hardware_concurrency() noexcept {
+    const std::size_t     detected_count = std::thread::hardware_concurrency();
+    constexpr std::size_t fallback_count = 4;
+    return detected_count ? detected_count : fallback_count;
+    // if 'hardware_concurrency()' struggles to determine the number of threads, we fallback onto a reasonable default
+}
+
+constexpr std::size_t cache_line_size = 64;
+// 'std::hardware_destructive_interference_size' would be more appropriate, but its support is spotty and GCC warns
+// about its usage in headers due to ABI concerns, 64 bytes is correct for virtually all modern x86 & ARM CPUs
+
+template <class T>
+struct alignas(cache_line_size) Padded {
+    T value{};
+}; // places each value in a separate cache line, which prevents false sharing when values are stored in an array
+
+// ===========================
+// --- Work-stealing deque ---
+// ===========================
+
+// Chase-Lev lock-free work-stealing deque, based on:
+//    - "Dynamic Circular Work-Stealing Deque" (D. Chase, Y. Lev, 2005)
+//    - "Correct and Efficient Work-Stealing for Weak Memory Models" (N. M. Le, A. Pop, A. Cohen, F. Z. Nardelli, 2013)
 //
-// While it'd be nice to avoid macro usage alltogether, having a few macros for generating standardized boilerplate
-// that gets repeated several dozen times DRASTICALLY improves the maintainability of the whole conditional compilation
-// mechanism down the line. They will be later #undef'ed.
+// The paper version uses relaxed operations paired with standalone fences, here we use 'seq_cst' operations in the
+// same places instead. On x86 this compiles to the same instructions, but unlike fences it is properly understood by
+// thread sanitizers. Retired buffers are kept alive until the deque dies since thieves might still be reading them,
+// this wastes at most as much memory as the largest buffer itself.
 
-#define utl_mvl_define_trait(trait_name_, ...)                                                                         \
-    template <class T, class = void>                                                                                   \
-    struct trait_name_ : std::false_type {};                                                                           \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    struct trait_name_<T, std::void_t<decltype(__VA_ARGS__)>> : std::true_type {};                                     \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    constexpr bool trait_name_##_v = trait_name_<T>::value;                                                            \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    using trait_name_##_enable_if = std::enable_if_t<trait_name_<T>::value, bool>
+template <class T>
+class WorkStealingDeque {
+    static constexpr std::int64_t initial_capacity = 64; // should be a power of 2
 
-// Shortcuts for different types of requirements
+    struct Buffer {
+        std::int64_t                       capacity;
+        std::int64_t                       mask;
+        std::unique_ptr<std::atomic<T*>[]> slots;
 
-#define utl_mvl_define_trait_has_binary_op(trait_name_, op_)                                                           \
-    utl_mvl_define_trait(trait_name_, std::declval<std::decay_t<T>>() op_ std::declval<std::decay_t<T>>())
+        explicit Buffer(std::int64_t capacity)
+            : capacity(capacity), mask(capacity - 1), slots(std::make_unique<std::atomic<T*>[]>(capacity)) {}
 
-#define utl_mvl_define_trait_has_assignment_op(trait_name_, op_)                                                       \
-    utl_mvl_define_trait(trait_name_, std::declval<std::decay_t<T>&>() op_ std::declval<std::decay_t<T>>())
-// for operators like '+=' lhs should be a reference
+        [[nodiscard]] T* get(std::int64_t i) const noexcept { return this->slots[i & this->mask].load(relaxed); }
+        void             put(std::int64_t i, T* x) noexcept { this->slots[i & this->mask].store(x, relaxed); }
+    };
 
-#define utl_mvl_define_trait_has_unary_op(trait_name_, op_)                                                            \
-    utl_mvl_define_trait(trait_name_, op_ std::declval<std::decay_t<T>>())
+    static constexpr auto relaxed = std::memory_order_relaxed;
+    static constexpr auto acquire = std::memory_order_acquire;
+    static constexpr auto release = std::memory_order_release;
+    static constexpr auto seq_cst = std::memory_order_seq_cst;
 
-#define utl_mvl_define_trait_has_member(trait_name_, member_)                                                          \
-    utl_mvl_define_trait(trait_name_, std::declval<std::decay_t<T>>().member_)
+    alignas(cache_line_size) std::atomic<std::int64_t> top{0};    // stealing end, contended by thieves
+    alignas(cache_line_size) std::atomic<std::int64_t> bottom{0}; // owner end
+    alignas(cache_line_size) std::atomic<Buffer*>      buffer{nullptr};
 
-#define utl_mvl_define_trait_has_member_type(trait_name_, member_)                                                     \
-    utl_mvl_define_trait(trait_name_, std::declval<typename std::decay_t<T>::member_>())
+    std::vector<std::unique_ptr<Buffer>> buffers; // owns current & retired buffers, only accessed by the owner
 
-// --- Type traits ---
-// -------------------
+    Buffer* grow(Buffer* old, std::int64_t t, std::int64_t b) {
+        this->buffers.push_back(std::make_unique<Buffer>(old->capacity * 2));
+        Buffer* grown = this->buffers.back().get();
+        for (std::int64_t i = t; i < b; ++i) grown->put(i, old->get(i));
+        return grown;
+    }
 
-utl_mvl_define_trait(_has_ostream_output_op, std::declval<std::ostream>() << std::declval<T>());
+public:
+    WorkStealingDeque() {
+        this->buffers.push_back(std::make_unique<Buffer>(initial_capacity));
+        this->buffer.store(this->buffers.back().get(), relaxed);
+    }
 
-utl_mvl_define_trait_has_binary_op(_has_binary_op_plus, +);
-utl_mvl_define_trait_has_binary_op(_has_binary_op_minus, -);
-utl_mvl_define_trait_has_binary_op(_has_binary_op_multiplies, *);
-utl_mvl_define_trait_has_binary_op(_has_binary_op_less, <);
-utl_mvl_define_trait_has_binary_op(_has_binary_op_greater, >);
-utl_mvl_define_trait_has_binary_op(_has_binary_op_equal, ==);
+    WorkStealingDeque(const WorkStealingDeque&)            = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    // Any thread, approximate unless called by the owner
+    [[nodiscard]] bool empty() const noexcept { return this->bottom.load(relaxed) <= this->top.load(relaxed); }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        const std::int64_t size = this->bottom.load(relaxed) - this->top.load(relaxed);
+        return size > 0 ? static_cast<std::size_t>(size) : 0;
+    }
+
+    // Owner-only
+    void push(T* x) {
+        const std::int64_t b = this->bottom.load(relaxed);
+        const std::int64_t t = this->top.load(acquire);
+        Buffer*            a = this->buffer.load(relaxed);
+
+        if (b - t > a->capacity - 1) {
+            a = this->grow(a, t, b);
+            this->buffer.store(a, release);
+        }
+
+        a->put(b, x);
+        this->bottom.store(b + 1, seq_cst);
+    }
+
+    // Owner-only, returns 'nullptr' if deque is empty
+    [[nodiscard]] T* pop() noexcept {
+        const std::int64_t b = this->bottom.load(relaxed) - 1;
+        Buffer*            a = this->buffer.load(relaxed);
+
+        this->bottom.store(b, seq_cst);
+        std::int64_t t = this->top.load(seq_cst);
+
+        if (t > b) { // deque was empty
+            this->bottom.store(b + 1, relaxed);
+            return nullptr;
+        }
+
+        T* x = a->get(b);
+
+        if (t == b) { // last element, race against thieves
+            if (!this->top.compare_exchange_strong(t, t + 1, seq_cst, relaxed)) x = nullptr;
+            this->bottom.store(b + 1, relaxed);
+        }
+
+        return x;
+    }
+
+    // Any thread, returns 'nullptr' if deque is empty
+    [[nodiscard]] T* steal() noexcept {
+        while (true) {
+            std::int64_t       t = this->top.load(seq_cst);
+            const std::int64_t b = this->bottom.load(seq_cst);
+
+            if (t >= b) return nullptr;
+
+            T* x = this->buffer.load(acquire)->get(t);
+
+            if (this->top.compare_exchange_strong(t, t + 1, seq_cst, relaxed)) return x;
+            // CAS failure means some other thread got the element first, which means we can just retry
+        }
+    }
+};
+
+// ===================
+// --- Event count ---
+// ===================
+
+// Event count is a "condition variable for lock-free code", waiting on it follows a 3-step protocol:
+//    1. 'prepare_wait()' registers a waiter and returns current epoch
+//    2. Waiter re-checks the condition it's waiting for, if it's satisfied => 'cancel_wait()'
+//    3. Otherwise 'commit_wait(epoch)' blocks until somebody notifies after the epoch was taken
+//
+// Notifying side first makes the condition true and then calls 'notify_one()' / 'notify_all()', which
+// only bumps the epoch & wakes up threads if there are registered waiters, otherwise notification is just
+// a single atomic load. Both sides use sequentially consistent operations, which guarantees that either
+// notifier sees the waiter, or the waiter sees the satisfied condition, so no wake-ups can be lost.
+
+// clang-format off
+#if defined(__cpp_lib_atomic_wait) && __cpp_lib_atomic_wait >= 201907L
+    #define utl_parallel_has_atomic_wait
+#endif
+// clang-format on
+
+class EventCount {
+    alignas(cache_line_size) std::atomic<std::uint32_t> epoch{0};
+    alignas(cache_line_size) std::atomic<std::uint32_t> waiters{0};
+
+#ifndef utl_parallel_has_atomic_wait
+    std::mutex              mutex;
+    std::condition_variable cv;
+#endif
+
+    static constexpr std::size_t all_waiters = std::size_t(-1);
+
+    void wake(std::size_t count) {
+        this->epoch.fetch_add(1, std::memory_order_seq_cst);
+
+#ifdef utl_parallel_has_atomic_wait
+        if (count == all_waiters) this->epoch.notify_all();
+        else
+            for (std::size_t i = 0; i < count; ++i) this->epoch.notify_one();
+#else
+        { const std::scoped_lock lock(this->mutex); } // prevents waiter from missing the epoch change
+        if (count == all_waiters) this->cv.notify_all();
+        else
+            for (std::size_t i = 0; i < count; ++i) this->cv.notify_one();
+#endif
+    }
 
-utl_mvl_define_trait_has_assignment_op(_has_assignment_op_plus, +=);
-utl_mvl_define_trait_has_assignment_op(_has_assignment_op_minus, -=);
-utl_mvl_define_trait_has_assignment_op(_has_assignment_op_multiplies, *=);
+public:
+    using key_type = std::uint32_t;
 
-utl_mvl_define_trait_has_unary_op(_has_unary_op_plus, +);
-utl_mvl_define_trait_has_unary_op(_has_unary_op_minus, -);
+    [[nodiscard]] key_type prepare_wait() noexcept {
+        this->waiters.fetch_add(1, std::memory_order_seq_cst);
+        return this->epoch.load(std::memory_order_seq_cst);
+    }
 
-utl_mvl_define_trait_has_member(_has_member_i, i);
-utl_mvl_define_trait_has_member(_has_member_j, j);
-utl_mvl_define_trait_has_member(_has_member_value, value);
+    void cancel_wait() noexcept { this->waiters.fetch_sub(1, std::memory_order_seq_cst); }
 
-utl_mvl_define_trait_has_member(_is_tensor, is_tensor);
-utl_mvl_define_trait_has_member(_is_sparse_entry_1d, is_sparse_entry_1d);
-utl_mvl_define_trait_has_member(_is_sparse_entry_2d, is_sparse_entry_2d);
+    [[nodiscard]] bool has_waiters() const noexcept { return this->waiters.load(std::memory_order_relaxed) != 0; }
 
-// =======================
-// --- Stringification ---
-// =======================
+    void commit_wait(key_type key) {
+#ifdef utl_parallel_has_atomic_wait
+        this->epoch.wait(key, std::memory_order_seq_cst);
+#else
+        std::unique_lock lock(this->mutex);
+        this->cv.wait(lock, [&] { return this->epoch.load(std::memory_order_seq_cst) != key; });
+#endif
+        this->waiters.fetch_sub(1, std::memory_order_seq_cst);
+    }
 
-// Stringification implementation from 'utl::log' module, see its source for more notes.
+    void notify_one() {
+        if (this->waiters.load(std::memory_order_seq_cst)) this->wake(1);
+    }
 
-// --- Internal type traits ---
-// ----------------------------
+    void notify_all() {
+        if (this->waiters.load(std::memory_order_seq_cst)) this->wake(all_waiters);
+    }
 
-utl_mvl_define_trait(_has_string_append, std::string() += std::declval<T>());
-utl_mvl_define_trait(_has_real, std::declval<T>().real());
-utl_mvl_define_trait(_has_imag, std::declval<T>().imag());
-utl_mvl_define_trait(_has_begin, std::declval<T>().begin());
-utl_mvl_define_trait(_has_end, std::declval<T>().end());
-utl_mvl_define_trait(_has_input_iter, std::next(std::declval<T>().begin()));
-utl_mvl_define_trait(_has_get, std::get<0>(std::declval<T>()));
-utl_mvl_define_trait(_has_tuple_size, std::tuple_size<T>::value);
-utl_mvl_define_trait(_has_ostream_insert, std::declval<std::ostream>() << std::declval<T>());
+    void notify(std::size_t count) { // wakes up to 'count' waiters, extra notifications would be wasted syscalls
+        const std::size_t waiters = this->waiters.load(std::memory_order_seq_cst);
+        if (waiters && count) this->wake(count < waiters ? count : all_waiters);
+    }
+};
 
-// --- Internal utils ---
-// ----------------------
+// =================
+// --- Task type ---
+// =================
 
-template <class>
-inline constexpr bool _always_false_v = false;
+// Move-only type-erased 'void()' callable with a small buffer optimization. Closures that fit into the inline
+// storage and have a non-throwing move get stored in-place, others fall back onto a heap allocation. Storage
+// size is selected so the whole task takes exactly 64 bytes, which fits most lambdas capturing a few references
+// or values, as well as a 'std::promise<>' used by awaitable tasks. Compared to 'std::function<>' this means:
+//    - No allocation for closures up to 56 bytes ('std::function<>' SBO is usually just 16 bytes)
+//    - Support for move-only closures, no need to wrap promises into shared pointers
+//    - Non-throwing move, which allows tasks to live in the lock-free & allocation-free containers
+
+class Task {
+    static constexpr std::size_t total_size   = 64;
+    static constexpr std::size_t storage_size = total_size - sizeof(void*);
+
+    struct VTable {
+        void (*invoke)(void* storage);
+        void (*move)(void* dst, void* src) noexcept; // move-constructs 'dst' from 'src' and destroys 'src'
+        void (*destroy)(void* storage) noexcept;
+    };
 
-template <class T>
-constexpr int _log_10_ceil(T num) {
-    return num < 10 ? 1 : 1 + _log_10_ceil(num / 10);
-}
+    template <class F>
+    static constexpr bool fits_inline = sizeof(F) <= storage_size && alignof(F) <= alignof(std::max_align_t) &&
+                                        std::is_nothrow_move_constructible_v<F>;
 
-template <class T>
-constexpr int _max_float_digits =
-    4 + std::numeric_limits<T>::max_digits10 + std::max(2, _log_10_ceil(std::numeric_limits<T>::max_exponent10));
+    template <class F>
+    struct InlineVTable {
+        static F* get(void* storage) noexcept { return std::launder(static_cast<F*>(storage)); }
 
-template <class T>
-constexpr int _max_int_digits = 2 + std::numeric_limits<T>::digits10;
+        static void invoke(void* storage) { (*get(storage))(); }
+        static void move(void* dst, void* src) noexcept {
+            ::new (dst) F(std::move(*get(src)));
+            get(src)->~F();
+        }
+        static void destroy(void* storage) noexcept { get(storage)->~F(); }
 
-// --- Stringifier ---
-// -------------------
+        static constexpr VTable value = {&invoke, &move, &destroy};
+    };
 
-// TODO:
-// Replace or rethink all of this stringifying stuff, perhaps it would be best to just have a super-simple
-// one and let other functions take custom stringifier from 'utl::log'
+    template <class F>
+    struct HeapVTable {
+        static F*& get(void* storage) noexcept { return *std::launder(static_cast<F**>(storage)); }
 
-template <class T>
-void _append_stringified(std::string& str, const T& value);
+        static void invoke(void* storage) { (*get(storage))(); }
+        static void move(void* dst, void* src) noexcept { ::new (dst) F*(get(src)); }
+        static void destroy(void* storage) noexcept { delete get(storage); }
 
-inline void _append_stringified_bool(std::string& str, bool value) { str += value ? "true" : "false"; }
+        static constexpr VTable value = {&invoke, &move, &destroy};
+    };
 
-template <class T>
-void _append_stringified_integer(std::string& str, T value) {
-    std::array<char, _max_int_digits<T>> buffer;
-    const auto [number_end_ptr, error_code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
-    if (error_code != std::errc())
-        throw std::runtime_error(
-            "Integer stringification encountered std::to_chars() formatting error while serializing a value.");
-    str.append(buffer.data(), number_end_ptr - buffer.data());
-}
+    alignas(std::max_align_t) unsigned char storage[storage_size];
+    const VTable* vtable = nullptr;
 
-template <class T>
-void _append_stringified_float(std::string& str, T value) {
-    std::array<char, _max_float_digits<T>> buffer;
-    const auto [number_end_ptr, error_code] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
-    if (error_code != std::errc())
-        throw std::runtime_error(
-            "Float stringification encountered std::to_chars() formatting error while serializing a value.");
-    str.append(buffer.data(), number_end_ptr - buffer.data());
-}
+public:
+    Task() noexcept = default;
 
-template <class T>
-void _append_stringified_complex(std::string& str, T value) {
-    _append_stringified_float(str, value.real());
-    str += " + ";
-    _append_stringified_float(str, value.imag());
-    str += " i";
-}
+    template <class F, std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task>, bool> = true>
+    Task(F&& f) {
+        using closure_type = std::decay_t<F>;
 
-template <class T>
-void _append_stringified_stringlike(std::string& str, const T& value) {
-    str += value;
-}
+        if constexpr (fits_inline<closure_type>) {
+            ::new (static_cast<void*>(this->storage)) closure_type(std::forward<F>(f));
+            this->vtable = &InlineVTable<closure_type>::value;
+        } else {
+            ::new (static_cast<void*>(this->storage)) closure_type*(new closure_type(std::forward<F>(f)));
+            this->vtable = &HeapVTable<closure_type>::value;
+        }
+    }
 
-template <class T>
-void _append_stringified_string_convertible(std::string& str, const T& value) {
-    str += std::string(value);
-}
+    Task(const Task&)            = delete;
+    Task& operator=(const Task&) = delete;
 
-template <class T>
-void _append_stringified_array(std::string& str, const T& value) {
-    str += "{ ";
-    if (value.begin() != value.end())
-        for (auto it = value.begin();;) {
-            _append_stringified(str, *it);
-            if (++it == value.end()) break;
-            str += ", ";
-        }
-    str += " }";
-}
+    Task(Task&& other) noexcept : vtable(other.vtable) {
+        if (this->vtable) this->vtable->move(this->storage, other.storage);
+        other.vtable = nullptr;
+    }
 
-template <class Tuple, std::size_t... Idx>
-void _append_stringified_tuple_impl(std::string& str, Tuple value, std::index_sequence<Idx...>) {
-    ((Idx == 0 ? "" : str += ", ", _append_stringified(str, std::get<Idx>(value))), ...);
-}
+    Task& operator=(Task&& other) noexcept {
+        if (this == &other) return *this;
 
-template <template <class...> class Tuple, class... Args>
-void _append_stringified_tuple(std::string& str, const Tuple<Args...>& value) {
-    str += "< ";
-    _append_stringified_tuple_impl(str, value, std::index_sequence_for<Args...>{});
-    str += " >";
-}
+        this->reset();
+        this->vtable = other.vtable;
+        if (this->vtable) this->vtable->move(this->storage, other.storage);
+        other.vtable = nullptr;
 
-template <class T>
-void _append_stringified_printable(std::string& str, const T& value) {
-    str += (std::ostringstream() << value).str();
-}
+        return *this;
+    }
 
-// --- Selector ---
-// ----------------
+    Task& operator=(std::nullptr_t) noexcept {
+        this->reset();
+        return *this;
+    }
 
-template <class T>
-void _append_stringified(std::string& str, const T& value) {
-    if constexpr (std::is_same_v<T, bool>) _append_stringified_bool(str, value);
-    else if constexpr (std::is_same_v<T, char>) _append_stringified_stringlike(str, value);
-    else if constexpr (std::is_integral_v<T>) _append_stringified_integer(str, value);
-    else if constexpr (std::is_floating_point_v<T>) _append_stringified_float(str, value);
-    else if constexpr (_has_real_v<T> && _has_imag_v<T>) _append_stringified_complex(str, value);
-    else if constexpr (std::is_convertible_v<T, std::string_view>) _append_stringified_stringlike(str, value);
-    else if constexpr (std::is_convertible_v<T, std::string>) _append_stringified_string_convertible(str, value);
-    else if constexpr (_has_begin_v<T> && _has_end_v<T> && _has_input_iter_v<T>) _append_stringified_array(str, value);
-    else if constexpr (_has_get_v<T> && _has_tuple_size_v<T>) _append_stringified_tuple(str, value);
-    else if constexpr (_has_ostream_insert_v<T>) _append_stringified_printable(str, value);
-    else static_assert(_always_false_v<T>, "No valid stringification exists for the type.");
-}
+    ~Task() { this->reset(); }
 
-// --- Public API ---
-// ------------------
+    void reset() noexcept {
+        if (this->vtable) this->vtable->destroy(this->storage);
+        this->vtable = nullptr;
+    }
 
-template <class... Args>
-void append_stringified(std::string& str, Args&&... args) {
-    (_append_stringified(str, std::forward<Args>(args)), ...);
-}
+    void operator()() { this->vtable->invoke(this->storage); }
 
-template <class... Args>
-[[nodiscard]] std::string stringify(Args&&... args) {
-    std::string buffer;
-    append_stringified(buffer, std::forward<Args>(args)...);
-    return buffer;
-}
+    explicit operator bool() const noexcept { return this->vtable; }
+};
 
-// Override "common special cases" that can be improved relative to a generic implementation
-[[nodiscard]] inline std::string stringify(int value) { return std::to_string(value); }
-[[nodiscard]] inline std::string stringify(long value) { return std::to_string(value); }
-[[nodiscard]] inline std::string stringify(long long value) { return std::to_string(value); }
-[[nodiscard]] inline std::string stringify(unsigned int value) { return std::to_string(value); }
-[[nodiscard]] inline std::string stringify(unsigned long value) { return std::to_string(value); }
-[[nodiscard]] inline std::string stringify(unsigned long long value) { return std::to_string(value); }
+static_assert(sizeof(Task) == 64);
 
-// We wrap stringifying function in functor-class so we can use it a default template callable argument.
-// Templates can't infer template parameters from default arguments:
-//
-//    template<class Func>
-//    void do_stuff(Func f = default_f);  // <- CAN'T infer 'Func'
-//
-//    template<class Func = default_functor>
-//    void do_stuff(Func f = Func());     // <- CAN infer 'Func'
-//
-// which is why the "standard" way of doing it (standard as in used by STL containers) is to use functors as default
-// template arguments, if user passes a callable it will override the 'Func' and we get the usual behaviour.
-//
-template <class T>
-struct default_stringifier {
-    [[nodiscard]] std::string operator()(const T& value) const { return stringify(value); }
+// ==================
+// --- Task nodes ---
+// ==================
+
+// Local deques store pointers, which means every recursive task needs a node to live in. To avoid allocating
+// a new node per task, each worker has its own cache of free nodes. Nodes can be freed by any thread in the pool
+// (since tasks can be stolen), in which case they are returned into the remote list of their owner. Remote list is
+// a lock-free stack that only gets pushed to and then drained by the owner in a single exchange, so there's no ABA.
+
+struct TaskNode {
+    Task        task;
+    TaskNode*   next  = nullptr;
+    std::size_t owner = 0; // index of the worker whose cache allocated this node
 };
 
-// ======================
-// --- Codegen Macros ---
-// ======================
+class TaskNodeCache {
+    TaskNode* local_list = nullptr; // owner-only
 
-#define utl_mvl_assert(condition_) assert(condition_)
-// if (!__VA_ARGS__) throw std::runtime_error("Failed assert on line " + std::to_string(__LINE__))
+    alignas(cache_line_size) std::atomic<TaskNode*> remote_list{nullptr};
 
-// ========================
-// --- Helper Functions ---
-// ========================
+    static void free_list(TaskNode* head) noexcept {
+        while (head) delete std::exchange(head, head->next);
+    }
 
-// Shortcut for lambda-type-based SFINAE.
-//
-// Callables in this module are usually takes as a template type since 'std::function<>' introduces very significant
-// overhead with its type erasure. With template args all lambdas and functors can be nicely inlined, however we lose
-// the ability to overload functions that take callable the way we could with 'std::function<>'.
-//
-// As a workaround we can use SFINAE to reject "overloads" tha don't have a particular signature, effectively achieving
-// the behaviour we need.
-template <class FuncType, class Signature>
-using _has_signature_enable_if = std::enable_if_t<std::is_convertible_v<FuncType, std::function<Signature>>, bool>;
+public:
+    TaskNodeCache() = default;
 
-template <class T>
-[[nodiscard]] std::unique_ptr<T[]> _make_unique_ptr_array(size_t size) {
-    return std::unique_ptr<T[]>(new T[size]);
-}
+    TaskNodeCache(const TaskNodeCache&)            = delete;
+    TaskNodeCache& operator=(const TaskNodeCache&) = delete;
 
-// Macro version of 'std::unreachable()' implementation from https://en.cppreference.com/w/cpp/utility/unreachable
-// we use macro instead of a function to work around false-positive MSVC /W4 warnings about "unreachable code"
-// in a function that exists to mark unreachable code
-#if defined(_MSC_VER) && !defined(__clang__) // MSVC
-#define utl_mvl_unreachable static_assert(true)
-#else // GCC, Clang
-#define utl_mvl_unreachable __builtin_unreachable()
-#endif
+    ~TaskNodeCache() {
+        free_list(this->local_list);
+        free_list(this->remote_list.load(std::memory_order_acquire));
+    }
 
-// =======================
-// --- Utility Classes ---
-// =======================
+    // Owner-only
+    [[nodiscard]] TaskNode* acquire(std::size_t owner) {
+        if (!this->local_list) this->local_list = this->remote_list.exchange(nullptr, std::memory_order_acquire);
 
-// Wrapper that allows passing standard set of member types down the CRTP chain
-// (types have to be passed through template args one way or another. Trying to access
-// 'derived_type::value_type' from the CRTP base class will fail, since in order for it to be available
-// the derived class has to be "implemented" which can only happen after the base class is "implemented",
-// which requires the type => a logical loop. So we wrap all the types in a class a pass them down
-// the chain a "pack with everything" type of deal. This pack then gets "unwrapped" with
-// '_utl_storage_define_types' macro in every class => we have all the member types defined).
-//
-// (!) Since CRTP approach has been deprecated in favor of mixins, the original reasoning is no longer
-// accurate, however it is this a useful class whenever a pack of types has to be passed through a
-// template (like, for example, in iterator implementation)
-template <class T>
-struct _types {
-    using value_type      = T;
-    using size_type       = std::size_t;
-    using difference_type = std::ptrdiff_t;
-    using reference       = T&;
-    using const_reference = const T&;
-    using pointer         = T*;
-    using const_pointer   = const T*;
+        if (!this->local_list) {
+            TaskNode* node = new TaskNode;
+            node->owner    = owner;
+            return node;
+        }
+
+        return std::exchange(this->local_list, this->local_list->next);
+    }
+
+    // Owner-only
+    void release_local(TaskNode* node) noexcept {
+        node->next       = this->local_list;
+        this->local_list = node;
+    }
+
+    // Any thread
+    void release_remote(TaskNode* node) noexcept {
+        TaskNode* head = this->remote_list.load(std::memory_order_relaxed);
+        do {
+            node->next = head;
+        } while (!this->remote_list.compare_exchange_weak(head, node, std::memory_order_release,
+                                                          std::memory_order_relaxed));
+    }
 };
 
-// A minimal equivalent of the once proposed 'std::observer_ptr<>'.
-// Used in views to allow observer pointers with the same interface as 'std::unique_ptr',
-// which means a generic '.data()` can be implemented without having to make a separate version for views and containers
+// ==================
+// --- Ring queue ---
+// ==================
+
+// Growable FIFO queue based on a ring buffer. Unlike 'std::queue<>' (which uses 'std::deque<>' underneath)
+// it never releases its storage, which means pushing & popping doesn't allocate once the queue warms up.
+
 template <class T>
-class _observer_ptr {
-public:
-    using element_type = T;
+class RingQueue {
+    std::vector<T> buffer; // capacity is always a power of 2
+    std::size_t    head  = 0;
+    std::size_t    count = 0;
 
-private:
-    element_type* _data = nullptr;
+    void grow() {
+        std::vector<T> grown(this->buffer.empty() ? 16 : this->buffer.size() * 2);
+        for (std::size_t i = 0; i < this->count; ++i) grown[i] = std::move(this->buffer[this->index(i)]);
+
+        this->buffer = std::move(grown);
+        this->head   = 0;
+    }
+
+    [[nodiscard]] std::size_t index(std::size_t i) const noexcept {
+        return (this->head + i) & (this->buffer.size() - 1);
+    }
 
 public:
-    // - Constructors -
-    constexpr _observer_ptr() noexcept = default;
-    constexpr _observer_ptr(std::nullptr_t) noexcept {}
-    explicit _observer_ptr(element_type* ptr) : _data(ptr) {}
+    [[nodiscard]] bool        empty() const noexcept { return this->count == 0; }
+    [[nodiscard]] std::size_t size() const noexcept { return this->count; }
 
-    _observer_ptr& operator=(element_type* ptr) {
-        this->_data = ptr;
-        return *this;
+    void push(T&& value) {
+        if (this->count == this->buffer.size()) this->grow();
+
+        this->buffer[this->index(this->count)] = std::move(value);
+        ++this->count;
     }
 
-    // - Interface -
-    [[nodiscard]] constexpr element_type* get() const noexcept { return _data; }
+    void pop(T& value) noexcept {
+        value      = std::move(this->buffer[this->head]);
+        this->head = this->index(1);
+        --this->count;
+    }
 };
 
 // =================
-// --- Iterators ---
+// --- Placement ---
 // =================
 
-// Iterator template for 1D iterator over a tensor.
-// Reduces code duplication for const & non-const variants by bundling some conditional logic.
-// Uses 'operator[]' of 'ParentPointer' for all logic, thus allowing arbitrary tensors that
-// don't have to be contiguous or even ordered in memory.
-template <class ParentPointer, class Types, bool is_const_iter = false>
-class _flat_iterator {
-    using parent_pointer = ParentPointer;
+// Worker placement policy, describes how pool threads get pinned to CPUs:
+//    - 'none'           - no pinning, OS is free to migrate threads (default)
+//    - 'compact'        - workers fill CPUs in topological order, neighbouring workers share cores & sockets
+//    - 'scatter'        - workers alternate between NUMA nodes & physical cores, hyper-threads get used last
+//    - 'physical_cores' - one worker per physical core, hyper-threads are left unused
+//    - 'cpu_list'       - worker 'i' gets pinned to 'cpus[i % cpus.size()]'
+// If there are more workers than suitable CPUs, assignment wraps around. Only CPUs allowed by the affinity mask of
+// the thread creating the pool are considered. Pinning is implemented for Linux, elsewhere every policy is a no-op.
 
-public:
-    // Iterator reqs: [General]
-    // Contains member types      =>
-    using iterator_category = std::random_access_iterator_tag;
-    using difference_type   = typename Types::difference_type;
-    using value_type        = typename Types::value_type;
-    using pointer = typename std::conditional_t<is_const_iter, typename Types::const_pointer, typename Types::pointer>;
-    using reference =
-        typename std::conditional_t<is_const_iter, typename Types::const_reference, typename Types::reference>;
+struct Placement {
+    enum class Policy { none, compact, scatter, physical_cores, cpu_list };
 
-    // Iterator reqs: [General]
-    // Constructible
-    _flat_iterator(parent_pointer parent, difference_type idx) : _parent(parent), _idx(idx) {}
-    // Copy-constructible => by default
-    // Copy-assignable    => by default
-    // Destructible       => by default
-    // Swappable
-    friend void swap(_flat_iterator& lhs, _flat_iterator& rhs) { std::swap(lhs._idx, rhs._idx); }
+    Policy                   policy = Policy::none;
+    std::vector<std::size_t> cpus; // only used by 'cpu_list'
 
-    // Iterator reqs: [General]
-    // Can be incremented (prefix & postfix)
-    _flat_iterator& operator++() {
-        ++_idx;
-        return *this;
-    } // prefix
-    _flat_iterator operator++(int) {
-        _flat_iterator temp = *this;
-        ++_idx;
-        return temp;
-    } // postfix
+    [[nodiscard]] static Placement none() { return {Policy::none, {}}; }
+    [[nodiscard]] static Placement compact() { return {Policy::compact, {}}; }
+    [[nodiscard]] static Placement scatter() { return {Policy::scatter, {}}; }
+    [[nodiscard]] static Placement physical_cores() { return {Policy::physical_cores, {}}; }
+    [[nodiscard]] static Placement cpu_list(std::vector<std::size_t> cpus) {
+        return {Policy::cpu_list, std::move(cpus)};
+    }
+};
 
-    // Iterator reqs: [Input iterator]
-    // Supports equality/inequality comparisons
-    friend bool operator==(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx == it2._idx; };
-    friend bool operator!=(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx != it2._idx; };
-    // Can be dereferenced as an rvalue
-    reference   operator*() const { return _parent->operator[](_idx); }
-    pointer     operator->() const { return &_parent->operator[](_idx); }
+struct CpuInfo {
+    std::size_t cpu;
+    std::size_t node;
+    std::size_t package;
+    std::size_t core;
+};
 
-    // Iterator reqs: [Output iterator]
-    // Can be dereferenced as an lvalue (only for mutable iterator types) => not needed
+#ifdef utl_parallel_has_thread_affinity
 
-    // Iterator reqs: [Forward iterator]
-    // Default-constructible
-    _flat_iterator() : _parent(nullptr), _idx(0) {}
-    // "Multi-pass" - dereferencing & incrementing does not affects dereferenceability => satisfied
+// Parses sysfs CPU & node lists, for example '0-3,8-11'
+[[nodiscard]] inline std::vector<std::size_t> parse_cpu_list(const std::string& str) {
+    std::vector<std::size_t> list;
 
-    // Iterator reqs: [Bidirectional iterator]
-    // Can be decremented
-    _flat_iterator& operator--() {
-        --_idx;
-        return *this;
-    } // prefix
-    _flat_iterator operator--(int) {
-        _flat_iterator temp = *this;
-        --_idx;
-        return temp;
-    } // postfix
+    for (std::size_t pos = 0; pos < str.size();) {
+        const std::size_t end   = std::min(str.find(',', pos), str.size());
+        const std::string token = str.substr(pos, end - pos);
+        pos                     = end + 1;
 
-    // Iterator reqs: [Random Access iterator]
-    // See: https://en.cppreference.com/w/cpp/named_req/RandomAccessIterator
-    // Supports arithmetic operators: it + n, n + it, it - n, it1 - it2
-    friend _flat_iterator operator+(const _flat_iterator& it, difference_type diff) {
-        return _flat_iterator(it._parent, it._idx + diff);
-    }
-    friend _flat_iterator operator+(difference_type diff, const _flat_iterator& it) {
-        return _flat_iterator(it._parent, it._idx + diff);
-    }
-    friend _flat_iterator operator-(const _flat_iterator& it, difference_type diff) {
-        return _flat_iterator(it._parent, it._idx - diff);
-    }
-    friend difference_type operator-(const _flat_iterator& it1, const _flat_iterator& it2) {
-        return it1._idx - it2._idx;
+        if (token.empty()) continue;
+
+        const std::size_t dash  = token.find('-');
+        const std::size_t first = std::stoul(token.substr(0, dash));
+        const std::size_t last  = (dash == std::string::npos) ? first : std::stoul(token.substr(dash + 1));
+
+        for (std::size_t i = first; i <= last; ++i) list.push_back(i);
     }
-    // Supports inequality comparisons (<, >, <= and >=) between iterators
-    friend bool     operator<(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx < it2._idx; }
-    friend bool     operator>(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx > it2._idx; }
-    friend bool     operator<=(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx <= it2._idx; }
-    friend bool     operator>=(const _flat_iterator& it1, const _flat_iterator& it2) { return it1._idx >= it2._idx; }
-    // Standard assumption: Both iterators are from the same container => no need to compare '_parent'
-    // Supports compound assignment operations += and -=
-    _flat_iterator& operator+=(difference_type diff) {
-        _idx += diff;
-        return *this;
+
+    return list;
+}
+
+[[nodiscard]] inline std::string read_sysfs_line(const std::string& path) {
+    std::ifstream file(path);
+    std::string   line;
+    std::getline(file, line);
+    return line; // missing file => empty line
+}
+
+#endif
+
+// Returns topology of CPUs available to the calling thread, empty if it can't be determined
+[[nodiscard]] inline std::vector<CpuInfo> get_cpu_topology() {
+#ifdef utl_parallel_has_thread_affinity
+    try {
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (pthread_getaffinity_np(pthread_self(), sizeof(allowed), &allowed) != 0) return {};
+
+        constexpr std::size_t max_cpus = CPU_SETSIZE;
+
+        std::vector<std::size_t> cpu_nodes(max_cpus, 0); // systems without NUMA have no node info => single node
+        for (std::size_t node : parse_cpu_list(read_sysfs_line("/sys/devices/system/node/online"))) {
+            const std::string path = "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist";
+            for (std::size_t cpu : parse_cpu_list(read_sysfs_line(path)))
+                if (cpu < max_cpus) cpu_nodes[cpu] = node;
+        }
+
+        const auto read_id = [](const std::string& path, std::size_t fallback) {
+            const std::string line = read_sysfs_line(path);
+            return line.empty() ? fallback : std::size_t(std::stoul(line));
+        };
+
+        std::vector<CpuInfo> topology;
+        for (std::size_t cpu = 0; cpu < max_cpus; ++cpu) {
+            if (!CPU_ISSET(cpu, &allowed)) continue;
+
+            const std::string dir     = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/";
+            const std::size_t package = read_id(dir + "physical_package_id", 0);
+            const std::size_t core    = read_id(dir + "core_id", cpu); // unknown core => every CPU is a core
+
+            topology.push_back({cpu, cpu_nodes[cpu], package, core});
+        }
+
+        return topology;
+    } catch (...) { return {}; } // malformed sysfs is treated the same as missing one
+#else
+    return {};
+#endif
+}
+
+// Returns CPUs assigned to each of the 'count' workers, empty if workers shouldn't be pinned
+[[nodiscard]] inline std::vector<CpuInfo> assign_cpus(const Placement& placement, std::size_t count,
+                                                      std::vector<CpuInfo> topology) {
+    using Policy = Placement::Policy;
+
+    if (placement.policy == Policy::none || count == 0) return {};
+
+    std::sort(topology.begin(), topology.end(), [](const CpuInfo& lhs, const CpuInfo& rhs) {
+        return std::tie(lhs.node, lhs.package, lhs.core, lhs.cpu) < std::tie(rhs.node, rhs.package, rhs.core, rhs.cpu);
+    });
+
+    // Rank of each CPU among hyper-threads of its core & rank of its core inside the NUMA node,
+    // topological sort above puts hyper-threads of a core next to each other, so one pass is enough
+    std::vector<std::size_t> smt_ranks(topology.size()), core_ranks(topology.size());
+    for (std::size_t i = 0; i < topology.size(); ++i) {
+        if (i == 0 || topology[i].node != topology[i - 1].node) {
+            smt_ranks[i]  = 0;
+            core_ranks[i] = 0;
+        } else if (topology[i].package == topology[i - 1].package && topology[i].core == topology[i - 1].core) {
+            smt_ranks[i]  = smt_ranks[i - 1] + 1;
+            core_ranks[i] = core_ranks[i - 1];
+        } else {
+            smt_ranks[i]  = 0;
+            core_ranks[i] = core_ranks[i - 1] + 1;
+        }
     }
-    _flat_iterator& operator-=(difference_type diff) {
-        _idx -= diff;
-        return *this;
+
+    std::vector<CpuInfo> order;
+
+    if (placement.policy == Policy::compact) {
+        order = topology;
+    } else if (placement.policy == Policy::physical_cores) {
+        for (std::size_t i = 0; i < topology.size(); ++i)
+            if (smt_ranks[i] == 0) order.push_back(topology[i]);
+    } else if (placement.policy == Policy::scatter) {
+        std::vector<std::size_t> indices(topology.size());
+        for (std::size_t i = 0; i < indices.size(); ++i) indices[i] = i;
+
+        std::sort(indices.begin(), indices.end(), [&](std::size_t lhs, std::size_t rhs) {
+            return std::tie(smt_ranks[lhs], core_ranks[lhs], topology[lhs].node) <
+                   std::tie(smt_ranks[rhs], core_ranks[rhs], topology[rhs].node);
+        });
+
+        for (std::size_t i : indices) order.push_back(topology[i]);
+    } else if (placement.policy == Policy::cpu_list) {
+        for (std::size_t cpu : placement.cpus)
+            for (const CpuInfo& info : topology)
+                if (info.cpu == cpu) order.push_back(info); // CPUs that aren't available get skipped
     }
-    // Supports offset dereference operator ([])
-    reference operator[](difference_type diff) const { return _parent->operator[](_idx + diff); }
 
-private:
-    parent_pointer  _parent;
-    difference_type _idx; // not size_type because we have to use it in 'difference_type' operations most of the time
-};
+    if (order.empty()) return {};
 
-// ======================================
-// --- Sparse Matrix Pairs & Triplets ---
-// ======================================
+    std::vector<CpuInfo> assignment(count);
+    for (std::size_t i = 0; i < count; ++i) assignment[i] = order[i % order.size()];
+    return assignment;
+}
 
-// Note:
-// All sparse entries and multi-dimensional indices can be sorted lexicographically
+inline void pin_this_thread(std::size_t cpu) noexcept {
+#ifdef utl_parallel_has_thread_affinity
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set); // failure just leaves the thread unpinned
+#else
+    (void)cpu;
+#endif
+}
 
-template <class T>
-struct SparseEntry1D {
-    size_t i;
-    T      value;
+// ==================
+// --- Statistics ---
+// ==================
 
-    constexpr static bool is_sparse_entry_1d = true;
+// Thread pool can optionally collect per-worker statistics, which is useful for tuning grain sizes & priorities.
+// Each counter has a single writer (its worker), so updates are plain relaxed load & store rather than atomic
+// read-modify-write, atomics only let 'stats()' read counters from other threads without a data race. Disabled
+// statistics compile out entirely, the only leftover is an empty vector of counters.
 
-    [[nodiscard]] bool operator<(const SparseEntry1D& other) const noexcept { return this->i < other.i; }
-    [[nodiscard]] bool operator>(const SparseEntry1D& other) const noexcept { return this->i > other.i; }
+// clang-format off
+#ifdef UTL_PARALLEL_ENABLE_STATS
+    constexpr bool stats_enabled = true;
+#else
+    constexpr bool stats_enabled = false;
+#endif
+// clang-format on
+
+using stats_clock = std::chrono::steady_clock;
+
+constexpr std::size_t latency_buckets = 32;
+
+[[nodiscard]] inline std::uint64_t elapsed_ns(stats_clock::time_point start) noexcept {
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(stats_clock::now() - start);
+    return static_cast<std::uint64_t>(elapsed.count());
+}
+
+// Bucket 'k > 0' counts latencies in '[2^(k-1), 2^k)' nanoseconds, the last one also counts everything above
+[[nodiscard]] constexpr std::size_t latency_bucket(std::uint64_t ns) noexcept {
+    std::size_t bucket = 0;
+    for (; ns && bucket < latency_buckets - 1; ns >>= 1) ++bucket;
+    return bucket;
+}
+
+struct WorkerStats {
+    std::size_t              executed_tasks        = 0;
+    std::size_t              local_pops            = 0;
+    std::size_t              global_pops           = 0;
+    std::size_t              steals                = 0;
+    std::size_t              failed_steals         = 0;
+    std::size_t              max_local_queue_depth = 0;
+    std::chrono::nanoseconds idle_time             = std::chrono::nanoseconds{0};
+
+    std::array<std::size_t, latency_buckets> latency_histogram{}; // time from submission to execution
 };
 
-template <class T>
-struct SparseEntry2D {
-    size_t i;
-    size_t j;
-    T      value;
+struct PoolStats {
+    std::vector<WorkerStats> workers;
+    std::size_t              max_global_queue_depth = 0;
+
+    [[nodiscard]] WorkerStats total() const {
+        WorkerStats total;
+
+        for (const auto& worker : this->workers) {
+            total.executed_tasks += worker.executed_tasks;
+            total.local_pops += worker.local_pops;
+            total.global_pops += worker.global_pops;
+            total.steals += worker.steals;
+            total.failed_steals += worker.failed_steals;
+            if (total.max_local_queue_depth < worker.max_local_queue_depth)
+                total.max_local_queue_depth = worker.max_local_queue_depth;
+            total.idle_time += worker.idle_time;
+            for (std::size_t i = 0; i < latency_buckets; ++i) total.latency_histogram[i] += worker.latency_histogram[i];
+        }
 
-    constexpr static bool is_sparse_entry_2d = true;
+        return total;
+    }
+};
 
-    [[nodiscard]] bool operator<(const SparseEntry2D& other) const noexcept {
-        return (this->i < other.i) || (this->j < other.j);
+struct WorkerCounters {
+    using counter_type = std::atomic<std::size_t>;
+
+    counter_type executed_tasks{0};
+    counter_type local_pops{0};
+    counter_type global_pops{0};
+    counter_type steals{0};
+    counter_type failed_steals{0};
+    counter_type max_local_queue_depth{0};
+    counter_type idle_ns{0};
+
+    std::array<counter_type, latency_buckets> latency_histogram{};
+
+    static void add(counter_type& counter, std::size_t value) noexcept {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
     }
-    [[nodiscard]] bool operator>(const SparseEntry2D& other) const noexcept {
-        return (this->i > other.i) || (this->j > other.j);
+
+    static void raise(counter_type& counter, std::size_t value) noexcept {
+        if (counter.load(std::memory_order_relaxed) < value) counter.store(value, std::memory_order_relaxed);
     }
-};
 
-struct Index2D {
-    size_t i;
-    size_t j;
+    [[nodiscard]] WorkerStats snapshot() const noexcept {
+        WorkerStats stats;
 
-    [[nodiscard]] bool operator<(const Index2D& other) const noexcept {
-        return (this->i < other.i) || (this->j < other.j);
+        stats.executed_tasks        = this->executed_tasks.load(std::memory_order_relaxed);
+        stats.local_pops            = this->local_pops.load(std::memory_order_relaxed);
+        stats.global_pops           = this->global_pops.load(std::memory_order_relaxed);
+        stats.steals                = this->steals.load(std::memory_order_relaxed);
+        stats.failed_steals         = this->failed_steals.load(std::memory_order_relaxed);
+        stats.max_local_queue_depth = this->max_local_queue_depth.load(std::memory_order_relaxed);
+        stats.idle_time             = std::chrono::nanoseconds(this->idle_ns.load(std::memory_order_relaxed));
+
+        for (std::size_t i = 0; i < latency_buckets; ++i)
+            stats.latency_histogram[i] = this->latency_histogram[i].load(std::memory_order_relaxed);
+
+        return stats;
     }
-    [[nodiscard]] bool operator>(const Index2D& other) const noexcept {
-        return (this->i > other.i) || (this->j > other.j);
+};
+
+// ==================
+// --- Coroutines ---
+// ==================
+
+// C++20 coroutine support. 'Coroutine<T>' is a lazy task, it starts either when awaited (in which case it runs
+// inline on the awaiting thread) or when spawned onto a thread pool. Completion is tracked by a single atomic:
+//    - 'pending' => coroutine is still running and nobody awaits it yet
+//    - 'ready'   => coroutine has finished
+//    - Any other value is the address of an awaiting coroutine, which gets resumed on whatever thread finishes
+//      the awaited one through a symmetric transfer, this way no thread ever blocks while awaiting
+// Waiting from regular code goes through a small helper coroutine that signals a blocking event.
+
+#ifdef utl_parallel_has_coroutines
+
+class ThreadPool;
+
+template <class T = void>
+class Coroutine;
+
+// Notification happens under the lock, once the waiter sees 'done' the event may be destroyed
+class BlockingEvent {
+    std::mutex              mutex;
+    std::condition_variable cv;
+    bool                    done = false;
+
+public:
+    void set() {
+        const std::scoped_lock lock(this->mutex);
+        this->done = true;
+        this->cv.notify_all();
     }
-    [[nodiscard]] bool operator==(const Index2D& other) const noexcept {
-        return (this->i == other.i) && (this->j == other.j);
+
+    void wait() {
+        std::unique_lock lock(this->mutex);
+        this->cv.wait(lock, [this] { return this->done; });
     }
 };
 
-// Functions that take 2 sparse entries '{ i, j, v1 }' and '{ i, j, v2 }' and return '{ i, j, op(v1, v2) }'.
-// Same thing for 1D sparse entries. LHS/RHS index correctness only gets checked in debug.
-//
-// Declaring these functions saves us from having to duplicate implementations of 'apply_binary_operator()'
-// for 1D and 2D sparse entries that have different number of constructor args. Instead, those cases will
-// be handled by '_apply_binary_op_to_sparse_entry()' that is SFINAE-overloaded to work with both.
-//
-// Implementations use perfect forwarding for everything and do the "overloading" through SFINAE with type traits.
-//
-// In reality 'op' doesn't ever get forwarded as an r-value but since are doing things generic why not forward it
-// properly as well. This is also somewhat ugly, but it works well enough and there isn't much reason to rewrite
-// this with some new abstraction.
-//
-template <class L, class R, class Op, _is_sparse_entry_1d_enable_if<L> = true, _is_sparse_entry_1d_enable_if<R> = true>
-std::decay_t<L> _apply_binary_op_to_sparse_entries(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.i == right.i);
-    return {left.i, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right).value)};
-}
+class SyncWaiter {
+public:
+    struct promise_type {
+        BlockingEvent* event = nullptr;
 
-template <class L, class R, class Op, _is_sparse_entry_2d_enable_if<L> = true, _is_sparse_entry_2d_enable_if<R> = true>
-std::decay_t<L> _apply_binary_op_to_sparse_entries(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.i == right.i);
-    utl_mvl_assert(left.j == right.j);
-    return {left.i, left.j, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right).value)};
-}
+        struct FinalAwaiter {
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<promise_type> handle) noexcept { handle.promise().event->set(); }
+            void await_resume() const noexcept {}
+        };
 
-template <class L, class R, class Op, _is_sparse_entry_1d_enable_if<L> = true>
-std::decay_t<L> _apply_binary_op_to_sparse_entry_and_value(L&& left, R&& right_value, Op&& op) {
-    return {left.i, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right_value))};
-}
+        SyncWaiter get_return_object() noexcept {
+            return SyncWaiter{std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() const noexcept { return {}; }
+        FinalAwaiter        final_suspend() const noexcept { return {}; }
+        void                return_void() const noexcept {}
+        void                unhandled_exception() const noexcept { std::terminate(); } // completion can't throw
+    };
 
-template <class L, class R, class Op, _is_sparse_entry_2d_enable_if<L> = true>
-std::decay_t<L> _apply_binary_op_to_sparse_entry_and_value(L&& left, R&& right_value, Op&& op) {
-    return {left.i, left.j, std::forward<Op>(op)(std::forward<L>(left).value, std::forward<R>(right_value))};
-}
+private:
+    std::coroutine_handle<promise_type> handle;
 
-template <class L, class R, class Op, _is_sparse_entry_1d_enable_if<R> = true>
-std::decay_t<R> _apply_binary_op_to_value_and_sparse_entry(L&& left_value, R&& right, Op&& op) {
-    return {right.i, std::forward<Op>(op)(std::forward<L>(left_value), std::forward<R>(right).value)};
-}
+    explicit SyncWaiter(std::coroutine_handle<promise_type> handle) : handle(handle) {}
 
-template <class L, class R, class Op, _is_sparse_entry_2d_enable_if<R> = true>
-std::decay_t<R> _apply_binary_op_to_value_and_sparse_entry(L&& left_value, R&& right, Op&& op) {
-    return {right.i, right.j, std::forward<Op>(op)(std::forward<L>(left_value), std::forward<R>(right).value)};
-}
+    template <class Awaitable>
+    static SyncWaiter make(Awaitable& awaitable) {
+        co_await awaitable;
+    }
 
-// TODO:
-// Fix binary ops, figure out what the hell did I even do here
+public:
+    SyncWaiter(const SyncWaiter&)            = delete;
+    SyncWaiter& operator=(const SyncWaiter&) = delete;
 
-// =============
-// --- Enums ---
-// =============
+    ~SyncWaiter() { this->handle.destroy(); }
 
-// Parameter enums
-//
-// Their combination specifies compiled tensor API.
-enum class Dimension { VECTOR, MATRIX };
-enum class Type { DENSE, STRIDED, SPARSE };
-enum class Ownership { CONTAINER, VIEW, CONST_VIEW };
+    // Blocks current thread until 'awaitable' is done, doesn't park a thread per await in coroutine code
+    template <class Awaitable>
+    static void wait(Awaitable&& awaitable) {
+        BlockingEvent event;
 
-// Config enums
-//
-// They specify conditional logic for a tensor.
-// Combination of config & parameter enums fully defines a GenericTensor.
-enum class Checking { NONE, BOUNDS };
-enum class Layout { /* 1D */ FLAT, /* 2D */ RC, CR, /* Other */ SPARSE };
+        SyncWaiter waiter = make(awaitable);
+        waiter.handle.promise().event = &event;
+        waiter.handle.resume();
 
-// Shortcut template used to deduce type of '_data' based on tensor 'ownership' parameter
-template <Ownership ownership, class ContainerResult, class ViewResult, class ConstViewResult>
-using _choose_based_on_ownership =
-    std::conditional_t<ownership == Ownership::CONTAINER, ContainerResult,
-                       std::conditional_t<ownership == Ownership::VIEW, ViewResult, ConstViewResult>>;
+        event.wait();
+    }
+};
 
-// Shortcut template used to check that both arguments are tensors
-// that have the same value type, mostly used in binary operators
-// for nicer error messages and to prevent accidental conversions
-template <class L, class R>
-using _are_tensors_with_same_value_type_enable_if =
-    std::enable_if_t<_is_tensor_v<L> && _is_tensor_v<R> &&
-                         std::is_same_v<typename std::decay_t<L>::value_type, typename std::decay_t<R>::value_type>,
-                     bool>;
+struct CoroutinePromiseBase {
+    static constexpr std::uintptr_t pending = 0;
+    static constexpr std::uintptr_t ready   = 1;
 
-// =====================================
-// --- Boilerplate generation macros ---
-// =====================================
+    std::atomic<std::uintptr_t> state{pending}; // 'pending', 'ready' or an address of the awaiting coroutine
+    bool                        started = false;
+    std::exception_ptr          exception;
 
-// Macros used to pass around unwieldy chains of tensor template arguments.
-//
-#define utl_mvl_tensor_arg_defs                                                                                        \
-    class T, Dimension _dimension, Type _type, Ownership _ownership, Checking _checking, Layout _layout
+    template <class Promise>
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
 
-#define utl_mvl_tensor_arg_vals T, _dimension, _type, _ownership, _checking, _layout
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            const std::uintptr_t awaiting = handle.promise().state.exchange(ready, std::memory_order_acq_rel);
+            // can't touch the promise past this point, awaiting side is free to destroy the frame once it sees 'ready'
 
-// Incredibly important macros used for conditional compilation of member functions.
-// They automatically create the boilerplate that makes member functions dependant on the template parameters,
-// which is necessary for conditional compilation and "forward" to a 'enable_if' condition.
-//
-// 'utl_mvl_require' is intended to be used inside template methods (template in a sense that they have other template
-// args besides this conditional compilation boilerplate which technically makes all methods template).
-//
-// 'utl_mvl_reqs' is used when we want only conditional compilation (aka majority of cases) and cuts down on
-// boilerplate even more.
-//
-#define utl_mvl_require(condition_)                                                                                    \
-    class value_type = T, Dimension dimension = _dimension, Type type = _type, Ownership ownership = _ownership,       \
-          Checking checking = _checking, Layout layout = _layout, std::enable_if_t<condition_, bool> = true
+            if (awaiting == pending) return std::noop_coroutine();
+            return std::coroutine_handle<>::from_address(reinterpret_cast<void*>(awaiting));
+        }
 
-#define utl_mvl_reqs(condition_) template <utl_mvl_require(condition_)>
+        void await_resume() const noexcept {}
+    };
 
-// A somewhat scuffed version of trait-defining macro used to create SFINAE-restrictions
-// on tensor params in free functions. Only supports trivial conditions of the form
-// '<parameter> [==][!=] <value>'. Perhaps there is a better way of doing it, but I'm not yet sure.
-//
-// Used mostly to restrict linear algebra operations for sparse/nonsparse so we can get
-// a "SFINAE-driven overloading" on operators that take both arguments with perfect forwarding,
-// which means they can't be overloaded in a regular way
-//
-#define utl_mvl_define_tensor_param_restriction(trait_name_, expr_)                                                    \
-    template <class T>                                                                                                 \
-    constexpr bool trait_name_##_v = (std::decay_t<T>::params::expr_);                                                 \
-                                                                                                                       \
-    template <class T>                                                                                                 \
-    using trait_name_##_enable_if = std::enable_if_t<trait_name_##_v<T>, bool>;
+    std::suspend_always initial_suspend() const noexcept { return {}; } // coroutines are lazy
+    void                unhandled_exception() noexcept { this->exception = std::current_exception(); }
 
-utl_mvl_define_tensor_param_restriction(_is_sparse_tensor, type == Type::SPARSE);
-utl_mvl_define_tensor_param_restriction(_is_nonsparse_tensor, type != Type::SPARSE);
-utl_mvl_define_tensor_param_restriction(_is_matrix_tensor, dimension == Dimension::MATRIX);
+    void rethrow_if_failed() const {
+        if (this->exception) std::rethrow_exception(this->exception);
+    }
+};
 
-// ===========================
-// --- Data Member Classes ---
-// ===========================
+template <class T>
+struct CoroutinePromise : CoroutinePromiseBase {
+    std::optional<T> value;
 
-// Unlike class method, member values can't be templated, which prevents us from using regular 'enable_if_t' SFINAE
-// for their conditional compilation. The (seemingly) best workaround to compile members conditionally is to inherit
-// 'std::conditional<T, EmptyClass>' where 'T' is a "dummy" class with the sole purpose of having data members to
-// inherit. This does not introduce virtualization (which is good, that how we want it).
+    Coroutine<T>                      get_return_object() noexcept;
+    FinalAwaiter<CoroutinePromise<T>> final_suspend() const noexcept { return {}; }
 
-template <int id>
-struct _nothing {};
+    template <class U = T>
+    void return_value(U&& value) {
+        this->value.emplace(std::forward<U>(value));
+    }
 
-template <utl_mvl_tensor_arg_defs>
-class _2d_extents {
-private:
-    using size_type = typename _types<T>::size_type;
+    T& result() & {
+        this->rethrow_if_failed();
+        return *this->value;
+    }
 
-public:
-    size_type _rows = 0;
-    size_type _cols = 0;
+    T result() && {
+        this->rethrow_if_failed();
+        return std::move(*this->value);
+    }
 };
 
-template <utl_mvl_tensor_arg_defs>
-class _2d_strides {
-private:
-    using size_type = typename _types<T>::size_type;
+template <>
+struct CoroutinePromise<void> : CoroutinePromiseBase {
+    Coroutine<void>                      get_return_object() noexcept;
+    FinalAwaiter<CoroutinePromise<void>> final_suspend() const noexcept { return {}; }
 
-public:
-    size_type _row_stride = 0;
-    size_type _col_stride = 0;
+    void return_void() const noexcept {}
+
+    void result() const { this->rethrow_if_failed(); }
 };
 
-template <utl_mvl_tensor_arg_defs>
-struct _2d_dense_data {
-private:
-    using value_type = typename _types<T>::value_type;
-    using _data_t    = _choose_based_on_ownership<_ownership, std::unique_ptr<value_type[]>, _observer_ptr<value_type>,
-                                                  _observer_ptr<const value_type>>;
+template <class T>
+class Coroutine {
+    static_assert(!std::is_reference_v<T>, "Coroutines cannot return references.");
 
 public:
-    _data_t _data;
-};
+    using promise_type = CoroutinePromise<T>;
 
-template <utl_mvl_tensor_arg_defs>
-struct _2d_sparse_data {
 private:
-    using value_type = typename _types<T>::value_type;
-    using _triplet_t = _choose_based_on_ownership<_ownership, SparseEntry2D<value_type>,
-                                                  SparseEntry2D<std::reference_wrapper<value_type>>,
-                                                  SparseEntry2D<std::reference_wrapper<const value_type>>>;
+    friend class ThreadPool;
+    friend promise_type;
 
-public:
-    using triplet_type = _triplet_t;
+    std::coroutine_handle<promise_type> handle;
 
-    std::vector<triplet_type> _data;
-};
+    explicit Coroutine(std::coroutine_handle<promise_type> handle) noexcept : handle(handle) {}
 
-// ===================
-// --- Tensor Type ---
-// ===================
+    // Waits for completion without touching the result, can't throw
+    struct CompletionAwaiter {
+        std::coroutine_handle<promise_type> handle;
 
-template <utl_mvl_tensor_arg_defs>
-class GenericTensor
-    // Conditionally compile member variables through inheritance
-    : public std::conditional_t<_dimension == Dimension::MATRIX, _2d_extents<utl_mvl_tensor_arg_vals>, _nothing<1>>,
-      public std::conditional_t<_dimension == Dimension::MATRIX && _type == Type::STRIDED,
-                                _2d_strides<utl_mvl_tensor_arg_vals>, _nothing<2>>,
-      public std::conditional_t<_type == Type::DENSE || _type == Type::STRIDED, _2d_dense_data<utl_mvl_tensor_arg_vals>,
-                                _nothing<3>>,
-      public std::conditional_t<_type == Type::SPARSE, _2d_sparse_data<utl_mvl_tensor_arg_vals>, _nothing<4>>
-// > After this point no non-static member variables will be introduced
-{
-    // --- Parameter reflection ---
-    // ----------------------------
-public:
-    struct params {
-        constexpr static auto dimension = _dimension;
-        constexpr static auto type      = _type;
-        constexpr static auto ownership = _ownership;
-        constexpr static auto checking  = _checking;
-        constexpr static auto layout    = _layout;
+        bool await_ready() const noexcept {
+            const promise_type& promise = this->handle.promise();
+            return promise.started && promise.state.load(std::memory_order_acquire) == promise_type::ready;
+        }
 
-        // Prevent impossible layouts
-        static_assert((dimension == Dimension::VECTOR) == (layout == Layout::FLAT), "Flat layout <=> matrix is 1D.");
-        static_assert((type == Type::SPARSE) == (layout == Layout::SPARSE), "Sparse layout <=> matrix is sparse.");
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+            promise_type&        promise = this->handle.promise();
+            const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(awaiting.address());
+
+            // Not started yet => run it inline on this thread, it will transfer back to us when finished
+            if (!promise.started) {
+                promise.started = true;
+                promise.state.store(address, std::memory_order_relaxed);
+                return this->handle;
+            }
+
+            // Already running somewhere else => register as a continuation, unless it finished in the meantime
+            std::uintptr_t expected = promise_type::pending;
+            if (promise.state.compare_exchange_strong(expected, address, std::memory_order_acq_rel)) {
+                return std::noop_coroutine();
+            }
+
+            return awaiting;
+        }
+
+        void await_resume() const noexcept {}
     };
 
-    constexpr static bool is_tensor = true;
+    struct LvalueAwaiter : CompletionAwaiter {
+        decltype(auto) await_resume() const { return this->handle.promise().result(); }
+    };
 
-    // --- Member types ---
-    // --------------------
-private:
-    using _type_wrapper = _types<T>;
+    struct RvalueAwaiter : CompletionAwaiter {
+        decltype(auto) await_resume() const { return std::move(this->handle.promise()).result(); }
+    };
+
+    [[nodiscard]] CompletionAwaiter completion() const noexcept { return CompletionAwaiter{this->handle}; }
 
 public:
-    using self            = GenericTensor;
-    using value_type      = typename _type_wrapper::value_type;
-    using size_type       = typename _type_wrapper::size_type;
-    using difference_type = typename _type_wrapper::difference_type;
-    using reference       = typename _type_wrapper::reference;
-    using const_reference = typename _type_wrapper::const_reference;
-    using pointer         = typename _type_wrapper::pointer;
-    using const_pointer   = typename _type_wrapper::const_pointer;
+    Coroutine(const Coroutine&)            = delete;
+    Coroutine& operator=(const Coroutine&) = delete;
 
-    using owning_reflection = GenericTensor<value_type, params::dimension, params::type, Ownership::CONTAINER,
-                                            params::checking, params::layout>;
-    // container type corresponding to 'self', this is the return type of algebraic operations on a tensor
+    Coroutine(Coroutine&& other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
 
-    // --- Iterators ---
-    // -----------------
-public:
-    using const_iterator         = _flat_iterator<const self*, _type_wrapper, true>;
-    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    Coroutine& operator=(Coroutine&& other) noexcept {
+        if (this != &other) {
+            this->destroy();
+            this->handle = std::exchange(other.handle, nullptr);
+        }
+        return *this;
+    }
 
-    using iterator = std::conditional_t<_ownership != Ownership::CONST_VIEW, _flat_iterator<self*, _type_wrapper>,
-                                        const_iterator>; // for const views 'iterator' is the same as 'const_iterator'
-    using reverse_iterator = std::reverse_iterator<iterator>;
+    ~Coroutine() { this->destroy(); }
 
-    [[nodiscard]] const_iterator cbegin() const { return const_iterator(this, 0); }
-    [[nodiscard]] const_iterator cend() const { return const_iterator(this, this->size()); }
-    [[nodiscard]] const_iterator begin() const { return this->cbegin(); }
-    [[nodiscard]] const_iterator end() const { return this->cend(); }
+    LvalueAwaiter operator co_await() & noexcept { return LvalueAwaiter{{this->handle}}; }
+    RvalueAwaiter operator co_await() && noexcept { return RvalueAwaiter{{this->handle}}; }
 
-    [[nodiscard]] const_reverse_iterator crbegin() const { return const_reverse_iterator(this->cend()); }
-    [[nodiscard]] const_reverse_iterator crend() const { return const_reverse_iterator(this->cbegin()); }
-    [[nodiscard]] const_reverse_iterator rbegin() const { return this->crbegin(); }
-    [[nodiscard]] const_reverse_iterator rend() const { return this->crend(); }
+    [[nodiscard]] bool valid() const noexcept { return static_cast<bool>(this->handle); }
 
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW)
-    [[nodiscard]] iterator begin() { return iterator(this, 0); }
+    [[nodiscard]] bool is_ready() const noexcept { return this->completion().await_ready(); }
 
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW)
-    [[nodiscard]] iterator end() { return iterator(this, this->size()); }
+    // Blocking API for regular code, coroutine that wasn't started yet runs inline on the calling thread
+    void wait() const {
+        if (!this->is_ready()) SyncWaiter::wait(this->completion());
+    }
 
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW)
-    [[nodiscard]] reverse_iterator rbegin() { return reverse_iterator(this->end()); }
+    T get() {
+        this->wait();
+        return std::move(this->handle.promise()).result();
+    }
 
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW)
-    [[nodiscard]] reverse_iterator rend() { return reverse_iterator(this->begin()); }
+private:
+    void destroy() noexcept {
+        if (!this->handle) return;
 
-    // --- Basic getters ---
-    // ---------------------
-public:
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-    [[nodiscard]] size_type size() const noexcept { return this->rows() * this->cols(); }
+        // Coroutine that is still running somewhere can't be destroyed under its own feet
+        if (this->handle.promise().started) this->wait();
 
-    utl_mvl_reqs(type == Type::SPARSE)
-    [[nodiscard]] size_type size() const noexcept { return this->_data.size(); }
+        this->handle.destroy();
+        this->handle = nullptr;
+    }
+};
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX)
-    [[nodiscard]] size_type rows() const noexcept { return this->_rows; }
+template <class T>
+Coroutine<T> CoroutinePromise<T>::get_return_object() noexcept {
+    return Coroutine<T>{std::coroutine_handle<CoroutinePromise<T>>::from_promise(*this)};
+}
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX)
-    [[nodiscard]] size_type cols() const noexcept { return this->_cols; }
+inline Coroutine<void> CoroutinePromise<void>::get_return_object() noexcept {
+    return Coroutine<void>{std::coroutine_handle<CoroutinePromise<void>>::from_promise(*this)};
+}
+
+template <class T>
+using non_void_t = std::conditional_t<std::is_void_v<T>, std::monostate, T>;
+
+#endif
+
+// ===================
+// --- Thread pool ---
+// ===================
+
+class ThreadPool;
+class TaskGroup;
+
+template <class T>
+class PerWorker;
+
+namespace ws_this_thread { // same this as thread introspection from public API, but more convenient for internal use
+inline thread_local ThreadPool* thread_pool_ptr = nullptr;
+inline thread_local std::size_t worker_index    = std::size_t(-1);
+}; // namespace ws_this_thread
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE)
-    [[nodiscard]] constexpr size_type row_stride() const noexcept {
-        if constexpr (self::params::layout == Layout::RC) return 0;
-        if constexpr (self::params::layout == Layout::CR) return 1;
-        utl_mvl_unreachable;
-    }
+inline std::size_t splitmix64() noexcept {
+    thread_local std::uint64_t state = ws_this_thread::worker_index;
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE)
-    [[nodiscard]] constexpr size_type col_stride() const noexcept {
-        if constexpr (self::params::layout == Layout::RC) return 1;
-        if constexpr (self::params::layout == Layout::CR) return 0;
-        utl_mvl_unreachable;
-    }
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED)
-    [[nodiscard]] size_type row_stride() const noexcept { return this->_row_stride; }
+    std::uint64_t result = (state += 0x9E3779B97f4A7C15);
+    result               = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9;
+    result               = (result ^ (result >> 27)) * 0x94D049BB133111EB;
+    return static_cast<std::size_t>(result ^ (result >> 31));
+} // very fast & simple PRNG
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED)
-    [[nodiscard]] size_type col_stride() const noexcept { return this->_col_stride; }
+// Priority classes of the global queue. High priority tasks are taken before any other work (including
+// the local deques), normal & low ones are taken after the local & stolen work. Each non-empty tier can
+// be skipped in favor of a higher one at most 'starvation_limit' times in a row, after that it gets its turn.
+enum class Priority { high, normal, low };
 
-    utl_mvl_reqs(type == Type::DENSE || type == Type::STRIDED)
-    [[nodiscard]] const_pointer data() const noexcept { return this->_data.get(); }
+constexpr std::size_t priority_count   = 3;
+constexpr std::size_t starvation_limit = 16;
 
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && (type == Type::DENSE || type == Type::STRIDED))
-    [[nodiscard]] pointer data() noexcept { return this->_data.get(); }
+class ThreadPool {
+    friend class TaskGroup; // waiting groups execute tasks from the local deques
 
-    [[nodiscard]] bool empty() const noexcept { return (this->size() == 0); }
+    template <class T>
+    friend class PerWorker; // per-worker storage follows the thread count of the pool
 
-    // --- Advanced getters ---
-    // ------------------------
-    utl_mvl_reqs(_has_binary_op_equal<value_type>::value)
-    [[nodiscard]] bool contains(const_reference value) const {
-        return std::find(this->cbegin(), this->cend(), value) != this->cend();
-    }
+    using task_type         = Task;
+    using global_queue_type = RingQueue<task_type>;
+    using local_queue_type  = WorkStealingDeque<TaskNode>;
 
-    utl_mvl_reqs(_has_binary_op_equal<value_type>::value)
-    [[nodiscard]] size_type count(const_reference value) const {
-        return std::count(this->cbegin(), this->cend(), value);
-    }
+    std::vector<std::thread> workers;
+    std::mutex               workers_mutex;
 
-    utl_mvl_reqs(_has_binary_op_less<value_type>::value)
-    [[nodiscard]] bool is_sorted() const { return std::is_sorted(this->cbegin(), this->cend()); }
+    std::array<global_queue_type, priority_count> global_queues; // one FIFO per priority tier
+    std::array<std::size_t, priority_count>       skip_counts{};  // guarded by the same mutex as the queues
+    std::mutex                                    global_queue_mutex;
 
-    template <class Compare>
-    [[nodiscard]] bool is_sorted(Compare cmp) const {
-        return std::is_sorted(this->cbegin(), this->cend(), cmp);
-    }
+    std::vector<local_queue_type> local_queues; // lock-free, not resized during worker lifetime
+    std::vector<TaskNodeCache>    node_caches;  // one per worker, recycles nodes of the local queues
 
-    [[nodiscard]] std::vector<value_type> to_std_vector() const { return std::vector(this->cbegin(), this->cend()); }
+    Placement                placement;
+    std::vector<std::size_t> worker_nodes; // NUMA node of each worker, all zeroes unless workers are pinned
+    bool                     multiple_nodes = false;
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE)
-    self transposed() const {
-        self res(this->cols(), this->rows());
-        this->for_each([&](const value_type& element, size_type i, size_type j) { res(j, i) = element; });
-        return res;
-    }
+    alignas(cache_line_size) std::atomic<std::size_t> tasks_unfinished{0}; // pending + running
+    alignas(cache_line_size) std::atomic<std::size_t> global_queue_size{0};
+    alignas(cache_line_size) std::atomic<std::size_t> high_priority_size{0};
+    // allows workers to skip locking the global queue when it's empty
 
-    utl_mvl_reqs(ownership == Ownership::CONTAINER)
-    [[nodiscard]] self clone() const { return *this; }
+    std::atomic<bool> terminating{true};
 
-    utl_mvl_reqs(ownership == Ownership::CONTAINER)
-    [[nodiscard]] self move() & { return std::move(*this); }
+    EventCount task_available; // idle workers park here
+    EventCount tasks_done;     // 'wait()' parks here
 
-    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout>
-    [[nodiscard]] bool
-    compare_contents(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
-                                         other_checking, other_layout>& other) const {
-        // Surface-level checks
-        if ((this->rows() != other.rows()) || (this->cols() != other.cols())) return false;
-        // Compare while respecting sparsity
-        constexpr bool is_sparse_l = (self::params::type == Type::SPARSE);
-        constexpr bool is_sparse_r = (std::remove_reference_t<decltype(other)>::params::type == Type::SPARSE);
-        // Same sparsity comparison
-        if constexpr (is_sparse_l == is_sparse_r) {
-            return this->size() == other.size() &&
-                   this->true_for_all([&](const_reference e, size_type i, size_type j) { return e == other(i, j); });
-        }
-        // Different sparsity comparison
-        // TODO: Impl here and use .all_of() OR .any_of()
-        else
-            return true;
-    }
+    std::vector<Padded<WorkerCounters>> counters; // one per worker, stays empty unless stats are enabled
+    std::atomic<std::size_t>            max_global_queue_depth{0};
 
-    // --- Indexation ---
-    // ------------------
-public:
-    // Vector API
-    [[nodiscard]] const_reference front() const { return this->operator[](0); }
-    [[nodiscard]] const_reference back() const { return this->operator[](this->size() - 1); }
-    [[nodiscard]] reference       front() { return this->operator[](0); }
-    [[nodiscard]] reference       back() { return this->operator[](this->size() - 1); }
+    std::map<std::size_t, std::function<void(std::size_t)>> resize_observers; // invoked with the new thread count
+    std::size_t                                             next_observer_id      = 0;
+    std::size_t                                             observed_thread_count = 0;
+    std::mutex                                              resize_observers_mutex;
 
 private:
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED)
-    [[nodiscard]] size_type _get_memory_offset_strided_impl(size_type idx, size_type i, size_type j) const {
-        if constexpr (self::params::layout == Layout::RC) return idx * this->col_stride() + this->row_stride() * i;
-        if constexpr (self::params::layout == Layout::CR) return idx * this->row_stride() + this->col_stride() * j;
-        utl_mvl_unreachable;
-    }
+    // Observers get notified while there are no workers, which lets them resize per-worker state without locking
+    std::size_t add_resize_observer(std::function<void(std::size_t)> observer) {
+        const std::scoped_lock observers_lock(this->resize_observers_mutex);
 
-public:
-    utl_mvl_reqs(type == Type::DENSE)
-    [[nodiscard]] size_type get_memory_offset_of_idx(size_type idx) const {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
-        return idx;
+        observer(this->observed_thread_count);
+        this->resize_observers.emplace(this->next_observer_id, std::move(observer));
+        return this->next_observer_id++;
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE)
-    [[nodiscard]] size_type get_memory_offset_of_ij(size_type i, size_type j) const {
-        return this->get_idx_of_ij(i, j);
+    void remove_resize_observer(std::size_t id) {
+        const std::scoped_lock observers_lock(this->resize_observers_mutex);
+        this->resize_observers.erase(id);
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED)
-    [[nodiscard]] size_type get_memory_offset_of_idx(size_type idx) const {
-        const auto ij = this->get_ij_of_idx(idx);
-        return _get_memory_offset_strided_impl(idx, ij.i, ij.j);
-    }
+    void notify_resize_observers(std::size_t count) {
+        const std::scoped_lock observers_lock(this->resize_observers_mutex);
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED)
-    [[nodiscard]] size_type get_memory_offset_of_ij(size_type i, size_type j) const {
-        const auto idx = this->get_idx_of_ij(i, j);
-        return _get_memory_offset_strided_impl(idx, i, j);
+        this->observed_thread_count = count;
+        for (auto& [id, observer] : this->resize_observers) observer(count);
     }
 
-public:
-    // - Flat indexation -
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::MATRIX &&
-                 (type == Type::DENSE || type == Type::STRIDED))
-    [[nodiscard]] reference operator[](size_type idx) { return this->data()[this->get_memory_offset_of_idx(idx)]; }
+    void spawn_workers(std::size_t count) {
+        this->notify_resize_observers(count);
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-    [[nodiscard]] const_reference operator[](size_type idx) const {
-        return this->data()[this->get_memory_offset_of_idx(idx)];
-    }
+        this->workers      = std::vector<std::thread>(count);
+        this->local_queues = std::vector<local_queue_type>(count);
+        this->node_caches  = std::vector<TaskNodeCache>(count);
+        this->terminating.store(false, std::memory_order_seq_cst);
 
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::VECTOR || type == Type::SPARSE)
-    [[nodiscard]] reference operator[](size_type idx) {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
-        return this->_data[idx].value;
-    }
+        if constexpr (stats_enabled) {
+            this->counters = std::vector<Padded<WorkerCounters>>(count);
+            this->max_global_queue_depth.store(0, std::memory_order_relaxed);
+        }
 
-    utl_mvl_reqs(dimension == Dimension::VECTOR || type == Type::SPARSE)
-    [[nodiscard]] const_reference operator[](size_type idx) const {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
-        return this->_data[idx].value;
-    }
+        const bool                 pinned = (this->placement.policy != Placement::Policy::none);
+        const std::vector<CpuInfo> cpus   = pinned ? assign_cpus(this->placement, count, get_cpu_topology())
+                                                   : std::vector<CpuInfo>{}; // don't touch sysfs unless needed
 
-    // - 2D indexation -
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::MATRIX &&
-                 (type == Type::DENSE || type == Type::STRIDED))
-    [[nodiscard]] reference operator()(size_type i, size_type j) {
-        return this->data()[this->get_memory_offset_of_ij(i, j)];
-    }
+        this->worker_nodes = std::vector<std::size_t>(count, 0);
+        for (std::size_t i = 0; i < cpus.size(); ++i) this->worker_nodes[i] = cpus[i].node;
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-    [[nodiscard]] const_reference operator()(size_type i, size_type j) const {
-        return this->data()[this->get_memory_offset_of_ij(i, j)];
-    }
+        this->multiple_nodes = false;
+        for (std::size_t node : this->worker_nodes) this->multiple_nodes |= (node != this->worker_nodes.front());
 
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && dimension == Dimension::MATRIX && type == Type::SPARSE)
-    [[nodiscard]] reference operator()(size_type i, size_type j) {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(i, j);
-        return this->_data[this->get_idx_of_ij(i, j)].value;
-    }
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
-    [[nodiscard]] const_reference operator()(size_type i, size_type j) const {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(i, j);
-        return this->_data[this->get_idx_of_ij(i, j)].value;
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::optional<std::size_t> cpu = cpus.empty() ? std::nullopt : std::optional{cpus[i].cpu};
+
+            this->workers[i] = std::thread([this, i, cpu] {
+                if (cpu) pin_this_thread(*cpu);
+                this->worker_main(i);
+            });
+        }
     }
 
-    // --- Index conversions ---
-    // -------------------------
+    void terminate_workers() {
+        this->terminating.store(true, std::memory_order_seq_cst);
+        this->task_available.notify_all();
 
-    // - Bound checking -
-private:
-    void _bound_check_idx(size_type idx) const {
-        if (idx >= this->size())
-            throw std::out_of_range(
-                stringify("idx (which is ", idx, ") >= this->size() (which is ", this->size(), ")"));
-    }
+        for (std::size_t i = 0; i < this->workers.size(); ++i)
+            if (this->workers[i].joinable()) this->workers[i].join();
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX)
-    void _bound_check_ij(size_type i, size_type j) const {
-        if (i >= this->rows())
-            throw std::out_of_range(stringify("i (which is ", i, ") >= this->rows() (which is ", this->rows(), ")"));
-        else if (j >= this->cols())
-            throw std::out_of_range(stringify("j (which is ", j, ") >= this->cols() (which is ", this->cols(), ")"));
+        for (auto& local_queue : this->local_queues)
+            while (TaskNode* node = local_queue.pop()) delete node; // deque doesn't own its pointers
     }
 
-    // - Dense & strided implementations -
-private:
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-    [[nodiscard]] size_type _unchecked_get_idx_of_ij(size_type i, size_type j) const {
-        if constexpr (self::params::layout == Layout::RC) return i * this->cols() + j;
-        if constexpr (self::params::layout == Layout::CR) return j * this->rows() + i;
-        utl_mvl_unreachable;
-    }
+    void worker_main(std::size_t worker_index) {
+        this_thread::thread_pool_ptr    = this;
+        this_thread::worker_index       = worker_index;
+        ws_this_thread::thread_pool_ptr = this;
+        ws_this_thread::worker_index    = worker_index;
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-    [[nodiscard]] Index2D _unchecked_get_ij_of_idx(size_type idx) const {
-        if constexpr (self::params::layout == Layout::RC) return {idx / this->cols(), idx % this->cols()};
-        if constexpr (self::params::layout == Layout::CR) return {idx % this->rows(), idx / this->rows()};
-        utl_mvl_unreachable;
-    }
+        task_type task;
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONTAINER)
-    [[nodiscard]] size_type _total_allocated_size() const noexcept {
-        // Note 1: Allocated size of the strided matrix is NOT equal to .size() (which is same as rows * cols)
-        // This is due to all the padding between the actual elements
-        // Note 2: The question of whether .size() should return the number of 'strided' elements or the number
-        // of actually allocated elements is rather perplexing, while the second option is more "correct" its
-        // usefulness is dubious at bets, while the first one does in fact allow convenient 1D iteration over
-        // all the elements. Option 1 also provides an API consistent with strided views, which is why it ended
-        // up being the one chosen
-        //
-        // This method returns a true allocated size
-        if constexpr (self::params::layout == Layout::RC)
-            return (this->rows() - 1) * this->row_stride() + this->rows() * this->cols() * this->col_stride();
-        if constexpr (self::params::layout == Layout::CR)
-            return (this->cols() - 1) * this->col_stride() + this->rows() * this->cols() * this->row_stride();
-        utl_mvl_unreachable;
-    }
+        while (true) {
+            // Fast path, no synchronization beyond the queues themselves
+            if (this->try_acquire_task(task)) {
+                this->execute(task);
+                continue;
+            }
 
-public:
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-    [[nodiscard]] size_type get_idx_of_ij(size_type i, size_type j) const {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_ij(i, j);
-        return _unchecked_get_idx_of_ij(i, j);
-    }
+            // Slow path, register as a sleeper, re-check everything and park if there is still nothing to do
+            const EventCount::key_type key = this->task_available.prepare_wait();
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-    [[nodiscard]] Index2D get_ij_of_idx(size_type idx) const {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
-        return _unchecked_get_ij_of_idx(idx);
+            if (this->terminating.load(std::memory_order_seq_cst)) {
+                this->task_available.cancel_wait();
+                break;
+            }
+
+            if (this->try_acquire_task(task)) {
+                this->task_available.cancel_wait();
+                this->execute(task);
+                continue;
+            }
+
+            if constexpr (stats_enabled) {
+                const auto idle_start = stats_clock::now();
+                this->task_available.commit_wait(key);
+                WorkerCounters::add(this->local_counters().idle_ns, static_cast<std::size_t>(elapsed_ns(idle_start)));
+            } else {
+                this->task_available.commit_wait(key);
+            }
+        }
+
+        this_thread::thread_pool_ptr    = std::nullopt;
+        this_thread::worker_index       = std::nullopt;
+        ws_this_thread::thread_pool_ptr = nullptr;
+        ws_this_thread::worker_index    = std::size_t(-1);
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-    [[nodiscard]] size_type extent_major() const noexcept {
-        if constexpr (self::params::layout == Layout::RC) return this->rows();
-        if constexpr (self::params::layout == Layout::CR) return this->cols();
-        utl_mvl_unreachable;
+    bool try_acquire_task(task_type& task) {
+        return this->try_pop_urgent(task) || this->try_pop_local(task) || this->try_steal(task) ||
+               this->try_pop_global(task);
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && (type == Type::DENSE || type == Type::STRIDED))
-    [[nodiscard]] size_type extent_minor() const noexcept {
-        if constexpr (self::params::layout == Layout::RC) return this->cols();
-        if constexpr (self::params::layout == Layout::CR) return this->rows();
-        utl_mvl_unreachable;
+    [[nodiscard]] WorkerCounters& local_counters() noexcept {
+        return this->counters[ws_this_thread::worker_index].value;
     }
 
-    // - Sparse implementations -
-private:
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
-    [[nodiscard]] size_type _search_ij(size_type i, size_type j) const noexcept {
-        // Returns this->size() if {i, j} wasn't found.
-        // Linear search for small .size() (more efficient fue to prediction and cache locality)
-        if (true) {
-            for (size_type idx = 0; idx < this->size(); ++idx)
-                if (this->_data[idx].i == i && this->_data[idx].j == j) return idx;
-            return this->size();
+    // With stats enabled tasks carry their submission time, this makes closures 16 bytes larger
+    template <class F>
+    task_type make_task(F&& f) {
+        if constexpr (stats_enabled) {
+            return [this, f = std::forward<F>(f), submitted = stats_clock::now()]() mutable {
+                WorkerCounters::add(this->local_counters().latency_histogram[latency_bucket(elapsed_ns(submitted))], 1);
+                f();
+            };
+        } else {
+            return task_type(std::forward<F>(f));
+        }
+    }
+
+    void record_global_queue_depth(std::size_t depth) noexcept { // called under the global queue lock
+        if constexpr (stats_enabled)
+            if (this->max_global_queue_depth.load(std::memory_order_relaxed) < depth)
+                this->max_global_queue_depth.store(depth, std::memory_order_relaxed);
+    }
+
+    void execute(task_type& task) {
+        if constexpr (stats_enabled) WorkerCounters::add(this->local_counters().executed_tasks, 1);
+
+        task();
+        task = nullptr; // captured state should die with the task, not linger until the next one
+
+        if (this->tasks_unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) this->tasks_done.notify_all();
+    }
+
+    void push_local(task_type&& task) {
+        const std::size_t index = ws_this_thread::worker_index;
+
+        TaskNode* node = this->node_caches[index].acquire(index);
+        node->task     = std::move(task);
+
+        try {
+            this->local_queues[index].push(node);
+        } catch (...) {
+            node->task = nullptr;
+            this->node_caches[index].release_local(node);
+            throw;
         }
-        // TODO: Binary search for larger .size() (N(log2(size)) instead of N(size) asymptotically)
+
+        if constexpr (stats_enabled)
+            WorkerCounters::raise(this->local_counters().max_local_queue_depth, this->local_queues[index].size());
     }
 
-public:
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
-    [[nodiscard]] size_type get_idx_of_ij(size_type i, size_type j) const {
-        const size_type idx = this->_search_ij(i, j);
-        // Return this->size() if {i, j} wasn't found. Throw with bound checking.
-        if constexpr (self::params::checking == Checking::BOUNDS)
-            if (idx == this->size())
-                throw std::out_of_range(stringify("Index { ", i, ", ", j, "} in not a part of sparse matrix"));
-        return idx;
+    void take_from_node(TaskNode* node, task_type& task) noexcept {
+        task = std::move(node->task);
+
+        if (node->owner == ws_this_thread::worker_index) this->node_caches[node->owner].release_local(node);
+        else this->node_caches[node->owner].release_remote(node);
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
-    [[nodiscard]] Index2D get_ij_of_idx(size_type idx) const {
-        if constexpr (self::params::checking == Checking::BOUNDS) this->_bound_check_idx(idx);
-        return Index2D{this->_data[idx].i, this->_data[idx].j};
+    bool try_pop_local(task_type& task) {
+        TaskNode* node = this->local_queues[ws_this_thread::worker_index].pop();
+
+        if (!node) return false;
+
+        if constexpr (stats_enabled) WorkerCounters::add(this->local_counters().local_pops, 1);
+
+        this->take_from_node(node, task);
+        return true;
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
-    [[nodiscard]] bool contains_index(size_type i, size_type j) const noexcept {
-        return this->_search_ij(i, j) != this->size();
+    bool try_steal(task_type& task) {
+        const bool stolen = this->try_steal_any(task);
+
+        if constexpr (stats_enabled) {
+            if (stolen) WorkerCounters::add(this->local_counters().steals, 1);
+            else WorkerCounters::add(this->local_counters().failed_steals, 1);
+        }
+
+        return stolen;
     }
 
-    // --- Reductions ---
-    // ------------------
-    utl_mvl_reqs(_has_binary_op_plus<value_type>::value)
-    [[nodiscard]] value_type sum() const { return std::accumulate(this->cbegin(), this->cend(), value_type()); }
+    bool try_steal_any(task_type& task) {
+        if (!this->multiple_nodes) return this->try_steal_if(task, [](std::size_t) { return true; });
 
-    utl_mvl_reqs(_has_binary_op_multiplies<value_type>::value)
-    [[nodiscard]] value_type product() const {
-        return std::accumulate(this->cbegin(), this->cend(), value_type(), std::multiplies<value_type>());
+        // Victims on the same NUMA node go first, stealing across nodes is more expensive since all
+        // the data touched by the task will likely have to travel through the interconnect
+        const std::size_t node = this->worker_nodes[ws_this_thread::worker_index];
+
+        return this->try_steal_if(task, [&](std::size_t i) { return this->worker_nodes[i] == node; }) ||
+               this->try_steal_if(task, [&](std::size_t i) { return this->worker_nodes[i] != node; });
     }
 
-    utl_mvl_reqs(_has_binary_op_less<value_type>::value)
-    [[nodiscard]] value_type min() const { return *std::min_element(this->cbegin(), this->cend()); }
+    template <class Pred>
+    bool try_steal_if(task_type& task, Pred&& is_victim) {
+        const std::size_t count = this->local_queues.size();
+        const std::size_t start = count ? splitmix64() % count : 0;
 
-    utl_mvl_reqs(_has_binary_op_less<value_type>::value)
-    [[nodiscard]] value_type max() const { return *std::max_element(this->cbegin(), this->cend()); }
+        // Unlike regular random stealing this is guaranteed to check every deque, which is
+        // necessary for a correct re-check before parking the thread, see 'worker_main()'
+        for (std::size_t k = 0; k < count; ++k) {
+            const std::size_t i = (start + k) % count;
+
+            if (i == ws_this_thread::worker_index) continue; // don't steal from yourself
+            if (!is_victim(i)) continue;
+
+            TaskNode* node = this->local_queues[i].steal();
+
+            if (!node) continue;
+
+            this->take_from_node(node, task);
+            return true;
+        }
 
-    // --- Predicate operations ---
-    // ----------------------------
-    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference)> = true>
-    [[nodiscard]] bool true_for_any(PredType predicate) const {
-        for (size_type idx = 0; idx < this->size(); ++idx)
-            if (predicate(this->operator[](idx), idx)) return true;
         return false;
     }
 
-    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type)> = true>
-    [[nodiscard]] bool true_for_any(PredType predicate) const {
-        for (size_type idx = 0; idx < this->size(); ++idx)
-            if (predicate(this->operator[](idx), idx)) return true;
-        return false;
+    bool try_pop_urgent(task_type& task) {
+        if (!this->high_priority_size.load(std::memory_order_seq_cst)) return false;
+        return this->try_pop_global(task); // high priority work doesn't wait behind the local deques
     }
 
-    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX)>
-    [[nodiscard]] bool true_for_any(PredType predicate) const {
-        // Loop over all 2D indices using 1D loop with idx->ij conversion
-        // This is just as fast and ensures looping only over existing elements in non-dense matrices
-        for (size_type idx = 0; idx < this->size(); ++idx) {
-            const auto ij = this->get_ij_of_idx(idx);
-            if (predicate(this->operator[](idx), ij.i, ij.j)) return true;
+    bool try_pop_global(task_type& task) {
+        if (!this->global_queue_size.load(std::memory_order_seq_cst)) return false;
+
+        const std::scoped_lock global_queue_lock(this->global_queue_mutex);
+
+        // Highest non-empty tier goes first, unless some lower tier was skipped too many times already
+        std::size_t selected = priority_count;
+
+        for (std::size_t tier = 0; tier < priority_count; ++tier) {
+            if (this->global_queues[tier].empty()) continue;
+            if (selected == priority_count) selected = tier;
+            if (this->skip_counts[tier] >= starvation_limit) {
+                selected = tier;
+                break;
+            }
         }
-        return false;
+
+        if (selected == priority_count) return false;
+
+        for (std::size_t tier = selected + 1; tier < priority_count; ++tier)
+            if (!this->global_queues[tier].empty()) ++this->skip_counts[tier];
+        this->skip_counts[selected] = 0;
+
+        this->global_queues[selected].pop(task);
+        this->global_queue_size.fetch_sub(1, std::memory_order_seq_cst);
+        if constexpr (stats_enabled) WorkerCounters::add(this->local_counters().global_pops, 1);
+        if (selected == tier_index(Priority::high)) this->high_priority_size.fetch_sub(1, std::memory_order_seq_cst);
+        return true;
     }
 
-    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference)> = true>
-    [[nodiscard]] bool true_for_all(PredType predicate) const {
-        auto inverse_predicate = [&](const_reference e) -> bool { return !predicate(e); };
-        return !this->true_for_any(inverse_predicate);
+    [[nodiscard]] static constexpr std::size_t tier_index(Priority priority) noexcept {
+        return static_cast<std::size_t>(priority);
     }
 
-    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type)> = true>
-    [[nodiscard]] bool true_for_all(PredType predicate) const {
-        auto inverse_predicate = [&](const_reference e, size_type idx) -> bool { return !predicate(e, idx); };
-        return !this->true_for_any(inverse_predicate);
+    void push_global(task_type&& task, Priority priority) {
+        const std::scoped_lock global_queue_lock(this->global_queue_mutex);
+
+        this->global_queues[tier_index(priority)].push(std::move(task));
+        this->global_queue_size.fetch_add(1, std::memory_order_seq_cst);
+        this->record_global_queue_depth(this->global_queues[tier_index(priority)].size());
+        if (priority == Priority::high) this->high_priority_size.fetch_add(1, std::memory_order_seq_cst);
     }
 
-    template <class PredType, _has_signature_enable_if<PredType, bool(const_reference, size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX)>
-    [[nodiscard]] bool true_for_all(PredType predicate) const {
-        // We can reuse .true_for_any() with inverted predicate due to following conjecture:
-        // FOR_ALL (predicate)  ~  ! FOR_ANY (!predicate)
-        auto inverse_predicate = [&](const_reference e, size_type i, size_type j) -> bool {
-            return !predicate(e, i, j);
-        };
-        return !this->true_for_any(inverse_predicate);
+    // Pushes 'wrap(*it)' for every element of '[first, last)' as a single batch, 'pushed' counts successful pushes
+    // so the caller can roll back its own accounting when some allocation throws halfway through the batch
+    template <class It, class Wrap>
+    void push_bulk(It first, It last, Wrap&& wrap, std::size_t& pushed) {
+        const std::size_t count = static_cast<std::size_t>(std::distance(first, last));
+
+        if (!count) return;
+
+        this->tasks_unfinished.fetch_add(count, std::memory_order_seq_cst); // same reasoning as 'detached_task()'
+
+        try {
+            // Recursive tasks, local deque is lock-free, the gain comes from notifying workers just once
+            if (ws_this_thread::thread_pool_ptr == this) {
+                for (; first != last; ++first, ++pushed) this->push_local(this->make_task(wrap(*first)));
+            }
+            // Regular tasks, the whole batch goes in under a single lock
+            else {
+                const std::scoped_lock global_queue_lock(this->global_queue_mutex);
+
+                try {
+                    for (; first != last; ++first, ++pushed)
+                        this->global_queues[tier_index(Priority::normal)].push(this->make_task(wrap(*first)));
+                } catch (...) {
+                    this->global_queue_size.fetch_add(pushed, std::memory_order_seq_cst);
+                    throw;
+                }
+
+                this->global_queue_size.fetch_add(pushed, std::memory_order_seq_cst);
+                this->record_global_queue_depth(this->global_queues[tier_index(Priority::normal)].size());
+            }
+        } catch (...) {
+            const std::size_t not_pushed = count - pushed;
+            if (this->tasks_unfinished.fetch_sub(not_pushed, std::memory_order_acq_rel) == not_pushed)
+                this->tasks_done.notify_all();
+            this->task_available.notify(pushed);
+            throw;
+        }
+
+        this->task_available.notify(count);
     }
 
-    // --- Const algorithms ---
-    // ------------------------
-    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference)> = true>
-    const self& for_each(FuncType func) const {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx));
-        return *this;
+public:
+    explicit ThreadPool(std::size_t count = std::thread::hardware_concurrency(), Placement placement = {})
+        : placement(std::move(placement)) {
+        this->spawn_workers(count);
     }
 
-    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type)> = true>
-    const self& for_each(FuncType func) const {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx), idx);
-        return *this;
+    ~ThreadPool() noexcept {
+        try {
+            this->wait();
+            this->terminate_workers();
+        } catch (...) {} // no throwing from the destructor
     }
 
-    template <class FuncType, _has_signature_enable_if<FuncType, void(const_reference, size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX)>
-    const self& for_each(FuncType func) const {
-        // Loop over all 2D indices using 1D loop with idx->ij conversion.
-        // This is just as fast and ensures looping only over existing elements in non-dense matrices.
-        for (size_type idx = 0; idx < this->size(); ++idx) {
-            const auto ij = this->get_ij_of_idx(idx);
-            func(this->operator[](idx), ij.i, ij.j);
+    template <class T = void>
+    struct future_type {
+        std::future<T> future;
+
+        void fallthrough() const {
+            ThreadPool* pool = ws_this_thread::thread_pool_ptr;
+
+            if (!pool) return;
+
+            // Execute recursive tasks from local queues until this future is ready
+            task_type task;
+            while (pool->try_pop_local(task) || pool->try_steal(task)) {
+                pool->execute(task);
+
+                if (this->is_ready()) return;
+            }
         }
-        return *this;
+
+        bool is_ready() const { return this->future.wait_for(std::chrono::seconds{0}) == std::future_status::ready; }
+
+    public:
+        future_type(std::future<T>&& future) : future(std::move(future)) {} // conversion from regular future
+        future_type& operator=(std::future<T>&& future) {
+            this->future = std::move(future);
+            return *this;
+        }
+
+        using is_recursive = void;
+
+        auto get() {
+            this->fallthrough();
+            return this->future.get();
+        }
+
+        bool valid() const noexcept { return this->future.valid(); }
+
+        void wait() const {
+            this->fallthrough();
+            this->future.wait();
+        }
+
+        template <class Rep, class Period>
+        std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout_duration) const {
+            this->fallthrough();
+            return this->future.wait_for(timeout_duration);
+        }
+
+        template <class Clock, class Duration>
+        std::future_status wait_until(const std::chrono::time_point<Clock, Duration>& timeout_time) const {
+            this->fallthrough();
+            return this->future.wait_until(timeout_time);
+        }
+    };
+
+    void set_thread_count(std::size_t count) {
+        if (ws_this_thread::thread_pool_ptr == this)
+            throw std::runtime_error("Cannot resize thread pool from its own pool thread.");
+
+        const std::scoped_lock workers_lock(this->workers_mutex);
+
+        this->wait();
+        this->terminate_workers();
+        this->spawn_workers(count);
     }
 
-    // --- Mutating algorithms ---
-    // ---------------------------
-    template <class FuncType, _has_signature_enable_if<FuncType, void(reference)> = true,
-              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
-    self& for_each(FuncType func) {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx));
-        return *this;
+    void set_thread_count(std::size_t count, Placement placement) {
+        if (ws_this_thread::thread_pool_ptr == this)
+            throw std::runtime_error("Cannot resize thread pool from its own pool thread.");
+
+        const std::scoped_lock workers_lock(this->workers_mutex);
+
+        this->wait();
+        this->terminate_workers();
+        this->placement = std::move(placement);
+        this->spawn_workers(count);
     }
 
-    template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type)> = true,
-              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
-    self& for_each(FuncType func) {
-        for (size_type idx = 0; idx < this->size(); ++idx) func(this->operator[](idx), idx);
-        return *this;
+    [[nodiscard]] std::size_t get_thread_count() {
+        if (ws_this_thread::thread_pool_ptr == this) return this->workers.size();
+        // calls from inside the pool shouldn't lock, otherwise we could deadlock the thread by trying to
+        // query the thread count while the pool was instructed to resize, worker count is constant during
+        // a worker lifetime so it's safe to query without a lock anyways
+
+        const std::scoped_lock workers_lock(this->workers_mutex);
+
+        return this->workers.size();
     }
 
-    template <class FuncType, _has_signature_enable_if<FuncType, void(reference, size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX)>
-    self& for_each(FuncType func) {
-        for (size_type idx = 0; idx < this->size(); ++idx) {
-            const auto ij = this->get_ij_of_idx(idx);
-            func(this->operator[](idx), ij.i, ij.j);
+    void wait() {
+        while (this->tasks_unfinished.load(std::memory_order_acquire)) {
+            const EventCount::key_type key = this->tasks_done.prepare_wait();
+
+            if (!this->tasks_unfinished.load(std::memory_order_seq_cst)) {
+                this->tasks_done.cancel_wait();
+                return;
+            }
+
+            this->tasks_done.commit_wait(key);
         }
-        return *this;
     }
 
-    template <class FuncType, _has_signature_enable_if<FuncType, value_type(const_reference)> = true,
-              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
-    self& transform(FuncType func) {
-        const auto func_wrapper = [&](reference elem) { elem = func(elem); };
-        return this->for_each(func_wrapper);
+#ifdef utl_parallel_has_coroutines
+    // Awaiting it moves the coroutine onto one of the pool threads
+    [[nodiscard]] auto schedule() noexcept {
+        struct ScheduleAwaiter {
+            ThreadPool* pool;
+
+            bool await_ready() const noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> handle) {
+                this->pool->detached_task([handle] { handle.resume(); });
+            }
+            void await_resume() const noexcept {}
+        };
+
+        return ScheduleAwaiter{this};
     }
 
-    template <class FuncType, _has_signature_enable_if<FuncType, value_type(const_reference, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::VECTOR && ownership != Ownership::CONST_VIEW)>
-    self& transform(FuncType func) {
-        const auto func_wrapper = [&](reference elem, size_type i) { elem = func(elem, i); };
-        return this->for_each(func_wrapper);
+    // Starts the coroutine on one of the pool threads, result can be awaited or waited on with '.get()' / '.wait()'
+    template <class T>
+    Coroutine<T> spawn(Coroutine<T> coroutine) {
+        if (!coroutine.handle || coroutine.handle.promise().started) return coroutine; // already running
+
+        const auto handle        = coroutine.handle;
+        handle.promise().started = true;
+        this->detached_task([handle] { handle.resume(); });
+
+        return coroutine;
     }
 
-    template <class FuncType,
-              _has_signature_enable_if<FuncType, value_type(const_reference, size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
-    self& transform(FuncType func) {
-        const auto func_wrapper = [&](reference elem, size_type i, size_type j) { elem = func(elem, i, j); };
-        return this->for_each(func_wrapper);
+    // Spawns all coroutines & resumes the awaiting coroutine once all of them are done, if any of them throws
+    // the first exception (in the order of arguments) gets rethrown, but only after all coroutines have finished
+    template <class... Ts>
+    Coroutine<std::tuple<non_void_t<Ts>...>> when_all(Coroutine<Ts>... coroutines) {
+        ((coroutines = this->spawn(std::move(coroutines))), ...);
+        (co_await coroutines.completion(), ...);
+
+        co_return std::tuple<non_void_t<Ts>...>{take_result(coroutines)...};
     }
 
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW)
-    self& fill(const_reference value) {
-        for (size_type idx = 0; idx < this->size(); ++idx) this->operator[](idx) = value;
-        return *this;
+    template <class T>
+    Coroutine<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>>
+    when_all(std::vector<Coroutine<T>> coroutines) {
+        for (auto& coroutine : coroutines) coroutine = this->spawn(std::move(coroutine));
+        for (auto& coroutine : coroutines) co_await coroutine.completion();
+
+        if constexpr (std::is_void_v<T>) {
+            for (auto& coroutine : coroutines) coroutine.get();
+        } else {
+            std::vector<T> results;
+            results.reserve(coroutines.size());
+            for (auto& coroutine : coroutines) results.push_back(coroutine.get());
+            co_return results;
+        }
     }
 
-    template <class FuncType, _has_signature_enable_if<FuncType, value_type()> = true,
-              utl_mvl_require(ownership != Ownership::CONST_VIEW)>
-    self& fill(FuncType func) {
-        const auto func_wrapper = [&](reference elem) { elem = func(); };
-        return this->for_each(func_wrapper);
+private:
+    template <class T>
+    static non_void_t<T> take_result(Coroutine<T>& coroutine) {
+        if constexpr (std::is_void_v<T>) {
+            coroutine.get();
+            return {};
+        } else {
+            return coroutine.get();
+        }
     }
 
-    template <class FuncType, _has_signature_enable_if<FuncType, value_type(size_type)> = true,
-              utl_mvl_require(dimension == Dimension::VECTOR && ownership != Ownership::CONST_VIEW)>
-    self& fill(FuncType func) {
-        const auto func_wrapper = [&](reference elem, size_type i) { elem = func(i); };
-        return this->for_each(func_wrapper);
+public:
+#endif
+
+    // Per-worker counters accumulated since the workers were spawned, empty unless 'UTL_PARALLEL_ENABLE_STATS' is
+    // defined. Counters are read without stopping the workers, so the snapshot is only consistent for an idle pool.
+    [[nodiscard]] PoolStats stats() {
+        std::unique_lock workers_lock(this->workers_mutex, std::defer_lock);
+        if (ws_this_thread::thread_pool_ptr != this) workers_lock.lock(); // same reasoning as 'get_thread_count()'
+
+        PoolStats stats;
+
+        for (const auto& counters : this->counters) stats.workers.push_back(counters.value.snapshot());
+        stats.max_global_queue_depth = this->max_global_queue_depth.load(std::memory_order_relaxed);
+
+        return stats;
     }
 
-    template <class FuncType, _has_signature_enable_if<FuncType, value_type(size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
-    self& fill(FuncType func) {
-        const auto func_wrapper = [&](reference elem, size_type i, size_type j) { elem = func(i, j); };
-        return this->for_each(func_wrapper);
+    // Approximate check for threads parked with no queued tasks to take, which means a new task would get picked
+    // up right away. Tasks queued by the calling thread itself count too, since idle threads will steal them first.
+    [[nodiscard]] bool has_idle_threads() const noexcept {
+        if (!this->task_available.has_waiters()) return false;
+        if (this->global_queue_size.load(std::memory_order_relaxed)) return false;
+        if (ws_this_thread::thread_pool_ptr == this && !this->local_queues[ws_this_thread::worker_index].empty())
+            return false;
+        return true;
     }
 
-    template <class Compare, utl_mvl_require(ownership != Ownership::CONST_VIEW)>
-    self& sort(Compare cmp) {
-        std::sort(this->begin(), this->end(), cmp);
-        return *this;
+    template <class F, class... Args>
+    void detached_task(F&& f, Args&&... args) {
+        this->detached_task(Priority::normal, std::forward<F>(f), std::forward<Args>(args)...);
     }
-    template <class Compare, utl_mvl_require(ownership != Ownership::CONST_VIEW)>
-    self& stable_sort(Compare cmp) {
-        std::stable_sort(this->begin(), this->end(), cmp);
-        return *this;
+
+    template <class F, class... Args>
+    void detached_task(Priority priority, F&& f, Args&&... args) {
+        task_type task = this->make_task(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
+
+        this->tasks_unfinished.fetch_add(1, std::memory_order_seq_cst);
+        // task has to be counted before it becomes visible to the workers, otherwise it could
+        // get executed & decrement the counter first, which would briefly wrap it around zero
+
+        try {
+            // Recursive task, explicitly prioritized ones still go into the global tiers so any thread can see them
+            if (ws_this_thread::thread_pool_ptr == this && priority == Priority::normal) {
+                this->push_local(std::move(task));
+            }
+            // Regular task
+            else {
+                this->push_global(std::move(task), priority);
+            }
+        } catch (...) {
+            if (this->tasks_unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1) this->tasks_done.notify_all();
+            throw;
+        }
+
+        this->task_available.notify_one();
     }
 
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && _has_binary_op_less<value_type>::value)
-    self& sort() {
-        std::sort(this->begin(), this->end());
-        return *this;
+    // Submits every callable of '[first, last)' as a detached task with a single queue lock & a single notification,
+    // which wakes up only as many workers as there are tasks. Use 'std::make_move_iterator()' to move the callables.
+    template <class It>
+    void bulk_detached(It first, It last) {
+        std::size_t pushed = 0;
+        this->push_bulk(first, last, [](auto&& f) -> auto&& { return std::forward<decltype(f)>(f); }, pushed);
     }
-    utl_mvl_reqs(ownership != Ownership::CONST_VIEW && _has_binary_op_less<value_type>::value)
-    self& stable_sort() {
-        std::stable_sort(this->begin(), this->end());
-        return *this;
+
+    template <class F, class... Args, class R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    future_type<R> awaitable_task(F&& f, Args&&... args) {
+        return this->awaitable_task(Priority::normal, std::forward<F>(f), std::forward<Args>(args)...);
     }
 
-    // --- Sparse Subviews ---
-    // -----------------------
+    template <class F, class... Args, class R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    future_type<R> awaitable_task(Priority priority, F&& f, Args&&... args) {
+        auto closure = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
 
-    // - Const views -
-private:
-    using _cref_triplet_array =
-        std::vector<SparseEntry2D<std::reference_wrapper<const value_type>>>; // NOTE: Generalize for 1D
+        std::promise<R> promise;
+        future_type<R>  future = promise.get_future();
 
-public:
-    using sparse_const_view_type = GenericTensor<value_type, self::params::dimension, Type::SPARSE,
-                                                 Ownership::CONST_VIEW, self::params::checking, Layout::SPARSE>;
+        this->detached_task(priority, [closure = std::move(closure), promise = std::move(promise)]() mutable {
+            try {
+                if constexpr (std::is_void_v<R>) {
+                    closure();
+                    promise.set_value();
+                } else {
+                    promise.set_value(closure());
+                } // 'promise.set_value(f())' when 'f()' returns 'void' is a compile error, so we use a workaround
+            } catch (...) {
+                try {
+                    promise.set_exception(std::current_exception()); // this may still throw
+                } catch (...) {}
+            }
+        });
 
-    template <class UnaryPredicate, _has_signature_enable_if<UnaryPredicate, bool(const_reference)> = true>
-    [[nodiscard]] sparse_const_view_type filter(UnaryPredicate predicate) const {
-        const auto forwarded_predicate = [&](const_reference elem, size_type, size_type) -> bool {
-            return predicate(elem);
-        };
-        return this->filter(forwarded_predicate);
-        // NOTE: This would need its own implementation for a proper 1D support
+        return future;
     }
+};
 
-    template <class UnaryPredicate, _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type)> = true>
-    [[nodiscard]] sparse_const_view_type filter(UnaryPredicate predicate) const {
-        const auto forwarded_predicate = [&](const_reference elem, size_type i, size_type j) -> bool {
-            const size_type idx = this->get_idx_of_ij(i, j);
-            return predicate(elem, idx);
-        };
-        return this->filter(forwarded_predicate);
-        // NOTE: This would need its own implementation for a proper 1D support
+template <class T = void>
+using Future = ThreadPool::future_type<T>;
+
+// ==================
+// --- Task group ---
+// ==================
+
+// Fork-join primitive for recursive divide-and-conquer. Unlike awaitable tasks it doesn't allocate a shared
+// 'std::promise<>' / 'std::future<>' state per task, all of the state lives in the group on the stack of the
+// waiting thread, children only capture a pointer to it. Pending counter starts at 1, which is the reference
+// held by the group itself until 'wait()', this way the counter can only reach zero once the group is waited on.
+//
+// Waiting from a pool thread executes queued work (most likely our own children from the local deque) until
+// every child is done. When there is nothing to take the thread parks on the same event count as idle workers,
+// so any newly pushed task (for example grandchildren pushed by whoever stole our child) wakes it up to help
+// and the waiting thread counts as idle for 'ThreadPool::has_idle_threads()'. Completion of the last child
+// wakes it up too. Waiting from an external thread just parks until the last child signals completion.
+
+class TaskGroup {
+    ThreadPool* pool;
+
+    alignas(cache_line_size) std::atomic<std::size_t> pending{1};
+
+    std::atomic<bool>       failed{false};
+    std::atomic<bool>       helper_parked{false}; // pool thread waiting on the group is parked as an idle worker
+    std::exception_ptr      exception;
+    bool                    done = false;
+    std::mutex              mutex;
+    std::condition_variable cv;
+
+    void capture_exception(std::exception_ptr ptr) {
+        const std::scoped_lock lock(this->mutex);
+        if (!this->exception) this->exception = std::move(ptr); // first exception wins
+        this->failed.store(true, std::memory_order_relaxed);
     }
 
-    template <class UnaryPredicate,
-              _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX)>
-    [[nodiscard]] sparse_const_view_type filter(UnaryPredicate predicate) const {
-        // We can't preallocate triplets without scanning predicate through the whole matrix,
-        // so we just push back entries into a vector and use to construct a sparse view
-        _cref_triplet_array triplets;
-        const auto          add_triplet_if_predicate = [&](const_reference elem, size_type i, size_type j) -> void {
-            if (predicate(elem, i, j)) triplets.push_back({i, j, elem});
-        };
+    void finish_one() {
+        if (this->pending.fetch_sub(1, std::memory_order_seq_cst) != 1) return;
 
-        this->for_each(add_triplet_if_predicate);
+        // Parked helper can't be woken up selectively, it sleeps among idle workers. Either it sees 'pending == 0'
+        // before parking, or we see the flag here, both sides use 'seq_cst' so one of them can't miss the other.
+        if (this->helper_parked.load(std::memory_order_seq_cst)) this->pool->task_available.notify_all();
 
-        triplets.shrink_to_fit();
-        return sparse_const_view_type(this->rows(), this->cols(), std::move(triplets));
+        // Notification has to happen under the lock, once the waiter sees 'done' the group may be destroyed
+        const std::scoped_lock lock(this->mutex);
+        this->done = true;
+        this->cv.notify_all();
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX)
-    [[nodiscard]] sparse_const_view_type diagonal() const {
-        // Sparse matrices have no better way of getting a diagonal than filtering (i ==j)
-        if constexpr (self::params::type == Type::SPARSE) {
-            return this->filter([](const_reference, size_type i, size_type j) { return i == j; });
-        }
-        // Non-sparse matrices can just iterate over diagonal directly
-        else {
-            const size_type     min_size = std::min(this->rows(), this->cols());
-            _cref_triplet_array triplets;
-            triplets.reserve(min_size);
-            for (size_type k = 0; k < min_size; ++k) triplets.push_back({k, k, this->operator()(k, k)});
-            return sparse_const_view_type(this->rows(), this->cols(), std::move(triplets));
+    // Same loop as 'ThreadPool::worker_main()', except it ends once the group is done rather than on termination
+    void help() {
+        if (ws_this_thread::thread_pool_ptr != this->pool) return;
+
+        EventCount&           task_available = this->pool->task_available;
+        ThreadPool::task_type task;
+
+        while (this->pending.load(std::memory_order_seq_cst)) {
+            if (this->pool->try_acquire_task(task)) {
+                this->pool->execute(task);
+                continue;
+            }
+
+            const EventCount::key_type key = task_available.prepare_wait();
+            this->helper_parked.store(true, std::memory_order_seq_cst);
+
+            if (!this->pending.load(std::memory_order_seq_cst)) {
+                task_available.cancel_wait();
+            } else if (this->pool->try_acquire_task(task)) {
+                task_available.cancel_wait();
+                this->helper_parked.store(false, std::memory_order_relaxed);
+                this->pool->execute(task);
+                continue;
+            } else {
+                task_available.commit_wait(key);
+            }
+
+            this->helper_parked.store(false, std::memory_order_relaxed);
         }
     }
 
-    // - Mutable views -
-private:
-    using _ref_triplet_array =
-        std::vector<SparseEntry2D<std::reference_wrapper<value_type>>>; // NOTE: Generalize for 1D
+    template <class F>
+    auto make_child(F&& f) {
+        return [this, f = std::forward<F>(f)]() mutable {
+            if (!this->failed.load(std::memory_order_relaxed)) { // remaining work of a failed group is skipped
+                try {
+                    f();
+                } catch (...) { this->capture_exception(std::current_exception()); }
+            }
+            this->finish_one();
+        };
+    }
 
 public:
-    using sparse_view_type = GenericTensor<value_type, self::params::dimension, Type::SPARSE, Ownership::VIEW,
-                                           self::params::checking, Layout::SPARSE>;
+    explicit TaskGroup(ThreadPool& pool) : pool(&pool) {}
+    TaskGroup(); // uses global thread pool, defined after it
 
-    template <class UnaryPredicate, utl_mvl_require(ownership != Ownership::CONST_VIEW),
-              _has_signature_enable_if<UnaryPredicate, bool(const_reference)> = true>
-    [[nodiscard]] sparse_view_type filter(UnaryPredicate predicate) {
-        const auto forwarded_predicate = [&](const_reference elem, size_type, size_type) -> bool {
-            return predicate(elem);
-        };
-        return this->filter(forwarded_predicate);
-        // NOTE: This would need its own implementation for a proper 1D support
+    TaskGroup(const TaskGroup&)            = delete;
+    TaskGroup(TaskGroup&&)                 = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    TaskGroup& operator=(TaskGroup&&)      = delete;
+
+    ~TaskGroup() {
+        try {
+            this->wait();
+        } catch (...) {} // children reference the group, it can't die before them, exceptions are discarded
     }
 
-    template <class UnaryPredicate, utl_mvl_require(ownership != Ownership::CONST_VIEW),
-              _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type)> = true>
-    [[nodiscard]] sparse_view_type filter(UnaryPredicate predicate) {
-        const auto forwarded_predicate = [&](const_reference elem, size_type i, size_type j) -> bool {
-            const size_type idx = this->get_idx_of_ij(i, j);
-            return predicate(elem, idx);
-        };
-        return this->filter(forwarded_predicate);
-        // NOTE: This would need its own implementation for a proper 1D support
+    template <class F>
+    void run(F&& f) {
+        this->pending.fetch_add(1, std::memory_order_relaxed); // group reference keeps the counter above zero
+
+        try {
+            this->pool->detached_task(this->make_child(std::forward<F>(f)));
+        } catch (...) {
+            this->pending.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
     }
 
-    template <class UnaryPredicate,
-              _has_signature_enable_if<UnaryPredicate, bool(const_reference, size_type, size_type)> = true,
-              utl_mvl_require(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)>
-    [[nodiscard]] sparse_view_type filter(UnaryPredicate predicate) {
-        // This method implements actual filtering, others just forward predicates to it
-        _ref_triplet_array triplets;
-        // We can't preallocate triplets without scanning predicate through the whole matrix,
-        // so we just push back entries into a vector and use to construct a sparse view
-        const auto         add_triplet_if_predicate = [&](reference elem, size_type i, size_type j) -> void {
-            if (predicate(elem, i, j)) triplets.push_back({i, j, elem});
-        };
+    // Runs every callable of '[first, last)' as a part of the group, see 'ThreadPool::bulk_detached()'
+    template <class It>
+    void bulk_run(It first, It last) {
+        const std::size_t count = static_cast<std::size_t>(std::distance(first, last));
 
-        this->for_each(add_triplet_if_predicate);
+        this->pending.fetch_add(count, std::memory_order_relaxed);
 
-        triplets.shrink_to_fit();
-        return sparse_view_type(this->rows(), this->cols(), std::move(triplets));
+        std::size_t pushed = 0;
+        try {
+            this->pool->push_bulk(
+                first, last, [this](auto&& f) { return this->make_child(std::forward<decltype(f)>(f)); }, pushed);
+        } catch (...) {
+            this->pending.fetch_sub(count - pushed, std::memory_order_relaxed);
+            throw;
+        }
     }
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)
-    [[nodiscard]] sparse_view_type diagonal() {
-        /* Sparse matrices have no better way of getting a diagonal than filtering (i == j) */
-        if constexpr (self::params::type == Type::SPARSE) {
-            return this->filter([](const_reference, size_type i, size_type j) { return i == j; });
-        } /* Non-sparse matrices can just iterate over diagonal directly */
-        else {
-            const size_type    min_size = std::min(this->rows(), this->cols());
-            _ref_triplet_array triplets;
-            triplets.reserve(min_size);
-            for (size_type k = 0; k < min_size; ++k) triplets.push_back({k, k, this->operator()(k, k)});
-            return sparse_view_type(this->rows(), this->cols(), std::move(triplets));
+    void wait() {
+        // Release the group reference, if some children are still pending help them & park until the last one is done,
+        // even after helping we still have to wait for 'done' since the last child might still be touching the group
+        if (this->pending.fetch_sub(1, std::memory_order_seq_cst) != 1) {
+            this->help();
+
+            std::unique_lock lock(this->mutex);
+            this->cv.wait(lock, [this] { return this->done; });
         }
+
+        // Reset the group so it can be reused
+        this->pending.store(1, std::memory_order_relaxed);
+        this->done = false;
+        this->failed.store(false, std::memory_order_relaxed);
+
+        if (std::exception_ptr ptr = std::exchange(this->exception, nullptr)) std::rethrow_exception(ptr);
     }
+};
+
+// ==============
+// --- Ranges ---
+// ==============
+
+// --- SFINAE helpers ---
+// ----------------------
+
+template <bool Cond>
+using require = std::enable_if_t<Cond, bool>;
+
+template <class T, class... Args>
+using require_invocable = require<std::is_invocable_v<T, Args...>>;
+// this is simple convenience
+
+template <class T, class = void>
+struct has_iter : std::false_type {};
+template <class T>
+struct has_iter<T, std::void_t<decltype(std::declval<typename T::iterator>())>> : std::true_type {};
+
+template <class T, class = void>
+struct has_const_iter : std::false_type {};
+template <class T>
+struct has_const_iter<T, std::void_t<decltype(std::declval<typename T::const_iterator>())>> : std::true_type {};
 
-    // --- Block Subviews ---
-    // ----------------------
-public:
-    // - Const views -
-    using block_const_view_type =
-        std::conditional_t<self::params::type == Type::SPARSE, sparse_const_view_type,
-                           GenericTensor<value_type, self::params::dimension, Type::STRIDED, Ownership::CONST_VIEW,
-                                         self::params::checking, self::params::layout>>;
+template <class T>
+using require_has_some_iter = require<has_iter<T>::value || has_const_iter<T>::value>;
+// needed to restrict template 'Range' constructor from a container, otherwise it takes priority over copy / move ctors
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
-    [[nodiscard]] block_const_view_type block(size_type block_i, size_type block_j, size_type block_rows,
-                                              size_type block_cols) const {
-        // Sparse matrices have no better way of getting a block than filtering by { i, j }
+template <class T, class = void>
+struct is_recursive : std::false_type {};
+template <class T>
+struct is_recursive<T, std::void_t<decltype(std::declval<typename T::is_recursive>())>> : std::true_type {};
+template <class T>
+constexpr bool is_recursive_v = is_recursive<T>::value;
 
-        // Do the same thing as in .filter(), but shrink resulting view size to
-        // { block_rows, block_cols } and shift indexation by { block_i, block_j }
-        _cref_triplet_array triplets;
+template <class T, class = void>
+struct has_thread_count : std::false_type {};
+template <class T>
+struct has_thread_count<T, std::void_t<decltype(std::declval<T&>().get_thread_count())>> : std::true_type {};
+template <class T>
+constexpr bool has_thread_count_v = has_thread_count<T>::value;
 
-        const auto add_triplet_if_inside_block = [&](const_reference elem, size_type i, size_type j) -> void {
-            if ((block_i <= i) && (i < block_i + block_rows) && (block_j <= j) && (j < block_j + block_cols))
-                triplets.push_back({i - block_i, j - block_j, elem});
-        };
+template <class T, class = void>
+struct has_idle_threads : std::false_type {};
+template <class T>
+struct has_idle_threads<T, std::void_t<decltype(std::declval<T&>().has_idle_threads())>> : std::true_type {};
+template <class T>
+constexpr bool has_idle_threads_v = has_idle_threads<T>::value;
 
-        this->for_each(add_triplet_if_inside_block);
+template <class T, class = void>
+struct has_bulk_detached : std::false_type {};
+template <class T>
+struct has_bulk_detached<T, std::void_t<decltype(std::declval<T&>().bulk_detached(std::declval<void (**)()>(),
+                                                                                   std::declval<void (**)()>()))>>
+    : std::true_type {};
+template <class T>
+constexpr bool has_bulk_detached_v = has_bulk_detached<T>::value;
 
-        triplets.shrink_to_fit();
-        return block_const_view_type(block_rows, block_cols, std::move(triplets));
-    }
+// --- Utils ---
+// -------------
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type != Type::SPARSE)
-    [[nodiscard]] block_const_view_type block(size_type block_i, size_type block_j, size_type block_rows,
-                                              size_type block_cols) const {
-        if constexpr (self::params::layout == Layout::RC) {
-            const size_type row_stride = this->row_stride() + this->col_stride() * (this->cols() - block_cols);
-            const size_type col_stride = this->col_stride();
-            return block_const_view_type(block_rows, block_cols, row_stride, col_stride,
-                                         &this->operator()(block_i, block_j));
-        }
-        if constexpr (self::params::layout == Layout::CR) {
-            const size_type row_stride = this->row_stride();
-            const size_type col_stride = this->col_stride() + this->row_stride() * (this->rows() - block_rows);
-            return block_const_view_type(block_rows, block_cols, row_stride, col_stride,
-                                         &this->operator()(block_i, block_j));
-        }
-        utl_mvl_unreachable;
-    }
+[[nodiscard]] constexpr std::size_t min_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? b : a; }
+[[nodiscard]] constexpr std::size_t max_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? a : b; }
+// standard min/max would be ambiguous with our own binary operations of the same name, hence a separate pair
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX)
-    [[nodiscard]] block_const_view_type row(size_type i) const { return this->block(i, 0, 1, this->cols()); }
+constexpr std::size_t default_grains_per_thread = 4;
+// by default we distribute 4 tasks per thread, this number is purely empirical. We don't want to split up
+// work into too many tasks (like with 'grain_size = 1'), yet we want it to be a bit more granular than
+// doing 1 task per thread since that would be horrible if tasks are noticeably uneven.
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX)
-    [[nodiscard]] block_const_view_type col(size_type j) const { return this->block(0, j, this->rows(), 1); }
+[[nodiscard]] inline std::size_t default_grain_size(std::size_t size) {
+    return max_size(1, size / (hardware_concurrency() * default_grains_per_thread));
+}
 
-    // - Mutable views -
-    using block_view_type =
-        std::conditional_t<self::params::type == Type::SPARSE, sparse_view_type,
-                           GenericTensor<value_type, self::params::dimension, Type::STRIDED, Ownership::VIEW,
-                                         self::params::checking, self::params::layout>>;
+constexpr std::size_t auto_grain = 0;
+// grain size sentinel that enables auto-partitioning, work gets split into coarse chunks which are then
+// split further on demand whenever some threads become idle, see 'Scheduler::auto_partitioned_loop()'
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE && ownership != Ownership::CONST_VIEW)
-    [[nodiscard]] block_view_type block(size_type block_i, size_type block_j, size_type block_rows,
-                                        size_type block_cols) {
-        // Sparse matrices have no better way of getting a block than filtering by { i, j }
+constexpr std::size_t auto_grain_steps_per_thread = 64;
+// auto-partitioned chunks are processed in steps of 'size / (threads * 64)' iterations, in between the steps
+// we check whether some threads are idle and can take over a half of the remaining work
 
-        // Do the same thing as in .filter(), but shrink resulting view size to
-        // { block_rows, block_cols } and shift indexation by { block_i, block_j }
-        _ref_triplet_array triplets;
+[[nodiscard]] inline std::size_t resolve_grain_size(std::size_t grain_size, std::size_t size) {
+    return (grain_size == auto_grain) ? default_grain_size(size) : grain_size;
+} // algorithms that need a fixed block structure fall back onto a default grain when asked for auto-partitioning
 
-        const auto add_triplet_if_inside_block = [&](reference elem, size_type i, size_type j) -> void {
-            if ((block_i <= i) && (i < block_i + block_rows) && (block_j <= j) && (j < block_j + block_cols))
-                triplets.push_back({i - block_i, j - block_j, elem});
-        };
+constexpr std::size_t min_parallel_scan_size = 1 << 15;
+// parallel scan traverses the input twice, which makes it slower than a serial scan unless input is large enough
 
-        this->for_each(add_triplet_if_inside_block);
+constexpr std::size_t min_parallel_sort_size = 1 << 14;
+// parallel sort & partition need an intermediate buffer, below this size it's faster to just do things serially
 
-        triplets.shrink_to_fit();
-        return block_view_type(block_rows, block_cols, std::move(triplets));
-    }
+// --- Range ---
+// -------------
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type != Type::SPARSE && ownership != Ownership::CONST_VIEW)
-    [[nodiscard]] block_view_type block(size_type block_i, size_type block_j, size_type block_rows,
-                                        size_type block_cols) {
-        if constexpr (self::params::layout == Layout::RC) {
-            const size_type row_stride = this->row_stride() + this->col_stride() * (this->cols() - block_cols);
-            const size_type col_stride = this->col_stride();
-            return block_view_type(block_rows, block_cols, row_stride, col_stride, &this->operator()(block_i, block_j));
-        }
-        if constexpr (self::params::layout == Layout::CR) {
-            const size_type row_stride = this->row_stride();
-            const size_type col_stride = this->col_stride() + this->row_stride() * (this->rows() - block_rows);
-            return block_view_type(block_rows, block_cols, row_stride, col_stride, &this->operator()(block_i, block_j));
-        }
-        utl_mvl_unreachable;
-    }
+template <class It>
+constexpr bool is_random_access_v =
+    std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<It>::iterator_category>;
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)
-    [[nodiscard]] block_view_type row(size_type i) { return this->block(i, 0, 1, this->cols()); }
+template <class It>
+[[nodiscard]] std::size_t distance_size(It begin, It end) {
+    return static_cast<std::size_t>(std::distance(begin, end));
+} // O(1) for random-access iterators, a single pass over the range otherwise
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && ownership != Ownership::CONST_VIEW)
-    [[nodiscard]] block_view_type col(size_type j) { return this->block(0, j, this->rows(), 1); }
+template <class It>
+struct Range {
+    It          begin;
+    It          end;
+    std::size_t grain_size;
 
-    // --- Sparse operations ---
-    // -------------------------
+    Range() = delete;
 
-private:
-    using _triplet_t = _choose_based_on_ownership<_ownership, SparseEntry2D<value_type>,
-                                                  SparseEntry2D<std::reference_wrapper<value_type>>,
-                                                  SparseEntry2D<std::reference_wrapper<const value_type>>>;
+    constexpr Range(It begin, It end, std::size_t grain_size) : begin(begin), end(end), grain_size(grain_size) {}
 
-public:
-    using sparse_entry_type = _triplet_t;
+    Range(It begin, It end)
+        : Range(begin, end, default_grain_size(distance_size(begin, end))) {}
 
-    utl_mvl_reqs(type == Type::SPARSE)
-    [[nodiscard]] const std::vector<sparse_entry_type>& entries() const noexcept { return this->_data; }
 
-    utl_mvl_reqs(type == Type::SPARSE && ownership != Ownership::CONST_VIEW)
-    [[nodiscard]] std::vector<sparse_entry_type>& entries() noexcept { return this->_data; }
+    template <class Container, require<has_const_iter<Container>::value> = true>
+    Range(const Container& container) : Range(container.begin(), container.end()) {}
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
-    self& insert_triplets(const std::vector<sparse_entry_type>& triplets) {
-        // Bulk-insert triplets and sort by index
-        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
-            return (l.i < r.i) && (l.j < r.j);
-        };
+    template <class Container, require<has_iter<Container>::value> = true>
+    Range(Container& container) : Range(container.begin(), container.end()) {}
+}; // loops & reductions accept forward iterators, scans & sorts require random-access ones
 
-        this->_data.insert(this->_data.end(), triplets.begin(), triplets.end());
-        std::sort(this->_data.begin(), this->_data.end(), ordering);
+// Note: Blocks of random-access ranges are computed with an offset, blocks of forward ranges get built by walking
+//       the range once on the calling thread, which is still much cheaper than copying a container into a vector
 
-        return *this;
-    }
+// CTAD for deducing iterator range from a container
+template <class Container>
+Range(const Container& container) -> Range<typename Container::const_iterator>;
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
-    self& rewrite_triplets(std::vector<sparse_entry_type>&& triplets) {
-        // Move-construct all triplets at once and sort by index
-        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
-            return (l.i < r.i) && (l.j < r.j);
-        };
+template <class Container>
+Range(Container& container) -> Range<typename Container::iterator>;
 
-        this->_data = std::move(triplets);
-        std::sort(this->_data.begin(), this->_data.end(), ordering);
+// --- Index range ---
+// -------------------
 
-        return *this;
-    }
+template <class Idx = std::ptrdiff_t>
+struct IndexRange {
+    Idx         first;
+    Idx         last;
+    std::size_t grain_size;
 
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
-    self& erase_triplets(std::vector<Index2D> indices) {
-        // Erase triplets with {i, j} from 'indices' using the fact that both
-        // 'indices' and triplets are sorted. We can scan through triplets once
-        // while advancing 'cursor' when 'indices[cursor]' gets deleted, which
-        // result in all necessary triplets being marked for erasure in order.
-        std::sort(indices.begin(), indices.end());
-        std::size_t cursor = 0;
+    IndexRange() = delete;
 
-        const auto erase_condition = [&](const sparse_entry_type& triplet) -> bool {
-            /* Stop erasing once all target indices are handled */
-            if (cursor == indices.size()) return false;
-            if (indices[cursor].i == triplet.i && indices[cursor].j == triplet.j) {
-                ++cursor;
-                return true;
-            }
-            return false;
-        };
+    constexpr IndexRange(Idx first, Idx last, std::size_t grain_size)
+        : first(first), last(last), grain_size(grain_size) {}
 
-        const auto iter = std::remove_if(this->_data.begin(), this->_data.end(), erase_condition);
-        this->_data.erase(iter, this->_data.end());
+    IndexRange(Idx first, Idx last)
+        : IndexRange(first, last, default_grain_size(last - first)) {}
 
-        // Re-sort triplets just in case
-        const auto ordering = [](const sparse_entry_type& l, const sparse_entry_type& r) -> bool {
-            return (l.i < r.i) && (l.j < r.j);
-        };
-        std::sort(this->_data.begin(), this->_data.end(), ordering);
+    template <class Idx1, class Idx2>
+    constexpr IndexRange(Idx1 first, Idx2 last, std::size_t grain_size)
+        : first(first), last(last), grain_size(grain_size) {}
 
-        return *this;
-    }
+    template <class Idx1, class Idx2>
+    IndexRange(Idx1 first, Idx2 last)
+        : IndexRange(first, last, default_grain_size(last - first)) {}
+};
 
-    // --- Constructors ---
-    // --------------------
+// Note: It is common to have a ranges from 'int' to 'std::size_t' (for example 'IndexRange{0, vec.size()}'),
+//       in such cases we assume 'std::ptrdiff_t' as a reasonable default
 
-    // - Matrix -
-public:
-    // Rule of five:
-    // copy-ctor       - [+] (deduced from copy-assignment)
-    // move-ctor       - [+] (= default)
-    // copy-assignment - [+] (custom for dense/strided, same as default for sparse)
-    // move-assignment - [+] (= default)
-    // destructor      - [+] (= default)
+// --- Multidimensional index range ---
+// ------------------------------------
 
-    // Move-ctor is default for all types
-    GenericTensor(self&& other) noexcept = default;
+// Multidimensional ranges are split into tiles, tile size along each dimension is given by the grain size
+// of the corresponding 1D range, 'auto_grain' picks a size that splits the range into a default number of tiles
 
-    // Move-assignment is default for all types
-    self& operator=(self&& other) noexcept = default;
+enum class TileOrder { row_major, z_order, hilbert };
 
-    // Copy-ctor is deduced from assignment operator
-    GenericTensor(const self& other) { *this = other; }
+template <class Idx = std::ptrdiff_t>
+struct IndexRange2D {
+    IndexRange<Idx> i;
+    IndexRange<Idx> j;
+    TileOrder       order;
 
-    // Copy-assignment
-    self& operator=(const self& other) {
-        // Note: copy-assignment operator CANNOT be templated, it has to be implemented with 'if constexpr'
-        this->_rows = other.rows();
-        this->_cols = other.cols();
-        if constexpr (self::params::type == Type::DENSE) {
-            this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
-            std::copy(other.begin(), other.end(), this->begin());
-        }
-        if constexpr (self::params::type == Type::STRIDED) {
-            this->_row_stride = other.row_stride();
-            this->_col_stride = other.col_stride();
-            this->_data       = std::move(_make_unique_ptr_array<value_type>(this->size()));
-            std::copy(other.begin(), other.end(), this->begin());
-        }
-        if constexpr (self::params::type == Type::SPARSE) { this->_data = other._data; }
-        return *this;
-    }
+    IndexRange2D() = delete;
 
-    // Default-ctor (containers)
-    utl_mvl_reqs(ownership == Ownership::CONTAINER)
-    GenericTensor() noexcept {}
+    constexpr IndexRange2D(IndexRange<Idx> i, IndexRange<Idx> j, TileOrder order = TileOrder::row_major)
+        : i(i), j(j), order(order) {}
+};
 
-    // Default-ctor (views)
-    utl_mvl_reqs(ownership != Ownership::CONTAINER)
-    GenericTensor() noexcept = delete;
+template <class Idx = std::ptrdiff_t>
+struct IndexRange3D {
+    IndexRange<Idx> i;
+    IndexRange<Idx> j;
+    IndexRange<Idx> k;
+    TileOrder       order;
 
-    // Copy-assignment over the config boundaries
-    // We can change checking config, copy from matrices with different layouts,
-    // copy from views and even matrices of other types
-    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
-                              ownership == Ownership::CONTAINER)>
-    self& operator=(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
-                                        other_checking, other_layout>& other) {
-        this->_rows = other.rows();
-        this->_cols = other.cols();
-        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
-        this->fill(value_type());
-        other.for_each([&](const value_type& element, size_type i, size_type j) { this->operator()(i, j) = element; });
-        return *this;
-        // copying from sparse to dense works, all elements that weren't in the sparse matrix remain default-initialized
-    }
+    IndexRange3D() = delete;
 
-    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
-                              ownership == Ownership::CONTAINER)>
-    self& operator=(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
-                                        other_checking, other_layout>& other) {
-        this->_rows       = other.rows();
-        this->_cols       = other.cols();
-        this->_row_stride = other.row_stride();
-        this->_col_stride = other.col_stride();
-        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->size()));
-        this->fill(value_type());
-        // Not quite sure whether swapping strides when changing layouts like this is okay,
-        // but it seems to be correct
-        if constexpr (self::params::layout != other_layout) std::swap(this->_row_stride, this->_cols_stride);
-        other.for_each([&](const value_type& element, size_type i, size_type j) { this->operator()(i, j) = element; });
-        return *this;
-        // copying from sparse to strided works, all elements that weren't in the sparse matrix remain
-        // default-initialized
+    constexpr IndexRange3D(IndexRange<Idx> i, IndexRange<Idx> j, IndexRange<Idx> k,
+                           TileOrder order = TileOrder::row_major)
+        : i(i), j(j), k(k), order(order) {}
+};
+
+// --- Tiling ---
+// --------------
+
+// Space-filling curve keys, tiles with close keys are also close to each other in space. Threads process
+// contiguous runs of tiles, with a curve order such runs form compact blobs rather than long thin stripes,
+// which means less data gets pulled into the cache per tile for stencils & other neighborhood-based loops.
+
+template <std::size_t N>
+[[nodiscard]] constexpr std::uint64_t morton_key(const std::array<std::uint32_t, N>& coords, unsigned bits) noexcept {
+    std::uint64_t key = 0;
+    for (unsigned b = bits; b-- > 0;)
+        for (std::size_t d = 0; d < N; ++d) key = (key << 1) | ((coords[d] >> b) & 1u);
+    return key;
+}
+
+// See J. Skilling "Programming the Hilbert curve" (2004), coordinates get transformed into a "transposed"
+// Hilbert index in place, interleaving its bits the same way as for a Morton key produces the index itself
+template <std::size_t N>
+[[nodiscard]] constexpr std::uint64_t hilbert_key(std::array<std::uint32_t, N> x, unsigned bits) noexcept {
+    const std::uint32_t m = std::uint32_t(1) << (bits - 1);
+
+    // Inverse undo
+    for (std::uint32_t q = m; q > 1; q >>= 1) {
+        const std::uint32_t p = q - 1;
+        for (std::size_t i = 0; i < N; ++i) {
+            if (x[i] & q) {
+                x[0] ^= p; // invert
+            } else {
+                const std::uint32_t t = (x[0] ^ x[i]) & p; // exchange
+                x[0] ^= t;
+                x[i] ^= t;
+            }
+        }
     }
 
-    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::SPARSE &&
-                              ownership == Ownership::CONTAINER)>
-    self& operator=(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership,
-                                        other_checking, other_layout>& other) {
-        this->_rows = other.rows();
-        this->_cols = other.cols();
-        std::vector<sparse_entry_type> triplets;
+    // Gray encode
+    for (std::size_t i = 1; i < N; ++i) x[i] ^= x[i - 1];
 
-        // Other sparse matrices can be trivially copied
-        if constexpr (other_type == Type::SPARSE) {
-            triplets.reserve(other.size());
-            other.for_each([&](const value_type& elem, size_type i, size_type j) { triplets.push_back({i, j, elem}); });
-        }
-        // Non-sparse matrices are filtered by non-default-initialized-elements to construct a sparse subset
-        else {
-            other.for_each([&](const_reference elem, size_type i, size_type j) {
-                if (elem != value_type()) triplets.push_back({i, j, elem});
-            });
-        }
+    std::uint32_t t = 0;
+    for (std::uint32_t q = m; q > 1; q >>= 1)
+        if (x[N - 1] & q) t ^= q - 1;
+    for (std::size_t i = 0; i < N; ++i) x[i] ^= t;
 
-        this->rewrite_triplets(std::move(triplets));
-        return *this;
-    }
+    return morton_key(x, bits);
+}
 
-    // Copy-ctor over the config boundaries (deduced from assignment over config boundaries)
-    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && ownership == Ownership::CONTAINER)>
-    GenericTensor(const GenericTensor<value_type, self::params::dimension, other_type, other_ownership, other_checking,
-                                      other_layout>& other) {
-        *this = other;
-    }
+// Splits N-dimensional index range into tiles & enumerates them in a given order. Row-major order maps tile
+// numbers to tile coordinates arithmetically, curve orders sort the tile coordinates by their key upfront.
+template <std::size_t N, class Idx>
+class Tiling {
+    std::array<Idx, N>                        first;
+    std::array<std::size_t, N>                sizes;
+    std::array<std::size_t, N>                tile_sizes;
+    std::array<std::size_t, N>                tile_counts;
+    std::vector<std::array<std::uint32_t, N>> curve; // tile coordinates in curve order, empty for row-major
 
-    // Move-assignment over config boundaries
-    // Note: Unlike copying, we can't change layout, only checking config
-    // Also 'other' can no longer be a view or have a different type
-    template <Checking other_checking, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
-                                                       ownership == Ownership::CONTAINER)>
-    self& operator=(GenericTensor<value_type, self::params::dimension, self::params::type, self::params::ownership,
-                                  other_checking, self::params::layout>&& other) {
-        this->_rows = other.rows();
-        this->_cols = other.cols();
-        this->_data = std::move(other._data);
-        return *this;
-    }
+    // Smallest number of pieces per dimension that gives at least the default number of tiles in total
+    static std::size_t default_pieces() {
+        const std::size_t target = hardware_concurrency() * default_grains_per_thread;
 
-    template <Checking other_checking, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
-                                                       ownership == Ownership::CONTAINER)>
-    self& operator=(GenericTensor<value_type, self::params::dimension, self::params::type, self::params::ownership,
-                                  other_checking, self::params::layout>&& other) {
-        this->_rows       = other.rows();
-        this->_cols       = other.cols();
-        this->_row_stride = other.row_stride();
-        this->_col_stride = other.col_stride();
-        this->_data       = std::move(other._data);
-        return *this;
+        std::size_t pieces = 1;
+        for (;; ++pieces) {
+            std::size_t total = 1;
+            for (std::size_t d = 0; d < N; ++d) total *= pieces;
+            if (total >= target) return pieces;
+        }
     }
 
-    template <Checking other_checking, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::SPARSE &&
-                                                       ownership == Ownership::CONTAINER)>
-    self& operator=(GenericTensor<value_type, self::params::dimension, self::params::type, self::params::ownership,
-                                  other_checking, self::params::layout>&& other) {
-        this->_rows = other.rows();
-        this->_cols = other.cols();
-        this->_data = std::move(other._data);
-        return *this;
-    }
+public:
+    Tiling(const std::array<IndexRange<Idx>, N>& ranges, TileOrder order) {
+        for (std::size_t d = 0; d < N; ++d) {
+            const IndexRange<Idx>& range = ranges[d];
 
-    // Move-ctor over the config boundaries (deduced from move-assignment over config boundaries)
-    template <Type other_type, Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && ownership == Ownership::CONTAINER)>
-    GenericTensor(GenericTensor<value_type, self::params::dimension, other_type, other_ownership, other_checking,
-                                other_layout>&& other) {
-        *this = std::move(other);
-    }
+            this->first[d] = range.first;
+            this->sizes[d] = (range.first < range.last) ? static_cast<std::size_t>(range.last - range.first) : 0;
 
-    // Init-with-value
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::CONTAINER)
-    explicit GenericTensor(size_type rows, size_type cols, const_reference value = value_type()) {
-        this->_rows = rows;
-        this->_cols = cols;
-        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
-        this->fill(value);
-    }
+            if (range.grain_size == auto_grain) {
+                const std::size_t pieces = default_pieces();
+                this->tile_sizes[d]      = max_size((this->sizes[d] + pieces - 1) / pieces, 1);
+            } else {
+                this->tile_sizes[d] = range.grain_size;
+            }
 
-    // Init-with-lambda
-    template <class FuncType, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
-                                              ownership == Ownership::CONTAINER)>
-    explicit GenericTensor(size_type rows, size_type cols, FuncType init_func) {
-        // .fill() already takes care of preventing improper values of 'FuncType', no need to do the check here
-        this->_rows = rows;
-        this->_cols = cols;
-        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
-        this->fill(init_func);
-    }
+            this->tile_counts[d] = (this->sizes[d] + this->tile_sizes[d] - 1) / this->tile_sizes[d];
+        }
 
-    // Init-with-ilist
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::CONTAINER)
-    GenericTensor(std::initializer_list<std::initializer_list<value_type>> init) {
-        this->_rows = init.size();
-        this->_cols = (*init.begin()).size();
-        this->_data = std::move(_make_unique_ptr_array<value_type>(this->size()));
+        if (order == TileOrder::row_major || this->size() == 0) return;
 
-        // Check dimensions (throw if cols have different dimensions)
-        for (auto row_it = init.begin(); row_it < init.end(); ++row_it)
-            if (static_cast<size_type>((*row_it).end() - (*row_it).begin()) != this->cols())
-                throw std::invalid_argument("Initializer list dimensions don't match.");
+        // Curve has to cover a power-of-2 grid, tiles outside of the range simply don't get a key
+        std::size_t max_count = 1;
+        for (std::size_t d = 0; d < N; ++d) max_count = max_size(max_count, this->tile_counts[d]);
 
-        // Copy elements
-        for (size_type i = 0; i < this->rows(); ++i)
-            for (size_type j = 0; j < this->cols(); ++j) this->operator()(i, j) = (init.begin()[i]).begin()[j];
-    }
+        unsigned bits = 1;
+        while ((max_count - 1) >> bits) ++bits;
 
-    // Init-with-data
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::CONTAINER)
-    explicit GenericTensor(size_type rows, size_type cols, pointer data_ptr) noexcept {
-        this->_rows = rows;
-        this->_cols = cols;
-        this->_data = std::move(decltype(this->_data)(data_ptr));
-    }
+        std::vector<std::pair<std::uint64_t, std::array<std::uint32_t, N>>> keyed(this->size());
 
-    // - Matrix View -
+        for (std::size_t t = 0; t < keyed.size(); ++t) {
+            std::array<std::uint32_t, N> coords = this->row_major_coords(t);
+            keyed[t] = {(order == TileOrder::hilbert) ? hilbert_key(coords, bits) : morton_key(coords, bits), coords};
+        }
 
-    // Init-from-data
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::VIEW)
-    explicit GenericTensor(size_type rows, size_type cols, pointer data_ptr) {
-        this->_rows = rows;
-        this->_cols = cols;
-        this->_data = data_ptr;
-    }
+        std::sort(keyed.begin(), keyed.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
 
-    // Init-from-tensor (any tensor of the same API type)
-    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::VIEW)>
-    GenericTensor(GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
-                                other_checking, other_layout>& other) {
-        this->_rows = other.rows();
-        this->_cols = other.cols();
-        this->_data = other.data();
+        this->curve.reserve(keyed.size());
+        for (const auto& [key, coords] : keyed) this->curve.push_back(coords);
     }
 
-    // - Const Matrix View -
-
-    // Init-from-data
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::DENSE && ownership == Ownership::CONST_VIEW)
-    explicit GenericTensor(size_type rows, size_type cols, const_pointer data_ptr) {
-        this->_rows = rows;
-        this->_cols = cols;
-        this->_data = data_ptr;
+    [[nodiscard]] std::size_t size() const noexcept {
+        std::size_t total = 1;
+        for (std::size_t d = 0; d < N; ++d) total *= this->tile_counts[d];
+        return total;
     }
 
-    // Init-from-tensor (any tensor of the same API type)
-    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::DENSE &&
-                              ownership == Ownership::CONST_VIEW)>
-    GenericTensor(const GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
-                                      other_checking, other_layout>& other) {
-        this->_rows = other.rows();
-        this->_cols = other.cols();
-        this->_data = other.data();
+    // Last dimension is the fastest one, same as for nested loops over 'i, j, k'
+    [[nodiscard]] std::array<std::uint32_t, N> row_major_coords(std::size_t t) const noexcept {
+        std::array<std::uint32_t, N> coords{};
+        for (std::size_t d = N; d-- > 0;) {
+            coords[d] = static_cast<std::uint32_t>(t % this->tile_counts[d]);
+            t /= this->tile_counts[d];
+        }
+        return coords;
     }
 
-    // - Strided Matrix -
+    // Invokes 'f(low, high)' with index bounds of the tile number 't'
+    template <class F>
+    void visit(std::size_t t, F& f) const {
+        const std::array<std::uint32_t, N> coords = this->curve.empty() ? this->row_major_coords(t) : this->curve[t];
 
-    // Init-with-value
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONTAINER)
-    explicit GenericTensor(size_type rows, size_type cols, size_type row_stride, size_type col_stride,
-                           const_reference value = value_type()) {
-        this->_rows       = rows;
-        this->_cols       = cols;
-        this->_row_stride = row_stride;
-        this->_col_stride = col_stride;
-        // Allocates size is NOT the same as .size() due to padding, see notes on '_total_allocated_size()'
-        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
-        this->fill(value);
-    }
+        std::array<Idx, N> low, high;
+        for (std::size_t d = 0; d < N; ++d) {
+            const std::size_t offset = coords[d] * this->tile_sizes[d];
+            const std::size_t extent = min_size(offset + this->tile_sizes[d], this->sizes[d]);
 
-    // Init-with-lambda
-    template <class FuncType, utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
-                                              ownership == Ownership::CONTAINER)>
-    explicit GenericTensor(size_type rows, size_type cols, size_type row_stride, size_type col_stride,
-                           FuncType init_func) {
-        // .fill() already takes care of preventing improper values of 'FuncType', no need to do the check here
-        this->_rows       = rows;
-        this->_cols       = cols;
-        this->_row_stride = row_stride;
-        this->_col_stride = col_stride;
-        // Allocates size is NOT the same as .size() due to padding, see notes on '_total_allocated_size()'
-        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
-        this->fill(init_func);
+            low[d]  = static_cast<Idx>(this->first[d] + static_cast<Idx>(offset));
+            high[d] = static_cast<Idx>(this->first[d] + static_cast<Idx>(extent));
+        }
+
+        f(low, high);
     }
+};
 
-    // Init-with-ilist
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONTAINER)
-    GenericTensor(std::initializer_list<std::initializer_list<value_type>> init, size_type row_stride,
-                  size_type col_stride) {
-        this->_rows       = init.size();
-        this->_cols       = (*init.begin()).size();
-        this->_row_stride = row_stride;
-        this->_col_stride = col_stride;
-        // Allocates size is NOT the same as .size() due to padding, see notes on '_total_allocated_size()'
-        this->_data       = std::move(_make_unique_ptr_array<value_type>(this->_total_allocated_size()));
+// ==========================
+// --- Per-worker storage ---
+// ==========================
 
-        // Check dimensions (throw if cols have different dimensions)
-        for (auto row_it = init.begin(); row_it < init.end(); ++row_it)
-            if ((*row_it).end() - (*row_it).begin() != this->_cols)
-                throw std::invalid_argument("Initializer list dimensions don't match.");
+// Enumerable thread-local storage, similar to 'tbb::enumerable_thread_specific'. Every pool thread gets its own
+// lazily constructed value in a slot padded to a cache line & indexed by the worker index, so 'local()' needs no
+// synchronization on the hot path. Threads that don't belong to the pool fall back onto a mutex-protected map
+// keyed by thread id. Pool notifies the storage whenever its thread count changes, slots of the removed workers
+// are kept if they hold a value so nothing gets lost before the final combine.
 
-        // Copy elements
-        for (size_type i = 0; i < this->rows(); ++i)
-            for (size_type j = 0; j < this->cols(); ++j) this->operator()(i, j) = (init.begin()[i]).begin()[j];
-    }
+template <class T>
+class PerWorker {
+    ThreadPool* pool;
+    std::size_t observer_id;
 
-    // Init-with-data
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONTAINER)
-    explicit GenericTensor(size_type rows, size_type cols, size_type row_stride, size_type col_stride,
-                           pointer data_ptr) noexcept {
-        this->_rows       = rows;
-        this->_cols       = cols;
-        this->_row_stride = row_stride;
-        this->_col_stride = col_stride;
-        this->_data       = std::move(decltype(this->_data)(data_ptr));
-    }
+    std::function<T()>                     factory;
+    std::vector<Padded<std::optional<T>>>  worker_slots; // only resized while the pool has no workers
+    std::unordered_map<std::thread::id, T> external_slots;
+    std::mutex                             external_slots_mutex;
 
-    // - Strided Matrix View -
+    void resize(std::size_t count) {
+        std::size_t used = 0;
+        for (std::size_t i = 0; i < this->worker_slots.size(); ++i)
+            if (this->worker_slots[i].value) used = i + 1;
 
-    // Init-from-data
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::VIEW)
-    explicit GenericTensor(size_type rows, size_type cols, size_type row_stride, size_type col_stride,
-                           pointer data_ptr) {
-        this->_rows       = rows;
-        this->_cols       = cols;
-        this->_row_stride = row_stride;
-        this->_col_stride = col_stride;
-        this->_data       = data_ptr;
+        this->worker_slots.resize(std::max(count, used));
     }
 
-    // Init-from-tensor (any tensor of the same API type)
-    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::VIEW)>
-    GenericTensor(GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
-                                other_checking, other_layout>& other) {
-        this->_rows       = other.rows();
-        this->_cols       = other.cols();
-        this->_row_stride = other.row_stride();
-        this->_col_stride = other.col_stride();
-        this->_data       = other.data();
+public:
+    explicit PerWorker(ThreadPool& pool) : PerWorker(pool, [] { return T{}; }) {}
+
+    template <class F, require<std::is_invocable_r_v<T, F&>> = true>
+    PerWorker(ThreadPool& pool, F factory) : pool(&pool), factory(std::move(factory)) {
+        this->observer_id = this->pool->add_resize_observer([this](std::size_t count) { this->resize(count); });
     }
 
-    // - Const Strided Matrix View -
+    PerWorker(); // uses global thread pool, defined after it
 
-    // Init-from-data
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::STRIDED && ownership == Ownership::CONST_VIEW)
-    explicit GenericTensor(size_type rows, size_type cols, size_type row_stride, size_type col_stride,
-                           const_pointer data_ptr) {
-        this->_rows       = rows;
-        this->_cols       = cols;
-        this->_row_stride = row_stride;
-        this->_col_stride = col_stride;
-        this->_data       = data_ptr;
+    template <class F, require<std::is_invocable_r_v<T, F&>> = true>
+    explicit PerWorker(F factory); // uses global thread pool, defined after it
+
+    PerWorker(const PerWorker&)            = delete;
+    PerWorker(PerWorker&&)                 = delete;
+    PerWorker& operator=(const PerWorker&) = delete;
+    PerWorker& operator=(PerWorker&&)      = delete;
+
+    ~PerWorker() { this->pool->remove_resize_observer(this->observer_id); }
+
+    // Returns the value of the current thread, it gets constructed by the factory on the first access
+    [[nodiscard]] T& local() {
+        const std::size_t index = ws_this_thread::worker_index;
+
+        if (ws_this_thread::thread_pool_ptr == this->pool && index < this->worker_slots.size()) {
+            std::optional<T>& slot = this->worker_slots[index].value;
+            if (!slot) slot.emplace(this->factory());
+            return *slot;
+        }
+
+        const std::scoped_lock external_slots_lock(this->external_slots_mutex);
+
+        const std::thread::id id = std::this_thread::get_id();
+
+        auto it = this->external_slots.find(id);
+        if (it == this->external_slots.end()) it = this->external_slots.emplace(id, this->factory()).first;
+        return it->second; // references to the map values are stable
     }
 
-    // Init-from-tensor (any tensor of the same API type)
-    template <Ownership other_ownership, Checking other_checking, Layout other_layout,
-              utl_mvl_require(dimension == Dimension::MATRIX && type == Type::STRIDED &&
-                              ownership == Ownership::CONST_VIEW)>
-    GenericTensor(const GenericTensor<value_type, self::params::dimension, self::params::type, other_ownership,
-                                      other_checking, other_layout>& other) {
-        this->_rows       = other.rows();
-        this->_cols       = other.cols();
-        this->_row_stride = other.row_stride();
-        this->_col_stride = other.col_stride();
-        this->_data       = other.data();
+    // Invokes 'f(value)' for every constructed value, shouldn't be called concurrently with 'local()'
+    template <class F>
+    void for_each(F&& f) {
+        for (auto& slot : this->worker_slots)
+            if (slot.value) f(*slot.value);
+
+        const std::scoped_lock external_slots_lock(this->external_slots_mutex);
+        for (auto& [id, value] : this->external_slots) f(value);
     }
 
-    // - Sparse Matrix / Sparse Matrix View / Sparse Matrix Const View -
+    // Folds all constructed values with a binary operation, returns a value made by the factory if there are none
+    template <class Op>
+    [[nodiscard]] T combine(Op&& op) {
+        std::optional<T> result;
+        this->for_each([&](T& value) {
+            if (result) result = op(*result, value);
+            else result = value;
+        });
+        return result ? std::move(*result) : this->factory();
+    }
 
-    // Init-from-data (copy)
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
-    explicit GenericTensor(size_type rows, size_type cols, const std::vector<sparse_entry_type>& data) {
-        this->_rows = rows;
-        this->_cols = cols;
-        this->insert_triplets(std::move(data));
+    // Number of constructed values
+    [[nodiscard]] std::size_t size() {
+        std::size_t count = 0;
+        this->for_each([&](T&) { ++count; });
+        return count;
     }
 
-    // Init-from-data (move)
-    utl_mvl_reqs(dimension == Dimension::MATRIX && type == Type::SPARSE)
-    explicit GenericTensor(size_type rows, size_type cols, std::vector<sparse_entry_type>&& data) {
-        this->_rows = rows;
-        this->_cols = cols;
-        this->rewrite_triplets(std::move(data));
+    // Destroys all values, they will be constructed again on the next access
+    void clear() {
+        for (auto& slot : this->worker_slots) slot.value.reset();
+
+        const std::scoped_lock external_slots_lock(this->external_slots_mutex);
+        this->external_slots.clear();
     }
 };
 
-// ===========================
-// --- Predefined Typedefs ---
-// ===========================
+// =======================
+// --- Partial results ---
+// =======================
 
-constexpr auto _default_checking        = Checking::NONE;
-constexpr auto _default_layout_dense_2d = Layout::RC;
+// Reductions accumulate results of each grain into a per-worker slot padded to a cache line, which means there is
+// no synchronization on the hot path, slots get combined by the calling thread once all grains are done. Threads
+// that don't belong to the backend can't use worker slots and fall back onto a shared mutex-protected slot, this
+// can't happen with a 'ThreadPool' backend, but custom backends might execute tasks on arbitrary threads.
 
-// - Dense 2D -
-template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
-using Matrix = GenericTensor<T, Dimension::MATRIX, Type::DENSE, Ownership::CONTAINER, checking, layout>;
+template <class T>
+class PartialResults {
+    std::vector<Padded<std::optional<T>>> worker_slots;
+    std::optional<T>                      shared_slot;
+    std::mutex                            shared_slot_mutex;
+    const void*                           pool;
 
-template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
-using MatrixView = GenericTensor<T, Dimension::MATRIX, Type::DENSE, Ownership::VIEW, checking, layout>;
+    template <class Op>
+    static void merge_into(std::optional<T>& slot, T&& partial, Op& op) {
+        if (slot) *slot = op(*slot, partial);
+        else slot = std::move(partial);
+    }
 
-template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
-using ConstMatrixView = GenericTensor<T, Dimension::MATRIX, Type::DENSE, Ownership::CONST_VIEW, checking, layout>;
+public:
+    PartialResults(std::size_t worker_count, const void* pool) : worker_slots(worker_count), pool(pool) {}
 
-// - Strided 2D -
-template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
-using StridedMatrix = GenericTensor<T, Dimension::MATRIX, Type::STRIDED, Ownership::CONTAINER, checking, layout>;
+    template <class Op>
+    void accumulate(T&& partial, Op& op) {
+        const std::optional<void*>       thread_pool  = this_thread::get_pool();
+        const std::optional<std::size_t> thread_index = this_thread::get_index();
 
-template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
-using StridedMatrixView = GenericTensor<T, Dimension::MATRIX, Type::STRIDED, Ownership::VIEW, checking, layout>;
+        const bool is_backend_thread = thread_pool && *thread_pool == this->pool && thread_index &&
+                                       *thread_index < this->worker_slots.size();
 
-template <class T, Checking checking = _default_checking, Layout layout = _default_layout_dense_2d>
-using ConstStridedMatrixView =
-    GenericTensor<T, Dimension::MATRIX, Type::STRIDED, Ownership::CONST_VIEW, checking, layout>;
+        if (is_backend_thread) {
+            merge_into(this->worker_slots[*thread_index].value, std::move(partial), op);
+        } else {
+            const std::scoped_lock shared_slot_lock(this->shared_slot_mutex);
+            merge_into(this->shared_slot, std::move(partial), op);
+        }
+    }
 
-// - Sparse 2D -
-template <class T, Checking checking = _default_checking>
-using SparseMatrix = GenericTensor<T, Dimension::MATRIX, Type::SPARSE, Ownership::CONTAINER, checking, Layout::SPARSE>;
+    template <class Op>
+    T combine(T init, Op& op) {
+        for (auto& slot : this->worker_slots)
+            if (slot.value) init = op(init, *slot.value);
+        if (this->shared_slot) init = op(init, *this->shared_slot);
+        return init;
+    }
+};
 
-template <class T, Checking checking = _default_checking>
-using SparseMatrixView = GenericTensor<T, Dimension::MATRIX, Type::SPARSE, Ownership::VIEW, checking, Layout::SPARSE>;
+// ====================
+// --- Cancellation ---
+// ====================
 
-template <class T, Checking checking = _default_checking>
-using ConstSparseMatrixView =
-    GenericTensor<T, Dimension::MATRIX, Type::SPARSE, Ownership::CONST_VIEW, checking, Layout::SPARSE>;
+// Cancellation token is a shared flag, similar to 'std::stop_token' from C++20, copies of the token refer to
+// the same state. Loops that were given a token check it before every block (or every iteration for iteration
+// overloads), this way blocks that are queued but haven't started yet turn into no-ops once the token gets
+// cancelled. Blocks that are already running can poll the token themselves.
 
-// ==================
-// --- Formatters ---
-// ==================
+class CancellationToken {
+    std::shared_ptr<std::atomic<bool>> cancelled = std::make_shared<std::atomic<bool>>(false);
 
-namespace format {
+public:
+    void cancel() noexcept { this->cancelled->store(true, std::memory_order_release); }
 
-// --- Implementation ---
-// ----------------------
+    [[nodiscard]] bool is_cancelled() const noexcept { return this->cancelled->load(std::memory_order_acquire); }
+};
 
-// The "header" of all human-readable formats that displays
-// some meta info with tensor type and dimensions.
-template <utl_mvl_tensor_arg_defs>
-[[nodiscard]] std::string _tensor_meta_string(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
-    std::string buffer;
+template <class F>
+struct SkipIfCancelled {
+    CancellationToken token;
+    F                 f;
 
-    if constexpr (_type == Type::DENSE) buffer += "Dense";
-    if constexpr (_type == Type::STRIDED) buffer += "Strided";
-    if constexpr (_type == Type::SPARSE) buffer += "Sparse";
-    if constexpr (_dimension == Dimension::VECTOR) buffer += stringify(" vector [size = ", tensor.size(), "]:\n");
-    if constexpr (_dimension == Dimension::MATRIX)
-        buffer += stringify(" matrix [size = ", tensor.size(), "] (", tensor.rows(), " x ", tensor.cols(), "):\n");
+    template <class... Args, require_invocable<const F&, Args...> = true>
+    void operator()(Args... args) const {
+        if (!this->token.is_cancelled()) this->f(args...);
+    }
+}; // wraps block / iteration function of the loop, stays invocable with the same arguments as 'F'
 
-    return buffer;
-}
+template <class T>
+using require_no_iter = require<!has_iter<T>::value && !has_const_iter<T>::value>;
+// distinguishes ranges from containers in the cancellable loop overloads
 
-// Human-readable formats automatically collapse matrices
-// that are too  large to be reasonably parsed by a human
-constexpr std::size_t _max_displayed_flat_size = 30 * 30;
+// ================
+// --- Pipeline ---
+// ================
 
-template <utl_mvl_tensor_arg_defs>
-[[nodiscard]] std::string _as_too_large(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor) {
-    return stringify(_tensor_meta_string(tensor), "  <hidden due to large size>\n");
+// Token-based pipeline, similar to 'tbb::parallel_pipeline()'. Every item produced by the source becomes a token
+// that carries it through the stages, token is processed by a single task that runs as many stages as it can
+// inline. When a serial stage is busy (or it's not the turn of the token yet) the token gets parked in the stage
+// and the task ends, whichever task releases the stage resumes the next parked token as a new task, this way
+// waiting for a stage never blocks a thread. Once the number of tokens in flight reaches the limit, the source
+// stops producing until some token leaves the pipeline, which bounds the amount of buffered items.
+
+enum class StageMode { parallel, serial_in_order, serial_out_of_order };
+
+template <class F>
+struct Stage {
+    StageMode mode;
+    F         f;
+};
+
+template <class F>
+Stage<std::decay_t<F>> stage(StageMode mode, F&& f) {
+    return {mode, std::forward<F>(f)};
 }
 
-// Generic method to do "dense matrix print" with given delimiters.
-// Cuts down on repetition since a lot of formats only differ in the delimiters used.
-template <class T, Type type, Ownership ownership, Checking checking, Layout layout, class Func>
-[[nodiscard]] std::string
-_generic_dense_format(const GenericTensor<T, Dimension::MATRIX, type, ownership, checking, layout>& tensor,     //
-                      std::string_view                                                              begin,      //
-                      std::string_view                                                              row_begin,  //
-                      std::string_view                                                              col_delim,  //
-                      std::string_view                                                              row_end,    //
-                      std::string_view                                                              row_delim,  //
-                      std::string_view                                                              end,        //
-                      Func                                                                          stringifier //
-) {
-    if (tensor.empty()) return (std::string() += begin) += end;
+// Input types of every stage as a tuple, the source produces 'In', every stage consumes the output of the previous one
+template <class In, class... Fs>
+struct stage_inputs {
+    using type = std::tuple<>;
+};
 
-    Matrix<std::string> strings(tensor.rows(), tensor.cols());
+template <class In, class F, class... Fs>
+struct stage_inputs<In, F, Fs...> {
+    using next = std::invoke_result_t<F&, In&&>;
+    using rest = typename stage_inputs<next, Fs...>::type;
+    using type = decltype(std::tuple_cat(std::declval<std::tuple<In>>(), std::declval<rest>()));
+};
 
-    // Stringify
-    if constexpr (type == Type::SPARSE) strings.fill("-");
-    tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) { strings(i, j) = stringifier(elem); });
-    // this takes care of sparsity, if the matrix is sparse we prefill 'strings' with "-" and then fill appropriate
-    // {i, j} with actual stringified values from the tensor. For dense matrices no unnecessary work is done.
+template <class T>
+struct SerialStageState {
+    bool                     busy = false;
+    std::size_t              next = 0; // sequence number of the next token, only used by in-order stages
+    std::map<std::size_t, T> parked;   // tokens waiting for the stage, ordered by their sequence number
+};
 
-    // Get column widths - we want matrix to format nice and aligned
-    std::vector<std::size_t> column_widths(strings.cols(), 0);
-    for (std::size_t i = 0; i < strings.rows(); ++i)
-        for (std::size_t j = 0; j < strings.cols(); ++j)
-            column_widths[j] = std::max(column_widths[j], strings(i, j).size());
+template <class Tuple>
+struct serial_stage_states;
 
-    // Format with proper alignment
-    std::string buffer(begin);
-    for (std::size_t i = 0; i < strings.rows(); ++i) {
-        buffer += row_begin;
-        for (std::size_t j = 0; j < strings.cols(); ++j) {
-            if (strings(i, j).size() < column_widths[j]) buffer.append(column_widths[j] - strings(i, j).size(), ' ');
-            buffer += strings(i, j);
-            if (j + 1 < strings.cols()) buffer += col_delim;
-        }
-        buffer += row_end;
-        if (i + 1 < strings.rows()) buffer += row_delim;
-    }
-    buffer += end;
+template <class... Ts>
+struct serial_stage_states<std::tuple<Ts...>> {
+    using type = std::tuple<SerialStageState<Ts>...>;
+};
 
-    return buffer;
-}
+// Runs tasks submitted from arbitrary threads & waits for all of them, thread pool uses a task group,
+// other backends fall back onto recursive futures. Every task submits its children before it finishes,
+// so once every future in the list is done there can be no more pending tasks.
+template <class Backend>
+class TaskTracker {
+    using future_type = typename Backend::template future_type<>;
 
-// --- Human-readable formats ---
-// ------------------------------
+    Backend&                backend;
+    std::deque<future_type> futures; // unlike a vector, deque doesn't invalidate references when growing
+    std::mutex              mutex;
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_vector(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
+public:
+    explicit TaskTracker(Backend& backend) : backend(backend) {}
 
-    std::string buffer = _tensor_meta_string(tensor);
+    template <class F>
+    void run(F&& f) {
+        future_type future = this->backend.awaitable_task(std::forward<F>(f));
 
-    buffer += "  { ";
-    for (std::size_t idx = 0; idx < tensor.size(); ++idx) {
-        buffer += stringifier(tensor[idx]);
-        if (idx + 1 < tensor.size()) buffer += ", ";
+        const std::scoped_lock lock(this->mutex);
+        this->futures.push_back(std::move(future));
     }
-    buffer += " }\n";
 
-    return buffer;
-}
+    void wait() {
+        for (std::size_t i = 0;; ++i) {
+            future_type* future;
+            {
+                const std::scoped_lock lock(this->mutex);
+                if (i == this->futures.size()) break;
+                future = &this->futures[i];
+            }
+            future->wait();
+        }
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_dictionary(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
-                                        Func                                          stringifier = Func()) {
-    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
+        for (auto& future : this->futures) future.get(); // rethrows the first exception
+    }
+};
 
-    std::string buffer = _tensor_meta_string(tensor);
+template <>
+class TaskTracker<ThreadPool> : public TaskGroup {
+public:
+    explicit TaskTracker(ThreadPool& pool) : TaskGroup(pool) {}
+};
 
-    if constexpr (_dimension == Dimension::MATRIX) {
-        tensor.for_each([&](const T& elem, std::size_t i, std::size_t j) {
-            buffer += stringify("(", i, ", ", j, ") = ");
-            buffer += stringifier(elem);
-            buffer += '\n';
-        });
-    } else {
-        tensor.for_each([&](const T& elem, std::size_t i) {
-            buffer += stringify("(", i, ") = ");
-            buffer += stringifier(elem);
-            buffer += '\n';
-        });
-    }
+template <class Backend, class Source, class... Fs>
+class Pipeline {
+    using item_type = typename std::invoke_result_t<Source&>::value_type; // source returns 'std::optional<>'
+    using inputs    = typename stage_inputs<item_type, Fs...>::type;
 
-    return buffer;
-}
+    template <std::size_t K>
+    using input_t = std::tuple_element_t<K, inputs>;
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_matrix(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    if (tensor.size() > _max_displayed_flat_size) return _as_too_large(tensor);
+    constexpr static std::size_t stage_count = sizeof...(Fs);
 
-    return _generic_dense_format(tensor, _tensor_meta_string(tensor), "  [ ", " ", " ]\n", "", "", stringifier);
-}
+    Source&                   source;
+    std::tuple<Stage<Fs>&...> stages;
+    std::size_t               max_tokens;
 
-// --- Export formats ---
-// ----------------------
+    std::mutex                                  mutex; // guards everything below
+    typename serial_stage_states<inputs>::type serial_states;
+    std::size_t                                 produced     = 0;
+    std::size_t                                 in_flight    = 0;
+    bool                                        input_active = false;
+    bool                                        input_done   = false;
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_raw(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "", "", " ", "\n", "", "", stringifier);
-}
+    std::atomic<bool>    failed{false};
+    TaskTracker<Backend> tasks;
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_csv(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "", "", ", ", "\n", "", "", stringifier);
-}
+    template <class F>
+    void spawn(F&& f) {
+        this->tasks.run([this, f = std::forward<F>(f)]() mutable {
+            if (this->failed.load(std::memory_order_relaxed)) return; // failed pipeline discards remaining tokens
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_json(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "[\n", "    [ ", ", ", " ]", ",\n", "\n]\n", stringifier);
-}
+            try {
+                f();
+            } catch (...) {
+                this->failed.store(true, std::memory_order_relaxed);
+                throw;
+            }
+        });
+    }
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_mathematica(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor,
-                                         Func                                          stringifier = Func()) {
-    return _generic_dense_format(tensor, "{\n", "    { ", ", ", " }", ",\n", "\n}\n", stringifier);
-}
+    // Source is serial, there is only ever one input task, which spawns the next one before processing its token
+    void input() {
+        std::optional<item_type> item = this->source();
+
+        std::size_t sequence = 0;
+        bool        more     = false;
+        {
+            const std::scoped_lock lock(this->mutex);
+
+            if (!item) {
+                this->input_done   = true;
+                this->input_active = false;
+                return;
+            }
 
-template <utl_mvl_tensor_arg_defs, class Func = default_stringifier<T>>
-[[nodiscard]] std::string as_latex(const GenericTensor<utl_mvl_tensor_arg_vals>& tensor, Func stringifier = Func()) {
-    return _generic_dense_format(tensor, "\\begin{pmatrix}\n", "  ", " & ", " \\\\\n", "", "\\end{pmatrix}\n",
-                                 stringifier);
-}
+            sequence           = this->produced++;
+            more               = ++this->in_flight < this->max_tokens;
+            this->input_active = more; // otherwise input gets resumed by the next token to leave the pipeline
+        }
 
+        if (more) this->spawn([this] { this->input(); });
 
-} // namespace format
+        this->process<0>(sequence, std::move(*item));
+    }
 
-// ================================
-// --- Linear algebra operators ---
-// ================================
+    void finish_token() {
+        bool resume_input = false;
+        {
+            const std::scoped_lock lock(this->mutex);
 
-// --- Unary operator implementation ----
-// --------------------------------------
+            --this->in_flight;
+            resume_input       = !this->input_active && !this->input_done;
+            this->input_active = this->input_active || resume_input;
+        }
 
-template <class L, class Op,                                                    //
-          _is_tensor_enable_if<L> = true,                                       //
-          class return_type       = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_unary_op(L&& left, Op&& op) {
-    using reference = typename std::decay_t<L>::reference;
+        if (resume_input) this->spawn([this] { this->input(); });
+    }
 
-    // Reuse r-value if possible
-    return_type res = std::forward<L>(left);
+    template <std::size_t K>
+    void process(std::size_t sequence, input_t<K>&& value) {
+        if (this->failed.load(std::memory_order_relaxed)) return;
 
-    // '.for_each()' takes care of possible sparsity
-    res.for_each([&](reference elem) { elem = op(std::move(elem)); });
+        const StageMode mode = std::get<K>(this->stages).mode;
 
-    return res;
-}
+        if (mode == StageMode::parallel) return this->execute<K>(sequence, std::move(value));
 
-// --- Unary operator API ----
-// ---------------------------
+        // Serial stage, token either acquires it or gets parked until its turn
+        {
+            const std::scoped_lock lock(this->mutex);
 
-// std <functional> has function objects for every operator possible,
-// except unary '+' for some reason, which is why we have to implement it ourselves.
-// This is the exact same thing as 'std::negate<>' but for operator '+'.
-template <class T>
-struct _unary_plus_functor {
-    constexpr T operator()(const T& lhs) const { return +lhs; }
-};
+            auto& state = std::get<K>(this->serial_states);
 
-template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
-          _has_unary_op_plus_enable_if<value_type> = true>
-auto operator+(L&& left) {
-    return apply_unary_op(std::forward<L>(left), _unary_plus_functor<value_type>());
-}
+            if (state.busy || (mode == StageMode::serial_in_order && sequence != state.next)) {
+                state.parked.emplace(sequence, std::move(value));
+                return;
+            }
 
-template <class L, _is_tensor_enable_if<L> = true, class value_type = typename std::decay_t<L>::value_type,
-          _has_unary_op_minus_enable_if<value_type> = true>
-auto operator-(L&& left) {
-    return apply_unary_op(std::forward<L>(left), std::negate<value_type>());
-}
+            state.busy = true;
+        }
 
-// --- Binary operator implementation ---
-// --------------------------------------
+        this->execute_serial<K>(sequence, std::move(value));
+    }
 
-// Doing things "in a dumb but simple way" would be to just have all operators take arguments as const-refs and
-// return a copy, however we can speed things up a lot by properly using perfect forwarding, which would reuse
-// r-values if possible to avoid allocation. Doing so would effectively change something like this:
-//    res = A + B - C - D + E
-// from 5 (!) copies to only 1, since first operator will create an r-value that gets propagated and reused by
-// all others. This however introduces it's own set of challenges since instead of traditional overloading we
-// now have to resort to SFINAE-driven imitation of it and carefully watch what we restrict.
-//
-// So here are the key points of implementing all of this:
-//
-//    1. All unary and binary operators ('-', '+', '*' and etc.) can benefit from reusing r-values and moving
-//       one of the arguments into the result rather than copy. This can only happen to CONTAINER args that
-//       correspond to the return type.
-//
-//    2. Binary operators have following return types for different tensors:
-//       - (1)  dense +  dense =>  dense      (complexity O(N^2))
-//       - (2)  dense + sparse =>  dense      (complexity O(N)  )
-//       - (3) sparse +  dense =>  dense      (complexity O(N)  )
-//       - (4) sparse + sparse => sparse      (complexity O(N)  )
-//       return types inherit option arguments from the lhs and always have 'ownership == CONTAINER',
-//       while argument can be anything, including views. To implement the list above efficiently there
-//       is no other way but to make 4 separate implementation, tailored for each level of sparsity.
-//
-//    3. All binary operators can be written in a generic form like 'apply_binary_operator(A, B, op)'
-//       and specialized with operator functors froms std <functional>. All we need for individual
-//       operators is to figure out correct boilerplate with perfect forwarding. "Overload resolution"
-//       will be performed by the 'apply_operator' method.
-//
-// It's a good question whether to threat binary '*' as element-wise product (which would be in line with other
-// operators) or a matrix product, but in the end it seems doing it element-wise would be too confusing for the
-// user, so we leave '*' as a matrix product and declare element-wise product as a function 'elementwise_product()'
-// since no existing operators seem suitable for such overload.
+    // Runs an acquired serial stage, after that hands the stage over to the next suitable parked token
+    template <std::size_t K>
+    void execute_serial(std::size_t sequence, input_t<K>&& value) {
+        const StageMode mode = std::get<K>(this->stages).mode;
 
-// (1)  dense +  dense =>  dense
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
-          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+        const auto release = [&] {
+            typename std::map<std::size_t, input_t<K>>::node_type next;
+            {
+                const std::scoped_lock lock(this->mutex);
 
-    using reference = typename std::decay_t<L>::reference;
-    using size_type = typename std::decay_t<L>::size_type;
+                auto& state = std::get<K>(this->serial_states);
 
-    return_type res;
+                ++state.next;
 
-    // Reuse r-value arguments if possible while preserving the order of operations
-    if constexpr (std::is_rvalue_reference_v<L> && std::decay_t<L>::params::ownership == Ownership::CONTAINER) {
-        res = std::forward<L>(left);
-        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(std::move(elem), right(i, j)); });
-    } else if constexpr (std::is_rvalue_reference_v<R> && std::decay_t<R>::params::ownership == Ownership::CONTAINER) {
-        res = std::forward<R>(right);
-        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), std::move(elem)); });
-    } else {
-        res = return_type(left.rows(), left.cols());
-        res.for_each([&](reference elem, size_type i, size_type j) { elem = op(left(i, j), right(i, j)); });
-    }
+                const bool has_next = !state.parked.empty() && (mode == StageMode::serial_out_of_order ||
+                                                                state.parked.begin()->first == state.next);
 
-    return res;
-}
+                if (has_next) next = state.parked.extract(state.parked.begin());
+                else state.busy = false;
+            }
 
-// (2)  dense + sparse =>  dense
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_nonsparse_tensor_enable_if<L>                 = true,                                       //
-          _is_sparse_tensor_enable_if<R>                    = true,                                       //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+            // Stage stays busy, it is handed over to the parked token directly
+            if (next)
+                this->spawn([this, next_sequence = next.key(), next_value = std::move(next.mapped())]() mutable {
+                    this->execute_serial<K>(next_sequence, std::move(next_value));
+                });
+        };
 
-    using reference = typename std::decay_t<L>::reference;
-    using size_type = typename std::decay_t<L>::size_type;
+        this->execute<K>(sequence, std::move(value), release);
+    }
 
-    // Reuse r-value if possible
-    return_type res = std::forward<L>(left);
+    template <std::size_t K, class Release = void (*)()>
+    void execute(std::size_t sequence, input_t<K>&& value, Release&& release = [] {}) {
+        auto& f = std::get<K>(this->stages).f;
 
-    // '.for_each()' to only iterate sparse elements
-    right.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(std::move(res(i, j)), elem); });
+        if constexpr (K + 1 < stage_count) {
+            input_t<K + 1> result = std::invoke(f, std::move(value));
+            release();
+            this->process<K + 1>(sequence, std::move(result));
+        } else {
+            std::invoke(f, std::move(value));
+            release();
+            this->finish_token();
+        }
+    }
 
-    return res;
-}
+public:
+    Pipeline(Backend& backend, std::size_t max_tokens, Source& source, Stage<Fs>&... stages)
+        : source(source), stages(stages...), max_tokens(max_size(max_tokens, 1)), tasks(backend) {}
 
-// (3) sparse +  dense =>  dense
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_sparse_tensor_enable_if<L>                    = true,                                       //
-          _is_nonsparse_tensor_enable_if<R>                 = true,                                       //
-          class return_type                                 = typename std::decay_t<R>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+    void run() {
+        this->input_active = true;
+        this->spawn([this] { this->input(); });
+        this->tasks.wait();
+    }
+};
 
-    using reference = typename std::decay_t<R>::reference;
-    using size_type = typename std::decay_t<R>::size_type;
+// =================
+// --- Scheduler ---
+// =================
 
-    // Reuse r-value if possible
-    return_type res = std::forward<R>(right);
+// There is a ton of boilerplate since we need a whole bunch of convenience overloads
+// (ranges / index ranges / containers, blocked functions / iteration functions, etc.),
+// but conceptually it's all quite simple we end up with 2 overloads for tasks,
+// 6+6+3=15 overloads for parallel-for and 4+4+2=10 overloads for reduce
 
-    // '.for_each()' to only iterate sparse elements
-    left.for_each([&](reference elem, size_type i, size_type j) { res(i, j) = op(elem, std::move(res(i, j))); });
+#define utl_parallel_assert_message                                                                                    \
+    "Awaitable loops require recursive task support from the 'future_type' of 'Scheduler' backend. "                   \
+    "Future can signal such support by  providing a 'using is_recursive = void' member typedef."
+// 'static_assert()' only supports string literals, cannot use constexpr variable here, assert itself
+// shouldn't be included in the macro as it makes error messages uglier due to macro expansion
 
-    return res;
-}
+#define utl_parallel_random_access_message                                                                             \
+    "Scans, sorts & deterministic reductions require a 'Range' with random-access iterators."
 
-// (4) sparse + sparse => sparse
-template <class L, class R, class Op,                                                                     //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                       //
-          _is_sparse_tensor_enable_if<L>                    = true,                                       //
-          _is_sparse_tensor_enable_if<R>                    = true,                                       //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection //
-          >
-return_type apply_binary_op(L&& left, R&& right, Op&& op) {
-    utl_mvl_assert(left.rows() == right.rows());
-    utl_mvl_assert(left.cols() == right.cols());
+template <class Backend = ThreadPool>
+struct Scheduler {
 
-    using sparse_entry = typename std::decay_t<L>::sparse_entry_type;
-    using value_type   = typename std::decay_t<L>::value_type;
+    // --- Backend ---
+    // ---------------
 
-    std::vector<sparse_entry> res_triplets;
-    res_triplets.reserve(std::max(left.size(), right.size()));
-    // not enough when matrices have different sparsity patterns, but good enough for initial guess
+    Backend backend; // underlying thread pool
 
-    std::size_t i = 0, j = 0;
+    template <class T = void>
+    using future_type = typename Backend::template future_type<T>;
 
-    // Merge sparsity patterns
-    while (i < left.size() && j < right.size()) {
-        // Entry present only in lhs sparsity pattern
-        if (left._data[i] < right._data[j]) {
-            res_triplets.emplace_back(
-                _apply_binary_op_to_sparse_entry_and_value(std::forward<L>(left)._data[i++], value_type{}, op));
-        }
-        // Entry present only in rhs sparsity pattern
-        else if (left._data[i] > right._data[j]) {
-            res_triplets.emplace_back(
-                _apply_binary_op_to_value_and_sparse_entry(value_type{}, std::forward<R>(right)._data[j++], op));
-        }
-        // Entry present in both sparsity patterns
-        else {
-            res_triplets.emplace_back(_apply_binary_op_to_sparse_entries(std::forward<L>(left)._data[i++],
-                                                                         std::forward<R>(right)._data[j++], op));
-        }
-    }
-    // Copy the rest of lhs (if needed)
-    while (i < left.size()) res_triplets.emplace_back(std::forward<L>(left)._data[i++]);
-    // Copy the rest of rhs (if needed)
-    while (j < right.size()) res_triplets.emplace_back(std::forward<R>(right)._data[j++]);
+    template <class... Args>
+    explicit Scheduler(Args&&... args) : backend(std::forward<Args>(args)...) {}
 
-    return return_type(left.rows(), left.cols(), std::move(res_triplets));
-}
+    // --- Task API ---
+    // ----------------
 
-// --- Binary operator API ---
-// ---------------------------
+    template <class F, class... Args>
+    void detached_task(F&& f, Args&&... args) {
+        this->backend.detached_task(std::forward<F>(f), std::forward<Args>(args)...);
+    }
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_plus_enable_if<value_type> = true>
-auto operator+(L&& left, R&& right) {
-    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::plus<value_type>());
-}
+    template <class F, class... Args, class R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    future_type<R> awaitable_task(F&& f, Args&&... args) {
+        return this->backend.awaitable_task(std::forward<F>(f), std::forward<Args>(args)...);
+    }
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type = typename std::decay_t<L>::value_type, _has_binary_op_minus_enable_if<value_type> = true>
-auto operator-(L&& left, R&& right) {
-    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::minus<value_type>());
-}
+    template <class F, class... Args>
+    void detached_task(Priority priority, F&& f, Args&&... args) {
+        this->backend.detached_task(priority, std::forward<F>(f), std::forward<Args>(args)...);
+    }
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type                                = typename std::decay_t<L>::value_type,
-          _has_binary_op_multiplies_enable_if<value_type> = true>
-auto elementwise_product(L&& left, R&& right) {
-    return apply_binary_op(std::forward<L>(left), std::forward<R>(right), std::multiplies<value_type>());
-}
+    template <class F, class... Args, class R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+    future_type<R> awaitable_task(Priority priority, F&& f, Args&&... args) {
+        return this->backend.awaitable_task(priority, std::forward<F>(f), std::forward<Args>(args)...);
+    }
 
-// --- Augmented assignment operator API ---
-// -----------------------------------------
+    // --- Fork-join API ---
+    // ---------------------
 
-// These can just reuse corresponding binary operators while 'std::move()'ing lhs to avoid copying.
+    // Runs all callables in parallel & waits for them, first one gets executed inline by the calling thread
+    template <class F, class... Fs>
+    void invoke(F&& f, Fs&&... fs) {
+        if constexpr (std::is_same_v<Backend, ThreadPool>) {
+            TaskGroup group(this->backend);
+            (group.run(std::forward<Fs>(fs)), ...);
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type = typename std::decay_t<L>::value_type, _has_assignment_op_plus_enable_if<value_type> = true>
-L& operator+=(L&& left, R&& right) {
-    return (left = std::move(left) + right);
-}
+            try {
+                std::forward<F>(f)();
+            } catch (...) {
+                group.wait(); // children may reference the stack of the caller, can't unwind before they're done
+                throw;
+            }
 
-template <class L, class R, _are_tensors_with_same_value_type_enable_if<L, R> = true,
-          class value_type                               = typename std::decay_t<L>::value_type,
-          _has_assignment_op_minus_enable_if<value_type> = true>
-L& operator-=(L&& left, R&& right) {
-    return (left = std::move(left) - right);
-}
+            group.wait();
+        }
+        // Other backends don't expose their internals, fall back onto recursive futures
+        else {
+            static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
 
-// --- Matrix multiplication ---
-// -----------------------------
+            std::array<future_type<>, sizeof...(Fs)> futures = {this->awaitable_task(std::forward<Fs>(fs))...};
 
-// Just like with binary operators, we run into the need to have 4 different implementations:
-//    - (1)  dense +  dense =>  dense      (complexity O(N^3))
-//    - (2)  dense + sparse =>  dense      (complexity O(N^2))
-//    - (3) sparse +  dense =>  dense      (complexity O(N^2))
-//    - (4) sparse + sparse => sparse      (complexity O(N)  )
-//
-// Would be gread to implement proper "smart" GEMM and CRS-multiplication for sparse matrices, however that adds
-// an absolutely huge amount of complexity for x1.5-x3 speedup on matrix multiplication, which is already kind of
-// an afterthought provided here mainly for convenience and not for actual number crunching usage.
-//
-// We do however use some basic optimizations like loop reordering / temporaries / blocking to have a sensible baseline,
-// we properly account for sparsity which brings multiplication with sparse matrices from O(N^3) down to O(N^2) / O(N).
+            try {
+                std::forward<F>(f)();
+            } catch (...) {
+                for (const auto& future : futures) future.wait();
+                throw;
+            }
 
-// (1)  dense +  dense =>  dense
-//
-// From benchmarks 1D blocking over "k" with a decently large block size seems to be more reliable than 2D/3D blocking.
-// When measuring varying matrix sizes and datatypes, for matrices with less than ~1k rows/cols (aka matrices that fully
-// fit into L2 cache) 1D blocking doesn't  seem to have much of an effect (positive or negative), while 2D/3D has often
-// lead to a slowdown for specific matrix  sizes. At large enough sizes blocking leads to a noticeable (~2x) speedup.
-// Note that this is all very hardware-specific, so it's difficult to make a truly generic judgement. In general,
-// blocking seems to be worth it.
-//
-// Note that unlike other binary operators, here there is no possible benefit in r-value reuse.
-//
-template <class L, class R,                                                                                //
-          _are_tensors_with_same_value_type_enable_if<L, R> = true,                                        //
-          _is_nonsparse_tensor_enable_if<L>                 = true,                                        //
-          _is_nonsparse_tensor_enable_if<R>                 = true,                                        //
-          class value_type                                  = typename std::decay_t<L>::value_type,        //
-          class return_type                                 = typename std::decay_t<L>::owning_reflection, //
-          _has_binary_op_multiplies_enable_if<value_type>   = true,                                        //
-          _has_assignment_op_plus_enable_if<value_type>     = true                                         //
-          >
-return_type operator*(const L& left, const R& right) {
-    utl_mvl_assert(left.cols() == right.rows());
+            for (const auto& future : futures) future.wait();
+            for (auto& future : futures) future.get(); // rethrows exceptions of the children
+        }
+    }
 
-    using size_type = typename std::decay_t<L>::size_type;
+    // --- Parallel-for API ---
+    // ------------------------
 
-    const size_type N_i = left.rows(), N_k = left.cols(), N_j = right.cols();
-    // (N_i)x(N_k) * (N_k)x(N_j) => (N_i)x(N_j)
+    // - 'Range' overloads (6) -
 
-    constexpr size_type block_size_kk = 32;
+    template <class It, class F, require_invocable<F, It, It> = true> // blocked loop iteration overload
+    void detached_loop(Range<It> range, F&& f) {
+        // auto-partitioned pieces share state on the stack of a waiting caller, detached loops use a default grain
+        if (range.grain_size == auto_grain)
+            range.grain_size = default_grain_size(distance_size(range.begin, range.end));
 
-    return_type res(N_i, N_j, value_type{});
+        this->detached_blocks<It>(range, f);
+    }
 
-    for (size_type kk = 0; kk < N_k; kk += block_size_kk) {
-        const size_type k_extent = std::min(N_k, kk + block_size_kk);
-        // needed for matrices that aren't a multiple of block size
-        for (size_type i = 0; i < N_i; ++i) {
-            for (size_type k = kk; k < k_extent; ++k) {
-                const auto& r = left(i, k);
-                for (size_type j = 0; j < N_j; ++j) res(i, j) += r * right(k, j);
-            }
-        }
+    template <class It, class F, require_invocable<F, It> = true> // single loop iteration overload
+    void detached_loop(Range<It> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](It low, It high) { // combine individual index
+            for (It it = low; it != high; ++it) f(it);                   // calls into blocks and forward
+        }; // into a blocked loop iteration overload
+        this->detached_loop(range, std::move(iterate_block));
     }
 
-    return res;
-}
+    template <class It, class F, require_invocable<F, It, It> = true>
+    void blocking_loop(Range<It> range, F&& f) {
+        if (range.grain_size == auto_grain) {
+            // forward iterators can't be split on demand in O(1), they use a default grain instead
+            if constexpr (is_random_access_v<It>)
+                return this->auto_partitioned_loop(range.end - range.begin, [&](std::size_t low, std::size_t high) {
+                    f(range.begin + low, range.begin + high);
+                });
+            else range.grain_size = default_grain_size(distance_size(range.begin, range.end));
+        }
 
-// (2)  dense + sparse =>  dense
+        this->blocking_blocks<It>(range, f);
+    }
 
-// TODO:
+    template <class It, class F, require_invocable<F, It> = true>
+    void blocking_loop(Range<It> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](It low, It high) {
+            for (It it = low; it != high; ++it) f(it);
+        };
+        this->blocking_loop(range, std::move(iterate_block));
+    }
 
-// (3) sparse +  dense =>  dense
+    template <class It, class F, require_invocable<F, It, It> = true>
+    future_type<> awaitable_loop(Range<It> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
 
-// TODO:
+        auto submit_loop = [this, range, f = std::forward<F>(f)] { this->blocking_loop(range, f); };
+        return this->awaitable_task(std::move(submit_loop));
+        // to wait for multiple tasks we need a vector of futures, since logically we want API to return regular
+        // 'future_type<>' rather than some composite construct, we can wrap block awaiting into another task
+        // that will "merge" all those futures into a single one for the user, this requires recursive task
+        // support from the backend so it's provided conditionally
+    }
 
-// (4) sparse + sparse => sparse
+    template <class It, class F, require_invocable<F, It> = true>
+    future_type<> awaitable_loop(Range<It> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
 
-// TODO:
+        auto iterate_block = [f = std::forward<F>(f)](It low, It high) {
+            for (It it = low; it != high; ++it) f(it);
+        };
+        return this->awaitable_loop(range, std::move(iterate_block));
+    }
 
-// Clear out internal macros
-#undef utl_mvl_tensor_arg_defs
-#undef utl_mvl_tensor_arg_vals
-#undef utl_mvl_require
-#undef utl_mvl_reqs
+    // - 'IndexRange' overloads (6) -
 
-} // namespace utl::mvl
+    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
+    void detached_loop(IndexRange<Idx> range, F&& f) {
+        range.grain_size = resolve_grain_size(range.grain_size, range.last - range.first);
 
-#endif
-#endif // module utl::mvl
+        this->detached_blocks<Idx>(range, f);
+    }
 
+    template <class Idx, class F, require_invocable<F, Idx> = true>
+    void detached_loop(IndexRange<Idx> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](Idx low, Idx high) {
+            for (Idx i = low; i < high; ++i) f(i);
+        };
+        this->detached_loop(range, std::move(iterate_block));
+    }
 
+    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
+    void blocking_loop(IndexRange<Idx> range, F&& f) {
+        if (range.grain_size == auto_grain)
+            return this->auto_partitioned_loop(range.last - range.first, [&](std::size_t low, std::size_t high) {
+                f(static_cast<Idx>(range.first + low), static_cast<Idx>(range.first + high));
+            });
 
+        this->blocking_blocks<Idx>(range, f);
+    }
 
+    template <class Idx, class F, require_invocable<F, Idx> = true>
+    void blocking_loop(IndexRange<Idx> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](Idx low, Idx high) {
+            for (Idx i = low; i < high; ++i) f(i);
+        };
+        this->blocking_loop(range, std::move(iterate_block));
+    }
 
+    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
+    future_type<> awaitable_loop(IndexRange<Idx> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
 
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~ DmitriBogdanov/UTL ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
-//
-// Module:        utl::parallel
-// Documentation: https://github.com/DmitriBogdanov/UTL/blob/master/docs/module_parallel.md
-// Source repo:   https://github.com/DmitriBogdanov/UTL
-//
-// This project is licensed under the MIT License
-//
-// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+        auto submit_loop = [this, range, f = std::forward<F>(f)] { this->blocking_loop(range, f); };
+        return this->awaitable_task(std::move(submit_loop));
+    }
 
-#if !defined(UTL_PICK_MODULES) || defined(UTL_MODULE_PARALLEL)
+    template <class Idx, class F, require_invocable<F, Idx> = true>
+    future_type<> awaitable_loop(IndexRange<Idx> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
 
-#ifndef utl_parallel_headerguard
-#define utl_parallel_headerguard
+        auto iterate_block = [f = std::forward<F>(f)](Idx low, Idx high) {
+            for (Idx i = low; i < high; ++i) f(i);
+        };
+        return this->awaitable_loop(range, std::move(iterate_block));
+    }
 
-#define UTL_PARALLEL_VERSION_MAJOR 2
-#define UTL_PARALLEL_VERSION_MINOR 1
-#define UTL_PARALLEL_VERSION_PATCH 4
+    // - 'IndexRange2D' overloads (6) -
 
-// _______________________ INCLUDES _______________________
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx, Idx> = true>
+    void detached_loop(IndexRange2D<Idx> range, F&& f) {
+        auto tile = [f = std::forward<F>(f)](const auto& low, const auto& high) {
+            f(low[0], high[0], low[1], high[1]);
+        };
+        this->detached_tiles(Tiling<2, Idx>({range.i, range.j}, range.order), std::move(tile));
+    }
 
-#include <condition_variable> // condition_variable
-#include <cstdint>            // uint64_t
-#include <functional>         // plus<>, multiplies<>, function<>
-#include <future>             // future<>, promise<>
-#include <memory>             // shared_ptr<>
-#include <mutex>              // mutex, scoped_lock<>, unique_lock<>
-#include <optional>           // optional<>, nullopt
-#include <queue>              // queue<>, deque<>, size_t, ptrdiff_t
-#include <stdexcept>          // current_exception, runtime_error
-#include <thread>             // thread
-#include <utility>            // forward<>()
-#include <vector>             // vector<>
+    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
+    void detached_loop(IndexRange2D<Idx> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](Idx i_low, Idx i_high, Idx j_low, Idx j_high) {
+            for (Idx i = i_low; i < i_high; ++i)
+                for (Idx j = j_low; j < j_high; ++j) f(i, j);
+        };
+        this->detached_loop(range, std::move(iterate_block));
+    }
 
-// ____________________ DEVELOPER DOCS ____________________
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx, Idx> = true>
+    void blocking_loop(IndexRange2D<Idx> range, F&& f) {
+        auto tile = [&f](const auto& low, const auto& high) { f(low[0], high[0], low[1], high[1]); };
+        this->blocking_tiles(Tiling<2, Idx>({range.i, range.j}, range.order), tile);
+    }
 
-// Work-stealing summary:
-//
-//    - We use several queues:
-//         - All  threads have a global task queue
-//         - Each thread  has  a local  task deque
-//    - Tasks go into different queues depending on their source:
-//         - Work queued from a     pool thread => recursive task, goes to the front of local  deque
-//         - Work queued from a non-pool thread => external  task, goes to the back  of global queue
-//    - When threads are looking for work they search in 3 steps:
-//         1. Check local  deque,  work here can be popped from the front
-//         2. Check other  deques, work here can be stolen from the back
-//         3. Check global queue,  work here can be popped from the front
-//    - To resolve recursive deadlocks we use a custom future:
-//         - Recursive task calls '.wait()' on its future => pop / steal work from local deques until finished
-//
-// Ideally we would want to use a different algorithm with Chase-Lev lock-free local SPMC queues for work-stealing,
-// and a global lock-free MPMC queue for outside tasks, however properly implementing such queues is a task of
-// incredible complexity, which is further exacerbated by the fact that 'std::function' has a potentially throwing
-// move-assignment, which disqualifies it from ~80% of existing lock-free queue implementations.
-//
-// Newer standards would enable several improvements in terms of implementation:
-//    - In C++20 'std::jthread' can be used to simplify joining and add stop tokens
-//    - In C++23 'std::move_only_function<>' can be used as a more efficient task type,
-//      however this still doesn't resolve the issue of throwing move assignment
-//    - In C++20 atomic wait / semaphores / barriers can be used to improve efficiency
-//      of some syncronization
-//
-// It is also possible to add task priority with a bit of constexpr logic and possibly reduce locking
-// in some parts of the scheduling, this is a work for future releases.
+    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
+    void blocking_loop(IndexRange2D<Idx> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](Idx i_low, Idx i_high, Idx j_low, Idx j_high) {
+            for (Idx i = i_low; i < i_high; ++i)
+                for (Idx j = j_low; j < j_high; ++j) f(i, j);
+        };
+        this->blocking_loop(range, std::move(iterate_block));
+    }
 
-// ____________________ IMPLEMENTATION ____________________
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx, Idx> = true>
+    future_type<> awaitable_loop(IndexRange2D<Idx> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
 
-namespace utl::parallel::impl {
+        auto submit_loop = [this, range, f = std::forward<F>(f)] { this->blocking_loop(range, f); };
+        return this->awaitable_task(std::move(submit_loop));
+    }
 
-// ============================
-// --- Thread introspection ---
-// ============================
+    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
+    future_type<> awaitable_loop(IndexRange2D<Idx> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
 
-namespace this_thread {
+        auto iterate_block = [f = std::forward<F>(f)](Idx i_low, Idx i_high, Idx j_low, Idx j_high) {
+            for (Idx i = i_low; i < i_high; ++i)
+                for (Idx j = j_low; j < j_high; ++j) f(i, j);
+        };
+        return this->awaitable_loop(range, std::move(iterate_block));
+    }
 
-inline thread_local std::optional<std::size_t> worker_index    = std::nullopt;
-inline thread_local std::optional<void*>       thread_pool_ptr = std::nullopt;
+    // - 'IndexRange3D' overloads (6) -
 
-[[nodiscard]] inline std::optional<std::size_t> get_index() noexcept { return worker_index; }
-[[nodiscard]] inline std::optional<void*>       get_pool() noexcept { return thread_pool_ptr; }
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx, Idx, Idx, Idx> = true>
+    void detached_loop(IndexRange3D<Idx> range, F&& f) {
+        auto tile = [f = std::forward<F>(f)](const auto& low, const auto& high) {
+            f(low[0], high[0], low[1], high[1], low[2], high[2]);
+        };
+        this->detached_tiles(Tiling<3, Idx>({range.i, range.j, range.k}, range.order), std::move(tile));
+    }
 
-}; // namespace this_thread
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx> = true>
+    void detached_loop(IndexRange3D<Idx> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](Idx i_low, Idx i_high, Idx j_low, Idx j_high, Idx k_low,
+                                                      Idx k_high) {
+            for (Idx i = i_low; i < i_high; ++i)
+                for (Idx j = j_low; j < j_high; ++j)
+                    for (Idx k = k_low; k < k_high; ++k) f(i, j, k);
+        };
+        this->detached_loop(range, std::move(iterate_block));
+    }
 
-[[nodiscard]] inline std::size_t hardware_concurrency() noexcept {
-    const std::size_t     detected_count = std::thread::hardware_concurrency();
-    constexpr std::size_t fallback_count = 4;
-    return detected_count ? detected_count : fallback_count;
-    // if 'hardware_concurrency()' struggles to determine the number of threads, we fallback onto a reasonable default
-}
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx, Idx, Idx, Idx> = true>
+    void blocking_loop(IndexRange3D<Idx> range, F&& f) {
+        auto tile = [&f](const auto& low, const auto& high) { f(low[0], high[0], low[1], high[1], low[2], high[2]); };
+        this->blocking_tiles(Tiling<3, Idx>({range.i, range.j, range.k}, range.order), tile);
+    }
 
-// ===================
-// --- Thread pool ---
-// ===================
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx> = true>
+    void blocking_loop(IndexRange3D<Idx> range, F&& f) {
+        auto iterate_block = [f = std::forward<F>(f)](Idx i_low, Idx i_high, Idx j_low, Idx j_high, Idx k_low,
+                                                      Idx k_high) {
+            for (Idx i = i_low; i < i_high; ++i)
+                for (Idx j = j_low; j < j_high; ++j)
+                    for (Idx k = k_low; k < k_high; ++k) f(i, j, k);
+        };
+        this->blocking_loop(range, std::move(iterate_block));
+    }
 
-class ThreadPool;
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx, Idx, Idx, Idx> = true>
+    future_type<> awaitable_loop(IndexRange3D<Idx> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
 
-namespace ws_this_thread { // same this as thread introspection from public API, but more convenient for internal use
-inline thread_local ThreadPool* thread_pool_ptr = nullptr;
-inline thread_local std::size_t worker_index    = std::size_t(-1);
-}; // namespace ws_this_thread
+        auto submit_loop = [this, range, f = std::forward<F>(f)] { this->blocking_loop(range, f); };
+        return this->awaitable_task(std::move(submit_loop));
+    }
 
-inline std::size_t splitmix64() noexcept {
-    thread_local std::uint64_t state = ws_this_thread::worker_index;
+    template <class Idx, class F, require_invocable<F, Idx, Idx, Idx> = true>
+    future_type<> awaitable_loop(IndexRange3D<Idx> range, F&& f) {
+        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
 
-    std::uint64_t result = (state += 0x9E3779B97f4A7C15);
-    result               = (result ^ (result >> 30)) * 0xBF58476D1CE4E5B9;
-    result               = (result ^ (result >> 27)) * 0x94D049BB133111EB;
-    return static_cast<std::size_t>(result ^ (result >> 31));
-} // very fast & simple PRNG
+        auto iterate_block = [f = std::forward<F>(f)](Idx i_low, Idx i_high, Idx j_low, Idx j_high, Idx k_low,
+                                                      Idx k_high) {
+            for (Idx i = i_low; i < i_high; ++i)
+                for (Idx j = j_low; j < j_high; ++j)
+                    for (Idx k = k_low; k < k_high; ++k) f(i, j, k);
+        };
+        return this->awaitable_loop(range, std::move(iterate_block));
+    }
 
-class ThreadPool {
-    using task_type         = std::function<void()>;
-    using global_queue_type = std::queue<task_type>;
-    using local_queue_type  = std::deque<task_type>;
+    // - 'Container' overloads (3) -
 
-    std::vector<std::thread> workers;
-    std::mutex               workers_mutex;
+    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true> // without SFINAE reqs
+    void detached_loop(Container&& container, F&& f) {                                         // such overloads would
+        this->detached_loop(Range{std::forward<Container>(container)}, std::forward<F>(f));    // always get picked
+    } // over the others
 
-    global_queue_type global_queue;
-    std::mutex        global_queue_mutex;
+    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+    void blocking_loop(Container&& container, F&& f) {
+        this->blocking_loop(Range{std::forward<Container>(container)}, std::forward<F>(f));
+    }
 
-    std::vector<local_queue_type> local_queues;
-    std::vector<std::mutex>       local_queues_mutexes;
+    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+    future_type<> awaitable_loop(Container&& container, F&& f) {
+        return this->awaitable_loop(Range{std::forward<Container>(container)}, std::forward<F>(f));
+    }
 
-    std::condition_variable task_available_cv;
-    std::condition_variable task_done_cv;
-    std::mutex              task_mutex;
+    // - Cancellable overloads (6) -
 
-    std::size_t tasks_running = 0; // protected by task mutex
-    std::size_t tasks_pending = 0;
+    // Any of the range types above, once the 'token' is cancelled remaining blocks / iterations get skipped
 
-    bool waiting     = false; // protected by task mutex
-    bool terminating = true;
+    template <class R, class F, require_no_iter<R> = true>
+    void detached_loop(R range, CancellationToken token, F&& f) {
+        this->detached_loop(range, SkipIfCancelled<std::decay_t<F>>{std::move(token), std::forward<F>(f)});
+    }
 
-private:
-    void spawn_workers(std::size_t count) {
-        this->workers              = std::vector<std::thread>(count);
-        this->local_queues         = std::vector<local_queue_type>(count);
-        this->local_queues_mutexes = std::vector<std::mutex>(count);
-        {
-            const std::scoped_lock task_lock(this->task_mutex);
-            this->terminating = false;
-        }
-        for (std::size_t i = 0; i < count; ++i) this->workers[i] = std::thread([this, i] { this->worker_main(i); });
+    template <class R, class F, require_no_iter<R> = true>
+    void blocking_loop(R range, CancellationToken token, F&& f) {
+        this->blocking_loop(range, SkipIfCancelled<std::decay_t<F>>{std::move(token), std::forward<F>(f)});
     }
 
-    void terminate_workers() {
-        {
-            const std::scoped_lock polling_lock(this->task_mutex);
-            this->terminating = true;
-        }
-        this->task_available_cv.notify_all();
+    template <class R, class F, require_no_iter<R> = true>
+    future_type<> awaitable_loop(R range, CancellationToken token, F&& f) {
+        return this->awaitable_loop(range, SkipIfCancelled<std::decay_t<F>>{std::move(token), std::forward<F>(f)});
+    }
 
-        for (std::size_t i = 0; i < this->workers.size(); ++i)
-            if (this->workers[i].joinable()) this->workers[i].join();
+    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+    void detached_loop(Container&& container, CancellationToken token, F&& f) {
+        this->detached_loop(Range{std::forward<Container>(container)}, std::move(token), std::forward<F>(f));
     }
 
-    void worker_main(std::size_t worker_index) {
-        this_thread::thread_pool_ptr    = this;
-        this_thread::worker_index       = worker_index;
-        ws_this_thread::thread_pool_ptr = this;
-        ws_this_thread::worker_index    = worker_index;
+    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+    void blocking_loop(Container&& container, CancellationToken token, F&& f) {
+        this->blocking_loop(Range{std::forward<Container>(container)}, std::move(token), std::forward<F>(f));
+    }
 
-        while (true) {
-            std::unique_lock task_lock(this->task_mutex);
+    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+    future_type<> awaitable_loop(Container&& container, CancellationToken token, F&& f) {
+        return this->awaitable_loop(Range{std::forward<Container>(container)}, std::move(token), std::forward<F>(f));
+    }
 
-            // Wake up thread pool 'wait()' if necessary
-            if (this->waiting && !this->tasks_pending && !this->tasks_running) this->task_done_cv.notify_all();
+    // --- Parallel-reduce API ---
+    // ---------------------------
 
-            // Tasks pending       => continue execution and pull tasks to execute
-            // Pool is terminating => continue execution and break out of the main loop
-            // otherwise           => wait
-            this->task_available_cv.wait(task_lock, [this] { return this->terminating || this->tasks_pending; });
+    // - 'Range' overloads (2) -
 
-            // Terminate if necessary
-            if (this->terminating) break;
+    template <class It, class Op, class R = typename It::value_type>
+    R blocking_reduce(Range<It> range, Op&& op) {
+        if (range.begin == range.end) throw std::runtime_error("Reduction over an empty range is undefined");
 
-            task_lock.unlock();
+        const auto identity = [](const auto& value) -> const auto& { return value; };
 
-            // Try to pull in a task
-            task_type task;
-            if (this->try_pop_local(task) || this->try_steal(task) || this->try_pop_global(task)) {
-                task_lock.lock();
-                --this->tasks_pending;
-                ++this->tasks_running;
-                task_lock.unlock();
+        return this->blocking_transform_reduce(Range<It>{std::next(range.begin), range.end, range.grain_size},
+                                               R(*range.begin), std::forward<Op>(op), identity);
+    }
 
-                task();
+    template <class It, class Op, class R = typename It::value_type>
+    future_type<R> awaitable_reduce(Range<It> range, Op&& op) {
+        auto submit_reduce = [this, range, op = std::forward<Op>(op)] { return this->blocking_reduce(range, op); };
+        return this->awaitable_task(std::move(submit_reduce));
+    }
 
-                task_lock.lock();
-                --this->tasks_running;
-                task_lock.unlock();
-            }
-        }
+    // - 'Container' overloads (2) -
 
-        this_thread::thread_pool_ptr    = std::nullopt;
-        this_thread::worker_index       = std::nullopt;
-        ws_this_thread::thread_pool_ptr = nullptr;
-        ws_this_thread::worker_index    = std::size_t(-1);
+    template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
+    R blocking_reduce(Container&& container, Op&& op) {
+        return this->blocking_reduce(Range{std::forward<Container>(container)}, std::forward<Op>(op));
     }
 
-    bool try_pop_local(task_type& task) {
-        const std::scoped_lock local_queue_lock(this->local_queues_mutexes[ws_this_thread::worker_index]);
+    template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
+    future_type<R> awaitable_reduce(Container&& container, Op&& op) {
+        return this->awaitable_reduce(Range{std::forward<Container>(container)}, std::forward<Op>(op));
+    }
 
-        auto& local_queue = this->local_queues[ws_this_thread::worker_index];
+    // - Deterministic overloads (4) -
 
-        if (local_queue.empty()) return false;
+    // Every grain folds its elements left-to-right into its own slot, slots then get combined by a fixed pairwise
+    // tree over the grain indices. Both only depend on the grain structure, which makes the result reproducible
+    // regardless of the thread count or the order in which grains finish, this matters for floating point.
+    template <class It, class Op, class R = typename It::value_type>
+    R blocking_deterministic_reduce(Range<It> range, Op&& op) {
+        static_assert(is_random_access_v<It>, utl_parallel_random_access_message);
 
-        task = std::move(local_queue.front());
-        local_queue.pop_front();
-        return true;
-    }
+        if (range.begin == range.end) throw std::runtime_error("Reduction over an empty range is undefined");
 
-    bool try_steal(task_type& task) {
-        for (std::size_t attempt = 0; attempt < this->workers.size(); ++attempt) {
-            const std::size_t i = splitmix64() % this->workers.size();
+        const std::size_t size       = range.end - range.begin;
+        const std::size_t grain_size = resolve_grain_size(range.grain_size, size);
+        const std::size_t grains     = (size + grain_size - 1) / grain_size;
 
-            if (i == ws_this_thread::worker_index) continue; // don't steal from yourself
+        std::vector<std::optional<R>> partials(grains);
 
-            const std::scoped_lock local_queue_lock(this->local_queues_mutexes[i]);
+        this->blocking_loop(IndexRange<std::size_t>{0, grains, 1}, [&](std::size_t low, std::size_t high) {
+            for (std::size_t grain = low; grain < high; ++grain) {
+                It       it  = range.begin + grain * grain_size;
+                const It end = range.begin + min_size((grain + 1) * grain_size, size);
 
-            auto& local_queue = this->local_queues[i];
+                R partial = R(*it);
+                for (++it; it != end; ++it) partial = op(partial, *it);
 
-            if (local_queue.empty()) continue;
+                partials[grain] = std::move(partial);
+            }
+        });
 
-            task = std::move(local_queue.back());
-            local_queue.pop_back();
-            return true;
-        }
+        for (std::size_t stride = 1; stride < grains; stride *= 2)
+            for (std::size_t grain = 0; grain + stride < grains; grain += 2 * stride)
+                partials[grain] = op(*partials[grain], *partials[grain + stride]);
 
-        return false;
+        return std::move(*partials.front());
     }
 
-    bool try_pop_global(task_type& task) {
-        const std::scoped_lock global_queue_lock(this->global_queue_mutex);
+    template <class It, class Op, class R = typename It::value_type>
+    future_type<R> awaitable_deterministic_reduce(Range<It> range, Op&& op) {
+        auto submit_reduce = [this, range, op = std::forward<Op>(op)] {
+            return this->blocking_deterministic_reduce(range, op);
+        };
+        return this->awaitable_task(std::move(submit_reduce));
+    }
 
-        if (this->global_queue.empty()) return false;
+    template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
+    R blocking_deterministic_reduce(Container&& container, Op&& op) {
+        return this->blocking_deterministic_reduce(Range{std::forward<Container>(container)}, std::forward<Op>(op));
+    }
 
-        task = std::move(this->global_queue.front());
-        this->global_queue.pop();
-        return true;
+    template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
+    future_type<R> awaitable_deterministic_reduce(Container&& container, Op&& op) {
+        return this->awaitable_deterministic_reduce(Range{std::forward<Container>(container)}, std::forward<Op>(op));
     }
 
-public:
-    explicit ThreadPool(std::size_t count = std::thread::hardware_concurrency()) { this->spawn_workers(count); }
+    // --- Parallel-transform-reduce API ---
+    // -------------------------------------
 
-    ~ThreadPool() noexcept {
-        try {
-            this->wait();
-            this->terminate_workers();
-        } catch (...) {} // no throwing from the destructor
-    }
+    // - 'Range' overloads (2) -
 
-    template <class T = void>
-    struct future_type {
-        std::future<T> future;
+    template <class It, class T, class ReduceOp, class TransformOp>
+    T blocking_transform_reduce(Range<It> range, T init, ReduceOp&& reduce_op, TransformOp&& transform_op) {
+        PartialResults<T> partial_results(this->worker_count(), &this->backend);
 
-        void fallthrough() const {
-            ThreadPool* pool = ws_this_thread::thread_pool_ptr;
+        this->blocking_loop(range, [&](It low, It high) {
+            T partial = transform_op(*low);
+            for (It it = std::next(low); it != high; ++it) partial = reduce_op(partial, transform_op(*it));
 
-            if (!pool) return;
+            partial_results.accumulate(std::move(partial), reduce_op);
+        });
 
-            // Execute recursive tasks from local queues until this future is ready
-            task_type task;
-            while (pool->try_pop_local(task) || pool->try_steal(task)) {
-                pool->task_mutex.lock();
-                --pool->tasks_pending;
-                ++pool->tasks_running;
-                pool->task_mutex.unlock();
+        return partial_results.combine(std::move(init), reduce_op);
+    }
 
-                task();
+    template <class It, class T, class ReduceOp, class TransformOp>
+    future_type<T> awaitable_transform_reduce(Range<It> range, T init, ReduceOp&& reduce_op,
+                                              TransformOp&& transform_op) {
+        auto submit_reduce = [this, range, init = std::move(init), reduce_op = std::forward<ReduceOp>(reduce_op),
+                              transform_op = std::forward<TransformOp>(transform_op)] {
+            return this->blocking_transform_reduce(range, init, reduce_op, transform_op);
+        };
+        return this->awaitable_task(std::move(submit_reduce));
+    }
 
-                pool->task_mutex.lock();
-                --pool->tasks_running;
-                pool->task_mutex.unlock();
+    // - 'IndexRange' overloads (2) -
 
-                if (this->is_ready()) return;
-            }
-        }
+    template <class Idx, class T, class ReduceOp, class TransformOp>
+    T blocking_transform_reduce(IndexRange<Idx> range, T init, ReduceOp&& reduce_op, TransformOp&& transform_op) {
+        PartialResults<T> partial_results(this->worker_count(), &this->backend);
 
-        bool is_ready() const { return this->future.wait_for(std::chrono::seconds{0}) == std::future_status::ready; }
+        this->blocking_loop(range, [&](Idx low, Idx high) {
+            T partial = transform_op(low);
+            for (Idx i = low + 1; i < high; ++i) partial = reduce_op(partial, transform_op(i));
 
-    public:
-        future_type(std::future<T>&& future) : future(std::move(future)) {} // conversion from regular future
-        future_type& operator=(std::future<T>&& future) {
-            this->future = std::move(future);
-            return *this;
-        }
+            partial_results.accumulate(std::move(partial), reduce_op);
+        });
 
-        using is_recursive = void;
+        return partial_results.combine(std::move(init), reduce_op);
+    }
 
-        auto get() {
-            this->fallthrough();
-            return this->future.get();
-        }
+    template <class Idx, class T, class ReduceOp, class TransformOp>
+    future_type<T> awaitable_transform_reduce(IndexRange<Idx> range, T init, ReduceOp&& reduce_op,
+                                              TransformOp&& transform_op) {
+        auto submit_reduce = [this, range, init = std::move(init), reduce_op = std::forward<ReduceOp>(reduce_op),
+                              transform_op = std::forward<TransformOp>(transform_op)] {
+            return this->blocking_transform_reduce(range, init, reduce_op, transform_op);
+        };
+        return this->awaitable_task(std::move(submit_reduce));
+    }
 
-        bool valid() const noexcept { return this->future.valid(); }
+    // - 'Container' overloads (2) -
 
-        void wait() const {
-            this->fallthrough();
-            this->future.wait();
-        }
+    template <class Container, class T, class ReduceOp, class TransformOp,
+              require_has_some_iter<std::decay_t<Container>> = true>
+    T blocking_transform_reduce(Container&& container, T init, ReduceOp&& reduce_op, TransformOp&& transform_op) {
+        return this->blocking_transform_reduce(Range{std::forward<Container>(container)}, std::move(init),
+                                               std::forward<ReduceOp>(reduce_op),
+                                               std::forward<TransformOp>(transform_op));
+    }
 
-        template <class Rep, class Period>
-        std::future_status wait_for(const std::chrono::duration<Rep, Period>& timeout_duration) const {
-            this->fallthrough();
-            return this->future.wait_for(timeout_duration);
-        }
+    template <class Container, class T, class ReduceOp, class TransformOp,
+              require_has_some_iter<std::decay_t<Container>> = true>
+    future_type<T> awaitable_transform_reduce(Container&& container, T init, ReduceOp&& reduce_op,
+                                              TransformOp&& transform_op) {
+        return this->awaitable_transform_reduce(Range{std::forward<Container>(container)}, std::move(init),
+                                                std::forward<ReduceOp>(reduce_op),
+                                                std::forward<TransformOp>(transform_op));
+    }
 
-        template <class Clock, class Duration>
-        std::future_status wait_until(const std::chrono::time_point<Clock, Duration>& timeout_time) const {
-            this->fallthrough();
-            return this->future.wait_until(timeout_time);
-        }
-    };
+    // --- Parallel-scan API ---
+    // -------------------------
 
-    void set_thread_count(std::size_t count) {
-        if (ws_this_thread::thread_pool_ptr == this)
-            throw std::runtime_error("Cannot resize thread pool from its own pool thread.");
+    // - 'Range' overloads (4) -
 
-        const std::scoped_lock workers_lock(this->workers_mutex);
+    template <class It, class OutIt, class Op>
+    OutIt blocking_inclusive_scan(Range<It> range, OutIt out, Op&& op) {
+        static_assert(is_random_access_v<It>, utl_parallel_random_access_message);
 
-        this->wait();
-        this->terminate_workers();
-        this->spawn_workers(count);
-    }
+        using value_type = typename std::iterator_traits<It>::value_type;
 
-    [[nodiscard]] std::size_t get_thread_count() {
-        if (ws_this_thread::thread_pool_ptr == this) return this->workers.size();
-        // calls from inside the pool shouldn't lock, otherwise we could deadlock the thread by trying to
-        // query the thread count while the pool was instructed to resize, worker count is constant during
-        // a worker lifetime so it's safe to query without a lock anyways
+        const auto value = [&](std::size_t i) -> decltype(auto) { return range.begin[i]; };
 
-        const std::scoped_lock workers_lock(this->workers_mutex);
+        return this->scan<value_type>(range.end - range.begin, range.grain_size, value, out, std::nullopt, op);
+    }
 
-        return this->workers.size();
+    template <class It, class OutIt, class Op>
+    future_type<OutIt> awaitable_inclusive_scan(Range<It> range, OutIt out, Op&& op) {
+        auto submit_scan = [this, range, out, op = std::forward<Op>(op)] {
+            return this->blocking_inclusive_scan(range, out, op);
+        };
+        return this->awaitable_task(std::move(submit_scan));
     }
 
-    void wait() {
-        std::unique_lock task_lock(this->task_mutex);
+    template <class It, class OutIt, class T, class Op>
+    OutIt blocking_exclusive_scan(Range<It> range, OutIt out, T init, Op&& op) {
+        static_assert(is_random_access_v<It>, utl_parallel_random_access_message);
+
+        const auto value = [&](std::size_t i) -> decltype(auto) { return range.begin[i]; };
 
-        this->waiting = true;
-        this->task_done_cv.wait(task_lock, [this] { return !this->tasks_pending && !this->tasks_running; });
-        this->waiting = false;
+        return this->scan<T>(range.end - range.begin, range.grain_size, value, out, std::move(init), op);
     }
 
-    template <class F, class... Args>
-    void detached_task(F&& f, Args&&... args) {
-        auto closure = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+    template <class It, class OutIt, class T, class Op>
+    future_type<OutIt> awaitable_exclusive_scan(Range<It> range, OutIt out, T init, Op&& op) {
+        auto submit_scan = [this, range, out, init = std::move(init), op = std::forward<Op>(op)] {
+            return this->blocking_exclusive_scan(range, out, init, op);
+        };
+        return this->awaitable_task(std::move(submit_scan));
+    }
 
-        // Recursive task
-        if (ws_this_thread::thread_pool_ptr == this) {
-            const std::scoped_lock local_queue_lock(this->local_queues_mutexes[ws_this_thread::worker_index]);
-            this->local_queues[ws_this_thread::worker_index].push_front(std::move(closure));
-        }
-        // Regular task
-        else {
-            const std::scoped_lock global_queue_lock(this->global_queue_mutex);
-            this->global_queue.emplace(std::move(closure));
-        }
+    // - 'IndexRange' overloads (4) -
 
-        {
-            const std::scoped_lock task_lock(this->task_mutex);
-            ++this->tasks_pending;
-        }
-        this->task_available_cv.notify_one();
-    }
+    template <class Idx, class OutIt, class Op, class F>
+    OutIt blocking_inclusive_scan(IndexRange<Idx> range, OutIt out, Op&& op, F&& f) {
+        using value_type = std::decay_t<std::invoke_result_t<F&, Idx>>;
 
-    template <class F, class... Args, class R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
-    future_type<R> awaitable_task(F&& f, Args&&... args) {
-        auto closure = std::bind(std::forward<F>(f), std::forward<Args>(args)...);
+        const auto value = [&](std::size_t i) -> decltype(auto) { return f(static_cast<Idx>(range.first + i)); };
 
-        const std::shared_ptr<std::promise<R>> promise = std::make_shared<std::promise<R>>();
-        // ideally we could just move promise into a lambda and use it as is, however that makes the lambda
-        // non-copyable (since promise itself is move-only) which doesn't work with 'std::function<>', this
-        // is fixed in C++23 with 'std::move_only_function<>'
+        return this->scan<value_type>(range.last - range.first, range.grain_size, value, out, std::nullopt, op);
+    }
 
-        future_type<R> future = promise->get_future();
+    template <class Idx, class OutIt, class Op, class F>
+    future_type<OutIt> awaitable_inclusive_scan(IndexRange<Idx> range, OutIt out, Op&& op, F&& f) {
+        auto submit_scan = [this, range, out, op = std::forward<Op>(op), f = std::forward<F>(f)] {
+            return this->blocking_inclusive_scan(range, out, op, f);
+        };
+        return this->awaitable_task(std::move(submit_scan));
+    }
 
-        this->detached_task([closure = std::move(closure), promise = std::move(promise)]() mutable {
-            try {
-                if constexpr (std::is_void_v<R>) {
-                    closure();
-                    promise->set_value();
-                } else {
-                    promise->set_value(closure());
-                } // 'promise->set_value(f())' when 'f()' returns 'void' is a compile error, so we use a workaround
-            } catch (...) {
-                try {
-                    promise->set_exception(std::current_exception()); // this may still throw
-                } catch (...) {}
-            }
-        });
+    template <class Idx, class OutIt, class T, class Op, class F>
+    OutIt blocking_exclusive_scan(IndexRange<Idx> range, OutIt out, T init, Op&& op, F&& f) {
+        const auto value = [&](std::size_t i) -> decltype(auto) { return f(static_cast<Idx>(range.first + i)); };
 
-        return future;
+        return this->scan<T>(range.last - range.first, range.grain_size, value, out, std::move(init), op);
     }
-};
 
-template <class T = void>
-using Future = ThreadPool::future_type<T>;
+    template <class Idx, class OutIt, class T, class Op, class F>
+    future_type<OutIt> awaitable_exclusive_scan(IndexRange<Idx> range, OutIt out, T init, Op&& op, F&& f) {
+        auto submit_scan = [this, range, out, init = std::move(init), op = std::forward<Op>(op),
+                            f = std::forward<F>(f)] { return this->blocking_exclusive_scan(range, out, init, op, f); };
+        return this->awaitable_task(std::move(submit_scan));
+    }
 
-// ==============
-// --- Ranges ---
-// ==============
+    // - 'Container' overloads (4) -
 
-// --- SFINAE helpers ---
-// ----------------------
+    template <class Container, class OutIt, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+    OutIt blocking_inclusive_scan(Container&& container, OutIt out, Op&& op) {
+        return this->blocking_inclusive_scan(Range{std::forward<Container>(container)}, out, std::forward<Op>(op));
+    }
 
-template <bool Cond>
-using require = std::enable_if_t<Cond, bool>;
+    template <class Container, class OutIt, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+    future_type<OutIt> awaitable_inclusive_scan(Container&& container, OutIt out, Op&& op) {
+        return this->awaitable_inclusive_scan(Range{std::forward<Container>(container)}, out, std::forward<Op>(op));
+    }
 
-template <class T, class... Args>
-using require_invocable = require<std::is_invocable_v<T, Args...>>;
-// this is simple convenience
+    template <class Container, class OutIt, class T, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+    OutIt blocking_exclusive_scan(Container&& container, OutIt out, T init, Op&& op) {
+        return this->blocking_exclusive_scan(Range{std::forward<Container>(container)}, out, std::move(init),
+                                             std::forward<Op>(op));
+    }
 
-template <class T, class = void>
-struct has_iter : std::false_type {};
-template <class T>
-struct has_iter<T, std::void_t<decltype(std::declval<typename T::iterator>())>> : std::true_type {};
+    template <class Container, class OutIt, class T, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+    future_type<OutIt> awaitable_exclusive_scan(Container&& container, OutIt out, T init, Op&& op) {
+        return this->awaitable_exclusive_scan(Range{std::forward<Container>(container)}, out, std::move(init),
+                                              std::forward<Op>(op));
+    }
 
-template <class T, class = void>
-struct has_const_iter : std::false_type {};
-template <class T>
-struct has_const_iter<T, std::void_t<decltype(std::declval<typename T::const_iterator>())>> : std::true_type {};
+    // --- Parallel-sort API ---
+    // -------------------------
 
-template <class T>
-using require_has_some_iter = require<has_iter<T>::value || has_const_iter<T>::value>;
-// needed to restrict template 'Range' constructor from a container, otherwise it takes priority over copy / move ctors
+    // - 'Range' overloads (3) -
 
-template <class T, class = void>
-struct is_recursive : std::false_type {};
-template <class T>
-struct is_recursive<T, std::void_t<decltype(std::declval<typename T::is_recursive>())>> : std::true_type {};
-template <class T>
-constexpr bool is_recursive_v = is_recursive<T>::value;
+    template <class It, class Cmp = std::less<>>
+    void sort(Range<It> range, Cmp&& cmp = Cmp{}) {
+        static_assert(is_random_access_v<It>, utl_parallel_random_access_message);
+        this->merge_sort<false>(range, cmp);
+    }
+
+    template <class It, class Cmp = std::less<>>
+    void stable_sort(Range<It> range, Cmp&& cmp = Cmp{}) {
+        static_assert(is_random_access_v<It>, utl_parallel_random_access_message);
+        this->merge_sort<true>(range, cmp);
+    }
 
-// --- Utils ---
-// -------------
+    template <class It, class Pred>
+    It partition(Range<It> range, Pred&& pred) {
+        static_assert(is_random_access_v<It>, utl_parallel_random_access_message);
 
-[[nodiscard]] constexpr std::size_t min_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? b : a; }
-[[nodiscard]] constexpr std::size_t max_size(std::size_t a, std::size_t b) noexcept { return (b < a) ? a : b; }
-// no reason to include the entirety of <algorithm> just for 2 one-liners
+        using value_type = typename std::iterator_traits<It>::value_type;
 
-constexpr std::size_t default_grains_per_thread = 4;
-// by default we distribute 4 tasks per thread, this number is purely empirical. We don't want to split up
-// work into too many tasks (like with 'grain_size = 1'), yet we want it to be a bit more granular than
-// doing 1 task per thread since that would be horrible if tasks are noticeably uneven.
+        const std::size_t size       = range.end - range.begin;
+        const std::size_t block_size = resolve_grain_size(range.grain_size, size);
 
-// --- Range ---
-// -------------
+        if (size < min_parallel_sort_size || size <= block_size) return std::partition(range.begin, range.end, pred);
 
-template <class It>
-struct Range {
-    It          begin;
-    It          end;
-    std::size_t grain_size;
+        const std::size_t block_count = (size + block_size - 1) / block_size;
 
-    Range() = delete;
+        // Evaluate the predicate once per element & count matches in each block, scan over counts gives us
+        // output offsets. Predicate results are stored so the scatter can't disagree with the counts even if
+        // the predicate is impure.
+        std::vector<char>        matches(size);
+        std::vector<std::size_t> true_offsets(block_count + 1, 0);
 
-    constexpr Range(It begin, It end, std::size_t grain_size) : begin(begin), end(end), grain_size(grain_size) {}
+        this->blocking_loop(IndexRange<std::size_t>{0, block_count, 1}, [&](std::size_t block) {
+            const std::size_t low  = block * block_size;
+            const std::size_t high = min_size(low + block_size, size);
 
-    Range(It begin, It end)
-        : Range(begin, end, max_size(1, (end - begin) / (hardware_concurrency() * default_grains_per_thread))) {}
+            std::size_t count = 0;
+            for (std::size_t i = low; i < high; ++i) count += (matches[i] = static_cast<bool>(pred(range.begin[i])));
 
+            true_offsets[block + 1] = count;
+        });
 
-    template <class Container, require<has_const_iter<Container>::value> = true>
-    Range(const Container& container) : Range(container.begin(), container.end()) {}
+        for (std::size_t block = 0; block < block_count; ++block) true_offsets[block + 1] += true_offsets[block];
 
-    template <class Container, require<has_iter<Container>::value> = true>
-    Range(Container& container) : Range(container.begin(), container.end()) {}
-}; // requires random-access iterator, but no good way to express that before C++20 concepts
+        const std::size_t true_count = true_offsets.back();
 
-// CTAD for deducing iterator range from a container
-template <class Container>
-Range(const Container& container) -> Range<typename Container::const_iterator>;
+        // Leading matches & trailing non-matches are already in place, only the part in between needs a buffer
+        std::size_t first = 0, last = size;
+        while (first < last && matches[first]) ++first;
+        while (first < last && !matches[last - 1]) --last;
 
-template <class Container>
-Range(Container& container) -> Range<typename Container::iterator>;
+        if (first == last) return range.begin + true_count;
 
-// --- Index range ---
-// -------------------
+        // Scatter elements from the buffer back into the range, elements keep their relative order
+        std::vector<value_type> buffer(std::make_move_iterator(range.begin + first),
+                                       std::make_move_iterator(range.begin + last));
 
-template <class Idx = std::ptrdiff_t>
-struct IndexRange {
-    Idx         first;
-    Idx         last;
-    std::size_t grain_size;
+        this->blocking_loop(IndexRange<std::size_t>{0, block_count, 1}, [&](std::size_t block) {
+            const std::size_t low  = block * block_size;
+            const std::size_t high = min_size(low + block_size, size);
 
-    IndexRange() = delete;
+            std::size_t true_pos  = true_offsets[block];
+            std::size_t false_pos = true_count + low - true_offsets[block];
 
-    constexpr IndexRange(Idx first, Idx last, std::size_t grain_size)
-        : first(first), last(last), grain_size(grain_size) {}
+            for (std::size_t i = low; i < high; ++i) {
+                const std::size_t pos = matches[i] ? true_pos++ : false_pos++;
+                if (first <= i && i < last) range.begin[pos] = std::move(buffer[i - first]);
+            }
+        });
 
-    IndexRange(Idx first, Idx last)
-        : IndexRange(first, last, max_size(1, (last - first) / (hardware_concurrency() * default_grains_per_thread))) {}
+        return range.begin + true_count;
+    }
 
-    template <class Idx1, class Idx2>
-    constexpr IndexRange(Idx1 first, Idx2 last, std::size_t grain_size)
-        : first(first), last(last), grain_size(grain_size) {}
+    // - 'Container' overloads (3) -
 
-    template <class Idx1, class Idx2>
-    IndexRange(Idx1 first, Idx2 last)
-        : IndexRange(first, last, max_size(1, (last - first) / (hardware_concurrency() * default_grains_per_thread))) {}
-};
+    template <class Container, class Cmp = std::less<>, require_has_some_iter<std::decay_t<Container>> = true>
+    void sort(Container&& container, Cmp&& cmp = Cmp{}) {
+        this->sort(Range{std::forward<Container>(container)}, std::forward<Cmp>(cmp));
+    }
 
-// Note: It is common to have a ranges from 'int' to 'std::size_t' (for example 'IndexRange{0, vec.size()}'),
-//       in such cases we assume 'std::ptrdiff_t' as a reasonable default
+    template <class Container, class Cmp = std::less<>, require_has_some_iter<std::decay_t<Container>> = true>
+    void stable_sort(Container&& container, Cmp&& cmp = Cmp{}) {
+        this->stable_sort(Range{std::forward<Container>(container)}, std::forward<Cmp>(cmp));
+    }
 
-// =================
-// --- Scheduler ---
-// =================
+    template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+    auto partition(Container&& container, Pred&& pred) {
+        return this->partition(Range{std::forward<Container>(container)}, std::forward<Pred>(pred));
+    }
 
-// There is a ton of boilerplate since we need a whole bunch of convenience overloads
-// (ranges / index ranges / containers, blocked functions / iteration functions, etc.),
-// but conceptually it's all quite simple we end up with 2 overloads for tasks,
-// 6+6+3=15 overloads for parallel-for and 4+4+2=10 overloads for reduce
+    // --- Parallel-search API ---
+    // ---------------------------
 
-#define utl_parallel_assert_message                                                                                    \
-    "Awaitable loops require recursive task support from the 'future_type' of 'Scheduler' backend. "                   \
-    "Future can signal such support by  providing a 'using is_recursive = void' member typedef."
-// 'static_assert()' only supports string literals, cannot use constexpr variable here, assert itself
-// shouldn't be included in the macro as it makes error messages uglier due to macro expansion
+    // - 'Range' overloads (4) -
 
-template <class Backend = ThreadPool>
-struct Scheduler {
+    // Returns the first iterator satisfying 'pred', same as 'std::find_if()'. Once a block finds a match, blocks
+    // after it stop or get skipped entirely, blocks before it still have to finish since they could contain an
+    // earlier match. Since blocks are queued in order, earlier blocks usually get searched first.
+    template <class It, class Pred>
+    It find_if(Range<It> range, Pred&& pred) {
+        if (range.grain_size == auto_grain)
+            range.grain_size = default_grain_size(distance_size(range.begin, range.end));
 
-    // --- Backend ---
-    // ---------------
+        std::vector<It> bounds; // block boundaries, the last one is the end of the range
+        for_each_block(range, [&](It low, It) { bounds.push_back(low); });
+        bounds.push_back(range.end);
 
-    Backend backend; // underlying thread pool
+        const std::size_t blocks = bounds.size() - 1;
 
-    template <class T = void>
-    using future_type = typename Backend::template future_type<T>;
+        std::vector<It>          matches(blocks, range.end);
+        std::atomic<std::size_t> first_match{blocks}; // earliest block with a match so far, 'blocks' if none
 
-    template <class... Args>
-    explicit Scheduler(Args&&... args) : backend(std::forward<Args>(args)...) {}
+        this->blocking_loop(IndexRange<std::size_t>{0, blocks, 1}, [&](std::size_t block) {
+            for (It it = bounds[block]; it != bounds[block + 1]; ++it) {
+                if (block > first_match.load(std::memory_order_relaxed)) return;
+                if (!pred(*it)) continue;
 
-    // --- Task API ---
-    // ----------------
+                matches[block] = it;
 
-    template <class F, class... Args>
-    void detached_task(F&& f, Args&&... args) {
-        this->backend.detached_task(std::forward<F>(f), std::forward<Args>(args)...);
-    }
+                std::size_t current = first_match.load(std::memory_order_relaxed);
+                while (block < current && !first_match.compare_exchange_weak(current, block)) {}
+                return;
+            }
+        });
 
-    template <class F, class... Args, class R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
-    future_type<R> awaitable_task(F&& f, Args&&... args) {
-        return this->backend.awaitable_task(std::forward<F>(f), std::forward<Args>(args)...);
+        const std::size_t block = first_match.load(std::memory_order_relaxed);
+        return (block == blocks) ? range.end : matches[block];
     }
 
-    // --- Parallel-for API ---
-    // ------------------------
+    // Any match is enough to know the answer, first match cancels the loop so that queued blocks get skipped,
+    // running blocks poll a flag on the stack, which is cheaper than going through the token for every element
+    template <class It, class Pred>
+    bool any_of(Range<It> range, Pred&& pred) {
+        CancellationToken token;
+        std::atomic<bool> found{false};
 
-    // - 'Range' overloads (6) -
+        this->blocking_loop(range, token, [&](It low, It high) {
+            for (It it = low; it != high && !found.load(std::memory_order_relaxed); ++it) {
+                if (!pred(*it)) continue;
+                found.store(true, std::memory_order_relaxed);
+                token.cancel();
+            }
+        });
 
-    template <class It, class F, require_invocable<F, It, It> = true> // blocked loop iteration overload
-    void detached_loop(Range<It> range, F&& f) {
-        for (It it = range.begin; it < range.end; it += min_size(range.grain_size, range.end - it))
-            this->detached_task(f, it, it + min_size(range.grain_size, range.end - it));
-        // 'min_size(...)' bit takes care of the unevenly sized tail segment
+        return found.load(std::memory_order_relaxed);
     }
 
-    template <class It, class F, require_invocable<F, It> = true> // single loop iteration overload
-    void detached_loop(Range<It> range, F&& f) {
-        auto iterate_block = [f = std::forward<F>(f)](It low, It high) { // combine individual index
-            for (It it = low; it < high; ++it) f(it);                    // calls into blocks and forward
-        }; // into a blocked loop iteration overload
-        this->detached_loop(range, std::move(iterate_block));
+    template <class It, class Pred>
+    bool all_of(Range<It> range, Pred&& pred) {
+        return !this->any_of(range, [&](const auto& value) { return !pred(value); });
     }
 
-    template <class It, class F, require_invocable<F, It, It> = true>
-    void blocking_loop(Range<It> range, F&& f) {
-        std::vector<future_type<>> futures;
+    template <class It, class Pred>
+    bool none_of(Range<It> range, Pred&& pred) {
+        return !this->any_of(range, std::forward<Pred>(pred));
+    }
 
-        for (It it = range.begin; it < range.end; it += min_size(range.grain_size, range.end - it))
-            futures.emplace_back(this->awaitable_task(f, it, it + min_size(range.grain_size, range.end - it)));
+    // - 'Container' overloads (4) -
 
-        for (auto& future : futures) future.wait();
+    template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+    auto find_if(Container&& container, Pred&& pred) {
+        return this->find_if(Range{std::forward<Container>(container)}, std::forward<Pred>(pred));
     }
 
-    template <class It, class F, require_invocable<F, It> = true>
-    void blocking_loop(Range<It> range, F&& f) {
-        auto iterate_block = [f = std::forward<F>(f)](It low, It high) {
-            for (It it = low; it < high; ++it) f(it);
-        };
-        this->blocking_loop(range, std::move(iterate_block));
+    template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+    bool any_of(Container&& container, Pred&& pred) {
+        return this->any_of(Range{std::forward<Container>(container)}, std::forward<Pred>(pred));
     }
 
-    template <class It, class F, require_invocable<F, It, It> = true>
-    future_type<> awaitable_loop(Range<It> range, F&& f) {
-        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
+    template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+    bool all_of(Container&& container, Pred&& pred) {
+        return this->all_of(Range{std::forward<Container>(container)}, std::forward<Pred>(pred));
+    }
 
-        auto submit_loop = [this, range, f = std::forward<F>(f)] { this->blocking_loop(range, f); };
-        return this->awaitable_task(std::move(submit_loop));
-        // to wait for multiple tasks we need a vector of futures, since logically we want API to return regular
-        // 'future_type<>' rather than some composite construct, we can wrap block awaiting into another task
-        // that will "merge" all those futures into a single one for the user, this requires recursive task
-        // support from the backend so it's provided conditionally
+    template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+    bool none_of(Container&& container, Pred&& pred) {
+        return this->none_of(Range{std::forward<Container>(container)}, std::forward<Pred>(pred));
     }
 
-    template <class It, class F, require_invocable<F, It> = true>
-    future_type<> awaitable_loop(Range<It> range, F&& f) {
+    // --- Pipeline API ---
+    // --------------------
+
+    // Runs 'source()' until it returns 'std::nullopt', passing every produced item through the stages,
+    // at most 'max_tokens' items can be in flight at the same time
+    template <class Source, class... Fs>
+    void pipeline(std::size_t max_tokens, Source&& source, Stage<Fs>... stages) {
+        static_assert(sizeof...(Fs) > 0, "Pipeline requires at least one stage after the source.");
         static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
 
-        auto iterate_block = [f = std::forward<F>(f)](It low, It high) {
-            for (It it = low; it < high; ++it) f(it);
-        };
-        return this->awaitable_loop(range, std::move(iterate_block));
+        Pipeline<Backend, std::remove_reference_t<Source>, Fs...>(this->backend, max_tokens, source, stages...).run();
     }
 
-    // - 'IndexRange' overloads (6) -
+private:
+    template <class It, class G>
+    static void for_each_block(const Range<It>& range, G&& g) {
+        if constexpr (is_random_access_v<It>) {
+            for (It it = range.begin; it < range.end; it += min_size(range.grain_size, range.end - it))
+                g(it, it + min_size(range.grain_size, range.end - it));
+            // 'min_size(...)' bit takes care of the unevenly sized tail segment
+        } else {
+            for (It low = range.begin; low != range.end;) {
+                It high = low;
+                for (std::size_t i = 0; i < range.grain_size && high != range.end; ++i) ++high;
+                g(low, high);
+                low = high;
+            }
+        }
+    }
 
-    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
-    void detached_loop(IndexRange<Idx> range, F&& f) {
+    template <class Idx, class G>
+    static void for_each_block(const IndexRange<Idx>& range, G&& g) {
         for (Idx i = range.first; i < range.last; i += static_cast<Idx>(range.grain_size))
-            this->detached_task(f, i, static_cast<Idx>(min_size(i + range.grain_size, range.last)));
+            g(i, static_cast<Idx>(min_size(i + range.grain_size, range.last)));
     }
 
-    template <class Idx, class F, require_invocable<F, Idx> = true>
-    void detached_loop(IndexRange<Idx> range, F&& f) {
-        auto iterate_block = [f = std::forward<F>(f)](Idx low, Idx high) {
-            for (Idx i = low; i < high; ++i) f(i);
-        };
-        this->detached_loop(range, std::move(iterate_block));
+    // Submits 'f(low, high)' for every block of the range, backends supporting bulk submission get all of the
+    // blocks in a single batch, which saves us from locking the queue & waking up a worker once per block
+    template <class T, class R, class F>
+    void detached_blocks(const R& range, F& f) {
+        if constexpr (has_bulk_detached_v<Backend>) {
+            const auto make_block = [&f](T low, T high) { return [f, low, high]() mutable { f(low, high); }; };
+
+            std::vector<std::invoke_result_t<decltype(make_block), T, T>> blocks;
+            for_each_block(range, [&](T low, T high) { blocks.push_back(make_block(low, high)); });
+
+            this->backend.bulk_detached(std::make_move_iterator(blocks.begin()), std::make_move_iterator(blocks.end()));
+        } else {
+            for_each_block(range, [&](T low, T high) { this->detached_task(f, low, high); });
+        }
     }
 
-    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
-    void blocking_loop(IndexRange<Idx> range, F&& f) {
-        std::vector<future_type<>> futures;
+    // Runs 'f(low, high)' for every block of the range & waits for all of them, rethrows the first exception.
+    // Thread pool runs the blocks through a task group, which avoids allocating a future for every block.
+    template <class T, class R, class F>
+    void blocking_blocks(const R& range, F& f) {
+        if constexpr (std::is_same_v<Backend, ThreadPool>) {
+            const auto make_block = [&f](T low, T high) { return [f, low, high]() mutable { f(low, high); }; };
 
-        for (Idx i = range.first; i < range.last; i += static_cast<Idx>(range.grain_size))
-            futures.emplace_back(
-                this->awaitable_task(f, i, static_cast<Idx>(min_size(i + range.grain_size, range.last))));
+            std::vector<std::invoke_result_t<decltype(make_block), T, T>> blocks;
+            for_each_block(range, [&](T low, T high) { blocks.push_back(make_block(low, high)); });
 
-        for (auto& future : futures) future.wait();
+            TaskGroup group(this->backend);
+            group.bulk_run(std::make_move_iterator(blocks.begin()), std::make_move_iterator(blocks.end()));
+            group.wait();
+        } else {
+            std::vector<future_type<>> futures;
+            for_each_block(range, [&](T low, T high) { futures.emplace_back(this->awaitable_task(f, low, high)); });
+
+            for (auto& future : futures) future.wait();
+            for (auto& future : futures) future.get();
+        }
     }
 
-    template <class Idx, class F, require_invocable<F, Idx> = true>
-    void blocking_loop(IndexRange<Idx> range, F&& f) {
-        auto iterate_block = [f = std::forward<F>(f)](Idx low, Idx high) {
-            for (Idx i = low; i < high; ++i) f(i);
-        };
-        this->blocking_loop(range, std::move(iterate_block));
+    // Tiles are processed as an auto-partitioned loop over tile numbers, this way threads take contiguous runs
+    // of tiles, which stay spatially close to each other when tiles are ordered along a space-filling curve
+    template <std::size_t N, class Idx, class F>
+    void blocking_tiles(const Tiling<N, Idx>& tiling, F& f) {
+        this->auto_partitioned_loop(tiling.size(), [&](std::size_t low, std::size_t high) {
+            for (std::size_t t = low; t < high; ++t) tiling.visit(t, f);
+        });
     }
 
-    template <class Idx, class F, require_invocable<F, Idx, Idx> = true>
-    future_type<> awaitable_loop(IndexRange<Idx> range, F&& f) {
-        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
+    // Detached tiles can outlive the caller, tiling gets shared between the tasks instead of being copied into each
+    template <std::size_t N, class Idx, class F>
+    void detached_tiles(Tiling<N, Idx>&& tiling, F&& f) {
+        const auto shared_tiling = std::make_shared<const Tiling<N, Idx>>(std::move(tiling));
 
-        auto submit_loop = [this, range, f = std::forward<F>(f)] { this->blocking_loop(range, f); };
-        return this->awaitable_task(std::move(submit_loop));
+        auto iterate_tiles = [shared_tiling, f = std::forward<F>(f)](std::size_t low, std::size_t high) mutable {
+            for (std::size_t t = low; t < high; ++t) shared_tiling->visit(t, f);
+        };
+        this->detached_blocks<std::size_t>(IndexRange<std::size_t>{0, shared_tiling->size(), 1}, iterate_tiles);
     }
 
-    template <class Idx, class F, require_invocable<F, Idx> = true>
-    future_type<> awaitable_loop(IndexRange<Idx> range, F&& f) {
-        static_assert(is_recursive_v<future_type<>>, utl_parallel_assert_message);
+    std::size_t worker_count() {
+        if constexpr (has_thread_count_v<Backend>) return this->backend.get_thread_count();
+        else return 0; // backend doesn't expose its thread count => all partial results go into the shared slot
+    }
 
-        auto iterate_block = [f = std::forward<F>(f)](Idx low, Idx high) {
-            for (Idx i = low; i < high; ++i) f(i);
+    // Auto-partitioned loop over offsets '[0, size)', this is what TBB calls an "auto partitioner". Work starts
+    // as a single coarse piece per thread, each piece is processed in small steps and whenever backend reports
+    // idle threads in between the steps, upper half of the remaining work gets split off into a new task. Since
+    // idle threads only exist if nothing is left to steal, this only splits when a previous split got stolen.
+    // Backends without 'has_idle_threads()' can't split on demand, they just use the default number of pieces.
+    template <class F>
+    void auto_partitioned_loop(std::size_t size, F&& f) {
+        if (size == 0) return;
+
+        const std::size_t threads = max_size(this->worker_count(), 1);
+        const std::size_t step    = max_size(size / (threads * auto_grain_steps_per_thread), 1);
+
+        const auto run_piece = [&](const auto& self, std::size_t low, std::size_t high) -> void {
+            std::vector<future_type<>> splits;
+
+            const auto wait_for_splits = [&] {
+                for (auto& split : splits) split.wait();
+            };
+
+            try {
+                while (low < high) {
+                    if (high - low >= 2 * step && this->has_idle_threads()) {
+                        const std::size_t mid = low + (high - low) / 2;
+                        splits.emplace_back(this->awaitable_task([&self, mid, high] { self(self, mid, high); }));
+                        high = mid;
+                    } else {
+                        const std::size_t next = min_size(low + step, high);
+                        f(low, next);
+                        low = next;
+                    }
+                }
+            } catch (...) {
+                wait_for_splits(); // splits reference this stack frame, they can't outlive it
+                throw;
+            }
+
+            wait_for_splits();
+            for (auto& split : splits) split.get(); // rethrows exceptions of the splits
         };
-        return this->awaitable_loop(range, std::move(iterate_block));
-    }
 
-    // - 'Container' overloads (3) -
+        const std::size_t pieces = min_size(has_idle_threads_v<Backend> ? threads : threads * default_grains_per_thread,
+                                            (size + step - 1) / step);
 
-    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true> // without SFINAE reqs
-    void detached_loop(Container&& container, F&& f) {                                         // such overloads would
-        this->detached_loop(Range{std::forward<Container>(container)}, std::forward<F>(f));    // always get picked
-    } // over the others
+        std::vector<future_type<>> futures;
 
-    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
-    void blocking_loop(Container&& container, F&& f) {
-        this->blocking_loop(Range{std::forward<Container>(container)}, std::forward<F>(f));
+        for (std::size_t piece = 0; piece < pieces; ++piece) {
+            const std::size_t low  = size * piece / pieces;
+            const std::size_t high = size * (piece + 1) / pieces;
+            futures.emplace_back(this->awaitable_task([&run_piece, low, high] { run_piece(run_piece, low, high); }));
+        }
+
+        for (auto& future : futures) future.wait();
+        for (auto& future : futures) future.get();
+        // not using 'blocking_loop()' here since that would recursively instantiate auto-partitioning templates
     }
 
-    template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
-    future_type<> awaitable_loop(Container&& container, F&& f) {
-        return this->awaitable_loop(Range{std::forward<Container>(container)}, std::forward<F>(f));
+    bool has_idle_threads() {
+        if constexpr (has_idle_threads_v<Backend>) return this->backend.has_idle_threads();
+        else return false;
     }
 
-    // --- Parallel-reduce API ---
-    // ---------------------------
+    // Merge sort, chunks of 'grain_size' get sorted in parallel, after which sorted runs get merged pairwise
+    // in rounds, ping-ponging between the range and the buffer. Merges themselves are also parallel, output
+    // of each merge is split into pieces of 'grain_size' that can be merged independently (see 'merge_round()').
+    template <bool stable, class It, class Cmp>
+    void merge_sort(Range<It> range, Cmp& cmp) {
+        using value_type = typename std::iterator_traits<It>::value_type;
 
-    // - 'Range' overloads (2) -
+        const std::size_t size       = range.end - range.begin;
+        const std::size_t chunk_size = resolve_grain_size(range.grain_size, size);
 
-    template <class It, class Op, class R = typename It::value_type>
-    R blocking_reduce(Range<It> range, Op&& op) {
-        if (range.begin == range.end) throw std::runtime_error("Reduction over an empty range is undefined");
+        const auto serial_sort = [&](It first, It last) {
+            if constexpr (stable) std::stable_sort(first, last, cmp);
+            else std::sort(first, last, cmp);
+        };
 
-        R          result = *range.begin;
-        std::mutex result_mutex;
+        if (size < min_parallel_sort_size || size <= chunk_size) return serial_sort(range.begin, range.end);
 
-        this->blocking_loop(Range<It>{range.begin + 1, range.end}, [&](It low, It high) {
-            R partial_result = *low;
-            for (auto it = low + 1; it != high; ++it) partial_result = op(partial_result, *it);
+        this->blocking_loop(Range<It>{range.begin, range.end, chunk_size}, serial_sort);
 
-            const std::scoped_lock result_lock(result_mutex);
-            result = op(result, partial_result);
-        });
+        std::vector<value_type> buffer(std::make_move_iterator(range.begin), std::make_move_iterator(range.end));
 
-        return result;
+        bool in_buffer = true;
+
+        for (std::size_t width = chunk_size; width < size; width *= 2) {
+            if (in_buffer) this->merge_round(buffer.begin(), range.begin, size, width, chunk_size, cmp);
+            else this->merge_round(range.begin, buffer.begin(), size, width, chunk_size, cmp);
+            in_buffer = !in_buffer;
+        }
+
+        if (in_buffer)
+            this->blocking_loop(IndexRange<std::size_t>{0, size, chunk_size}, [&](std::size_t low, std::size_t high) {
+                std::move(buffer.begin() + low, buffer.begin() + high, range.begin + low);
+            });
     }
 
-    template <class It, class Op, class R = typename It::value_type>
-    future_type<R> awaitable_reduce(Range<It> range, Op&& op) {
-        auto submit_reduce = [this, range, op = std::forward<Op>(op)] { return this->blocking_reduce(range, op); };
-        return this->awaitable_task(std::move(submit_reduce));
+    // Merges pairs of adjacent sorted runs of 'width' from 'src' into 'dst'. To merge in parallel we use the merge
+    // path approach: for every output offset 'd' binary search finds how many of the first 'd' merged elements
+    // come from the left run, this splits both runs into pieces that merge independently of each other.
+    // Note: Splits have to be computed in a separate pass, otherwise a search could read elements already moved
+    //       out by a neighbouring piece.
+    template <class Src, class Dst, class Cmp>
+    void merge_round(Src src, Dst dst, std::size_t size, std::size_t width, std::size_t piece_size, Cmp& cmp) {
+        const std::size_t pair_width      = 2 * width;
+        const std::size_t pair_count      = (size + pair_width - 1) / pair_width;
+        const std::size_t pieces_per_pair = (pair_width + piece_size - 1) / piece_size;
+
+        struct Piece {
+            std::size_t first, mid, last; // pair of runs
+            std::size_t low, high;        // merged output
+        };
+
+        const auto get_piece = [&](std::size_t task) {
+            const std::size_t pair  = task / pieces_per_pair;
+            const std::size_t piece = task % pieces_per_pair;
+
+            const std::size_t first = pair * pair_width;
+            const std::size_t mid   = min_size(first + width, size);
+            const std::size_t last  = min_size(first + pair_width, size);
+            const std::size_t low   = min_size(first + piece * piece_size, last);
+            const std::size_t high  = min_size(low + piece_size, last);
+
+            return Piece{first, mid, last, low, high}; // tail pair might have fewer pieces, those will be empty
+        };
+
+        const std::size_t        task_count = pair_count * pieces_per_pair;
+        std::vector<std::size_t> left_splits(task_count); // how much of the left run precedes the piece
+
+        this->blocking_loop(IndexRange<std::size_t>{0, task_count, 1}, [&](std::size_t task) {
+            const Piece p = get_piece(task);
+            if (p.low == p.high) return;
+
+            const std::size_t left_size  = p.mid - p.first;
+            const std::size_t right_size = p.last - p.mid;
+
+            left_splits[task] = merge_path(p.low - p.first, src + p.first, left_size, src + p.mid, right_size, cmp);
+        });
+
+        this->blocking_loop(IndexRange<std::size_t>{0, task_count, 1}, [&](std::size_t task) {
+            const Piece p = get_piece(task);
+            if (p.low == p.high) return;
+
+            const std::size_t left_low   = left_splits[task];
+            const std::size_t left_high  = (p.high == p.last) ? p.mid - p.first : left_splits[task + 1];
+            const std::size_t right_low  = p.low - p.first - left_low;
+            const std::size_t right_high = p.high - p.first - left_high;
+
+            const Src left  = src + p.first;
+            const Src right = src + p.mid;
+
+            std::merge(std::make_move_iterator(left + left_low), std::make_move_iterator(left + left_high),
+                       std::make_move_iterator(right + right_low), std::make_move_iterator(right + right_high),
+                       dst + p.low, cmp);
+        });
     }
 
-    // - 'Container' overloads (2) -
+    // Returns how many of the first 'd' elements of a stable merge come from the left run,
+    // ties go to the left run, which is consistent with 'std::merge()' & keeps merging stable
+    template <class Src, class Cmp>
+    static std::size_t merge_path(std::size_t d, Src left, std::size_t left_size, Src right, std::size_t right_size,
+                                  Cmp& cmp) {
+        std::size_t low  = (d > right_size) ? d - right_size : 0;
+        std::size_t high = min_size(d, left_size);
 
-    template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
-    R blocking_reduce(Container&& container, Op&& op) {
-        return this->blocking_reduce(Range{std::forward<Container>(container)}, std::forward<Op>(op));
+        while (low < high) {
+            const std::size_t i = low + (high - low) / 2;
+            if (!cmp(right[d - i - 1], left[i])) low = i + 1; // 'left[i]' precedes 'right[d - i - 1]'
+            else high = i;
+        }
+
+        return low;
     }
 
-    template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
-    future_type<R> awaitable_reduce(Container&& container, Op&& op) {
-        return this->awaitable_reduce(Range{std::forward<Container>(container)}, std::forward<Op>(op));
+    // Scan is done in 3 phases over blocks of 'grain_size':
+    //    1. Up-sweep   - blocks get reduced in parallel, last block is skipped since its total affects nothing
+    //    2. Carries    - serial exclusive scan over block totals gives us a carry-in value for every block
+    //    3. Down-sweep - blocks get scanned in parallel, starting from their carry
+    // Empty 'init' means inclusive scan, block carry is empty only for the very first block of an inclusive scan.
+    // Input is always read before the corresponding output is written, which makes in-place scans valid.
+    template <class T, class Value, class OutIt, class Op>
+    OutIt scan(std::size_t size, std::size_t grain_size, Value& value, OutIt out, std::optional<T> init, Op& op) {
+        const bool inclusive = !init.has_value();
+
+        const auto scan_block = [&](std::size_t low, std::size_t high, const std::optional<T>& carry) {
+            if (low == high) return;
+
+            if (inclusive) {
+                T acc = carry ? T(op(*carry, value(low))) : T(value(low));
+                out[low] = acc;
+                for (std::size_t i = low + 1; i < high; ++i) out[i] = acc = op(acc, value(i));
+            } else {
+                T acc = *carry;
+                for (std::size_t i = low; i < high; ++i) {
+                    T next = op(acc, value(i));
+                    out[i] = std::move(acc);
+                    acc    = std::move(next);
+                }
+            }
+        };
+
+        grain_size                    = resolve_grain_size(grain_size, size);
+        const std::size_t block_count = (size + grain_size - 1) / grain_size;
+
+        if (size < min_parallel_scan_size || block_count < 2) {
+            scan_block(0, size, init);
+            return out + size;
+        }
+
+        std::vector<std::optional<T>> carries(block_count);
+
+        this->blocking_loop(IndexRange<std::size_t>{0, block_count - 1, 1}, [&](std::size_t block) {
+            const std::size_t low  = block * grain_size;
+            const std::size_t high = min_size(low + grain_size, size);
+
+            T acc = value(low);
+            for (std::size_t i = low + 1; i < high; ++i) acc = op(acc, value(i));
+
+            carries[block + 1] = std::move(acc); // block total temporarily lives in the slot of the next block
+        });
+
+        carries[0] = std::move(init);
+        for (std::size_t block = 1; block < block_count; ++block)
+            if (carries[block - 1]) carries[block] = op(*carries[block - 1], *carries[block]);
+
+        this->blocking_loop(IndexRange<std::size_t>{0, block_count, 1}, [&](std::size_t block) {
+            const std::size_t low  = block * grain_size;
+            const std::size_t high = min_size(low + grain_size, size);
+
+            scan_block(low, high, carries[block]);
+        });
+
+        return out + size;
     }
 };
 
 #undef utl_parallel_assert_message
+#undef utl_parallel_random_access_message
 
 // =========================
 // --- Binary operations ---
@@ -8939,14 +13249,277 @@ template <>
 struct max<void> {
     template <class T1, class T2>
     constexpr auto operator()(T1&& lhs, T2&& rhs) const
-        noexcept(noexcept(std::less<>{}(lhs, rhs) ? std::forward<T1>(rhs) : std::forward<T2>(lhs)))
-            -> decltype(std::less<>{}(lhs, rhs) ? std::forward<T1>(rhs) : std::forward<T2>(lhs)) {
-        return std::less<>{}(lhs, rhs) ? std::forward<T1>(rhs) : std::forward<T2>(lhs);
+        noexcept(noexcept(std::less<>{}(lhs, rhs) ? std::forward<T2>(rhs) : std::forward<T1>(lhs)))
+            -> decltype(std::less<>{}(lhs, rhs) ? std::forward<T2>(rhs) : std::forward<T1>(lhs)) {
+        return std::less<>{}(lhs, rhs) ? std::forward<T2>(rhs) : std::forward<T1>(lhs);
     }
 
     using is_transparent = std::less<>::is_transparent;
 };
 
+// =============================
+// --- Concurrent containers ---
+// =============================
+
+// --- MPMC queue ---
+// ------------------
+
+// Bounded lock-free multi-producer multi-consumer queue, based on the D. Vyukov bounded MPMC queue. Every cell
+// of the ring buffer has a sequence number that tells producers & consumers whether the cell is free for the
+// current lap, claiming a cell is a single CAS on the enqueue / dequeue position, after that the cell is owned
+// exclusively until its sequence number is published. Producers & consumers only contend with their own kind.
+//
+// Cell cannot be given up once claimed, which is why values have to be nothrow-move-constructible.
+
+template <class T>
+class MPMCQueue {
+    static_assert(std::is_nothrow_move_constructible_v<T>, "MPMCQueue requires nothrow-move-constructible values.");
+
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        [[nodiscard]] T* get() noexcept { return std::launder(reinterpret_cast<T*>(this->storage)); }
+    };
+
+    static constexpr auto relaxed = std::memory_order_relaxed;
+    static constexpr auto acquire = std::memory_order_acquire;
+    static constexpr auto release = std::memory_order_release;
+
+    std::size_t             mask;
+    std::unique_ptr<Cell[]> cells;
+
+    alignas(cache_line_size) std::atomic<std::size_t> enqueue_pos{0};
+    alignas(cache_line_size) std::atomic<std::size_t> dequeue_pos{0};
+
+    static std::size_t round_up_capacity(std::size_t capacity) noexcept {
+        std::size_t rounded = 2; // algorithm needs at least 2 cells to tell a full queue from an empty one
+        while (rounded < capacity) rounded *= 2;
+        return rounded;
+    }
+
+public:
+    explicit MPMCQueue(std::size_t capacity)
+        : mask(round_up_capacity(capacity) - 1), cells(std::make_unique<Cell[]>(this->mask + 1)) {
+        for (std::size_t i = 0; i <= this->mask; ++i) this->cells[i].sequence.store(i, relaxed);
+    }
+
+    MPMCQueue(const MPMCQueue&)            = delete;
+    MPMCQueue(MPMCQueue&&)                 = delete;
+    MPMCQueue& operator=(const MPMCQueue&) = delete;
+    MPMCQueue& operator=(MPMCQueue&&)      = delete;
+
+    ~MPMCQueue() {
+        if constexpr (!std::is_trivially_destructible_v<T>)
+            while (this->try_pop().has_value()) {} // destroys the remaining values
+    }
+
+    // Moves 'value' into the queue, returns 'false' and leaves 'value' untouched if the queue is full
+    [[nodiscard]] bool try_push(T&& value) noexcept {
+        Cell*       cell;
+        std::size_t pos = this->enqueue_pos.load(relaxed);
+
+        while (true) {
+            cell = &this->cells[pos & this->mask];
+
+            const std::size_t    sequence = cell->sequence.load(acquire);
+            const std::ptrdiff_t diff     = static_cast<std::ptrdiff_t>(sequence - pos);
+
+            if (diff == 0) {
+                if (this->enqueue_pos.compare_exchange_weak(pos, pos + 1, relaxed)) break;
+            } else if (diff < 0) {
+                return false; // cell still holds a value from the previous lap => queue is full
+            } else {
+                pos = this->enqueue_pos.load(relaxed); // another producer got ahead of us
+            }
+        }
+
+        ::new (static_cast<void*>(cell->storage)) T(std::move(value));
+        cell->sequence.store(pos + 1, release);
+        return true;
+    }
+
+    [[nodiscard]] bool try_push(const T& value) {
+        T copy = value;
+        return this->try_push(std::move(copy));
+    }
+
+    template <class... Args>
+    [[nodiscard]] bool try_emplace(Args&&... args) {
+        return this->try_push(T(std::forward<Args>(args)...));
+    }
+
+    // Moves the oldest value out of the queue, returns 'std::nullopt' if the queue is empty
+    [[nodiscard]] std::optional<T> try_pop() noexcept {
+        Cell*       cell;
+        std::size_t pos = this->dequeue_pos.load(relaxed);
+
+        while (true) {
+            cell = &this->cells[pos & this->mask];
+
+            const std::size_t    sequence = cell->sequence.load(acquire);
+            const std::ptrdiff_t diff     = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+
+            if (diff == 0) {
+                if (this->dequeue_pos.compare_exchange_weak(pos, pos + 1, relaxed)) break;
+            } else if (diff < 0) {
+                return std::nullopt; // cell hasn't been filled for this lap yet => queue is empty
+            } else {
+                pos = this->dequeue_pos.load(relaxed); // another consumer got ahead of us
+            }
+        }
+
+        std::optional<T> value(std::move(*cell->get()));
+        cell->get()->~T();
+        cell->sequence.store(pos + this->mask + 1, release); // frees the cell for the next lap of producers
+        return value;
+    }
+
+    [[nodiscard]] bool try_pop(T& value) {
+        std::optional<T> popped = this->try_pop();
+        if (popped) value = std::move(*popped);
+        return popped.has_value();
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return this->mask + 1; }
+
+    // Approximate, the value might already be outdated by the time it's returned
+    [[nodiscard]] std::size_t size() const noexcept {
+        const std::size_t enqueued = this->enqueue_pos.load(relaxed);
+        const std::size_t dequeued = this->dequeue_pos.load(relaxed);
+        return (enqueued > dequeued) ? min_size(enqueued - dequeued, this->capacity()) : 0;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return this->size() == 0; }
+};
+
+// --- Sharded map ---
+// -------------------
+
+// Hash map split into independently locked shards, every shard sits in its own cache line so threads working
+// with different shards contend neither on the lock nor on the memory. Shard is selected by a remixed hash,
+// 'std::unordered_map' picks buckets by the same hash & standard hashes of integers are usually an identity,
+// without remixing every shard would end up using only a fraction of its buckets.
+
+template <class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+class ShardedMap {
+    using map_type = std::unordered_map<K, V, Hash, KeyEqual>;
+
+    struct alignas(cache_line_size) Shard {
+        mutable std::mutex mutex;
+        map_type           map;
+    };
+
+    std::size_t              mask;
+    std::unique_ptr<Shard[]> shards;
+    Hash                     hash;
+
+    static std::size_t round_up_shard_count(std::size_t count) noexcept {
+        std::size_t rounded = 1;
+        while (rounded < count) rounded *= 2;
+        return rounded;
+    }
+
+    // Finalizer of the MurmurHash3, spreads every bit of the input across the whole output
+    [[nodiscard]] static constexpr std::uint64_t mix(std::uint64_t h) noexcept {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ull;
+        h ^= h >> 33;
+        return h;
+    }
+
+    [[nodiscard]] Shard& shard_of(const K& key) const {
+        return this->shards[mix(static_cast<std::uint64_t>(this->hash(key))) & this->mask];
+    }
+
+public:
+    explicit ShardedMap(std::size_t shard_count = hardware_concurrency() * 4)
+        : mask(round_up_shard_count(shard_count) - 1), shards(std::make_unique<Shard[]>(this->mask + 1)) {}
+
+    ShardedMap(const ShardedMap&)            = delete;
+    ShardedMap(ShardedMap&&)                 = delete;
+    ShardedMap& operator=(const ShardedMap&) = delete;
+    ShardedMap& operator=(ShardedMap&&)      = delete;
+
+    // Inserts a value constructed from 'args...' unless 'key' is already present, returns whether it was inserted
+    template <class... Args>
+    bool try_emplace(const K& key, Args&&... args) {
+        Shard&                 shard = this->shard_of(key);
+        const std::scoped_lock lock(shard.mutex);
+        return shard.map.try_emplace(key, std::forward<Args>(args)...).second;
+    }
+
+    // Inserts or overwrites the value, returns whether it was inserted
+    bool insert_or_assign(const K& key, V value) {
+        Shard&                 shard = this->shard_of(key);
+        const std::scoped_lock lock(shard.mutex);
+        return shard.map.insert_or_assign(key, std::move(value)).second;
+    }
+
+    // Invokes 'f(value)' under the lock of the shard, value is default-constructed if the key is not present yet
+    template <class F>
+    void update(const K& key, F&& f) {
+        Shard&                 shard = this->shard_of(key);
+        const std::scoped_lock lock(shard.mutex);
+        std::forward<F>(f)(shard.map[key]);
+    }
+
+    // Returns a copy of the value, references can't be returned since the value may be modified concurrently
+    [[nodiscard]] std::optional<V> get(const K& key) const {
+        Shard&                 shard = this->shard_of(key);
+        const std::scoped_lock lock(shard.mutex);
+
+        const auto it = shard.map.find(key);
+        if (it == shard.map.end()) return std::nullopt;
+        return it->second;
+    }
+
+    [[nodiscard]] bool contains(const K& key) const {
+        Shard&                 shard = this->shard_of(key);
+        const std::scoped_lock lock(shard.mutex);
+        return shard.map.find(key) != shard.map.end();
+    }
+
+    bool erase(const K& key) {
+        Shard&                 shard = this->shard_of(key);
+        const std::scoped_lock lock(shard.mutex);
+        return shard.map.erase(key) != 0;
+    }
+
+    // Invokes 'f(key, value)' for every element, shards get locked one at a time,
+    // which means concurrent modifications of other shards can happen during the traversal
+    template <class F>
+    void for_each(F&& f) {
+        for (std::size_t i = 0; i <= this->mask; ++i) {
+            const std::scoped_lock lock(this->shards[i].mutex);
+            for (auto& [key, value] : this->shards[i].map) f(key, value);
+        }
+    }
+
+    // Approximate when there are concurrent modifications, shards get counted one at a time
+    [[nodiscard]] std::size_t size() const {
+        std::size_t total = 0;
+        for (std::size_t i = 0; i <= this->mask; ++i) {
+            const std::scoped_lock lock(this->shards[i].mutex);
+            total += this->shards[i].map.size();
+        }
+        return total;
+    }
+
+    [[nodiscard]] bool empty() const { return this->size() == 0; }
+
+    void clear() {
+        for (std::size_t i = 0; i <= this->mask; ++i) {
+            const std::scoped_lock lock(this->shards[i].mutex);
+            this->shards[i].map.clear();
+        }
+    }
+
+    [[nodiscard]] std::size_t shard_count() const noexcept { return this->mask + 1; }
+};
+
 // =======================
 // --- Global executor ---
 // =======================
@@ -8965,10 +13538,23 @@ inline void set_thread_count(std::size_t count = hardware_concurrency()) {
     global_scheduler().backend.set_thread_count(count);
 }
 
+inline void set_thread_count(std::size_t count, Placement placement) {
+    global_scheduler().backend.set_thread_count(count, std::move(placement));
+}
+
 inline std::size_t get_thread_count() { return global_scheduler().backend.get_thread_count(); }
 
 inline void wait() { global_scheduler().backend.wait(); }
 
+inline TaskGroup::TaskGroup() : TaskGroup(global_scheduler().backend) {}
+
+template <class T>
+PerWorker<T>::PerWorker() : PerWorker(global_scheduler().backend) {}
+
+template <class T>
+template <class F, require<std::is_invocable_r_v<T, F&>>>
+PerWorker<T>::PerWorker(F factory) : PerWorker(global_scheduler().backend, std::move(factory)) {}
+
 // --- Scheduler API ---
 // ---------------------
 
@@ -8987,6 +13573,44 @@ Future<R> awaitable_task(F&& f, Args&&... args) {
     return global_scheduler().awaitable_task(std::forward<F>(f), std::forward<Args>(args)...);
 }
 
+template <class F, class... Args>
+void detached_task(Priority priority, F&& f, Args&&... args) {
+    global_scheduler().detached_task(priority, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+template <class F, class... Args, class R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>>
+Future<R> awaitable_task(Priority priority, F&& f, Args&&... args) {
+    return global_scheduler().awaitable_task(priority, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+// - Coroutine API -
+
+#ifdef utl_parallel_has_coroutines
+[[nodiscard]] inline auto schedule() noexcept { return global_scheduler().backend.schedule(); }
+
+template <class T>
+Coroutine<T> spawn(Coroutine<T> coroutine) {
+    return global_scheduler().backend.spawn(std::move(coroutine));
+}
+
+template <class... Ts>
+Coroutine<std::tuple<non_void_t<Ts>...>> when_all(Coroutine<Ts>... coroutines) {
+    return global_scheduler().backend.when_all(std::move(coroutines)...);
+}
+
+template <class T>
+Coroutine<std::conditional_t<std::is_void_v<T>, void, std::vector<T>>> when_all(std::vector<Coroutine<T>> coroutines) {
+    return global_scheduler().backend.when_all(std::move(coroutines));
+}
+#endif
+
+// - Fork-join API -
+
+template <class F, class... Fs>
+void invoke(F&& f, Fs&&... fs) {
+    global_scheduler().invoke(std::forward<F>(f), std::forward<Fs>(fs)...);
+}
+
 // - Parallel-for API -
 
 template <class It, class F>
@@ -9019,6 +13643,36 @@ Future<> awaitable_loop(IndexRange<Idx> range, F&& f) {
     return global_scheduler().awaitable_loop(range, std::forward<F>(f));
 }
 
+template <class Idx, class F>
+void detached_loop(IndexRange2D<Idx> range, F&& f) {
+    global_scheduler().detached_loop(range, std::forward<F>(f));
+}
+
+template <class Idx, class F>
+void blocking_loop(IndexRange2D<Idx> range, F&& f) {
+    global_scheduler().blocking_loop(range, std::forward<F>(f));
+}
+
+template <class Idx, class F>
+Future<> awaitable_loop(IndexRange2D<Idx> range, F&& f) {
+    return global_scheduler().awaitable_loop(range, std::forward<F>(f));
+}
+
+template <class Idx, class F>
+void detached_loop(IndexRange3D<Idx> range, F&& f) {
+    global_scheduler().detached_loop(range, std::forward<F>(f));
+}
+
+template <class Idx, class F>
+void blocking_loop(IndexRange3D<Idx> range, F&& f) {
+    global_scheduler().blocking_loop(range, std::forward<F>(f));
+}
+
+template <class Idx, class F>
+Future<> awaitable_loop(IndexRange3D<Idx> range, F&& f) {
+    return global_scheduler().awaitable_loop(range, std::forward<F>(f));
+}
+
 template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
 void detached_loop(Container&& container, F&& f) {
     global_scheduler().detached_loop(std::forward<Container>(container), std::forward<F>(f));
@@ -9034,6 +13688,39 @@ Future<> awaitable_loop(Container&& container, F&& f) {
     return global_scheduler().awaitable_loop(std::forward<Container>(container), std::forward<F>(f));
 }
 
+template <class R, class F, require_no_iter<R> = true>
+void detached_loop(R range, CancellationToken token, F&& f) {
+    global_scheduler().detached_loop(range, std::move(token), std::forward<F>(f));
+}
+
+template <class R, class F, require_no_iter<R> = true>
+void blocking_loop(R range, CancellationToken token, F&& f) {
+    global_scheduler().blocking_loop(range, std::move(token), std::forward<F>(f));
+}
+
+template <class R, class F, require_no_iter<R> = true>
+Future<> awaitable_loop(R range, CancellationToken token, F&& f) {
+    return global_scheduler().awaitable_loop(range, std::move(token), std::forward<F>(f));
+}
+
+template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+void detached_loop(Container&& container, CancellationToken token, F&& f) {
+    global_scheduler().detached_loop(std::forward<Container>(container), std::move(token), std::forward<F>(f));
+}
+
+template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+void blocking_loop(Container&& container, CancellationToken token, F&& f) {
+    global_scheduler().blocking_loop(std::forward<Container>(container), std::move(token), std::forward<F>(f));
+}
+
+template <class Container, class F, require_has_some_iter<std::decay_t<Container>> = true>
+Future<> awaitable_loop(Container&& container, CancellationToken token, F&& f) {
+    return global_scheduler().awaitable_loop(std::forward<Container>(container), std::move(token),
+                                             std::forward<F>(f));
+}
+
+// - Parallel-reduce API -
+
 template <class It, class Op, class R = typename It::value_type>
 R blocking_reduce(Range<It> range, Op&& op) {
     return global_scheduler().blocking_reduce(range, std::forward<Op>(op));
@@ -9054,8 +13741,221 @@ Future<R> awaitable_reduce(Container&& container, Op&& op) {
     return global_scheduler().awaitable_reduce(std::forward<Container>(container), std::forward<Op>(op));
 }
 
+template <class It, class Op, class R = typename It::value_type>
+R blocking_deterministic_reduce(Range<It> range, Op&& op) {
+    return global_scheduler().blocking_deterministic_reduce(range, std::forward<Op>(op));
+}
+
+template <class It, class Op, class R = typename It::value_type>
+Future<R> awaitable_deterministic_reduce(Range<It> range, Op&& op) {
+    return global_scheduler().awaitable_deterministic_reduce(range, std::forward<Op>(op));
+}
+
+template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
+R blocking_deterministic_reduce(Container&& container, Op&& op) {
+    return global_scheduler().blocking_deterministic_reduce(std::forward<Container>(container), std::forward<Op>(op));
+}
+
+template <class Container, class Op, class R = typename std::decay_t<Container>::value_type>
+Future<R> awaitable_deterministic_reduce(Container&& container, Op&& op) {
+    return global_scheduler().awaitable_deterministic_reduce(std::forward<Container>(container), std::forward<Op>(op));
+}
+
+template <class It, class T, class ReduceOp, class TransformOp>
+T blocking_transform_reduce(Range<It> range, T init, ReduceOp&& reduce_op, TransformOp&& transform_op) {
+    return global_scheduler().blocking_transform_reduce(range, std::move(init), std::forward<ReduceOp>(reduce_op),
+                                                        std::forward<TransformOp>(transform_op));
+}
+
+template <class It, class T, class ReduceOp, class TransformOp>
+Future<T> awaitable_transform_reduce(Range<It> range, T init, ReduceOp&& reduce_op, TransformOp&& transform_op) {
+    return global_scheduler().awaitable_transform_reduce(range, std::move(init), std::forward<ReduceOp>(reduce_op),
+                                                         std::forward<TransformOp>(transform_op));
+}
+
+template <class Idx, class T, class ReduceOp, class TransformOp>
+T blocking_transform_reduce(IndexRange<Idx> range, T init, ReduceOp&& reduce_op, TransformOp&& transform_op) {
+    return global_scheduler().blocking_transform_reduce(range, std::move(init), std::forward<ReduceOp>(reduce_op),
+                                                        std::forward<TransformOp>(transform_op));
+}
+
+template <class Idx, class T, class ReduceOp, class TransformOp>
+Future<T> awaitable_transform_reduce(IndexRange<Idx> range, T init, ReduceOp&& reduce_op,
+                                     TransformOp&& transform_op) {
+    return global_scheduler().awaitable_transform_reduce(range, std::move(init), std::forward<ReduceOp>(reduce_op),
+                                                         std::forward<TransformOp>(transform_op));
+}
+
+template <class Container, class T, class ReduceOp, class TransformOp,
+          require_has_some_iter<std::decay_t<Container>> = true>
+T blocking_transform_reduce(Container&& container, T init, ReduceOp&& reduce_op, TransformOp&& transform_op) {
+    return global_scheduler().blocking_transform_reduce(std::forward<Container>(container), std::move(init),
+                                                        std::forward<ReduceOp>(reduce_op),
+                                                        std::forward<TransformOp>(transform_op));
+}
+
+template <class Container, class T, class ReduceOp, class TransformOp,
+          require_has_some_iter<std::decay_t<Container>> = true>
+Future<T> awaitable_transform_reduce(Container&& container, T init, ReduceOp&& reduce_op,
+                                     TransformOp&& transform_op) {
+    return global_scheduler().awaitable_transform_reduce(std::forward<Container>(container), std::move(init),
+                                                         std::forward<ReduceOp>(reduce_op),
+                                                         std::forward<TransformOp>(transform_op));
+}
+
+// - Parallel-scan API -
+
+template <class It, class OutIt, class Op>
+OutIt blocking_inclusive_scan(Range<It> range, OutIt out, Op&& op) {
+    return global_scheduler().blocking_inclusive_scan(range, out, std::forward<Op>(op));
+}
+
+template <class It, class OutIt, class Op>
+Future<OutIt> awaitable_inclusive_scan(Range<It> range, OutIt out, Op&& op) {
+    return global_scheduler().awaitable_inclusive_scan(range, out, std::forward<Op>(op));
+}
+
+template <class It, class OutIt, class T, class Op>
+OutIt blocking_exclusive_scan(Range<It> range, OutIt out, T init, Op&& op) {
+    return global_scheduler().blocking_exclusive_scan(range, out, std::move(init), std::forward<Op>(op));
+}
+
+template <class It, class OutIt, class T, class Op>
+Future<OutIt> awaitable_exclusive_scan(Range<It> range, OutIt out, T init, Op&& op) {
+    return global_scheduler().awaitable_exclusive_scan(range, out, std::move(init), std::forward<Op>(op));
+}
+
+template <class Idx, class OutIt, class Op, class F>
+OutIt blocking_inclusive_scan(IndexRange<Idx> range, OutIt out, Op&& op, F&& f) {
+    return global_scheduler().blocking_inclusive_scan(range, out, std::forward<Op>(op), std::forward<F>(f));
+}
+
+template <class Idx, class OutIt, class Op, class F>
+Future<OutIt> awaitable_inclusive_scan(IndexRange<Idx> range, OutIt out, Op&& op, F&& f) {
+    return global_scheduler().awaitable_inclusive_scan(range, out, std::forward<Op>(op), std::forward<F>(f));
+}
+
+template <class Idx, class OutIt, class T, class Op, class F>
+OutIt blocking_exclusive_scan(IndexRange<Idx> range, OutIt out, T init, Op&& op, F&& f) {
+    return global_scheduler().blocking_exclusive_scan(range, out, std::move(init), std::forward<Op>(op),
+                                                      std::forward<F>(f));
+}
+
+template <class Idx, class OutIt, class T, class Op, class F>
+Future<OutIt> awaitable_exclusive_scan(IndexRange<Idx> range, OutIt out, T init, Op&& op, F&& f) {
+    return global_scheduler().awaitable_exclusive_scan(range, out, std::move(init), std::forward<Op>(op),
+                                                       std::forward<F>(f));
+}
+
+template <class Container, class OutIt, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+OutIt blocking_inclusive_scan(Container&& container, OutIt out, Op&& op) {
+    return global_scheduler().blocking_inclusive_scan(std::forward<Container>(container), out, std::forward<Op>(op));
+}
+
+template <class Container, class OutIt, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+Future<OutIt> awaitable_inclusive_scan(Container&& container, OutIt out, Op&& op) {
+    return global_scheduler().awaitable_inclusive_scan(std::forward<Container>(container), out, std::forward<Op>(op));
+}
+
+template <class Container, class OutIt, class T, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+OutIt blocking_exclusive_scan(Container&& container, OutIt out, T init, Op&& op) {
+    return global_scheduler().blocking_exclusive_scan(std::forward<Container>(container), out, std::move(init),
+                                                      std::forward<Op>(op));
+}
+
+template <class Container, class OutIt, class T, class Op, require_has_some_iter<std::decay_t<Container>> = true>
+Future<OutIt> awaitable_exclusive_scan(Container&& container, OutIt out, T init, Op&& op) {
+    return global_scheduler().awaitable_exclusive_scan(std::forward<Container>(container), out, std::move(init),
+                                                       std::forward<Op>(op));
+}
+
+// - Parallel-sort API -
+
+template <class It, class Cmp = std::less<>>
+void sort(Range<It> range, Cmp&& cmp = Cmp{}) {
+    global_scheduler().sort(range, std::forward<Cmp>(cmp));
+}
+
+template <class It, class Cmp = std::less<>>
+void stable_sort(Range<It> range, Cmp&& cmp = Cmp{}) {
+    global_scheduler().stable_sort(range, std::forward<Cmp>(cmp));
+}
+
+template <class It, class Pred>
+It partition(Range<It> range, Pred&& pred) {
+    return global_scheduler().partition(range, std::forward<Pred>(pred));
+}
+
+template <class Container, class Cmp = std::less<>, require_has_some_iter<std::decay_t<Container>> = true>
+void sort(Container&& container, Cmp&& cmp = Cmp{}) {
+    global_scheduler().sort(std::forward<Container>(container), std::forward<Cmp>(cmp));
+}
+
+template <class Container, class Cmp = std::less<>, require_has_some_iter<std::decay_t<Container>> = true>
+void stable_sort(Container&& container, Cmp&& cmp = Cmp{}) {
+    global_scheduler().stable_sort(std::forward<Container>(container), std::forward<Cmp>(cmp));
+}
+
+template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+auto partition(Container&& container, Pred&& pred) {
+    return global_scheduler().partition(std::forward<Container>(container), std::forward<Pred>(pred));
+}
+
+// - Parallel-search API -
+
+template <class It, class Pred>
+It find_if(Range<It> range, Pred&& pred) {
+    return global_scheduler().find_if(range, std::forward<Pred>(pred));
+}
+
+template <class It, class Pred>
+bool any_of(Range<It> range, Pred&& pred) {
+    return global_scheduler().any_of(range, std::forward<Pred>(pred));
+}
+
+template <class It, class Pred>
+bool all_of(Range<It> range, Pred&& pred) {
+    return global_scheduler().all_of(range, std::forward<Pred>(pred));
+}
+
+template <class It, class Pred>
+bool none_of(Range<It> range, Pred&& pred) {
+    return global_scheduler().none_of(range, std::forward<Pred>(pred));
+}
+
+template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+auto find_if(Container&& container, Pred&& pred) {
+    return global_scheduler().find_if(std::forward<Container>(container), std::forward<Pred>(pred));
+}
+
+template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+bool any_of(Container&& container, Pred&& pred) {
+    return global_scheduler().any_of(std::forward<Container>(container), std::forward<Pred>(pred));
+}
+
+template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+bool all_of(Container&& container, Pred&& pred) {
+    return global_scheduler().all_of(std::forward<Container>(container), std::forward<Pred>(pred));
+}
+
+template <class Container, class Pred, require_has_some_iter<std::decay_t<Container>> = true>
+bool none_of(Container&& container, Pred&& pred) {
+    return global_scheduler().none_of(std::forward<Container>(container), std::forward<Pred>(pred));
+}
+
+// - Pipeline API -
+
+template <class Source, class... Fs>
+void pipeline(std::size_t max_tokens, Source&& source, Stage<Fs>... stages) {
+    global_scheduler().pipeline(max_tokens, std::forward<Source>(source), std::move(stages)...);
+}
+
 } // namespace utl::parallel::impl
 
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
 // ______________________ PUBLIC API ______________________
 
 namespace utl::parallel {
@@ -9063,9 +13963,19 @@ namespace utl::parallel {
 using impl::Scheduler;
 using impl::ThreadPool;
 using impl::Future;
+using impl::TaskGroup;
+using impl::PerWorker;
+using impl::Placement;
+using impl::Priority;
+using impl::WorkerStats;
+using impl::PoolStats;
 
 using impl::Range;
 using impl::IndexRange;
+using impl::IndexRange2D;
+using impl::IndexRange3D;
+using impl::TileOrder;
+using impl::auto_grain;
 
 using impl::sum;
 using impl::prod;
@@ -9079,12 +13989,49 @@ using impl::wait;
 using impl::detached_task;
 using impl::awaitable_task;
 
+using impl::invoke;
+
+#ifdef utl_parallel_has_coroutines
+using impl::Coroutine;
+using impl::schedule;
+using impl::spawn;
+using impl::when_all;
+#endif
+
 using impl::detached_loop;
 using impl::blocking_loop;
 using impl::awaitable_loop;
 
 using impl::blocking_reduce;
 using impl::awaitable_reduce;
+using impl::blocking_deterministic_reduce;
+using impl::awaitable_deterministic_reduce;
+
+using impl::blocking_transform_reduce;
+using impl::awaitable_transform_reduce;
+
+using impl::blocking_inclusive_scan;
+using impl::awaitable_inclusive_scan;
+using impl::blocking_exclusive_scan;
+using impl::awaitable_exclusive_scan;
+
+using impl::sort;
+using impl::stable_sort;
+using impl::partition;
+
+using impl::CancellationToken;
+using impl::find_if;
+using impl::any_of;
+using impl::all_of;
+using impl::none_of;
+
+using impl::MPMCQueue;
+using impl::ShardedMap;
+
+using impl::StageMode;
+using impl::Stage;
+using impl::stage;
+using impl::pipeline;
 
 namespace this_thread = impl::this_thread;
 
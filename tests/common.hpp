@@ -12,6 +12,7 @@
 
 // ____________________ STD INCLUDES  _____________________
 
+#include <cstdint>     // IWYU pragma: keep // uint64_t
 #include <filesystem>  // IWYU pragma: keep // filesystem::
 #include <limits>      // IWYU pragma: keep // numeric_limits<>::
 #include <string>      // IWYU pragma: keep // string_literals::
@@ -45,6 +46,15 @@ void repeat(std::size_t repeats, Func&& func) {
     }
 }
 
+// --- Pseudorandom data ---
+// -------------------------
+
+// Cheap deterministic LCG hash for generating test data, unlike 'std::rand()' it gives the same
+// sequence on every platform and can be safely called from multiple threads
+[[nodiscard]] constexpr std::uint64_t pseudorandom(std::uint64_t i) noexcept {
+    return (i * 6364136223846793005ull + 1442695040888963407ull) >> 40;
+}
+
 // --- Shortened numeric limits ---
 // --------------------------------
 
@@ -0,0 +1,133 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/json.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <stdexcept>   // runtime_error, out_of_range
+#include <string>      // string
+#include <utility>     // move()
+
+// ____________________ IMPLEMENTATION ____________________
+
+// =============================
+// --- Parsing & conversions ---
+// =============================
+
+TEST_CASE("Flat DOM / Accepts valid") {
+    const fs::path test_suite_path = "tests/data/json_test_suite/should_accept/";
+
+    // Flat DOM should represent exactly the same data as the regular one
+    for (const auto& test_suite_entry : fs::directory_iterator(test_suite_path)) {
+        const std::string path = test_suite_entry.path().string();
+        const json::Node  node = json::from_file(path);
+
+        CAPTURE(path);
+
+        json::FlatDocument document;
+        REQUIRE_NOTHROW(document = json::flat_from_file(path));
+        CHECK(document.to_node().to_string() == node.to_string());
+    }
+}
+
+TEST_CASE("Flat DOM / Rejects invalid") {
+    const fs::path test_suite_path = "tests/data/json_test_suite/should_reject/";
+
+    for (const auto& test_suite_entry : fs::directory_iterator(test_suite_path)) {
+        const std::string path = test_suite_entry.path().string();
+
+        CAPTURE(path);
+
+        bool regular_parser_throws = false;
+        try {
+            [[maybe_unused]] const auto json = json::from_file(path);
+        } catch (std::runtime_error&) { regular_parser_throws = true; }
+
+        if (regular_parser_throws) CHECK_THROWS_AS(json::flat_from_file(path), std::runtime_error);
+        else CHECK_NOTHROW(json::flat_from_file(path));
+    }
+}
+
+// ================
+// --- Node API ---
+// ================
+
+TEST_CASE("Flat DOM / Access") {
+    const auto document = json::flat_from_string(R"(
+        {
+            "string": "lorem ipsum",
+            "escaped": "line\nbreak \u0041",
+            "number": 0.5,
+            "bool": true,
+            "null": null,
+            "array": [ 1, [ 2, 3 ], {} ],
+            "object": { "key": "value", "key": "duplicate" }
+        }
+    )");
+
+    const json::FlatNode& root = document.root();
+
+    REQUIRE(root.is_object());
+    CHECK(root.get_object().size() == 7);
+    CHECK(root.get_object()[0].key == "string"); // original order of keys is preserved
+
+    CHECK(root["string"].get_string() == "lorem ipsum");
+    CHECK(root["escaped"].get_string() == "line\nbreak A");
+    CHECK(root["number"].get_number() == 0.5);
+    CHECK(root["bool"].get_bool() == true);
+    CHECK(root["null"].is_null());
+
+    CHECK(root["array"].get_array().size() == 3);
+    CHECK(root["array"][1][0].get_number() == 2);
+    CHECK(root["array"][2].get_object().empty());
+
+    CHECK(root["object"]["key"].get_string() == "value"); // first of the duplicate keys wins, same as 'Node'
+    CHECK(root["object"].contains("key"));
+    CHECK(!root["object"].contains("other_key"));
+    CHECK(root["object"].find("other_key") == nullptr);
+
+    std::size_t count = 0;
+    for (const auto& [key, value] : root.get_object()) count += key.size() + value.is_string();
+    CHECK(count == 40);
+}
+
+TEST_CASE("Flat DOM / Serialization") {
+    // Keys are serialized in their original order, with sorted unique keys the result should match 'Node'
+    const std::string chars = R"({ "a": [ 1, 2.5, "str\"ing" ], "b": {}, "c": [], "d": { "e": [ true, null ] } })";
+
+    const auto document = json::flat_from_string(chars);
+    const auto node     = json::from_string(chars);
+
+    CHECK(document.to_string() == node.to_string());
+    CHECK(document.to_string(json::Format::MINIMIZED) == node.to_string(json::Format::MINIMIZED));
+    CHECK(json::flat_from_string(R"({ "b": 1, "a": 2, "b": 3 })").to_string(json::Format::MINIMIZED) ==
+          R"({"b":1,"a":2,"b":3})");
+
+    // Keys are stored decoded, serializing should escape them again
+    const auto escaped = json::flat_from_string(R"({ "k\nk": 1, "q\"uote": 2 })");
+    CHECK(escaped.to_string(json::Format::MINIMIZED) == R"({"k\nk":1,"q\"uote":2})");
+    CHECK(json::from_string(escaped.to_string()).at("k\nk").get_number() == 1);
+}
+
+TEST_CASE("Flat DOM / Access errors") {
+    const auto document = json::flat_from_string(R"({ "array": [ 1, 2 ], "number": 3 })");
+
+    CHECK_THROWS_AS(document["non-existent"], std::runtime_error);
+    CHECK_THROWS_AS(document["array"].at(2), std::out_of_range);
+    CHECK_THROWS_AS(document["array"].get_object(), std::runtime_error);
+    CHECK_THROWS_AS(document["number"].get_string(), std::runtime_error);
+    CHECK_THROWS_AS(document["number"]["key"], std::runtime_error);
+    CHECK_THROWS_AS(document[0], std::runtime_error);
+}
+
+TEST_CASE("Flat DOM / Document ownership") {
+    // Moving the document should keep all of the string views valid
+    auto document = json::flat_from_string(R"({ "key": [ "value", "escaped \"value\"" ] })");
+    auto moved    = std::move(document);
+    document      = json::flat_from_string("null");
+
+    CHECK(moved["key"][0].get_string() == "value");
+    CHECK(moved["key"][1].get_string() == "escaped \"value\"");
+    CHECK(moved.to_string(json::Format::MINIMIZED) == R"({"key":["value","escaped \"value\""]})");
+    CHECK(document.root().is_null());
+}
@@ -4,7 +4,10 @@
 
 // _______________________ INCLUDES _______________________
 
+#include <array>         // array<>
 #include <map>           // map<>
+#include <string>        // string
+#include <type_traits>   // decay_t<>
 #include <unordered_map> // unordered_map<>
 #include <vector>        // vector<>
 
@@ -167,4 +170,223 @@ TEST_CASE("Reflection / Nested containers of reflected structs") {
     CHECK(reflected_cfg == cfg);
 }
 // if map-of-arrays of structs and 3D tensor of reflected structs are properly reflected in
-// another struct then it seems pretty safe to assume that everything else should be possible too
\ No newline at end of file
+// another struct then it seems pretty safe to assume that everything else should be possible too
+
+// ===================================
+// --- Reflection from rvalue node ---
+// ===================================
+
+TEST_CASE("Reflection / Move from rvalue node") {
+    // Moving from a node should produce the same struct as copying, while stealing its strings & containers
+    auto json = json::from_struct(test_nested_container_cfg);
+
+    const auto copied_cfg = json.to_struct<NestedContainerConfig>();
+    CHECK(copied_cfg == test_nested_container_cfg);
+
+    const auto moved_cfg = std::move(json).to_struct<NestedContainerConfig>();
+    CHECK(moved_cfg == test_nested_container_cfg);
+
+    // Temporaries bind to the rvalue overload
+    const auto temporary_cfg = json::from_struct(test_nested_cfg).to_struct<NestedConfig>();
+    CHECK(temporary_cfg == test_nested_cfg);
+}
+
+// ===================================
+// --- Missing & fixed-size fields ---
+// ===================================
+
+struct FixedSizeConfig {
+    std::array<std::string, 3> names;
+    std::array<double, 2>      point;
+    int                        optional = 17;
+
+    bool operator==(const FixedSizeConfig& other) const {
+        return (this->names == other.names) && (this->point == other.point) && (this->optional == other.optional);
+    }
+};
+
+UTL_JSON_REFLECT(FixedSizeConfig, names, point, optional);
+
+TEST_CASE("Reflection / Fixed-size arrays & missing fields") {
+    json::Node json;
+    json["names"] = json::Array{"lorem", "ipsum", "dolor"};
+    json["point"] = json::Array{0.5, 1.5};
+    // 'optional' is missing and should stay defaulted
+
+    const FixedSizeConfig expected = {{"lorem", "ipsum", "dolor"}, {0.5, 1.5}, 17};
+
+    CHECK(json.to_struct<FixedSizeConfig>() == expected);
+    CHECK(json::Node(json).to_struct<FixedSizeConfig>() == expected);
+
+    json["point"] = json::Array{0.5};
+    CHECK_THROWS(json.to_struct<FixedSizeConfig>());
+    CHECK_THROWS(std::move(json).to_struct<FixedSizeConfig>());
+}
+
+// ================================
+// --- Direct parsing to struct ---
+// ================================
+
+TEST_CASE("Reflection / Direct parsing matches to_struct()") {
+    // Parsing straight into the struct should give the same result as going through the 'Node'
+    const auto check_roundtrip = [](const auto& cfg) {
+        using config_type = std::decay_t<decltype(cfg)>;
+
+        for (const auto format : {json::Format::PRETTY, json::Format::MINIMIZED}) {
+            const std::string chars = json::from_struct(cfg).to_string(format);
+            CHECK(json::from_string_to<config_type>(chars) == cfg);
+            CHECK(json::from_string_to<config_type>(chars) == json::from_string(chars).to_struct<config_type>());
+        }
+    };
+
+    check_roundtrip(test_simple_cfg);
+    check_roundtrip(test_nested_cfg);
+    check_roundtrip(test_nested_container_cfg);
+    check_roundtrip(FixedSizeConfig{{"lorem", "ipsum", "dolor"}, {0.5, 1.5}, 4});
+}
+
+TEST_CASE("Reflection / Direct parsing skips unknown members") {
+    const std::string chars = R"(
+        {
+            "unknown_object" : { "a": [1, 2, {"b": null}], "c": "\"escaped\"" },
+            "flag"           : true,
+            "unknown_array"  : [[], {}, "A", -1.5e3, false],
+            "substruct"      : {
+                "object"  : { "key_1": 1, "key_2": 2 },
+                "array"   : [ 4, 5, 6 ],
+                "string"  : "lorem \n ipsum",
+                "number"  : 0.5,
+                "boolean" : true,
+                "null"    : null,
+                "extra"   : "ignored"
+            }
+        }
+    )";
+
+    NestedConfig expected = test_nested_cfg;
+    expected.flag             = true;
+    expected.substruct.string = "lorem \n ipsum";
+
+    CHECK(json::from_string_to<NestedConfig>(chars) == expected);
+
+    // Containers of reflected structs can be parsed at the top level
+    const auto array = json::from_string_to<std::vector<FixedSizeConfig>>(
+        R"([ { "names": ["a", "b", "c"], "point": [1, 2] }, { "optional": 5, "names": ["d", "e", "f"] } ])");
+    REQUIRE(array.size() == 2);
+    CHECK(array[0] == FixedSizeConfig{{"a", "b", "c"}, {1, 2}, 17});
+    CHECK(array[1] == FixedSizeConfig{{"d", "e", "f"}, {}, 5});
+}
+
+TEST_CASE("Reflection / Direct parsing of duplicate keys matches to_struct()") {
+    // First occurrence of a duplicate key wins for both struct fields & map keys, same as with 'from_string()'
+    const std::string chars = R"(
+        {
+            "flag"      : false,
+            "substruct" : {
+                "object"  : { "key_1": 1, "key_2": 2, "key_1": 3 },
+                "array"   : [ 1, 2, 3 ],
+                "string"  : "first",
+                "number"  : 0.5,
+                "boolean" : true,
+                "null"    : null,
+                "string"  : "second",
+                "array"   : "not even an array"
+            },
+            "flag"      : true,
+            "substruct" : "not even an object"
+        }
+    )";
+
+    const auto direct  = json::from_string_to<NestedConfig>(chars);
+    const auto regular = json::from_string(chars).to_struct<NestedConfig>();
+
+    CHECK(direct == regular);
+    CHECK(direct.flag == false);
+    CHECK(direct.substruct.string == "first");
+    CHECK(direct.substruct.object.at("key_1") == 1);
+}
+
+TEST_CASE("Reflection / Direct parsing rejects invalid input") {
+    // Type mismatches
+    CHECK_THROWS(json::from_string_to<FixedSizeConfig>(R"({ "optional": "5" })"));
+    CHECK_THROWS(json::from_string_to<FixedSizeConfig>(R"({ "names": "a" })"));
+    CHECK_THROWS(json::from_string_to<FixedSizeConfig>(R"([])"));
+
+    // Fixed-size array mismatches
+    CHECK_THROWS(json::from_string_to<FixedSizeConfig>(R"({ "point": [1] })"));
+    CHECK_THROWS(json::from_string_to<FixedSizeConfig>(R"({ "point": [1, 2, 3] })"));
+
+    // Skipped members should still be valid JSON
+    CHECK_THROWS(json::from_string_to<FixedSizeConfig>(R"({ "unknown": [1, 2,] })"));
+    CHECK_THROWS(json::from_string_to<FixedSizeConfig>(R"({ "unknown": "\x" })"));
+    CHECK_THROWS(json::from_string_to<FixedSizeConfig>(R"({ "unknown": tru })"));
+
+    // Structural errors
+    CHECK_THROWS(json::from_string_to<FixedSizeConfig>(R"({ "optional": 5 )"));
+    CHECK_THROWS(json::from_string_to<FixedSizeConfig>(R"({ "optional" 5 })"));
+    CHECK_THROWS(json::from_string_to<FixedSizeConfig>(R"({ "optional": 5 } })"));
+
+    // Recursion limit applies to skipped members too
+    CHECK_THROWS(json::from_string_to<FixedSizeConfig>("{ \"unknown\": " + std::string(1000, '[') +
+                                                       std::string(1000, ']') + "}"));
+}
+
+// =====================================
+// --- Direct serializing of structs ---
+// =====================================
+
+TEST_CASE("Reflection / Direct serializing matches from_struct()") {
+    // Serializing straight from the struct should give the same JSON as going through the 'Node'
+    const auto check_roundtrip = [](const auto& cfg) {
+        using config_type = std::decay_t<decltype(cfg)>;
+
+        for (const auto format : {json::Format::PRETTY, json::Format::MINIMIZED}) {
+            const std::string chars = json::to_string(cfg, format);
+            CHECK(json::from_string(chars).to_string() == json::from_struct(cfg).to_string());
+            CHECK(json::from_string_to<config_type>(chars) == cfg);
+        }
+    };
+
+    check_roundtrip(test_simple_cfg);
+    check_roundtrip(test_nested_cfg);
+    check_roundtrip(test_nested_container_cfg);
+    check_roundtrip(FixedSizeConfig{{"lorem", "ipsum", "dolor"}, {0.5, 1.5}, 4});
+}
+
+TEST_CASE("Reflection / Direct serializing formatting") {
+    // Fields are written in their declaration order, formatting follows 'Node::to_string()'
+    const FixedSizeConfig cfg = {{"a", "b\n", "c"}, {0.5, 1.}, 2};
+
+    CHECK(json::to_string(cfg, json::Format::MINIMIZED) ==
+          R"({"names":["a","b\n","c"],"point":[0.5,1],"optional":2})");
+
+    CHECK(json::to_string(cfg) == "{\n"
+                                  "    \"names\": [\n"
+                                  "        \"a\",\n"
+                                  "        \"b\\n\",\n"
+                                  "        \"c\"\n"
+                                  "    ],\n"
+                                  "    \"point\": [\n"
+                                  "        0.5,\n"
+                                  "        1\n"
+                                  "    ],\n"
+                                  "    \"optional\": 2\n"
+                                  "}");
+
+    // Containers of reflected structs can be serialized at the top level
+    CHECK(json::to_string(std::vector<FixedSizeConfig>{}) == "[]");
+    CHECK(json::to_string(std::vector<FixedSizeConfig>{cfg, cfg}, json::Format::MINIMIZED) ==
+          "[" + json::to_string(cfg, json::Format::MINIMIZED) + "," + json::to_string(cfg, json::Format::MINIMIZED) +
+              "]");
+}
+
+TEST_CASE("Reflection / Direct serializing escapes keys") {
+    SimpleConfig cfg = test_simple_cfg;
+    cfg.object       = {{"q\"uote", 1}, {"line\nbreak", 2}, {"back\\slash", 3}};
+
+    for (const auto format : {json::Format::PRETTY, json::Format::MINIMIZED}) {
+        const std::string chars = json::to_string(cfg, format);
+        CHECK(chars.find("\"q\\\"uote\"") != std::string::npos);
+        CHECK(json::from_string_to<SimpleConfig>(chars) == cfg);
+    }
+}
@@ -0,0 +1,178 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/json.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <deque>         // deque<>
+#include <fstream>       // ifstream
+#include <sstream>       // istringstream, ostringstream
+#include <stdexcept>     // runtime_error, invalid_argument
+#include <string>        // string
+#include <string_view>   // string_view
+#include <unordered_set> // unordered_set<>
+#include <vector>        // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+// =========================
+// --- Node-building SAX ---
+// =========================
+
+// Handler that reconstructs the 'Node' from events, if SAX parser works correctly
+// the result should be exactly the same as the one we get from the regular parser
+struct NodeBuilder : json::SaxHandler {
+    json::Node               root;
+    std::vector<json::Node*> stack;
+    std::string              key;
+    std::deque<json::Node>   discarded; // regular parser keeps the first value of duplicate keys
+
+    json::Node& next() {
+        if (this->stack.empty()) return this->root;
+
+        json::Node& parent = *this->stack.back();
+        if (parent.is_array()) return parent.get_array().emplace_back();
+
+        const auto [it, inserted] = parent.get_object().try_emplace(this->key);
+        return inserted ? it->second : this->discarded.emplace_back();
+    }
+
+    void on_object_begin() {
+        json::Node& node = this->next();
+        node             = json::Object{};
+        this->stack.push_back(&node);
+    }
+    void on_object_end() { this->stack.pop_back(); }
+    void on_array_begin() {
+        json::Node& node = this->next();
+        node             = json::Array{};
+        this->stack.push_back(&node);
+    }
+    void on_array_end() { this->stack.pop_back(); }
+    void on_key(std::string_view key) { this->key = key; }
+    void on_string(std::string_view value) { this->next() = std::string(value); }
+    void on_number(json::Number value) { this->next() = value; }
+    void on_bool(json::Bool value) { this->next() = value; }
+    void on_null() { this->next() = json::Null{}; }
+};
+
+// Small chunks make sure that every kind of token gets split across the chunk border at some point
+constexpr std::size_t chunk_sizes[] = {1, 2, 3, 7, 64 * 1024};
+
+TEST_CASE("SAX parser / Accepts valid") {
+    const fs::path test_suite_path = "tests/data/json_test_suite/should_accept/";
+
+    for (const auto& test_suite_entry : fs::directory_iterator(test_suite_path)) {
+        const std::string path     = test_suite_entry.path().string();
+        const std::string expected = json::from_file(path).to_string();
+
+        CAPTURE(path);
+
+        const std::string chars = (std::ostringstream{} << std::ifstream(path, std::ios::binary).rdbuf()).str();
+
+        NodeBuilder string_builder;
+        REQUIRE_NOTHROW(json::sax_from_string(chars, string_builder));
+        CHECK(string_builder.root.to_string() == expected);
+
+        for (const std::size_t chunk_size : chunk_sizes) {
+            CAPTURE(chunk_size);
+
+            NodeBuilder file_builder;
+            REQUIRE_NOTHROW(json::sax_from_file(path, file_builder, 100, chunk_size));
+            CHECK(file_builder.root.to_string() == expected);
+        }
+    }
+}
+
+TEST_CASE("SAX parser / Rejects invalid") {
+    const fs::path test_suite_path = "tests/data/json_test_suite/should_reject/";
+
+    // SAX parser should reject exactly the same inputs as the regular one, including
+    // the deliberately accepted numeric cases (see "parser_rejects_invalid.cpp")
+    for (const auto& test_suite_entry : fs::directory_iterator(test_suite_path)) {
+        const std::string path = test_suite_entry.path().string();
+
+        CAPTURE(path);
+
+        bool regular_parser_throws = false;
+        try {
+            [[maybe_unused]] const auto json = json::from_file(path);
+        } catch (std::runtime_error&) { regular_parser_throws = true; }
+
+        for (const std::size_t chunk_size : chunk_sizes) {
+            CAPTURE(chunk_size);
+
+            NodeBuilder builder;
+            if (regular_parser_throws)
+                CHECK_THROWS_AS(json::sax_from_file(path, builder, 100, chunk_size), std::runtime_error);
+            else CHECK_NOTHROW(json::sax_from_file(path, builder, 100, chunk_size));
+        }
+    }
+}
+
+// ===========================
+// --- Partial SAX handler ---
+// ===========================
+
+// Handler that only cares about some of the events, a typical use case for aggregating huge inputs
+struct NumberSum : json::SaxHandler {
+    double      sum     = 0;
+    std::size_t objects = 0;
+
+    void on_number(json::Number value) { this->sum += value; }
+    void on_object_begin() { ++this->objects; }
+};
+
+TEST_CASE("SAX parser / Partial handler") {
+    const std::string chars = R"([ { "a": 1, "b": [2, 3.5, "4"] }, { "c": { "d": -0.5e1 } }, true, null ])";
+
+    for (const std::size_t chunk_size : chunk_sizes) {
+        NumberSum handler;
+        std::istringstream stream(chars);
+        json::sax_from_stream(stream, handler, 100, chunk_size);
+        CHECK(handler.sum == 1.5);
+        CHECK(handler.objects == 3);
+    }
+}
+
+TEST_CASE("SAX parser / Recursion limit") {
+    const std::string chars = std::string(200, '[') + std::string(200, ']');
+
+    for (const std::size_t chunk_size : chunk_sizes) {
+        NumberSum          handler;
+        std::istringstream stream(chars);
+        CHECK_THROWS_AS(json::sax_from_stream(stream, handler, 100, chunk_size), std::runtime_error);
+
+        std::istringstream other_stream(chars);
+        CHECK_NOTHROW(json::sax_from_stream(other_stream, handler, 300, chunk_size));
+    }
+}
+
+TEST_CASE("SAX parser / Zero chunk size") {
+    NumberSum          handler;
+    std::istringstream stream("[ 1, 2 ]");
+    CHECK_THROWS_AS(json::sax_from_stream(stream, handler, 100, 0), std::invalid_argument);
+}
+
+TEST_CASE("SAX parser / Error messages match the regular parser") {
+    for (const std::string chars : {"{ \"a\": 1 ]", "[ 1 }", "[[[[1]]]]"}) {
+        CAPTURE(chars);
+
+        std::string regular_message;
+        try {
+            [[maybe_unused]] const auto json = json::from_string(chars, 3);
+        } catch (std::runtime_error& e) { regular_message = e.what(); }
+
+        NumberSum   handler;
+        std::string sax_message;
+        try {
+            json::sax_from_string(chars, handler, 3);
+        } catch (std::runtime_error& e) { sax_message = e.what(); }
+
+        CHECK(!regular_message.empty());
+        CHECK(sax_message == regular_message);
+    }
+
+    CHECK_THROWS_WITH(json::from_string("{ \"a\": 1 ]"), doctest::Contains("JSON object node could not find comma"));
+    CHECK_THROWS_WITH(json::from_string("[ 1 }"), doctest::Contains("JSON array node could not find comma"));
+}
@@ -0,0 +1,177 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <algorithm> // find_if(), any_of(), all_of(), none_of()
+#include <atomic>    // atomic<>
+#include <list>      // list<>
+#include <numeric>   // iota()
+#include <vector>    // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+constexpr std::size_t repeats = 10;
+// we run tests multiple times to increase the chance of catching race conditions,
+// this is usually kept low for CI builds, can be increased locally for better coverage
+
+constexpr std::size_t threads = 7;       // weird number of threads
+constexpr std::size_t N       = 100'003; // prime number to make things never evenly divisible
+
+std::vector<int> make_iota(std::size_t size) {
+    std::vector<int> vec(size);
+    std::iota(vec.begin(), vec.end(), 0);
+    return vec;
+}
+
+// --- Cancellation tokens (4) ---
+// -------------------------------
+
+TEST_CASE("Cancellation / Token state is shared between copies") {
+    parallel::CancellationToken token;
+    parallel::CancellationToken copy = token;
+
+    CHECK(!token.is_cancelled());
+    CHECK(!copy.is_cancelled());
+
+    copy.cancel();
+
+    CHECK(token.is_cancelled());
+    CHECK(copy.is_cancelled());
+}
+
+TEST_CASE("Cancellation / Cancelled token skips the whole loop") {
+    parallel::set_thread_count(threads);
+
+    parallel::CancellationToken token;
+    token.cancel();
+
+    std::atomic<std::size_t> calls = 0;
+
+    parallel::blocking_loop(parallel::IndexRange<std::size_t>{0, N}, token, [&](std::size_t) { ++calls; });
+    parallel::blocking_loop(parallel::IndexRange2D<std::size_t>{{0, 100}, {0, 100}}, token, [&](auto, auto) {
+        ++calls;
+    });
+    parallel::blocking_loop(make_iota(N), token, [&](auto, auto) { ++calls; });
+    parallel::awaitable_loop(parallel::IndexRange<std::size_t>{0, N}, token, [&](std::size_t) { ++calls; }).wait();
+    parallel::detached_loop(parallel::IndexRange<std::size_t>{0, N}, token, [&](std::size_t) { ++calls; });
+    parallel::wait();
+
+    CHECK(calls == 0);
+}
+
+TEST_CASE("Cancellation / Queued blocks get skipped") {
+    parallel::set_thread_count(1); // single worker executes blocks in order, which makes skipping deterministic
+
+    parallel::CancellationToken token;
+
+    std::atomic<std::size_t> blocks = 0;
+
+    parallel::blocking_loop(parallel::IndexRange<std::size_t>{0, N, 1000}, token, [&](std::size_t, std::size_t) {
+        if (++blocks == 3) token.cancel();
+    });
+
+    CHECK(blocks == 3);
+}
+
+TEST_CASE("Cancellation / Running blocks can poll the token") {
+    parallel::set_thread_count(threads);
+
+    repeat(repeats, [&] {
+        parallel::CancellationToken token;
+
+        std::atomic<std::size_t> calls = 0;
+
+        parallel::blocking_loop(parallel::IndexRange<std::size_t>{0, N}, token, [&](std::size_t low, std::size_t high) {
+            for (std::size_t i = low; i < high && !token.is_cancelled(); ++i) {
+                ++calls;
+                if (i == N / 2) token.cancel();
+            }
+        });
+
+        CHECK(token.is_cancelled());
+        CHECK(calls <= N);
+    });
+}
+
+// --- Parallel search (5) ---
+// ---------------------------
+
+TEST_CASE("Parallel-search / Find if") {
+    const std::vector<int> vec = make_iota(N);
+
+    parallel::set_thread_count(threads);
+
+    repeat(repeats, [&] {
+        for (int target : {0, 1, 777, int(N) / 2, int(N) - 1}) {
+            // several matches, the first one has to be found
+            const auto pred = [&](int x) { return x >= target && x % 3 == target % 3; };
+            CHECK(parallel::find_if(vec, pred) == std::find_if(vec.begin(), vec.end(), pred));
+        }
+        CHECK(parallel::find_if(vec, [](int x) { return x < 0; }) == vec.end());
+        CHECK(parallel::find_if(parallel::Range{vec.begin(), vec.end(), 1}, [](int x) { return x == 5; }) ==
+              vec.begin() + 5);
+    });
+}
+
+TEST_CASE("Parallel-search / Any of & all of & none of") {
+    const std::vector<int> vec = make_iota(N);
+
+    parallel::set_thread_count(threads);
+
+    repeat(repeats, [&] {
+        CHECK(parallel::any_of(vec, [](int x) { return x == int(N) - 1; }));
+        CHECK(!parallel::any_of(vec, [](int x) { return x < 0; }));
+
+        CHECK(parallel::all_of(vec, [](int x) { return x >= 0; }));
+        CHECK(!parallel::all_of(vec, [](int x) { return x != 12345; }));
+
+        CHECK(parallel::none_of(vec, [](int x) { return x < 0; }));
+        CHECK(!parallel::none_of(parallel::Range{vec}, [](int x) { return x == 0; }));
+    });
+}
+
+TEST_CASE("Parallel-search / Empty ranges") {
+    const std::vector<int> vec;
+
+    const auto always = [](int) { return true; };
+
+    CHECK(parallel::find_if(vec, always) == vec.end());
+    CHECK(!parallel::any_of(vec, always));
+    CHECK(parallel::all_of(vec, always));
+    CHECK(parallel::none_of(vec, always));
+}
+
+TEST_CASE("Parallel-search / Forward ranges") {
+    std::list<int> list(N);
+    std::iota(list.begin(), list.end(), 0);
+
+    parallel::set_thread_count(threads);
+
+    const auto pred = [](int x) { return x > 5000 && x % 7 == 0; };
+
+    CHECK(parallel::find_if(list, pred) == std::find_if(list.begin(), list.end(), pred));
+    CHECK(parallel::any_of(list, pred));
+    CHECK(!parallel::all_of(list, pred));
+}
+
+TEST_CASE("Parallel-search / Early exit") {
+    const std::vector<int> vec = make_iota(N);
+
+    parallel::set_thread_count(1); // single worker executes blocks in order, which makes early exit deterministic
+
+    std::atomic<std::size_t> calls = 0;
+
+    const auto is_first = [&](int x) {
+        ++calls;
+        return x == 0;
+    };
+
+    CHECK(parallel::find_if(vec, is_first) == vec.begin());
+    CHECK(calls == 1);
+
+    calls = 0;
+    CHECK(parallel::any_of(vec, is_first));
+    CHECK(calls == 1);
+}
@@ -0,0 +1,178 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <atomic>  // atomic<>
+#include <memory>  // unique_ptr<>, make_unique<>()
+#include <string>  // string, to_string()
+#include <utility> // move()
+#include <vector>  // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+constexpr std::size_t repeats = 10;
+// we run tests multiple times to increase the chance of catching race conditions,
+// this is usually kept low for CI builds, can be increased locally for better coverage
+
+// Counts live instances to check that the queue destroys everything it constructs
+struct Tracked {
+    inline static std::atomic<int> alive = 0;
+
+    int value = 0;
+
+    Tracked(int value) : value(value) { ++alive; }
+    Tracked(Tracked&& other) noexcept : value(other.value) { ++alive; }
+    ~Tracked() { --alive; }
+};
+
+// --- MPMC queue (4) ---
+// ----------------------
+
+TEST_CASE("MPMC queue / Basics") {
+    parallel::MPMCQueue<int> queue(5);
+
+    CHECK(queue.capacity() == 8); // rounded up to a power of 2
+    CHECK(queue.empty());
+    CHECK(!queue.try_pop().has_value());
+
+    for (int i = 0; i < 8; ++i) CHECK(queue.try_push(i));
+    CHECK(!queue.try_push(8)); // full
+    CHECK(queue.size() == 8);
+
+    for (int i = 0; i < 8; ++i) {
+        int value = -1;
+        CHECK(queue.try_pop(value));
+        CHECK(value == i); // FIFO order
+    }
+    CHECK(queue.empty());
+
+    // Wrap around the ring several times
+    for (int i = 0; i < 100; ++i) {
+        CHECK(queue.try_emplace(i));
+        CHECK(queue.try_pop() == i);
+    }
+}
+
+TEST_CASE("MPMC queue / Move-only types") {
+    parallel::MPMCQueue<std::unique_ptr<int>> queue(4);
+
+    CHECK(queue.try_push(std::make_unique<int>(1)));
+    CHECK(queue.try_emplace(new int(2)));
+
+    auto first  = queue.try_pop();
+    auto second = queue.try_pop();
+    REQUIRE(first.has_value());
+    REQUIRE(second.has_value());
+    CHECK(**first == 1);
+    CHECK(**second == 2);
+}
+
+TEST_CASE("MPMC queue / Destructor cleanup") {
+    {
+        parallel::MPMCQueue<Tracked> queue(16);
+        for (int i = 0; i < 10; ++i) CHECK(queue.try_emplace(i));
+        CHECK(queue.try_pop()->value == 0);
+        CHECK(Tracked::alive == 9);
+    }
+    CHECK(Tracked::alive == 0);
+}
+
+TEST_CASE("MPMC queue / Concurrent producers & consumers") {
+    constexpr std::size_t N = 100'000;
+
+    parallel::set_thread_count(8);
+
+    repeat(repeats, [&] {
+        parallel::MPMCQueue<std::size_t> queue(64); // small capacity so the queue gets full all the time
+
+        std::atomic<std::size_t> sum   = 0;
+        std::atomic<std::size_t> count = 0;
+
+        const auto pop_one = [&] {
+            if (const auto value = queue.try_pop()) {
+                sum += *value;
+                ++count;
+            }
+        };
+
+        // Every task is a producer that becomes a consumer whenever the queue is full
+        parallel::blocking_loop(parallel::IndexRange<std::size_t>{0, N}, [&](std::size_t i) {
+            while (!queue.try_push(i)) pop_one();
+        });
+        while (!queue.empty()) pop_one();
+
+        CHECK(count == N);
+        CHECK(sum == N * (N - 1) / 2);
+    });
+}
+
+// --- Sharded map (3) ---
+// -----------------------
+
+TEST_CASE("Sharded map / Basics") {
+    parallel::ShardedMap<std::string, int> map(5);
+
+    CHECK(map.shard_count() == 8); // rounded up to a power of 2
+    CHECK(map.empty());
+
+    CHECK(map.try_emplace("a", 1));
+    CHECK(!map.try_emplace("a", 2)); // already present
+    CHECK(map.get("a") == 1);
+
+    CHECK(!map.insert_or_assign("a", 3));
+    CHECK(map.insert_or_assign("b", 4));
+    CHECK(map.get("a") == 3);
+    CHECK(map.get("b") == 4);
+    CHECK(!map.get("c").has_value());
+
+    map.update("c", [](int& value) { value += 5; }); // default-constructed first
+    map.update("c", [](int& value) { value += 5; });
+    CHECK(map.get("c") == 10);
+
+    CHECK(map.contains("b"));
+    CHECK(map.erase("b"));
+    CHECK(!map.erase("b"));
+    CHECK(!map.contains("b"));
+    CHECK(map.size() == 2);
+
+    int total = 0;
+    map.for_each([&](const std::string&, int& value) { total += value; });
+    CHECK(total == 13);
+
+    map.clear();
+    CHECK(map.empty());
+}
+
+TEST_CASE("Sharded map / Shards are used evenly") {
+    // Integer keys hash to themselves, without remixing they would all land in a few shards
+    parallel::ShardedMap<std::size_t, int> map(16);
+
+    for (std::size_t i = 0; i < 16 * 1024; ++i) map.try_emplace(i * 64, 0);
+    CHECK(map.size() == 16 * 1024);
+}
+
+TEST_CASE("Sharded map / Concurrent counting") {
+    constexpr std::size_t N        = 100'000;
+    constexpr std::size_t distinct = 1000;
+
+    parallel::set_thread_count(8);
+
+    repeat(repeats, [&] {
+        parallel::ShardedMap<std::string, std::size_t> map;
+
+        parallel::blocking_loop(parallel::IndexRange<std::size_t>{0, N}, [&](std::size_t i) {
+            map.update(std::to_string(i % distinct), [](std::size_t& count) { ++count; });
+        });
+
+        CHECK(map.size() == distinct);
+
+        std::size_t total = 0;
+        map.for_each([&](const std::string&, std::size_t& count) {
+            CHECK(count == N / distinct);
+            total += count;
+        });
+        CHECK(total == N);
+    });
+}
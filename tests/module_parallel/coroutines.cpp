@@ -0,0 +1,180 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <atomic>    // atomic<>
+#include <stdexcept> // runtime_error
+#include <thread>    // this_thread::get_id()
+#include <vector>    // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+// Coroutines require C++20, this test target is built with it, but we still guard against compilers
+// that don't implement coroutines even in C++20 mode
+#ifdef utl_parallel_has_coroutines
+
+constexpr std::size_t threads = 7; // weird number of threads
+
+parallel::Coroutine<int> twice(int x) {
+    co_await parallel::schedule();
+    co_return 2 * x;
+}
+
+parallel::Coroutine<void> increment(std::atomic<int>& counter) {
+    co_await parallel::schedule();
+    ++counter;
+}
+
+parallel::Coroutine<int> fail() {
+    co_await parallel::schedule();
+    throw std::runtime_error("Coroutine failed");
+    co_return 0;
+}
+
+parallel::Coroutine<int> fibonacci(int n) {
+    if (n < 2) co_return n;
+
+    auto [prev_1, prev_2] = co_await parallel::when_all(fibonacci(n - 1), fibonacci(n - 2));
+    co_return prev_1 + prev_2;
+}
+
+// --- Basics (3) ---
+// ------------------
+
+TEST_CASE("Coroutines / Lazy start") {
+    const auto caller_id = std::this_thread::get_id();
+
+    bool started = false;
+
+    // Coroutine lambdas shouldn't capture, closure dies before the lazy coroutine starts, pass state as arguments
+    auto coroutine = [](bool& flag) -> parallel::Coroutine<std::thread::id> {
+        flag = true;
+        co_return std::this_thread::get_id();
+    }(started);
+
+    REQUIRE(!started); // nothing runs until the coroutine is awaited or spawned
+    REQUIRE(coroutine.get() == caller_id); // coroutines that never reschedule run inline
+    REQUIRE(started);
+}
+
+TEST_CASE("Coroutines / Scheduling onto the pool") {
+    parallel::set_thread_count(threads);
+
+    auto coroutine = []() -> parallel::Coroutine<bool> {
+        co_await parallel::schedule();
+        co_return parallel::this_thread::get_pool().has_value();
+    }();
+
+    REQUIRE(coroutine.get());
+    REQUIRE(parallel::spawn(twice(21)).get() == 42);
+
+    parallel::set_thread_count(0);
+}
+
+TEST_CASE("Coroutines / Local thread pool") {
+    parallel::ThreadPool pool(threads);
+
+    auto coroutine = [](parallel::ThreadPool& pool) -> parallel::Coroutine<std::size_t> {
+        co_await pool.schedule();
+        co_return *parallel::this_thread::get_index();
+    }(pool);
+
+    REQUIRE(pool.spawn(std::move(coroutine)).get() < threads);
+}
+
+// --- Composition (3) ---
+// -----------------------
+
+TEST_CASE("Coroutines / Nested awaiting") {
+    parallel::set_thread_count(threads);
+
+    auto outer = []() -> parallel::Coroutine<int> {
+        const int a = co_await twice(1);
+
+        auto b = twice(2);
+        const int b_value = co_await b; // awaiting an lvalue
+
+        co_return a + b_value;
+    }();
+
+    REQUIRE(outer.get() == 6);
+    REQUIRE(fibonacci(15).get() == 610);
+
+    parallel::set_thread_count(0);
+}
+
+TEST_CASE("Coroutines / When all") {
+    parallel::set_thread_count(threads);
+
+    std::atomic<int> counter = 0;
+
+    auto [a, b, c] = parallel::when_all(twice(1), increment(counter), twice(3)).get();
+    REQUIRE(a == 2);
+    REQUIRE(c == 6);
+    REQUIRE(counter == 1);
+
+    std::vector<parallel::Coroutine<int>> values;
+    for (int i = 0; i < 100; ++i) values.push_back(twice(i));
+
+    const auto results = parallel::when_all(std::move(values)).get();
+    REQUIRE(results.size() == 100);
+    for (int i = 0; i < 100; ++i) REQUIRE(results[i] == 2 * i);
+
+    std::vector<parallel::Coroutine<void>> actions;
+    for (int i = 0; i < 100; ++i) actions.push_back(increment(counter));
+
+    parallel::when_all(std::move(actions)).wait();
+    REQUIRE(counter == 101);
+
+    parallel::set_thread_count(0);
+}
+
+TEST_CASE("Coroutines / Many in-flight coroutines") {
+    parallel::set_thread_count(2); // far fewer threads than pending awaits
+
+    std::vector<parallel::Coroutine<int>> coroutines;
+    for (int i = 0; i < 5000; ++i)
+        coroutines.push_back(parallel::spawn([](int i) -> parallel::Coroutine<int> { co_return co_await twice(i); }(i)));
+
+    long long sum = 0;
+    for (auto& coroutine : coroutines) sum += coroutine.get();
+
+    REQUIRE(sum == 4999LL * 5000LL);
+
+    parallel::set_thread_count(0);
+}
+
+// --- Exceptions (2) ---
+// ----------------------
+
+TEST_CASE("Coroutines / Exceptions propagate") {
+    parallel::set_thread_count(threads);
+
+    REQUIRE_THROWS_AS(fail().get(), std::runtime_error);
+
+    auto outer = []() -> parallel::Coroutine<bool> {
+        try {
+            co_await fail();
+        } catch (const std::runtime_error&) { co_return true; }
+        co_return false;
+    }();
+
+    REQUIRE(outer.get());
+
+    parallel::set_thread_count(0);
+}
+
+TEST_CASE("Coroutines / When all waits for everything before rethrowing") {
+    parallel::set_thread_count(threads);
+
+    std::atomic<int> counter = 0;
+
+    REQUIRE_THROWS_AS(parallel::when_all(fail(), increment(counter), increment(counter)).get(), std::runtime_error);
+    REQUIRE(counter == 2);
+
+    parallel::set_thread_count(0);
+}
+
+#endif
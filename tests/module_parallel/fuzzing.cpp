@@ -94,4 +94,38 @@ TEST_CASE("Fuzzing / Modifying thread pool from multiple threads") {
 
         REQUIRE(tasks_completed == modifying_threads * tasks_per_thread);
     });
-}
\ No newline at end of file
+}
+
+TEST_CASE("Fuzzing / Recursive task loss") {
+    // Enqueues tasks that recursively spawn random number of subtasks into the local deques, large subtask
+    // counts force deques to grow while other threads are stealing from them, which is the trickiest part
+    // of the lock-free work-stealing, all tasks should be executed exactly once
+
+    std::mt19937                               gen(16);
+    std::uniform_int_distribution<std::size_t> thread_count_dist{2, 17};
+    std::uniform_int_distribution<std::size_t> subtask_count_dist{0, 517};
+
+    constexpr std::size_t external_tasks = 23;
+
+    repeat(repeats, [&] {
+        parallel::ThreadPool pool(thread_count_dist(gen));
+
+        std::vector<std::size_t> subtask_counts(external_tasks);
+        for (auto& count : subtask_counts) count = subtask_count_dist(gen);
+
+        std::atomic<std::size_t> tasks_completed = 0;
+
+        for (std::size_t i = 0; i < external_tasks; ++i)
+            pool.detached_task([&, i] {
+                for (std::size_t k = 0; k < subtask_counts[i]; ++k) pool.detached_task([&] { ++tasks_completed; });
+                ++tasks_completed;
+            });
+
+        pool.wait();
+
+        std::size_t expected_tasks = external_tasks;
+        for (auto count : subtask_counts) expected_tasks += count;
+
+        REQUIRE(tasks_completed == expected_tasks);
+    });
+}
@@ -0,0 +1,129 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <algorithm> // is_sorted()
+#include <atomic>    // atomic<>
+#include <cstdint>   // std::int64_t
+#include <vector>    // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+constexpr std::size_t repeats = 1;
+// we run tests multiple times to increase the chance of catching race conditions,
+// this is usually kept low for CI builds, can be increased locally for better coverage
+
+constexpr std::size_t threads = 7;      // weird number of threads
+constexpr std::size_t N       = 10'007; // prime number to make things never evenly divisible
+
+// Note: With auto-partitioning blocks can be of any size, the only guarantee is that every element
+//       gets visited exactly once, which is what we check
+
+// --- Auto-partitioned loops (4) ---
+// ----------------------------------
+
+TEST_CASE("Parallel-for (auto grain) / Blocking (Range)") {
+    repeat(repeats, [] {
+        std::vector<int> vec(N, 0);
+
+        parallel::set_thread_count(threads);
+        parallel::blocking_loop(parallel::Range{vec.begin(), vec.end(), parallel::auto_grain}, [](auto it) { ++*it; });
+        parallel::set_thread_count(0);
+
+        for (std::size_t i = 0; i < N; ++i) REQUIRE(vec[i] == 1);
+    });
+}
+
+TEST_CASE("Parallel-for (auto grain) / Blocking (IndexRange)") {
+    repeat(repeats, [] {
+        std::vector<int> vec(N, 0);
+
+        parallel::set_thread_count(threads);
+        parallel::blocking_loop(parallel::IndexRange<std::size_t>{0, N, parallel::auto_grain},
+                                [&](std::size_t low, std::size_t high) {
+                                    for (std::size_t i = low; i < high; ++i) ++vec[i];
+                                });
+        parallel::set_thread_count(0);
+
+        for (std::size_t i = 0; i < N; ++i) REQUIRE(vec[i] == 1);
+    });
+}
+
+TEST_CASE("Parallel-for (auto grain) / Awaitable & detached") {
+    repeat(repeats, [] {
+        std::vector<int> vec(N, 0);
+
+        parallel::set_thread_count(threads);
+        const auto range = parallel::IndexRange<std::size_t>{0, N, parallel::auto_grain};
+        parallel::awaitable_loop(range, [&](std::size_t i) { ++vec[i]; }).wait();
+        parallel::detached_loop(range, [&](std::size_t i) { ++vec[i]; });
+        parallel::wait();
+        parallel::set_thread_count(0);
+
+        for (std::size_t i = 0; i < N; ++i) REQUIRE(vec[i] == 2);
+    });
+}
+
+TEST_CASE("Parallel-for (auto grain) / Irregular workload") {
+    repeat(repeats, [] {
+        // cost of an iteration grows linearly with index, this is where fixed grains cause load imbalance
+        std::vector<std::int64_t> vec(N / 10, 0);
+        std::atomic<std::size_t>  blocks = 0;
+
+        parallel::set_thread_count(threads);
+        parallel::blocking_loop(parallel::IndexRange<std::size_t>{0, vec.size(), parallel::auto_grain},
+                                [&](std::size_t low, std::size_t high) {
+                                    ++blocks;
+                                    for (std::size_t i = low; i < high; ++i)
+                                        for (std::size_t j = 0; j < i; ++j) vec[i] += std::int64_t(j);
+                                });
+        parallel::set_thread_count(0);
+
+        for (std::size_t i = 0; i < vec.size(); ++i) REQUIRE(vec[i] == std::int64_t(i * (i - 1) / 2));
+        REQUIRE(blocks > 0);
+    });
+}
+
+// --- Algorithms with auto grain (3) ---
+// --------------------------------------
+
+TEST_CASE("Parallel-for (auto grain) / Transform-reduce") {
+    repeat(repeats, [] {
+        parallel::set_thread_count(threads);
+        const auto identity = [](std::int64_t i) { return i; };
+        const auto res      = parallel::blocking_transform_reduce(
+            parallel::IndexRange<std::int64_t>{0, std::int64_t(N), parallel::auto_grain}, std::int64_t(0),
+            parallel::sum<>{}, identity);
+        parallel::set_thread_count(0);
+
+        REQUIRE(res == std::int64_t(N * (N - 1) / 2));
+    });
+}
+
+TEST_CASE("Parallel-for (auto grain) / Scan") {
+    repeat(repeats, [] {
+        std::vector<std::int64_t> vec(100'003, 1);
+
+        parallel::set_thread_count(threads);
+        parallel::blocking_inclusive_scan(parallel::Range{vec.begin(), vec.end(), parallel::auto_grain}, vec.begin(),
+                                          parallel::sum<>{});
+        parallel::set_thread_count(0);
+
+        REQUIRE(vec.back() == std::int64_t(vec.size()));
+    });
+}
+
+TEST_CASE("Parallel-for (auto grain) / Sort") {
+    repeat(repeats, [] {
+        std::vector<std::int64_t> vec(100'003);
+        for (std::size_t i = 0; i < vec.size(); ++i) vec[i] = std::int64_t((i * 7919) % 1009);
+
+        parallel::set_thread_count(threads);
+        parallel::sort(parallel::Range{vec.begin(), vec.end(), parallel::auto_grain});
+        parallel::set_thread_count(0);
+
+        REQUIRE(std::is_sorted(vec.begin(), vec.end()));
+    });
+}
@@ -0,0 +1,109 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <atomic>       // atomic<>
+#include <forward_list> // forward_list<>
+#include <list>         // list<>
+#include <map>          // map<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+constexpr std::size_t repeats = 1;
+// we run tests multiple times to increase the chance of catching race conditions,
+// this is usually kept low for CI builds, can be increased locally for better coverage
+
+constexpr std::size_t threads = 7;    // weird number of threads
+constexpr std::size_t N       = 1367; // prime number to make things never evenly divisible
+constexpr int         x       = 17;   // test value
+
+// --- Forward & bidirectional ranges (7) ---
+// ------------------------------------------
+
+TEST_CASE("Parallel-for (forward Range) / Detached iteration loop over a list") {
+    repeat(repeats, [] {
+        std::list<int> list(N, 0);
+
+        parallel::set_thread_count(threads);
+        parallel::detached_loop(parallel::Range{list}, [&](auto it) { *it = x; });
+        parallel::set_thread_count(0);
+
+        for (const auto& e : list) REQUIRE(e == x);
+    });
+}
+
+TEST_CASE("Parallel-for (forward Range) / Blocking block loop over a list") {
+    repeat(repeats, [] {
+        std::list<int> list(N, 0);
+
+        std::atomic<std::size_t> blocks = 0;
+
+        parallel::set_thread_count(threads);
+        parallel::blocking_loop(parallel::Range{list.begin(), list.end(), 100}, [&](auto low, auto high) {
+            for (auto it = low; it != high; ++it) *it = x;
+            ++blocks;
+        });
+
+        CHECK(blocks == (N + 99) / 100); // grain size is respected
+        for (const auto& e : list) REQUIRE(e == x);
+    });
+}
+
+TEST_CASE("Parallel-for (forward Range) / Blocking iteration loop over a map") {
+    repeat(repeats, [] {
+        std::map<std::size_t, int> map;
+        for (std::size_t i = 0; i < N; ++i) map[i] = 0;
+
+        parallel::set_thread_count(threads);
+        parallel::blocking_loop(map, [&](auto it) { it->second = x; }); // container overload
+
+        for (const auto& [key, value] : map) REQUIRE(value == x);
+    });
+}
+
+TEST_CASE("Parallel-for (forward Range) / Blocking loop over a forward list with auto grain") {
+    repeat(repeats, [] {
+        std::forward_list<int> list(N, 0);
+
+        parallel::set_thread_count(threads);
+        parallel::blocking_loop(parallel::Range{list.begin(), list.end(), parallel::auto_grain}, [&](auto it) {
+            *it = x;
+        });
+
+        for (const auto& e : list) REQUIRE(e == x);
+    });
+}
+
+TEST_CASE("Parallel-for (forward Range) / Awaitable iteration loop over a forward list") {
+    repeat(repeats, [] {
+        std::forward_list<int> list(N, 0);
+
+        parallel::set_thread_count(threads);
+        auto future = parallel::awaitable_loop(list, [&](auto it) { *it = x; });
+        future.wait();
+
+        for (const auto& e : list) REQUIRE(e == x);
+    });
+}
+
+TEST_CASE("Parallel-for (forward Range) / Empty range") {
+    std::list<int> list;
+
+    std::atomic<std::size_t> calls = 0;
+
+    parallel::set_thread_count(threads);
+    parallel::blocking_loop(list, [&](auto) { ++calls; });
+
+    CHECK(calls == 0);
+}
+
+TEST_CASE("Parallel-reduce (forward Range) / Reduce over a list") {
+    std::list<int> list(N, x);
+
+    parallel::set_thread_count(threads);
+
+    CHECK(parallel::blocking_reduce(list, parallel::sum<>{}) == int(N) * x);
+    CHECK(parallel::awaitable_reduce(parallel::Range{list}, parallel::sum<>{}).get() == int(N) * x);
+}
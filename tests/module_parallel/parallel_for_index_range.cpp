@@ -4,7 +4,7 @@
 
 // _______________________ INCLUDES _______________________
 
-// None
+#include <stdexcept> // runtime_error
 
 // ____________________ IMPLEMENTATION ____________________
 
@@ -172,4 +172,21 @@ TEST_CASE("Container-for API / Awaitable iteration loop") {
 
         for (const auto& e : vec) REQUIRE(e == x);
     });
-}
\ No newline at end of file
+}
+
+// --- Exceptions (1) ---
+// ----------------------
+
+TEST_CASE("Parallel-for (IndexRange) / Blocking loop rethrows") {
+    parallel::set_thread_count(threads);
+
+    for (std::size_t grain : {std::size_t(1), std::size_t(100), parallel::auto_grain}) {
+        const auto throwing_body = [](int i) {
+            if (i == 777) throw std::runtime_error("Iteration failed");
+        };
+        REQUIRE_THROWS_AS(parallel::blocking_loop(parallel::IndexRange<int>{0, 10'000, grain}, throwing_body),
+                          std::runtime_error);
+    }
+
+    parallel::set_thread_count(0);
+}
@@ -0,0 +1,312 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <array>   // array<>
+#include <atomic>  // atomic<>
+#include <cstdlib> // abs()
+#include <vector>  // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+constexpr std::size_t repeats = 1;
+// we run tests multiple times to increase the chance of catching race conditions,
+// this is usually kept low for CI builds, can be increased locally for better coverage
+
+constexpr std::size_t threads = 7;  // weird number of threads
+constexpr std::size_t N       = 67; // prime numbers to make things never evenly divisible
+constexpr std::size_t M       = 41;
+constexpr std::size_t K       = 23;
+constexpr int         x       = 17; // test value
+
+constexpr std::array orders = {parallel::TileOrder::row_major, parallel::TileOrder::z_order,
+                               parallel::TileOrder::hilbert};
+
+// Every element should be visited exactly once regardless of the tile order
+template <class Grid>
+void check_visited_once(const Grid& grid) {
+    for (const auto& e : grid) REQUIRE(e == x);
+}
+
+// --- 'IndexRange2D' overloads (6) ---
+// ------------------------------------
+
+TEST_CASE("Parallel-for (IndexRange2D) / Detached block loop") {
+    repeat(repeats, [] {
+        for (auto order : orders) {
+            std::vector<int> grid(N * M, 0);
+
+            parallel::set_thread_count(threads);
+            parallel::detached_loop(parallel::IndexRange2D{{0, N, 10}, {0, M, 7}, order},
+                                    [&](auto i_low, auto i_high, auto j_low, auto j_high) {
+                                        for (auto i = i_low; i < i_high; ++i)
+                                            for (auto j = j_low; j < j_high; ++j) grid[i * M + j] += x;
+                                    });
+            parallel::set_thread_count(0);
+
+            check_visited_once(grid);
+        }
+    });
+}
+
+TEST_CASE("Parallel-for (IndexRange2D) / Detached iteration loop") {
+    repeat(repeats, [] {
+        for (auto order : orders) {
+            std::vector<int> grid(N * M, 0);
+
+            parallel::set_thread_count(threads);
+            parallel::detached_loop(parallel::IndexRange2D{{0, N, 10}, {0, M, 7}, order},
+                                    [&](auto i, auto j) { grid[i * M + j] += x; });
+            parallel::set_thread_count(0);
+
+            check_visited_once(grid);
+        }
+    });
+}
+
+TEST_CASE("Parallel-for (IndexRange2D) / Blocking block loop") {
+    repeat(repeats, [] {
+        for (auto order : orders) {
+            std::vector<int> grid(N * M, 0);
+
+            parallel::set_thread_count(threads);
+            parallel::blocking_loop(parallel::IndexRange2D{{0, N, 10}, {0, M, 7}, order},
+                                    [&](auto i_low, auto i_high, auto j_low, auto j_high) {
+                                        for (auto i = i_low; i < i_high; ++i)
+                                            for (auto j = j_low; j < j_high; ++j) grid[i * M + j] += x;
+                                    });
+
+            check_visited_once(grid);
+        }
+    });
+}
+
+TEST_CASE("Parallel-for (IndexRange2D) / Blocking iteration loop") {
+    repeat(repeats, [] {
+        for (auto order : orders) {
+            std::vector<int> grid(N * M, 0);
+
+            parallel::set_thread_count(threads);
+            parallel::blocking_loop(parallel::IndexRange2D{{0, N, parallel::auto_grain}, {0, M, 7}, order},
+                                    [&](auto i, auto j) { grid[i * M + j] += x; });
+
+            check_visited_once(grid);
+        }
+    });
+}
+
+TEST_CASE("Parallel-for (IndexRange2D) / Awaitable block loop") {
+    repeat(repeats, [] {
+        for (auto order : orders) {
+            std::vector<int> grid(N * M, 0);
+
+            parallel::set_thread_count(threads);
+            auto future = parallel::awaitable_loop(parallel::IndexRange2D{{0, N, 10}, {0, M, 7}, order},
+                                                   [&](auto i_low, auto i_high, auto j_low, auto j_high) {
+                                                       for (auto i = i_low; i < i_high; ++i)
+                                                           for (auto j = j_low; j < j_high; ++j) grid[i * M + j] += x;
+                                                   });
+            future.wait();
+
+            check_visited_once(grid);
+        }
+    });
+}
+
+TEST_CASE("Parallel-for (IndexRange2D) / Awaitable iteration loop") {
+    repeat(repeats, [] {
+        for (auto order : orders) {
+            std::vector<int> grid(N * M, 0);
+
+            parallel::set_thread_count(threads);
+            auto future = parallel::awaitable_loop(parallel::IndexRange2D{{0, N, 10}, {0, M, 7}, order},
+                                                   [&](auto i, auto j) { grid[i * M + j] += x; });
+            future.wait();
+
+            check_visited_once(grid);
+        }
+    });
+}
+
+// --- 'IndexRange3D' overloads (6) ---
+// ------------------------------------
+
+TEST_CASE("Parallel-for (IndexRange3D) / Detached block loop") {
+    repeat(repeats, [] {
+        for (auto order : orders) {
+            std::vector<int> grid(N * M * K, 0);
+
+            parallel::set_thread_count(threads);
+            parallel::detached_loop(
+                parallel::IndexRange3D{{0, N, 10}, {0, M, 7}, {0, K, 4}, order},
+                [&](auto i_low, auto i_high, auto j_low, auto j_high, auto k_low, auto k_high) {
+                    for (auto i = i_low; i < i_high; ++i)
+                        for (auto j = j_low; j < j_high; ++j)
+                            for (auto k = k_low; k < k_high; ++k) grid[(i * M + j) * K + k] += x;
+                });
+            parallel::set_thread_count(0);
+
+            check_visited_once(grid);
+        }
+    });
+}
+
+TEST_CASE("Parallel-for (IndexRange3D) / Detached iteration loop") {
+    repeat(repeats, [] {
+        for (auto order : orders) {
+            std::vector<int> grid(N * M * K, 0);
+
+            parallel::set_thread_count(threads);
+            parallel::detached_loop(parallel::IndexRange3D{{0, N, 10}, {0, M, 7}, {0, K, 4}, order},
+                                    [&](auto i, auto j, auto k) { grid[(i * M + j) * K + k] += x; });
+            parallel::set_thread_count(0);
+
+            check_visited_once(grid);
+        }
+    });
+}
+
+TEST_CASE("Parallel-for (IndexRange3D) / Blocking block loop") {
+    repeat(repeats, [] {
+        for (auto order : orders) {
+            std::vector<int> grid(N * M * K, 0);
+
+            parallel::set_thread_count(threads);
+            parallel::blocking_loop(
+                parallel::IndexRange3D{{0, N, 10}, {0, M, 7}, {0, K, parallel::auto_grain}, order},
+                [&](auto i_low, auto i_high, auto j_low, auto j_high, auto k_low, auto k_high) {
+                    for (auto i = i_low; i < i_high; ++i)
+                        for (auto j = j_low; j < j_high; ++j)
+                            for (auto k = k_low; k < k_high; ++k) grid[(i * M + j) * K + k] += x;
+                });
+
+            check_visited_once(grid);
+        }
+    });
+}
+
+TEST_CASE("Parallel-for (IndexRange3D) / Blocking iteration loop") {
+    repeat(repeats, [] {
+        for (auto order : orders) {
+            std::vector<int> grid(N * M * K, 0);
+
+            parallel::set_thread_count(threads);
+            parallel::blocking_loop(parallel::IndexRange3D{{0, N, 10}, {0, M, 7}, {0, K, 4}, order},
+                                    [&](auto i, auto j, auto k) { grid[(i * M + j) * K + k] += x; });
+
+            check_visited_once(grid);
+        }
+    });
+}
+
+TEST_CASE("Parallel-for (IndexRange3D) / Awaitable block loop") {
+    repeat(repeats, [] {
+        for (auto order : orders) {
+            std::vector<int> grid(N * M * K, 0);
+
+            parallel::set_thread_count(threads);
+            auto future = parallel::awaitable_loop(
+                parallel::IndexRange3D{{0, N, 10}, {0, M, 7}, {0, K, 4}, order},
+                [&](auto i_low, auto i_high, auto j_low, auto j_high, auto k_low, auto k_high) {
+                    for (auto i = i_low; i < i_high; ++i)
+                        for (auto j = j_low; j < j_high; ++j)
+                            for (auto k = k_low; k < k_high; ++k) grid[(i * M + j) * K + k] += x;
+                });
+            future.wait();
+
+            check_visited_once(grid);
+        }
+    });
+}
+
+TEST_CASE("Parallel-for (IndexRange3D) / Awaitable iteration loop") {
+    repeat(repeats, [] {
+        for (auto order : orders) {
+            std::vector<int> grid(N * M * K, 0);
+
+            parallel::set_thread_count(threads);
+            auto future = parallel::awaitable_loop(parallel::IndexRange3D{{0, N, 10}, {0, M, 7}, {0, K, 4}, order},
+                                                   [&](auto i, auto j, auto k) { grid[(i * M + j) * K + k] += x; });
+            future.wait();
+
+            check_visited_once(grid);
+        }
+    });
+}
+
+// --- Tiles (3) ---
+// -----------------
+
+TEST_CASE("Parallel-for (IndexRange2D) / Tile bounds") {
+    parallel::set_thread_count(threads);
+
+    std::atomic<std::size_t> tiles = 0, bad_tiles = 0;
+
+    const auto check_tile = [&](auto i_low, auto i_high, auto j_low, auto j_high) {
+        const bool is_valid = i_low < i_high && j_low < j_high &&            // non-empty
+                              i_high - i_low <= 10 && j_high - j_low <= 4 && // no larger than the tile size
+                              (i_low + 5) % 10 == 0 && (j_low - 3) % 4 == 0; // aligned to the grid
+        ++tiles;
+        if (!is_valid) ++bad_tiles;
+    };
+
+    parallel::blocking_loop(parallel::IndexRange2D{{-5, 20, 10}, {3, 10, 4}}, check_tile);
+
+    REQUIRE(tiles == 3 * 2);
+    REQUIRE(bad_tiles == 0);
+
+    // Empty ranges produce no tiles
+    parallel::blocking_loop(parallel::IndexRange2D{{0, 0, 10}, {0, 10, 4}}, [&](auto, auto) { ++tiles; });
+    parallel::blocking_loop(parallel::IndexRange3D{{0, 10}, {5, 5}, {0, 10}}, [&](auto, auto, auto) { ++tiles; });
+
+    REQUIRE(tiles == 3 * 2);
+
+    parallel::set_thread_count(0);
+}
+
+// With a single thread tiles get processed in exactly the tile order, on a power-of-2 grid
+// each tile of a Hilbert curve should be a neighbor of the previous one
+TEST_CASE("Parallel-for (IndexRange2D) / Tile order") {
+    parallel::Scheduler scheduler{1};
+
+    const auto traverse = [&](parallel::TileOrder order) {
+        std::vector<std::array<int, 2>> tiles;
+        scheduler.blocking_loop(parallel::IndexRange2D<int>{{0, 16, 2}, {0, 16, 2}, order},
+                                [&](int i_low, int, int j_low, int) { tiles.push_back({i_low / 2, j_low / 2}); });
+        return tiles;
+    };
+
+    const auto row_major = traverse(parallel::TileOrder::row_major);
+    REQUIRE(row_major.size() == 64);
+    for (std::size_t t = 0; t < row_major.size(); ++t) REQUIRE(row_major[t] == std::array{int(t / 8), int(t % 8)});
+
+    const auto z_order = traverse(parallel::TileOrder::z_order);
+    REQUIRE(z_order.size() == 64);
+    for (std::size_t t = 0; t < z_order.size(); t += 4) { // Z-order visits tiles in 2x2 quads
+        REQUIRE(z_order[t + 0][0] == z_order[t + 1][0]);
+        REQUIRE(z_order[t + 2][0] == z_order[t + 3][0]);
+        REQUIRE(z_order[t + 0][1] == z_order[t + 2][1]);
+        REQUIRE(z_order[t + 1][1] == z_order[t + 3][1]);
+    }
+
+    const auto hilbert = traverse(parallel::TileOrder::hilbert);
+    REQUIRE(hilbert.size() == 64);
+    for (std::size_t t = 1; t < hilbert.size(); ++t)
+        REQUIRE(std::abs(hilbert[t][0] - hilbert[t - 1][0]) + std::abs(hilbert[t][1] - hilbert[t - 1][1]) == 1);
+}
+
+TEST_CASE("Parallel-for (IndexRange3D) / Tile order") {
+    parallel::Scheduler scheduler{1};
+
+    std::vector<std::array<int, 3>> tiles;
+    scheduler.blocking_loop(parallel::IndexRange3D<int>{{0, 8, 1}, {0, 8, 1}, {0, 8, 1}, parallel::TileOrder::hilbert},
+                            [&](int i, int, int j, int, int k, int) { tiles.push_back({i, j, k}); });
+
+    REQUIRE(tiles.size() == 512);
+    for (std::size_t t = 1; t < tiles.size(); ++t)
+        REQUIRE(std::abs(tiles[t][0] - tiles[t - 1][0]) + std::abs(tiles[t][1] - tiles[t - 1][1]) +
+                    std::abs(tiles[t][2] - tiles[t - 1][2]) ==
+                1);
+}
@@ -0,0 +1,141 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <cmath>     // pow()
+#include <cstdint>   // uint64_t
+#include <cstring>   // memcmp()
+#include <stdexcept> // runtime_error
+#include <string>    // string
+#include <vector>    // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+constexpr std::size_t repeats = 10;
+// we run tests multiple times to increase the chance of catching race conditions,
+// this is usually kept low for CI builds, can be increased locally for better coverage
+
+constexpr std::size_t N     = 100'003; // prime number to make things never evenly divisible
+constexpr std::size_t grain = 997;
+
+// Values of wildly different magnitudes, floating point sum of these depends heavily on the order of additions
+std::vector<double> make_values() {
+    std::vector<double> values(N);
+    for (std::size_t i = 0; i < N; ++i)
+        values[i] = std::pow(-1.7, double(pseudorandom(i) % 60)) * (1.0 + double(pseudorandom(i + N) % 1000) / 1000.0);
+    return values;
+}
+
+bool bitwise_equal(double lhs, double rhs) { return std::memcmp(&lhs, &rhs, sizeof(double)) == 0; }
+
+// Fixed combine tree the deterministic reduction is expected to use
+double reference_sum(const std::vector<double>& values, std::size_t grain_size) {
+    std::vector<double> partials;
+    for (std::size_t low = 0; low < values.size(); low += grain_size) {
+        double partial = values[low];
+        for (std::size_t i = low + 1; i < std::min(low + grain_size, values.size()); ++i) partial += values[i];
+        partials.push_back(partial);
+    }
+
+    for (std::size_t stride = 1; stride < partials.size(); stride *= 2)
+        for (std::size_t i = 0; i + stride < partials.size(); i += 2 * stride) partials[i] += partials[i + stride];
+
+    return partials.front();
+}
+
+// --- Reproducibility (3) ---
+// ---------------------------
+
+TEST_CASE("Parallel-reduce (deterministic) / Reproducible across runs") {
+    const std::vector<double> values = make_values();
+
+    parallel::set_thread_count(7);
+
+    const double first = parallel::blocking_deterministic_reduce(parallel::Range{values}, parallel::sum<>{});
+
+    repeat(repeats, [&] {
+        const double result = parallel::blocking_deterministic_reduce(parallel::Range{values}, parallel::sum<>{});
+        REQUIRE(bitwise_equal(result, first));
+    });
+
+    parallel::set_thread_count(0);
+}
+
+TEST_CASE("Parallel-reduce (deterministic) / Reproducible across thread counts") {
+    const std::vector<double> values   = make_values();
+    const double              expected = reference_sum(values, grain);
+
+    for (std::size_t threads : {1, 2, 3, 7, 16}) {
+        parallel::set_thread_count(threads);
+
+        const double result = parallel::blocking_deterministic_reduce(
+            parallel::Range{values.begin(), values.end(), grain}, parallel::sum<>{});
+        REQUIRE(bitwise_equal(result, expected));
+
+        const double awaited = parallel::awaitable_deterministic_reduce(
+                                   parallel::Range{values.begin(), values.end(), grain}, parallel::sum<>{})
+                                   .get();
+        REQUIRE(bitwise_equal(awaited, expected));
+    }
+
+    parallel::set_thread_count(0);
+}
+
+TEST_CASE("Parallel-reduce (deterministic) / Local scheduler") {
+    const std::vector<double> values   = make_values();
+    const double              expected = reference_sum(values, grain);
+
+    parallel::Scheduler scheduler{5};
+
+    const double result =
+        scheduler.blocking_deterministic_reduce(parallel::Range{values.begin(), values.end(), grain}, parallel::sum<>{});
+    REQUIRE(bitwise_equal(result, expected));
+}
+
+// --- Generic (3) ---
+// -------------------
+
+TEST_CASE("Parallel-reduce (deterministic) / Non-commutative op") {
+    parallel::set_thread_count(7);
+
+    std::vector<std::string> words;
+    for (std::size_t i = 0; i < 1000; ++i) words.push_back(std::to_string(i % 10));
+
+    std::string expected;
+    for (const auto& word : words) expected += word;
+
+    // Order of the elements is always preserved, only the grouping changes
+    REQUIRE(parallel::blocking_deterministic_reduce(words, parallel::sum<>{}) == expected);
+    REQUIRE(parallel::awaitable_deterministic_reduce(words, parallel::sum<>{}).get() == expected);
+
+    parallel::set_thread_count(0);
+}
+
+TEST_CASE("Parallel-reduce (deterministic) / Single element & empty range") {
+    parallel::set_thread_count(7);
+
+    const std::vector<int> single = {17};
+    const std::vector<int> empty  = {};
+
+    REQUIRE(parallel::blocking_deterministic_reduce(single, parallel::max<>{}) == 17);
+    REQUIRE_THROWS_AS(parallel::blocking_deterministic_reduce(empty, parallel::sum<>{}), std::runtime_error);
+
+    parallel::set_thread_count(0);
+}
+
+TEST_CASE("Parallel-reduce (deterministic) / Exceptions") {
+    parallel::set_thread_count(7);
+
+    const std::vector<int> values(1000, 1);
+
+    const auto throwing_sum = [](int lhs, int rhs) {
+        if (lhs + rhs > 500) throw std::runtime_error("Sum is too large");
+        return lhs + rhs;
+    };
+
+    REQUIRE_THROWS_AS(parallel::blocking_deterministic_reduce(values, throwing_sum), std::runtime_error);
+
+    parallel::set_thread_count(0);
+}
@@ -16,7 +16,8 @@ constexpr std::size_t repeats = 1;
 constexpr std::size_t threads = 7;  // weird number of threads
 constexpr std::size_t N       = 37; // prime number to make things never evenly divisible
 
-// Note: Large values of 'N' might cause product to overflow
+// Note: Partial results are combined per worker, so intermediate products can overflow even if the final one
+//       doesn't, product tests use small non-zero values for that reason, large 'N' might still overflow
 
 // --- 'Range' blocking reduce for different binary ops (4) ---
 // ------------------------------------------------------------
@@ -40,7 +41,7 @@ TEST_CASE("Parallel-reduce (Range) / Blocking sum") {
 TEST_CASE("Parallel-reduce (Range) / Blocking prod") {
     repeat(repeats, [] {
         std::vector<std::int64_t> vec(N, 0);
-        for (std::size_t i = 0; i < N; ++i) vec[i] = i;
+        for (std::size_t i = 0; i < N; ++i) vec[i] = 1 + i % 2;
 
         std::int64_t res_serial = vec[0];
         for (std::size_t i = 1; i < N; ++i) res_serial *= vec[i];
@@ -107,7 +108,7 @@ TEST_CASE("Parallel-reduce (Range) / Awaitable sum") {
 TEST_CASE("Parallel-reduce (Range) / Awaitable prod") {
     repeat(repeats, [] {
         std::vector<std::int64_t> vec(N, 0);
-        for (std::size_t i = 0; i < N; ++i) vec[i] = i;
+        for (std::size_t i = 0; i < N; ++i) vec[i] = 1 + i % 2;
 
         std::int64_t res_serial = vec[0];
         for (std::size_t i = 1; i < N; ++i) res_serial *= vec[i];
@@ -0,0 +1,146 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <cstdint> // std::int64_t, std::uint64_t
+#include <numeric> // inclusive_scan(), exclusive_scan()
+#include <vector>  // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+constexpr std::size_t repeats = 1;
+// we run tests multiple times to increase the chance of catching race conditions,
+// this is usually kept low for CI builds, can be increased locally for better coverage
+
+constexpr std::size_t threads = 7; // weird number of threads
+
+constexpr std::size_t N_small = 37;      // goes through a serial path
+constexpr std::size_t N_large = 100'003; // goes through a parallel path, prime to never be evenly divisible
+
+// Note: Serial & parallel scans use different order of operations, integers make sure it doesn't affect results
+
+// --- Inclusive / exclusive scan over different ranges (4) ---
+// ------------------------------------------------------------
+
+TEST_CASE("Parallel-scan / Blocking inclusive (Range)") {
+    repeat(repeats, [] {
+        for (std::size_t N : {N_small, N_large}) {
+            std::vector<std::int64_t> vec(N);
+            for (std::size_t i = 0; i < N; ++i) vec[i] = i % 13;
+
+            std::vector<std::int64_t> res_serial(N), res_parallel(N);
+            std::inclusive_scan(vec.begin(), vec.end(), res_serial.begin());
+
+            parallel::set_thread_count(threads);
+            const auto end = parallel::blocking_inclusive_scan(parallel::Range{vec.begin(), vec.end(), 1000},
+                                                               res_parallel.begin(), parallel::sum<>{});
+            parallel::set_thread_count(0);
+
+            REQUIRE(end == res_parallel.end());
+            REQUIRE(res_parallel == res_serial);
+        }
+    });
+}
+
+TEST_CASE("Parallel-scan / Blocking exclusive (Range)") {
+    repeat(repeats, [] {
+        for (std::size_t N : {N_small, N_large}) {
+            std::vector<std::int64_t> vec(N);
+            for (std::size_t i = 0; i < N; ++i) vec[i] = i % 13;
+
+            std::vector<std::int64_t> res_serial(N), res_parallel(N);
+            std::exclusive_scan(vec.begin(), vec.end(), res_serial.begin(), std::int64_t(7));
+
+            parallel::set_thread_count(threads);
+            parallel::blocking_exclusive_scan(vec, res_parallel.begin(), std::int64_t(7), parallel::sum<>{});
+            parallel::set_thread_count(0);
+
+            REQUIRE(res_parallel == res_serial);
+        }
+    });
+}
+
+TEST_CASE("Parallel-scan / Blocking inclusive (IndexRange)") {
+    repeat(repeats, [] {
+        std::vector<std::int64_t> res_serial(N_large), res_parallel(N_large);
+        for (std::size_t i = 0; i < N_large; ++i) res_serial[i] = i * i;
+        std::inclusive_scan(res_serial.begin(), res_serial.end(), res_serial.begin());
+
+        parallel::set_thread_count(threads);
+        const auto square = [](std::int64_t i) { return i * i; };
+        parallel::blocking_inclusive_scan(parallel::IndexRange<std::int64_t>{0, std::int64_t(N_large)},
+                                          res_parallel.begin(), parallel::sum<>{}, square);
+        parallel::set_thread_count(0);
+
+        REQUIRE(res_parallel == res_serial);
+    });
+}
+
+TEST_CASE("Parallel-scan / Blocking exclusive (IndexRange)") {
+    repeat(repeats, [] {
+        // exclusive scan over 0/1 flags is how stream compaction computes output positions
+        const auto is_kept = [](std::size_t i) { return std::size_t(i % 3 == 0); };
+
+        std::vector<std::size_t> res_serial(N_large), res_parallel(N_large);
+        for (std::size_t i = 0; i < N_large; ++i) res_serial[i] = is_kept(i);
+        std::exclusive_scan(res_serial.begin(), res_serial.end(), res_serial.begin(), std::size_t(0));
+
+        parallel::set_thread_count(threads);
+        parallel::blocking_exclusive_scan(parallel::IndexRange<std::size_t>{0, N_large, 4096}, res_parallel.begin(),
+                                          std::size_t(0), parallel::sum<>{}, is_kept);
+        parallel::set_thread_count(0);
+
+        REQUIRE(res_parallel == res_serial);
+    });
+}
+
+// --- Edge cases (3) ---
+// ----------------------
+
+TEST_CASE("Parallel-scan / Awaitable & in-place") {
+    repeat(repeats, [] {
+        std::vector<std::int64_t> vec(N_large, 1);
+
+        parallel::set_thread_count(threads);
+        auto future = parallel::awaitable_inclusive_scan(vec, vec.begin(), parallel::sum<>{});
+        future.wait();
+        parallel::set_thread_count(0);
+
+        bool correct = true;
+        for (std::size_t i = 0; i < N_large; ++i) correct &= (vec[i] == std::int64_t(i + 1));
+        REQUIRE(correct);
+    });
+}
+
+TEST_CASE("Parallel-scan / Non-commutative operation") {
+    repeat(repeats, [] {
+        // composition of affine maps 'x -> a * x + b' is associative, but not commutative
+        struct Affine {
+            std::uint64_t a, b;
+            bool          operator==(const Affine& other) const { return a == other.a && b == other.b; }
+        };
+        const auto compose = [](const Affine& f, const Affine& g) { return Affine{g.a * f.a, g.a * f.b + g.b}; };
+
+        std::vector<Affine> vec(N_large);
+        for (std::size_t i = 0; i < N_large; ++i) vec[i] = {i % 7 + 1, i % 11};
+
+        std::vector<Affine> res_serial(N_large, Affine{0, 0}), res_parallel(N_large, Affine{0, 0});
+        std::inclusive_scan(vec.begin(), vec.end(), res_serial.begin(), compose);
+
+        parallel::set_thread_count(threads);
+        parallel::blocking_inclusive_scan(vec, res_parallel.begin(), compose);
+        parallel::set_thread_count(0);
+
+        REQUIRE(res_parallel == res_serial);
+    });
+}
+
+TEST_CASE("Parallel-scan / Empty range") {
+    parallel::set_thread_count(threads);
+    std::vector<int> vec, res;
+    REQUIRE(parallel::blocking_inclusive_scan(vec, res.begin(), parallel::sum<>{}) == res.begin());
+    REQUIRE(parallel::blocking_exclusive_scan(vec, res.begin(), 0, parallel::sum<>{}) == res.begin());
+    parallel::set_thread_count(0);
+}
@@ -0,0 +1,166 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <algorithm>  // sort(), stable_sort(), is_sorted(), is_partitioned()
+#include <atomic>     // atomic<>
+#include <cstdint>    // std::uint64_t
+#include <functional> // greater<>
+#include <string>     // string, to_string()
+#include <utility>    // pair<>
+#include <vector>     // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+constexpr std::size_t repeats = 1;
+// we run tests multiple times to increase the chance of catching race conditions,
+// this is usually kept low for CI builds, can be increased locally for better coverage
+
+constexpr std::size_t threads = 7; // weird number of threads
+
+constexpr std::size_t N_small = 37;      // goes through a serial path
+constexpr std::size_t N_large = 100'003; // goes through a parallel path, prime to never be evenly divisible
+
+// --- Sorting (4) ---
+// ------------------
+
+TEST_CASE("Parallel-sort / Sort") {
+    repeat(repeats, [] {
+        for (std::size_t N : {N_small, N_large}) {
+            std::vector<std::uint64_t> vec(N);
+            for (std::size_t i = 0; i < N; ++i) vec[i] = pseudorandom(i) % 1000;
+
+            auto res_serial   = vec;
+            auto res_parallel = vec;
+            std::sort(res_serial.begin(), res_serial.end());
+
+            parallel::set_thread_count(threads);
+            parallel::sort(res_parallel);
+            parallel::set_thread_count(0);
+
+            REQUIRE(res_parallel == res_serial);
+        }
+    });
+}
+
+TEST_CASE("Parallel-sort / Sort with a custom comparator & grain size") {
+    repeat(repeats, [] {
+        std::vector<std::string> vec(N_large);
+        for (std::size_t i = 0; i < N_large; ++i) vec[i] = std::to_string(pseudorandom(i));
+
+        auto res_serial   = vec;
+        auto res_parallel = vec;
+        std::sort(res_serial.begin(), res_serial.end(), std::greater<>{});
+
+        parallel::set_thread_count(threads);
+        parallel::sort(parallel::Range{res_parallel.begin(), res_parallel.end(), 1000}, std::greater<>{});
+        parallel::set_thread_count(0);
+
+        REQUIRE(res_parallel == res_serial);
+    });
+}
+
+TEST_CASE("Parallel-sort / Stable sort") {
+    repeat(repeats, [] {
+        // sort by key only, second member records the original position to check that order of ties is preserved
+        std::vector<std::pair<int, std::size_t>> vec(N_large);
+        for (std::size_t i = 0; i < N_large; ++i) vec[i] = {int(pseudorandom(i) % 100), i};
+
+        const auto by_key = [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; };
+
+        auto res_serial   = vec;
+        auto res_parallel = vec;
+        std::stable_sort(res_serial.begin(), res_serial.end(), by_key);
+
+        parallel::set_thread_count(threads);
+        parallel::stable_sort(parallel::Range{res_parallel.begin(), res_parallel.end(), 3000}, by_key);
+        parallel::set_thread_count(0);
+
+        REQUIRE(res_parallel == res_serial);
+    });
+}
+
+TEST_CASE("Parallel-sort / Sort presorted data") {
+    repeat(repeats, [] {
+        std::vector<std::uint64_t> ascending(N_large), descending(N_large);
+        for (std::size_t i = 0; i < N_large; ++i) ascending[i] = i, descending[i] = N_large - i;
+
+        parallel::set_thread_count(threads);
+        parallel::sort(ascending);
+        parallel::sort(descending);
+        parallel::set_thread_count(0);
+
+        REQUIRE(std::is_sorted(ascending.begin(), ascending.end()));
+        REQUIRE(std::is_sorted(descending.begin(), descending.end()));
+    });
+}
+
+// --- Partitioning (3) ---
+// ------------------------
+
+TEST_CASE("Parallel-sort / Partition") {
+    repeat(repeats, [] {
+        for (std::size_t N : {N_small, N_large}) {
+            std::vector<std::uint64_t> vec(N);
+            for (std::size_t i = 0; i < N; ++i) vec[i] = pseudorandom(i);
+
+            const auto is_even = [](std::uint64_t x) { return x % 2 == 0; };
+
+            auto res_serial   = vec;
+            auto res_parallel = vec;
+            std::stable_partition(res_serial.begin(), res_serial.end(), is_even);
+
+            parallel::set_thread_count(threads);
+            const auto point = parallel::partition(res_parallel, is_even);
+            parallel::set_thread_count(0);
+
+            REQUIRE(std::is_partitioned(res_parallel.begin(), res_parallel.end(), is_even));
+            REQUIRE(point == std::partition_point(res_parallel.begin(), res_parallel.end(), is_even));
+            if (N == N_large) REQUIRE(res_parallel == res_serial); // parallel version also happens to be stable
+        }
+    });
+}
+
+TEST_CASE("Parallel-sort / Partition with all elements on one side") {
+    repeat(repeats, [] {
+        std::vector<std::uint64_t> vec(N_large, 1);
+
+        parallel::set_thread_count(threads);
+        const auto all  = parallel::partition(vec, [](std::uint64_t x) { return x == 1; });
+        const auto none = parallel::partition(vec, [](std::uint64_t x) { return x == 0; });
+        parallel::set_thread_count(0);
+
+        REQUIRE(all == vec.end());
+        REQUIRE(none == vec.begin());
+    });
+}
+
+TEST_CASE("Parallel-sort / Partition evaluates predicate once per element") {
+    repeat(repeats, [] {
+        // Leading even & trailing odd elements are already in place, only the middle part gets moved around
+        std::vector<std::uint64_t> vec(N_large);
+        for (std::size_t i = 0; i < N_large; ++i) vec[i] = 2 * pseudorandom(i) + (i < N_large / 4 ? 0 : 1);
+        for (std::size_t i = N_large / 4; i < N_large / 2; ++i) vec[i] = pseudorandom(i);
+
+        const auto is_even = [](std::uint64_t x) { return x % 2 == 0; };
+
+        auto res_serial   = vec;
+        auto res_parallel = vec;
+        std::stable_partition(res_serial.begin(), res_serial.end(), is_even);
+
+        std::atomic<std::size_t> calls = 0;
+
+        parallel::set_thread_count(threads);
+        const auto point = parallel::partition(res_parallel, [&](std::uint64_t x) {
+            ++calls;
+            return is_even(x);
+        });
+        parallel::set_thread_count(0);
+
+        REQUIRE(calls == N_large);
+        REQUIRE(point == std::partition_point(res_parallel.begin(), res_parallel.end(), is_even));
+        REQUIRE(res_parallel == res_serial);
+    });
+}
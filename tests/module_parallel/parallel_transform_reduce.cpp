@@ -0,0 +1,112 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <algorithm> // max()
+#include <cstdint>   // std::int64_t
+#include <string>    // string
+#include <vector>    // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+constexpr std::size_t repeats = 1;
+// we run tests multiple times to increase the chance of catching race conditions,
+// this is usually kept low for CI builds, can be increased locally for better coverage
+
+constexpr std::size_t threads = 7;  // weird number of threads
+constexpr std::size_t N       = 37; // prime number to make things never evenly divisible
+
+// --- Transform-reduce over different ranges (3) ---
+// --------------------------------------------------
+
+TEST_CASE("Parallel-transform-reduce / Blocking (Range)") {
+    repeat(repeats, [] {
+        std::vector<std::int64_t> vec(N, 0);
+        for (std::size_t i = 0; i < N; ++i) vec[i] = i;
+
+        std::int64_t res_serial = 5;
+        for (std::size_t i = 0; i < N; ++i) res_serial += vec[i] * vec[i];
+
+        parallel::set_thread_count(threads);
+        const auto   square       = [](std::int64_t x) { return x * x; };
+        std::int64_t res_parallel = parallel::blocking_transform_reduce(parallel::Range{vec.begin(), vec.end(), 1},
+                                                                        std::int64_t(5), parallel::sum<>{}, square);
+        parallel::set_thread_count(0);
+
+        REQUIRE(res_parallel == res_serial);
+    });
+}
+
+TEST_CASE("Parallel-transform-reduce / Blocking (IndexRange)") {
+    repeat(repeats, [] {
+        std::vector<std::int64_t> a(N, 0), b(N, 0);
+        for (std::size_t i = 0; i < N; ++i) a[i] = i, b[i] = 2 * i + 1;
+
+        std::int64_t res_serial = 0;
+        for (std::size_t i = 0; i < N; ++i) res_serial += a[i] * b[i];
+
+        parallel::set_thread_count(threads);
+        const auto   product      = [&](std::size_t i) { return a[i] * b[i]; };
+        std::int64_t res_parallel = parallel::blocking_transform_reduce(parallel::IndexRange<std::size_t>{0, N, 2},
+                                                                        std::int64_t(0), parallel::sum<>{}, product);
+        parallel::set_thread_count(0);
+
+        REQUIRE(res_parallel == res_serial);
+    });
+}
+
+TEST_CASE("Parallel-transform-reduce / Blocking (Container)") {
+    repeat(repeats, [] {
+        std::vector<std::string> vec(N);
+        for (std::size_t i = 0; i < N; ++i) vec[i] = std::string(i % 5, 'x');
+
+        std::size_t res_serial = 0;
+        for (std::size_t i = 0; i < N; ++i) res_serial = std::max(res_serial, vec[i].size());
+
+        parallel::set_thread_count(threads);
+        const auto  length       = [](const std::string& str) { return str.size(); };
+        std::size_t res_parallel = parallel::blocking_transform_reduce(vec, std::size_t(0), parallel::max<>{}, length);
+        parallel::set_thread_count(0);
+
+        REQUIRE(res_parallel == res_serial);
+    });
+}
+
+// --- Edge cases (3) ---
+// ----------------------
+
+TEST_CASE("Parallel-transform-reduce / Awaitable") {
+    repeat(repeats, [] {
+        parallel::set_thread_count(threads);
+        const auto identity = [](std::int64_t i) { return i; };
+        auto       future   = parallel::awaitable_transform_reduce(parallel::IndexRange<std::int64_t>{0, 1000},
+                                                                   std::int64_t(0), parallel::sum<>{}, identity);
+        REQUIRE(future.get() == 999 * 1000 / 2);
+        parallel::set_thread_count(0);
+    });
+}
+
+TEST_CASE("Parallel-transform-reduce / Empty range returns init") {
+    parallel::set_thread_count(threads);
+    const std::vector<int> vec;
+    const auto             identity = [](int x) { return x; };
+    REQUIRE(parallel::blocking_transform_reduce(vec, 17, parallel::sum<>{}, identity) == 17);
+    REQUIRE_THROWS(parallel::blocking_reduce(vec, parallel::sum<>{}));
+    parallel::set_thread_count(0);
+}
+
+TEST_CASE("Parallel-transform-reduce / Reduce keeps user grain size") {
+    // each grain is a single element, which maximizes the number of partial results that get merged into slots
+    repeat(repeats, [] {
+        std::vector<std::int64_t> vec(10'000, 3);
+
+        parallel::set_thread_count(threads);
+        const auto range = parallel::Range{vec.begin(), vec.end(), 1};
+        const auto res   = parallel::blocking_reduce(range, parallel::sum<>{});
+        parallel::set_thread_count(0);
+
+        REQUIRE(res == 30'000);
+    });
+}
@@ -0,0 +1,105 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <atomic> // atomic<>
+#include <thread> // thread
+#include <vector> // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+constexpr std::size_t repeats = 10;
+// we run tests multiple times to increase the chance of catching race conditions,
+// this is usually kept low for CI builds, can be increased locally for better coverage
+
+constexpr std::size_t N = 100'003; // prime number to make things never evenly divisible
+
+// --- Per-worker storage (5) ---
+// ------------------------------
+
+TEST_CASE("Per-worker / Accumulation") {
+    parallel::set_thread_count(8);
+
+    repeat(repeats, [&] {
+        parallel::PerWorker<std::size_t> sums;
+
+        parallel::blocking_loop(parallel::IndexRange<std::size_t>{0, N}, [&](std::size_t i) { sums.local() += i; });
+
+        CHECK(sums.size() <= 8);
+        CHECK(sums.combine(parallel::sum<>{}) == N * (N - 1) / 2);
+    });
+}
+
+TEST_CASE("Per-worker / Lazy construction & factory") {
+    parallel::set_thread_count(4);
+
+    std::atomic<int> constructed = 0;
+
+    parallel::PerWorker<std::vector<int>> buffers([&] {
+        ++constructed;
+        return std::vector<int>(16, 0);
+    });
+
+    CHECK(buffers.size() == 0);
+    CHECK(constructed == 0);
+    CHECK(buffers.combine([](auto lhs, const auto&) { return lhs; }).size() == 16); // factory value when empty
+
+    parallel::blocking_loop(parallel::IndexRange<std::size_t>{0, N}, [&](std::size_t i) { buffers.local()[i % 16]++; });
+
+    CHECK(constructed <= 1 + 4); // one for the empty combine + at most one per worker
+    CHECK(buffers.size() == std::size_t(constructed) - 1);
+
+    std::size_t total = 0;
+    buffers.for_each([&](std::vector<int>& buffer) {
+        for (int e : buffer) total += e;
+    });
+    CHECK(total == N);
+
+    buffers.clear();
+    CHECK(buffers.size() == 0);
+}
+
+TEST_CASE("Per-worker / Non-pool threads") {
+    parallel::PerWorker<int> values;
+
+    values.local() = 1; // main thread doesn't belong to the pool
+
+    std::thread thread([&] { values.local() = 2; });
+    thread.join();
+
+    CHECK(values.local() == 1); // same value on repeated access
+    CHECK(values.size() == 2);
+    CHECK(values.combine(parallel::sum<>{}) == 3);
+}
+
+TEST_CASE("Per-worker / Resized with the thread pool") {
+    parallel::set_thread_count(2);
+
+    parallel::PerWorker<std::size_t> counts;
+
+    const auto count_iterations = [&] {
+        parallel::blocking_loop(parallel::IndexRange<std::size_t>{0, N}, [&](std::size_t) { ++counts.local(); });
+    };
+
+    count_iterations();
+    parallel::set_thread_count(8); // grow
+    count_iterations();
+    parallel::set_thread_count(3); // shrink, values of the removed workers are kept
+    count_iterations();
+
+    CHECK(counts.combine(parallel::sum<>{}) == 3 * N);
+}
+
+TEST_CASE("Per-worker / Local thread pool") {
+    parallel::ThreadPool pool(4);
+
+    parallel::PerWorker<std::size_t> sums(pool, [] { return std::size_t(0); });
+
+    for (std::size_t i = 0; i < 1000; ++i) pool.detached_task([&, i] { sums.local() += i; });
+    pool.wait();
+
+    CHECK(sums.size() <= 4);
+    CHECK(sums.combine(parallel::sum<>{}) == 1000 * 999 / 2);
+}
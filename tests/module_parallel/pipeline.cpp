@@ -0,0 +1,231 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <algorithm> // sort(), max()
+#include <atomic>    // atomic<>
+#include <cstdint>   // uint64_t
+#include <memory>    // unique_ptr<>, make_unique<>()
+#include <optional>  // optional<>, nullopt
+#include <stdexcept> // runtime_error
+#include <string>    // string, to_string(), stoi()
+#include <vector>    // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+constexpr std::size_t repeats = 10;
+// we run tests multiple times to increase the chance of catching race conditions,
+// this is usually kept low for CI builds, can be increased locally for better coverage
+
+constexpr std::size_t threads = 7; // weird number of threads
+
+constexpr int item_count = 2000;
+
+// Uneven amount of busy work, makes tokens overtake each other in parallel stages
+int uneven_work(int i) {
+    volatile std::uint64_t acc = 0; // prevents the loop from being optimized away
+    for (std::uint64_t k = 0; k < pseudorandom(i) % 2000; ++k) acc = acc + pseudorandom(k);
+    return i;
+}
+
+// Serial stages should never be entered by multiple threads at once
+struct ExclusiveCheck {
+    std::atomic<int> inside     = 0;
+    std::atomic<int> violations = 0;
+
+    void enter() {
+        if (this->inside.fetch_add(1) != 0) ++this->violations;
+    }
+    void leave() { this->inside.fetch_sub(1); }
+};
+
+// --- Stage modes (3) ---
+// -----------------------
+
+TEST_CASE("Pipeline / Serial in-order stages preserve the order") {
+    parallel::set_thread_count(threads);
+
+    for (std::size_t r = 0; r < repeats; ++r) {
+        int              next = 0;
+        std::vector<int> output;
+        ExclusiveCheck   check;
+
+        parallel::pipeline(
+            threads * 2,
+            [&]() -> std::optional<int> {
+                if (next == item_count) return std::nullopt;
+                return next++;
+            },
+            parallel::stage(parallel::StageMode::parallel, [](int i) { return uneven_work(i); }),
+            parallel::stage(parallel::StageMode::parallel, [](int i) { return std::to_string(i); }),
+            parallel::stage(parallel::StageMode::serial_in_order, [&](std::string s) {
+                check.enter();
+                output.push_back(std::stoi(s));
+                check.leave();
+            }));
+
+        REQUIRE(check.violations == 0);
+        REQUIRE(output.size() == item_count);
+        for (int i = 0; i < item_count; ++i) REQUIRE(output[i] == i);
+    }
+
+    parallel::set_thread_count(0);
+}
+
+TEST_CASE("Pipeline / Serial out-of-order stages see every item once") {
+    parallel::set_thread_count(threads);
+
+    for (std::size_t r = 0; r < repeats; ++r) {
+        int              next = 0;
+        std::vector<int> output;
+        ExclusiveCheck   check_1, check_2;
+
+        parallel::pipeline(
+            threads * 2,
+            [&]() -> std::optional<int> {
+                if (next == item_count) return std::nullopt;
+                return next++;
+            },
+            parallel::stage(parallel::StageMode::parallel, [](int i) { return uneven_work(i); }),
+            parallel::stage(parallel::StageMode::serial_out_of_order,
+                            [&](int i) {
+                                check_1.enter();
+                                check_1.leave();
+                                return i;
+                            }),
+            parallel::stage(parallel::StageMode::serial_out_of_order, [&](int i) {
+                check_2.enter();
+                output.push_back(i);
+                check_2.leave();
+            }));
+
+        REQUIRE(check_1.violations == 0);
+        REQUIRE(check_2.violations == 0);
+
+        std::sort(output.begin(), output.end());
+        REQUIRE(output.size() == item_count);
+        for (int i = 0; i < item_count; ++i) REQUIRE(output[i] == i);
+    }
+
+    parallel::set_thread_count(0);
+}
+
+TEST_CASE("Pipeline / Stages take & return values by move") {
+    parallel::set_thread_count(threads);
+
+    int next = 0, sum = 0;
+
+    parallel::pipeline(
+        4,
+        [&]() -> std::optional<std::unique_ptr<int>> {
+            if (next == item_count) return std::nullopt;
+            return std::make_unique<int>(next++);
+        },
+        parallel::stage(parallel::StageMode::parallel,
+                        [](std::unique_ptr<int> ptr) {
+                            *ptr *= 2;
+                            return ptr;
+                        }),
+        parallel::stage(parallel::StageMode::serial_in_order, [&](std::unique_ptr<int> ptr) { sum += *ptr; }));
+
+    REQUIRE(sum == item_count * (item_count - 1));
+
+    parallel::set_thread_count(0);
+}
+
+// --- Flow control (3) ---
+// ------------------------
+
+TEST_CASE("Pipeline / Tokens in flight are bounded") {
+    parallel::set_thread_count(threads);
+
+    for (std::size_t max_tokens : {1, 3, 16}) {
+        int              next = 0;
+        std::atomic<int> in_flight = 0, max_in_flight = 0;
+
+        parallel::pipeline(
+            max_tokens,
+            [&]() -> std::optional<int> {
+                if (next == item_count) return std::nullopt;
+                const int current = ++in_flight;
+                if (current > max_in_flight) max_in_flight = current; // source is serial, no CAS needed
+                return next++;
+            },
+            parallel::stage(parallel::StageMode::parallel, [](int i) { return uneven_work(i); }),
+            parallel::stage(parallel::StageMode::serial_in_order, [&](int) { --in_flight; }));
+
+        REQUIRE(next == item_count);
+        REQUIRE(max_in_flight <= int(max_tokens));
+    }
+
+    parallel::set_thread_count(0);
+}
+
+TEST_CASE("Pipeline / Empty source") {
+    parallel::set_thread_count(threads);
+
+    bool called = false;
+
+    parallel::pipeline(
+        4, []() -> std::optional<int> { return std::nullopt; },
+        parallel::stage(parallel::StageMode::serial_in_order, [&](int) { called = true; }));
+
+    REQUIRE(!called);
+
+    parallel::set_thread_count(0);
+}
+
+TEST_CASE("Pipeline / Local & nested pipelines") {
+    parallel::Scheduler scheduler{threads};
+
+    const auto run_pipeline = [&] {
+        int next = 0, sum = 0;
+
+        scheduler.pipeline(
+            threads,
+            [&]() -> std::optional<int> {
+                if (next == item_count) return std::nullopt;
+                return next++;
+            },
+            parallel::stage(parallel::StageMode::parallel, [](int i) { return uneven_work(i); }),
+            parallel::stage(parallel::StageMode::serial_out_of_order, [&](int i) { sum += i; }));
+
+        return sum;
+    };
+
+    REQUIRE(run_pipeline() == item_count * (item_count - 1) / 2);
+
+    // Pipelines started from the pool threads help with the work instead of blocking
+    std::vector<parallel::Future<int>> futures;
+    for (std::size_t i = 0; i < threads * 2; ++i) futures.push_back(scheduler.awaitable_task(run_pipeline));
+    for (auto& future : futures) REQUIRE(future.get() == item_count * (item_count - 1) / 2);
+}
+
+// --- Exceptions (1) ---
+// ----------------------
+
+TEST_CASE("Pipeline / Exceptions stop the pipeline") {
+    parallel::set_thread_count(threads);
+
+    for (std::size_t r = 0; r < repeats; ++r) {
+        int next = 0; // infinite source, only the exception can stop it
+
+        const auto run_pipeline = [&] {
+            parallel::pipeline(
+                threads, [&]() -> std::optional<int> { return next++; },
+                parallel::stage(parallel::StageMode::parallel,
+                                [](int i) {
+                                    if (i == 100) throw std::runtime_error("Stage failed");
+                                    return i;
+                                }),
+                parallel::stage(parallel::StageMode::serial_in_order, [](int) {}));
+        };
+
+        REQUIRE_THROWS_AS(run_pipeline(), std::runtime_error);
+        REQUIRE(next > 100);
+    }
+
+    parallel::set_thread_count(0);
+}
@@ -0,0 +1,237 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <algorithm> // sort(), partition()
+#include <atomic>    // atomic<>
+#include <chrono>    // milliseconds, microseconds
+#include <cstdint>   // uint64_t
+#include <memory>    // unique_ptr<>, make_unique<>()
+#include <stdexcept> // runtime_error
+#include <thread>    // thread
+#include <vector>    // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+constexpr std::size_t repeats = 10;
+// we run tests multiple times to increase the chance of catching race conditions,
+// this is usually kept low for CI builds, can be increased locally for better coverage
+
+constexpr std::size_t threads = 7; // weird number of threads
+
+// Deeply recursive illustrative tasks, not a practical way of computing fibonacci numbers
+int fibonacci_invoke(int n) {
+    if (n < 2) return n;
+
+    int prev_1 = 0, prev_2 = 0;
+    parallel::invoke([&] { prev_1 = fibonacci_invoke(n - 1); }, [&] { prev_2 = fibonacci_invoke(n - 2); });
+    return prev_1 + prev_2;
+}
+
+int fibonacci_group(parallel::ThreadPool& pool, int n) {
+    if (n < 2) return n;
+
+    int prev_1 = 0, prev_2 = 0;
+
+    parallel::TaskGroup group(pool);
+    group.run([&] { prev_1 = fibonacci_group(pool, n - 1); });
+    group.run([&] { prev_2 = fibonacci_group(pool, n - 2); });
+    group.wait();
+
+    return prev_1 + prev_2;
+}
+
+template <class It>
+void quicksort(It first, It last) {
+    if (last - first < 32) return std::sort(first, last);
+
+    const auto pivot  = *(first + (last - first) / 2);
+    const It   middle = std::partition(first, last, [&](const auto& e) { return e < pivot; });
+    const It   upper  = std::partition(middle, last, [&](const auto& e) { return !(pivot < e); });
+
+    parallel::invoke([&] { quicksort(first, middle); }, [&] { quicksort(upper, last); });
+}
+
+struct Node {
+    std::uint64_t         value;
+    std::unique_ptr<Node> left, right;
+};
+
+std::unique_ptr<Node> make_tree(std::size_t depth, std::uint64_t value) {
+    if (!depth) return nullptr;
+    return std::make_unique<Node>(Node{value, make_tree(depth - 1, 2 * value), make_tree(depth - 1, 2 * value + 1)});
+}
+
+void traverse(const Node* node, std::atomic<std::uint64_t>& sum) {
+    if (!node) return;
+
+    sum.fetch_add(node->value, std::memory_order_relaxed);
+
+    parallel::TaskGroup group;
+    group.run([&] { traverse(node->left.get(), sum); });
+    group.run([&] { traverse(node->right.get(), sum); });
+    group.wait();
+}
+
+// --- Fork-join (5) ---
+// ---------------------
+
+TEST_CASE("Task group / Recursive invoke") {
+    repeat(repeats, [] {
+        parallel::set_thread_count(threads);
+        REQUIRE(fibonacci_invoke(16) == 987);
+        parallel::set_thread_count(0);
+    });
+}
+
+TEST_CASE("Task group / Recursive group on a local pool") {
+    repeat(repeats, [] {
+        parallel::ThreadPool pool(threads);
+
+        int result = 0;
+        pool.awaitable_task([&] { result = fibonacci_group(pool, 16); }).wait();
+        REQUIRE(result == 987);
+
+        REQUIRE(fibonacci_group(pool, 12) == 144); // waiting from an external thread
+    });
+}
+
+TEST_CASE("Task group / Quicksort") {
+    repeat(repeats, [] {
+        std::vector<std::uint64_t> vec(100'003);
+        for (std::size_t i = 0; i < vec.size(); ++i) vec[i] = pseudorandom(i) % 1000;
+
+        auto res_serial   = vec;
+        auto res_parallel = vec;
+        std::sort(res_serial.begin(), res_serial.end());
+
+        parallel::set_thread_count(threads);
+        quicksort(res_parallel.begin(), res_parallel.end());
+        parallel::set_thread_count(0);
+
+        REQUIRE(res_parallel == res_serial);
+    });
+}
+
+TEST_CASE("Task group / Tree traversal") {
+    repeat(repeats, [] {
+        const auto tree = make_tree(12, 1); // nodes are numbered 1, 2, ..., 2^12 - 1
+
+        std::atomic<std::uint64_t> sum = 0;
+
+        parallel::set_thread_count(threads);
+        traverse(tree.get(), sum);
+        parallel::set_thread_count(0);
+
+        REQUIRE(sum == (4095 * 4096) / 2);
+    });
+}
+
+TEST_CASE("Task group / Waiting worker keeps helping") {
+    // Unbalanced split: the only child of the root gets stolen & spawns all of the actual work on another worker
+    // after the root has already started waiting with nothing to help with. Waiting worker should still pick up
+    // that work, leaves block until every worker of the pool has joined in (or until the deadline runs out).
+    constexpr std::size_t workers = 4;
+    constexpr std::size_t leaves  = 4 * workers;
+
+    repeat(repeats, [] {
+        parallel::ThreadPool pool(workers);
+
+        const auto                 deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        std::atomic<std::uint64_t> seen_workers{0}; // bitmask of worker indices that executed a leaf
+
+        const auto all_seen = [&] { return seen_workers.load() == (std::uint64_t(1) << workers) - 1; };
+
+        const auto leaf = [&] {
+            seen_workers.fetch_or(std::uint64_t(1) << parallel::this_thread::get_index().value());
+            while (!all_seen() && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+        };
+
+        pool.awaitable_task([&] {
+            parallel::TaskGroup outer(pool);
+            outer.run([&] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+                parallel::TaskGroup inner(pool);
+                for (std::size_t i = 0; i < leaves; ++i) inner.run(leaf);
+                inner.wait();
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(20)); // lets idle workers steal the child
+            outer.wait();
+        }).wait();
+
+        REQUIRE(all_seen());
+    });
+}
+
+// --- Group semantics (4) ---
+// ---------------------------
+
+TEST_CASE("Task group / Reuse after wait") {
+    parallel::ThreadPool pool(threads);
+    parallel::TaskGroup  group(pool);
+
+    std::atomic<std::size_t> counter = 0;
+
+    for (std::size_t round = 1; round <= 5; ++round) {
+        for (std::size_t i = 0; i < 100; ++i) group.run([&] { ++counter; });
+        group.wait();
+        REQUIRE(counter == 100 * round);
+    }
+
+    group.wait(); // waiting on an empty group is a no-op
+}
+
+TEST_CASE("Task group / Exceptions") {
+    parallel::ThreadPool pool(threads);
+    parallel::TaskGroup  group(pool);
+
+    std::atomic<std::size_t> counter = 0;
+
+    for (std::size_t i = 0; i < 100; ++i) group.run([&] { ++counter; });
+    group.run([] { throw std::runtime_error("Task failed"); });
+
+    REQUIRE_THROWS_AS(group.wait(), std::runtime_error);
+
+    // Group stays usable after a failure
+    counter = 0;
+    for (std::size_t i = 0; i < 100; ++i) group.run([&] { ++counter; });
+    group.wait();
+    REQUIRE(counter == 100);
+}
+
+TEST_CASE("Task group / Invoke exceptions") {
+    parallel::set_thread_count(threads);
+
+    std::atomic<bool> child_finished = false;
+
+    REQUIRE_THROWS_AS(parallel::invoke([] { throw std::runtime_error("Inline task failed"); },
+                                       [&] {
+                                           std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                                           child_finished = true;
+                                       }),
+                      std::runtime_error);
+    REQUIRE(child_finished); // children are always waited for
+
+    REQUIRE_THROWS_AS(parallel::invoke([] {}, [] { throw std::runtime_error("Child task failed"); }),
+                      std::runtime_error);
+
+    parallel::set_thread_count(0);
+}
+
+TEST_CASE("Task group / Destructor waits") {
+    parallel::ThreadPool pool(threads);
+
+    std::atomic<std::size_t> counter = 0;
+    {
+        parallel::TaskGroup group(pool);
+        for (std::size_t i = 0; i < 100; ++i)
+            group.run([&] {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+                ++counter;
+            });
+    }
+    REQUIRE(counter == 100);
+}
@@ -4,7 +4,12 @@
 
 // _______________________ INCLUDES _______________________
 
-// None
+#include <array>      // array<>
+#include <atomic>     // atomic<>
+#include <functional> // function<>
+#include <iterator>   // make_move_iterator()
+#include <memory>     // unique_ptr<>, make_unique<>()
+#include <vector>     // vector<>
 
 // ____________________ IMPLEMENTATION ____________________
 
@@ -86,4 +91,88 @@ TEST_CASE("Threadpool basics / Recursive awaitable tasks") {
 
         CHECK(res_serial == res_async);
     });
-}
\ No newline at end of file
+}
+
+TEST_CASE("Threadpool basics / Waking up parked threads") {
+    repeat(repeats, [] {
+        parallel::ThreadPool pool(4);
+
+        pool.wait(); // waiting on an idle pool should return immediately
+
+        std::atomic<std::size_t> counter = 0;
+
+        for (std::size_t round = 0; round < 5; ++round) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2)); // let all workers park
+
+            for (std::size_t i = 0; i < 10; ++i) pool.detached_task([&] { ++counter; });
+            pool.wait();
+
+            REQUIRE(counter == (round + 1) * 10);
+        }
+    });
+}
+
+TEST_CASE("Threadpool basics / Move-only and large closures") {
+    repeat(repeats, [] {
+        parallel::ThreadPool pool(3);
+
+        // Move-only closure
+        auto ptr    = std::make_unique<int>(42);
+        auto future = pool.awaitable_task([ptr = std::move(ptr)] { return *ptr; });
+        CHECK(future.get() == 42);
+
+        // Closure too large for the inline storage, should fall back onto a heap allocation
+        std::array<std::size_t, 32> data{};
+        for (std::size_t i = 0; i < data.size(); ++i) data[i] = i;
+
+        std::atomic<std::size_t> sum = 0;
+        for (std::size_t i = 0; i < 10; ++i)
+            pool.detached_task([data, &sum] {
+                for (auto e : data) sum += e;
+            });
+        pool.wait();
+
+        CHECK(sum == 10 * (31 * 32 / 2));
+    });
+}
+
+struct MoveOnlyIncrement {
+    std::unique_ptr<std::size_t> amount;
+    std::atomic<std::size_t>*    counter;
+
+    void operator()() const { *counter += *amount; }
+};
+
+TEST_CASE("Threadpool basics / Bulk submission") {
+    repeat(repeats, [] {
+        parallel::ThreadPool pool(3);
+
+        std::atomic<std::size_t> counter = 0;
+
+        // External batch, goes into the global queue under a single lock
+        std::vector<std::function<void()>> tasks(100, [&] { ++counter; });
+        pool.bulk_detached(tasks.begin(), tasks.end());
+        pool.wait();
+
+        CHECK(counter == 100);
+
+        // Recursive batch of move-only closures, goes into the local deque
+        pool.detached_task([&] {
+            std::vector<MoveOnlyIncrement> move_only_tasks;
+            for (std::size_t i = 0; i < 100; ++i)
+                move_only_tasks.push_back({std::make_unique<std::size_t>(2), &counter});
+
+            pool.bulk_detached(std::make_move_iterator(move_only_tasks.begin()),
+                               std::make_move_iterator(move_only_tasks.end()));
+        });
+        pool.wait();
+
+        CHECK(counter == 300);
+
+        // Empty batch is a no-op
+        pool.bulk_detached(tasks.end(), tasks.end());
+        pool.wait();
+
+        CHECK(counter == 300);
+    });
+}
@@ -0,0 +1,95 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <atomic> // atomic<>
+#include <vector> // vector<>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <pthread.h> // pthread_self(), pthread_getaffinity_np()
+#include <sched.h>   // cpu_set_t, CPU_ZERO(), CPU_ISSET(), CPU_COUNT(), CPU_SETSIZE
+#endif
+
+// ____________________ IMPLEMENTATION ____________________
+
+constexpr std::size_t threads = 7; // weird number of threads
+
+using Placement = parallel::Placement;
+using CpuInfo   = parallel::impl::CpuInfo;
+
+// Dual-socket machine with 2 NUMA nodes, 2 cores per node & 2 hyper-threads per core,
+// hyper-thread siblings are numbered like on most Intel systems: CPU 'i' & CPU 'i + 4'
+const std::vector<CpuInfo> dual_socket = {
+    {0, 0, 0, 0}, {1, 0, 0, 1}, {2, 1, 1, 0}, {3, 1, 1, 1},
+    {4, 0, 0, 0}, {5, 0, 0, 1}, {6, 1, 1, 0}, {7, 1, 1, 1},
+};
+
+std::vector<std::size_t> assigned_cpus(const Placement& placement, std::size_t count) {
+    std::vector<std::size_t> cpus;
+    for (const auto& info : parallel::impl::assign_cpus(placement, count, dual_socket)) cpus.push_back(info.cpu);
+    return cpus;
+}
+
+// --- CPU assignment (5) ---
+// --------------------------
+
+TEST_CASE("Thread pool placement / None") { REQUIRE(assigned_cpus(Placement::none(), 4).empty()); }
+
+TEST_CASE("Thread pool placement / Compact") {
+    REQUIRE(assigned_cpus(Placement::compact(), 8) == std::vector<std::size_t>{0, 4, 1, 5, 2, 6, 3, 7});
+}
+
+TEST_CASE("Thread pool placement / Scatter") {
+    REQUIRE(assigned_cpus(Placement::scatter(), 8) == std::vector<std::size_t>{0, 2, 1, 3, 4, 6, 5, 7});
+}
+
+TEST_CASE("Thread pool placement / Physical cores") {
+    REQUIRE(assigned_cpus(Placement::physical_cores(), 6) == std::vector<std::size_t>{0, 1, 2, 3, 0, 1});
+}
+
+TEST_CASE("Thread pool placement / CPU list") {
+    REQUIRE(assigned_cpus(Placement::cpu_list({6, 100, 1}), 3) == std::vector<std::size_t>{6, 1, 6});
+    REQUIRE(assigned_cpus(Placement::cpu_list({100}), 3).empty()); // no available CPUs => no pinning
+}
+
+// --- Pinned thread pool (2) ---
+// ------------------------------
+
+TEST_CASE("Thread pool placement / Pinned pool executes tasks") {
+    for (const auto& placement : {Placement::compact(), Placement::scatter(), Placement::physical_cores()}) {
+        parallel::ThreadPool     pool(threads, placement);
+        std::atomic<std::size_t> counter = 0;
+
+        for (std::size_t i = 0; i < 1000; ++i) pool.detached_task([&] { ++counter; });
+        pool.wait();
+
+        REQUIRE(counter == 1000);
+
+        pool.set_thread_count(2, Placement::none());
+        REQUIRE(pool.get_thread_count() == 2);
+    }
+}
+
+#if defined(__linux__) && !defined(__ANDROID__)
+TEST_CASE("Thread pool placement / Workers are pinned") {
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    REQUIRE(pthread_getaffinity_np(pthread_self(), sizeof(allowed), &allowed) == 0);
+
+    std::size_t first_cpu = 0;
+    while (!CPU_ISSET(first_cpu, &allowed)) ++first_cpu;
+
+    parallel::ThreadPool pool(threads, Placement::cpu_list({first_cpu}));
+
+    auto future = pool.awaitable_task([] {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        pthread_getaffinity_np(pthread_self(), sizeof(set), &set);
+        return CPU_COUNT(&set);
+    });
+
+    REQUIRE(future.get() == 1);
+}
+#endif
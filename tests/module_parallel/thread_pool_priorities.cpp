@@ -0,0 +1,119 @@
+#include "tests/common.hpp"
+
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <algorithm> // count(), find()
+#include <atomic>    // atomic<>
+#include <future>    // promise<>, shared_future<>
+#include <mutex>     // mutex, scoped_lock<>
+#include <vector>    // vector<>
+
+// ____________________ IMPLEMENTATION ____________________
+
+using parallel::Priority;
+
+// Single-threaded pool with a blocked worker, lets us queue up tasks & observe the order in which they get executed
+struct BlockedPool {
+    parallel::ThreadPool pool{1};
+    std::promise<void>   gate;
+
+    std::mutex       mutex;
+    std::vector<int> order;
+
+    BlockedPool() {
+        pool.detached_task([future = gate.get_future().share()] { future.wait(); });
+    }
+
+    void submit(Priority priority, int id) {
+        pool.detached_task(priority, [this, id] {
+            const std::scoped_lock lock(mutex);
+            order.push_back(id);
+        });
+    }
+
+    std::vector<int> run() {
+        gate.set_value();
+        pool.wait();
+        return order;
+    }
+};
+
+// --- Ordering (3) ---
+// -------------------
+
+TEST_CASE("Thread pool priorities / Higher tiers go first") {
+    BlockedPool blocked;
+
+    for (int i = 0; i < 3; ++i) blocked.submit(Priority::low, 3);
+    for (int i = 0; i < 3; ++i) blocked.submit(Priority::normal, 2);
+    for (int i = 0; i < 3; ++i) blocked.submit(Priority::high, 1);
+
+    REQUIRE(blocked.run() == std::vector<int>{1, 1, 1, 2, 2, 2, 3, 3, 3});
+}
+
+TEST_CASE("Thread pool priorities / Tiers are FIFO") {
+    BlockedPool blocked;
+
+    for (int i = 0; i < 10; ++i) blocked.submit(Priority::high, i);
+
+    REQUIRE(blocked.run() == std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+}
+
+TEST_CASE("Thread pool priorities / Starvation protection") {
+    BlockedPool blocked;
+
+    constexpr int high_tasks = 10 * static_cast<int>(parallel::impl::starvation_limit);
+
+    blocked.submit(Priority::low, 0);
+    for (int i = 0; i < high_tasks; ++i) blocked.submit(Priority::high, 1);
+
+    const auto order = blocked.run();
+    const auto pos   = std::find(order.begin(), order.end(), 0) - order.begin();
+
+    REQUIRE(pos <= static_cast<std::ptrdiff_t>(parallel::impl::starvation_limit)); // low task doesn't wait for all
+    REQUIRE(std::count(order.begin(), order.end(), 1) == high_tasks);
+}
+
+// --- API (2) ---
+// ---------------
+
+TEST_CASE("Thread pool priorities / Recursive high priority tasks skip local work") {
+    parallel::ThreadPool pool(1);
+
+    std::mutex       mutex;
+    std::vector<int> order;
+
+    const auto record = [&](int id) {
+        const std::scoped_lock lock(mutex);
+        order.push_back(id);
+    };
+
+    pool.detached_task([&] {
+        for (int i = 0; i < 5; ++i) pool.detached_task(record, 2); // goes into the local deque
+        pool.detached_task(Priority::high, record, 1);             // goes into the global high priority tier
+    });
+    pool.wait();
+
+    REQUIRE(order == std::vector<int>{1, 2, 2, 2, 2, 2});
+}
+
+TEST_CASE("Thread pool priorities / Awaitable & global API") {
+    parallel::ThreadPool pool(3);
+
+    REQUIRE(pool.awaitable_task(Priority::high, [](int x) { return 2 * x; }, 21).get() == 42);
+    REQUIRE(pool.awaitable_task(Priority::low, [] { return 17; }).get() == 17);
+
+    parallel::set_thread_count(3);
+
+    std::atomic<int> counter = 0;
+    parallel::detached_task(Priority::low, [&] { ++counter; });
+    parallel::detached_task(Priority::high, [&](int x) { counter += x; }, 2);
+    parallel::wait();
+
+    REQUIRE(counter == 3);
+    REQUIRE(parallel::awaitable_task(Priority::normal, [] { return 5; }).get() == 5);
+
+    parallel::set_thread_count(0);
+}
@@ -0,0 +1,81 @@
+#include "tests/common.hpp"
+
+#define UTL_PARALLEL_ENABLE_STATS
+#include "include/UTL/parallel.hpp"
+
+// _______________________ INCLUDES _______________________
+
+#include <atomic>  // atomic<>
+#include <chrono>  // milliseconds
+#include <numeric> // accumulate()
+#include <thread>  // this_thread::sleep_for()
+
+// ____________________ IMPLEMENTATION ____________________
+
+constexpr std::size_t threads = 7; // weird number of threads
+
+std::size_t histogram_count(const parallel::WorkerStats& stats) {
+    return std::accumulate(stats.latency_histogram.begin(), stats.latency_histogram.end(), std::size_t(0));
+}
+
+TEST_CASE("Thread pool stats / Latency buckets") {
+    REQUIRE(parallel::impl::latency_bucket(0) == 0);
+    REQUIRE(parallel::impl::latency_bucket(1) == 1);
+    REQUIRE(parallel::impl::latency_bucket(2) == 2);
+    REQUIRE(parallel::impl::latency_bucket(3) == 2);
+    REQUIRE(parallel::impl::latency_bucket(1024) == 11);
+    REQUIRE(parallel::impl::latency_bucket(std::uint64_t(-1)) == parallel::impl::latency_buckets - 1);
+}
+
+TEST_CASE("Thread pool stats / External tasks") {
+    parallel::ThreadPool pool(threads);
+
+    std::atomic<std::size_t> counter = 0;
+    for (std::size_t i = 0; i < 1000; ++i) pool.detached_task([&] { ++counter; });
+    pool.wait();
+
+    const auto stats = pool.stats();
+    const auto total = stats.total();
+
+    REQUIRE(stats.workers.size() == threads);
+    REQUIRE(total.executed_tasks == 1000);
+    REQUIRE(total.global_pops == 1000); // nothing is recursive, everything goes through the global queue
+    REQUIRE(total.local_pops == 0);
+    REQUIRE(histogram_count(total) == 1000);
+    REQUIRE(stats.max_global_queue_depth >= 1);
+    REQUIRE(stats.max_global_queue_depth <= 1000);
+}
+
+TEST_CASE("Thread pool stats / Recursive tasks") {
+    parallel::ThreadPool pool(threads);
+
+    std::atomic<std::size_t> counter = 0;
+    pool.detached_task([&] {
+        for (std::size_t i = 0; i < 1000; ++i) pool.detached_task([&] { ++counter; });
+    });
+    pool.wait();
+
+    const auto total = pool.stats().total();
+
+    REQUIRE(total.executed_tasks == 1001);
+    REQUIRE(total.global_pops == 1);
+    REQUIRE(total.local_pops + total.steals == 1000); // recursive tasks are either popped or stolen
+    REQUIRE(total.max_local_queue_depth >= 1);
+    REQUIRE(histogram_count(total) == 1001);
+}
+
+TEST_CASE("Thread pool stats / Idle time & resizing") {
+    parallel::ThreadPool pool(2);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // let the workers park
+    pool.detached_task([] {});
+    pool.wait();
+
+    REQUIRE(pool.stats().total().idle_time.count() > 0);
+
+    pool.set_thread_count(3); // stats are reset along with the workers
+
+    const auto stats = pool.stats();
+    REQUIRE(stats.workers.size() == 3);
+    REQUIRE(stats.total().executed_tasks == 0);
+}